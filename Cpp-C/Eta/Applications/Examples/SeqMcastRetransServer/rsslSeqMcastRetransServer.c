@@ -0,0 +1,442 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+/*
+ * This is a reference retransmission server for the Sequenced Multicast
+ * transport (RSSL_CONN_TYPE_SEQ_MCAST).  It joins the multicast group, keeps
+ * the most recent packets from each sender (origin address, port and instance
+ * ID), and answers retransmission requests from consumers that connect with
+ * RsslSeqMCastOpts.retransHostName/retransServiceName set.  The request and
+ * response format is described with RSSL_SEQ_MCAST_RETRANS_VERSION in
+ * rsslTransport.h.
+ *
+ * This application is written as a basic example and supports Linux only.
+ *
+ * Usage:
+ *   SeqMcastRetransServer -g <group> -p <port> [-if <interface>] [-rp <retrans port>] [-cache <packets>]
+ */
+
+#include "rtr/rsslTransport.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/* Sequenced Multicast packet header positions (all fields network byte order) */
+#define SEQ_MCAST_VERSION			0x01
+#define SEQ_MCAST_VERSION_POS		0
+#define SEQ_MCAST_FLAGS_POS			1
+#define SEQ_MCAST_INSTANCE_ID_POS	4
+#define SEQ_MCAST_SEQ_NUM_POS		8
+#define SEQ_MCAST_PING_LEN			12
+#define SEQ_MCAST_FLAGS_RETRANSMIT	0x02
+
+#define MAX_PKT_LEN		65535
+#define MAX_CLIENTS		64
+#define MAX_STREAMS		64
+
+typedef struct
+{
+	RsslUInt32	seqNum;
+	RsslUInt16	length;
+	char		*data;
+} CachedPkt;
+
+/* The last cacheSize packets from one sender, indexed by sequence number */
+typedef struct
+{
+	RsslUInt32	addr;
+	RsslUInt16	port;
+	RsslUInt16	instanceId;
+	CachedPkt	*pkts;
+} Stream;
+
+typedef struct
+{
+	int			sock;
+	char		in[RSSL_SEQ_MCAST_RETRANS_REQ_LEN];
+	RsslUInt32	inLen;
+	char		*out;
+	RsslUInt32	outLen;
+	RsslUInt32	outPos;
+	RsslUInt32	outCap;
+} Client;
+
+static RsslUInt32 cacheSize = 65536;
+static Stream streams[MAX_STREAMS];
+static RsslUInt32 numStreams = 0;
+static Client clients[MAX_CLIENTS];
+static RsslUInt32 numClients = 0;
+
+static RsslUInt64 pktsCached = 0, reqsServed = 0, pktsResent = 0, pktsNotFound = 0;
+
+static RsslUInt16 get16(const char *p)
+{
+	return (RsslUInt16)(((RsslUInt8)p[0] << 8) | (RsslUInt8)p[1]);
+}
+
+static RsslUInt32 get32(const char *p)
+{
+	return ((RsslUInt32)(RsslUInt8)p[0] << 24) | ((RsslUInt32)(RsslUInt8)p[1] << 16) | ((RsslUInt32)(RsslUInt8)p[2] << 8) | (RsslUInt8)p[3];
+}
+
+static void put16(char *p, RsslUInt16 value)
+{
+	p[0] = (char)(value >> 8);
+	p[1] = (char)value;
+}
+
+/* Sequence number 0 is only used by a sender that was reset, so it is skipped when counting */
+static RsslUInt32 seqNext(RsslUInt32 seqNum)
+{
+	return (++seqNum == 0) ? 1 : seqNum;
+}
+
+static Stream *findStream(RsslUInt32 addr, RsslUInt16 port, RsslUInt16 instanceId, RsslBool create)
+{
+	struct in_addr inAddr;
+	RsslUInt32 i;
+
+	for (i = 0; i < numStreams; i++)
+		if (streams[i].addr == addr && streams[i].port == port && streams[i].instanceId == instanceId)
+			return &streams[i];
+
+	if (!create || numStreams == MAX_STREAMS)
+		return NULL;
+
+	if (!(streams[numStreams].pkts = (CachedPkt*)calloc(cacheSize, sizeof(CachedPkt))))
+		return NULL;
+	streams[numStreams].addr = addr;
+	streams[numStreams].port = port;
+	streams[numStreams].instanceId = instanceId;
+	inAddr.s_addr = htonl(addr);
+	printf("New sender %s:%u instance %u\n", inet_ntoa(inAddr), port, instanceId);
+	return &streams[numStreams++];
+}
+
+static void cachePacket(RsslUInt32 addr, RsslUInt16 port, char *pData, int length)
+{
+	Stream *pStream;
+	CachedPkt *pCached;
+	RsslUInt32 seqNum;
+
+	if (length <= SEQ_MCAST_PING_LEN || pData[SEQ_MCAST_VERSION_POS] != SEQ_MCAST_VERSION)
+		return;
+
+	seqNum = get32(pData + SEQ_MCAST_SEQ_NUM_POS);
+	if (seqNum == 0 || !(pStream = findStream(addr, port, get16(pData + SEQ_MCAST_INSTANCE_ID_POS), RSSL_TRUE)))
+		return;
+
+	pCached = &pStream->pkts[seqNum % cacheSize];
+	if (pCached->data == NULL || pCached->length < length)
+	{
+		free(pCached->data);
+		if (!(pCached->data = (char*)malloc(length)))
+		{
+			pCached->length = 0;
+			return;
+		}
+	}
+	memcpy(pCached->data, pData, length);
+	pCached->data[SEQ_MCAST_FLAGS_POS] |= SEQ_MCAST_FLAGS_RETRANSMIT;
+	pCached->seqNum = seqNum;
+	pCached->length = (RsslUInt16)length;
+	pktsCached++;
+}
+
+static int appendOut(Client *pClient, const char *pData, RsslUInt32 length)
+{
+	if (pClient->outLen + length > pClient->outCap)
+	{
+		RsslUInt32 newCap = pClient->outCap ? pClient->outCap : 65536;
+		char *pNew;
+
+		while (pClient->outLen + length > newCap)
+			newCap *= 2;
+		if (!(pNew = (char*)realloc(pClient->out, newCap)))
+			return -1;
+		pClient->out = pNew;
+		pClient->outCap = newCap;
+	}
+	memcpy(pClient->out + pClient->outLen, pData, length);
+	pClient->outLen += length;
+	return 0;
+}
+
+/* Queues the packets still cached for one request, followed by the end marker */
+static int serveRequest(Client *pClient)
+{
+	const char *pReq = pClient->in;
+	Stream *pStream;
+	RsslUInt32 seqNum = get32(pReq + 12);
+	RsslUInt16 count = get16(pReq + 10);
+	char lenBuf[2];
+	RsslUInt16 i;
+
+	if ((RsslUInt8)pReq[0] != RSSL_SEQ_MCAST_RETRANS_VERSION)
+		return -1;
+
+	pStream = findStream(get32(pReq + 4), get16(pReq + 8), get16(pReq + 2), RSSL_FALSE);
+	reqsServed++;
+
+	for (i = 0; i < count; i++, seqNum = seqNext(seqNum))
+	{
+		CachedPkt *pCached;
+
+		if (pStream == NULL || (pCached = &pStream->pkts[seqNum % cacheSize])->seqNum != seqNum || pCached->length == 0)
+		{
+			pktsNotFound++;
+			continue;
+		}
+
+		put16(lenBuf, pCached->length);
+		if (appendOut(pClient, lenBuf, 2) < 0 || appendOut(pClient, pCached->data, pCached->length) < 0)
+			return -1;
+		pktsResent++;
+	}
+
+	put16(lenBuf, 0);
+	return appendOut(pClient, lenBuf, 2);
+}
+
+static void closeClient(RsslUInt32 index)
+{
+	close(clients[index].sock);
+	free(clients[index].out);
+	clients[index] = clients[--numClients];
+	printf("Client disconnected (%u connected)\n", numClients);
+}
+
+/* Returns -1 if the client should be closed */
+static int flushClient(Client *pClient)
+{
+	while (pClient->outPos < pClient->outLen)
+	{
+		ssize_t cc = send(pClient->sock, pClient->out + pClient->outPos, pClient->outLen - pClient->outPos, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+		if (cc < 0)
+			return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+		pClient->outPos += (RsslUInt32)cc;
+	}
+	pClient->outPos = pClient->outLen = 0;
+	return 0;
+}
+
+static int readClient(Client *pClient)
+{
+	for (;;)
+	{
+		ssize_t cc = recv(pClient->sock, pClient->in + pClient->inLen, RSSL_SEQ_MCAST_RETRANS_REQ_LEN - pClient->inLen, MSG_DONTWAIT);
+
+		if (cc == 0)
+			return -1;
+		if (cc < 0)
+			return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+
+		if ((pClient->inLen += (RsslUInt32)cc) == RSSL_SEQ_MCAST_RETRANS_REQ_LEN)
+		{
+			pClient->inLen = 0;
+			if (serveRequest(pClient) < 0)
+				return -1;
+		}
+	}
+}
+
+static int openMulticast(const char *group, const char *port, const char *interfaceName)
+{
+	struct sockaddr_in addr;
+	struct ip_mreq mreq;
+	int sock, opt = 1, rcvBuf = 4 * 1024 * 1024;
+
+	if ((sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) < 0)
+		return -1;
+
+	setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
+	setsockopt(sock, SOL_SOCKET, SO_RCVBUF, (char*)&rcvBuf, sizeof(rcvBuf));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons((unsigned short)atoi(port));
+	addr.sin_addr.s_addr = inet_addr(group);
+	if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+	{
+		close(sock);
+		return -1;
+	}
+
+	mreq.imr_multiaddr.s_addr = inet_addr(group);
+	mreq.imr_interface.s_addr = interfaceName ? inet_addr(interfaceName) : htonl(INADDR_ANY);
+	if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char*)&mreq, sizeof(mreq)) < 0)
+	{
+		close(sock);
+		return -1;
+	}
+
+	fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK);
+	return sock;
+}
+
+static int openListener(const char *port)
+{
+	struct sockaddr_in addr;
+	int sock, opt = 1;
+
+	if ((sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) < 0)
+		return -1;
+
+	setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons((unsigned short)atoi(port));
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(sock, 16) < 0)
+	{
+		close(sock);
+		return -1;
+	}
+	return sock;
+}
+
+static void printUsageAndExit(char *appName)
+{
+	printf("Usage: %s -g <multicast group> -p <multicast port> [-if <interface address>] [-rp <retransmission port>] [-cache <packets per sender>]\n"
+			" -g       Multicast group the senders publish on\n"
+			" -p       Multicast port\n"
+			" -if      Address of the interface to join the group on\n"
+			" -rp      TCP port consumers connect to for retransmissions (default 14100)\n"
+			" -cache   Number of recent packets kept for each sender (default 65536)\n", appName);
+	exit(-1);
+}
+
+int main(int argc, char **argv)
+{
+	char *group = NULL, *port = NULL, *interfaceName = NULL, *retransPort = (char*)"14100";
+	static char pktBuf[MAX_PKT_LEN];
+	struct pollfd fds[MAX_CLIENTS + 2];
+	int mcastSock, listenSock, i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+			group = argv[++i];
+		else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+			port = argv[++i];
+		else if (strcmp(argv[i], "-if") == 0 && i + 1 < argc)
+			interfaceName = argv[++i];
+		else if (strcmp(argv[i], "-rp") == 0 && i + 1 < argc)
+			retransPort = argv[++i];
+		else if (strcmp(argv[i], "-cache") == 0 && i + 1 < argc)
+			cacheSize = (RsslUInt32)atoi(argv[++i]);
+		else
+			printUsageAndExit(argv[0]);
+	}
+
+	if (!group || !port || cacheSize == 0)
+		printUsageAndExit(argv[0]);
+
+	signal(SIGPIPE, SIG_IGN);
+
+	if ((mcastSock = openMulticast(group, port, interfaceName)) < 0)
+	{
+		printf("Failed to join %s:%s: %s\n", group, port, strerror(errno));
+		exit(-1);
+	}
+
+	if ((listenSock = openListener(retransPort)) < 0)
+	{
+		printf("Failed to listen on port %s: %s\n", retransPort, strerror(errno));
+		exit(-1);
+	}
+
+	printf("Caching %u packets per sender from %s:%s, serving retransmissions on port %s\n", cacheSize, group, port, retransPort);
+
+	for (;;)
+	{
+		RsslUInt32 c;
+
+		fds[0].fd = mcastSock;
+		fds[0].events = POLLIN;
+		fds[1].fd = listenSock;
+		fds[1].events = POLLIN;
+		for (c = 0; c < numClients; c++)
+		{
+			fds[c + 2].fd = clients[c].sock;
+			fds[c + 2].events = POLLIN | (clients[c].outLen ? POLLOUT : 0);
+		}
+
+		if (poll(fds, numClients + 2, -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			printf("poll() failed: %s\n", strerror(errno));
+			exit(-1);
+		}
+
+		if (fds[0].revents & POLLIN)
+		{
+			struct sockaddr_in srcAddr;
+			socklen_t srcAddrLen;
+			ssize_t cc;
+
+			for (;;)
+			{
+				srcAddrLen = sizeof(srcAddr);
+				if ((cc = recvfrom(mcastSock, pktBuf, sizeof(pktBuf), 0, (struct sockaddr*)&srcAddr, &srcAddrLen)) < 0)
+					break;
+				cachePacket(ntohl(srcAddr.sin_addr.s_addr), ntohs(srcAddr.sin_port), pktBuf, (int)cc);
+			}
+		}
+
+		/* Clients are serviced from the end, since closing one moves the last one into its place */
+		for (c = numClients; c-- > 0; )
+		{
+			short revents = fds[c + 2].revents;
+
+			if ((revents & (POLLIN | POLLERR | POLLHUP)) && readClient(&clients[c]) < 0)
+			{
+				closeClient(c);
+				continue;
+			}
+			if (clients[c].outLen && flushClient(&clients[c]) < 0)
+				closeClient(c);
+		}
+
+		if (fds[1].revents & POLLIN)
+		{
+			int sock, opt = 1;
+
+			if ((sock = accept(listenSock, NULL, NULL)) >= 0)
+			{
+				if (numClients == MAX_CLIENTS)
+					close(sock);
+				else
+				{
+					setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (char*)&opt, sizeof(opt));
+					memset(&clients[numClients], 0, sizeof(Client));
+					clients[numClients++].sock = sock;
+					printf("Client connected (%u connected), %llu packets cached, %llu requests served, %llu packets resent, %llu not found\n",
+							numClients, (unsigned long long)pktsCached, (unsigned long long)reqsServed,
+							(unsigned long long)pktsResent, (unsigned long long)pktsNotFound);
+				}
+			}
+		}
+	}
+
+	return 0;
+}
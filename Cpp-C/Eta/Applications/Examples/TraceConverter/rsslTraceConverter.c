@@ -0,0 +1,303 @@
+/*
+ * This source code is provided under the Apache 2.0 license and is provided
+ * AS IS with no warranty or guarantee of fit for purpose.  See the project's
+ * LICENSE.md for details.
+ * Copyright Thomson Reuters 2018. All rights reserved.
+*/
+
+/*
+ * This is the main file for the TraceConverter application.  It reads a
+ * file written by a channel traced with RSSL_TRACE_BINARY and writes the
+ * XML trace that RSSL_TRACE_TO_FILE_ENABLE would have written for the same
+ * messages.  See readme file for usage.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rtr/rsslTransport.h"
+#include "rtr/rsslBinaryTrace.h"
+#include "rtr/rsslMessagePackage.h"
+#include "decodeRoutines.h"
+#include "xmlDump.h"
+
+/* longest record accepted, so a damaged file cannot ask for any amount of memory */
+#define MAX_RECORD_LENGTH 0x1000000
+
+static FILE *inFile = NULL;
+static FILE *outFile = NULL;
+static RsslBool hexDump = RSSL_FALSE;
+static RsslBinaryTraceFileHeader fileHeader;
+
+/* a write or pack whose end is only written once it is known whether a failure follows it */
+static RsslBool writePending = RSSL_FALSE;
+static RsslUInt64 writePendingChannel = 0;
+
+static void printUsageAndExit(char *appName)
+{
+	printf("Usage: %s -in <binary trace file> [-out <xml file>] [-hex]\n"
+		" -in the file written by a channel traced with RSSL_TRACE_BINARY\n"
+		" -out the XML file to write; the XML is written to stdout if not given\n"
+		" -hex adds a hex dump of every message, as RSSL_TRACE_HEX does\n", appName);
+	exit(-1);
+}
+
+static void dumpComment(const char *format, RsslUInt64 channelId)
+{
+	char comment[128];
+
+	snprintf(comment, sizeof(comment), format, (unsigned long long)channelId);
+	xmlDumpComment(outFile, comment);
+}
+
+/* Writes a time comment as xmlDumpTimestamp() would, from the time of the record */
+static void dumpRecordTime(RsslInt64 recordTime)
+{
+	time_t seconds = (time_t)(recordTime / 1000000000LL);
+	struct tm stampTime;
+
+#if defined(_WIN32)
+	localtime_s(&stampTime, &seconds);
+#else
+	localtime_r(&seconds, &stampTime);
+#endif
+
+	fprintf(outFile, "<!-- Time: %ld:%02ld:%02ld:%03ld -->\n",
+		(long)stampTime.tm_hour,
+		(long)stampTime.tm_min,
+		(long)stampTime.tm_sec,
+		(long)((recordTime / 1000000LL) % 1000));
+}
+
+static void endPendingWrite(RsslBinaryTraceRecord *pNextRecord)
+{
+	if (!writePending)
+		return;
+
+	if (pNextRecord && pNextRecord->event == RSSL_BTRC_WRITE_RESULT && pNextRecord->channelId == writePendingChannel)
+	{
+		switch (pNextRecord->retCode)
+		{
+			case RSSL_RET_FAILURE:
+				dumpComment("rsslWrite Failed (Channel IPC descriptor = %llu)", writePendingChannel);
+				break;
+			case RSSL_RET_WRITE_CALL_AGAIN:
+				dumpComment("rsslWrite returned RSSL_RET_WRITE_CALL_AGAIN (Channel IPC descriptor = %llu)", writePendingChannel);
+				break;
+			case RSSL_RET_INIT_NOT_INITIALIZED:
+				dumpComment("rsslWrite returned RSSL_RET_INIT_NOT_INITIALIZED (Channel IPC descriptor = %llu)", writePendingChannel);
+				break;
+			default:
+				break;
+		}
+	}
+
+	dumpComment("End Message (Channel IPC descriptor = %llu)", writePendingChannel);
+	writePending = RSSL_FALSE;
+}
+
+/* Writes the XML for a message, and its hex dump if it cannot be decoded or one was asked for */
+static void dumpMessage(RsslBinaryTraceRecord *pRecord, char *data)
+{
+	RsslDecodeIterator dIter;
+	RsslMsg msg;
+	RsslBuffer buffer;
+	RsslRet ret = RSSL_RET_FAILURE;
+
+	buffer.data = data;
+	buffer.length = (pRecord->flags & RSSL_BTRC_FL_TRUNCATED) ? pRecord->recordLength - (RsslUInt32)sizeof(RsslBinaryTraceRecord) : pRecord->dataLength;
+	if (buffer.length > pRecord->dataLength)
+		buffer.length = pRecord->dataLength;
+
+	if (pRecord->flags & RSSL_BTRC_FL_TRUNCATED)
+	{
+		char comment[128];
+
+		snprintf(comment, sizeof(comment), "Only the first %u of %u bytes were traced", buffer.length, pRecord->dataLength);
+		xmlDumpComment(outFile, comment);
+	}
+
+	if (fileHeader.protocolType == RSSL_RWF_PROTOCOL_TYPE)
+	{
+		rsslClearMsg(&msg);
+		rsslClearDecodeIterator(&dIter);
+		rsslSetDecodeIteratorRWFVersion(&dIter, fileHeader.majorVersion, fileHeader.minorVersion);
+		rsslSetDecodeIteratorBuffer(&dIter, &buffer);
+
+		if ((ret = rsslDecodeMsg(&dIter, &msg)) == RSSL_RET_SUCCESS)
+			decodeMsgToXML(outFile, &msg, NULL, &dIter);
+	}
+
+	if (ret != RSSL_RET_SUCCESS || hexDump || fileHeader.protocolType != RSSL_RWF_PROTOCOL_TYPE)
+	{
+		xmlDumpHexBuffer(outFile, &buffer);
+		fputc('\n', outFile);
+	}
+}
+
+static void dumpRecord(RsslBinaryTraceRecord *pRecord, char *data)
+{
+	char comment[128];
+
+	endPendingWrite(pRecord);
+
+	switch (pRecord->event)
+	{
+		case RSSL_BTRC_READ:
+			dumpComment("Incoming Message (Channel IPC descriptor = %llu)", pRecord->channelId);
+			dumpRecordTime(pRecord->time);
+			dumpMessage(pRecord, data);
+			dumpComment("End Message (Channel IPC descriptor = %llu)", pRecord->channelId);
+			break;
+
+		case RSSL_BTRC_WRITE:
+		case RSSL_BTRC_PACK:
+			dumpComment((pRecord->event == RSSL_BTRC_WRITE) ? "Outgoing Message (Channel IPC descriptor = %llu)" : "Pack Message (Channel IPC descriptor = %llu)",
+				pRecord->channelId);
+			dumpRecordTime(pRecord->time);
+			dumpMessage(pRecord, data);
+			writePending = RSSL_TRUE;
+			writePendingChannel = pRecord->channelId;
+			break;
+
+		case RSSL_BTRC_READ_PING:
+		case RSSL_BTRC_WRITE_PING:
+			dumpComment((pRecord->event == RSSL_BTRC_READ_PING) ? "Incoming Ping (Channel IPC descriptor = %llu)" : "Outgoing Ping (Channel IPC descriptor = %llu)",
+				pRecord->channelId);
+			dumpRecordTime(pRecord->time);
+			dumpComment("End Message (Channel IPC descriptor = %llu)", pRecord->channelId);
+			break;
+
+		case RSSL_BTRC_CONNECTED:
+			dumpComment("Connection Established (Channel IPC descriptor = %llu)", pRecord->channelId);
+			dumpRecordTime(pRecord->time);
+			break;
+
+		case RSSL_BTRC_CHANNEL_CLOSED:
+			dumpComment("Channel Closed (Channel IPC descriptor = %llu)", pRecord->channelId);
+			dumpRecordTime(pRecord->time);
+			break;
+
+		case RSSL_BTRC_CLOSE_CHANNEL:
+			dumpComment("rsslCloseChannel Connection closed (Channel IPC descriptor = %llu)", pRecord->channelId);
+			dumpRecordTime(pRecord->time);
+			break;
+
+		case RSSL_BTRC_DROPPED:
+			snprintf(comment, sizeof(comment), "%d messages were not traced because the trace buffer was full", pRecord->retCode);
+			xmlDumpComment(outFile, comment);
+			dumpRecordTime(pRecord->time);
+			break;
+
+		default:
+			/* RSSL_BTRC_WRITE_RESULT was written with its write; anything else is from a later version */
+			break;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	RsslBinaryTraceRecord record;
+	char *inFileName = NULL;
+	char *outFileName = NULL;
+	char *data = NULL;
+	RsslUInt32 dataSize = 0;
+	RsslUInt32 recordCount = 0;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp("-in", argv[i]) == 0 && i + 1 < argc)
+			inFileName = argv[++i];
+		else if (strcmp("-out", argv[i]) == 0 && i + 1 < argc)
+			outFileName = argv[++i];
+		else if (strcmp("-hex", argv[i]) == 0)
+			hexDump = RSSL_TRUE;
+		else
+			printUsageAndExit(argv[0]);
+	}
+
+	if (inFileName == NULL)
+		printUsageAndExit(argv[0]);
+
+	if ((inFile = fopen(inFileName, "rb")) == NULL)
+	{
+		printf("Error: Unable to open %s\n", inFileName);
+		exit(-1);
+	}
+
+	if (fread(&fileHeader, sizeof(fileHeader), 1, inFile) != 1 ||
+		memcmp(fileHeader.magic, RSSL_BINARY_TRACE_MAGIC, sizeof(fileHeader.magic)) != 0)
+	{
+		printf("Error: %s is not a binary trace file\n", inFileName);
+		exit(-1);
+	}
+
+	if (fileHeader.byteOrder != RSSL_BINARY_TRACE_BYTE_ORDER)
+	{
+		printf("Error: %s was written on a host of a different byte order\n", inFileName);
+		exit(-1);
+	}
+
+	if (fileHeader.formatVersion != RSSL_BINARY_TRACE_VERSION)
+	{
+		printf("Error: %s has version %u of the format; version %u is supported\n", inFileName, fileHeader.formatVersion, RSSL_BINARY_TRACE_VERSION);
+		exit(-1);
+	}
+
+	if (outFileName == NULL)
+		outFile = stdout;
+	else if ((outFile = fopen(outFileName, "w")) == NULL)
+	{
+		printf("Error: Unable to open %s\n", outFileName);
+		exit(-1);
+	}
+
+	while (fread(&record, sizeof(record), 1, inFile) == 1)
+	{
+		RsslUInt32 length;
+
+		if (record.recordLength < sizeof(record) || record.recordLength > MAX_RECORD_LENGTH)
+		{
+			printf("Error: Record %u of %s is damaged\n", recordCount + 1, inFileName);
+			break;
+		}
+
+		length = record.recordLength - (RsslUInt32)sizeof(record);
+		if (length > dataSize)
+		{
+			char *newData = (char*)realloc(data, length);
+
+			if (newData == NULL)
+			{
+				printf("Error: Unable to allocate %u bytes\n", length);
+				break;
+			}
+			data = newData;
+			dataSize = length;
+		}
+
+		if (length && fread(data, length, 1, inFile) != 1)
+		{
+			printf("Error: %s ends part way through record %u\n", inFileName, recordCount + 1);
+			break;
+		}
+
+		dumpRecord(&record, data);
+		recordCount++;
+	}
+
+	endPendingWrite(NULL);
+
+	if (outFile != stdout)
+	{
+		fclose(outFile);
+		printf("Converted %u records to %s\n", recordCount, outFileName);
+	}
+	fclose(inFile);
+	free(data);
+
+	return 0;
+}
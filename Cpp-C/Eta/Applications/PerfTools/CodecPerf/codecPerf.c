@@ -0,0 +1,1007 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+/* codecPerf.c
+ * Measures the cost of codec operations on a MarketPrice refresh payload, comparing
+ * alternative ways of decoding the same content. */
+
+#include "rtr/rsslDataPackage.h"
+#include "rtr/rwfConvert.h"
+#include "getTime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_FIELD_LIST_INDEX		0x01
+#define TEST_FIELD_LIST_TEMPLATE	0x02
+#define TEST_FIELD_LIST_DELTA		0x04
+#define TEST_REAL_CONVERSION		0x08
+#define TEST_STRING_PARSE			0x10
+
+static int iterations = 1000000;
+static int testMask = TEST_FIELD_LIST_INDEX | TEST_FIELD_LIST_TEMPLATE | TEST_FIELD_LIST_DELTA | TEST_REAL_CONVERSION
+		| TEST_STRING_PARSE;
+
+typedef struct {
+	RsslFieldId	fieldId;
+	RsslUInt8	dataType;
+} PerfField;
+
+/* Fields of an 80 field equity MarketPrice refresh */
+static const PerfField refreshFields[] =
+{
+	{ 1, RSSL_DT_UINT }, { 2, RSSL_DT_UINT }, { 3, RSSL_DT_RMTES_STRING }, { 4, RSSL_DT_ENUM },
+	{ 6, RSSL_DT_REAL }, { 7, RSSL_DT_REAL }, { 8, RSSL_DT_REAL }, { 9, RSSL_DT_REAL },
+	{ 10, RSSL_DT_REAL }, { 11, RSSL_DT_REAL }, { 12, RSSL_DT_REAL }, { 13, RSSL_DT_REAL },
+	{ 14, RSSL_DT_ENUM }, { 15, RSSL_DT_ENUM }, { 16, RSSL_DT_DATE }, { 18, RSSL_DT_TIME },
+	{ 19, RSSL_DT_REAL }, { 21, RSSL_DT_REAL }, { 22, RSSL_DT_REAL }, { 23, RSSL_DT_REAL },
+	{ 24, RSSL_DT_REAL }, { 25, RSSL_DT_REAL }, { 26, RSSL_DT_REAL }, { 27, RSSL_DT_REAL },
+	{ 28, RSSL_DT_REAL }, { 30, RSSL_DT_REAL }, { 31, RSSL_DT_REAL }, { 32, RSSL_DT_REAL },
+	{ 34, RSSL_DT_REAL }, { 35, RSSL_DT_REAL }, { 36, RSSL_DT_REAL }, { 37, RSSL_DT_REAL },
+	{ 38, RSSL_DT_DATE }, { 39, RSSL_DT_REAL }, { 40, RSSL_DT_REAL }, { 41, RSSL_DT_REAL },
+	{ 42, RSSL_DT_REAL }, { 43, RSSL_DT_REAL }, { 44, RSSL_DT_REAL }, { 45, RSSL_DT_REAL },
+	{ 46, RSSL_DT_REAL }, { 47, RSSL_DT_REAL }, { 53, RSSL_DT_ENUM }, { 54, RSSL_DT_ENUM },
+	{ 55, RSSL_DT_RMTES_STRING }, { 56, RSSL_DT_REAL }, { 57, RSSL_DT_REAL }, { 58, RSSL_DT_REAL },
+	{ 59, RSSL_DT_REAL }, { 60, RSSL_DT_REAL }, { 61, RSSL_DT_REAL }, { 62, RSSL_DT_REAL },
+	{ 63, RSSL_DT_REAL }, { 64, RSSL_DT_REAL }, { 65, RSSL_DT_REAL }, { 66, RSSL_DT_REAL },
+	{ 67, RSSL_DT_REAL }, { 68, RSSL_DT_REAL }, { 69, RSSL_DT_ASCII_STRING }, { 70, RSSL_DT_REAL },
+	{ 71, RSSL_DT_REAL }, { 75, RSSL_DT_REAL }, { 76, RSSL_DT_REAL }, { 77, RSSL_DT_REAL },
+	{ 78, RSSL_DT_ENUM }, { 79, RSSL_DT_DATE }, { 90, RSSL_DT_REAL }, { 91, RSSL_DT_REAL },
+	{ 100, RSSL_DT_REAL }, { 104, RSSL_DT_REAL }, { 105, RSSL_DT_REAL }, { 178, RSSL_DT_REAL },
+	{ 259, RSSL_DT_ENUM }, { 1021, RSSL_DT_REAL }, { 1025, RSSL_DT_TIME }, { 3404, RSSL_DT_ENUM },
+	{ 3853, RSSL_DT_ASCII_STRING }, { 3863, RSSL_DT_REAL }, { 5357, RSSL_DT_TIME }, { 14265, RSSL_DT_TIME }
+};
+#define REFRESH_FIELD_COUNT (int)(sizeof(refreshFields) / sizeof(PerfField))
+
+/* BID, ASK, TRDPRC_1; then NETCHNG_1, HIGH_1, LOW_1, TRADE_DATE, TRDTIM_1, BIDSIZE, ASKSIZE */
+static const RsslFieldId wantedFields[] = { 22, 25, 6, 11, 12, 13, 16, 18, 30, 31 };
+
+/* Type of each field by its identifier, as a field dictionary would give it */
+static RsslUInt8 fieldTypes[65536];
+
+static void exitWithUsage()
+{
+	printf(	"Options:\n"
+			"  -iterations <count>   Number of times each operation is measured (default 1000000).\n"
+			"  -tests <list>         Comma-separated tests to run: fieldListIndex, fieldListTemplate,\n"
+			"                        fieldListDelta, realConversion, stringParse (default all).\n"
+			"\n");
+	exit(-1);
+}
+
+static void parseArgs(int argc, char **argv)
+{
+	int i;
+	char *pToken;
+
+	for (i = 1; i < argc; ++i)
+	{
+		if (strcmp("-iterations", argv[i]) == 0 && i + 1 < argc)
+		{
+			if ((iterations = atoi(argv[++i])) <= 0)
+				exitWithUsage();
+		}
+		else if (strcmp("-tests", argv[i]) == 0 && i + 1 < argc)
+		{
+			testMask = 0;
+			for (pToken = strtok(argv[++i], ","); pToken != NULL; pToken = strtok(NULL, ","))
+			{
+				if (strcmp(pToken, "fieldListIndex") == 0) testMask |= TEST_FIELD_LIST_INDEX;
+				else if (strcmp(pToken, "fieldListTemplate") == 0) testMask |= TEST_FIELD_LIST_TEMPLATE;
+				else if (strcmp(pToken, "fieldListDelta") == 0) testMask |= TEST_FIELD_LIST_DELTA;
+				else if (strcmp(pToken, "realConversion") == 0) testMask |= TEST_REAL_CONVERSION;
+				else if (strcmp(pToken, "stringParse") == 0) testMask |= TEST_STRING_PARSE;
+				else exitWithUsage();
+			}
+		}
+		else
+		{
+			printf("Unknown option: %s\n", argv[i]);
+			exitWithUsage();
+		}
+	}
+}
+
+/* Encodes the refresh's field list, with values typical of each type.  If given, fields set in changed get other values. */
+static RsslRet encodeRefreshFieldList(RsslBuffer *pBuffer, const RsslUInt8 *changed)
+{
+	RsslEncodeIterator eIter;
+	RsslFieldList fList;
+	RsslFieldEntry fEntry;
+	RsslRet ret;
+	int i;
+
+	rsslClearEncodeIterator(&eIter);
+	if ((ret = rsslSetEncodeIteratorBuffer(&eIter, pBuffer)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	rsslClearFieldList(&fList);
+	fList.flags = RSSL_FLF_HAS_STANDARD_DATA | RSSL_FLF_HAS_FIELD_LIST_INFO;
+	fList.dictionaryId = 1;
+	fList.fieldListNum = 79;
+	if ((ret = rsslEncodeFieldListInit(&eIter, &fList, 0, 0)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	for (i = 0; i < REFRESH_FIELD_COUNT; ++i)
+	{
+		RsslUInt uintVal = 4000 + i;
+		RsslEnum enumVal = (RsslEnum)(i % 12);
+		RsslReal realVal;
+		RsslDate dateVal;
+		RsslTime timeVal;
+		RsslBuffer strVal = { 9, (char*)"TRI.N EQ" };
+		int change = (changed && changed[(RsslUInt16)refreshFields[i].fieldId]) ? 1 : 0;
+		void *pValue;
+
+		rsslClearReal(&realVal);
+		realVal.hint = RSSL_RH_EXPONENT_2;
+		realVal.value = 391234 + i * 17 + change;
+		dateVal.day = 18 + change; dateVal.month = 10; dateVal.year = 2018;
+		rsslClearTime(&timeVal);
+		timeVal.hour = 14; timeVal.minute = 30; timeVal.second = i % 60; timeVal.millisecond = 250 + change;
+		uintVal += change;
+		enumVal = (RsslEnum)(enumVal + change);
+		if (change)
+			strVal.data = (char*)"TRI.N EQX";
+
+		switch (refreshFields[i].dataType)
+		{
+			case RSSL_DT_UINT: pValue = &uintVal; break;
+			case RSSL_DT_ENUM: pValue = &enumVal; break;
+			case RSSL_DT_REAL: pValue = &realVal; break;
+			case RSSL_DT_DATE: pValue = &dateVal; break;
+			case RSSL_DT_TIME: pValue = &timeVal; break;
+			default: pValue = &strVal; break;
+		}
+
+		rsslClearFieldEntry(&fEntry);
+		fEntry.fieldId = refreshFields[i].fieldId;
+		fEntry.dataType = refreshFields[i].dataType;
+		if ((ret = rsslEncodeFieldEntry(&eIter, &fEntry, pValue)) < RSSL_RET_SUCCESS)
+			return ret;
+	}
+
+	if ((ret = rsslEncodeFieldListComplete(&eIter, RSSL_TRUE)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	pBuffer->length = rsslGetEncodedBufferLength(&eIter);
+	return RSSL_RET_SUCCESS;
+}
+
+/* Decodes the value of the current entry by the type its field identifier has, as an application using a dictionary would. */
+static RsslRet decodeValue(RsslDecodeIterator *pIter, RsslFieldId fieldId, RsslUInt64 *pSum)
+{
+	RsslRet ret;
+
+	switch (fieldTypes[(RsslUInt16)fieldId])
+	{
+		case RSSL_DT_UINT: { RsslUInt value; ret = rsslDecodeUInt(pIter, &value); *pSum += value; break; }
+		case RSSL_DT_ENUM: { RsslEnum value; ret = rsslDecodeEnum(pIter, &value); *pSum += value; break; }
+		case RSSL_DT_REAL: { RsslReal value; ret = rsslDecodeReal(pIter, &value); *pSum += (RsslUInt64)value.value; break; }
+		case RSSL_DT_DATE: { RsslDate value; ret = rsslDecodeDate(pIter, &value); *pSum += value.day; break; }
+		case RSSL_DT_TIME: { RsslTime value; ret = rsslDecodeTime(pIter, &value); *pSum += value.second; break; }
+		default: { RsslBuffer value; ret = rsslDecodeBuffer(pIter, &value); *pSum += value.length; break; }
+	}
+
+	return (ret < RSSL_RET_SUCCESS) ? ret : RSSL_RET_SUCCESS;
+}
+
+/* Walks the list with rsslDecodeFieldEntry() until every wanted field is decoded. */
+static RsslRet decodeSequential(RsslBuffer *pBuffer, const RsslUInt8 *wanted, int wantedCount, RsslUInt64 *pSum)
+{
+	RsslDecodeIterator dIter;
+	RsslFieldList fList;
+	RsslFieldEntry fEntry;
+	RsslRet ret;
+	int found = 0;
+
+	rsslClearDecodeIterator(&dIter);
+	rsslSetDecodeIteratorBuffer(&dIter, pBuffer);
+	if ((ret = rsslDecodeFieldList(&dIter, &fList, 0)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	while (found < wantedCount && (ret = rsslDecodeFieldEntry(&dIter, &fEntry)) == RSSL_RET_SUCCESS)
+	{
+		if (wanted[(RsslUInt16)fEntry.fieldId])
+		{
+			if ((ret = decodeValue(&dIter, fEntry.fieldId, pSum)) < RSSL_RET_SUCCESS)
+				return ret;
+			++found;
+		}
+	}
+
+	return (found == wantedCount) ? RSSL_RET_SUCCESS : RSSL_RET_FAILURE;
+}
+
+static RsslRet decodeIndexed(RsslDecodeIterator *pIter, RsslFieldListIndex *pIndex, const RsslFieldId *fids, int fidCount, RsslUInt64 *pSum)
+{
+	RsslFieldEntry fEntry;
+	RsslRet ret;
+	int i;
+
+	for (i = 0; i < fidCount; ++i)
+	{
+		if ((ret = rsslDecodeFieldEntryAt(pIter, pIndex, fids[i], &fEntry)) != RSSL_RET_SUCCESS)
+			return RSSL_RET_FAILURE;
+		if ((ret = decodeValue(pIter, fids[i], pSum)) < RSSL_RET_SUCCESS)
+			return ret;
+	}
+	return RSSL_RET_SUCCESS;
+}
+
+static RsslRet buildIndex(RsslBuffer *pBuffer, RsslDecodeIterator *pIter, RsslFieldListIndex *pIndex)
+{
+	RsslFieldList fList;
+	RsslRet ret;
+
+	rsslClearDecodeIterator(pIter);
+	rsslSetDecodeIteratorBuffer(pIter, pBuffer);
+	if ((ret = rsslDecodeFieldList(pIter, &fList, 0)) < RSSL_RET_SUCCESS)
+		return ret;
+	return rsslDecodeFieldListIndex(pIter, pIndex);
+}
+
+/* Compares decoding some fields of the refresh by walking it with rsslDecodeFieldEntry(), against
+ * indexing it with rsslDecodeFieldListIndex() and looking the fields up with rsslDecodeFieldEntryAt(). */
+static int runFieldListIndexTest()
+{
+	char encMem[2048], indexMem[RSSL_FIELD_LIST_INDEX_MEMORY_SIZE(REFRESH_FIELD_COUNT)];
+	RsslBuffer encBuffer = { sizeof(encMem), encMem };
+	RsslFieldListIndex index = RSSL_INIT_FIELD_LIST_INDEX;
+	RsslDecodeIterator dIter;
+	RsslFieldId allFields[REFRESH_FIELD_COUNT];
+	static RsslUInt8 wanted[65536];
+	int counts[3] = { 3, 10, REFRESH_FIELD_COUNT };
+	RsslUInt64 sum = 0;
+	int c, i, j;
+
+	for (i = 0; i < REFRESH_FIELD_COUNT; ++i)
+	{
+		fieldTypes[(RsslUInt16)refreshFields[i].fieldId] = refreshFields[i].dataType;
+		allFields[i] = refreshFields[i].fieldId;
+	}
+
+	if (encodeRefreshFieldList(&encBuffer, NULL) != RSSL_RET_SUCCESS)
+	{
+		printf("Failed to encode refresh field list.\n");
+		return -1;
+	}
+
+	index.memory.data = indexMem;
+	index.memory.length = sizeof(indexMem);
+
+	printf("Field list index: %d field refresh of %u bytes, %d iterations\n\n", REFRESH_FIELD_COUNT, encBuffer.length, iterations);
+	printf("%-8s %16s %14s %12s %12s\n", "Fields", "Sequential(ns)", "Indexed(ns)", "Build(ns)", "Lookup(ns)");
+
+	for (c = 0; c < 3; ++c)
+	{
+		const RsslFieldId *fids = (counts[c] == REFRESH_FIELD_COUNT) ? allFields : wantedFields;
+		TimeValue startTime, sequentialTime, indexedTime, buildTime, lookupTime;
+
+		memset(wanted, 0, sizeof(wanted));
+		for (j = 0; j < counts[c]; ++j)
+			wanted[(RsslUInt16)fids[j]] = 1;
+
+		/* walk until the fields are found */
+		startTime = getTimeNano();
+		for (i = 0; i < iterations; ++i)
+		{
+			if (decodeSequential(&encBuffer, wanted, counts[c], &sum) != RSSL_RET_SUCCESS)
+			{
+				printf("Sequential decode failed.\n");
+				return -1;
+			}
+		}
+		sequentialTime = getTimeNano() - startTime;
+
+		/* index, then look the fields up */
+		startTime = getTimeNano();
+		for (i = 0; i < iterations; ++i)
+		{
+			if (buildIndex(&encBuffer, &dIter, &index) != RSSL_RET_SUCCESS
+					|| decodeIndexed(&dIter, &index, fids, counts[c], &sum) != RSSL_RET_SUCCESS)
+			{
+				printf("Indexed decode failed.\n");
+				return -1;
+			}
+		}
+		indexedTime = getTimeNano() - startTime;
+
+		/* the index alone */
+		startTime = getTimeNano();
+		for (i = 0; i < iterations; ++i)
+			buildIndex(&encBuffer, &dIter, &index);
+		buildTime = getTimeNano() - startTime;
+
+		/* lookups alone, the cost of each further set of fields taken from the same index */
+		startTime = getTimeNano();
+		for (i = 0; i < iterations; ++i)
+			decodeIndexed(&dIter, &index, fids, counts[c], &sum);
+		lookupTime = getTimeNano() - startTime;
+
+		printf("%-8d %16.1f %14.1f %12.1f %12.1f\n", counts[c],
+				(double)sequentialTime / iterations, (double)indexedTime / iterations,
+				(double)buildTime / iterations, (double)lookupTime / iterations);
+	}
+
+	/* keeps the decoded values live */
+	printf("\n(checksum %llu)\n\n", (unsigned long long)sum);
+	return 0;
+}
+
+/* Values for a layout, with values typical of each type */
+static void setTemplateValues(const RsslFieldListTemplateEntry *pLayout, int count, RsslFieldListTemplateValue *pValues)
+{
+	int i;
+
+	memset(pValues, 0, count * sizeof(RsslFieldListTemplateValue));
+	for (i = 0; i < count; ++i)
+	{
+		switch (pLayout[i].dataType)
+		{
+			case RSSL_DT_UINT: pValues[i].uintValue = 4000 + i; break;
+			case RSSL_DT_ENUM: pValues[i].enumValue = (RsslEnum)(i % 12); break;
+			case RSSL_DT_REAL: pValues[i].realValue.hint = RSSL_RH_EXPONENT_2; pValues[i].realValue.value = 391234 + i * 17; break;
+			case RSSL_DT_DATE: pValues[i].dateValue.day = 18; pValues[i].dateValue.month = 10; pValues[i].dateValue.year = 2018; break;
+			case RSSL_DT_TIME: pValues[i].timeValue.hour = 14; pValues[i].timeValue.minute = 30; pValues[i].timeValue.second = i % 60; pValues[i].timeValue.millisecond = 250; break;
+			default: pValues[i].bufferValue.data = (char*)"TRI.N EQ"; pValues[i].bufferValue.length = 8; break;
+		}
+	}
+}
+
+/* Encodes the list with rsslEncodeFieldListInit(), rsslEncodeFieldEntry() and rsslEncodeFieldListComplete(). */
+static RsslRet encodeEntries(RsslBuffer *pBuffer, const RsslFieldListTemplateEntry *pLayout, int count, 
+		const RsslFieldListTemplateValue *pValues, const RsslLocalFieldSetDefDb *pSetDb)
+{
+	RsslEncodeIterator eIter;
+	RsslFieldList fList;
+	RsslFieldEntry fEntry;
+	RsslRet ret;
+	int i;
+
+	rsslClearEncodeIterator(&eIter);
+	rsslSetEncodeIteratorBuffer(&eIter, pBuffer);
+
+	rsslClearFieldList(&fList);
+	fList.flags = pSetDb ? RSSL_FLF_HAS_SET_DATA : RSSL_FLF_HAS_STANDARD_DATA;
+	if ((ret = rsslEncodeFieldListInit(&eIter, &fList, pSetDb, 0)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	for (i = 0; i < count; ++i)
+	{
+		rsslClearFieldEntry(&fEntry);
+		fEntry.fieldId = pLayout[i].fieldId;
+		fEntry.dataType = pLayout[i].dataType;
+		if ((ret = rsslEncodeFieldEntry(&eIter, &fEntry, &pValues[i])) < RSSL_RET_SUCCESS)
+			return ret;
+	}
+
+	if ((ret = rsslEncodeFieldListComplete(&eIter, RSSL_TRUE)) < RSSL_RET_SUCCESS)
+		return ret;
+	return (RsslRet)rsslGetEncodedBufferLength(&eIter);
+}
+
+static RsslRet encodeTemplate(RsslBuffer *pBuffer, const RsslFieldListTemplate *pTemplate, const RsslFieldListTemplateValue *pValues)
+{
+	RsslEncodeIterator eIter;
+	RsslRet ret;
+
+	rsslClearEncodeIterator(&eIter);
+	rsslSetEncodeIteratorBuffer(&eIter, pBuffer);
+	if ((ret = rsslEncodeFieldListTemplate(&eIter, pTemplate, pValues)) < RSSL_RET_SUCCESS)
+		return ret;
+	return (RsslRet)rsslGetEncodedBufferLength(&eIter);
+}
+
+/* Compares encoding field lists of a fixed layout field by field, against encoding them from a compiled template. */
+static int runFieldListTemplateTest()
+{
+	static const char *layoutNames[2] = { "update", "refresh" };
+	static const char *modeNames[3] = { "fixed", "variable", "set data" };
+	static const RsslUInt8 modeFlags[3] = { RSSL_FLTF_NONE, RSSL_FLTF_VARIABLE_WIDTH, RSSL_FLTF_SET_DEFINED };
+	RsslFieldListTemplateEntry layouts[2][REFRESH_FIELD_COUNT];
+	RsslFieldListTemplateValue values[REFRESH_FIELD_COUNT];
+	char encMem[2048], templateMem[RSSL_FIELD_LIST_TEMPLATE_MEMORY_SIZE(REFRESH_FIELD_COUNT)];
+	RsslBuffer encBuffer;
+	RsslFieldListTemplate fTemplate;
+	RsslLocalFieldSetDefDb setDb;
+	int counts[2] = { (int)(sizeof(wantedFields) / sizeof(RsslFieldId)), REFRESH_FIELD_COUNT };
+	int l, m, i;
+
+	for (i = 0; i < REFRESH_FIELD_COUNT; ++i)
+	{
+		fieldTypes[(RsslUInt16)refreshFields[i].fieldId] = refreshFields[i].dataType;
+		layouts[1][i].fieldId = refreshFields[i].fieldId;
+		layouts[1][i].dataType = refreshFields[i].dataType;
+	}
+	for (i = 0; i < counts[0]; ++i)
+	{
+		layouts[0][i].fieldId = wantedFields[i];
+		layouts[0][i].dataType = fieldTypes[(RsslUInt16)wantedFields[i]];
+	}
+
+	printf("Field list template: %d iterations\n\n", iterations);
+	printf("%-8s %-9s %6s %12s %13s %8s %13s %14s\n", "Layout", "Mode", "Fields", "Entries(ns)", "Template(ns)", "Speedup", "Entries(byte)", "Template(byte)");
+
+	for (l = 0; l < 2; ++l)
+	{
+		for (m = 0; m < 3; ++m)
+		{
+			const RsslLocalFieldSetDefDb *pSetDb = NULL;
+			TimeValue startTime, entriesTime, templateTime;
+			RsslRet entriesLength = 0, templateLength = 0;
+
+			/* the refresh's strings leave no fixed width encoding to compare */
+			if (l == 1 && m == 0)
+				continue;
+
+			rsslClearFieldListTemplate(&fTemplate);
+			fTemplate.memory.data = templateMem;
+			fTemplate.memory.length = sizeof(templateMem);
+			fTemplate.flags = modeFlags[m];
+			if (rsslCompileFieldListTemplate(&fTemplate, layouts[l], (RsslUInt16)counts[l]) != RSSL_RET_SUCCESS)
+			{
+				printf("Failed to compile template.\n");
+				return -1;
+			}
+
+			if (fTemplate.flags & RSSL_FLTF_SET_DEFINED)
+			{
+				rsslClearLocalFieldSetDefDb(&setDb);
+				setDb.definitions[0] = fTemplate.setDef;
+				pSetDb = &setDb;
+			}
+
+			setTemplateValues(layouts[l], counts[l], values);
+
+			startTime = getTimeNano();
+			for (i = 0; i < iterations; ++i)
+			{
+				values[0].realValue.value = i;
+				encBuffer.data = encMem;
+				encBuffer.length = sizeof(encMem);
+				if ((entriesLength = encodeEntries(&encBuffer, layouts[l], counts[l], values, pSetDb)) < RSSL_RET_SUCCESS)
+				{
+					printf("Entry encode failed: %d.\n", entriesLength);
+					return -1;
+				}
+			}
+			entriesTime = getTimeNano() - startTime;
+
+			startTime = getTimeNano();
+			for (i = 0; i < iterations; ++i)
+			{
+				values[0].realValue.value = i;
+				encBuffer.data = encMem;
+				encBuffer.length = sizeof(encMem);
+				if ((templateLength = encodeTemplate(&encBuffer, &fTemplate, values)) < RSSL_RET_SUCCESS)
+				{
+					printf("Template encode failed: %d.\n", templateLength);
+					return -1;
+				}
+			}
+			templateTime = getTimeNano() - startTime;
+
+			printf("%-8s %-9s %6d %12.1f %13.1f %7.1fx %13d %14d\n", layoutNames[l], modeNames[m], counts[l],
+					(double)entriesTime / iterations, (double)templateTime / iterations, (double)entriesTime / (double)templateTime,
+					entriesLength, templateLength);
+		}
+	}
+
+	printf("\n");
+	return 0;
+}
+
+/* A field decoded by the type its field identifier has, as an application holding an item's values would keep it */
+typedef struct {
+	RsslFieldId		fieldId;
+	RsslBool		blank;
+	union {
+		RsslUInt	uintValue;
+		RsslEnum	enumValue;
+		RsslReal	realValue;
+		RsslDate	dateValue;
+		RsslTime	timeValue;
+		RsslBuffer	bufferValue;
+	} value;
+} PerfValue;
+
+/* Decodes every field of a list, noting the position + 1 of each in positions */
+static RsslRet decodeValues(RsslBuffer *pBuffer, PerfValue *pValues, int *pCount, RsslUInt16 *positions)
+{
+	RsslDecodeIterator dIter;
+	RsslFieldList fList;
+	RsslFieldEntry fEntry;
+	RsslRet ret;
+	int count = 0;
+
+	rsslClearDecodeIterator(&dIter);
+	rsslSetDecodeIteratorBuffer(&dIter, pBuffer);
+	if ((ret = rsslDecodeFieldList(&dIter, &fList, 0)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	while ((ret = rsslDecodeFieldEntry(&dIter, &fEntry)) == RSSL_RET_SUCCESS)
+	{
+		PerfValue *pValue = &pValues[count];
+
+		pValue->fieldId = fEntry.fieldId;
+		switch (fieldTypes[(RsslUInt16)fEntry.fieldId])
+		{
+			case RSSL_DT_UINT: ret = rsslDecodeUInt(&dIter, &pValue->value.uintValue); break;
+			case RSSL_DT_ENUM: ret = rsslDecodeEnum(&dIter, &pValue->value.enumValue); break;
+			case RSSL_DT_REAL: ret = rsslDecodeReal(&dIter, &pValue->value.realValue); break;
+			case RSSL_DT_DATE: ret = rsslDecodeDate(&dIter, &pValue->value.dateValue); break;
+			case RSSL_DT_TIME: ret = rsslDecodeTime(&dIter, &pValue->value.timeValue); break;
+			default: ret = rsslDecodeBuffer(&dIter, &pValue->value.bufferValue); break;
+		}
+		if (ret < RSSL_RET_SUCCESS)
+			return ret;
+
+		pValue->blank = (ret == RSSL_RET_BLANK_DATA) ? RSSL_TRUE : RSSL_FALSE;
+		positions[(RsslUInt16)fEntry.fieldId] = (RsslUInt16)++count;
+	}
+
+	*pCount = count;
+	return (ret == RSSL_RET_END_OF_CONTAINER) ? RSSL_RET_SUCCESS : ret;
+}
+
+static RsslBool valuesEqual(const PerfValue *pValue1, const PerfValue *pValue2)
+{
+	if (pValue1->blank || pValue2->blank)
+		return (pValue1->blank && pValue2->blank) ? RSSL_TRUE : RSSL_FALSE;
+
+	switch (fieldTypes[(RsslUInt16)pValue1->fieldId])
+	{
+		case RSSL_DT_UINT: return (pValue1->value.uintValue == pValue2->value.uintValue) ? RSSL_TRUE : RSSL_FALSE;
+		case RSSL_DT_ENUM: return (pValue1->value.enumValue == pValue2->value.enumValue) ? RSSL_TRUE : RSSL_FALSE;
+		case RSSL_DT_REAL: return rsslRealIsEqual(&pValue1->value.realValue, &pValue2->value.realValue);
+		case RSSL_DT_DATE: return rsslDateIsEqual(&pValue1->value.dateValue, &pValue2->value.dateValue);
+		case RSSL_DT_TIME: return rsslTimeIsEqual(&pValue1->value.timeValue, &pValue2->value.timeValue);
+		default: return rsslBufferIsEqual(&pValue1->value.bufferValue, &pValue2->value.bufferValue);
+	}
+}
+
+static RsslRet encodeValue(RsslEncodeIterator *pIter, const PerfValue *pValue)
+{
+	RsslFieldEntry fEntry;
+
+	rsslClearFieldEntry(&fEntry);
+	fEntry.fieldId = pValue->fieldId;
+	fEntry.dataType = fieldTypes[(RsslUInt16)pValue->fieldId];
+	return rsslEncodeFieldEntry(pIter, &fEntry, pValue->blank ? NULL : &pValue->value);
+}
+
+/* The delta (or, if apply is set, the image with the update applied) by decoding both lists to typed values,
+ * comparing or merging them, and encoding the values again. */
+static RsslRet typedDelta(RsslBuffer *pOldBuffer, RsslBuffer *pNewBuffer, RsslBuffer *pOutBuffer, RsslBool apply)
+{
+	static PerfValue oldValues[REFRESH_FIELD_COUNT], newValues[REFRESH_FIELD_COUNT];
+	static RsslUInt16 oldPositions[65536], newPositions[65536];
+	RsslEncodeIterator eIter;
+	RsslFieldList fList;
+	RsslRet ret;
+	int oldCount, newCount, i;
+
+	if ((ret = decodeValues(pOldBuffer, oldValues, &oldCount, oldPositions)) < RSSL_RET_SUCCESS
+			|| (ret = decodeValues(pNewBuffer, newValues, &newCount, newPositions)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	rsslClearEncodeIterator(&eIter);
+	rsslSetEncodeIteratorBuffer(&eIter, pOutBuffer);
+	rsslClearFieldList(&fList);
+	fList.flags = RSSL_FLF_HAS_STANDARD_DATA;
+	if ((ret = rsslEncodeFieldListInit(&eIter, &fList, 0, 0)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	if (apply)
+	{
+		for (i = 0; ret >= RSSL_RET_SUCCESS && i < oldCount; ++i)
+		{
+			RsslUInt16 position = newPositions[(RsslUInt16)oldValues[i].fieldId];
+			ret = encodeValue(&eIter, position ? &newValues[position - 1] : &oldValues[i]);
+		}
+		for (i = 0; ret >= RSSL_RET_SUCCESS && i < newCount; ++i)
+		{
+			if (!oldPositions[(RsslUInt16)newValues[i].fieldId])
+				ret = encodeValue(&eIter, &newValues[i]);
+		}
+	}
+	else
+	{
+		for (i = 0; ret >= RSSL_RET_SUCCESS && i < newCount; ++i)
+		{
+			RsslUInt16 position = oldPositions[(RsslUInt16)newValues[i].fieldId];
+			if (!position || !valuesEqual(&oldValues[position - 1], &newValues[i]))
+				ret = encodeValue(&eIter, &newValues[i]);
+		}
+		for (i = 0; ret >= RSSL_RET_SUCCESS && i < oldCount; ++i)
+		{
+			if (!newPositions[(RsslUInt16)oldValues[i].fieldId])
+			{
+				PerfValue blankValue = oldValues[i];
+				blankValue.blank = RSSL_TRUE;
+				ret = encodeValue(&eIter, &blankValue);
+			}
+		}
+	}
+
+	for (i = 0; i < oldCount; ++i)
+		oldPositions[(RsslUInt16)oldValues[i].fieldId] = 0;
+	for (i = 0; i < newCount; ++i)
+		newPositions[(RsslUInt16)newValues[i].fieldId] = 0;
+
+	if (ret < RSSL_RET_SUCCESS || (ret = rsslEncodeFieldListComplete(&eIter, RSSL_TRUE)) < RSSL_RET_SUCCESS)
+		return ret;
+	pOutBuffer->length = rsslGetEncodedBufferLength(&eIter);
+	return RSSL_RET_SUCCESS;
+}
+
+/* The same, by indexing the lists and comparing or copying their encoded entries.  Unless indexOld is set,
+ * the old list's index is the one already built, as it would be for an image kept with its index. */
+static RsslRet encodedDelta(RsslBuffer *pOldBuffer, RsslBuffer *pNewBuffer, RsslBuffer *pOutBuffer, RsslBool apply,
+		RsslFieldListIndex *pOldIndex, RsslFieldListIndex *pNewIndex, RsslBool indexOld)
+{
+	RsslDecodeIterator oldIter, newIter;
+	RsslEncodeIterator eIter;
+	RsslFieldList fList;
+	RsslRet ret;
+
+	if ((indexOld && (ret = buildIndex(pOldBuffer, &oldIter, pOldIndex)) < RSSL_RET_SUCCESS)
+			|| (ret = buildIndex(pNewBuffer, &newIter, pNewIndex)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	rsslClearEncodeIterator(&eIter);
+	rsslSetEncodeIteratorBuffer(&eIter, pOutBuffer);
+	rsslClearFieldList(&fList);
+	fList.flags = RSSL_FLF_HAS_STANDARD_DATA;
+	if ((ret = rsslEncodeFieldListInit(&eIter, &fList, 0, 0)) < RSSL_RET_SUCCESS)
+		return ret;
+
+	ret = apply ? rsslApplyFieldListUpdate(&eIter, pOldIndex, pNewIndex) : rsslEncodeFieldListDelta(&eIter, pOldIndex, pNewIndex);
+	if (ret < RSSL_RET_SUCCESS || (ret = rsslEncodeFieldListComplete(&eIter, RSSL_TRUE)) < RSSL_RET_SUCCESS)
+		return ret;
+	pOutBuffer->length = rsslGetEncodedBufferLength(&eIter);
+	return RSSL_RET_SUCCESS;
+}
+
+/* Compares producing the delta between two images of the refresh, and applying that delta to the first image,
+ * by decoding to typed values against rsslEncodeFieldListDelta() and rsslApplyFieldListUpdate().  The latter are
+ * measured indexing both lists, and indexing only the second, as when the first image is kept with its index. */
+static int runFieldListDeltaTest()
+{
+	char oldMem[2048], newMem[2048], deltaMem[2048], typedMem[2048], encodedMem[2048];
+	char oldIndexMem[RSSL_FIELD_LIST_INDEX_MEMORY_SIZE(REFRESH_FIELD_COUNT)], newIndexMem[RSSL_FIELD_LIST_INDEX_MEMORY_SIZE(REFRESH_FIELD_COUNT)];
+	RsslBuffer oldBuffer = { sizeof(oldMem), oldMem }, newBuffer, deltaBuffer, typedBuffer, encodedBuffer;
+	RsslFieldListIndex oldIndex = RSSL_INIT_FIELD_LIST_INDEX, newIndex = RSSL_INIT_FIELD_LIST_INDEX;
+	static RsslUInt8 changed[65536];
+	int counts[3] = { 3, 10, REFRESH_FIELD_COUNT };
+	int c, i, a;
+
+	for (i = 0; i < REFRESH_FIELD_COUNT; ++i)
+		fieldTypes[(RsslUInt16)refreshFields[i].fieldId] = refreshFields[i].dataType;
+
+	if (encodeRefreshFieldList(&oldBuffer, NULL) != RSSL_RET_SUCCESS)
+	{
+		printf("Failed to encode refresh field list.\n");
+		return -1;
+	}
+
+	oldIndex.memory.data = oldIndexMem;
+	oldIndex.memory.length = sizeof(oldIndexMem);
+	newIndex.memory.data = newIndexMem;
+	newIndex.memory.length = sizeof(newIndexMem);
+
+	printf("Field list delta: %d field refresh of %u bytes, %d iterations\n\n", REFRESH_FIELD_COUNT, oldBuffer.length, iterations);
+	printf("%-8s %-6s %10s %12s %8s %11s %8s %8s\n", "Changes", "Op", "Typed(ns)", "Encoded(ns)", "Speedup", "Indexed(ns)", "Speedup", "Bytes");
+
+	for (c = 0; c < 3; ++c)
+	{
+		memset(changed, 0, sizeof(changed));
+		for (i = 0; i < counts[c]; ++i)
+			changed[(RsslUInt16)((counts[c] == REFRESH_FIELD_COUNT) ? refreshFields[i].fieldId : wantedFields[i])] = 1;
+
+		newBuffer.data = newMem;
+		newBuffer.length = sizeof(newMem);
+		if (encodeRefreshFieldList(&newBuffer, changed) != RSSL_RET_SUCCESS)
+		{
+			printf("Failed to encode refresh field list.\n");
+			return -1;
+		}
+
+		deltaBuffer.data = deltaMem;
+		deltaBuffer.length = sizeof(deltaMem);
+		if (encodedDelta(&oldBuffer, &newBuffer, &deltaBuffer, RSSL_FALSE, &oldIndex, &newIndex, RSSL_TRUE) != RSSL_RET_SUCCESS)
+		{
+			printf("Delta failed.\n");
+			return -1;
+		}
+
+		/* the delta, then the delta applied to the old image */
+		for (a = 0; a < 2; ++a)
+		{
+			RsslBuffer *pSecond = a ? &deltaBuffer : &newBuffer;
+			TimeValue startTime, typedTime, encodedTime, indexedTime;
+
+			startTime = getTimeNano();
+			for (i = 0; i < iterations; ++i)
+			{
+				typedBuffer.data = typedMem;
+				typedBuffer.length = sizeof(typedMem);
+				if (typedDelta(&oldBuffer, pSecond, &typedBuffer, (RsslBool)a) != RSSL_RET_SUCCESS)
+				{
+					printf("Typed delta failed.\n");
+					return -1;
+				}
+			}
+			typedTime = getTimeNano() - startTime;
+
+			startTime = getTimeNano();
+			for (i = 0; i < iterations; ++i)
+			{
+				encodedBuffer.data = encodedMem;
+				encodedBuffer.length = sizeof(encodedMem);
+				if (encodedDelta(&oldBuffer, pSecond, &encodedBuffer, (RsslBool)a, &oldIndex, &newIndex, RSSL_TRUE) != RSSL_RET_SUCCESS)
+				{
+					printf("Encoded delta failed.\n");
+					return -1;
+				}
+			}
+			encodedTime = getTimeNano() - startTime;
+
+			startTime = getTimeNano();
+			for (i = 0; i < iterations; ++i)
+			{
+				encodedBuffer.data = encodedMem;
+				encodedBuffer.length = sizeof(encodedMem);
+				if (encodedDelta(&oldBuffer, pSecond, &encodedBuffer, (RsslBool)a, &oldIndex, &newIndex, RSSL_FALSE) != RSSL_RET_SUCCESS)
+				{
+					printf("Encoded delta failed.\n");
+					return -1;
+				}
+			}
+			indexedTime = getTimeNano() - startTime;
+
+			/* both ways give the same entries, in the same order */
+			if (typedBuffer.length != encodedBuffer.length || memcmp(typedBuffer.data, encodedBuffer.data, typedBuffer.length) != 0)
+			{
+				printf("Typed and encoded results differ.\n");
+				return -1;
+			}
+
+			printf("%-8d %-6s %10.1f %12.1f %7.1fx %11.1f %7.1fx %8u\n", counts[c], a ? "apply" : "delta",
+					(double)typedTime / iterations, (double)encodedTime / iterations, (double)typedTime / (double)encodedTime,
+					(double)indexedTime / iterations, (double)typedTime / (double)indexedTime, encodedBuffer.length);
+		}
+	}
+
+	printf("\n");
+	return 0;
+}
+
+#define REAL_CONVERSION_COUNT 1000
+
+/* Compares converting prices between RsslReal and double one at a time, with rsslRealToDouble() and
+ * rsslDoubleToReal(), against converting the whole array with rsslRealToDoubleBatch() and rsslDoubleToRealBatch(). */
+static int runRealConversionTest()
+{
+	static RsslReal reals[REAL_CONVERSION_COUNT], outReals[REAL_CONVERSION_COUNT];
+	static RsslDouble values[REAL_CONVERSION_COUNT], outValues[REAL_CONVERSION_COUNT];
+	int passes = (iterations + REAL_CONVERSION_COUNT - 1) / REAL_CONVERSION_COUNT;
+	TimeValue startTime, scalarTime, batchTime;
+	int a, i, j;
+
+	/* prices of a few decimal places, as in the refresh's REAL fields */
+	for (i = 0; i < REAL_CONVERSION_COUNT; ++i)
+	{
+		rsslClearReal(&reals[i]);
+		reals[i].hint = (RsslUInt8)((i % 3 == 0) ? RSSL_RH_EXPONENT_4 : RSSL_RH_EXPONENT_2);
+		reals[i].value = 1000 + (i * 7919) % 250000;
+		if (rsslRealToDouble(&values[i], &reals[i]) != RSSL_RET_SUCCESS)
+		{
+			printf("Failed to convert real.\n");
+			return -1;
+		}
+	}
+
+	printf("Real conversion: %d values, %d conversions\n\n", REAL_CONVERSION_COUNT, passes * REAL_CONVERSION_COUNT);
+	printf("%-14s %10s %10s %8s\n", "Op", "Scalar(ns)", "Batch(ns)", "Speedup");
+
+	/* real to double, then double to real */
+	for (a = 0; a < 2; ++a)
+	{
+		startTime = getTimeNano();
+		for (j = 0; j < passes; ++j)
+		{
+			for (i = 0; i < REAL_CONVERSION_COUNT; ++i)
+			{
+				if ((a ? rsslDoubleToReal(&outReals[i], &values[i], RSSL_RH_EXPONENT_4) : rsslRealToDouble(&outValues[i], &reals[i])) != RSSL_RET_SUCCESS)
+				{
+					printf("Scalar conversion failed.\n");
+					return -1;
+				}
+			}
+		}
+		scalarTime = getTimeNano() - startTime;
+
+		startTime = getTimeNano();
+		for (j = 0; j < passes; ++j)
+		{
+			if ((a ? rsslDoubleToRealBatch(outReals, values, REAL_CONVERSION_COUNT, RSSL_RH_EXPONENT_4)
+					: rsslRealToDoubleBatch(outValues, reals, REAL_CONVERSION_COUNT)) != RSSL_RET_SUCCESS)
+			{
+				printf("Batch conversion failed.\n");
+				return -1;
+			}
+		}
+		batchTime = getTimeNano() - startTime;
+
+		/* both ways give the same values */
+		for (i = 0; i < REAL_CONVERSION_COUNT; ++i)
+		{
+			RsslDouble scalarValue;
+			RsslReal scalarReal;
+
+			if (a ? (rsslDoubleToReal(&scalarReal, &values[i], RSSL_RH_EXPONENT_4) != RSSL_RET_SUCCESS || !rsslRealIsEqual(&scalarReal, &outReals[i]))
+					: (rsslRealToDouble(&scalarValue, &reals[i]) != RSSL_RET_SUCCESS || memcmp(&scalarValue, &outValues[i], sizeof(RsslDouble)) != 0))
+			{
+				printf("Scalar and batch results differ.\n");
+				return -1;
+			}
+		}
+
+		printf("%-14s %10.2f %10.2f %7.1fx\n", a ? "doubleToReal" : "realToDouble",
+				(double)scalarTime / (passes * REAL_CONVERSION_COUNT), (double)batchTime / (passes * REAL_CONVERSION_COUNT),
+				(double)scalarTime / (double)batchTime);
+	}
+
+	printf("\n");
+	return 0;
+}
+
+#define STRING_PARSE_COUNT 1000
+
+typedef union {
+	RsslReal		real;
+	RsslDate		date;
+	RsslTime		time;
+	RsslDateTime	dateTime;
+} ParsedValue;
+
+static RsslRet parseString(RsslDataType dataType, RsslBuffer *pString, ParsedValue *pValue)
+{
+	switch (dataType)
+	{
+		case RSSL_DT_REAL: return rsslNumericStringToReal(&pValue->real, pString);
+		case RSSL_DT_DATE: return rsslDateStringToDate(&pValue->date, pString);
+		case RSSL_DT_TIME: return rsslTimeStringToTime(&pValue->time, pString);
+		default: return rsslDateTimeStringToDateTime(&pValue->dateTime, pString);
+	}
+}
+
+/* Compares parsing prices, dates and times from strings with the general parsers against the fast
+ * paths taken for the common formats.  Half of the strings of each type are in ISO 8601 form (or
+ * plain decimals for prices) and half in the form rsslDateTimeToString() gives (or integers). */
+static int runStringParseTest()
+{
+	static char strings[STRING_PARSE_COUNT][40];
+	static RsslBuffer buffers[STRING_PARSE_COUNT];
+	static ParsedValue generalValues[STRING_PARSE_COUNT], fastValues[STRING_PARSE_COUNT];
+	static const RsslDataType dataTypes[] = { RSSL_DT_REAL, RSSL_DT_DATE, RSSL_DT_TIME, RSSL_DT_DATETIME };
+	static const char *typeNames[] = { "Real", "Date", "Time", "DateTime" };
+	static const char *months[] = { "JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC" };
+	int passes = (iterations + STRING_PARSE_COUNT - 1) / STRING_PARSE_COUNT;
+	TimeValue startTime, generalTime, fastTime;
+	int t, f, i, j;
+
+	printf("String parse: %d strings of each type, %d parses\n\n", STRING_PARSE_COUNT, passes * STRING_PARSE_COUNT);
+	printf("%-9s %11s %9s %8s\n", "Type", "General(ns)", "Fast(ns)", "Speedup");
+
+	for (t = 0; t < (int)(sizeof(dataTypes) / sizeof(RsslDataType)); ++t)
+	{
+		for (i = 0; i < STRING_PARSE_COUNT; ++i)
+		{
+			int year = 2000 + i % 25, month = 1 + i % 12, day = 1 + i % 28;
+			int hour = i % 24, minute = (i * 7) % 60, second = (i * 13) % 60, nanos = (i * 7919) % 1000000000;
+
+			switch (dataTypes[t])
+			{
+				case RSSL_DT_REAL:
+					if (i % 2 == 0)
+						snprintf(strings[i], sizeof(strings[i]), "%d.%02d", 10 + (i * 7919) % 25000, i % 100);
+					else
+						snprintf(strings[i], sizeof(strings[i]), "%d", 100 + (i * 104729) % 5000000);
+					break;
+				case RSSL_DT_DATE:
+					if (i % 2 == 0)
+						snprintf(strings[i], sizeof(strings[i]), "%04d-%02d-%02d", year, month, day);
+					else
+						snprintf(strings[i], sizeof(strings[i]), "%02d %s %04d", day, months[month - 1], year);
+					break;
+				case RSSL_DT_TIME:
+					if (i % 2 == 0)
+						snprintf(strings[i], sizeof(strings[i]), "%02d:%02d:%02d.%09d", hour, minute, second, nanos);
+					else
+						snprintf(strings[i], sizeof(strings[i]), "%02d:%02d:%02d:%03d:%03d:%03d", hour, minute, second,
+								nanos / 1000000, nanos / 1000 % 1000, nanos % 1000);
+					break;
+				default:
+					if (i % 2 == 0)
+						snprintf(strings[i], sizeof(strings[i]), "%04d-%02d-%02dT%02d:%02d:%02d.%09d", year, month, day,
+								hour, minute, second, nanos);
+					else
+						snprintf(strings[i], sizeof(strings[i]), "%02d %s %04d %02d:%02d:%02d:%03d:%03d:%03d", day, months[month - 1],
+								year, hour, minute, second, nanos / 1000000, nanos / 1000 % 1000, nanos % 1000);
+					break;
+			}
+			buffers[i].data = strings[i];
+			buffers[i].length = (RsslUInt32)strlen(strings[i]);
+		}
+
+		/* general parsing, then the fast paths */
+		for (f = 0; f < 2; ++f)
+		{
+			ParsedValue *pValues = f ? fastValues : generalValues;
+
+			memset(pValues, 0, sizeof(ParsedValue) * STRING_PARSE_COUNT);
+			rwfFastStringParsing = (RsslBool)f;
+
+			startTime = getTimeNano();
+			for (j = 0; j < passes; ++j)
+			{
+				for (i = 0; i < STRING_PARSE_COUNT; ++i)
+				{
+					if (parseString(dataTypes[t], &buffers[i], &pValues[i]) != RSSL_RET_SUCCESS)
+					{
+						printf("Failed to parse '%s'.\n", strings[i]);
+						return -1;
+					}
+				}
+			}
+			if (f)
+				fastTime = getTimeNano() - startTime;
+			else
+				generalTime = getTimeNano() - startTime;
+		}
+
+		/* both ways give the same values */
+		if (memcmp(generalValues, fastValues, sizeof(ParsedValue) * STRING_PARSE_COUNT) != 0)
+		{
+			printf("General and fast results differ.\n");
+			return -1;
+		}
+
+		printf("%-9s %11.1f %9.1f %7.1fx\n", typeNames[t],
+				(double)generalTime / (passes * STRING_PARSE_COUNT), (double)fastTime / (passes * STRING_PARSE_COUNT),
+				(double)generalTime / (double)fastTime);
+	}
+
+	printf("\n");
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	parseArgs(argc, argv);
+
+	if ((testMask & TEST_FIELD_LIST_INDEX) && runFieldListIndexTest() < 0)
+		return -1;
+
+	if ((testMask & TEST_FIELD_LIST_TEMPLATE) && runFieldListTemplateTest() < 0)
+		return -1;
+
+	if ((testMask & TEST_FIELD_LIST_DELTA) && runFieldListDeltaTest() < 0)
+		return -1;
+
+	if ((testMask & TEST_REAL_CONVERSION) && runRealConversionTest() < 0)
+		return -1;
+
+	if ((testMask & TEST_STRING_PARSE) && runStringParseTest() < 0)
+		return -1;
+
+	return 0;
+}
@@ -133,6 +133,8 @@ RsslRet channelHandlerReadChannel(ChannelHandler *pHandler, ChannelInfo *pChanne
 			/* Mark that we received data for ping timeout handling. */
 			pChannelInfo->receivedMsg = RSSL_TRUE;
 
+			pChannelInfo->recvTimestamp = (readOutArgs.readOutFlags & RSSL_READ_OUT_RECV_TIMESTAMP) ? readOutArgs.recvTimestamp : 0;
+
 			/* Received an RsslBuffer, call the application's processing function. */
 			if ((pHandler->msgCallback)(pHandler, pChannelInfo, pMsgBuf) < RSSL_RET_SUCCESS)
 			{
@@ -252,11 +254,12 @@ void channelHandlerReadChannels(ChannelHandler *pHandler, TimeValue stopTimeNsec
 	/* Loop on select(), looking for channels with available data, until stopTimeNsec is reached. */
 	do
 	{
-
+		TimeValue wakeTimeNsec = stopTimeNsec;
 
 #ifdef WIN32
 		/* Windows does not allow select() to be called with empty file descriptor sets. */
-		if (rsslQueueGetElementCount(&pHandler->initializingChannelList) + rsslQueueGetElementCount(&pHandler->activeChannelList) == 0)
+		if (rsslQueueGetElementCount(&pHandler->initializingChannelList) + rsslQueueGetElementCount(&pHandler->activeChannelList) == 0
+				&& !pHandler->pServer)
 		{
 			currentTime = getTimeNano();
 			selRet = 0;
@@ -273,11 +276,25 @@ void channelHandlerReadChannels(ChannelHandler *pHandler, TimeValue stopTimeNsec
 			FD_ZERO(&useExceptFds);
 			FD_ZERO(&useWriteFds);
 
+			currentTime = getTimeNano();
+
 			/* Add active channels to the descriptor sets. */
 			RSSL_QUEUE_FOR_EACH_LINK(&pHandler->activeChannelList, pLink)
 			{
 				ChannelInfo *pChannelInfo = RSSL_QUEUE_LINK_TO_OBJECT(ChannelInfo, queueLink, pLink);
 
+				/* Start any flush that was waiting for the channel's coalescing time to pass. */
+				if (pChannelInfo->flushTime)
+				{
+					if (pChannelInfo->flushTime <= currentTime)
+					{
+						pChannelInfo->flushTime = 0;
+						pChannelInfo->needFlush = RSSL_TRUE;
+					}
+					else if (pChannelInfo->flushTime < wakeTimeNsec)
+						wakeTimeNsec = pChannelInfo->flushTime;
+				}
+
 				FD_SET(pChannelInfo->pChannel->socketId, &useReadFds);
 				FD_SET(pChannelInfo->pChannel->socketId, &useExceptFds);
 
@@ -303,15 +320,29 @@ void channelHandlerReadChannels(ChannelHandler *pHandler, TimeValue stopTimeNsec
 					FD_SET(pChannelInfo->pChannel->socketId, &useWriteFds);
 			}
 
+			/* Add the server, if connections are accepted on this thread. */
+			if (pHandler->pServer)
+			{
+				FD_SET(pHandler->pServer->socketId, &useReadFds);
+
+				if (pHandler->pServer->socketId > maxFd)
+					maxFd = pHandler->pServer->socketId;
+			}
+
 			currentTime = getTimeNano();
-			time_interval.tv_usec = (long)((currentTime < stopTimeNsec) ? (stopTimeNsec - currentTime)/1000 : 0);
+			time_interval.tv_usec = (long)((currentTime < wakeTimeNsec) ? (wakeTimeNsec - currentTime)/1000 : 0);
 			time_interval.tv_sec = 0;
 
 			selRet = select((int)(maxFd+1), &useReadFds, &useWriteFds, &useExceptFds, &time_interval);
 		}
 
 		if (selRet == 0)
+		{
+			/* Woken early to start a waiting flush; keep going until stopTimeNsec. */
+			if (wakeTimeNsec < stopTimeNsec)
+				continue;
 			return;
+		}
 		else if (selRet > 0)
 		{
 
@@ -344,6 +375,17 @@ void channelHandlerReadChannels(ChannelHandler *pHandler, TimeValue stopTimeNsec
 						/* rsslFlush() returned 0 instead of a higher value, so there's no more data to flush. */
 						_flushDone(pHandler, pChannelInfo);
 					}
+					else if (pChannelInfo->coalesceWriteUsec)
+					{
+						RsslChannelInfo channelInfo;
+
+						/* The transport is still holding the data for its coalescing time; wait for that to pass. */
+						if (rsslGetChannelInfo(pChannel, &channelInfo, &error) == RSSL_RET_SUCCESS && channelInfo.coalesceFlushUsec)
+						{
+							pChannelInfo->needFlush = RSSL_FALSE;
+							pChannelInfo->flushTime = getTimeNano() + (TimeValue)channelInfo.coalesceFlushUsec * 1000;
+						}
+					}
 				}
 			}
 
@@ -363,6 +405,10 @@ void channelHandlerReadChannels(ChannelHandler *pHandler, TimeValue stopTimeNsec
 					channelHandlerInitializeChannel(pHandler, pChannelInfo);
 				}
 			}
+
+			/* Accept a new connection.  It is added to the initializing list by the callback. */
+			if (pHandler->pServer && FD_ISSET(pHandler->pServer->socketId, &useReadFds))
+				pHandler->serverAcceptCallback(pHandler, pHandler->pServer);
 		}
 #ifdef WIN32
 		else if (WSAGetLastError() != WSAEINTR)
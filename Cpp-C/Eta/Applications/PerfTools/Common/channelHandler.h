@@ -41,10 +41,13 @@ typedef struct {
 	RsslReactorChannel	*pReactorChannel;		/* Used for when application uses VA Reactor instead of UPA Channel. */
 	void				*pUserSpec;				/* Pointer to user-specified data associated with this channel. */
 	RsslBool			needFlush;				/* Whether this channel needs to have data flushed. */
+	RsslUInt32			coalesceWriteUsec;		/* If set, a requested flush waits this long so that more writes go out with it. See RSSL_COALESCE_WRITE_USEC. */
+	TimeValue			flushTime;				/* Time at which a waiting flush starts, 0 if none is waiting. */
 	RsslBool			receivedMsg;			/* Whether a ping or messages have been received since the last ping check. */
 	RsslBool			checkPings;				/* Whether ping handling is done for this channel. */
 	TimeValue			nextReceivePingTime;	/* Time before which this channel should receive a ping. */
 	TimeValue			nextSendPingTime;		/* Time before which a ping should be sent for this channel. */
+	RsslUInt64			recvTimestamp;			/* Kernel receive time (nsec since the epoch) of the buffer being processed, 0 if not known. See RSSL_RECV_TIMESTAMPS. */
 	RsslQueue			*parentQueue;			/* Pointer back to the list this channel is an element of. */
 } ChannelInfo;
 
@@ -59,6 +62,7 @@ typedef struct _ChannelHandler ChannelHandler;
 typedef RsslRet ChannelActiveCallback(ChannelHandler*, ChannelInfo*);
 typedef RsslRet MsgCallback(ChannelHandler*, ChannelInfo*, RsslBuffer*);
 typedef void ChannelInactiveCallback(ChannelHandler*, ChannelInfo*, RsslError*);
+typedef void ServerAcceptCallback(ChannelHandler*, RsslServer*);
 
 /* Maintains a list of open RsslChannels and handles transport-related functionality on them
  * such as reading, initializing, flushing, and pings. */
@@ -69,12 +73,22 @@ struct _ChannelHandler {
 	void					*pUserSpec;					/* Pointer to application-specified data. */
 	ChannelActiveCallback	*channelActiveCallback;		/* Function to be called when a channel finishes initializing and becomes active. */
 	ChannelInactiveCallback	*channelInactiveCallback;	/* Function to be called when a channel is closed. */
+	RsslServer				*pServer;					/* Server whose connections are accepted on this handler's thread, if any. */
+	ServerAcceptCallback	*serverAcceptCallback;		/* Function to be called when pServer has a connection to accept. */
 };
 
 /* Requests that the ChannelHandler begin calling rsslFlush() for a channel.  Used when a call to rsslWrite()
- * indicates there is still data to be written to the network. */
+ * indicates there is still data to be written to the network.  If the channel is coalescing writes, flushing
+ * begins once its coalescing time has passed. */
 RTR_C_INLINE void channelHandlerRequestFlush(ChannelHandler *pHandler, ChannelInfo *pChannelInfo)
 {
+	if (pChannelInfo->coalesceWriteUsec && !pChannelInfo->needFlush)
+	{
+		if (!pChannelInfo->flushTime)
+			pChannelInfo->flushTime = getTimeNano() + (TimeValue)pChannelInfo->coalesceWriteUsec * 1000;
+		return;
+	}
+
 	pChannelInfo->needFlush = RSSL_TRUE;
 }
 
@@ -91,6 +105,17 @@ RTR_C_INLINE void initChannelHandler(ChannelHandler *pHandler,
 	pHandler->channelInactiveCallback = channelInactiveCallback;
 	pHandler->msgCallback = msgCallback;
 	pHandler->pUserSpec = pUserSpec;
+	pHandler->pServer = NULL;
+	pHandler->serverAcceptCallback = NULL;
+}
+
+/* Has the ChannelHandler watch a server while reading its channels, calling serverAcceptCallback
+ * when there is a connection to accept. */
+RTR_C_INLINE void channelHandlerSetServer(ChannelHandler *pHandler, RsslServer *pServer,
+		ServerAcceptCallback *serverAcceptCallback)
+{
+	pHandler->pServer = pServer;
+	pHandler->serverAcceptCallback = serverAcceptCallback;
 }
 
 /* Cleans up a ChannelHandler. */
@@ -103,7 +128,7 @@ ChannelInfo *channelHandlerAddChannel(ChannelHandler *pHandler, RsslChannel *pCh
 void channelHandlerCloseChannel(ChannelHandler *pHandler, ChannelInfo *pChannelInfo, RsslError *pError);
 
 /* Tries to read data from channels until stopTimeNsec is reached(stopTimeNsec should be based on getTimeNano()). 
- * Also initializes any new channels. */
+ * Also initializes any new channels, and accepts connections on the server, if one is set. */
 void channelHandlerReadChannels(ChannelHandler *pHandler, TimeValue stopTimeNsec);
 
 /* Try to initialize a single channel. */
@@ -185,6 +185,7 @@ void providerThreadInit(ProviderThread *pProvThread,
 	char tmpFilename[sizeof(providerThreadConfig.statsFilename) + 8];
 
 	timeRecordQueueInit(&pProvThread->genMsgLatencyRecords);
+	timeRecordQueueInit(&pProvThread->channelInitTimeRecords);
 
 	/* Load dictionary from file if possible. */
 	pProvThread->pDictionary = NULL;
@@ -218,6 +219,10 @@ void providerThreadInit(ProviderThread *pProvThread,
 	initCountStat(&pProvThread->outOfBuffersCount);
 	initCountStat(&pProvThread->msgSentCount);
 	initCountStat(&pProvThread->bufferSentCount);
+	initCountStat(&pProvThread->acceptedChannelCount);
+	initCountStat(&pProvThread->writeSysCallCount);
+	initCountStat(&pProvThread->autoPackedMsgCount);
+	initCountStat(&pProvThread->autoPackedBufCount);
 	initCountStat(&pProvThread->stats.genMsgSentCount);
 	initCountStat(&pProvThread->stats.genMsgRecvCount);
 	initCountStat(&pProvThread->stats.latencyGenMsgSentCount);
@@ -288,6 +293,7 @@ void providerThreadInit(ProviderThread *pProvThread,
 static void providerThreadCleanup(ProviderThread *pProvThread)
 {
 	timeRecordQueueCleanup(&pProvThread->genMsgLatencyRecords);
+	timeRecordQueueCleanup(&pProvThread->channelInitTimeRecords);
 	if (pProvThread->pDictionary)
 	{
 		rsslDeleteDataDictionary(pProvThread->pDictionary);
@@ -325,8 +331,12 @@ ProviderSession *providerSessionCreate(ProviderThread *pProvThread, RsslChannel
 	pSession->openItemsCount = 0;
 	pSession->pWritingBuffer = 0;
 	pSession->packedBufferCount = 0;
+	pSession->timeCreated = getTimeNano();
 	pSession->timeActivated = 0;
 	pSession->lastWriteRet = 0;
+	pSession->lastWriteSysCalls = 0;
+	pSession->lastAutoPackedMsgs = 0;
+	pSession->lastAutoPackedBufs = 0;
 
 
 	hashTableInit(&pSession->itemAttributesTable, 
@@ -1357,11 +1367,27 @@ void providerThreadReceiveNewChannels(ProviderThread *pProvThread)
 				exit(-1);
 			}
 
+			countStatIncr(&pProvThread->acceptedChannelCount);
 			free(pNewChannel);
 		}
 	} while (pLink);
 }
 
+void providerThreadAcceptNewChannel(ProviderThread *pProvThread, RsslChannel *pChannel)
+{
+	RSSL_MUTEX_LOCK(&pProvThread->newClientSessionsLock);
+	++pProvThread->clientSessionsCount;
+	RSSL_MUTEX_UNLOCK(&pProvThread->newClientSessionsLock);
+
+	if (!providerSessionCreate(pProvThread, pChannel))
+	{
+		printf("providerSessionCreate() failed\n");
+		exit(-1);
+	}
+
+	countStatIncr(&pProvThread->acceptedChannelCount);
+}
+
 void providerInit(Provider *pProvider, ProviderType providerType,
 		ChannelActiveCallback *processActiveChannel,
 		ChannelInactiveCallback *processInactiveChannel,
@@ -1381,6 +1407,9 @@ void providerInit(Provider *pProvider, ProviderType providerType,
 	initCountStat(&pProvider->outOfBuffersCount);
 	initCountStat(&pProvider->msgSentCount);
 	initCountStat(&pProvider->bufferSentCount);
+	initCountStat(&pProvider->writeSysCallCount);
+	initCountStat(&pProvider->autoPackedMsgCount);
+	initCountStat(&pProvider->autoPackedBufCount);
 
 	initCountStat(&pProvider->mcastPacketSentCount);
 	initCountStat(&pProvider->mcastPacketReceivedCount);
@@ -1499,12 +1528,39 @@ void providerThreadSendMsgBurst(ProviderThread *pProvThread, RsslUInt64 stopTime
 	}
 }
 
+void providerThreadTakeWriteStats(ProviderThread *pProvThread)
+{
+	RsslQueueLink *pLink;
+
+	RSSL_QUEUE_FOR_EACH_LINK(&pProvThread->channelHandler.activeChannelList, pLink)
+	{
+		ChannelInfo *pChannelInfo = RSSL_QUEUE_LINK_TO_OBJECT(ChannelInfo, queueLink, pLink);
+		ProviderSession *pSession = (ProviderSession*)pChannelInfo->pUserSpec;
+		RsslChannelInfo chnlInfo;
+		RsslError error;
+
+		if (pChannelInfo->pChannel == NULL || pChannelInfo->pChannel->state != RSSL_CH_STATE_ACTIVE)
+			continue;
+
+		if (rsslGetChannelInfo(pChannelInfo->pChannel, &chnlInfo, &error) != RSSL_RET_SUCCESS)
+			continue;
+
+		countStatAdd(&pProvThread->writeSysCallCount, chnlInfo.writeSysCalls - pSession->lastWriteSysCalls);
+		pSession->lastWriteSysCalls = chnlInfo.writeSysCalls;
+		countStatAdd(&pProvThread->autoPackedMsgCount, chnlInfo.autoPackedMsgs - pSession->lastAutoPackedMsgs);
+		pSession->lastAutoPackedMsgs = chnlInfo.autoPackedMsgs;
+		countStatAdd(&pProvThread->autoPackedBufCount, chnlInfo.autoPackedBufs - pSession->lastAutoPackedBufs);
+		pSession->lastAutoPackedBufs = chnlInfo.autoPackedBufs;
+	}
+}
+
 void providerCollectStats(Provider *pProvider, RsslBool writeStats, RsslBool displayStats, RsslUInt32 currentRuntimeSec,
 		RsslUInt32 timePassedSec)
 {
 	RsslInt32 i;
 	RsslUInt64 refreshCount, updateCount, requestCount, closeCount, postCount, genMsgSentCount, genMsgRecvCount,
-			   latencyGenMsgSentCount, latencyGenMsgRecvCount, outOfBuffersCount, msgSentCount, bufferSentCount;
+			   latencyGenMsgSentCount, latencyGenMsgRecvCount, outOfBuffersCount, msgSentCount, bufferSentCount,
+			   writeSysCallCount;
 	RsslQueue latencyRecords;
 
 	rsslInitQueue(&latencyRecords);
@@ -1555,6 +1611,7 @@ void providerCollectStats(Provider *pProvider, RsslBool writeStats, RsslBool dis
 		closeCount = countStatGetChange(&pProviderThread->closeMsgCount);
 		postCount = countStatGetChange(&pProviderThread->postMsgCount);
 		outOfBuffersCount = countStatGetChange(&pProviderThread->outOfBuffersCount);
+		writeSysCallCount = countStatGetChange(&pProviderThread->writeSysCallCount);
 	
 		if (writeStats)
 		{
@@ -1600,6 +1657,9 @@ void providerCollectStats(Provider *pProvider, RsslBool writeStats, RsslBool dis
 		countStatAdd(&totalStats.genMsgSentCount, genMsgSentCount);
 		countStatAdd(&totalStats.latencyGenMsgSentCount, latencyGenMsgSentCount);
 		countStatAdd(&pProvider->outOfBuffersCount, outOfBuffersCount);
+		countStatAdd(&pProvider->writeSysCallCount, writeSysCallCount);
+		countStatAdd(&pProvider->autoPackedMsgCount, countStatGetChange(&pProviderThread->autoPackedMsgCount));
+		countStatAdd(&pProvider->autoPackedBufCount, countStatGetChange(&pProviderThread->autoPackedBufCount));
 
 		/* Take packing stats, if packing is enabled. */
 		if (providerThreadConfig.totalBuffersPerPack > 1)
@@ -1621,6 +1681,11 @@ void providerCollectStats(Provider *pProvider, RsslBool writeStats, RsslBool dis
 					updateCount/timePassedSec,
 					pProvider->resourceStats.cpuUsageFraction * 100.0f, (double)pProvider->resourceStats.memUsageBytes / 1048576.0);
 
+			if (writeSysCallCount > 0)
+				printf("  - Write syscalls/sec: %llu, approx. msgs per syscall: %.1f\n",
+						writeSysCallCount/timePassedSec,
+						(double)(refreshCount + updateCount + genMsgSentCount)/(double)writeSysCallCount);
+
 			switch(pProvider->providerType)
 			{
 				case PROVIDER_INTERACTIVE:
@@ -1674,6 +1739,14 @@ void providerCollectStats(Provider *pProvider, RsslBool writeStats, RsslBool dis
 			{
 				printf("  - Approx. avg msgs per pack: %.0f\n", (double)msgSentCount/(double)bufferSentCount);
 			}
+
+			/* Print transport packing stats, if the transport is packing. */
+			msgSentCount = countStatGetChange(&pProvider->autoPackedMsgCount);
+			bufferSentCount = countStatGetChange(&pProvider->autoPackedBufCount);
+			if (bufferSentCount > 0)
+			{
+				printf("  - Approx. avg msgs per transport pack: %.1f\n", (double)msgSentCount/(double)bufferSentCount);
+			}
 		}
 
 		if(providerThreadConfig.takeMCastStats)
@@ -1891,6 +1964,21 @@ void providerPrintSummaryStats(Provider *pProvider, FILE *file)
 			break;
 	}
 
+	if (countStatGetTotal(&pProvider->writeSysCallCount))
+	{
+		fprintf(file, "  Write syscalls: %llu\n", countStatGetTotal(&pProvider->writeSysCallCount));
+		fprintf(file, "  Approx. msgs per write syscall: %.1f\n",
+				(double)(countStatGetTotal(&pProvider->refreshCount) + countStatGetTotal(&pProvider->updateCount)
+					+ countStatGetTotal(&totalStats.genMsgSentCount)) / (double)countStatGetTotal(&pProvider->writeSysCallCount));
+	}
+
+	if (countStatGetTotal(&pProvider->autoPackedBufCount))
+	{
+		fprintf(file, "  Msgs packed by transport: %llu\n", countStatGetTotal(&pProvider->autoPackedMsgCount));
+		fprintf(file, "  Approx. msgs per transport pack: %.1f\n",
+				(double)countStatGetTotal(&pProvider->autoPackedMsgCount) / (double)countStatGetTotal(&pProvider->autoPackedBufCount));
+	}
+
 	if (pProvider->cpuUsageStats.count)
 	{
 		assert(pProvider->memUsageStats.count);
@@ -135,6 +135,11 @@ typedef struct
 	RsslQueue				newClientSessionsList;	/* List of any new channels to add. */
 	RsslMutex				newClientSessionsLock;	/* Lock for newClientSessionsList. */
 	RsslInt32				clientSessionsCount;	/* Number of channels in use. */
+	CountStat				acceptedChannelCount;	/* Counts channels accepted by or given to this thread. */
+	CountStat				writeSysCallCount;		/* Counts write system calls made on this thread's channels. See providerThreadTakeWriteStats(). */
+	CountStat				autoPackedMsgCount;		/* Counts messages packed by the transport on this thread's channels. */
+	CountStat				autoPackedBufCount;		/* Counts buffers packed by the transport on this thread's channels. */
+	TimeRecordQueue			channelInitTimeRecords;	/* Time from accepting each channel until it became active, collected periodically by the main thread. */
 	RsslThreadId			threadId;				/* Thread ID. */
 	RsslInt32				cpuId;					/* CPU to bind to, if any. */
 	ChannelHandler			channelHandler;			/* Channel handler. */
@@ -172,8 +177,12 @@ typedef struct {
 	ProviderThread	*pProviderThread;
 	RsslBuffer		*pWritingBuffer;		/* Current buffer in use by this channel. */
 	RsslInt32		packedBufferCount;		/* Total number of buffers currently packed in pWritingBuffer */
+	TimeValue		timeCreated;			/* Time at which this session was created for its accepted channel. */
 	TimeValue		timeActivated;			/* Time at which this channel was fully setup. */
 	RsslRet			lastWriteRet;			/* Last return from an rsslWrite call. */
+	RsslUInt64		lastWriteSysCalls;		/* RsslChannelInfo::writeSysCalls when it was last sampled. */
+	RsslUInt64		lastAutoPackedMsgs;		/* RsslChannelInfo::autoPackedMsgs when it was last sampled. */
+	RsslUInt64		lastAutoPackedBufs;		/* RsslChannelInfo::autoPackedBufs when it was last sampled. */
 
 	RsslBuffer		*preEncMarketPriceMsgs;		/* Buffer of a pre-encoded market price message, if sending pre-encoded items;  This is allocated per-channel in case the versions are different */
 	RsslBuffer		*preEncMarketByOrderMsgs;	/* Buffer of a pre-encoded market by order message, if sending pre-encoded items;  This is allocated per-channel in case the versions are different */
@@ -279,6 +288,13 @@ void providerThreadSendNewChannel(ProviderThread *pProvThread, RsslChannel *pCha
 /* Provider thread method for adding new channels. */
 void providerThreadReceiveNewChannels(ProviderThread *pProvThread);
 
+/* Adds a channel accepted on the provider thread itself. */
+void providerThreadAcceptNewChannel(ProviderThread *pProvThread, RsslChannel *pChannel);
+
+/* Samples the number of write system calls made on a provider thread's channels.  It is
+ * called by the provider thread itself, about once per second. */
+void providerThreadTakeWriteStats(ProviderThread *pProvThread);
+
 /* Get the current number of channels open on a provider thread. */
 RsslInt32 providerThreadGetConnectionCount(ProviderThread *pProvThread);
 
@@ -331,6 +347,9 @@ typedef struct
 												 * output buffers. */
 	CountStat msgSentCount;						/* Count of total messages sent(used w/ packing). */
 	CountStat bufferSentCount;					/* Count of total number of buffers sent(used w/ packing). */
+	CountStat writeSysCallCount;				/* Count of write system calls. */
+	CountStat autoPackedMsgCount;				/* Count of messages packed by the transport(-autoPackSize). */
+	CountStat autoPackedBufCount;				/* Count of buffers packed by the transport(-autoPackSize). */
 
 	ValueStatistics msgEncodingStats;
 	ValueStatistics intervalMsgEncodingStats;
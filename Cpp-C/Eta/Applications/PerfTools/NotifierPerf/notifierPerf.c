@@ -0,0 +1,278 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+/* notifierPerf.c
+ * Measures the cost of waking up an RsslNotifier as the number of registered descriptors grows,
+ * for each notification mechanism (see RsslNotifierType). */
+
+#include "rtr/rsslNotifier.h"
+#include "getTime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef Linux
+#include <sys/eventfd.h>
+#endif
+
+#define MAX_FD_COUNTS 16
+
+static int fdCounts[MAX_FD_COUNTS] = { 10, 1000, 10000 };
+static int fdCountCount = 3;
+static int iterations = 100000;
+static int typeMask = (1 << RSSL_NOTIFIER_TYPE_POLL) | (1 << RSSL_NOTIFIER_TYPE_EPOLL) | (1 << RSSL_NOTIFIER_TYPE_EPOLL_EDGE);
+
+static const char *notifierTypeToString(RsslNotifierType notifierType)
+{
+	switch(notifierType)
+	{
+		case RSSL_NOTIFIER_TYPE_POLL: return "poll";
+		case RSSL_NOTIFIER_TYPE_EPOLL: return "epoll";
+		case RSSL_NOTIFIER_TYPE_EPOLL_EDGE: return "epollEdge";
+		default: return "default";
+	}
+}
+
+static void exitWithUsage()
+{
+	printf(	"Options:\n"
+			"  -fdCounts <list>      Comma-separated numbers of descriptors to register (default 10,1000,10000).\n"
+			"  -iterations <count>   Number of wake-ups measured for each test (default 100000).\n"
+			"  -type <list>          Comma-separated notifier types to test: poll, epoll, epollEdge (default all).\n"
+			"\n");
+	exit(-1);
+}
+
+static void parseArgs(int argc, char **argv)
+{
+	int i;
+	char *pToken, *saveptr;
+
+	for (i = 1; i < argc; ++i)
+	{
+		if (strcmp("-fdCounts", argv[i]) == 0 && i + 1 < argc)
+		{
+			fdCountCount = 0;
+			for (pToken = strtok_r(argv[++i], ",", &saveptr); pToken != NULL && fdCountCount < MAX_FD_COUNTS; 
+					pToken = strtok_r(NULL, ",", &saveptr))
+			{
+				if ((fdCounts[fdCountCount++] = atoi(pToken)) <= 0)
+					exitWithUsage();
+			}
+		}
+		else if (strcmp("-iterations", argv[i]) == 0 && i + 1 < argc)
+		{
+			if ((iterations = atoi(argv[++i])) <= 0)
+				exitWithUsage();
+		}
+		else if (strcmp("-type", argv[i]) == 0 && i + 1 < argc)
+		{
+			typeMask = 0;
+			for (pToken = strtok_r(argv[++i], ",", &saveptr); pToken != NULL; pToken = strtok_r(NULL, ",", &saveptr))
+			{
+				if (strcmp(pToken, "poll") == 0) typeMask |= (1 << RSSL_NOTIFIER_TYPE_POLL);
+				else if (strcmp(pToken, "epoll") == 0) typeMask |= (1 << RSSL_NOTIFIER_TYPE_EPOLL);
+				else if (strcmp(pToken, "epollEdge") == 0) typeMask |= (1 << RSSL_NOTIFIER_TYPE_EPOLL_EDGE);
+				else exitWithUsage();
+			}
+		}
+		else
+		{
+			printf("Unknown option: %s\n", argv[i]);
+			exitWithUsage();
+		}
+	}
+}
+
+/* Creates a descriptor that can be signaled for reading. An eventfd is used where available, since it needs
+ * only one descriptor; otherwise a pipe is used. */
+static int createSignalFds(int fds[2])
+{
+#ifdef Linux
+	if ((fds[0] = fds[1] = eventfd(0, 0)) < 0)
+		return -1;
+	return 0;
+#else
+	return pipe(fds);
+#endif
+}
+
+static int signalFds(int fds[2])
+{
+#ifdef Linux
+	unsigned long long value = 1;
+	return (write(fds[1], &value, sizeof(value)) == sizeof(value)) ? 0 : -1;
+#else
+	char byte = 0;
+	return (write(fds[1], &byte, 1) == 1) ? 0 : -1;
+#endif
+}
+
+static int clearSignalFds(int fds[2])
+{
+#ifdef Linux
+	unsigned long long value;
+	return (read(fds[0], &value, sizeof(value)) == sizeof(value)) ? 0 : -1;
+#else
+	char byte;
+	return (read(fds[0], &byte, 1) == 1) ? 0 : -1;
+#endif
+}
+
+static void closeSignalFds(int fds[2])
+{
+	close(fds[0]);
+	if (fds[1] != fds[0])
+		close(fds[1]);
+}
+
+/* Registers fdCount descriptors for read notification, then repeatedly writes to one of them and measures
+ * how long rsslNotifierWait takes to report it. Also measures a wait that finds nothing to report. */
+static int runTest(RsslNotifierType notifierType, int fdCount)
+{
+	RsslNotifier *pNotifier;
+	RsslNotifierEvent **pEvents;
+	int (*pipeFds)[2];
+	int i, created = 0;
+	TimeValue startTime, endTime, totalTime = 0, minTime = (TimeValue)-1, maxTime = 0, idleTime;
+	int ret = -1;
+
+	if ((pNotifier = rsslCreateNotifierEx(fdCount, notifierType)) == NULL)
+	{
+		printf("Failed to create notifier.\n");
+		return -1;
+	}
+
+	if (rsslNotifierGetType(pNotifier) != notifierType)
+	{
+		printf("%-10s %8d  (not available)\n", notifierTypeToString(notifierType), fdCount);
+		rsslDestroyNotifier(pNotifier);
+		return 0;
+	}
+
+	pEvents = (RsslNotifierEvent**)calloc(fdCount, sizeof(RsslNotifierEvent*));
+	pipeFds = (int(*)[2])calloc(fdCount, sizeof(*pipeFds));
+	if (pEvents == NULL || pipeFds == NULL)
+	{
+		printf("Failed to allocate memory for %d descriptors.\n", fdCount);
+		goto cleanup;
+	}
+
+	for (created = 0; created < fdCount; ++created)
+	{
+		if (createSignalFds(pipeFds[created]) < 0)
+		{
+			printf("Failed to create descriptor %d of %d (try raising the open file limit).\n", created + 1, fdCount);
+			goto cleanup;
+		}
+
+		if ((pEvents[created] = rsslCreateNotifierEvent()) == NULL
+				|| rsslNotifierAddEvent(pNotifier, pEvents[created], pipeFds[created][0], &pipeFds[created]) < 0
+				|| rsslNotifierRegisterRead(pNotifier, pEvents[created]) < 0)
+		{
+			++created;
+			printf("Failed to add notifier event %d of %d.\n", created, fdCount);
+			goto cleanup;
+		}
+	}
+
+	for (i = 0; i < iterations; ++i)
+	{
+		int index = (int)(((long long)i * 7919) % fdCount);
+
+		if (signalFds(pipeFds[index]) < 0)
+		{
+			printf("Failed to signal descriptor.\n");
+			goto cleanup;
+		}
+
+		startTime = getTimeNano();
+		if (rsslNotifierWait(pNotifier, 1000000) != 1 || pNotifier->notifiedEventCount != 1
+				|| rsslNotifierEventGetObject(pNotifier->notifiedEvents[0]) != &pipeFds[index])
+		{
+			printf("Unexpected notification.\n");
+			goto cleanup;
+		}
+		endTime = getTimeNano();
+
+		if (clearSignalFds(pipeFds[index]) < 0)
+		{
+			printf("Failed to read from descriptor.\n");
+			goto cleanup;
+		}
+
+		totalTime += endTime - startTime;
+		if (endTime - startTime < minTime) minTime = endTime - startTime;
+		if (endTime - startTime > maxTime) maxTime = endTime - startTime;
+	}
+
+	startTime = getTimeNano();
+	for (i = 0; i < iterations; ++i)
+		rsslNotifierWait(pNotifier, 0);
+	idleTime = getTimeNano() - startTime;
+
+	printf("%-10s %8d %12.3f %12.3f %12.3f %12.3f\n", notifierTypeToString(notifierType), fdCount,
+			(double)totalTime / iterations / 1000.0, (double)minTime / 1000.0, (double)maxTime / 1000.0,
+			(double)idleTime / iterations / 1000.0);
+	ret = 0;
+
+cleanup:
+	for (i = 0; i < created; ++i)
+	{
+		if (pEvents[i] != NULL)
+		{
+			rsslNotifierRemoveEvent(pNotifier, pEvents[i]);
+			rsslDestroyNotifierEvent(pEvents[i]);
+		}
+		closeSignalFds(pipeFds[i]);
+	}
+	free(pEvents);
+	free(pipeFds);
+	rsslDestroyNotifier(pNotifier);
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	struct rlimit fdLimit;
+	int maxFdCount = 0;
+	int i, type;
+
+	parseArgs(argc, argv);
+
+	/* Each registered descriptor may use a pipe. Make sure the process can open enough of them. */
+	for (i = 0; i < fdCountCount; ++i)
+		if (fdCounts[i] > maxFdCount)
+			maxFdCount = fdCounts[i];
+
+	if (getrlimit(RLIMIT_NOFILE, &fdLimit) == 0 && fdLimit.rlim_cur < (rlim_t)(maxFdCount * 2 + 64))
+	{
+		fdLimit.rlim_cur = (rlim_t)(maxFdCount * 2 + 64);
+		if (fdLimit.rlim_cur > fdLimit.rlim_max)
+			fdLimit.rlim_cur = fdLimit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &fdLimit);
+	}
+
+	printf("Iterations: %d\n\n", iterations);
+	printf("%-10s %8s %12s %12s %12s %12s\n", "Type", "Fds", "Wake(usec)", "Min(usec)", "Max(usec)", "Idle(usec)");
+
+	for (i = 0; i < fdCountCount; ++i)
+	{
+		for (type = RSSL_NOTIFIER_TYPE_POLL; type <= RSSL_NOTIFIER_TYPE_EPOLL_EDGE; ++type)
+		{
+			if (!(typeMask & (1 << type)))
+				continue;
+
+			if (runTest((RsslNotifierType)type, fdCounts[i]) < 0)
+				return -1;
+		}
+	}
+
+	return 0;
+}
@@ -31,8 +31,11 @@ static void clearProvPerfConfig()
 	provPerfConfig.recvBufSize = 0;
 	provPerfConfig.tcpNoDelay = RSSL_TRUE;
 	provPerfConfig.highWaterMark = 0;
+	provPerfConfig.coalesceWriteUsec = 0;
+	provPerfConfig.autoPackSize = 0;
 	snprintf(provPerfConfig.interfaceName, sizeof(provPerfConfig.interfaceName), "");
 	snprintf(provPerfConfig.portNo, sizeof(provPerfConfig.portNo), "%s", "14002");
+	provPerfConfig.listenerCount = 1;
 	snprintf(provPerfConfig.summaryFilename, sizeof(provPerfConfig.summaryFilename), "ProvSummary.out");
 	provPerfConfig.writeStatsInterval = 5;
 	provPerfConfig.displayStats = RSSL_TRUE;
@@ -143,6 +146,11 @@ void initProvPerfConfig(int argc, char **argv)
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
 			snprintf(provPerfConfig.portNo, sizeof(provPerfConfig.portNo), "%s", argv[iargs]);
 		}
+		else if (0 == strcmp("-listeners", argv[iargs]))
+		{
+			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
+			sscanf(argv[iargs], "%u", &provPerfConfig.listenerCount);
+		}
 		else if (0 == strcmp("-tcpDelay", argv[iargs]))
 		{
 			provPerfConfig.tcpNoDelay = RSSL_FALSE;
@@ -221,6 +229,16 @@ void initProvPerfConfig(int argc, char **argv)
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
 			sscanf(argv[iargs], "%d", &provPerfConfig.highWaterMark);
 		}
+		else if (0 == strcmp("-coalesceUsec", argv[iargs]))
+		{
+			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
+			sscanf(argv[iargs], "%u", &provPerfConfig.coalesceWriteUsec);
+		}
+		else if (0 == strcmp("-autoPackSize", argv[iargs]))
+		{
+			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
+			sscanf(argv[iargs], "%u", &provPerfConfig.autoPackSize);
+		}
 		else if (0 == strcmp("-sendBufSize", argv[iargs]))
 		{
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
@@ -265,6 +283,18 @@ void initProvPerfConfig(int argc, char **argv)
 		exitConfigError(argv);
 	} 
 
+	if (provPerfConfig.listenerCount < 1 || provPerfConfig.listenerCount > (RsslUInt32)providerThreadConfig.threadCount)
+	{
+		printf("Config Error: Listener count must be between 1 and the number of threads.\n");
+		exitConfigError(argv);
+	}
+
+	if (provPerfConfig.listenerCount > 1 && provPerfConfig.useReactor)
+	{
+		printf("Config Error: Multiple listeners cannot be used with the reactor.\n");
+		exitConfigError(argv);
+	}
+
 	if (provPerfConfig.writeStatsInterval < 1)
 	{
 		printf("Config error: Write Stats Interval cannot be less than 1.\n");
@@ -299,6 +329,7 @@ void printProvPerfConfig(FILE *file)
 	fprintf(file,  
 			"                Run Time: %u\n"
 			"                    Port: %s\n"
+			"               Listeners: %u\n"
 			"             Thread List: %s\n"
 			"          Output Buffers: %u\n"
 			"       Max Fragment Size: %u\n"
@@ -309,6 +340,8 @@ void printProvPerfConfig(FILE *file)
 			"               Tick Rate: %u\n"
 			"       Use Direct Writes: %s\n"
 			"         High Water Mark: %d%s\n"
+			"   Write Coalescing Time: %u%s\n"
+			"       Transport Packing: %u%s\n"
 			"            Summary File: %s\n"
 			"              Stats File: %s\n"
 			"            Latency File: %s\n"
@@ -316,6 +349,7 @@ void printProvPerfConfig(FILE *file)
 			"           Display Stats: %s\n",
 			provPerfConfig.runTime,
 			provPerfConfig.portNo,
+			provPerfConfig.listenerCount,
 			threadString,
 			provPerfConfig.guaranteedOutputBuffers,
 			provPerfConfig.maxFragmentSize,
@@ -326,6 +360,8 @@ void printProvPerfConfig(FILE *file)
 			providerThreadConfig.ticksPerSec,
 			(providerThreadConfig.writeFlags & RSSL_WRITE_DIRECT_SOCKET_WRITE) ? "Yes" : "No",
 			provPerfConfig.highWaterMark, (provPerfConfig.highWaterMark > 0 ?  " bytes" : "(use default)"),
+			provPerfConfig.coalesceWriteUsec, (provPerfConfig.coalesceWriteUsec > 0 ?  " usec" : "(off)"),
+			provPerfConfig.autoPackSize, (provPerfConfig.autoPackSize > 0 ?  " bytes" : "(off)"),
 			provPerfConfig.summaryFilename,
 			providerThreadConfig.statsFilename,
 			providerThreadConfig.latencyLogFilename,
@@ -388,6 +424,8 @@ void exitWithUsage()
 			"  -?                                   Shows this usage\n"
 			"\n"
 			"  -p <port number>                     Port number\n"
+			"  -listeners <count>                   Number of servers to bind to the port with serverSharedSocket(SO_REUSEPORT).\n"
+			"                                        Each of the first <count> threads accepts and initializes its own connections.\n"
 			"\n"
 			"  -outputBufs <count>                  Number of output buffers(configures guaranteedOutputBuffers in RsslBindOptions)\n"
 			"  -maxFragmentSize <size>              Max size of buffers(configures maxFragmentSize in RsslBindOptions)\n"
@@ -395,6 +433,8 @@ void exitWithUsage()
 			"  -recvBufSize <size>                  System Receive Buffer Size(configures sysRecvBufSize in RsslBindOptions)\n"
 			"  -tcpDelay                            Turns off tcp_nodelay in RsslBindOptions, enabling Nagle's\n"
 			"  -highWaterMark                       Sets the number of buffered bytes that will cause UPA to automatically flush\n"
+			"  -coalesceUsec <usec>                 Holds written data for up to this long so it is flushed in fewer system calls(RSSL_COALESCE_WRITE_USEC)\n"
+			"  -autoPackSize <size>                 Has the transport pack written messages into buffers of this size(configures tcpOpts.autoPackSize in RsslBindOptions)\n"
 			"  -if <interface name>                 Name of network interface to use\n"
 			"\n"
 			"  -tickRate <ticks per second>         Ticks per second\n"
@@ -23,10 +23,13 @@ typedef struct
 	RsslUInt32	runTime;							/* Time application runs befor exiting(-runTime) */
 	char 				portNo[32];					/* Port number. See -p */
 	char				interfaceName[128];			/* Name of interface. See -if */
+	RsslUInt32			listenerCount;				/* Number of servers sharing the port, each accepting on its own provider thread. See -listeners */
 	RsslBool			tcpNoDelay;					/* Enable/Disable Nagle's algorithm. See -tcpDelay */
 	RsslUInt32			guaranteedOutputBuffers;	/* Guaranteed Output Buffers. See -outputBufs */
 	RsslUInt32			maxFragmentSize;			/* Maximum Fragment Size. See -maxFragmentSize */
 	RsslUInt32			highWaterMark;				/* sets the point which will cause UPA to automatically flush */
+	RsslUInt32			coalesceWriteUsec;			/* Time written data may be held before it is flushed. See -coalesceUsec */
+	RsslUInt32			autoPackSize;				/* Size of the buffers the transport packs messages into. See -autoPackSize */
 	RsslUInt32			sendBufSize;				/* System Send Buffer Size. See -sendBufSize */
 	RsslUInt32			recvBufSize;				/* System Send Buffer Size. See -recvBufSize */
 	char				summaryFilename[128];		/* Name of the summary log file. See -summaryFile */
@@ -19,6 +19,7 @@
 #include <ctype.h>
 #include <assert.h>
 #include <signal.h>
+#include <math.h>
 
 //uncomment the following line for debugging only - this will greatly affect performance
 //#define ENABLE_XML_TRACE
@@ -40,6 +41,16 @@ TimeValue _currentTime;
 
 static RsslServer *rsslSrvr = NULL;
 
+/* Servers sharing the port when more than one listener is configured(-listeners).  Each is
+ * accepted from by the provider thread of the same index. */
+static RsslServer **listenerSrvrList = NULL;
+
+/* Accept and channel initialization statistics, collected from the provider threads. */
+static CountStat acceptedChannelCount;
+static RsslUInt64 peakAcceptRate = 0;
+static ValueStatistics channelInitTimeStats;
+static ValueStatistics intervalChannelInitTimeStats;
+
 static RsslInt64 nsecPerTick;
 
 /* Logs summary information, such as application inputs and final statistics. */
@@ -55,6 +66,99 @@ static void signal_handler(int sig)
 
 extern void startProviderThreads(Provider *pProvider, RSSL_THREAD_DECLARE(threadFunction,pArg));
 
+/* Accepts a connection on a provider thread's own listener. */
+static void acceptThreadChannel(ChannelHandler *pChanHandler, RsslServer *pServer)
+{
+	ProviderThread *pProvThread = (ProviderThread*)pChanHandler->pUserSpec;
+	RsslChannel *pChannel;
+	RsslError error;
+	RsslAcceptOptions acceptOpts = RSSL_INIT_ACCEPT_OPTS;
+
+	if ((pChannel = rsslAccept(pServer, &acceptOpts, &error)) == 0)
+	{
+		printf("rsslAccept: failed <%s>\n", error.text);
+		return;
+	}
+
+	printf("Server "SOCKET_PRINT_TYPE" accepting channel "SOCKET_PRINT_TYPE" on thread %d.\n\n", pServer->socketId, pChannel->socketId,
+			pProvThread->providerIndex + 1);
+	providerThreadAcceptNewChannel(pProvThread, pChannel);
+}
+
+/* Gathers accept counts and channel initialization times from the provider threads. */
+static void collectConnectionStats(RsslBool displayStats, RsslUInt32 timePassedSec)
+{
+	RsslInt32 i;
+	RsslUInt64 acceptCount;
+	RsslQueue timeRecords;
+
+	rsslInitQueue(&timeRecords);
+
+	for(i = 0; i < providerThreadConfig.threadCount; ++i)
+	{
+		RsslQueueLink *pLink;
+		ProviderThread *pProvThread = &provider.providerThreadList[i];
+
+		countStatAdd(&acceptedChannelCount, countStatGetChange(&pProvThread->acceptedChannelCount));
+
+		timeRecordQueueGet(&pProvThread->channelInitTimeRecords, &timeRecords);
+		RSSL_QUEUE_FOR_EACH_LINK(&timeRecords, pLink)
+		{
+			TimeRecord *pRecord = RSSL_QUEUE_LINK_TO_OBJECT(TimeRecord, queueLink, pLink);
+			double initTime = (double)(pRecord->endTime - pRecord->startTime)/(double)pRecord->ticks;
+
+			updateValueStatistics(&intervalChannelInitTimeStats, initTime);
+			updateValueStatistics(&channelInitTimeStats, initTime);
+		}
+		timeRecordQueueRepool(&pProvThread->channelInitTimeRecords, &timeRecords);
+	}
+
+	acceptCount = countStatGetChange(&acceptedChannelCount);
+
+	if (timePassedSec && acceptCount/timePassedSec > peakAcceptRate)
+		peakAcceptRate = acceptCount/timePassedSec;
+
+	if (displayStats && (acceptCount > 0 || intervalChannelInitTimeStats.count > 0))
+	{
+		printf("  - Accepted %llu channels (total: %llu), %llu became active\n",
+				acceptCount, countStatGetTotal(&acceptedChannelCount), intervalChannelInitTimeStats.count);
+		if (intervalChannelInitTimeStats.count > 0)
+			printValueStatistics(stdout, "  ChnlInitTime(usec)", "Chnls", &intervalChannelInitTimeStats, RSSL_FALSE);
+	}
+
+	clearValueStatistics(&intervalChannelInitTimeStats);
+}
+
+static void printConnectionSummaryStats(FILE *file)
+{
+	if (countStatGetTotal(&acceptedChannelCount) == 0)
+		return;
+
+	fprintf(file, "\nConnection Statistics: \n");
+	fprintf(file,
+			"  Listeners: %u\n"
+			"  Channels accepted: %llu\n"
+			"  Channels activated: %llu\n"
+			"  Peak accept rate: %llu\n",
+			provPerfConfig.listenerCount,
+			countStatGetTotal(&acceptedChannelCount),
+			channelInitTimeStats.count,
+			peakAcceptRate);
+
+	if (channelInitTimeStats.count)
+	{
+		fprintf(file,
+				"  Channel init time avg (usec): %.1f\n"
+				"  Channel init time std dev (usec): %.1f\n"
+				"  Channel init time max (usec): %.1f\n"
+				"  Channel init time min (usec): %.1f\n",
+				channelInitTimeStats.average,
+				sqrt(channelInitTimeStats.variance),
+				channelInitTimeStats.maxValue,
+				channelInitTimeStats.minValue);
+	}
+}
+
 RSSL_THREAD_DECLARE(runChannelConnectionHandler, pArg)
 {
 
@@ -90,6 +194,7 @@ RSSL_THREAD_DECLARE(runChannelConnectionHandler, pArg)
 		}
 
 		providerThreadCheckPings(pProvThread);
+		providerThreadTakeWriteStats(pProvThread);
 
 	}
 
@@ -198,6 +303,12 @@ RSSL_THREAD_DECLARE(runReactorConnectionHandler, pArg)
 		nextTickTime += nsecPerTick;
 
 		providerThreadSendMsgBurst(pProvThread, nextTickTime);
+
+		if (++currentTicks == providerThreadConfig.ticksPerSec)
+		{
+			currentTicks = 0;
+			providerThreadTakeWriteStats(pProvThread);
+		}
 	}
 
 	return RSSL_THREAD_RETURN();
@@ -300,6 +411,7 @@ RsslReactorCallbackRet channelEventCallback(RsslReactor *pReactor, RsslReactorCh
 			pProvSession->pChannelInfo->pReactor = pReactor;
 			rsslQueueAddLinkToBack(&pProviderThread->channelHandler.activeChannelList, &pProvSession->pChannelInfo->queueLink);
 			pProvSession->timeActivated = getTimeNano();
+			timeRecordSubmit(&pProviderThread->channelInitTimeRecords, pProvSession->timeCreated, pProvSession->timeActivated, 1000);
 
 			return RSSL_RC_CRET_SUCCESS;
 		}
@@ -463,6 +575,7 @@ static RsslRet acceptReactorConnection(RsslServer *pRsslSrvr, RsslErrorInfo *pRs
 	}
 	pProvSession->pProviderThread = pProvThread;
 	++pProvThread->clientSessionsCount;
+	countStatIncr(&pProvThread->acceptedChannelCount);
 
 	// initialize provider role
 	rsslClearOMMProviderRole(&providerRole);
@@ -479,6 +592,7 @@ static RsslRet acceptReactorConnection(RsslServer *pRsslSrvr, RsslErrorInfo *pRs
 	printf("Accepting new Reactor connection...\n");
 
 	rsslClearReactorAcceptOptions(&aopts);
+	aopts.coalesceWriteUsec = provPerfConfig.coalesceWriteUsec;
 	aopts.rsslAcceptOptions.userSpecPtr = pProvSession;
 
 	if ((ret = rsslReactorAccept(pProvThread->pReactor, pRsslSrvr, &aopts, (RsslReactorChannelRole*)&providerRole, &rsslErrorInfo))
@@ -520,6 +634,10 @@ int main(int argc, char **argv)
 
 	printProvPerfConfig(summaryFile); fflush(summaryFile);
 
+	initCountStat(&acceptedChannelCount);
+	clearValueStatistics(&channelInitTimeStats);
+	clearValueStatistics(&intervalChannelInitTimeStats);
+
 	// set up a signal handler so we can cleanup before exit
 	signal(SIGINT, signal_handler);
 
@@ -561,16 +679,6 @@ int main(int argc, char **argv)
 			processInactiveChannel,
 			processMsg);
 
-	if (provPerfConfig.useReactor == RSSL_FALSE) // use UPA Channel
-	{
-		startProviderThreads(&provider, runChannelConnectionHandler);
-	}
-	else // use UPA VA Reactor
-	{
-		startProviderThreads(&provider, runReactorConnectionHandler);
-	}
-
-
 	rsslClearBindOpts(&sopts);
 
 	sopts.guaranteedOutputBuffers = provPerfConfig.guaranteedOutputBuffers;
@@ -584,16 +692,52 @@ int main(int argc, char **argv)
 	sopts.sysRecvBufSize = provPerfConfig.recvBufSize;
 	sopts.connectionType = RSSL_CONN_TYPE_SOCKET;
 	sopts.maxFragmentSize = provPerfConfig.maxFragmentSize;
+	sopts.tcpOpts.autoPackSize = provPerfConfig.autoPackSize;
 
-	if ((rsslSrvr = rsslBind(&sopts, &error)) == 0)
+	if (provPerfConfig.listenerCount > 1)
 	{
-		printf("rsslBind() failed: %d(%s)\n", error.rsslErrorId, error.text);
-		exit(-1);
+		RsslUInt32 i;
+
+		/* Each listener is handed to a provider thread before it starts, so that
+		 * connections are accepted and initialized on the thread that will own them. */
+		sopts.serverSharedSocket = RSSL_TRUE;
+		listenerSrvrList = (RsslServer**)malloc(provPerfConfig.listenerCount * sizeof(RsslServer*));
+
+		for(i = 0; i < provPerfConfig.listenerCount; ++i)
+		{
+			if ((listenerSrvrList[i] = rsslBind(&sopts, &error)) == 0)
+			{
+				printf("rsslBind() failed: %d(%s)\n", error.rsslErrorId, error.text);
+				exit(-1);
+			}
+
+			printf("Server "SOCKET_PRINT_TYPE" bound to port %d for thread %u.\n", listenerSrvrList[i]->socketId,
+					listenerSrvrList[i]->portNumber, i + 1);
+			channelHandlerSetServer(&provider.providerThreadList[i].channelHandler, listenerSrvrList[i], acceptThreadChannel);
+		}
+		printf("\n");
+	}
+	else
+	{
+		if ((rsslSrvr = rsslBind(&sopts, &error)) == 0)
+		{
+			printf("rsslBind() failed: %d(%s)\n", error.rsslErrorId, error.text);
+			exit(-1);
+		}
+
+		printf("Server "SOCKET_PRINT_TYPE" bound to port %d.\n\n", rsslSrvr->socketId, rsslSrvr->portNumber);
+		FD_SET(rsslSrvr->socketId,&readfds);
+		FD_SET(rsslSrvr->socketId,&exceptfds);
 	}
 
-	printf("Server "SOCKET_PRINT_TYPE" bound to port %d.\n\n", rsslSrvr->socketId, rsslSrvr->portNumber);
-	FD_SET(rsslSrvr->socketId,&readfds);
-	FD_SET(rsslSrvr->socketId,&exceptfds);
+	if (provPerfConfig.useReactor == RSSL_FALSE) // use UPA Channel
+	{
+		startProviderThreads(&provider, runChannelConnectionHandler);
+	}
+	else // use UPA VA Reactor
+	{
+		startProviderThreads(&provider, runReactorConnectionHandler);
+	}
 
 	time_interval.tv_sec = 0; time_interval.tv_usec = 0;
 	nextTickTime = getTimeNano() + nsecPerTick;
@@ -628,6 +772,7 @@ int main(int argc, char **argv)
 			{
 				providerCollectStats(&provider, RSSL_TRUE, provPerfConfig.displayStats, currentRuntimeSec,
 						provPerfConfig.writeStatsInterval);
+				collectConnectionStats(provPerfConfig.displayStats, provPerfConfig.writeStatsInterval);
 				intervalSeconds = 0;
 			}
 
@@ -740,6 +885,18 @@ RsslRet processActiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannel
 		}
 	}
 
+	if (provPerfConfig.coalesceWriteUsec > 0)
+	{
+		if (rsslIoctl(pChannelInfo->pChannel, RSSL_COALESCE_WRITE_USEC, &provPerfConfig.coalesceWriteUsec, &error) != RSSL_RET_SUCCESS)
+		{
+			printf("rsslIoctl() of RSSL_COALESCE_WRITE_USEC failed <%s>\n", error.text);
+			exit(-1);
+		}
+
+		/* The channel handler flushes when the coalescing time runs out, instead of as soon as a write leaves data queued. */
+		pChannelInfo->coalesceWriteUsec = provPerfConfig.coalesceWriteUsec;
+	}
+
 	if ((ret = rsslGetChannelInfo(pChannelInfo->pChannel, &channelInfo, &error)) != RSSL_RET_SUCCESS)
 	{
 		printf("rsslGetChannelInfo() failed: %d\n", ret);
@@ -800,6 +957,7 @@ RsslRet processActiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannel
 		return RSSL_RET_FAILURE;
 
 	pProvSession->timeActivated = getTimeNano();
+	timeRecordSubmit(&pProvThread->channelInitTimeRecords, pProvSession->timeCreated, pProvSession->timeActivated, 1000);
 
 	return RSSL_RET_SUCCESS;
 }
@@ -896,9 +1054,12 @@ void cleanUpAndExit()
 
 	/* Collect final stats before writing summary. */
 	providerCollectStats(&provider, RSSL_FALSE, RSSL_FALSE, 0, 0);
+	collectConnectionStats(RSSL_FALSE, 0);
 
 	providerPrintSummaryStats(&provider, stdout);
+	printConnectionSummaryStats(stdout);
 	providerPrintSummaryStats(&provider, summaryFile);
+	printConnectionSummaryStats(summaryFile);
 	fclose(summaryFile);
 
 	providerCleanup(&provider);
@@ -912,6 +1073,16 @@ void cleanUpAndExit()
 		rsslCloseServer(rsslSrvr, &error);
 	}
 
+	if (listenerSrvrList)
+	{
+		RsslError error;
+		RsslUInt32 i;
+
+		for(i = 0; i < provPerfConfig.listenerCount; ++i)
+			rsslCloseServer(listenerSrvrList[i], &error);
+		free(listenerSrvrList);
+	}
+
 	providerThreadConfigCleanup();
 
 	rsslUninitialize();
@@ -41,11 +41,19 @@ static void clearTransportPerfConfig()
 	transportPerfConfig.recvBufSize = 0;
 	transportPerfConfig.compressionType = RSSL_COMP_NONE;
 	transportPerfConfig.compressionLevel = 5;
+	transportPerfConfig.compressionMinSavings = 0;
+	snprintf(transportPerfConfig.compressionDictFile, sizeof(transportPerfConfig.compressionDictFile), "");
+	rsslClearBuffer(&transportPerfConfig.compressionDictionary);
 	transportPerfConfig.highWaterMark = 0;
+	transportPerfConfig.zeroCopyThreshold = 0;
+	transportPerfConfig.busyPollUsec = 0;
+	transportPerfConfig.recvTimestamps = RSSL_FALSE;
+	transportPerfConfig.memoryFlags = RSSL_INIT_MEM_DEFAULT;
 	snprintf(transportPerfConfig.interfaceName, sizeof(transportPerfConfig.interfaceName), "");
 	snprintf(transportPerfConfig.hostName, sizeof(transportPerfConfig.hostName), "%s", "localhost");
 	snprintf(transportPerfConfig.portNo, sizeof(transportPerfConfig.portNo), "%s", "14002");
 	transportPerfConfig.tcpNoDelay = RSSL_TRUE;
+	transportPerfConfig.kernelTlsOffload = RSSL_FALSE;
 	snprintf(transportPerfConfig.sendAddr, sizeof(transportPerfConfig.sendAddr), "");
 	snprintf(transportPerfConfig.recvAddr, sizeof(transportPerfConfig.recvAddr), "");
 	snprintf(transportPerfConfig.sendPort, sizeof(transportPerfConfig.sendPort), "");
@@ -153,6 +161,8 @@ void initTransportPerfConfig(int argc, char **argv)
 				transportPerfConfig.connectionType = RSSL_CONN_TYPE_UNIDIR_SHMEM;
 			else if(0 == strcmp(argv[iargs], "seqMCast"))
 				transportPerfConfig.connectionType = RSSL_CONN_TYPE_SEQ_MCAST;
+			else if (0 == strcmp(argv[iargs], "bidirShmem"))
+				transportPerfConfig.connectionType = RSSL_CONN_TYPE_BIDIR_SHMEM;
 			else
 				transportPerfConfig.connectionType = RSSL_CONN_TYPE_INIT; /* error */
 		}
@@ -208,6 +218,28 @@ void initTransportPerfConfig(int argc, char **argv)
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
 			sscanf(argv[iargs], "%u", &transportPerfConfig.highWaterMark);
 		}
+		else if (0 == strcmp("-zeroCopy", argv[iargs]))
+		{
+			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
+			sscanf(argv[iargs], "%u", &transportPerfConfig.zeroCopyThreshold);
+		}
+		else if (0 == strcmp("-busyPoll", argv[iargs]))
+		{
+			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
+			sscanf(argv[iargs], "%u", &transportPerfConfig.busyPollUsec);
+		}
+		else if (0 == strcmp("-hugePages", argv[iargs]))
+		{
+			transportPerfConfig.memoryFlags |= RSSL_INIT_MEM_HUGE_PAGES;
+		}
+		else if (0 == strcmp("-numaLocal", argv[iargs]))
+		{
+			transportPerfConfig.memoryFlags |= RSSL_INIT_MEM_NUMA_LOCAL;
+		}
+		else if (0 == strcmp("-recvTimestamps", argv[iargs]))
+		{
+			transportPerfConfig.recvTimestamps = RSSL_TRUE;
+		}
 		else if (0 == strcmp("-latencyFile", argv[iargs]))
 		{
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
@@ -222,6 +254,10 @@ void initTransportPerfConfig(int argc, char **argv)
 				transportPerfConfig.compressionType = RSSL_COMP_NONE;
 			else if (0 == strcmp(argv[iargs], "zlib"))
 				transportPerfConfig.compressionType = RSSL_COMP_ZLIB;
+			else if (0 == strcmp(argv[iargs], "lz4"))
+				transportPerfConfig.compressionType = RSSL_COMP_LZ4;
+			else if (0 == strcmp(argv[iargs], "zstd"))
+				transportPerfConfig.compressionType = RSSL_COMP_ZSTD;
 			else
 			{
 				/* Read it as a number. */
@@ -238,6 +274,16 @@ void initTransportPerfConfig(int argc, char **argv)
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
 			sscanf(argv[iargs], "%u", &transportPerfConfig.compressionLevel);
 		}
+		else if (0 == strcmp("-compressionMinSavings", argv[iargs]))
+		{
+			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
+			sscanf(argv[iargs], "%u", &transportPerfConfig.compressionMinSavings);
+		}
+		else if (0 == strcmp("-compressionDict", argv[iargs]))
+		{
+			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
+			snprintf(transportPerfConfig.compressionDictFile, sizeof(transportPerfConfig.compressionDictFile), "%s", argv[iargs]);
+		}
 		else if (0 == strcmp("-if", argv[iargs]))
 		{
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
@@ -284,6 +330,10 @@ void initTransportPerfConfig(int argc, char **argv)
 		{
 			transportPerfConfig.tcpNoDelay = RSSL_FALSE;
 		}
+		else if (0 == strcmp("-kernelTls", argv[iargs]))
+		{
+			transportPerfConfig.kernelTlsOffload = RSSL_TRUE;
+		}
 		else if (0 == strcmp("-msgRate", argv[iargs]))
 		{
 			++iargs; if (iargs == argc) exitMissingArgument(argv, iargs - 1);
@@ -368,10 +418,34 @@ void initTransportPerfConfig(int argc, char **argv)
 
 	if (transportPerfConfig.connectionType == RSSL_CONN_TYPE_INIT)
 	{
-		printf("Config Error: Unknown connectionType. Valid types are \"socket\", \"http\", \"encrypted\", \"reliableMCast\", \"shmem\", \"seqMCast\" \n");
+		printf("Config Error: Unknown connectionType. Valid types are \"socket\", \"http\", \"encrypted\", \"reliableMCast\", \"shmem\", \"seqMCast\", \"bidirShmem\" \n");
 		exitConfigError(argv);
 	} 
 
+	if (strlen(transportPerfConfig.compressionDictFile))
+	{
+		FILE *dictFile;
+		long dictLength;
+
+		if (transportPerfConfig.compressionType != RSSL_COMP_ZSTD)
+		{
+			printf("Config Error: -compressionDict requires -compressionType zstd.\n");
+			exitConfigError(argv);
+		}
+
+		if ((dictFile = fopen(transportPerfConfig.compressionDictFile, "rb")) == NULL
+				|| fseek(dictFile, 0, SEEK_END) != 0 || (dictLength = ftell(dictFile)) <= 0)
+		{
+			printf("Config Error: Unable to read compression dictionary file '%s'.\n", transportPerfConfig.compressionDictFile);
+			exitConfigError(argv);
+		}
+
+		rewind(dictFile);
+		transportPerfConfig.compressionDictionary.data = (char*)malloc(dictLength);
+		transportPerfConfig.compressionDictionary.length = (RsslUInt32)fread(transportPerfConfig.compressionDictionary.data, 1, dictLength, dictFile);
+		fclose(dictFile);
+	}
+
 	if (transportPerfConfig.appType == APPTYPE_SERVER &&
 		transportPerfConfig.connectionType == RSSL_CONN_TYPE_UNIDIR_SHMEM)
 	{
@@ -398,13 +472,15 @@ static const char *connectionTypeToString(RsslConnectionTypes connType)
 			return "shmem";
 		case RSSL_CONN_TYPE_SEQ_MCAST:
 			return "seqMCast";
+		case RSSL_CONN_TYPE_BIDIR_SHMEM:
+			return "bidirShmem";
 		default:
 			return "unknown";
 	}
 
 }
 
-static const char *compressionTypeToString(RsslCompTypes compType)
+const char *compressionTypeToString(RsslCompTypes compType)
 {
 	switch(compType)
 	{
@@ -412,6 +488,10 @@ static const char *compressionTypeToString(RsslCompTypes compType)
 			return "none";
 		case RSSL_COMP_ZLIB:
 			return "zlib";
+		case RSSL_COMP_LZ4:
+			return "lz4";
+		case RSSL_COMP_ZSTD:
+			return "zstd";
 		default:
 			return "unknown";
 	}
@@ -470,10 +550,18 @@ void printTransportPerfConfig(FILE *file)
 			"      Send Buffer Size: %u%s\n"
 			"      Recv Buffer Size: %u%s\n"
 			"       High Water Mark: %u%s\n"
+			"   Zero Copy Threshold: %u%s\n"
+			"        Busy Poll Usec: %u%s\n"
+			"       Recv Timestamps: %s\n"
+			"     Buffer Huge Pages: %s\n"
+			"     Buffer NUMA Local: %s\n"
 			"      Compression Type: %s(%u)\n"
 			"     Compression Level: %u\n"
+			"      Min Comp Savings: %u%s\n"
+			"      Compression Dict: %s\n"
 			"        Interface Name: %s\n"
 			"           Tcp_NoDelay: %s\n"
+			"            Kernel TLS: %s\n"
 			"             Tick Rate: %u\n"
 			"     Use Direct Writes: %s\n"
 			"      Latency Log File: %s\n"
@@ -494,11 +582,19 @@ void printTransportPerfConfig(FILE *file)
 			transportPerfConfig.sendBufSize, (transportPerfConfig.sendBufSize ? " bytes" : "(use default)"),
 			transportPerfConfig.recvBufSize, (transportPerfConfig.recvBufSize ? " bytes" : "(use default)"),
 			transportPerfConfig.highWaterMark, (transportPerfConfig.highWaterMark ? " bytes" : "(use default)"),
+			transportPerfConfig.zeroCopyThreshold, (transportPerfConfig.zeroCopyThreshold ? " bytes" : "(disabled)"),
+			transportPerfConfig.busyPollUsec, (transportPerfConfig.busyPollUsec ? "" : "(disabled)"),
+			(transportPerfConfig.recvTimestamps ? "Yes" : "No"),
+			((transportPerfConfig.memoryFlags & RSSL_INIT_MEM_HUGE_PAGES) ? "Yes" : "No"),
+			((transportPerfConfig.memoryFlags & RSSL_INIT_MEM_NUMA_LOCAL) ? "Yes" : "No"),
 			compressionTypeToString(transportPerfConfig.compressionType),
 			transportPerfConfig.compressionType,
 			transportPerfConfig.compressionLevel,
+			transportPerfConfig.compressionMinSavings, (transportPerfConfig.compressionMinSavings ? "%" : "(adaptive compression off)"),
+			strlen(transportPerfConfig.compressionDictFile) ? transportPerfConfig.compressionDictFile : "(none)",
 			strlen(transportPerfConfig.interfaceName) ? transportPerfConfig.interfaceName : "(use default)",
 			(transportPerfConfig.tcpNoDelay ? "Yes" : "No"),
+			(transportPerfConfig.kernelTlsOffload ? "Yes" : "No"),
 			transportThreadConfig.ticksPerSec,
 			(transportThreadConfig.writeFlags & RSSL_WRITE_DIRECT_SOCKET_WRITE) ? "Yes" : "No",
 			transportThreadConfig.logLatencyToFile ? transportThreadConfig.latencyLogFilename : "(none)",
@@ -537,16 +633,24 @@ void exitWithUsage()
 			"\n"
 			"  -appType <type>            Type of application(server, client)\n"
 			"\n"
-			"  -connType <type>           Type of connection(\"socket\", \"http\", \"encrypted\", \"reliableMCast\", \"shmem\", \"seqMCast\")\n"
+			"  -connType <type>           Type of connection(\"socket\", \"http\", \"encrypted\", \"reliableMCast\", \"shmem\", \"seqMCast\", \"bidirShmem\")\n"
 			"  -outputBufs <count>        Number of output buffers(configures guaranteedOutputBuffers in the RSSL bind/connection options)\n"
 			"  -maxFragmentSize <count>   Max size of buffers(configures maxFragmentSize in the RSSL bind/connection options)\n"
 			"  -sendBufSize <size>        System Send Buffer Size(configures sysSendBufSize in the RSSL bind/connection options)\n"
 			"  -recvBufSize <size>        System Receive Buffer Size(configures sysRecvBufSize in the RSSL bind/connection options)\n"
 			"  -highWaterMark <bytes>     Number of queued bytes at which rsslWrite() internally flushes.\n"
-			"  -compressionType <type>    Type of compression to use(\"none\", \"zlib\")\n"
+			"  -zeroCopy <bytes>          Size of socket writes at or above which MSG_ZEROCOPY is used(Linux only).\n"
+			"  -busyPoll <usec>           Microseconds rsslRead() keeps polling an empty socket before returning.\n"
+			"  -recvTimestamps            Uses kernel receive timestamps to measure time spent in the socket buffer(Linux only).\n"
+			"  -hugePages                 Allocates channel buffers from 2MB regions backed by huge pages.\n"
+			"  -numaLocal                 Allocates channel buffers on the NUMA node of the thread creating the channel.\n"
+			"  -compressionType <type>    Type of compression to use(\"none\", \"zlib\", \"lz4\", \"zstd\")\n"
 			"  -compressionLevel <num>    Level of compression.\n"
+			"  -compressionMinSavings <pct> Turns on adaptive compression; message sizes that compress by less than this percent are sent uncompressed.\n"
+			"  -compressionDict <file>    Zstandard dictionary to use with zstd compression(e.g. from 'zstd --train').\n"
 			"  -if <interface name>       Name of network interface to use\n"
 			"  -tcpDelay                  Turns off tcp_nodelay in RsslBindOpts, enabling Nagle's\n"
+			"  -kernelTls                 Asks for kernel TLS on encrypted connections(Linux, OpenSSL 3.0 or later).\n"
 			"\n"
 			"  -tickRate <ticks/sec>      Ticks per second\n"
 			"  -msgRate <msgs/second>     Message rate per second\n"
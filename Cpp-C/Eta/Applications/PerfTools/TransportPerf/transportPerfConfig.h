@@ -41,18 +41,30 @@ typedef struct
 	char 				portNo[32];					/* Port number. See -p */
 	char				interfaceName[128];			/* Name of interface.  See -if */
 	RsslBool			tcpNoDelay;					/* Enable/Disable Nagle's algorithm. See -tcpDelay */
+	RsslBool			kernelTlsOffload;			/* Ask for kernel TLS on encrypted connections. See -kernelTls */
 	RsslUInt32			guaranteedOutputBuffers;	/* Guaranteed Output Buffers. See -outputBufs */
 	RsslUInt32			maxFragmentSize;			/* Maximum Fragment Size. See -maxFragmentSize */
 	RsslUInt32			sendBufSize;				/* System Send Buffer Size(-sendBufSize) */
 	RsslUInt32			recvBufSize;				/* System Send Buffer Size(-recvBufSize) */
 	RsslUInt32			highWaterMark;				/* The "high water mark" (bytes) at which rsslWrite() will automatically flush. 
 													   See rsslIoctl() and RSSL_HIGH_WATER_MARK. */
+	RsslUInt32			zeroCopyThreshold;			/* Size (bytes) at or above which socket writes use MSG_ZEROCOPY. 
+													   See rsslIoctl() and RSSL_ZERO_COPY_THRESHOLD. */
+	RsslUInt32			busyPollUsec;				/* Microseconds rsslRead() polls an empty socket before returning. 
+													   See rsslIoctl() and RSSL_BUSY_POLL_USEC. */
+	RsslBool			recvTimestamps;				/* Read with kernel receive timestamps and measure time spent in the socket buffer.
+													   See rsslIoctl() and RSSL_RECV_TIMESTAMPS. */
+	RsslUInt32			memoryFlags;				/* RsslInitMemoryFlags for the transport's channel buffers. See -hugePages, -numaLocal */
 	char				summaryFilename[128];		/* Name of the summary log file(-summaryFile).. */
 	RsslUInt32			writeStatsInterval;			/* Controls how often statistics are written. */
 	RsslBool			displayStats;				/* Controls whether stats appear on the screen. */
 
 	RsslCompTypes		compressionType;			/* Type of compression to use, if any. */
 	int					compressionLevel;			/* Compression level, optional depending on compression algorithm used */
+	RsslUInt32			compressionMinSavings;		/* Percent compression must save to stay on for a message size class. 
+													   See rsslIoctl() and RSSL_COMPRESSION_MIN_SAVINGS. */
+	char				compressionDictFile[256];	/* Zstandard dictionary file, if any.  See -compressionDict */
+	RsslBuffer			compressionDictionary;		/* Contents of compressionDictFile. */
 	char				hostName[128];				/* hostName, if using rsslConnect(). See -hostname */
 	char				sendAddr[128];				/* Outbound address, if using a multicast connection. See -sa */
 	char				recvAddr[128];				/* Inbound address, if using a multicast connection. See -ra */
@@ -77,6 +89,9 @@ void printTransportPerfConfig(FILE *file);
 /* Exits the application and prints out usage information. */
 void exitWithUsage();
 
+/* Returns the command-line name of a compression type. */
+const char *compressionTypeToString(RsslCompTypes compType);
+
 #ifdef __cplusplus
 };
 #endif
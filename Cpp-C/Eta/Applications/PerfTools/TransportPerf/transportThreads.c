@@ -112,6 +112,8 @@ void transportThreadInit(TransportThread *pThread,
 
 	pThread->connectTime = 0;
 	pThread->disconnectTime = 0;
+	pThread->encrypted = RSSL_FALSE;
+	pThread->encryptionOffload = RSSL_ENC_OFFLOAD_NONE;
 	pThread->threadIndex = threadIndex;
 
 	snprintf(tmpFilename, sizeof(tmpFilename), "%s%d_%d.csv", 
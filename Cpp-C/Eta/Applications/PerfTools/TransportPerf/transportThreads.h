@@ -79,6 +79,8 @@ typedef struct
 	LatencyRandomArrayIter	randArrayIter;		/* Iterator for latency random array. */
 	TimeValue				connectTime;		/* Time of first connection. */
 	TimeValue				disconnectTime; 	/* Time of last disconnection. */
+	RsslBool				encrypted;			/* The first connection was an encrypted connection. */
+	RsslUInt32				encryptionOffload;	/* RsslChannelInfo::encryptionOffload of the first connection. */
 	CountStat				msgsSent;			/* Total messages sent. */
 	CountStat				bytesSent;			/* Total bytes sent(counting any compression) */
 	CountStat				msgsReceived;		/* Total messages received. */
@@ -48,6 +48,7 @@ static ResourceUsageStats resourceStats;
 static ValueStatistics cpuUsageStats;
 static ValueStatistics memUsageStats;
 static ValueStatistics totalLatencyStats;
+static ValueStatistics totalSocketWaitStats;
 
 static RsslUInt32 currentRuntimeSec = 0, intervalSeconds = 0;
 
@@ -71,6 +72,21 @@ static void signal_handler(int sig)
 
 
 static void printSummaryStats(FILE *file);
+static const char *encryptionModeToString(RsslBool encrypted, RsslUInt32 encryptionOffload);
+
+/* Wall clock time in nanoseconds, the clock used by kernel receive timestamps. */
+static RsslUInt64 getWallTimeNano()
+{
+#ifdef _WIN32
+	/* Receive timestamps are only available on Linux. */
+	return 0;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (RsslUInt64)ts.tv_sec * 1000000000ULL + (RsslUInt64)ts.tv_nsec;
+#endif
+}
 
 RsslRet processMsg(ChannelHandler *pChanHandler, ChannelInfo *pChannelInfo, RsslBuffer *pMsgBuf)
 {
@@ -105,7 +121,18 @@ RsslRet processMsg(ChannelHandler *pChanHandler, ChannelInfo *pChannelInfo, Rssl
 
 		if (timeTracker)
 		{
-			timeRecordSubmit(&pHandler->latencyRecords, timeTracker, getTimeNano(), 1000);
+			TimeValue endTime = getTimeNano();
+
+			timeRecordSubmit(&pHandler->latencyRecords, timeTracker, endTime, 1000);
+
+			/* Split out the time the message waited in the socket buffer before being read. */
+			if (pChannelInfo->recvTimestamp)
+			{
+				RsslUInt64 wallTime = getWallTimeNano();
+
+				if (wallTime > pChannelInfo->recvTimestamp)
+					timeRecordSubmit(&pHandler->socketWaitRecords, endTime - (wallTime - pChannelInfo->recvTimestamp), endTime, 1000);
+			}
 		}
 		return RSSL_RET_SUCCESS;
 	}
@@ -212,9 +239,43 @@ RsslRet processActiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannel
 		}
 	}
 
-	/* Record first connection time. */
-	if (!pHandler->transportThread.connectTime)
-		pHandler->transportThread.connectTime = getTimeNano();
+	if (transportPerfConfig.zeroCopyThreshold > 0)
+	{
+		if ((ret = rsslIoctl(pChannelInfo->pChannel, RSSL_ZERO_COPY_THRESHOLD, &transportPerfConfig.zeroCopyThreshold, &error)) != RSSL_RET_SUCCESS)
+		{
+			printf("Failed to set zero copy threshold: %s (%s)\n", rsslRetCodeToString(ret), error.text);
+			return RSSL_RET_FAILURE;
+		}
+	}
+
+	if (transportPerfConfig.compressionMinSavings > 0)
+	{
+		if ((ret = rsslIoctl(pChannelInfo->pChannel, RSSL_COMPRESSION_MIN_SAVINGS, &transportPerfConfig.compressionMinSavings, &error)) != RSSL_RET_SUCCESS)
+		{
+			printf("Failed to set compression minimum savings: %s (%s)\n", rsslRetCodeToString(ret), error.text);
+			return RSSL_RET_FAILURE;
+		}
+	}
+
+	if (transportPerfConfig.busyPollUsec > 0)
+	{
+		if ((ret = rsslIoctl(pChannelInfo->pChannel, RSSL_BUSY_POLL_USEC, &transportPerfConfig.busyPollUsec, &error)) != RSSL_RET_SUCCESS)
+		{
+			printf("Failed to set busy poll time: %s (%s)\n", rsslRetCodeToString(ret), error.text);
+			return RSSL_RET_FAILURE;
+		}
+	}
+
+	if (transportPerfConfig.recvTimestamps)
+	{
+		RsslUInt32 on = 1;
+
+		if ((ret = rsslIoctl(pChannelInfo->pChannel, RSSL_RECV_TIMESTAMPS, &on, &error)) != RSSL_RET_SUCCESS)
+		{
+			printf("Failed to enable receive timestamps: %s (%s)\n", rsslRetCodeToString(ret), error.text);
+			return RSSL_RET_FAILURE;
+		}
+	}
 
 	/* Print component version. */
 	if ((ret = rsslGetChannelInfo(pChannelInfo->pChannel, &channelInfo, &error)) != RSSL_RET_SUCCESS)
@@ -223,6 +284,14 @@ RsslRet processActiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannel
 		return 0;
 	} 
 
+	/* Record first connection time, and how it is encrypted so the summary can tell encrypted and plain runs apart. */
+	if (!pHandler->transportThread.connectTime)
+	{
+		pHandler->transportThread.connectTime = getTimeNano();
+		pHandler->transportThread.encrypted = (pChannelInfo->pChannel->connectionType == RSSL_CONN_TYPE_ENCRYPTED);
+		pHandler->transportThread.encryptionOffload = channelInfo.encryptionOffload;
+	}
+
 	printf( "Channel "SOCKET_PRINT_TYPE" active. Channel Info:\n"
 			"  maxFragmentSize: %u\n"
 			"  maxOutputBuffers: %u\n"
@@ -235,6 +304,7 @@ RsslRet processActiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannel
 			"  sysSendBufSize: %u\n"			
 			"  compressionType: %s\n"
 			"  compressionThreshold: %u\n"			
+			"  encryption: %s\n"
 			"  ComponentInfo: ", 
 			pChannelInfo->pChannel->socketId,
 			channelInfo.maxFragmentSize,
@@ -244,8 +314,9 @@ RsslRet processActiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannel
 			channelInfo.clientToServerPings == RSSL_TRUE ? "true" : "false",
 			channelInfo.serverToClientPings == RSSL_TRUE ? "true" : "false",
 			channelInfo.sysSendBufSize, channelInfo.sysRecvBufSize,			
-			channelInfo.compressionType == RSSL_COMP_ZLIB ? "zlib" : "none",
-			channelInfo.compressionThreshold			
+			compressionTypeToString(channelInfo.compressionType),
+			channelInfo.compressionThreshold,
+			encryptionModeToString(pChannelInfo->pChannel->connectionType == RSSL_CONN_TYPE_ENCRYPTED, channelInfo.encryptionOffload)
 			);
 	if (channelInfo.componentInfoCount == 0)
 		printf("(No component info)");
@@ -274,11 +345,68 @@ RsslRet processActiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannel
 	return RSSL_RET_SUCCESS;
 }
 
+/* Describes how a connection is encrypted: not at all, by OpenSSL, or by the kernel in one or both directions. */
+static const char *encryptionModeToString(RsslBool encrypted, RsslUInt32 encryptionOffload)
+{
+	if (!encrypted)
+		return "none";
+
+	switch (encryptionOffload & (RSSL_ENC_OFFLOAD_KTLS_TX | RSSL_ENC_OFFLOAD_KTLS_RX))
+	{
+		case RSSL_ENC_OFFLOAD_KTLS_TX | RSSL_ENC_OFFLOAD_KTLS_RX:
+			return "TLS, kernel TLS send and receive";
+		case RSSL_ENC_OFFLOAD_KTLS_RX:
+			return "TLS, kernel TLS receive, OpenSSL send";
+		case RSSL_ENC_OFFLOAD_KTLS_TX:
+			return "TLS, kernel TLS send, OpenSSL receive";
+		default:
+			return "TLS, OpenSSL";
+	}
+}
+
+/* Prints the outbound compression statistics of a channel that is still active. */
+static void printCompressionStats(RsslChannel *pChannel)
+{
+	RsslChannelInfo channelInfo;
+	RsslError error;
+	RsslUInt32 i;
+
+	if (rsslGetChannelInfo(pChannel, &channelInfo, &error) != RSSL_RET_SUCCESS
+			|| channelInfo.compressionType == RSSL_COMP_NONE)
+		return;
+
+	printf("Compression statistics (fd="SOCKET_PRINT_TYPE", min savings %u%%):\n", pChannel->socketId,
+			channelInfo.compressionStats.minSavings);
+	printf("  %-8s %12s %12s %8s %10s %s\n", "Size", "Compressed", "Bypassed", "Ratio", "Usec/Msg", "State");
+
+	for (i = 0; i < RSSL_COMP_STATS_BUCKET_COUNT; ++i)
+	{
+		RsslCompressionBucketStats *pStats = &channelInfo.compressionStats.buckets[i];
+		char sizeStr[16];
+
+		if (pStats->compressedMsgs == 0 && pStats->bypassedMsgs == 0)
+			continue;
+
+		if (pStats->maxLength)
+			snprintf(sizeStr, sizeof(sizeStr), "<%u", pStats->maxLength);
+		else
+			snprintf(sizeStr, sizeof(sizeStr), ">=%u", channelInfo.compressionStats.buckets[i - 1].maxLength);
+
+		printf("  %-8s %12llu %12llu %8.2f %10.2f %s\n", sizeStr,
+				pStats->compressedMsgs, pStats->bypassedMsgs,
+				pStats->bytesOut ? (double)pStats->bytesIn / (double)pStats->bytesOut : 0.0,
+				pStats->compressedMsgs ? (double)pStats->compressTimeNsec / 1000.0 / (double)pStats->compressedMsgs : 0.0,
+				pStats->bypassed ? "bypassed" : "compressing");
+	}
+}
+
 void processInactiveChannel(ChannelHandler *pChanHandler, ChannelInfo *pChannelInfo, RsslError *pError)
 {
 	SessionHandler *pHandler = (SessionHandler*)pChanHandler->pUserSpec;
 	TransportSession *pSession = (TransportSession*)pChannelInfo->pUserSpec;
 
+	printCompressionStats(pChannelInfo->pChannel);
+
 	/* If the channel was active and this is a client, we won't attempt to reconnect,
 	 * so stop the test. */
 	if (!signal_shutdown && transportPerfConfig.appType == APPTYPE_CLIENT
@@ -489,6 +617,7 @@ int main(int argc, char **argv)
 	int i;
 	struct timeval time_interval;
 	RsslError error;
+	RsslInitializeExOpts initOpts = RSSL_INIT_INITIALIZE_EX_OPTS;
 	fd_set useRead;
 	fd_set useExcept;
 	int selRet;
@@ -527,11 +656,12 @@ int main(int argc, char **argv)
 	/* Initialize RSSL */
 	/* Multicast statistics are retrieved via rsslGetChannelInfo(), so set the per-channel-lock 
 	 * when taking them. */
-	if (rsslInitialize(transportPerfConfig.takeMCastStats ? RSSL_LOCK_GLOBAL_AND_CHANNEL :
-					(transportPerfConfig.threadCount > 1 ? RSSL_LOCK_GLOBAL : RSSL_LOCK_NONE),
-					 &error) != RSSL_RET_SUCCESS)
+	initOpts.rsslLocking = transportPerfConfig.takeMCastStats ? RSSL_LOCK_GLOBAL_AND_CHANNEL :
+					(transportPerfConfig.threadCount > 1 ? RSSL_LOCK_GLOBAL : RSSL_LOCK_NONE);
+	initOpts.memoryFlags = transportPerfConfig.memoryFlags;
+	if (rsslInitializeEx(&initOpts, &error) != RSSL_RET_SUCCESS)
 	{
-		printf("RsslInitialize failed: %s\n", error.text);
+		printf("RsslInitializeEx failed: %s\n", error.text);
 		exit(-1);
 	}
 	/* Initialize run-time */
@@ -586,6 +716,7 @@ int main(int argc, char **argv)
 	clearValueStatistics(&cpuUsageStats);
 	clearValueStatistics(&memUsageStats);
 	clearValueStatistics(&totalLatencyStats);
+	clearValueStatistics(&totalSocketWaitStats);
 
 	time_interval.tv_sec = 0; time_interval.tv_usec = 0;
 	nextTickTime = getTimeNano() + nsecPerTick;
@@ -684,6 +815,7 @@ void collectStats(RsslBool writeStats, RsslBool displayStats, RsslUInt32 current
 			  intervalMsgReceivedCount = 0, intervalBytesReceived = 0,
 			  intervalOutOfBuffersCount = 0;
 	ValueStatistics intervalLatencyStats;
+	ValueStatistics intervalSocketWaitStats;
 	RsslRet ret;
 	RsslInt32 i;
 
@@ -736,6 +868,21 @@ void collectStats(RsslBool writeStats, RsslBool displayStats, RsslUInt32 current
 
 		timeRecordQueueRepool(&sessionHandlerList[i].latencyRecords, &latencyRecords);
 
+		timeRecordQueueGet(&sessionHandlerList[i].socketWaitRecords, &latencyRecords);
+
+		clearValueStatistics(&intervalSocketWaitStats);
+
+		RSSL_QUEUE_FOR_EACH_LINK(&latencyRecords, pLink)
+		{
+			TimeRecord *pRecord = RSSL_QUEUE_LINK_TO_OBJECT(TimeRecord, queueLink, pLink);
+			double socketWait = (double)(pRecord->endTime - pRecord->startTime)/(double)pRecord->ticks;
+
+			updateValueStatistics(&intervalSocketWaitStats, socketWait);
+			updateValueStatistics(&totalSocketWaitStats, socketWait);
+		}
+
+		timeRecordQueueRepool(&sessionHandlerList[i].socketWaitRecords, &latencyRecords);
+
 		if (transportThreadConfig.logLatencyToFile)
 			fflush(sessionHandlerList[i].transportThread.latencyLogFile);
 
@@ -795,6 +942,9 @@ void collectStats(RsslBool writeStats, RsslBool displayStats, RsslUInt32 current
 			if (intervalLatencyStats.count > 0)
 				printValueStatistics(stdout, "  Latency (usec)", "Msgs", &intervalLatencyStats, RSSL_TRUE);
 
+			if (intervalSocketWaitStats.count > 0)
+				printValueStatistics(stdout, "  Socket wait (usec)", "Msgs", &intervalSocketWaitStats, RSSL_TRUE);
+
 			if(transportPerfConfig.takeMCastStats)
 			{
 				RsslUInt64 intervalMcastPacketsSent = 0, intervalMcastPacketsReceived = 0, intervalMcastRetransSent = 0, intervalMcastRetransReceived = 0;
@@ -862,6 +1012,7 @@ static RsslServer* bindRsslServer(RsslError* error)
 	sopts.maxFragmentSize = transportPerfConfig.maxFragmentSize;
 	sopts.compressionType = transportPerfConfig.compressionType;
 	sopts.compressionLevel = transportPerfConfig.compressionLevel;
+	sopts.compressionDictionary = transportPerfConfig.compressionDictionary;
 	sopts.serviceName = transportPerfConfig.portNo;
 	sopts.sysSendBufSize = transportPerfConfig.sendBufSize;
 	sopts.sysRecvBufSize = transportPerfConfig.recvBufSize;
@@ -949,7 +1100,9 @@ static RsslChannel* startConnection()
 	copts.protocolType = TEST_PROTOCOL_TYPE;
 	copts.connectionType = transportPerfConfig.connectionType;
 	copts.tcp_nodelay = transportPerfConfig.tcpNoDelay;
+	copts.encryptionOpts.kernelTlsOffload = transportPerfConfig.kernelTlsOffload;
 	copts.compressionType = transportPerfConfig.compressionType;
+	copts.compressionDictionary = transportPerfConfig.compressionDictionary;
 
 	if(copts.connectionType == RSSL_CONN_TYPE_SEQ_MCAST)
 	{
@@ -1089,6 +1242,7 @@ static void printSummaryStats(FILE *file)
 				fprintf( file, "  No latency information was received.\n\n");
 
 			fprintf( file,
+					"  Encryption: %s\n"
 					"  Sampling duration(sec): %.2f\n"
 					"  Msgs Sent: %llu\n"
 					"  Msgs Received: %llu\n"
@@ -1098,6 +1252,7 @@ static void printSummaryStats(FILE *file)
 					"  Avg. Msg Recv Rate: %.0f\n"
 					"  Avg. Data Sent Rate (MB): %.2f\n"
 					"  Avg. Data Recv Rate (MB): %.2f\n\n",
+					encryptionModeToString(pThread->encrypted, pThread->encryptionOffload),
 					threadConnectedTime,
 					countStatGetTotal(&pThread->msgsSent),
 					countStatGetTotal(&pThread->msgsReceived),
@@ -1131,7 +1286,19 @@ static void printSummaryStats(FILE *file)
 	else
 		fprintf( file, "  No latency information was received.\n\n");
 
+	if (totalSocketWaitStats.count)
+	{
+		fprintf( file,
+				"  Socket wait avg (usec): %.3f\n"
+				"  Socket wait max (usec): %.3f\n"
+				"  Socket wait min (usec): %.3f\n",
+				totalSocketWaitStats.average,
+				totalSocketWaitStats.maxValue,
+				totalSocketWaitStats.minValue);
+	}
+
 	fprintf( file,
+			"  Encryption: %s\n"
 			"  Sampling duration(sec): %.2f\n"
 			"  Msgs Sent: %llu\n"
 			"  Msgs Received: %llu\n"
@@ -1141,6 +1308,7 @@ static void printSummaryStats(FILE *file)
 			"  Avg. Msg Recv Rate: %.0f\n"
 			"  Avg. Data Sent Rate (MB): %.2f\n"
 			"  Avg. Data Recv Rate (MB): %.2f\n",
+			encryptionModeToString(sessionHandlerList[0].transportThread.encrypted, sessionHandlerList[0].transportThread.encryptionOffload),
 			connectedTime,
 			totalMsgSentCount,
 			totalMsgReceivedCount,
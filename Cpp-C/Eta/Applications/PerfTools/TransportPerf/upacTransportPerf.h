@@ -50,6 +50,7 @@ typedef struct
 	RsslThreadId			threadId;			/* ThreadID for this handler. */
 	RsslInt32				cpuId;				/* ID of a CPU core this thread should be bound to, if any. */
 	TimeRecordQueue			latencyRecords;		/* Latency records from the TransportThread. */
+	TimeRecordQueue			socketWaitRecords;	/* Time latency messages spent in the socket buffer, with -recvTimestamps. */
 	TransportThread			transportThread;	/* Thread associated with this handler. */
 	transportTestRole		role;				/* Role of this handler. */
 	RsslMCastStats			prevMCastStats;		/* Stores any multicast statistics. */
@@ -75,6 +76,7 @@ RTR_C_INLINE void sessionHandlerInit(SessionHandler *pHandler)
 	pHandler->openChannelsCount = 0;
 	pHandler->active = RSSL_FALSE;
 	timeRecordQueueInit(&pHandler->latencyRecords);
+	timeRecordQueueInit(&pHandler->socketWaitRecords);
 	pHandler->cpuId = -1;
 
 	pHandler->role = (transportTestRole)(ROLE_READER | ROLE_WRITER);
@@ -86,6 +88,7 @@ RTR_C_INLINE void sessionHandlerCleanup(SessionHandler *pHandler)
 {
 	RSSL_MUTEX_DESTROY(&pHandler->handlerLock);
 	timeRecordQueueCleanup(&pHandler->latencyRecords);
+	timeRecordQueueCleanup(&pHandler->socketWaitRecords);
 	transportThreadCleanup(&pHandler->transportThread);
 }
 
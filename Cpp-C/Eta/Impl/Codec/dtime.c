@@ -11,6 +11,7 @@
 #include "rtr/rwfConvert.h"
 #include "rtr/rsslDataUtils.h"
 #include <ctype.h>
+#include <stddef.h>
 #include <time.h>
 
 
@@ -615,6 +616,319 @@ RSSL_API RsslBool rsslDateTimeIsValid(const RsslDateTime * iDateTime)
 	return (rsslDateIsValid(&iDateTime->date) && rsslTimeIsValid(&iDateTime->time));
 }
 
+/* The fast paths below handle the most common date and time formats. Each accepts only input
+ * that the general sscanf() based parsing would read the same way, reading just the given length,
+ * and returns RSSL_FALSE for anything else so that the general parsing handles it. */
+
+/* Reads minDigits to maxDigits digits at *pPtr, stopping at endptr, and advances *pPtr past them. */
+static RsslBool _rsslScanDigits(const char **pPtr, const char *endptr, int minDigits, int maxDigits, int *oValue)
+{
+	const char *ptr = *pPtr;
+	int value = 0;
+
+	while (ptr < endptr && _rtr_acisdigit(*ptr))
+	{
+		if (ptr - *pPtr == maxDigits)
+			return RSSL_FALSE;
+		value = value * 10 + _rtr_actoint(*ptr);
+		ptr++;
+	}
+
+	if (ptr - *pPtr < minDigits)
+		return RSSL_FALSE;
+
+	*oValue = value;
+	*pPtr = ptr;
+	return RSSL_TRUE;
+}
+
+/* Returns the value of the two digits at ptr, or -1 if they are not both digits. */
+RTR_C_ALWAYS_INLINE int _rsslTwoDigits(const char *ptr)
+{
+	unsigned int tens = (unsigned char)ptr[0] - '0';
+	unsigned int units = (unsigned char)ptr[1] - '0';
+
+	return (tens <= 9 && units <= 9) ? (int)(tens * 10 + units) : -1;
+}
+
+/* Reads an ISO 8601 'YYYY-MM-DD' date at ptr. */
+static RsslBool _rsslScanIsoDate(const char *ptr, int *oYear, int *oMonth, int *oDay)
+{
+	int high, low;
+
+	if (ptr[4] != '-' || ptr[7] != '-')
+		return RSSL_FALSE;
+
+	if ((high = _rsslTwoDigits(ptr)) < 0 || (low = _rsslTwoDigits(ptr + 2)) < 0
+			|| (*oMonth = _rsslTwoDigits(ptr + 5)) < 0 || (*oDay = _rsslTwoDigits(ptr + 8)) < 0)
+		return RSSL_FALSE;
+
+	*oYear = high * 100 + low;
+	return RSSL_TRUE;
+}
+
+/* Reads the 1 to 9 digits of fractional seconds from ptr to endptr the way
+ * iso8601FractionalStringTimeToTime() does. */
+static RsslBool _rsslScanFraction(const char *ptr, const char *endptr, RsslUInt16 *oMilli, RsslUInt16 *oMicro, RsslUInt16 *oNano)
+{
+	static const RsslUInt32 nanoScale[10] = { 0, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+	RsslUInt64 value = 0;
+	RsslUInt32 nanos;
+	ptrdiff_t count = endptr - ptr;
+
+	if (count < 1 || count > MAX_DECIMAL_DIGITS || _rwfParseDigits(ptr, endptr, &value) != endptr)
+		return RSSL_FALSE;
+
+	nanos = (RsslUInt32)value * nanoScale[count];
+	*oMilli = (RsslUInt16)(nanos / 1000000);
+	*oMicro = (RsslUInt16)(nanos / 1000 % 1000);
+	*oNano = (RsslUInt16)(nanos % 1000);
+	return RSSL_TRUE;
+}
+
+/* Reads a 'D MMM YYYY' or 'M/D/Y' style date (as "%d %3s %d" or "%d/%d/%d" would) at *pPtr,
+ * stopping at endptr, and advances *pPtr past it. */
+static RsslBool _rsslScanDate(const char **pPtr, const char *endptr, RsslDate *oDate)
+{
+	const char *ptr = *pPtr;
+	int a, b, c;
+
+	if (!_rsslScanDigits(&ptr, endptr, 1, 4, &a) || ptr == endptr)
+		return RSSL_FALSE;
+
+	if (*ptr == '/')
+	{
+		ptr++;
+		if (!_rsslScanDigits(&ptr, endptr, 1, 4, &b) || ptr == endptr || *ptr != '/')
+			return RSSL_FALSE;
+		ptr++;
+		if (!_rsslScanDigits(&ptr, endptr, 1, 4, &c))
+			return RSSL_FALSE;
+
+		if (a > 255) // assume year here is greater than MAX UINT8
+		{
+			oDate->day = c;
+			oDate->month = b;
+			oDate->year = a;
+		}
+		else
+		{
+			oDate->day = b;
+			oDate->month = a;
+			oDate->year = (c < 100) ? c + 1900 : c;
+		}
+	}
+	else if (*ptr == ' ' && ptr - *pPtr <= 2 && endptr - ptr >= 6 && ptr[4] == ' ')
+	{
+		for (b = 0; b < 12 && strncmp(months[b], ptr + 1, 3); b++);
+		if (b == 12)
+			return RSSL_FALSE;
+
+		ptr += 5;
+		if (!_rsslScanDigits(&ptr, endptr, 1, 4, &c))
+			return RSSL_FALSE;
+
+		oDate->day = a;
+		oDate->month = b + 1;
+		oDate->year = (c < 100) ? c + 1900 : c;
+	}
+	else
+		return RSSL_FALSE;
+
+	*pPtr = ptr;
+	return RSSL_TRUE;
+}
+
+/* Reads an 'h:m[:s[:milli[:micro[:nano]]]]' time, as "%d:%d:%d:%d:%d:%d" would, at *pPtr,
+ * stopping at endptr, and advances *pPtr past it. Fields not present are set to zero. */
+static RsslBool _rsslScanColonTime(const char **pPtr, const char *endptr, int fields[6], int *oCount)
+{
+	const char *ptr = *pPtr;
+	int count = 0;
+
+	memset(fields, 0, 6 * sizeof(int));
+
+	do
+	{
+		if (count > 0)
+			ptr++;
+		if (!_rsslScanDigits(&ptr, endptr, 1, (count < 3) ? 2 : 3, &fields[count]))
+			return RSSL_FALSE;
+		count++;
+	} while (count < 6 && ptr < endptr && *ptr == ':');
+
+	if (count < 2)
+		return RSSL_FALSE;
+
+	*oCount = count;
+	*pPtr = ptr;
+	return RSSL_TRUE;
+}
+
+static void _rsslSetColonTime(RsslTime *oTime, const int fields[6])
+{
+	oTime->hour = fields[0];
+	oTime->minute = fields[1];
+	oTime->second = fields[2];
+	oTime->millisecond = fields[3];
+	oTime->microsecond = fields[4];
+	oTime->nanosecond = fields[5];
+}
+
+/* yyyy-mm-dd, yyyymmdd, dd MMM yyyy and the mm/dd/yyyy forms */
+static RsslBool _rsslFastDateStringToDate(RsslDate *oDate, const char *ptr, const char *endptr)
+{
+	ptrdiff_t length = endptr - ptr;
+	int year, month, day;
+
+	if (length == 10 && _rsslScanIsoDate(ptr, &year, &month, &day))
+	{
+		oDate->day = day;
+		oDate->month = month;
+		oDate->year = year;
+		return RSSL_TRUE;
+	}
+
+	if (length == 8)
+	{
+		RsslUInt64 value = 0;
+
+		if (_rwfParseDigits(ptr, endptr, &value) == endptr)
+		{
+			oDate->day = (RsslUInt8)(value % 100);
+			oDate->month = (RsslUInt8)(value / 100 % 100);
+			oDate->year = (RsslUInt16)(value / 10000);
+			return RSSL_TRUE;
+		}
+	}
+
+	if (length >= 5)
+	{
+		RsslDate date;
+
+		if (_rsslScanDate(&ptr, endptr, &date) && ptr == endptr)
+		{
+			*oDate = date;
+			return RSSL_TRUE;
+		}
+	}
+
+	return RSSL_FALSE;
+}
+
+/* hh:mm:ss.nnnnnnnnn, hh:mm:ss:mmm:uuu:nnn and shorter, hhmmss.nnnnnnnnn, hhmmss and hhmm */
+static RsslBool _rsslFastTimeStringToTime(RsslTime *oTime, const char *ptr, const char *endptr)
+{
+	const char *start = ptr;
+	RsslUInt16 milli, micro, nano;
+	int fields[6];
+	int count, value;
+
+	if (_rsslScanColonTime(&ptr, endptr, fields, &count))
+	{
+		if (ptr == endptr)
+		{
+			_rsslSetColonTime(oTime, fields);
+			return RSSL_TRUE;
+		}
+
+		if (count == 3 && (*ptr == '.' || *ptr == ',') && _rsslScanFraction(ptr + 1, endptr, &milli, &micro, &nano))
+		{
+			oTime->hour = fields[0];
+			oTime->minute = fields[1];
+			oTime->second = fields[2];
+			oTime->millisecond = milli;
+			oTime->microsecond = micro;
+			oTime->nanosecond = nano;
+			return RSSL_TRUE;
+		}
+		return RSSL_FALSE;
+	}
+
+	/* ISO 8601 basic format; the sub-second fields are only set when present */
+	ptr = start;
+	if (!_rsslScanDigits(&ptr, endptr, 4, 6, &value) || (ptr - start) == 5)
+		return RSSL_FALSE;
+
+	if (ptr == endptr)
+	{
+		oTime->hour = _rsslTwoDigits(start);
+		oTime->minute = _rsslTwoDigits(start + 2);
+		oTime->second = (ptr - start == 6) ? _rsslTwoDigits(start + 4) : 0;
+		return RSSL_TRUE;
+	}
+
+	if (ptr - start == 6 && (*ptr == '.' || *ptr == ',') && _rsslScanFraction(ptr + 1, endptr, &milli, &micro, &nano))
+	{
+		oTime->hour = _rsslTwoDigits(start);
+		oTime->minute = _rsslTwoDigits(start + 2);
+		oTime->second = _rsslTwoDigits(start + 4);
+		oTime->millisecond = milli;
+		oTime->microsecond = micro;
+		oTime->nanosecond = nano;
+		return RSSL_TRUE;
+	}
+
+	return RSSL_FALSE;
+}
+
+/* yyyy-mm-ddThh:mm[:ss[.nnnnnnnnn]] and the dd MMM yyyy or mm/dd/yyyy dates followed by hh:mm[:ss[:mmm[:uuu[:nnn]]]] */
+static RsslBool _rsslFastDateTimeStringToDateTime(RsslDateTime *oDateTime, const char *ptr, const char *endptr)
+{
+	ptrdiff_t length = endptr - ptr;
+	RsslUInt16 milli, micro, nano;
+	RsslDate date;
+	int fields[6];
+	int count;
+
+	if (length >= 16 && ptr[10] == 'T')
+	{
+		int year, month, day, hour, minute, second = 0;
+
+		if (!_rsslScanIsoDate(ptr, &year, &month, &day) || ptr[13] != ':'
+				|| (hour = _rsslTwoDigits(ptr + 11)) < 0 || (minute = _rsslTwoDigits(ptr + 14)) < 0)
+			return RSSL_FALSE;
+
+		if (length > 16)
+		{
+			if (length < 19 || ptr[16] != ':' || (second = _rsslTwoDigits(ptr + 17)) < 0)
+				return RSSL_FALSE;
+
+			if (length > 19 && ((ptr[19] != '.' && ptr[19] != ',') || !_rsslScanFraction(ptr + 20, endptr, &milli, &micro, &nano)))
+				return RSSL_FALSE;
+		}
+
+		/* Only the fields present are set */
+		oDateTime->date.day = day;
+		oDateTime->date.month = month;
+		oDateTime->date.year = year;
+		oDateTime->time.hour = hour;
+		oDateTime->time.minute = minute;
+		if (length > 16)
+			oDateTime->time.second = second;
+		if (length > 19)
+		{
+			oDateTime->time.millisecond = milli;
+			oDateTime->time.microsecond = micro;
+			oDateTime->time.nanosecond = nano;
+		}
+		return RSSL_TRUE;
+	}
+
+	if (_rsslScanDate(&ptr, endptr, &date) && ptr < endptr && *ptr == ' ')
+	{
+		ptr++;
+		if (_rsslScanColonTime(&ptr, endptr, fields, &count) && ptr == endptr)
+		{
+			oDateTime->date = date;
+			_rsslSetColonTime(&oDateTime->time, fields);
+			return RSSL_TRUE;
+		}
+	}
+
+	return RSSL_FALSE;
+}
+
 RSSL_API RsslRet rsslDateStringToDate(RsslDate * oDate, const RsslBuffer * iDateString)
 {
 	char * tmp;
@@ -633,6 +947,9 @@ RSSL_API RsslRet rsslDateStringToDate(RsslDate * oDate, const RsslBuffer * iDate
 		return RSSL_RET_BLANK_DATA;
 	}
 
+	if (rwfFastStringParsing && _rsslFastDateStringToDate(oDate, iDateString->data, iDateString->data + iDateString->length))
+		return RSSL_RET_SUCCESS;
+
 	if (sscanf(iDateString->data, "%4d-%2d-%2d", &a, &b, &c ) == 3)
 	{ /* Read ISO 8601 datetime format yyyy-mm-dd e.g. 2017-08-12 */
 		oDate->day = c;
@@ -828,6 +1145,9 @@ RSSL_API RsslRet rsslTimeStringToTime(RsslTime * oTime, const RsslBuffer * iTime
 
 		return RSSL_RET_BLANK_DATA;
 	}
+
+	if (rwfFastStringParsing && _rsslFastTimeStringToTime(oTime, iTimeString->data, iTimeString->data + iTimeString->length))
+		return RSSL_RET_SUCCESS;
 	
 	if (sscanf(iTimeString->data, "%2d:%2d:%2d.%9s", &hour, &min, &sec, isoFractionalTime) == 4)
 	{ /* Read ISO hh:mm:ss,nnnnnnnnn e.g. 08:37:48,009216350 */
@@ -1014,6 +1334,9 @@ RSSL_API RsslRet rsslDateTimeStringToDateTime(RsslDateTime *oDateTime, const Rss
 		return RSSL_RET_BLANK_DATA;
 	}
 
+	if (rwfFastStringParsing && _rsslFastDateTimeStringToDateTime(oDateTime, iDateTimeString->data, iDateTimeString->data + iDateTimeString->length))
+		return RSSL_RET_SUCCESS;
+
 	if (sscanf(iDateTimeString->data, "%4d-%2d-%2dT%2d:%2d:%2d.%9s", &a, &b, &c, &hour, &minute, &second, isoFractionalTime) == 7)
 	{ /* Read ISO 8601 datetime format yyyy-mm-ddThh:mm:ss.nnnnnnnnn e.g. 2017-08-12T23:20:50.550967845  Or digits < 9 after decimal */
 		oDateTime->date.day = c;
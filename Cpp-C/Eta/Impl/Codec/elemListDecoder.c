@@ -127,8 +127,9 @@ RSSL_API RsslRet rsslDecodeElementList(
 		}
 		else
 		{
+			/* position is already past the set data when standard data follows it */
 			_levelInfo->_setCount = 0;
-			_levelInfo->_nextEntryPtr = /* oIter->_curBufPtr = */ position + oElementList->encSetData.length;
+			_levelInfo->_nextEntryPtr = /* oIter->_curBufPtr = */ (oElementList->encEntries.data) ? oElementList->encEntries.data : position + oElementList->encSetData.length;
 			return RSSL_RET_SET_SKIPPED;
 		}
 	}
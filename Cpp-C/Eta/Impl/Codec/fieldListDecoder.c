@@ -133,8 +133,9 @@ RSSL_API RsslRet rsslDecodeFieldList(
 		}
 		else
 		{
+			/* position is already past the set data when standard data follows it */
 			_levelInfo->_setCount = 0;
-			_levelInfo->_nextEntryPtr = /* oIter->_curBufPtr = */ position + oFieldList->encSetData.length;
+			_levelInfo->_nextEntryPtr = /* oIter->_curBufPtr = */ (oFieldList->encEntries.data) ? oFieldList->encEntries.data : position + oFieldList->encSetData.length;
 			return RSSL_RET_SET_SKIPPED;
 		}
 	}
@@ -241,6 +242,159 @@ RSSL_API RsslRet rsslDecodeFieldEntry(
 	return RSSL_RET_SUCCESS;
 }
 
+/* A later entry for a field replaces an earlier one. */
+RTR_C_ALWAYS_INLINE void _rsslFieldListIndexInsert(RsslFieldListIndex *pIndex, RsslFieldId fieldId, RsslUInt32 position)
+{
+	RsslUInt32 key = (RsslUInt32)(RsslUInt16)fieldId << 16;
+	RsslUInt32 slot = _rsslFieldListIndexHash(fieldId, pIndex->_hashShift);
+
+	while (pIndex->_hashTable[slot] != 0 && (pIndex->_hashTable[slot] & 0xFFFF0000U) != key)
+		slot = (slot + 1) & pIndex->_hashMask;
+	if (pIndex->_hashTable[slot] != 0)
+		pIndex->_hasDuplicates = RSSL_TRUE;
+	pIndex->_hashTable[slot] = key | (position + 1);
+}
+
+RSSL_API RsslRet rsslDecodeFieldListIndex(
+				RsslDecodeIterator		*iIter,
+				RsslFieldListIndex		*pIndex )
+{
+	RsslDecodingLevel *_levelInfo;
+	RsslFieldList *fieldList;
+	RsslFieldListIndexEntry *entries;
+	RsslFieldEntry field;
+	RsslUInt32 count = 0, hashSize = 0, hashBits = 0;
+	RsslUInt32 *hashTable = NULL;
+	char *position, *base;
+	RsslRet ret;
+
+	RSSL_ASSERT(iIter && pIndex, Invalid parameters or parameters passed in as NULL);
+	RSSL_ASSERT(iIter->_decodingLevel > -1 && iIter->_decodingLevel < RSSL_ITER_MAX_LEVELS, Invalid or incorrect iterator used);
+
+	_levelInfo = &iIter->_levelInfo[iIter->_decodingLevel];
+
+	if (_levelInfo->_containerType != RSSL_DT_FIELD_LIST || _levelInfo->_nextItemPosition != 0)
+		return RSSL_RET_INVALID_ARGUMENT;
+
+	if (_levelInfo->_itemCount > RSSL_FIELD_LIST_INDEX_SCAN_MAX)
+	{
+		/* at most half full, so a lookup of an absent field soon finds an empty slot */
+		for (hashBits = 5, hashSize = 32; hashSize < 2 * (RsslUInt32)_levelInfo->_itemCount; ++hashBits, hashSize <<= 1);
+	}
+
+	entries = (RsslFieldListIndexEntry*)(pIndex->memory.data + 
+		((sizeof(RsslUInt32) - ((size_t)pIndex->memory.data & (sizeof(RsslUInt32) - 1))) & (sizeof(RsslUInt32) - 1)));
+
+	if (pIndex->memory.data == NULL 
+			|| (char*)(entries + _levelInfo->_itemCount) + hashSize * sizeof(RsslUInt32) > pIndex->memory.data + pIndex->memory.length)
+		return RSSL_RET_BUFFER_TOO_SMALL;
+
+	pIndex->entries = entries;
+	pIndex->_decodingLevel = iIter->_decodingLevel;
+	if (hashSize)
+	{
+		hashTable = (RsslUInt32*)(entries + _levelInfo->_itemCount);
+		memset(hashTable, 0, hashSize * sizeof(RsslUInt32));
+		pIndex->_hashMask = hashSize - 1;
+		pIndex->_hashShift = (RsslUInt8)(32 - hashBits);
+		pIndex->_hasDuplicates = RSSL_FALSE;
+	}
+	else
+	{
+		pIndex->_hashMask = 0;
+		pIndex->_hashShift = 0;
+		pIndex->_hasDuplicates = RSSL_TRUE;
+	}
+	pIndex->_hashTable = hashTable;
+
+	/* set data, if any, comes before the standard entries */
+	fieldList = (RsslFieldList*)_levelInfo->_listType;
+	pIndex->_entryBase = base = (_levelInfo->_setCount > 0) ? fieldList->encSetData.data : fieldList->encEntries.data;
+
+	/* Set defined entries are located by their definitions, as rsslDecodeFieldEntry() does. */
+	while (_levelInfo->_nextSetPosition < _levelInfo->_setCount)
+	{
+		if ((ret = rsslDecodeFieldEntry(iIter, &field)) != RSSL_RET_SUCCESS)
+			return ret;
+
+		entries[count].fieldId = field.fieldId;
+		entries[count].dataType = field.dataType;
+		entries[count]._lengthSize = 0;
+		entries[count].offset = (RsslUInt32)(iIter->_curBufPtr - base);
+		entries[count].length = (RsslUInt32)(iIter->_levelInfo[iIter->_decodingLevel + 1]._endBufPtr - iIter->_curBufPtr);
+		if (hashTable)
+			_rsslFieldListIndexInsert(pIndex, field.fieldId, count);
+		++count;
+	}
+
+	/* Standard entries are only the field identifier and the length specified content.
+	 * Kept in locals, as the byte-wise gets could otherwise alias the iterator. */
+	if ((position = fieldList->encEntries.data) != NULL)
+	{
+		char *endBufPtr = _levelInfo->_endBufPtr;
+		RsslUInt16 item = _levelInfo->_nextItemPosition, itemCount = _levelInfo->_itemCount;
+
+		for (; item < itemCount; ++item, ++count)
+		{
+			RsslFieldId fieldId;
+			RsslBuffer encData;
+			char *lengthPosition;
+
+			if (endBufPtr - position < 3)
+				return RSSL_RET_INCOMPLETE_DATA;
+
+			position += rwfGet16(fieldId, position);
+			lengthPosition = position;
+			position += rwfGetBuffer16(&encData, position);
+			if (position > endBufPtr)
+				return RSSL_RET_INCOMPLETE_DATA;
+
+			entries[count].fieldId = fieldId;
+			entries[count].dataType = RSSL_DT_UNKNOWN;
+			entries[count]._lengthSize = (RsslUInt8)(encData.data - lengthPosition);
+			entries[count].offset = (RsslUInt32)(encData.data - base);
+			entries[count].length = encData.length;
+			if (hashTable)
+				_rsslFieldListIndexInsert(pIndex, fieldId, count);
+		}
+
+		_levelInfo->_nextItemPosition = item;
+		_levelInfo->_nextEntryPtr = iIter->_curBufPtr = position;
+	}
+
+	pIndex->entryCount = count;
+
+	return RSSL_RET_SUCCESS;
+}
+
+RSSL_API RsslRet rsslDecodeFieldEntryAt(
+				RsslDecodeIterator			*iIter,
+				const RsslFieldListIndex	*pIndex,
+				RsslFieldId					fieldId,
+				RsslFieldEntry				*oField )
+{
+	const RsslFieldListIndexEntry *entry;
+
+	RSSL_ASSERT(iIter && pIndex && oField, Invalid parameters or parameters passed in as NULL);
+	RSSL_ASSERT(pIndex->_decodingLevel > -1, Field list index was not built);
+
+	entry = _rsslFieldListIndexFind(pIndex, fieldId);
+	if (entry == NULL)
+		return RSSL_RET_NO_DATA;
+
+	/* Return to the list's level, in case a container entry was decoded since the last lookup */
+	iIter->_decodingLevel = pIndex->_decodingLevel;
+	iIter->_curBufPtr = pIndex->_entryBase + entry->offset;
+	iIter->_levelInfo[iIter->_decodingLevel + 1]._endBufPtr = iIter->_curBufPtr + entry->length;
+
+	oField->fieldId = entry->fieldId;
+	oField->dataType = entry->dataType;
+	oField->encData.data = iIter->_curBufPtr;
+	oField->encData.length = entry->length;
+
+	return RSSL_RET_SUCCESS;
+}
+
 RSSL_API RsslRet rsslDecodeLocalFieldSetDefDb(
 				RsslDecodeIterator				*pIter,
 				RsslLocalFieldSetDefDb			*oLocalSetDb )
@@ -10,6 +10,8 @@
 
 #include "rtr/rsslFieldList.h"
 #include "rtr/encoderTools.h"
+#include "rtr/decoderTools.h"
+#include "rtr/rsslPrimitiveDecoders.h"
 #include "rtr/rsslIteratorUtilsInt.h"
 
 RsslRet RTR_FASTCALL _rsslCompleteFieldSet(RsslEncodeIterator *pIter, RsslEncodingLevel *_levelInfo, RsslFieldList *pFieldList);
@@ -611,6 +613,560 @@ RSSL_API RsslRet rsslEncodeFieldEntryComplete(
 	return RSSL_RET_SUCCESS;
 }
 
+/**************************/
+/* Field List templates */
+
+/* Width of the fixed width slot of a value, not including any length byte */
+static RsslUInt8 _rsslFieldListTemplateWidth(RsslUInt8 dataType)
+{
+	switch (dataType)
+	{
+		case RSSL_DT_INT:
+		case RSSL_DT_UINT:		return 8;
+		case RSSL_DT_REAL:		return 9;
+		case RSSL_DT_ENUM:		return 2;
+		case RSSL_DT_DATE:		return 4;
+		case RSSL_DT_TIME:		return 8;
+		case RSSL_DT_DATETIME:	return 12;
+		default:				return 0;
+	}
+}
+
+/* Set defined type of a fixed width slot in set data.  Reals and enums stay length specified, 
+ * as the set defined reals cannot hold a blank value in a fixed width. */
+static RsslUInt8 _rsslFieldListTemplateSetType(RsslUInt8 dataType)
+{
+	switch (dataType)
+	{
+		case RSSL_DT_INT:		return RSSL_DT_INT_8;
+		case RSSL_DT_UINT:		return RSSL_DT_UINT_8;
+		case RSSL_DT_DATE:		return RSSL_DT_DATE_4;
+		case RSSL_DT_TIME:		return RSSL_DT_TIME_8;
+		case RSSL_DT_DATETIME:	return RSSL_DT_DATETIME_12;
+		default:				return dataType;
+	}
+}
+
+RSSL_API RsslRet rsslCompileFieldListTemplate(
+				RsslFieldListTemplate				*pTemplate,
+				const RsslFieldListTemplateEntry	*pEntries,
+				RsslUInt16							entryCount )
+{
+	RsslBool setDefined, fixedWidth;
+	RsslFieldSetDefEntry *pSetEntries;
+	RsslUInt32 i, encLength;
+	char *pos, *endPos;
+	RsslUInt8 flags;
+
+	RSSL_ASSERT(pTemplate && (pEntries || !entryCount), Invalid parameters or parameters passed in as NULL);
+
+	setDefined = (pTemplate->flags & RSSL_FLTF_SET_DEFINED) ? RSSL_TRUE : RSSL_FALSE;
+	if (setDefined && (pTemplate->setId > RSSL_FIELD_SET_MAX_LOCAL_ID || entryCount > 255))
+		return RSSL_RET_INVALID_ARGUMENT;
+
+	fixedWidth = (pTemplate->flags & RSSL_FLTF_VARIABLE_WIDTH) ? RSSL_FALSE : RSSL_TRUE;
+	for (i = 0; i < entryCount; ++i)
+	{
+		switch (pEntries[i].dataType)
+		{
+			case RSSL_DT_INT: case RSSL_DT_UINT: case RSSL_DT_REAL: case RSSL_DT_ENUM:
+			case RSSL_DT_DATE: case RSSL_DT_TIME: case RSSL_DT_DATETIME:
+				break;
+			case RSSL_DT_BUFFER: case RSSL_DT_ASCII_STRING: case RSSL_DT_UTF8_STRING: case RSSL_DT_RMTES_STRING:
+				fixedWidth = RSSL_FALSE;
+				break;
+			default:
+				return RSSL_RET_INVALID_ARGUMENT;
+		}
+	}
+
+	/* slots, then set definition entries, then the encoding */
+	pTemplate->_slots = (RsslFieldListTemplateSlot*)(pTemplate->memory.data + 
+		((sizeof(RsslUInt32) - ((size_t)pTemplate->memory.data & (sizeof(RsslUInt32) - 1))) & (sizeof(RsslUInt32) - 1)));
+	pSetEntries = (RsslFieldSetDefEntry*)(pTemplate->_slots + entryCount);
+	pos = pTemplate->_encData = (char*)(pSetEntries + (setDefined ? entryCount : 0));
+	endPos = pTemplate->memory.data + pTemplate->memory.length;
+
+	/* header, at most flags, set id and count */
+	if (pTemplate->memory.data == NULL || pos + 5 > endPos)
+		return RSSL_RET_BUFFER_TOO_SMALL;
+
+	if (setDefined)
+	{
+		flags = RSSL_FLF_HAS_SET_DATA;
+		if (pTemplate->setId != 0)
+			flags |= RSSL_FLF_HAS_SET_ID;
+		pos += rwfPut8(pos, flags);
+		if (pTemplate->setId != 0)
+			pos += rwfPutResBitU15(pos, pTemplate->setId);
+	}
+	else
+	{
+		pos += rwfPut8(pos, RSSL_FLF_HAS_STANDARD_DATA);
+		pos += rwfPut16(pos, entryCount);
+	}
+
+	for (i = 0; i < entryCount; ++i)
+	{
+		RsslFieldListTemplateSlot *pSlot = &pTemplate->_slots[i];
+		RsslUInt8 width = _rsslFieldListTemplateWidth(pEntries[i].dataType);
+
+		pSlot->fieldId = pEntries[i].fieldId;
+		pSlot->dataType = pEntries[i].dataType;
+		pSlot->encDataType = (setDefined && fixedWidth) ? _rsslFieldListTemplateSetType(pEntries[i].dataType) : pEntries[i].dataType;
+		pSlot->offset = 0;
+
+		if (setDefined)
+		{
+			pSetEntries[i].fieldId = pSlot->fieldId;
+			pSetEntries[i].dataType = pSlot->encDataType;
+		}
+
+		if (!fixedWidth)
+			continue;
+
+		if (pos + 3 + width > endPos)
+			return RSSL_RET_BUFFER_TOO_SMALL;
+
+		if (!setDefined)
+			pos += rwfPut16(pos, pSlot->fieldId);
+		if (pSlot->encDataType < RSSL_DT_SET_PRIMITIVE_MIN)
+			pos += rwfPut8(pos, width);
+
+		pSlot->offset = (RsslUInt32)(pos - pTemplate->_encData);
+		memset(pos, 0, width);
+		pos += width;
+	}
+
+	encLength = (RsslUInt32)(pos - pTemplate->_encData);
+
+	pTemplate->entryCount = entryCount;
+	pTemplate->_encLength = encLength;
+	pTemplate->_fixedWidth = fixedWidth;
+	if (setDefined)
+	{
+		pTemplate->setDef.setId = pTemplate->setId;
+		pTemplate->setDef.count = (RsslUInt8)entryCount;
+		pTemplate->setDef.pEntries = pSetEntries;
+	}
+	else
+		rsslClearFieldSetDef(&pTemplate->setDef);
+
+	return RSSL_RET_SUCCESS;
+}
+
+RTR_C_ALWAYS_INLINE char *_rsslPutTemplateTime(char *pos, const RsslTime *pTime)
+{
+	pos += rwfPut8(pos, pTime->hour);
+	pos += rwfPut8(pos, pTime->minute);
+	pos += rwfPut8(pos, pTime->second);
+	pos += rwfPut16(pos, pTime->millisecond);
+	pos += rwfPut16(pos, (RsslUInt16)(((pTime->nanosecond & 0xFF00) << 3) | pTime->microsecond));
+	pos += rwfPut8(pos, (RsslUInt8)pTime->nanosecond);
+	return pos;
+}
+
+RTR_C_ALWAYS_INLINE char *_rsslPutTemplateDate(char *pos, const RsslDate *pDate)
+{
+	pos += rwfPut8(pos, pDate->day);
+	pos += rwfPut8(pos, pDate->month);
+	pos += rwfPut16(pos, pDate->year);
+	return pos;
+}
+
+RSSL_API RsslRet rsslEncodeFieldListTemplate(
+				RsslEncodeIterator					*pIter,
+				const RsslFieldListTemplate			*pTemplate,
+				const RsslFieldListTemplateValue	*pValues )
+{
+	const RsslFieldListTemplateSlot *pSlot, *pEndSlot;
+	RsslEncodingLevel *_levelInfo;
+	char *startPos;
+	RsslRet ret;
+
+	RSSL_ASSERT(pIter && pTemplate && (pValues || !pTemplate->entryCount), Invalid parameters or parameters passed in as NULL);
+	RSSL_ASSERT(pIter->_pBuffer && pIter->_pBuffer->data, Invalid iterator use - check buffer);
+
+	if (_rsslIteratorOverrun(pIter, pTemplate->_encLength))
+		return RSSL_RET_BUFFER_TOO_SMALL;
+
+	startPos = pIter->_curBufPtr;
+	MemCopyByInt(startPos, pTemplate->_encData, pTemplate->_encLength);
+	pEndSlot = pTemplate->_slots + pTemplate->entryCount;
+
+	if (pTemplate->_fixedWidth)
+	{
+		/* Only the values need writing; nothing is committed until the iterator is moved past them. */
+		for (pSlot = pTemplate->_slots; pSlot < pEndSlot; ++pSlot, ++pValues)
+		{
+			char *pos = startPos + pSlot->offset;
+
+			switch (pSlot->dataType)
+			{
+				case RSSL_DT_INT:
+					rwfPut64(pos, pValues->intValue);
+					break;
+				case RSSL_DT_UINT:
+					rwfPut64(pos, pValues->uintValue);
+					break;
+				case RSSL_DT_REAL:
+					if (pValues->realValue.isBlank)
+					{
+						pos += rwfPut8(pos, 0x20);
+						memset(pos, 0, 8);
+					}
+					else
+					{
+						/* 31 and 32 are currently reserved */
+						if (pValues->realValue.hint > RSSL_RH_NOT_A_NUMBER || pValues->realValue.hint == 31 || pValues->realValue.hint == 32)
+							return RSSL_RET_INVALID_DATA;
+						pos += rwfPut8(pos, pValues->realValue.hint);
+						rwfPut64(pos, pValues->realValue.value);
+					}
+					break;
+				case RSSL_DT_ENUM:
+					rwfPut16(pos, pValues->enumValue);
+					break;
+				case RSSL_DT_DATE:
+					_rsslPutTemplateDate(pos, &pValues->dateValue);
+					break;
+				case RSSL_DT_TIME:
+					_rsslPutTemplateTime(pos, &pValues->timeValue);
+					break;
+				case RSSL_DT_DATETIME:
+					_rsslPutTemplateTime(_rsslPutTemplateDate(pos, &pValues->dateTimeValue.date), &pValues->dateTimeValue.time);
+					break;
+			}
+		}
+
+		pIter->_curBufPtr += pTemplate->_encLength;
+		return RSSL_RET_SUCCESS;
+	}
+
+	/* Variable width: the header was copied, each entry is encoded by the encoder for its type */
+	_levelInfo = &pIter->_levelInfo[++pIter->_encodingLevel]; if (pIter->_encodingLevel >= RSSL_ITER_MAX_LEVELS) { --pIter->_encodingLevel; return RSSL_RET_ITERATOR_OVERRUN; }
+	_rsslInitEncodeIterator(_levelInfo, RSSL_DT_FIELD_LIST, (pTemplate->flags & RSSL_FLTF_SET_DEFINED) ? RSSL_EIS_SET_DATA : RSSL_EIS_PRIMITIVE, NULL, startPos);
+	pIter->_curBufPtr += pTemplate->_encLength;
+
+	for (pSlot = pTemplate->_slots; pSlot < pEndSlot; ++pSlot, ++pValues)
+	{
+		if (_levelInfo->_encodingState == RSSL_EIS_PRIMITIVE)
+		{
+			if (_rsslIteratorOverrun(pIter, 2))
+			{
+				ret = RSSL_RET_BUFFER_TOO_SMALL;
+				break;
+			}
+			pIter->_curBufPtr += rwfPut16(pIter->_curBufPtr, pSlot->fieldId);
+		}
+
+		if ((ret = (*(_rsslDataTypeInfo[pSlot->encDataType].rawEncoders))(pIter, pValues)) < 0)
+			break;
+	}
+
+	--pIter->_encodingLevel;
+	if (pSlot < pEndSlot)
+	{
+		pIter->_curBufPtr = startPos;
+		return ret;
+	}
+
+	return RSSL_RET_SUCCESS;
+}
+
+/**********************/
+/* Field List deltas */
+
+/* Encodes an indexed entry as a standard entry.  Set defined numeric, date and time values are decoded and
+ * encoded again, as the set encodings of those types differ from the standard ones.  The content of any
+ * other entry is already what a standard entry holds, so is copied. */
+static RsslRet _rsslEncodeIndexedFieldEntry(RsslEncodeIterator *pIter, RsslEncodingLevel *_levelInfo,
+				const RsslFieldListIndex *pIndex, const RsslFieldListIndexEntry *pEntry)
+{
+	RsslBuffer encData;
+
+	encData.data = pIndex->_entryBase + pEntry->offset;
+	encData.length = pEntry->length;
+
+	switch (pEntry->dataType)
+	{
+		case RSSL_DT_INT: case RSSL_DT_UINT: case RSSL_DT_FLOAT: case RSSL_DT_DOUBLE: case RSSL_DT_REAL:
+		case RSSL_DT_DATE: case RSSL_DT_TIME: case RSSL_DT_DATETIME:
+		{
+			union {
+				RsslInt64		intValue;
+				RsslUInt64		uintValue;
+				RsslFloat		floatValue;
+				RsslDouble		doubleValue;
+				RsslReal		realValue;
+				RsslDate		dateValue;
+				RsslTime		timeValue;
+				RsslDateTime	dateTimeValue;
+			} value;
+			RsslDecodeIterator dIter;
+			RsslFieldEntry field;
+			RsslRet ret;
+
+			rsslClearDecodeIterator(&dIter);
+			rsslSetDecodeIteratorBuffer(&dIter, &encData);
+			if ((ret = rsslDecodePrimitiveType(&dIter, pEntry->dataType, &value)) < 0)
+				return ret;
+
+			field.fieldId = pEntry->fieldId;
+			field.dataType = pEntry->dataType;
+			field.encData.length = 0;
+			field.encData.data = 0;
+			return rsslEncodeFieldEntry(pIter, &field, (ret == RSSL_RET_BLANK_DATA) ? NULL : &value);
+		}
+
+		default:
+			break;
+	}
+
+	if (_rsslIteratorOverrun(pIter, encData.length + ((encData.length < 0xFE) ? 3 : 5)))
+		return RSSL_RET_BUFFER_TOO_SMALL;
+
+	pIter->_curBufPtr += rwfPut16(pIter->_curBufPtr, pEntry->fieldId);
+	pIter->_curBufPtr = _rsslEncodeBuffer16(pIter->_curBufPtr, &encData);
+	_levelInfo->_currentCount++;
+
+	return RSSL_RET_SUCCESS;
+}
+
+/* Most values are a few bytes, for which a loop is cheaper than calling memcmp() */
+RTR_C_ALWAYS_INLINE RsslBool _rsslFieldListIndexEntriesEqual(const RsslFieldListIndex *pIndex1, const RsslFieldListIndexEntry *pEntry1,
+				const RsslFieldListIndex *pIndex2, const RsslFieldListIndexEntry *pEntry2)
+{
+	const char *pData1, *pData2;
+	RsslUInt32 i;
+
+	if (pEntry1->length != pEntry2->length || pEntry1->dataType != pEntry2->dataType)
+		return RSSL_FALSE;
+
+	pData1 = pIndex1->_entryBase + pEntry1->offset;
+	pData2 = pIndex2->_entryBase + pEntry2->offset;
+	if (pEntry1->length > 16)
+		return (memcmp(pData1, pData2, pEntry1->length) == 0) ? RSSL_TRUE : RSSL_FALSE;
+
+	for (i = 0; i < pEntry1->length; ++i)
+	{
+		if (pData1[i] != pData2[i])
+			return RSSL_FALSE;
+	}
+	return RSSL_TRUE;
+}
+
+/* Whether an entry is the last for its field identifier, so the one that is used */
+#define _rsslFieldListIndexIsLast(PINDEX, PENTRY) \
+	(!(PINDEX)->_hasDuplicates || _rsslFieldListIndexFind((PINDEX), (PENTRY)->fieldId) == (PENTRY))
+
+/* One bit of 64 for a field identifier, to rule out lookups of fields a short list cannot have */
+#define _rsslFieldListIndexMaskBit(FID) ((RsslUInt64)1 << _rsslFieldListIndexHash((FID), 26))
+
+/* Start of an indexed standard entry, from its field identifier, or NULL for a set defined entry */
+#define _rsslFieldListIndexEntryStart(PINDEX, PENTRY) \
+	((PENTRY)->_lengthSize ? (PINDEX)->_entryBase + (PENTRY)->offset - 2 - (PENTRY)->_lengthSize : NULL)
+
+/* Standard entries that lie one after another in a list are copied together, with their field identifiers and lengths */
+typedef struct {
+	char		*pStart;
+	char		*pEnd;
+	RsslUInt16	count;
+} RsslFieldEntryRun;
+
+RTR_C_ALWAYS_INLINE RsslRet _rsslFieldEntryRunFlush(RsslEncodeIterator *pIter, RsslEncodingLevel *_levelInfo, RsslFieldEntryRun *pRun)
+{
+	RsslUInt32 length = (RsslUInt32)(pRun->pEnd - pRun->pStart);
+
+	if (pRun->count == 0)
+		return RSSL_RET_SUCCESS;
+
+	if (_rsslIteratorOverrun(pIter, length))
+		return RSSL_RET_BUFFER_TOO_SMALL;
+
+	memcpy(pIter->_curBufPtr, pRun->pStart, length);
+	pIter->_curBufPtr += length;
+	_levelInfo->_currentCount += pRun->count;
+	pRun->pStart = pRun->pEnd = NULL;
+	pRun->count = 0;
+	return RSSL_RET_SUCCESS;
+}
+
+/* Adds an indexed entry to the run, or encodes it if it cannot be copied as part of one */
+RTR_C_ALWAYS_INLINE RsslRet _rsslFieldEntryRunAdd(RsslEncodeIterator *pIter, RsslEncodingLevel *_levelInfo, RsslFieldEntryRun *pRun,
+				const RsslFieldListIndex *pIndex, const RsslFieldListIndexEntry *pEntry)
+{
+	char *pStart = _rsslFieldListIndexEntryStart(pIndex, pEntry);
+	RsslRet ret;
+
+	if (pStart == NULL || pStart != pRun->pEnd)
+	{
+		if ((ret = _rsslFieldEntryRunFlush(pIter, _levelInfo, pRun)) < 0)
+			return ret;
+		if (pStart == NULL)
+			return _rsslEncodeIndexedFieldEntry(pIter, _levelInfo, pIndex, pEntry);
+		pRun->pStart = pStart;
+	}
+
+	pRun->pEnd = pIndex->_entryBase + pEntry->offset + pEntry->length;
+	++pRun->count;
+	return RSSL_RET_SUCCESS;
+}
+
+RSSL_API RsslRet rsslEncodeFieldListDelta(
+				RsslEncodeIterator			*pIter,
+				const RsslFieldListIndex	*pOldIndex,
+				const RsslFieldListIndex	*pNewIndex )
+{
+	RsslEncodingLevel *_levelInfo;
+	const RsslFieldListIndexEntry *pEntry, *pEndEntry, *pOldEntry;
+	RsslFieldEntryRun run = { NULL, NULL, 0 };
+	char *startPos;
+	RsslUInt16 startCount;
+	RsslBool sameFields;
+	RsslUInt32 position;
+	RsslRet ret = RSSL_RET_SUCCESS;
+
+	RSSL_ASSERT(pIter && pOldIndex && pNewIndex, Invalid parameters or parameters passed in as NULL);
+	RSSL_ASSERT(pOldIndex->_decodingLevel > -1 && pNewIndex->_decodingLevel > -1, Field list index was not built);
+
+	_levelInfo = &pIter->_levelInfo[pIter->_encodingLevel];
+
+	RSSL_ASSERT(_levelInfo->_containerType == RSSL_DT_FIELD_LIST, Invalid encoding attempted - wrong container);
+
+	if (_levelInfo->_encodingState != RSSL_EIS_ENTRIES)
+		return RSSL_RET_INVALID_ARGUMENT;
+
+	startPos = pIter->_curBufPtr;
+	startCount = _levelInfo->_currentCount;
+
+	/* Images of an item usually have their fields in the same order, so the old entry in the same position
+	 * is tried before looking the field up.  If every field is found that way, no field was removed. */
+	sameFields = (!pOldIndex->_hasDuplicates && !pNewIndex->_hasDuplicates && pOldIndex->entryCount == pNewIndex->entryCount);
+
+	/* Changed and added fields, in the order of the new image */
+	for (position = 0; position < pNewIndex->entryCount; ++position)
+	{
+		pEntry = &pNewIndex->entries[position];
+
+		if (!_rsslFieldListIndexIsLast(pNewIndex, pEntry))
+			continue;
+
+		if (!pOldIndex->_hasDuplicates && position < pOldIndex->entryCount && pOldIndex->entries[position].fieldId == pEntry->fieldId)
+			pOldEntry = &pOldIndex->entries[position];
+		else
+		{
+			sameFields = RSSL_FALSE;
+			pOldEntry = _rsslFieldListIndexFind(pOldIndex, pEntry->fieldId);
+		}
+
+		if (pOldEntry != NULL && _rsslFieldListIndexEntriesEqual(pOldIndex, pOldEntry, pNewIndex, pEntry))
+			continue;
+
+		if ((ret = _rsslFieldEntryRunAdd(pIter, _levelInfo, &run, pNewIndex, pEntry)) < 0)
+			break;
+	}
+
+	if (ret >= 0)
+		ret = _rsslFieldEntryRunFlush(pIter, _levelInfo, &run);
+
+	/* Removed fields are blanked */
+	for (pEntry = pOldIndex->entries, pEndEntry = pEntry + pOldIndex->entryCount; !sameFields && ret >= 0 && pEntry < pEndEntry; ++pEntry)
+	{
+		if (_rsslFieldListIndexFind(pNewIndex, pEntry->fieldId) != NULL || !_rsslFieldListIndexIsLast(pOldIndex, pEntry))
+			continue;
+
+		if (_rsslIteratorOverrun(pIter, 3))
+		{
+			ret = RSSL_RET_BUFFER_TOO_SMALL;
+			break;
+		}
+
+		pIter->_curBufPtr += rwfPut16(pIter->_curBufPtr, pEntry->fieldId);
+		pIter->_curBufPtr += rwfPut8(pIter->_curBufPtr, 0);
+		_levelInfo->_currentCount++;
+	}
+
+	if (ret < 0)
+	{
+		/* roll back */
+		pIter->_curBufPtr = startPos;
+		_levelInfo->_currentCount = startCount;
+		return ret;
+	}
+
+	return (_levelInfo->_currentCount == startCount) ? RSSL_RET_NO_DATA : RSSL_RET_SUCCESS;
+}
+
+RSSL_API RsslRet rsslApplyFieldListUpdate(
+				RsslEncodeIterator			*pIter,
+				const RsslFieldListIndex	*pImageIndex,
+				const RsslFieldListIndex	*pUpdateIndex )
+{
+	RsslEncodingLevel *_levelInfo;
+	const RsslFieldListIndexEntry *pEntry, *pEndEntry, *pUpdateEntry;
+	RsslFieldEntryRun run = { NULL, NULL, 0 };
+	char *startPos;
+	RsslUInt16 startCount;
+	RsslUInt64 updateMask = 0;
+	RsslRet ret = RSSL_RET_SUCCESS;
+
+	RSSL_ASSERT(pIter && pImageIndex && pUpdateIndex, Invalid parameters or parameters passed in as NULL);
+	RSSL_ASSERT(pImageIndex->_decodingLevel > -1 && pUpdateIndex->_decodingLevel > -1, Field list index was not built);
+
+	_levelInfo = &pIter->_levelInfo[pIter->_encodingLevel];
+
+	RSSL_ASSERT(_levelInfo->_containerType == RSSL_DT_FIELD_LIST, Invalid encoding attempted - wrong container);
+
+	if (_levelInfo->_encodingState != RSSL_EIS_ENTRIES)
+		return RSSL_RET_INVALID_ARGUMENT;
+
+	startPos = pIter->_curBufPtr;
+	startCount = _levelInfo->_currentCount;
+
+	/* Updates are usually much shorter than the image, so most fields of the image are ruled out by the mask */
+	for (pEntry = pUpdateIndex->entries, pEndEntry = pEntry + pUpdateIndex->entryCount; pEntry < pEndEntry; ++pEntry)
+		updateMask |= _rsslFieldListIndexMaskBit(pEntry->fieldId);
+
+	/* Fields of the image, updated or not */
+	for (pEntry = pImageIndex->entries, pEndEntry = pEntry + pImageIndex->entryCount; pEntry < pEndEntry; ++pEntry)
+	{
+		if (!_rsslFieldListIndexIsLast(pImageIndex, pEntry))
+			continue;
+
+		if ((updateMask & _rsslFieldListIndexMaskBit(pEntry->fieldId))
+				&& (pUpdateEntry = _rsslFieldListIndexFind(pUpdateIndex, pEntry->fieldId)) != NULL)
+			ret = _rsslFieldEntryRunAdd(pIter, _levelInfo, &run, pUpdateIndex, pUpdateEntry);
+		else
+			ret = _rsslFieldEntryRunAdd(pIter, _levelInfo, &run, pImageIndex, pEntry);
+
+		if (ret < 0)
+			break;
+	}
+
+	/* Fields added by the update */
+	for (pEntry = pUpdateIndex->entries, pEndEntry = pEntry + pUpdateIndex->entryCount; ret >= 0 && pEntry < pEndEntry; ++pEntry)
+	{
+		if (_rsslFieldListIndexFind(pImageIndex, pEntry->fieldId) != NULL || !_rsslFieldListIndexIsLast(pUpdateIndex, pEntry))
+			continue;
+
+		ret = _rsslFieldEntryRunAdd(pIter, _levelInfo, &run, pUpdateIndex, pEntry);
+	}
+
+	if (ret >= 0)
+		ret = _rsslFieldEntryRunFlush(pIter, _levelInfo, &run);
+
+	if (ret < 0)
+	{
+		/* roll back */
+		pIter->_curBufPtr = startPos;
+		_levelInfo->_currentCount = startCount;
+		return ret;
+	}
+
+	return RSSL_RET_SUCCESS;
+}
+
 /******************************/
 /* Field List set Definitions */
 
@@ -19,6 +19,14 @@
 #include <math.h>
 #include <float.h>
 #include <ctype.h>
+#include <stddef.h>
+
+/* SIMD batch conversion kernels are selected at runtime using the GCC/Clang target attributes. */
+#if !defined(WIN32) && !defined(_WIN32) && (defined(__x86_64__) || defined(__i386__)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+	#define RSSL_REAL_BATCH_SIMD
+	#include <immintrin.h>
+#endif
 
 /* Suppress warning C4756: overflow in constant arithmetic that occurs only on VS2013 */
 #if defined(WIN32) &&  _MSC_VER == 1800
@@ -69,7 +77,7 @@ RSSL_API RsslRet rsslDoubleToReal(RsslReal * oReal, RsslDouble * iValue, RsslUIn
 		oReal->isBlank = RSSL_FALSE;
 		oReal->value = 0;		
 	}
-	else if (*iValue == NAN)
+	else if (*iValue != *iValue) /* NaN does not compare equal to anything, including NAN */
 	{
 		oReal->hint = RSSL_RH_NOT_A_NUMBER;
 		oReal->isBlank = RSSL_FALSE;
@@ -268,6 +276,226 @@ RSSL_API RsslRet rsslRealToDouble(RsslDouble * oValue, RsslReal * iReal)
 	return RSSL_RET_SUCCESS;
 }
 
+/* Batch Real conversions.
+ * Entries are converted with the same table arithmetic as rsslRealToDouble() and rsslDoubleToReal(),
+ * so each result is identical to the scalar function.  The SIMD kernels of rsslDoubleToRealBatch()
+ * only store values within +/- 2^51, which are converted from double exactly by adding and
+ * subtracting 1.5 * 2^52.  Any other entry (infinity, NaN or very large values) is converted by
+ * rsslDoubleToReal(). */
+
+#define RSSL_REAL_BATCH_LAYOUT (sizeof(RsslReal) == 16 && offsetof(RsslReal, isBlank) == 0 \
+		&& offsetof(RsslReal, hint) == 1 && offsetof(RsslReal, value) == 8)
+
+#define RSSL_REAL_BATCH_MAGIC RTR_LL(0x4338000000000000)		/* 1.5 * 2^52 */
+#define RSSL_REAL_BATCH_LIMIT RTR_LL(0x8000000000000)			/* 2^51 */
+
+static int rwfRealBatchLevelInUse = -1;
+
+rwfRealBatchLevel rwfGetRealBatchMaxLevel()
+{
+#ifdef RSSL_REAL_BATCH_SIMD
+	if (RSSL_REAL_BATCH_LAYOUT)
+	{
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return RWF_REAL_BATCH_AVX2;
+		if (__builtin_cpu_supports("sse4.1"))
+			return RWF_REAL_BATCH_SSE4;
+	}
+#endif
+	return RWF_REAL_BATCH_SCALAR;
+}
+
+rwfRealBatchLevel rwfSetRealBatchLevel(rwfRealBatchLevel level)
+{
+	rwfRealBatchLevel maxLevel = rwfGetRealBatchMaxLevel();
+
+	rwfRealBatchLevelInUse = (level > maxLevel) ? maxLevel : level;
+	return (rwfRealBatchLevel)rwfRealBatchLevelInUse;
+}
+
+RTR_C_ALWAYS_INLINE rwfRealBatchLevel _rsslGetRealBatchLevel()
+{
+	if (rwfRealBatchLevelInUse < 0)
+		rwfRealBatchLevelInUse = rwfGetRealBatchMaxLevel();
+	return (rwfRealBatchLevel)rwfRealBatchLevelInUse;
+}
+
+/* Converts one entry as rsslRealToDouble() does; entries it cannot convert are set to NaN. */
+RTR_C_ALWAYS_INLINE RsslRet _rsslRealToDoubleEntry(RsslDouble *oValue, const RsslReal *iReal)
+{
+#if !defined (WIN32) && !defined (_WIN32)
+	if (iReal->isBlank == RSSL_FALSE && iReal->hint <= RSSL_RH_MAX_DIVISOR)
+	{
+		*oValue = (iReal->value*powHints[iReal->hint]);
+		return RSSL_RET_SUCCESS;
+	}
+#endif
+	if (rsslRealToDouble(oValue, (RsslReal*)iReal) == RSSL_RET_SUCCESS)
+		return RSSL_RET_SUCCESS;
+
+	*oValue = NAN;
+	return RSSL_RET_FAILURE;
+}
+
+/* Converts one entry as rsslDoubleToReal() does; scale is powHintsEx[iHint]. */
+RTR_C_ALWAYS_INLINE void _rsslDoubleToRealEntry(RsslReal *oReal, const RsslDouble *iValue, RsslUInt8 iHint, RsslDouble scale)
+{
+#if !defined (WIN32) && !defined (_WIN32)
+	RsslDouble rounded = floor((*iValue) * scale + 0.5);
+
+	/* Infinity and NaN fail the range check and are handled by rsslDoubleToReal(). */
+	if (rounded >= -9223372036854775808.0 && rounded < 9223372036854775808.0)
+	{
+		oReal->hint = iHint;
+		oReal->isBlank = RSSL_FALSE;
+		oReal->value = (RsslInt)rounded;
+		return;
+	}
+#endif
+	rsslDoubleToReal(oReal, (RsslDouble*)iValue, iHint);
+}
+
+static RsslRet _rsslRealToDoubleBatchScalar(RsslDouble *oValues, const RsslReal *iReals, RsslUInt32 count)
+{
+	RsslRet ret = RSSL_RET_SUCCESS;
+	RsslUInt32 i;
+
+	for (i = 0; i < count; ++i)
+	{
+		if (_rsslRealToDoubleEntry(&oValues[i], &iReals[i]) != RSSL_RET_SUCCESS)
+			ret = RSSL_RET_FAILURE;
+	}
+	return ret;
+}
+
+static void _rsslDoubleToRealBatchScalar(RsslReal *oReals, const RsslDouble *iValues, RsslUInt32 count, RsslUInt8 iHint)
+{
+	RsslDouble scale = powHintsEx[iHint];
+	RsslUInt32 i;
+
+	for (i = 0; i < count; ++i)
+		_rsslDoubleToRealEntry(&oReals[i], &iValues[i], iHint, scale);
+}
+
+#ifdef RSSL_REAL_BATCH_SIMD
+
+/* Returns the first eight bytes of an RsslReal that is not blank and has the given hint. */
+RTR_C_ALWAYS_INLINE RsslInt64 _rsslRealBatchHeader(RsslUInt8 iHint)
+{
+	RsslReal real;
+	RsslInt64 header;
+
+	memset(&real, 0, sizeof(real));
+	real.isBlank = RSSL_FALSE;
+	real.hint = iHint;
+	memcpy(&header, &real, sizeof(header));
+	return header;
+}
+
+__attribute__((target("sse4.1")))
+static void _rsslDoubleToRealBatchSSE4(RsslReal *oReals, const RsslDouble *iValues, RsslUInt32 count, RsslUInt8 iHint)
+{
+	const __m128d scale = _mm_set1_pd(powHintsEx[iHint]);
+	const __m128d half = _mm_set1_pd(0.5);
+	const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(RTR_LL(0x7FFFFFFFFFFFFFFF)));
+	const __m128d limit = _mm_set1_pd((RsslDouble)RSSL_REAL_BATCH_LIMIT);
+	const __m128i magicBits = _mm_set1_epi64x(RSSL_REAL_BATCH_MAGIC);
+	const __m128d magic = _mm_castsi128_pd(magicBits);
+	const __m128i header = _mm_set1_epi64x(_rsslRealBatchHeader(iHint));
+	RsslUInt32 i;
+
+	for (i = 0; i + 2 <= count; i += 2)
+	{
+		__m128d rounded = _mm_floor_pd(_mm_add_pd(_mm_mul_pd(_mm_loadu_pd(&iValues[i]), scale), half));
+
+		if (_mm_movemask_pd(_mm_cmplt_pd(_mm_and_pd(rounded, absMask), limit)) == 0x3)
+		{
+			__m128i values = _mm_sub_epi64(_mm_castpd_si128(_mm_add_pd(rounded, magic)), magicBits);
+
+			_mm_storeu_si128((__m128i*)&oReals[i], _mm_unpacklo_epi64(header, values));
+			_mm_storeu_si128((__m128i*)&oReals[i + 1], _mm_unpackhi_epi64(header, values));
+		}
+		else
+		{
+			_rsslDoubleToRealEntry(&oReals[i], &iValues[i], iHint, powHintsEx[iHint]);
+			_rsslDoubleToRealEntry(&oReals[i + 1], &iValues[i + 1], iHint, powHintsEx[iHint]);
+		}
+	}
+
+	_rsslDoubleToRealBatchScalar(&oReals[i], &iValues[i], count - i, iHint);
+}
+
+__attribute__((target("avx2")))
+static void _rsslDoubleToRealBatchAVX2(RsslReal *oReals, const RsslDouble *iValues, RsslUInt32 count, RsslUInt8 iHint)
+{
+	const __m256d scale = _mm256_set1_pd(powHintsEx[iHint]);
+	const __m256d half = _mm256_set1_pd(0.5);
+	const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(RTR_LL(0x7FFFFFFFFFFFFFFF)));
+	const __m256d limit = _mm256_set1_pd((RsslDouble)RSSL_REAL_BATCH_LIMIT);
+	const __m256i magicBits = _mm256_set1_epi64x(RSSL_REAL_BATCH_MAGIC);
+	const __m256d magic = _mm256_castsi256_pd(magicBits);
+	const __m256i header = _mm256_set1_epi64x(_rsslRealBatchHeader(iHint));
+	RsslUInt32 i, j;
+
+	for (i = 0; i + 4 <= count; i += 4)
+	{
+		__m256d rounded = _mm256_floor_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(&iValues[i]), scale), half));
+
+		if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(rounded, absMask), limit, _CMP_LT_OQ)) == 0xF)
+		{
+			__m256i values = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(rounded, magic)), magicBits);
+			__m256i low = _mm256_unpacklo_epi64(header, values);		/* entries 0 and 2 */
+			__m256i high = _mm256_unpackhi_epi64(header, values);		/* entries 1 and 3 */
+
+			_mm256_storeu_si256((__m256i*)&oReals[i], _mm256_permute2x128_si256(low, high, 0x20));
+			_mm256_storeu_si256((__m256i*)&oReals[i + 2], _mm256_permute2x128_si256(low, high, 0x31));
+		}
+		else
+		{
+			for (j = i; j < i + 4; ++j)
+				_rsslDoubleToRealEntry(&oReals[j], &iValues[j], iHint, powHintsEx[iHint]);
+		}
+	}
+
+	_rsslDoubleToRealBatchScalar(&oReals[i], &iValues[i], count - i, iHint);
+}
+
+#endif
+
+RSSL_API RsslRet rsslRealToDoubleBatch(RsslDouble * oValues, const RsslReal * iReals, RsslUInt32 count)
+{
+	RSSL_ASSERT((oValues && iReals) || count == 0, Invalid parameters or parameters passed in as NULL);
+
+	/* The integer to double conversion and table multiply of each entry is faster than the shuffles needed to
+	 * gather the values and hints of the RsslReal structures into SIMD registers, so no SIMD kernel is used. */
+	return _rsslRealToDoubleBatchScalar(oValues, iReals, count);
+}
+
+RSSL_API RsslRet rsslDoubleToRealBatch(RsslReal * oReals, const RsslDouble * iValues, RsslUInt32 count, RsslUInt8 iHint)
+{
+	RSSL_ASSERT((oReals && iValues) || count == 0, Invalid parameters or parameters passed in as NULL);
+
+	if (iHint > RSSL_RH_MAX_DIVISOR)
+		return RSSL_RET_FAILURE;
+
+	switch (_rsslGetRealBatchLevel())
+	{
+#ifdef RSSL_REAL_BATCH_SIMD
+		case RWF_REAL_BATCH_AVX2:
+			_rsslDoubleToRealBatchAVX2(oReals, iValues, count, iHint);
+			break;
+		case RWF_REAL_BATCH_SSE4:
+			_rsslDoubleToRealBatchSSE4(oReals, iValues, count, iHint);
+			break;
+#endif
+		default:
+			_rsslDoubleToRealBatchScalar(oReals, iValues, count, iHint);
+			break;
+	}
+	return RSSL_RET_SUCCESS;
+}
+
 RSSL_API RsslRet rsslNumericStringToDouble(RsslDouble * oValue, RsslBuffer * iNumericString)
 {
 	RsslRet		ret;
@@ -13,6 +13,7 @@
 #include "rtr/intDataTypes.h"
 #include "rtr/custmem.h"
 #include "rtr/rsslDataUtils.h"
+#include "rtr/rsslFieldList.h"
 
 
 #ifdef __cplusplus
@@ -52,6 +53,38 @@ RTR_C_ALWAYS_INLINE char * _rsslDecodeBuffer15(RsslBuffer * buffer, char * posit
 	return position;
 }
 
+/* Field list index hash slots hold the field identifier in the upper half and the position + 1 of its entry
+ * in the lower half, so probing does not need to look at the entries. */
+#define _rsslFieldListIndexHash(FID, SHIFT) (((RsslUInt32)(RsslUInt16)(FID) * 0x9E3779B1U) >> (SHIFT))
+
+/* The last entry of an indexed field list with the field identifier, or NULL if it has none */
+RTR_C_ALWAYS_INLINE const RsslFieldListIndexEntry *_rsslFieldListIndexFind(const RsslFieldListIndex *pIndex, RsslFieldId fieldId)
+{
+	if (pIndex->_hashTable)
+	{
+		RsslUInt32 key = (RsslUInt32)(RsslUInt16)fieldId << 16;
+		RsslUInt32 slot = _rsslFieldListIndexHash(fieldId, pIndex->_hashShift);
+
+		for (; pIndex->_hashTable[slot] != 0; slot = (slot + 1) & pIndex->_hashMask)
+		{
+			if ((pIndex->_hashTable[slot] & 0xFFFF0000U) == key)
+				return &pIndex->entries[(pIndex->_hashTable[slot] & 0xFFFF) - 1];
+		}
+	}
+	else
+	{
+		RsslUInt32 i;
+
+		for (i = pIndex->entryCount; i > 0; --i)
+		{
+			if (pIndex->entries[i - 1].fieldId == fieldId)
+				return &pIndex->entries[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
 /* Writes a string representing flags into the RsslBuffer. If successful, adjusts buffer length to 
  * that of the written string.
  * Returns RSSL_RET_SUCCESS if successful, RSSL_RET_BUFFER_TOO_SMALL if out of space. */
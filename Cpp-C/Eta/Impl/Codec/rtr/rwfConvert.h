@@ -81,6 +81,78 @@ extern char * rwfDateTimetos(	char *str,
 								RsslDateTime *iDTime );
 
 
+/* When set (the default), the string to RsslReal, date and time parsers first try a fast path
+ * for the common formats and only use the general parsing for anything else.
+ * Clear it to always use the general parsing; used to test that both give the same results. */
+extern RsslBool rwfFastStringParsing;
+
+#ifdef RTR_LITTLE_ENDIAN
+/* Returns the number of leading digits (0 to 8) in eight characters loaded little-endian.
+ * The high bit of each byte is set when it is not '0' to '9'; carries and borrows only
+ * move toward later characters, so the first non-digit is always flagged correctly. */
+RTR_C_ALWAYS_INLINE RsslUInt32 _rwfSwarDigitCount(RsslUInt64 chunk)
+{
+	RsslUInt64 nonDigit = (chunk | (chunk + RTR_ULL(0x4646464646464646)) | (chunk - RTR_ULL(0x3030303030303030)))
+			& RTR_ULL(0x8080808080808080);
+
+	if (nonDigit == 0)
+		return 8;
+
+	/* Turn the lowest flagged byte into its index */
+	return (RsslUInt32)((((nonDigit & (0 - nonDigit)) >> 7) * RTR_ULL(0x0001020304050607)) >> 56);
+}
+
+/* Returns the value of the first count (1 to 8) digits of eight characters loaded little-endian. */
+RTR_C_ALWAYS_INLINE RsslUInt64 _rwfSwarDigitValue(RsslUInt64 chunk, RsslUInt32 count)
+{
+	/* Move the digits to the top so the unused characters become leading zeros,
+	 * then combine pairs of digits, pairs of pairs and finally the two halves. */
+	chunk = (chunk - RTR_ULL(0x3030303030303030)) << (8 * (8 - count));
+	chunk = (chunk * 10 + (chunk >> 8)) & RTR_ULL(0x00FF00FF00FF00FF);
+	chunk = (chunk * 100 + (chunk >> 16)) & RTR_ULL(0x0000FFFF0000FFFF);
+	return (chunk * 10000 + (chunk >> 32)) & RTR_ULL(0x00000000FFFFFFFF);
+}
+#endif
+
+/* Parses the digits from strptr up to (not including) endptr, stopping at the first non-digit,
+ * and accumulates them into *oValue modulo 2^64. Returns a pointer to the first character not used. */
+RTR_C_ALWAYS_INLINE const char * _rwfParseDigits(const char *strptr, const char *endptr, RsslUInt64 *oValue)
+{
+	RsslUInt64 value = *oValue;
+
+#ifdef RTR_LITTLE_ENDIAN
+	static const RsslUInt64 scale[9] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+	while (endptr - strptr >= 8)
+	{
+		RsslUInt64 chunk;
+		RsslUInt32 count;
+
+		memcpy(&chunk, strptr, 8);
+		if ((count = _rwfSwarDigitCount(chunk)) == 0)
+			break;
+
+		value = value * scale[count] + _rwfSwarDigitValue(chunk, count);
+		strptr += count;
+
+		if (count < 8)
+		{
+			*oValue = value;
+			return strptr;
+		}
+	}
+#endif
+
+	while (strptr < endptr && _rtr_acisdigit(*strptr))
+	{
+		value = value * 10 + _rtr_actoint(*strptr);
+		strptr++;
+	}
+
+	*oValue = value;
+	return strptr;
+}
+
 /* These functions convert an ascii string to an RsslInt32 */
 RTR_C_INLINE RsslInt32 rwf_stoi(const char *strptr)
 {
@@ -106,9 +178,21 @@ RTR_C_INLINE RsslInt64 rwf_stoi64(const char *strptr)
 {
 	return (rtr_atoll((char*)strptr));
 }
+/* Same results as rtr_atoll_size(), parsing eight digits at a time. endptr points to the last character. */
 RTR_C_INLINE RsslInt64 rwf_stoi64_size(const char *strptr, const char *endptr)
 {
-	return (rtr_atoll_size((char*)strptr,(char*)endptr));
+	RsslUInt64 value = 0;
+	int isNeg = 0;
+
+	while (strptr <= endptr && *strptr == ' ')
+		strptr++;
+
+	if (strptr <= endptr && (*strptr == '-' || *strptr == '+'))
+		isNeg = (*strptr++ == '-');
+
+	_rwfParseDigits(strptr, endptr + 1, &value);
+
+	return (RsslInt64)(isNeg ? 0 - value : value);
 }
 
 /* These functions convert an ascii string to an RsslUInt64 */
@@ -116,9 +200,20 @@ RTR_C_INLINE RsslUInt64 rwf_stoui64(const char *strptr)
 {
 	return (rtr_atoull((char*)strptr));
 }
+/* Same results as rtr_atoull_size(), parsing eight digits at a time. endptr points to the last character. */
 RTR_C_INLINE RsslUInt64 rwf_stoui64_size(const char *strptr, const char *endptr)
 {
-	return (rtr_atoull_size((char*)strptr,(char*)endptr));
+	RsslUInt64 value = 0;
+
+	while (strptr <= endptr && *strptr == ' ')
+		strptr++;
+
+	if (strptr <= endptr && *strptr == '+')
+		strptr++;
+
+	_rwfParseDigits(strptr, endptr + 1, &value);
+
+	return value;
 }
 
 /* These functions convert an ascii string to an RsslReal */
@@ -140,6 +235,21 @@ extern RsslRet rwf_stodatetime_size(
 					const char *strptr,
 					const char *endptr );
 
+/* Instruction set used by rsslDoubleToRealBatch().
+ * The best level supported by the CPU is selected on first use. */
+typedef enum {
+	RWF_REAL_BATCH_SCALAR	= 0,
+	RWF_REAL_BATCH_SSE4		= 1,
+	RWF_REAL_BATCH_AVX2		= 2
+} rwfRealBatchLevel;
+
+/* Returns the best level supported by this build and CPU. */
+extern rwfRealBatchLevel rwfGetRealBatchMaxLevel();
+
+/* Sets the level used by the batch conversions, limited to the best supported
+ * level, and returns the level now in use. Used to test each kernel. */
+extern rwfRealBatchLevel rwfSetRealBatchLevel(rwfRealBatchLevel level);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -39,6 +39,8 @@ rtrInt64	MAX_INT64 = RTR_LL(0x7FFFFFFFFFFFFFFF);
 rtrInt64	MAX_INT64DIV10 = (RTR_LL(0x7FFFFFFFFFFFFFFF))/10;
 rtrUInt64	MAX_UINT64DIV10 = (RTR_ULL(0xFFFFFFFFFFFFFFFF))/10;
 
+RsslBool	rwfFastStringParsing = RSSL_TRUE;
+
 #define powerof( value, x, y ) \
 {\
 	int i; \
@@ -1120,6 +1122,69 @@ RsslRet rwf_storeal64( RsslReal *oReal64, const char *strptr )
 	return RSSL_RET_SUCCESS;
 }
 
+/* Handles the common forms "[-]digits" and "[-]digits.digits" with at most 19 digits and
+ * 14 decimal places, giving the same result as the general parsing below.
+ * endptr points past the last character. Returns RSSL_FALSE, leaving oReal64 untouched,
+ * for anything else. */
+static RsslBool _rwf_storeal64_fast( RsslReal *oReal64, const char *strptr, const char *endptr )
+{
+	RsslUInt64	value = 0;
+	const char	*digits;
+	RsslUInt32	intDigits, decDigits;
+	RsslUInt8	hint;
+	int			isNeg = 0;
+
+	while ((strptr < endptr) && (*strptr == ' '))
+		strptr++;
+
+	if ((strptr < endptr) && (*strptr == '-'))
+	{
+		isNeg = 1;
+		strptr++;
+	}
+
+	digits = strptr;
+	strptr = _rwfParseDigits(strptr, endptr, &value);
+	intDigits = (RsslUInt32)(strptr - digits);
+
+	if (intDigits == 0 || intDigits > 19)
+		return RSSL_FALSE;
+
+	if (strptr == endptr)
+	{
+		/* Up to 7 trailing zeros go in the exponent */
+		RsslUInt8 trailZeros = 0;
+
+		if (value != 0)
+		{
+			while (trailZeros < 7 && (value % 10) == 0)
+			{
+				value /= 10;
+				trailZeros++;
+			}
+		}
+		hint = RSSL_RH_EXPONENT0 + trailZeros;
+	}
+	else if (*strptr == '.')
+	{
+		digits = ++strptr;
+		strptr = _rwfParseDigits(strptr, endptr, &value);
+		decDigits = (RsslUInt32)(strptr - digits);
+
+		if (strptr != endptr || decDigits > 14 || intDigits + decDigits > 19)
+			return RSSL_FALSE;
+
+		hint = RSSL_RH_EXPONENT0 - (RsslUInt8)decDigits;
+	}
+	else
+		return RSSL_FALSE;
+
+	oReal64->isBlank = RSSL_FALSE;
+	oReal64->hint = hint;
+	oReal64->value = (RsslInt64)(isNeg ? 0 - value : value);
+	return RSSL_TRUE;
+}
+
 RsslRet rwf_storeal64_size( RsslReal *oReal64, const char *strptr, const char *endptr )
 {
 	RsslUInt64	value = 0,tempValue = 0;
@@ -1130,6 +1195,9 @@ RsslRet rwf_storeal64_size( RsslReal *oReal64, const char *strptr, const char *e
 	int			nextDigit;
 	int			plusZero = 0;
 
+	if (rwfFastStringParsing && _rwf_storeal64_fast(oReal64, strptr, endptr + 1))
+		return RSSL_RET_SUCCESS;
+
 	__rtr_removewhitespace_end(strptr,endptr);
 
 	if (strptr > endptr)
@@ -58,6 +58,29 @@ RTR_C_INLINE RsslInt64 getCurrentTimeMs(RsslInt64 ticksPerMsec)
 	return timeMs;
 }
 
+/* Gets the current time in microseconds. ticksPerMsec is used only on windows. */
+RTR_C_INLINE RsslInt64 getCurrentTimeUsec(RsslInt64 ticksPerMsec)
+{
+	RsslInt64 timeUsec;
+#ifdef WIN32
+	LARGE_INTEGER	queryTime;
+
+
+	QueryPerformanceCounter(&queryTime);
+	timeUsec = (RsslInt64)((double)queryTime.QuadPart * 1000 / ticksPerMsec);
+	return timeUsec;
+#else
+	struct timeval currentTime;
+
+	gettimeofday(&currentTime, NULL);
+
+	timeUsec = currentTime.tv_sec;
+	timeUsec *= 1000000;
+	timeUsec += currentTime.tv_usec;
+#endif
+	return timeUsec;
+}
+
 /* Estimates the encoded length of an RsslMsg.  */
 RTR_C_INLINE RsslUInt32 rsslGetEstimatedEncodedLength(RsslMsg *pRsslMsg)
 {
@@ -350,7 +350,8 @@ RSSL_VA_API RsslReactor *rsslCreateReactor(RsslCreateReactorOptions *pReactorOpt
 		_reactorMoveChannel(&pReactorImpl->channelPool, pNewChannel);
 	}
 
-	if ((pReactorImpl->pNotifier = rsslCreateNotifier(1024)) == NULL)
+	if ((pReactorImpl->pNotifier = rsslCreateNotifierEx(1024, 
+					pReactorOpts->useEpollNotification ? RSSL_NOTIFIER_TYPE_EPOLL : RSSL_NOTIFIER_TYPE_DEFAULT)) == NULL)
 	{
 		_reactorWorkerCleanupReactor(pReactorImpl);
 		rsslSetErrorInfo(pError, RSSL_EIC_FAILURE, RSSL_RET_FAILURE, __FILE__, __LINE__, "Failed to create reactor notifier.");
@@ -672,6 +673,8 @@ RSSL_VA_API RsslRet rsslReactorConnect(RsslReactor *pReactor, RsslReactorConnect
 	pReactorChannel->initializationTimeout = pOpts->initializationTimeout;
 	pReactorChannel->pWatchlist = pWatchlist;
 	pReactorChannel->readRet = 0;
+	pReactorChannel->busyPollUsec = pOpts->busyPollUsec;
+	pReactorChannel->coalesceWriteUsec = pOpts->coalesceWriteUsec;
 
 	/* Set reconnection info here, this should be zeroed out provider bound connections */
 	pReactorChannel->reconnectAttemptLimit = pOpts->reconnectAttemptLimit;
@@ -854,6 +857,8 @@ RSSL_VA_API RsslRet rsslReactorAccept(RsslReactor *pReactor, RsslServer *pServer
 	pReactorChannel->reactorChannel.pRsslServer = pServer;
 	pReactorChannel->reactorChannel.userSpecPtr = pOpts->rsslAcceptOptions.userSpecPtr;
 	pReactorChannel->initializationTimeout = pOpts->initializationTimeout;
+	pReactorChannel->busyPollUsec = 0;
+	pReactorChannel->coalesceWriteUsec = pOpts->coalesceWriteUsec;
 
 	if ((pReactorChannel->pTunnelManager = tunnelManagerOpen(pReactor, (RsslReactorChannel*)pReactorChannel, pError)) == NULL)
 		return (reactorUnlockInterface(pReactorImpl), RSSL_RET_FAILURE);
@@ -943,8 +948,9 @@ RSSL_VA_API RsslRet rsslReactorDispatch(RsslReactor *pReactor, RsslReactorDispat
 
 				/* A channel has something to read if either:
 				 * - The last return from rsslRead() was greater than zero, indicating there were still bytes in RSSL's queue
-				 * - The file descriptor is set because there is data from the socket */
-				if (pReactorChannel->readRet > 0 || isFdReadable)
+				 * - The file descriptor is set because there is data from the socket
+				 * A busy polling channel is always read; rsslRead() itself waits for data. */
+				if (pReactorChannel->readRet > 0 || isFdReadable || pReactorChannel->busyPollUsec)
 				{
 					if ((ret = _reactorDispatchFromChannel(pReactorImpl, pReactorChannel, pError)) < RSSL_RET_SUCCESS)
 					{
@@ -1082,8 +1088,9 @@ RSSL_VA_API RsslRet rsslReactorDispatch(RsslReactor *pReactor, RsslReactorDispat
 			channelsToCheck = 1;
 			/* A channel has something to read if either:
 			 * - The last return from rsslRead() was greater than zero, indicating there were still bytes in RSSL's queue
-			 * - The file descriptor is set because there is data from the socket */
-			if (pReactorChannel->readRet > 0 || rsslNotifierEventIsReadable(pReactorChannel->pNotifierEvent))
+			 * - The file descriptor is set because there is data from the socket
+			 * A busy polling channel is always read; rsslRead() itself waits for data. */
+			if (pReactorChannel->readRet > 0 || rsslNotifierEventIsReadable(pReactorChannel->pNotifierEvent) || pReactorChannel->busyPollUsec)
 			{
 				while (maxMsgs > 0 && channelsToCheck > 0)
 				{
@@ -3057,6 +3064,15 @@ static RsslRet _reactorDispatchFromChannel(RsslReactorImpl *pReactorImpl, RsslRe
 				/* Clear descriptor so that we will ignore this channel until the next notification call */
 				rsslNotifierEventClearNotifiedFlags(pReactorChannel->pNotifierEvent);
 				pReactorChannel->readRet = 0;
+
+				/* A busy polling channel is never left unread, so check its ping timeout here. */
+				if (pReactorChannel->busyPollUsec && 
+						(pReactorImpl->lastRecordedTimeMs - pReactorChannel->lastPingReadMs) > pChannel->pingTimeout * 1000)
+				{
+					rsslSetErrorInfo(pError, RSSL_EIC_FAILURE, RSSL_RET_FAILURE, __FILE__, __LINE__, "Channel ping timeout expired.");
+					if (_reactorHandleChannelDown(pReactorImpl, pReactorChannel, pError) != RSSL_RET_SUCCESS)
+						return RSSL_RET_FAILURE;
+				}
 				return RSSL_RET_SUCCESS;
 			case RSSL_RET_READ_FD_CHANGE:
 				{
@@ -26,6 +26,10 @@ static const int defaultSelectTimeoutMs = 5000;
  * that we don't do too much unnecessary pinging) */
 static const float pingIntervalFactor = 1.0f/3.0f;
 
+/* Time in microseconds before retrying the flush of a shared memory channel whose ring was full.  Its
+ * eventfd is always writable, so waiting for write notification would only spin. */
+static const RsslInt64 shmemFlushRetryUsec = 100;
+
 /* Handles a newly connected channel and starts initializing it */
 static RsslRet _reactorWorkerProcessNewChannel(RsslReactorImpl *pReactorImpl, RsslReactorChannelImpl *pReactorChannel);
 
@@ -82,7 +86,8 @@ RsslRet _reactorWorkerStart(RsslReactorImpl *pReactorImpl, RsslCreateReactorOpti
 	rsslInitQueue(&pReactorImpl->reactorWorker.inactiveChannels);
 	rsslInitQueue(&pReactorImpl->reactorWorker.reconnectingChannels);
 
-	pReactorImpl->reactorWorker.pNotifier = rsslCreateNotifier(1024);
+	pReactorImpl->reactorWorker.pNotifier = rsslCreateNotifierEx(1024, 
+			pReactorOptions->useEpollNotification ? RSSL_NOTIFIER_TYPE_EPOLL : RSSL_NOTIFIER_TYPE_DEFAULT);
 	if (pReactorImpl->reactorWorker.pNotifier == NULL)
 	{
 		rsslSetErrorInfo(pError, RSSL_EIC_FAILURE, RSSL_RET_FAILURE, __FILE__, __LINE__, "Failed to initialize notifier.");
@@ -372,7 +377,10 @@ RSSL_THREAD_DECLARE(runReactorWorker, pArg)
 		RsslReactorChannelImpl *pReactorChannel;
 		RsslQueueLink *pLink;
 
-		ret = rsslNotifierWait(pReactorWorker->pNotifier, pReactorWorker->sleepTimeMs * 1000);
+		if (pReactorWorker->coalesceSleepTimeUsec && pReactorWorker->coalesceSleepTimeUsec < pReactorWorker->sleepTimeMs * 1000)
+			ret = rsslNotifierWait(pReactorWorker->pNotifier, pReactorWorker->coalesceSleepTimeUsec);
+		else
+			ret = rsslNotifierWait(pReactorWorker->pNotifier, pReactorWorker->sleepTimeMs * 1000);
 
 		pReactorWorker->lastRecordedTimeMs = getCurrentTimeMs(pReactorImpl->ticksPerMsec);
 
@@ -536,7 +544,13 @@ RSSL_THREAD_DECLARE(runReactorWorker, pArg)
 									{
 										case RSSL_RCIMPL_FET_START_FLUSH:
 											pReactorChannel = (RsslReactorChannelImpl*)pFlushEvent->pReactorChannel;
-											if (pReactorChannel->reactorChannel.pRsslChannel != NULL && pReactorChannel->reactorChannel.pRsslChannel->socketId != REACTOR_INVALID_SOCKET)
+											if (pReactorChannel->coalesceWriteUsec)
+											{
+												/* Hold the flush so more messages can be written with it; the timeout check below starts it. */
+												if (pReactorChannel->coalesceFlushTimeUsec == 0)
+													pReactorChannel->coalesceFlushTimeUsec = getCurrentTimeUsec(pReactorImpl->ticksPerMsec) + pReactorChannel->coalesceWriteUsec;
+											}
+											else if (pReactorChannel->reactorChannel.pRsslChannel != NULL && pReactorChannel->reactorChannel.pRsslChannel->socketId != REACTOR_INVALID_SOCKET)
 											{
 												if (rsslNotifierRegisterWrite(pReactorWorker->pNotifier, pReactorChannel->pWorkerNotifierEvent) < 0)
 												{
@@ -658,6 +672,34 @@ RSSL_THREAD_DECLARE(runReactorWorker, pArg)
 
 							case RSSL_RET_SUCCESS:
 								{
+									if (pReactorChannel->busyPollUsec)
+									{
+										int busyPollUsec = (int)pReactorChannel->busyPollUsec;
+
+										if (rsslIoctl(pReactorChannel->reactorChannel.pRsslChannel, RSSL_BUSY_POLL_USEC, &busyPollUsec, 
+													&pReactorChannel->channelWorkerCerr.rsslError) != RSSL_RET_SUCCESS)
+										{
+											rsslSetErrorInfoLocation(&pReactorChannel->channelWorkerCerr, __FILE__, __LINE__);
+											if (_reactorWorkerHandleChannelFailure(pReactorImpl, pReactorChannel, &pReactorChannel->channelWorkerCerr) != RSSL_RET_SUCCESS)
+												return (_reactorWorkerShutdown(pReactorImpl, &pReactorWorker->workerCerr), RSSL_THREAD_RETURN());
+											break;
+										}
+									}
+
+									if (pReactorChannel->coalesceWriteUsec)
+									{
+										int coalesceWriteUsec = (int)pReactorChannel->coalesceWriteUsec;
+
+										if (rsslIoctl(pReactorChannel->reactorChannel.pRsslChannel, RSSL_COALESCE_WRITE_USEC, &coalesceWriteUsec, 
+													&pReactorChannel->channelWorkerCerr.rsslError) != RSSL_RET_SUCCESS)
+										{
+											rsslSetErrorInfoLocation(&pReactorChannel->channelWorkerCerr, __FILE__, __LINE__);
+											if (_reactorWorkerHandleChannelFailure(pReactorImpl, pReactorChannel, &pReactorChannel->channelWorkerCerr) != RSSL_RET_SUCCESS)
+												return (_reactorWorkerShutdown(pReactorImpl, &pReactorWorker->workerCerr), RSSL_THREAD_RETURN());
+											break;
+										}
+									}
+
 									if (_reactorWorkerProcessChannelUp(pReactorImpl, pReactorChannel) != RSSL_RET_SUCCESS)
 										return (_reactorWorkerShutdown(pReactorImpl, &pReactorWorker->workerCerr), RSSL_THREAD_RETURN());
 									/* Channel is now active. Clear descriptor so we don't think we need to flush right away */
@@ -708,6 +750,35 @@ RSSL_THREAD_DECLARE(runReactorWorker, pArg)
 								}
 								_reactorWorkerSendFlushComplete(pReactorImpl, pReactorChannel);
 							}
+							else if (pReactorChannel->reactorChannel.pRsslChannel->connectionType == RSSL_CONN_TYPE_BIDIR_SHMEM)
+							{
+								/* Retry once the peer has had time to read; the timeout check below starts it. */
+								if (rsslNotifierUnregisterWrite(pReactorWorker->pNotifier, pReactorChannel->pWorkerNotifierEvent) < 0)
+								{
+									rsslSetErrorInfo(&pReactorWorker->workerCerr, RSSL_EIC_FAILURE, RSSL_RET_FAILURE, __FILE__, __LINE__, 
+											"Failed to unregister write notification for flushing channel.");
+									return (_reactorWorkerShutdown(pReactorImpl, &pReactorWorker->workerCerr), RSSL_THREAD_RETURN());
+								}
+								pReactorChannel->coalesceFlushTimeUsec = getCurrentTimeUsec(pReactorImpl->ticksPerMsec) + shmemFlushRetryUsec;
+							}
+							else if (pReactorChannel->coalesceWriteUsec)
+							{
+								RsslChannelInfo channelInfo;
+
+								/* rsslFlush() keeps holding the data until the transport's coalescing time has passed;
+								 * wait for that rather than for the socket, which is writable all along. */
+								if (rsslGetChannelInfo(pReactorChannel->reactorChannel.pRsslChannel, &channelInfo, &pReactorChannel->channelWorkerCerr.rsslError) == RSSL_RET_SUCCESS
+										&& channelInfo.coalesceFlushUsec)
+								{
+									if (rsslNotifierUnregisterWrite(pReactorWorker->pNotifier, pReactorChannel->pWorkerNotifierEvent) < 0)
+									{
+										rsslSetErrorInfo(&pReactorWorker->workerCerr, RSSL_EIC_FAILURE, RSSL_RET_FAILURE, __FILE__, __LINE__, 
+												"Failed to unregister write notification for flushing channel.");
+										return (_reactorWorkerShutdown(pReactorImpl, &pReactorWorker->workerCerr), RSSL_THREAD_RETURN());
+									}
+									pReactorChannel->coalesceFlushTimeUsec = getCurrentTimeUsec(pReactorImpl->ticksPerMsec) + channelInfo.coalesceFlushUsec;
+								}
+							}
 						}
 					}
 					
@@ -745,6 +816,7 @@ RSSL_THREAD_DECLARE(runReactorWorker, pArg)
 		/* Ping/initialization/recovery timeout check */
 
 		pReactorWorker->sleepTimeMs = defaultSelectTimeoutMs;
+		pReactorWorker->coalesceSleepTimeUsec = 0;
 
 		/* Check whether the initialization time period has passed. */
 		RSSL_QUEUE_FOR_EACH_LINK(&pReactorWorker->initializingChannels, pLink)
@@ -801,6 +873,27 @@ RSSL_THREAD_DECLARE(runReactorWorker, pArg)
 				else
 					_reactorWorkerCalculateNextTimeout(pReactorImpl, (RsslUInt32)(pReactorChannel->nextExpireTime - pReactorWorker->lastRecordedTimeMs));
 			}
+
+			/* Start any held flush whose coalescing time has run out. */
+			if (pReactorChannel->coalesceFlushTimeUsec)
+			{
+				RsslInt64 currentTimeUsec = getCurrentTimeUsec(pReactorImpl->ticksPerMsec);
+
+				if (pReactorChannel->coalesceFlushTimeUsec <= currentTimeUsec)
+				{
+					pReactorChannel->coalesceFlushTimeUsec = 0;
+					if (pReactorChannel->reactorChannel.pRsslChannel->socketId != REACTOR_INVALID_SOCKET &&
+							rsslNotifierRegisterWrite(pReactorWorker->pNotifier, pReactorChannel->pWorkerNotifierEvent) < 0)
+					{
+						rsslSetErrorInfo(&pReactorWorker->workerCerr, RSSL_EIC_FAILURE, RSSL_RET_FAILURE, __FILE__, __LINE__, 
+								"Failed to register write notification for flushing channel.");
+						return (_reactorWorkerShutdown(pReactorImpl, &pReactorWorker->workerCerr), RSSL_THREAD_RETURN());
+					}
+				}
+				else if (pReactorWorker->coalesceSleepTimeUsec == 0 
+						|| pReactorChannel->coalesceFlushTimeUsec - currentTimeUsec < pReactorWorker->coalesceSleepTimeUsec)
+					pReactorWorker->coalesceSleepTimeUsec = (RsslUInt32)(pReactorChannel->coalesceFlushTimeUsec - currentTimeUsec);
+			}
 		}
 
 		RSSL_QUEUE_FOR_EACH_LINK(&pReactorWorker->reconnectingChannels, pLink)
@@ -62,6 +62,8 @@ typedef struct
 	RsslInt64 lastPingReadMs;
 	RsslNotifierEvent *pNotifierEvent;
 	RsslRet readRet;				/* Last return code from rsslRead on this channel. Helps determine whether data can still be read from this channel. */
+	RsslUInt32 busyPollUsec;		/* Busy poll time for reads, see RsslReactorConnectOptions. The channel is read without waiting for notification when set. */
+	RsslUInt32 coalesceWriteUsec;	/* Time submitted messages may be held before flushing, see RsslReactorConnectOptions. */
 	RsslRet writeRet;				/* Last return from rsslWrite() for this channel. Helps determine whether we should request a flush. */
 	RsslBool requestedFlush;		/* Indicates whether flushing is signaled for this channel */
 	RsslWatchlist *pWatchlist;
@@ -85,6 +87,7 @@ typedef struct
 	RsslErrorInfo channelWorkerCerr;
 	RsslInt64 lastRequestedExpireTime;
 	RsslInt64 nextExpireTime;
+	RsslInt64 coalesceFlushTimeUsec;	/* When coalescing, or retrying a full shared memory channel, time at which a requested flush starts; 0 if none is waiting. */
 	RsslNotifierEvent *pWorkerNotifierEvent;
 
 	/* Reconnection logic */
@@ -190,6 +193,7 @@ RTR_C_INLINE RsslRet _rsslChannelFreeConnectionList(RsslReactorChannelImpl *pRea
 RTR_C_INLINE void rsslResetReactorChannelState(RsslReactorImpl *pReactorImpl, RsslReactorChannelImpl *pReactorChannel)
 {
 	pReactorChannel->requestedFlush = 0;
+	pReactorChannel->coalesceFlushTimeUsec = 0;
 	pReactorChannel->channelSetupState = RSSL_RC_CHST_INIT;
 	pReactorChannel->lastPingReadMs = 0;
 	pReactorChannel->readRet = 0;
@@ -258,6 +262,7 @@ typedef struct
 	RsslThreadId thread;
 	RsslReactorEventQueue workerQueue;
 	RsslUInt32 sleepTimeMs; /* Time to sleep when not flushing; should be equivalent to 1/3 of smallest ping timeout. */
+	RsslUInt32 coalesceSleepTimeUsec; /* Time until the next held flush of a coalescing channel starts; 0 if none is waiting. */
 
 	RsslErrorInfo workerCerr;
 	RsslReactorEventQueueGroup activeEventQueueGroup;
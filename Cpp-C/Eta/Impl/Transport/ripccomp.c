@@ -8,6 +8,7 @@
 
 
 #include <stdio.h>
+#include <string.h>
 #include "rtr/rsslAlloc.h"
 #include "rtr/rsslErrors.h"
 #include "rtr/rsslSocketTransportImpl.h"
@@ -271,4 +272,413 @@ int ripcInitLz4Comp()
 	return(ipcSetCompFunc(RSSL_COMP_LZ4,&funcs));
 }
 
+//
+//	Zstandard compression routines start here
+//
+//	libzstd is not shipped with RSSL, so it is loaded at runtime the same
+//	way as the OpenSSL libraries.  Only the stable zstd API (plus the
+//	magicless frame format) is used, so the declarations are kept here
+//	instead of depending on zstd.h.
+//
+#if defined(_WIN32)
+#define RIPC_ZSTD_LIBNAME					"libzstd.dll"
+#define RIPC_ZSTD_DLOPEN(FILENAME)			LoadLibrary(FILENAME)
+#define RIPC_ZSTD_DLSYM(MODULE,FUNCNAME)	GetProcAddress((MODULE), (FUNCNAME))
+#define RIPC_ZSTD_DLCLOSE(HANDLE)			FreeLibrary(HANDLE)
+static HMODULE zstdHandle = 0;
+#else
+#include <dlfcn.h>
+#define RIPC_ZSTD_LIBNAME					"libzstd.so.1"
+#define RIPC_ZSTD_DLOPEN(FILENAME)			dlopen(FILENAME, RTLD_NOW | RTLD_LOCAL)
+#define RIPC_ZSTD_DLSYM(MODULE,FUNCNAME)	dlsym((MODULE), (FUNCNAME))
+#define RIPC_ZSTD_DLCLOSE(HANDLE)			dlclose(HANDLE)
+static void *zstdHandle = 0;
+#endif
+
+typedef struct {
+	const void	*src;
+	size_t		size;
+	size_t		pos;
+} zstdInBuffer;
+
+typedef struct {
+	void		*dst;
+	size_t		size;
+	size_t		pos;
+} zstdOutBuffer;
+
+/* parameter and directive values from zstd.h; only ones from the stable API, whose values do not change */
+#define ZSTD_C_COMPRESSIONLEVEL		100
+#define ZSTD_C_WINDOWLOG			101
+#define ZSTD_C_CONTENTSIZEFLAG		200
+#define ZSTD_C_DICTIDFLAG			202
+#define ZSTD_E_FLUSH				1
+#define ZSTD_E_END					2
+
+/* The advanced API used here (ZSTD_compressStream2, ZSTD_CCtx_setParameter, ZSTD_CCtx_refCDict, ...)
+ * became stable in zstd 1.4.0 */
+#define RIPC_ZSTD_MIN_VERSION		10400
+
+/* Streams without a dictionary keep a 64k history window, similar to zlib */
+#define RIPC_ZSTD_WINDOWLOG			16
+
+static struct {
+	void*		(*createCCtx)(void);
+	size_t		(*freeCCtx)(void*);
+	void*		(*createDCtx)(void);
+	size_t		(*freeDCtx)(void*);
+	size_t		(*cctxSetParameter)(void*, int, int);
+	size_t		(*compressStream2)(void*, zstdOutBuffer*, zstdInBuffer*, int);
+	size_t		(*decompressStream)(void*, zstdOutBuffer*, zstdInBuffer*);
+	void*		(*createCDict)(const void*, size_t, int);
+	size_t		(*freeCDict)(void*);
+	void*		(*createDDict)(const void*, size_t);
+	size_t		(*freeDDict)(void*);
+	size_t		(*cctxRefCDict)(void*, const void*);
+	size_t		(*dctxRefDDict)(void*, const void*);
+	unsigned	(*getDictIDFromDict)(const void*, size_t);
+	int			(*maxCLevel)(void);
+	unsigned	(*isError)(size_t);
+	const char*	(*getErrorName)(size_t);
+	unsigned	(*versionNumber)(void);
+} zstdFuncs;
+
+typedef struct {
+	void		*ctx;			/* ZSTD_CCtx or ZSTD_DCtx */
+	int			endOp;			/* ZSTD_E_FLUSH for one long frame, ZSTD_E_END for a frame per message */
+} zstdStream;
+
+static void *zstdCompInit(RsslInt32 compressionLevel, RsslError *error)
+{
+	size_t err;
+	zstdStream *zs = (zstdStream*)_rsslMalloc(sizeof(zstdStream));
+
+	if (zs == 0)
+		return 0;
+
+	if (compressionLevel < 0 || compressionLevel > (*zstdFuncs.maxCLevel)())
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1004 Invalid zstd compression level %d.  Level must be between 0 and %d.\n",
+			__FILE__, __LINE__, compressionLevel, (*zstdFuncs.maxCLevel)());
+
+		_rsslFree(zs);
+		return 0;
+	}
+
+	zs->endOp = ZSTD_E_FLUSH;
+	if ((zs->ctx = (*zstdFuncs.createCCtx)()) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1001 ZSTD_createCCtx() failed.\n", __FILE__, __LINE__);
+		_rsslFree(zs);
+		return 0;
+	}
+
+	/* level 0 leaves zstd at its own default */
+	err = (*zstdFuncs.cctxSetParameter)(zs->ctx, ZSTD_C_COMPRESSIONLEVEL, compressionLevel);
+	if (!(*zstdFuncs.isError)(err))
+		err = (*zstdFuncs.cctxSetParameter)(zs->ctx, ZSTD_C_WINDOWLOG, RIPC_ZSTD_WINDOWLOG);
+	if (!(*zstdFuncs.isError)(err))
+		err = (*zstdFuncs.cctxSetParameter)(zs->ctx, ZSTD_C_CONTENTSIZEFLAG, 0);
+	if ((*zstdFuncs.isError)(err))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1002 ZSTD_CCtx_setParameter() failed. Zstd error: %s\n",
+			__FILE__, __LINE__, (*zstdFuncs.getErrorName)(err));
+		(*zstdFuncs.freeCCtx)(zs->ctx);
+		_rsslFree(zs);
+		return 0;
+	}
+
+	if (rtrUnlikely(compressionDebug)) printf("zstd using compression level=%d\n", compressionLevel);
+	return zs;
+}
+
+static void *zstdDecompInit(RsslError *error)
+{
+	zstdStream *zs = (zstdStream*)_rsslMalloc(sizeof(zstdStream));
+
+	if (zs == 0)
+		return 0;
+
+	zs->endOp = ZSTD_E_FLUSH;
+	if ((zs->ctx = (*zstdFuncs.createDCtx)()) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1001 ZSTD_createDCtx() failed.\n", __FILE__, __LINE__);
+		_rsslFree(zs);
+		return 0;
+	}
+	return zs;
+}
+
+static void zstdCompEnd(void *zstream)
+{
+	zstdStream *zs = (zstdStream*)zstream;
+	if (zs)
+	{
+		(*zstdFuncs.freeCCtx)(zs->ctx);
+		_rsslFree(zs);
+	}
+}
+
+static void zstdDecompEnd(void *zstream)
+{
+	zstdStream *zs = (zstdStream*)zstream;
+	if (zs)
+	{
+		(*zstdFuncs.freeDCtx)(zs->ctx);
+		_rsslFree(zs);
+	}
+}
+
+static RsslRet zstdCompress(void *zstream, ripcCompBuffer *buf, RsslError *error)
+{
+	size_t remaining;
+	zstdStream *zs = (zstdStream*)zstream;
+	zstdInBuffer in;
+	zstdOutBuffer out;
+
+	in.src = buf->next_in;
+	in.size = buf->avail_in;
+	in.pos = 0;
+	out.dst = buf->next_out;
+	out.size = buf->avail_out;
+	out.pos = 0;
+
+	/* Like deflate(Z_SYNC_FLUSH), this stops when everything is flushed or the output
+	 * is full; in the latter case the caller calls again with a new buffer to finish. */
+	remaining = (*zstdFuncs.compressStream2)(zs->ctx, &out, &in, zs->endOp);
+	if ((*zstdFuncs.isError)(remaining))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1002 ZSTD_compressStream2() failed. Zstd error: %s\n",
+				__FILE__, __LINE__, (*zstdFuncs.getErrorName)(remaining));
+		return -1;
+	}
+
+	buf->bytes_in_used = (int)in.pos;
+	buf->bytes_out_used = (int)out.pos;
+
+	buf->next_in = buf->next_in + in.pos;
+	buf->avail_in = buf->avail_in - (unsigned int)in.pos;
+	buf->next_out = buf->next_out + out.pos;
+	buf->avail_out = buf->avail_out - out.pos;
+	if (rtrUnlikely(compressionDebug)) printf("zstd Compressed %d inbytes to %d outbytes (avail_out = %lu)\n", buf->bytes_in_used, buf->bytes_out_used, buf->avail_out);
+
+	return 1;
+}
+
+static RsslRet zstdDecompress(void *zstream, ripcCompBuffer *buf, RsslError *error)
+{
+	size_t ret;
+	zstdStream *zs = (zstdStream*)zstream;
+	zstdInBuffer in;
+	zstdOutBuffer out;
+
+	in.src = buf->next_in;
+	in.size = buf->avail_in;
+	in.pos = 0;
+	out.dst = buf->next_out;
+	out.size = buf->avail_out;
+	out.pos = 0;
+
+	while (in.pos < in.size && out.pos < out.size)
+	{
+		ret = (*zstdFuncs.decompressStream)(zs->ctx, &out, &in);
+		if ((*zstdFuncs.isError)(ret))
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1002 ZSTD_decompressStream() failed. Zstd error: %s\n",
+					__FILE__, __LINE__, (*zstdFuncs.getErrorName)(ret));
+			return -1;
+		}
+	}
+
+	buf->bytes_in_used = (int)in.pos;
+	buf->bytes_out_used = (int)out.pos;
+
+	buf->next_in = buf->next_in + in.pos;
+	buf->avail_in = buf->avail_in - (unsigned int)in.pos;
+	buf->next_out = buf->next_out + out.pos;
+	buf->avail_out = buf->avail_out - out.pos;
+	if (rtrUnlikely(compressionDebug)) printf("zstd Decompressed %d inbytes to %d outbytes\n", buf->bytes_in_used, buf->bytes_out_used);
+
+	return 1;
+}
+
+ripcCompDict *ripcZstdCreateDict(char *data, RsslUInt32 length, RsslError *error)
+{
+	ripcCompDict *dict;
+
+	if (zstdHandle == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1004 A zstd compression dictionary was given but %s could not be loaded.\n",
+			__FILE__, __LINE__, RIPC_ZSTD_LIBNAME);
+		return 0;
+	}
+
+	if ((dict = (ripcCompDict*)_rsslMalloc(sizeof(ripcCompDict))) == 0 ||
+		(dict->data = (char*)_rsslMalloc(length)) == 0)
+	{
+		if (dict)
+			_rsslFree(dict);
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1001 Could not allocate memory for the zstd compression dictionary.\n",
+			__FILE__, __LINE__);
+		return 0;
+	}
+	memcpy(dict->data, data, length);
+	dict->length = length;
+	dict->level = 0;
+	dict->cdict = 0;
+	dict->ddict = 0;
+
+	/* Raw content dictionaries have no ID, and the ID is all the handshake can check */
+	dict->dictId = (*zstdFuncs.getDictIDFromDict)(data, length);
+	if (dict->dictId == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1004 The zstd compression dictionary has no dictionary ID.  Use a dictionary produced by 'zstd --train'.\n",
+			__FILE__, __LINE__);
+		ripcZstdFreeDict(dict);
+		return 0;
+	}
+
+	if ((dict->ddict = (*zstdFuncs.createDDict)(data, length)) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1002 ZSTD_createDDict() failed.\n", __FILE__, __LINE__);
+		ripcZstdFreeDict(dict);
+		return 0;
+	}
+
+	return dict;
+}
+
+RsslRet ripcZstdPrepareDict(ripcCompDict *dict, RsslInt32 compressionLevel, RsslError *error)
+{
+	if (dict->cdict)
+	{
+		if (dict->level == compressionLevel)
+			return RSSL_RET_SUCCESS;
+		(*zstdFuncs.freeCDict)(dict->cdict);
+	}
+
+	if ((dict->cdict = (*zstdFuncs.createCDict)(dict->data, dict->length, compressionLevel)) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1002 ZSTD_createCDict() failed for compression level %d.\n",
+			__FILE__, __LINE__, compressionLevel);
+		return RSSL_RET_FAILURE;
+	}
+	dict->level = compressionLevel;
+	return RSSL_RET_SUCCESS;
+}
+
+RsslRet ripcZstdUseDict(ripcCompDict *dict, void *compressInfo, void *decompressInfo, RsslError *error)
+{
+	size_t err = 0;
+	zstdStream *czs = (zstdStream*)compressInfo;
+	zstdStream *dzs = (zstdStream*)decompressInfo;
+
+	/* With a dictionary every message is a frame of its own, so the dictionary stays in
+	 * reach no matter how much data went before.  The frames leave out the content size
+	 * and dictionary ID, since the handshake already agreed on the dictionary. */
+	if (czs)
+	{
+		czs->endOp = ZSTD_E_END;
+		err = (*zstdFuncs.cctxRefCDict)(czs->ctx, dict->cdict);
+		if (!(*zstdFuncs.isError)(err))
+			err = (*zstdFuncs.cctxSetParameter)(czs->ctx, ZSTD_C_DICTIDFLAG, 0);
+	}
+	if (dzs && !(*zstdFuncs.isError)(err))
+	{
+		dzs->endOp = ZSTD_E_END;
+		err = (*zstdFuncs.dctxRefDDict)(dzs->ctx, dict->ddict);
+	}
+	if ((*zstdFuncs.isError)(err))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1002 Could not apply zstd compression dictionary. Zstd error: %s\n",
+			__FILE__, __LINE__, (*zstdFuncs.getErrorName)(err));
+		return RSSL_RET_FAILURE;
+	}
+	return RSSL_RET_SUCCESS;
+}
+
+void ripcZstdFreeDict(ripcCompDict *dict)
+{
+	if (dict)
+	{
+		if (dict->cdict)
+			(*zstdFuncs.freeCDict)(dict->cdict);
+		if (dict->ddict)
+			(*zstdFuncs.freeDDict)(dict->ddict);
+		if (dict->data)
+			_rsslFree(dict->data);
+		_rsslFree(dict);
+	}
+}
+
+RsslInt32 ripcInitZstdComp(char *libzstdName)
+{
+	ripcCompFuncs funcs;
+
+	if (zstdHandle == 0)
+	{
+		if ((zstdHandle = RIPC_ZSTD_DLOPEN(libzstdName ? libzstdName : RIPC_ZSTD_LIBNAME)) == 0)
+			return -1;
+
+		if ((zstdFuncs.versionNumber = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_versionNumber")) == 0 ||
+			(*zstdFuncs.versionNumber)() < RIPC_ZSTD_MIN_VERSION ||
+			(zstdFuncs.createCCtx = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_createCCtx")) == 0 ||
+			(zstdFuncs.freeCCtx = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_freeCCtx")) == 0 ||
+			(zstdFuncs.createDCtx = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_createDCtx")) == 0 ||
+			(zstdFuncs.freeDCtx = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_freeDCtx")) == 0 ||
+			(zstdFuncs.cctxSetParameter = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_CCtx_setParameter")) == 0 ||
+			(zstdFuncs.compressStream2 = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_compressStream2")) == 0 ||
+			(zstdFuncs.decompressStream = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_decompressStream")) == 0 ||
+			(zstdFuncs.createCDict = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_createCDict")) == 0 ||
+			(zstdFuncs.freeCDict = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_freeCDict")) == 0 ||
+			(zstdFuncs.createDDict = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_createDDict")) == 0 ||
+			(zstdFuncs.freeDDict = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_freeDDict")) == 0 ||
+			(zstdFuncs.cctxRefCDict = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_CCtx_refCDict")) == 0 ||
+			(zstdFuncs.dctxRefDDict = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_DCtx_refDDict")) == 0 ||
+			(zstdFuncs.getDictIDFromDict = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_getDictID_fromDict")) == 0 ||
+			(zstdFuncs.maxCLevel = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_maxCLevel")) == 0 ||
+			(zstdFuncs.isError = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_isError")) == 0 ||
+			(zstdFuncs.getErrorName = RIPC_ZSTD_DLSYM(zstdHandle, "ZSTD_getErrorName")) == 0)
+		{
+			/* older than the stable streaming API we need; leave zstd unregistered */
+			RIPC_ZSTD_DLCLOSE(zstdHandle);
+			zstdHandle = 0;
+			return -1;
+		}
+	}
+
+	funcs.compressInit = zstdCompInit;
+	funcs.decompressInit = zstdDecompInit;
+	funcs.compressEnd = zstdCompEnd;
+	funcs.decompressEnd = zstdDecompEnd;
+	funcs.compress = zstdCompress;
+	funcs.decompress = zstdDecompress;
+
+	return(ipcSetCompFunc(RSSL_COMP_ZSTD,&funcs));
+}
+
+void ripcUninitZstdComp()
+{
+	if (zstdHandle != 0)
+	{
+		RIPC_ZSTD_DLCLOSE(zstdHandle);
+		zstdHandle = 0;
+	}
+}
+
 #endif
@@ -0,0 +1,901 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#include "rtr/ripcplat.h"
+#include "rtr/ripcshmutils.h"
+
+#ifdef Linux
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+
+#include "rtr/ripcflip.h"
+#include "rtr/rsslErrors.h"
+
+/* The abstract socket name for a port; it disappears when the server closes. */
+static int ipcShmSocketAddr(char *serverName, struct sockaddr_un *addr, socklen_t *addrLen, RsslError *error)
+{
+	RsslInt32 portnum;
+	int len;
+
+	if ((portnum = ipcGetServByName(serverName)) == -1)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1004 ipcGetServByName() failed. Port name/number is incorrect. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+		return -1;
+	}
+
+	memset(addr, 0, sizeof(struct sockaddr_un));
+	addr->sun_family = AF_UNIX;
+	len = snprintf(addr->sun_path + 1, sizeof(addr->sun_path) - 1, "rssl_shmem.%u", (unsigned)net2host_u16((RsslUInt16)portnum));
+	*addrLen = (socklen_t)(offsetof(struct sockaddr_un, sun_path) + 1 + len);
+	return portnum;
+}
+
+/* Anyone on the host can bind or connect to an abstract socket name, so both
+ * sides only accept a peer running as the same user. */
+static int ipcShmCheckPeer(RsslSocket fd, RsslError *error)
+{
+	struct ucred	cred;
+	socklen_t		len = sizeof(cred);
+
+	if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Could not get the credentials of the shared memory peer. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+		return -1;
+	}
+
+	if (cred.uid != geteuid())
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Shared memory peer (pid %d) runs as user %u, not %u.\n",
+			__FILE__, __LINE__, (int)cred.pid, (unsigned)cred.uid, (unsigned)geteuid());
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Rounds a configured buffer size up to a supported ring size. */
+static RsslUInt32 ipcShmRingSize(RsslUInt32 requested)
+{
+	RsslUInt32 size = RIPC_SHM_MIN_RING_SIZE;
+
+	if (requested == 0)
+		return RIPC_SHM_DFLT_RING_SIZE;
+
+	while (size < requested && size < RIPC_SHM_MAX_RING_SIZE)
+		size <<= 1;
+
+	return size;
+}
+
+static int ipcShmCreateFd(size_t length)
+{
+	int fd;
+
+#ifdef __NR_memfd_create
+	fd = (int)syscall(__NR_memfd_create, "rssl_shmem", 1 /* MFD_CLOEXEC */);
+#else
+	char name[64];
+
+	snprintf(name, sizeof(name), "/rssl_shmem.%d.%p", (int)getpid(), (void*)&name);
+	if ((fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600)) >= 0)
+		shm_unlink(name);
+#endif
+
+	if (fd < 0)
+		return -1;
+
+	if (ftruncate(fd, (off_t)length) < 0)
+	{
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static void ipcShmFreeSession(ripcShmSession *sess)
+{
+	if (sess->seg)
+		munmap((void*)sess->seg, sess->segLength);
+	if (ripcValidSocket(sess->ctlFd))
+		close(sess->ctlFd);
+	if (ripcValidSocket(sess->inFd))
+		close(sess->inFd);
+	if (ripcValidSocket(sess->peerFd))
+		close(sess->peerFd);
+	free(sess);
+}
+
+static ripcShmSession *ipcShmNewSession()
+{
+	ripcShmSession *sess = (ripcShmSession*)malloc(sizeof(ripcShmSession));
+
+	if (sess == 0)
+		return 0;
+
+	memset(sess, 0, sizeof(ripcShmSession));
+	sess->ctlFd = RIPC_INVALID_SOCKET;
+	sess->inFd = RIPC_INVALID_SOCKET;
+	sess->peerFd = RIPC_INVALID_SOCKET;
+	return sess;
+}
+
+/* Points the session at its rings; direction is the ring this side reads. */
+static void ipcShmSetRings(ripcShmSession *sess, int direction)
+{
+	sess->in = &sess->seg->rings[direction];
+	sess->out = &sess->seg->rings[direction ^ 1];
+	sess->inData = (char*)sess->seg + sess->in->dataOffset;
+	sess->outData = (char*)sess->seg + sess->out->dataOffset;
+}
+
+/* Signals the eventfd of the side that reads ring. */
+RTR_C_INLINE void ipcShmRing(ripcShmRing *ring, RsslSocket fd)
+{
+	RsslUInt64 one = 1;
+
+	__atomic_add_fetch(&ring->bells, 1, __ATOMIC_SEQ_CST);
+	if (write(fd, &one, sizeof(one)) < 0)
+		return;
+}
+
+/* Consumes any signals on our eventfd, so the channel is not reported readable
+ * again for data that has already been read. */
+RTR_C_INLINE void ipcShmClearBells(ripcShmSession *sess)
+{
+	RsslUInt64 count;
+
+	if (sess->bellsSeen != __atomic_load_n(&sess->in->bells, __ATOMIC_ACQUIRE))
+	{
+		if (read(sess->inFd, &count, sizeof(count)) == sizeof(count))
+			sess->bellsSeen += (RsslUInt32)count;
+	}
+}
+
+/* Waits until our eventfd is signalled or the peer's socket closes. */
+static int ipcShmWait(ripcShmSession *sess)
+{
+	struct pollfd pollFds[2];
+
+	pollFds[0].fd = sess->inFd;
+	pollFds[0].events = POLLIN;
+	pollFds[1].fd = sess->ctlFd;
+	pollFds[1].events = POLLIN;
+
+	if (poll(pollFds, 2, -1) < 0 && errno != EINTR)
+		return -1;
+
+	if (pollFds[1].revents & (POLLIN | POLLHUP | POLLERR))
+		return -2;
+
+	return 0;
+}
+
+RsslInt32 ipcShmSrvrBind(rsslServerImpl *srvr, RsslError *error)
+{
+	RsslSocket			sock_fd;
+	struct sockaddr_un	addr;
+	socklen_t			addrLen;
+	RsslServerSocketChannel*	rsslServerSocketChannel = (RsslServerSocketChannel*)srvr->transportInfo;
+
+	if (ipcShmSocketAddr(rsslServerSocketChannel->serverName, &addr, &addrLen, error) == -1)
+		return -1;
+
+	sock_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (!ripcValidSocket(sock_fd))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Call to socket() failed System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		return -1;
+	}
+
+	if (bind(sock_fd, (struct sockaddr*)&addr, addrLen) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Unable to bind socket. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		sock_close(sock_fd);
+		return -1;
+	}
+
+	if (ipcSessSetMode(sock_fd, rsslServerSocketChannel->server_blocking, 0, error, __LINE__) < 0)
+	{
+		sock_close(sock_fd);
+		return -1;
+	}
+
+	if (listen(sock_fd, 1024) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Unable to listen on socket. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		sock_close(sock_fd);
+		return -1;
+	}
+
+	rsslServerSocketChannel->stream = sock_fd;
+
+	return 0;
+}
+
+/* Receives the segment and eventfds the client sent on the session's ctlFd and
+ * maps the segment.  Returns 1 once attached, 0 if they have not arrived yet
+ * and ctlFd is non-blocking, and -1 on failure; on failure whatever was
+ * received is left in the session for ipcShmShutdown to release. */
+static int ipcShmAttach(ripcShmSession *sess, RsslError *error)
+{
+	ripcShmHello	hello;
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr	*cmsg;
+	struct stat		st;
+	int				fds[3];
+	ssize_t			cc;
+	int				i;
+	union {
+		struct cmsghdr	align;
+		char			buf[CMSG_SPACE(sizeof(fds))];
+	} control;
+
+	iov.iov_base = &hello;
+	iov.iov_len = sizeof(hello);
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+
+	cc = recvmsg(sess->ctlFd, &msg, MSG_CMSG_CLOEXEC);
+
+	if (cc < 0 && (errno == _IPC_WOULD_BLOCK || errno == EINTR))
+		return 0;
+
+	cmsg = (cc > 0) ? CMSG_FIRSTHDR(&msg) : 0;
+
+	if (cc != sizeof(hello) || cmsg == 0 || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+		cmsg->cmsg_len != CMSG_LEN(sizeof(fds)))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Did not receive the shared memory segment from the client. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+		{
+			for (i = 0; i < (int)((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int)); i++)
+				close(((int*)CMSG_DATA(cmsg))[i]);
+		}
+		return -1;
+	}
+
+	memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+	sess->inFd = fds[1];
+	sess->peerFd = fds[2];
+
+	if (hello.magic != RIPC_SHM_MAGIC || hello.version != RIPC_SHM_VERSION || fstat(fds[0], &st) < 0 ||
+		(size_t)st.st_size < sizeof(ripcShmSegment))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Invalid shared memory segment from the client. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		close(fds[0]);
+		return -1;
+	}
+
+	sess->segLength = (size_t)st.st_size;
+	sess->seg = (ripcShmSegment*)mmap(0, sess->segLength, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+	close(fds[0]);
+
+	if (sess->seg == (ripcShmSegment*)MAP_FAILED)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 mmap() of the shared memory segment failed. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		sess->seg = 0;
+		return -1;
+	}
+
+	/* the client wrote the header before sending it; make sure it describes this segment */
+	for (i = 0; i < 2; i++)
+	{
+		ripcShmRing *ring = &sess->seg->rings[i];
+
+		if (sess->seg->magic != RIPC_SHM_MAGIC || ring->size == 0 || (ring->size & (ring->size - 1)) != 0 ||
+			ring->dataOffset < sizeof(ripcShmSegment) || ring->dataOffset + ring->size > sess->segLength)
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+				"<%s:%d> Error: 1002 Invalid shared memory segment header from the client.\n",
+				__FILE__, __LINE__);
+
+			munmap((void*)sess->seg, sess->segLength);
+			sess->seg = 0;
+			return -1;
+		}
+	}
+
+	ipcShmSetRings(sess, RIPC_SHM_CLIENT_TO_SERVER);
+	return 1;
+}
+
+RsslSocket ipcShmSrvrAccept(rsslServerImpl *srvr, void** userSpecPtr, RsslError *error)
+{
+	RsslSocket	    fdtemp;
+	ripcShmSession	*sess;
+	RsslServerSocketChannel	*rsslServerSocketChannel = (RsslServerSocketChannel*)srvr->transportInfo;
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslServerSocketChannel -- ipcShmSrvrAccept (before accept)\n");
+#endif
+	IPC_MUTEX_UNLOCK(rsslServerSocketChannel);
+
+	fdtemp = accept(rsslServerSocketChannel->stream, (struct sockaddr *)0, (socklen_t *)0);
+
+#ifdef MUTEX_DEBUG
+	printf("LOCK rsslServerSocketChannel -- ipcShmSrvrAccept (after accept)\n");
+#endif
+	IPC_MUTEX_LOCK(rsslServerSocketChannel);
+
+	if (rsslServerSocketChannel->stream == RIPC_INVALID_SOCKET)
+	{
+		if (ripcValidSocket(fdtemp))
+			sock_close(fdtemp);
+
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 accept() failed due to server shutting down. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		ipcCloseActiveSrvr(rsslServerSocketChannel);
+		return(0);
+	}
+
+	if (!ripcValidSocket(fdtemp))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		if ((errno == _IPC_WOULD_BLOCK) || (errno == EINTR))
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+				"<%s:%d> Error: 1002 accept() would block. System errno: (%d)\n",
+				__FILE__, __LINE__, errno);
+		else
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+				"<%s:%d> Error: 1002 accept() failed. System errno: (%d)\n",
+				__FILE__, __LINE__, errno);
+		return(0);
+	}
+
+	if (rtrUnlikely(getConndebug()))
+		printf("\nipcShmSrvrAccept: accept client "SOCKET_PRINT_TYPE"\n", fdtemp);
+
+	if ((ipcShmCheckPeer(fdtemp, error) < 0) ||
+		(ipcSessSetMode(fdtemp, rsslServerSocketChannel->session_blocking, 0, error, __LINE__) < 0))
+	{
+		sock_close(fdtemp);
+		return(0);
+	}
+
+	if ((sess = ipcShmNewSession()) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1001 Failed to allocate the shared memory session.\n",
+			__FILE__, __LINE__);
+
+		sock_close(fdtemp);
+		return(0);
+	}
+
+	/* The segment arrives on this socket; it is attached by ipcShmInitTrans
+	 * from rsslInitChannel(), which moves the channel to the eventfd. */
+	sess->ctlFd = fdtemp;
+	*userSpecPtr = sess;
+	return fdtemp;
+}
+
+RsslSocket ipcShmConnectSocket(RsslInt32 *portnum, void *opts, RsslInt32 flags, void** userSpecPtr, RsslError *error)
+{
+	RsslSocketChannel	*pRsslSocketChannel = (RsslSocketChannel*)opts;
+	ripcShmSession		*sess;
+	ripcShmSegment		*seg;
+	struct sockaddr_un	addr;
+	socklen_t			addrLen;
+	RsslUInt32			sizes[2];
+	ripcShmHello		hello;
+	struct msghdr		msg;
+	struct iovec		iov;
+	struct cmsghdr		*cmsg;
+	int					fds[3];
+	union {
+		struct cmsghdr	align;
+		char			buf[CMSG_SPACE(sizeof(fds))];
+	} control;
+
+	if ((*portnum = ipcShmSocketAddr(pRsslSocketChannel->serverName, &addr, &addrLen, error)) == -1)
+		return 0;
+
+	if ((sess = ipcShmNewSession()) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1001 Failed to allocate the shared memory session.\n",
+			__FILE__, __LINE__);
+		return 0;
+	}
+
+	sess->ctlFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (!ripcValidSocket(sess->ctlFd))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> ipcShmConnectSocket() Error: 1002 socket() failed. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		ipcShmFreeSession(sess);
+		return 0;
+	}
+
+	/* A local connect() completes immediately, so this is done even for non-blocking channels. */
+	if (connect(sess->ctlFd, (struct sockaddr*)&addr, addrLen) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 ipcShmConnectSocket() connect() failed. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		ipcShmFreeSession(sess);
+		return 0;
+	}
+
+	if (ipcShmCheckPeer(sess->ctlFd, error) < 0)
+	{
+		ipcShmFreeSession(sess);
+		return 0;
+	}
+
+	sizes[RIPC_SHM_CLIENT_TO_SERVER] = ipcShmRingSize(pRsslSocketChannel->sendBufSize);
+	sizes[RIPC_SHM_SERVER_TO_CLIENT] = ipcShmRingSize(pRsslSocketChannel->recvBufSize);
+	sess->segLength = sizeof(ripcShmSegment) + sizes[0] + sizes[1];
+
+	sess->inFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	sess->peerFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	fds[0] = ipcShmCreateFd(sess->segLength);
+
+	if (!ripcValidSocket(sess->inFd) || !ripcValidSocket(sess->peerFd) || fds[0] < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Could not create the shared memory segment. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		if (fds[0] >= 0)
+			close(fds[0]);
+		ipcShmFreeSession(sess);
+		return 0;
+	}
+
+	seg = (ripcShmSegment*)mmap(0, sess->segLength, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+	if (seg == (ripcShmSegment*)MAP_FAILED)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 mmap() of the shared memory segment failed. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		close(fds[0]);
+		ipcShmFreeSession(sess);
+		return 0;
+	}
+
+	/* ftruncate() zero filled the segment */
+	sess->seg = seg;
+	seg->magic = RIPC_SHM_MAGIC;
+	seg->version = RIPC_SHM_VERSION;
+	seg->rings[RIPC_SHM_CLIENT_TO_SERVER].size = sizes[RIPC_SHM_CLIENT_TO_SERVER];
+	seg->rings[RIPC_SHM_CLIENT_TO_SERVER].dataOffset = sizeof(ripcShmSegment);
+	seg->rings[RIPC_SHM_SERVER_TO_CLIENT].size = sizes[RIPC_SHM_SERVER_TO_CLIENT];
+	seg->rings[RIPC_SHM_SERVER_TO_CLIENT].dataOffset = sizeof(ripcShmSegment) + sizes[RIPC_SHM_CLIENT_TO_SERVER];
+	/* neither side has read yet, so the first write in each direction must signal */
+	seg->rings[RIPC_SHM_CLIENT_TO_SERVER].readerWaiting = 1;
+	seg->rings[RIPC_SHM_SERVER_TO_CLIENT].readerWaiting = 1;
+	ipcShmSetRings(sess, RIPC_SHM_SERVER_TO_CLIENT);
+
+	fds[1] = sess->peerFd;
+	fds[2] = sess->inFd;
+	hello.magic = RIPC_SHM_MAGIC;
+	hello.version = RIPC_SHM_VERSION;
+
+	iov.iov_base = &hello;
+	iov.iov_len = sizeof(hello);
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+	memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+	if (sendmsg(sess->ctlFd, &msg, MSG_NOSIGNAL) != sizeof(hello))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1002 Could not send the shared memory segment to the server. System errno: (%d)\n",
+			__FILE__, __LINE__, errno);
+
+		close(fds[0]);
+		ipcShmFreeSession(sess);
+		return 0;
+	}
+
+	close(fds[0]);
+
+	*userSpecPtr = sess;
+	return sess->inFd;
+}
+
+void *ipcShmNewConn(void *srvr, RsslSocket fd, int *initComplete, void* userSpecPtr, RsslError *error)
+{
+	*initComplete = 0;
+	return userSpecPtr;
+}
+
+void *ipcShmNewClientConn(RsslSocket fd, int *initComplete, void* userSpecPtr, RsslError* error)
+{
+	*initComplete = 1;
+	return userSpecPtr;
+}
+
+/* Attaches an accepted channel to the client's segment without waiting for it. */
+int ipcShmInitTrans(void *transport, ripcSessInProg *inPr, RsslError *error)
+{
+	ripcShmSession	*sess = (ripcShmSession*)transport;
+	int				cc;
+
+	if (sess->seg)
+		return(1);
+
+	if ((cc = ipcShmAttach(sess, error)) <= 0)
+		return(cc);
+
+	/* from now on the channel waits on its eventfd */
+	inPr->types = RIPC_INPROG_NEW_FD;
+	inPr->oldSocket = sess->ctlFd;
+	inPr->newSocket.stream = sess->inFd;
+	return(1);
+}
+
+int ipcShmShutdown(void *transport)
+{
+	ripcShmSession *sess = (ripcShmSession*)transport;
+
+	if (sess == 0)
+		return(1);
+
+	/* wake the peer so it reads the close instead of waiting for a ping timeout */
+	if (sess->seg)
+	{
+		__atomic_store_n(&sess->seg->closed, 1, __ATOMIC_SEQ_CST);
+		ipcShmRing(sess->out, sess->peerFd);
+	}
+
+	ipcShmFreeSession(sess);
+	return(1);
+}
+
+int ipcShmRead(void *transport, char *buf, int max_len, ripcRWFlags flags, RsslError *error)
+{
+	ripcShmSession	*sess = (ripcShmSession*)transport;
+	ripcShmRing		*ring = sess->in;
+	RsslUInt64		head = ring->head;
+	RsslUInt64		tail;
+	RsslUInt32		mask = ring->size - 1;
+	RsslUInt32		offset;
+	RsslUInt32		len;
+	int				totalBytes = 0;
+
+	error->text[0] = '\0';
+
+	while (totalBytes < max_len)
+	{
+		tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+		/* the peer can write anything to the segment; never read past what the ring holds */
+		if (rtrUnlikely(tail - head > ring->size))
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+				"<%s:%d> Error: 1002 Shared memory ring is corrupt, tail " RTR_LLU " is more than %u bytes past head " RTR_LLU ".\n",
+				__FILE__, __LINE__, tail, ring->size, head);
+			errno = EPROTO;
+			return(-1);
+		}
+
+		if (tail == head)
+		{
+			if (totalBytes && (!(flags & RIPC_RW_BLOCKING) || !(flags & RIPC_RW_WAITALL)))
+				break;
+
+			/* Clear the eventfd first, then announce we may sleep and look again, so
+			 * anything written after the first look rings the eventfd. */
+			ipcShmClearBells(sess);
+			__atomic_store_n(&ring->readerWaiting, 1, __ATOMIC_SEQ_CST);
+			tail = __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST);
+
+			if (tail == head)
+			{
+				if (__atomic_load_n(&sess->seg->closed, __ATOMIC_ACQUIRE))
+				{
+					errno = ECONNRESET;
+					return(totalBytes ? totalBytes : -2);
+				}
+
+				if (!(flags & RIPC_RW_BLOCKING))
+					return(totalBytes);
+
+				if (ipcShmWait(sess) == -2 && __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST) == head)
+				{
+					errno = ECONNRESET;
+					return(totalBytes ? totalBytes : -2);
+				}
+				continue;
+			}
+
+			/* data arrived; if the writer has not seen the flag yet, it does not need to ring */
+			__atomic_store_n(&ring->readerWaiting, 0, __ATOMIC_RELAXED);
+		}
+
+		len = (RsslUInt32)(tail - head);
+		if (len > (RsslUInt32)(max_len - totalBytes))
+			len = (RsslUInt32)(max_len - totalBytes);
+
+		offset = (RsslUInt32)head & mask;
+		if (offset + len <= ring->size)
+			memcpy(buf + totalBytes, sess->inData + offset, len);
+		else
+		{
+			memcpy(buf + totalBytes, sess->inData + offset, ring->size - offset);
+			memcpy(buf + totalBytes + (ring->size - offset), sess->inData, len - (ring->size - offset));
+		}
+
+		head += len;
+		totalBytes += len;
+		__atomic_store_n(&ring->head, head, __ATOMIC_SEQ_CST);
+
+		/* a blocking writer is waiting for the space we just freed */
+		if (__atomic_load_n(&ring->writerWaiting, __ATOMIC_SEQ_CST) &&
+			__atomic_exchange_n(&ring->writerWaiting, 0, __ATOMIC_SEQ_CST))
+			ipcShmRing(sess->out, sess->peerFd);
+	}
+
+	return(totalBytes);
+}
+
+int ipcShmWriteV(void *transport, ripcIovType *iov, int iovcnt, int outLen, ripcRWFlags flags, RsslError *error)
+{
+	ripcShmSession	*sess = (ripcShmSession*)transport;
+	ripcShmRing		*ring = sess->out;
+	RsslUInt64		tail = ring->tail;
+	RsslUInt64		head;
+	RsslUInt32		mask = ring->size - 1;
+	RsslUInt32		space;
+	RsslUInt32		offset;
+	RsslUInt32		len;
+	int				totalBytes = 0;
+	int				iovIdx = 0;
+	int				iovPos = 0;
+
+	error->text[0] = '\0';
+
+	while (totalBytes < outLen)
+	{
+		if (__atomic_load_n(&sess->seg->closed, __ATOMIC_ACQUIRE))
+		{
+			errno = EPIPE;
+			return(-1);
+		}
+
+		head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		space = ring->size - (RsslUInt32)(tail - head);
+
+		if (space == 0)
+		{
+			/* Have the reader ring our eventfd when it frees space, making the channel
+			 * readable, then look again in case it already has.  The bells are not
+			 * cleared here, since they may also be for data that has not been read. */
+			if (!(flags & RIPC_RW_BLOCKING))
+			{
+				__atomic_store_n(&ring->writerWaiting, 1, __ATOMIC_SEQ_CST);
+				if (__atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) == head)
+					break;
+				continue;
+			}
+
+			/* same handshake as the reader, with the reader ringing our eventfd */
+			ipcShmClearBells(sess);
+			__atomic_store_n(&ring->writerWaiting, 1, __ATOMIC_SEQ_CST);
+			if (__atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) == head &&
+				ipcShmWait(sess) == -2)
+			{
+				errno = EPIPE;
+				return(-1);
+			}
+			continue;
+		}
+
+		/* copy from the vector until it is done or the ring is full */
+		while (space && iovIdx < iovcnt)
+		{
+			len = (RsslUInt32)RIPC_IOV_GETLEN(&iov[iovIdx]) - iovPos;
+			if (len > space)
+				len = space;
+
+			offset = (RsslUInt32)tail & mask;
+			if (offset + len <= ring->size)
+				memcpy(sess->outData + offset, (char*)RIPC_IOV_GETBUF(&iov[iovIdx]) + iovPos, len);
+			else
+			{
+				memcpy(sess->outData + offset, (char*)RIPC_IOV_GETBUF(&iov[iovIdx]) + iovPos, ring->size - offset);
+				memcpy(sess->outData, (char*)RIPC_IOV_GETBUF(&iov[iovIdx]) + iovPos + (ring->size - offset), len - (ring->size - offset));
+			}
+
+			tail += len;
+			space -= len;
+			totalBytes += len;
+			iovPos += len;
+			if (iovPos == (int)RIPC_IOV_GETLEN(&iov[iovIdx]))
+			{
+				++iovIdx;
+				iovPos = 0;
+			}
+		}
+
+		__atomic_store_n(&ring->tail, tail, __ATOMIC_SEQ_CST);
+
+		if (__atomic_load_n(&ring->readerWaiting, __ATOMIC_SEQ_CST) &&
+			__atomic_exchange_n(&ring->readerWaiting, 0, __ATOMIC_SEQ_CST))
+			ipcShmRing(ring, sess->peerFd);
+	}
+
+	return(totalBytes);
+}
+
+int ipcShmWrite(void *transport, char *buf, int outLen, ripcRWFlags flags, RsslError *error)
+{
+	ripcIovType iov;
+
+	RIPC_IOV_SETBUF(&iov, buf);
+	RIPC_IOV_SETLEN(&iov, outLen);
+
+	return ipcShmWriteV(transport, &iov, 1, outLen, flags, error);
+}
+
+/* The handshake reports this as the client's address. */
+static int ipcShmGetSockName(RsslSocket fd, struct sockaddr *address, int *address_len, void *transport)
+{
+	struct sockaddr_in *inAddr = (struct sockaddr_in*)address;
+
+	if (*address_len < (int)sizeof(struct sockaddr_in))
+		return RSSL_RET_FAILURE;
+
+	memset(inAddr, 0, sizeof(struct sockaddr_in));
+	inAddr->sin_family = AF_INET;
+	inAddr->sin_addr.s_addr = host2net_u32(INADDR_LOOPBACK);
+	*address_len = sizeof(struct sockaddr_in);
+	return RSSL_RET_SUCCESS;
+}
+
+static int ipcShmSetSockOpts(RsslSocket fd, ripcSocketOption *option, void *transport)
+{
+	switch (option->code)
+	{
+		/* ring sizes are fixed when the client creates the segment */
+		case RIPC_SOPT_RD_BUF_SIZE:
+		case RIPC_SOPT_WRT_BUF_SIZE:
+			errno = EINVAL;
+			return(-1);
+		/* the rest are TCP options, or handled by the read and write flags */
+		default:
+			return(1);
+	}
+}
+
+static int ipcShmGetSockOpts(RsslSocket fd, int code, int* value, void *transport, RsslError *error)
+{
+	ripcShmSession *sess = (ripcShmSession*)transport;
+
+	switch (code)
+	{
+		case RIPC_SYSTEM_READ_BUFFERS:
+			*value = (int)sess->in->size;
+			return RSSL_RET_SUCCESS;
+		case RIPC_SYSTEM_WRITE_BUFFERS:
+			*value = (int)sess->out->size;
+			return RSSL_RET_SUCCESS;
+		default:
+			*value = 0;
+			return RSSL_RET_FAILURE;
+	}
+}
+
+static int ipcShmConnected(RsslSocket fd, void *transport)
+{
+	return(1);
+}
+
+int ipcSetShmFuncs()
+{
+	ripcTransportFuncs  func;
+	func.bindSrvr = ipcShmSrvrBind;
+	func.newSrvrConnection = ipcShmNewConn;
+	func.connectSocket = ipcShmConnectSocket;
+	func.newClientConnection = ipcShmNewClientConn;
+	func.initializeTransport = ipcShmInitTrans;
+	func.shutdownTransport = ipcShmShutdown;
+	func.readTransport = ipcShmRead;
+	func.writeTransport = ipcShmWrite;
+	func.writeVTransport = ipcShmWriteV;
+	func.reconnectClient = ipcScktReconnectClient;
+	func.acceptSocket = ipcShmSrvrAccept;
+	func.shutdownSrvrError = ipcSrvrShutdownError;
+	func.sessIoctl = ipcSessIoctl;  // Not Support, only a stub
+	func.getSockName = ipcShmGetSockName;
+	func.setSockOpts = ipcShmSetSockOpts;
+	func.getSockOpts = ipcShmGetSockOpts;
+	func.connected = ipcShmConnected;
+	func.shutdownServer = ipcServerShutdown;
+	func.uninitialize = ipcUninitialize;  // Not defined, only a stub
+
+	return(ipcSetTransFunc(RSSL_CONN_TYPE_BIDIR_SHMEM, &func));
+}
+
+#else
+
+/* Shared memory connections need eventfd and descriptor passing, which are Linux only. */
+int ipcSetShmFuncs()
+{
+	return(1);
+}
+
+#endif
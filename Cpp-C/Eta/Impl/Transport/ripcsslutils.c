@@ -20,6 +20,14 @@
 #include <openssl/ssl.h>
 #include <openssl/x509v3.h>
 #include <openssl/bn.h>
+#include <poll.h>
+
+/* SSL_OP_ENABLE_KTLS and the BIO_get_ktls_send()/BIO_get_ktls_recv() controls, from OpenSSL 3.0;
+ * defined here since the headers built against may be older than the library loaded */
+#define RIPC_SSL_OP_ENABLE_KTLS			((uint64_t)1 << 3)
+#define RIPC_BIO_CTRL_GET_KTLS_SEND		73
+#define RIPC_BIO_CTRL_GET_KTLS_RECV		76
+#define RIPC_SSL_KTLS_MIN_VERSION		0x30000000UL
 
 static ripcSSLApiFuncs sslFuncs = INIT_SSL_API_FUNCS;
 static ripcSSLCTXApiFuncs ctxFuncs = INIT_SSL_CTX_FUNCS;
@@ -42,6 +50,21 @@ static char* defaultSslLibName = "libssl.so.10";
 static char* defaultCryptoLibName = "libcrypto.so.10";
 #endif
 
+/* Client sessions kept for resumption, one per server address and protocol version, so that a
+ * reconnecting client can skip the full handshake.  Entries are replaced oldest first. */
+#define RIPC_SSL_SESSION_CACHE_SIZE 64
+
+typedef struct {
+	struct sockaddr_storage	peer;
+	socklen_t				peerLen;
+	ripcSSLProtocolFlags	protocol;
+	SSL_SESSION				*session;
+} ripcSSLCachedSession;
+
+static RSSL_STATIC_MUTEX_DECL(sslSessionCacheMutex);
+static ripcSSLCachedSession sslSessionCache[RIPC_SSL_SESSION_CACHE_SIZE];
+static RsslUInt32 sslSessionCacheNext = 0;
+
 RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 {
 	char* sslLib;
@@ -67,11 +90,14 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 		if((sslHandle = RIPC_DLOPEN(sslLib)) == 0)
 			return -1;
 		
-		if((sslFuncs.library_init = RIPC_DLSYM(sslHandle, "SSL_library_init")) == 0)
+		/* OpenSSL 1.1 and later initialize themselves; SSL_library_init() and the other calls
+		 * removed from those versions are optional */
+		sslFuncs.library_init = RIPC_DLSYM(sslHandle, "SSL_library_init");
+		sslFuncs.init_ssl = RIPC_DLSYM(sslHandle, "OPENSSL_init_ssl");
+		if ((sslFuncs.library_init == 0) && (sslFuncs.init_ssl == 0))
 			goto sslLoadError;
 		
-		if((sslFuncs.load_error_strings = RIPC_DLSYM(sslHandle, "SSL_load_error_strings")) == 0)
-			goto sslLoadError;
+		sslFuncs.load_error_strings = RIPC_DLSYM(sslHandle, "SSL_load_error_strings");
 				
 		if((sslFuncs.get_ex_data = RIPC_DLSYM(sslHandle, "SSL_get_ex_data")) == 0)
 			goto sslLoadError;
@@ -109,7 +135,9 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 		if((sslFuncs.get_verify_result = RIPC_DLSYM(sslHandle, "SSL_get_verify_result")) == 0)
 			goto sslLoadError;
 			
-		if((sslFuncs.ssl_state = RIPC_DLSYM(sslHandle, "SSL_state")) == 0)
+		sslFuncs.ssl_state = RIPC_DLSYM(sslHandle, "SSL_state");
+		sslFuncs.is_init_finished = RIPC_DLSYM(sslHandle, "SSL_is_init_finished");
+		if ((sslFuncs.ssl_state == 0) && (sslFuncs.is_init_finished == 0))
 			goto sslLoadError;
 		
 		if((sslFuncs.ssl_connect = RIPC_DLSYM(sslHandle, "SSL_connect")) == 0)
@@ -168,6 +196,8 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 			
 		if((ctxFuncs.ctx_ctrl = RIPC_DLSYM(sslHandle, "SSL_CTX_ctrl")) == 0)
 			goto sslLoadError;
+
+		ctxFuncs.ctx_set_options = RIPC_DLSYM(sslHandle, "SSL_CTX_set_options");
 			
 		if((ctxFuncs.ctx_set_tmp_dh_callback = RIPC_DLSYM(sslHandle, "SSL_CTX_set_tmp_dh_callback")) == 0)
 			goto sslLoadError;
@@ -177,6 +207,17 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 		
 		if((ctxFuncs.ctx_set_ex_data = RIPC_DLSYM(sslHandle, "SSL_CTX_set_ex_data")) == 0)
 			goto sslLoadError;
+
+		/* session resumption is skipped if these are missing */
+		sslFuncs.set_session = RIPC_DLSYM(sslHandle, "SSL_set_session");
+		sslFuncs.get1_session = RIPC_DLSYM(sslHandle, "SSL_get1_session");
+		sslFuncs.session_free = RIPC_DLSYM(sslHandle, "SSL_SESSION_free");
+		if ((sslFuncs.get1_session == 0) || (sslFuncs.session_free == 0))
+			sslFuncs.set_session = 0;
+
+		sslFuncs.set_options = RIPC_DLSYM(sslHandle, "SSL_set_options");
+
+		sslFuncs.get_ex_data_X509_STORE_CTX_idx = RIPC_DLSYM(sslHandle, "SSL_get_ex_data_X509_STORE_CTX_idx");
 	}
 	
 	if(cryptoHandle == 0)
@@ -184,18 +225,14 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 		if((cryptoHandle = RIPC_DLOPEN(cryptoLib)) == 0)
 			return -1;
 		
-		if((sslFuncs.load_crypto_strings = RIPC_DLSYM(cryptoHandle, "ERR_load_crypto_strings")) == 0)
-			goto cryptoLoadError;
-			
-		if((cryptoFuncs.err_free_strings = RIPC_DLSYM(cryptoHandle, "ERR_free_strings")) == 0)
-			goto cryptoLoadError;
+		sslFuncs.load_crypto_strings = RIPC_DLSYM(cryptoHandle, "ERR_load_crypto_strings");
+		cryptoFuncs.err_free_strings = RIPC_DLSYM(cryptoHandle, "ERR_free_strings");
 			
 		if((cryptoFuncs.v3_add_standard_extensions = RIPC_DLSYM(cryptoHandle, "X509V3_add_standard_extensions")) == 0)
 			goto cryptoLoadError;
 			
-		if((cryptoFuncs.thread_id = RIPC_DLSYM(cryptoHandle, "CRYPTO_thread_id")) == 0)
-			goto cryptoLoadError;
-			
+		cryptoFuncs.thread_id = RIPC_DLSYM(cryptoHandle, "CRYPTO_thread_id");
+
 		if((cryptoFuncs.get_error_line_data = RIPC_DLSYM(cryptoHandle, "ERR_get_error_line_data")) == 0)
 			goto cryptoLoadError;
 		
@@ -241,17 +278,12 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 		if((cryptoFuncs.get_subject_name = RIPC_DLSYM(cryptoHandle, "X509_get_subject_name")) == 0)
 			goto cryptoLoadError;
 			
-		if((cryptoFuncs.err_remove_state = RIPC_DLSYM(cryptoHandle, "ERR_remove_state")) == 0)
-			goto cryptoLoadError;
-			
-		if((cryptoFuncs.engine_cleanup = RIPC_DLSYM(cryptoHandle, "ENGINE_cleanup")) == 0)
-			goto cryptoLoadError;
-			
-		if((cryptoFuncs.crypto_cleanup_all_ex_data = RIPC_DLSYM(cryptoHandle, "CRYPTO_cleanup_all_ex_data")) == 0)
-			goto cryptoLoadError;
-			
-		if((cryptoFuncs.evp_cleanup = RIPC_DLSYM(cryptoHandle, "EVP_cleanup")) == 0)
-			goto cryptoLoadError;
+		cryptoFuncs.err_remove_state = RIPC_DLSYM(cryptoHandle, "ERR_remove_state");
+		cryptoFuncs.engine_cleanup = RIPC_DLSYM(cryptoHandle, "ENGINE_cleanup");
+		cryptoFuncs.crypto_cleanup_all_ex_data = RIPC_DLSYM(cryptoHandle, "CRYPTO_cleanup_all_ex_data");
+		cryptoFuncs.evp_cleanup = RIPC_DLSYM(cryptoHandle, "EVP_cleanup");
+
+		cryptoFuncs.version_num = RIPC_DLSYM(cryptoHandle, "OpenSSL_version_num");
 			
 		if((bioFuncs.new_file = RIPC_DLSYM(cryptoHandle, "BIO_new_file")) == 0)
 			goto cryptoLoadError;
@@ -264,6 +296,8 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 			
 		if((bioFuncs.new_socket = RIPC_DLSYM(cryptoHandle, "BIO_new_socket")) == 0)
 			goto cryptoLoadError;
+
+		bioFuncs.bio_ctrl = RIPC_DLSYM(cryptoHandle, "BIO_ctrl");
 	}
 		
 	SSLfuncs.bindSrvr = 0;
@@ -274,7 +308,7 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 	SSLfuncs.shutdownTransport = ripcShutdownSSLSocket; // shuts down socket on client or server side
 	SSLfuncs.readTransport = ripcSSLRead; // read function on client or server side
 	SSLfuncs.writeTransport = ripcSSLWrite; // write function on client or server side
-	SSLfuncs.writeVTransport = 0;
+	SSLfuncs.writeVTransport = ripcSSLWriteV;
 	SSLfuncs.reconnectClient = ripcSSLReconnection;
 	SSLfuncs.acceptSocket = 0;
 	SSLfuncs.shutdownSrvrError = 0;
@@ -319,10 +353,15 @@ RsslInt32 ripcInitializeSSL(char* libsslName, char* libcryptoName)
 
 	retVal = ipcSetSSLFuncs(&funcs);
 	
-	(*(sslFuncs.library_init))();
+	if (sslFuncs.library_init)
+		(*(sslFuncs.library_init))();
+	else
+		(*(sslFuncs.init_ssl))(0, NULL);
 
-	(*(sslFuncs.load_error_strings))();
-	(*(sslFuncs.load_crypto_strings))();
+	if (sslFuncs.load_error_strings)
+		(*(sslFuncs.load_error_strings))();
+	if (sslFuncs.load_crypto_strings)
+		(*(sslFuncs.load_crypto_strings))();
 
 	(*(cryptoFuncs.v3_add_standard_extensions))();
 	
@@ -350,13 +389,34 @@ sslLoadError:
 
 void ripcUninitializeSSL(void)
 {
+	RsslUInt32 i;
+
+	RSSL_STATIC_MUTEX_LOCK(sslSessionCacheMutex);
+	for (i = 0; i < RIPC_SSL_SESSION_CACHE_SIZE; i++)
+	{
+		if (sslSessionCache[i].session)
+		{
+			(*(sslFuncs.session_free))(sslSessionCache[i].session);
+			sslSessionCache[i].session = 0;
+			sslSessionCache[i].peerLen = 0;
+		}
+	}
+	sslSessionCacheNext = 0;
+	RSSL_STATIC_MUTEX_UNLOCK(sslSessionCacheMutex);
+
 	if (cryptoHandle)
 	{
-		(*(cryptoFuncs.evp_cleanup))();
-		(*(cryptoFuncs.engine_cleanup))();
-		(*(cryptoFuncs.crypto_cleanup_all_ex_data))();
-		(*(cryptoFuncs.err_remove_state))(0);
-		(*(cryptoFuncs.err_free_strings))();
+		/* OpenSSL 1.1 and later clean up on their own and no longer have these */
+		if (cryptoFuncs.evp_cleanup)
+			(*(cryptoFuncs.evp_cleanup))();
+		if (cryptoFuncs.engine_cleanup)
+			(*(cryptoFuncs.engine_cleanup))();
+		if (cryptoFuncs.crypto_cleanup_all_ex_data)
+			(*(cryptoFuncs.crypto_cleanup_all_ex_data))();
+		if (cryptoFuncs.err_remove_state)
+			(*(cryptoFuncs.err_remove_state))(0);
+		if (cryptoFuncs.err_free_strings)
+			(*(cryptoFuncs.err_free_strings))();
 		RIPC_DLCLOSE(cryptoHandle);
 		cryptoHandle = 0;
 	}
@@ -381,7 +441,7 @@ void ripcSSLErrors(RsslError *error, RsslInt32 initPos)
 	RsslInt32 line = 0;
 	RsslInt32 flags = 0;
 	RsslInt32 cUrl = initPos;
-	RsslUInt32 es= (*(cryptoFuncs.thread_id))();
+	RsslUInt32 es= cryptoFuncs.thread_id ? (*(cryptoFuncs.thread_id))() : 0;
 
 	buf[0] = '\0';
 
@@ -513,6 +573,12 @@ ripcSSLSession *ripcSSLNewSession(RsslSocket fd, char* name, ripcSSLServer *serv
 	session->ctx = 0;
 	session->connection = 0;
 	session->clientConnState = SSL_INITIALIZING;
+	session->sessionProtocol = RIPC_PROTO_SSL_NONE;
+	session->peerLen = 0;
+	session->resumeChecked = 0;
+	session->kernelTlsRequested = 0;
+	session->kernelTlsTx = 0;
+	session->kernelTlsRx = 0;
 	
 	/* we only need to initialize the connect opts for client side configs - if its 
 	   a server side channel, just point it to the servers config */
@@ -818,7 +884,11 @@ SSL_CTX* ripcSSLSetupCTX(RsslInt32 user, ripcSSLProtocolFlags version, ripcSSLCo
 	/* need to get CERTFILE from config */
 	(*(ctxFuncs.ctx_set_verify))(ctx, perm, verify_callback);
 
-	(*(ctxFuncs.ctx_ctrl))(ctx, SSL_CTRL_OPTIONS, opts,NULL);
+	/* SSL_CTX_set_options() was a macro over SSL_CTRL_OPTIONS before OpenSSL 1.1 */
+	if (ctxFuncs.ctx_set_options)
+		(*(ctxFuncs.ctx_set_options))(ctx, opts);
+	else
+		(*(ctxFuncs.ctx_ctrl))(ctx, SSL_CTRL_OPTIONS, opts,NULL);
 	
 	(*(ctxFuncs.ctx_set_tmp_dh_callback))(ctx, ripcDHCallback);
 
@@ -890,6 +960,9 @@ RsslInt32 ripcSSLWrite( void *sslSess, char *buf, RsslInt32 len, ripcRWFlags fla
 	RsslInt32 totalOut = 0;
 	ripcSSLSession *sess = (ripcSSLSession*)sslSess;
 
+	if (sess->kernelTlsTx)
+		return ipcWrite((void*)(intptr_t)sess->socket, buf, len, flags, error);
+
 	while (totalOut < len)
 	{
 		numBytes = (*(sslFuncs.ssl_write))(sess->connection, (buf + totalOut), (len - totalOut));
@@ -929,6 +1002,33 @@ RsslInt32 ripcSSLWrite( void *sslSess, char *buf, RsslInt32 len, ripcRWFlags fla
 	return totalOut;
 }
 
+/* our transport writev function -
+   a single writev() when the kernel encrypts the records, otherwise each buffer is written with SSL
+   until one is only partly written */
+int ripcSSLWriteV( void *sslSess, ripcIovType *iov, int iovcnt, int outLen, ripcRWFlags flags, RsslError *error)
+{
+	ripcSSLSession *sess = (ripcSSLSession*)sslSess;
+	RsslInt32 numBytes;
+	int totalOut = 0;
+	int i;
+
+	if (sess->kernelTlsTx)
+		return ipcWriteV((void*)(intptr_t)sess->socket, iov, iovcnt, outLen, flags, error);
+
+	for (i = 0; i < iovcnt; i++)
+	{
+		numBytes = ripcSSLWrite(sess, (char*)RIPC_IOV_GETBUF(&iov[i]), (RsslInt32)RIPC_IOV_GETLEN(&iov[i]), flags, error);
+		if (numBytes < 0)
+			return numBytes;
+
+		totalOut += numBytes;
+		if (numBytes < (RsslInt32)RIPC_IOV_GETLEN(&iov[i]))
+			break;
+	}
+
+	return totalOut;
+}
+
 RsslInt32 ripcShutdownSSLSocket(void *session)
 {
 	ripcSSLSession *sess = (ripcSSLSession*)session;
@@ -943,6 +1043,136 @@ RsslInt32 ripcShutdownSSLSocket(void *session)
 	return 1;
 }
 
+/* Offers the session cached for the same server, if there is one, to a client connection.  This
+ * has to happen before its first SSL_connect(), once the TCP connection is up so that the server's
+ * address is known.  Returns 0 while the TCP connection is still being made. */
+static RsslInt32 ripcSSLOfferSession(ripcSSLSession *sess)
+{
+	struct pollfd pfd;
+	RsslUInt32 i;
+
+	if (sess->resumeChecked)
+		return 1;
+
+	if (sslFuncs.set_session == 0)
+	{
+		sess->resumeChecked = 1;
+		return 1;
+	}
+
+	sess->peerLen = sizeof(sess->peer);
+	if (getpeername(sess->socket, (struct sockaddr*)&sess->peer, &sess->peerLen) != 0)
+	{
+		sess->peerLen = 0;
+
+		/* a connection that failed is writable, and SSL_connect() reports the failure */
+		pfd.fd = sess->socket;
+		pfd.events = POLLOUT;
+		pfd.revents = 0;
+		if (poll(&pfd, 1, 0) == 0)
+			return 0;
+
+		sess->resumeChecked = 1;
+		return 1;
+	}
+
+	sess->resumeChecked = 1;
+
+	RSSL_STATIC_MUTEX_LOCK(sslSessionCacheMutex);
+	for (i = 0; i < RIPC_SSL_SESSION_CACHE_SIZE; i++)
+	{
+		ripcSSLCachedSession *entry = &sslSessionCache[i];
+
+		if (entry->session && (entry->protocol == sess->sessionProtocol) && (entry->peerLen == sess->peerLen) &&
+			(memcmp(&entry->peer, &sess->peer, sess->peerLen) == 0))
+		{
+			(*(sslFuncs.set_session))(sess->connection, entry->session);
+			break;
+		}
+	}
+	RSSL_STATIC_MUTEX_UNLOCK(sslSessionCacheMutex);
+
+	return 1;
+}
+
+/* Keeps the session of a client connection that just completed its handshake for the next
+ * connection to the same server. */
+static void ripcSSLCacheSession(ripcSSLSession *sess)
+{
+	ripcSSLCachedSession *entry = 0;
+	SSL_SESSION *newSession;
+	SSL_SESSION *oldSession;
+	RsslUInt32 i;
+
+	if ((sess->peerLen == 0) || (sslFuncs.set_session == 0))
+		return;
+
+	if ((newSession = (*(sslFuncs.get1_session))(sess->connection)) == 0)
+		return;
+
+	RSSL_STATIC_MUTEX_LOCK(sslSessionCacheMutex);
+	for (i = 0; i < RIPC_SSL_SESSION_CACHE_SIZE; i++)
+	{
+		if ((sslSessionCache[i].protocol == sess->sessionProtocol) && (sslSessionCache[i].peerLen == sess->peerLen) &&
+			(memcmp(&sslSessionCache[i].peer, &sess->peer, sess->peerLen) == 0))
+		{
+			entry = &sslSessionCache[i];
+			break;
+		}
+	}
+
+	if (entry == 0)
+	{
+		entry = &sslSessionCache[sslSessionCacheNext];
+		sslSessionCacheNext = (sslSessionCacheNext + 1) % RIPC_SSL_SESSION_CACHE_SIZE;
+	}
+
+	oldSession = entry->session;
+	memcpy(&entry->peer, &sess->peer, sess->peerLen);
+	entry->peerLen = sess->peerLen;
+	entry->protocol = sess->sessionProtocol;
+	entry->session = newSession;
+	RSSL_STATIC_MUTEX_UNLOCK(sslSessionCacheMutex);
+
+	if (oldSession)
+		(*(sslFuncs.session_free))(oldSession);
+}
+
+/* Asks OpenSSL to hand the record encryption of a client connection to the kernel (kTLS) once its
+ * handshake completes.  OpenSSL sets the keys and record sequence numbers itself, and only for the
+ * ciphers the kernel takes; this needs OpenSSL 3.0 or later, built with kTLS.  Must be called
+ * before the handshake starts. */
+static void ripcSSLRequestKernelTls(ripcSSLSession *sess)
+{
+#ifdef Linux
+	if ((sslFuncs.set_options == 0) || (bioFuncs.bio_ctrl == 0) || (cryptoFuncs.version_num == 0) ||
+		((*(cryptoFuncs.version_num))() < RIPC_SSL_KTLS_MIN_VERSION))
+		return;
+
+	(*(sslFuncs.set_options))(sess->connection, RIPC_SSL_OP_ENABLE_KTLS);
+	sess->kernelTlsRequested = 1;
+#endif
+}
+
+/* Records which directions OpenSSL handed to the kernel during the handshake.  Writes in an
+ * offloaded direction go straight to the socket.  Reads always go through SSL_read(), which
+ * takes the alerts and other control records the kernel passes up separately. */
+static void ripcSSLCheckKernelTls(ripcSSLSession *sess)
+{
+	if (!sess->kernelTlsRequested)
+		return;
+
+	sess->kernelTlsTx = ((*(bioFuncs.bio_ctrl))(sess->bio, RIPC_BIO_CTRL_GET_KTLS_SEND, 0, NULL) != 0);
+	sess->kernelTlsRx = ((*(bioFuncs.bio_ctrl))(sess->bio, RIPC_BIO_CTRL_GET_KTLS_RECV, 0, NULL) != 0);
+}
+
+RsslUInt32 ripcSSLKernelTlsOffload(void *session)
+{
+	ripcSSLSession *sess = (ripcSSLSession*)session;
+
+	return (sess->kernelTlsRx ? RIPC_SSL_KTLS_RX : 0) | (sess->kernelTlsTx ? RIPC_SSL_KTLS_TX : 0);
+}
+
 RsslInt32 ripcSSLAccept(void *session, ripcSessInProg *inPr, RsslError *error)
 {
 	RsslInt32 retVal = 0;
@@ -987,7 +1217,7 @@ RsslInt32 ripcSSLAccept(void *session, ripcSessInProg *inPr, RsslError *error)
 		}
 
 		/* what happens if this is not true??? */
-		if ((*(sslFuncs.ssl_state))(sess->connection) == SSL_ST_OK)
+		if (sslFuncs.ssl_state ? ((*(sslFuncs.ssl_state))(sess->connection) == SSL_ST_OK) : (*(sslFuncs.is_init_finished))(sess->connection))
 		{
 			return 1;
 		}
@@ -1008,6 +1238,9 @@ RsslInt32 ripcSSLAccept(void *session, ripcSessInProg *inPr, RsslError *error)
 		/* should be client side */
 		if (sess->clientConnState == SSL_INITIALIZING)
 		{
+			if (ripcSSLOfferSession(sess) == 0)
+				return 0;
+
 			if ((retVal = (*(sslFuncs.ssl_connect))(sess->connection)) <= 0)
 			{
 				/* this would happen if its nonblocking and it needs more action to be taken */
@@ -1027,6 +1260,8 @@ RsslInt32 ripcSSLAccept(void *session, ripcSessInProg *inPr, RsslError *error)
 			{
 				sess->clientConnState = SSL_ACTIVE;
 				inPr->intConnState = (sess->clientConnState << 8);  
+				ripcSSLCacheSession(sess);
+				ripcSSLCheckKernelTls(sess);
 				return 1;
 			}
 		}
@@ -1068,6 +1303,17 @@ void *ripcSSLConnectInt(RsslSocket fd, RsslInt32 SSLProtocolVersion, RsslInt32 *
 	
 	(*(sslFuncs.set_ex_data))(sess->connection, 0, sess);  // Set the user spec pointer for this connection 
 
+	if ((userSpecPtr != 0) && *(RsslBool*)userSpecPtr)
+		ripcSSLRequestKernelTls(sess);
+
+	if (ripcSSLOfferSession(sess) == 0)
+	{
+		/* still connecting; SSL_connect() is started by ripcSSLAccept() */
+		sess->clientConnState = SSL_INITIALIZING;
+		*initComplete = 0;
+		return sess;
+	}
+
 	if ((retVal = (*(sslFuncs.ssl_connect))(sess->connection)) <= 0)
 	{
 		/* this would happen if its nonblocking and it needs more action to be taken */
@@ -1091,6 +1337,8 @@ void *ripcSSLConnectInt(RsslSocket fd, RsslInt32 SSLProtocolVersion, RsslInt32 *
 	{
 		sess->clientConnState = SSL_ACTIVE;
 			*initComplete = 1;
+		ripcSSLCacheSession(sess);
+		ripcSSLCheckKernelTls(sess);
 		}
 
 	return sess;
@@ -1263,6 +1511,7 @@ ripcSSLSession *ripcInitializeSSLSession(RsslSocket fd, RsslInt32 SSLProtocolVer
 
 	/* setup the CTX - we are the client */
 	sess->ctx = ripcSSLSetupCTX(0, SSLProtocolVersion, &sess->config, error);
+	sess->sessionProtocol = (ripcSSLProtocolFlags)SSLProtocolVersion;
 
 	(*(ctxFuncs.ctx_set_ex_data))(sess->ctx, 0, sess);
 
@@ -1279,7 +1528,8 @@ RsslInt32 verify_callback(RsslInt32 ok, X509_STORE_CTX *store)
 	SSL *ssl = 0;
 	X509 *cert = 0;
 
-	ssl = (SSL*)(*(cryptoFuncs.X509_get_ex_data))(store, 0);
+	ssl = (SSL*)(*(cryptoFuncs.X509_get_ex_data))(store,
+		sslFuncs.get_ex_data_X509_STORE_CTX_idx ? (*(sslFuncs.get_ex_data_X509_STORE_CTX_idx))() : 0);
 	sess = (ripcSSLSession*)(*(sslFuncs.get_ex_data))(ssl, 0);
 
 	cert = (*(cryptoFuncs.get_current_cert))(store);
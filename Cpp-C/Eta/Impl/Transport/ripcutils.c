@@ -26,6 +26,7 @@
 #include <ctype.h>
 #include <netdb.h>
 #include <string.h>
+#include <time.h>
 #endif
 
 #ifdef DEV_HAS_POLL
@@ -41,6 +42,35 @@
 
 #ifdef Linux
 #include <asm/ioctls.h>
+#include <sys/socket.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+/* Older headers may not define the zero copy constants; the values are fixed by the kernel ABI. */
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+#ifndef SO_TIMESTAMPING
+#define SO_TIMESTAMPING 37
+#endif
+#ifndef SCM_TIMESTAMPING
+#define SCM_TIMESTAMPING SO_TIMESTAMPING
+#endif
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL 46
+#endif
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
 #endif /* Linux */
 
 static rtr_atomic_val rtr_SocketInits = 0;
@@ -336,6 +366,17 @@ int ipcSockOpts(RsslSocket fd, ripcSocketOption *option)
 			break;
 		}
 
+#if defined(SO_REUSEPORT)
+		case RIPC_SOPT_REUSEPORT:
+		{
+			int reusePortFlag = (option->options.turn_on ? 1 : 0);
+			if (setsockopt(fd,SOL_SOCKET,SO_REUSEPORT,(char *)&reusePortFlag,
+								(int)sizeof(reusePortFlag)) < 0)
+				ret = -1;
+			break;
+		}
+#endif
+
 #if defined(_WIN32) && defined(SO_EXCLUSIVEADDRUSE)
 		case RIPC_SOPT_EXCLUSIVEADDRUSE:
 		{
@@ -674,6 +715,275 @@ ripcwritevagain:
 	return(totOut);
 }
 
+int ipcZeroCopyEnable(RsslSocket fd)
+{
+#ifdef Linux
+	int on = 1;
+
+	if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, (char*)&on, sizeof(on)) < 0)
+		return(-1);
+	return(1);
+#else
+	errno = ENOSYS;
+	return(-1);
+#endif
+}
+
+int ipcZeroCopyWriteV( void *transport, ripcIovType *iov, int iovcnt, int outLen, ripcRWFlags flags, int *zeroCopySent, RsslError *error)
+{
+#ifdef Linux
+	struct msghdr	msg;
+	int numBytes = 0;
+	int totOut = 0;
+	int sendFlags = MSG_ZEROCOPY;
+
+	*zeroCopySent = 0;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = iovcnt;
+
+ripczerocopyagain:
+
+	numBytes = (int)sendmsg((RsslSocket)(intptr_t)transport, &msg, sendFlags);
+
+	if (numBytes > 0)
+	{
+		totOut += numBytes;
+		if (sendFlags & MSG_ZEROCOPY)
+			*zeroCopySent = 1;
+	}
+	else if (numBytes < 0)
+	{
+		if ((errno == _IPC_WOULD_BLOCK) || (errno == EINTR))
+		{
+			if (flags & RIPC_RW_BLOCKING)
+				goto ripczerocopyagain;
+		}
+		else if ((errno == ENOBUFS) && (sendFlags & MSG_ZEROCOPY))
+		{
+			/* Out of option memory for pinning pages; copy this one instead. */
+			sendFlags = 0;
+			goto ripczerocopyagain;
+		}
+		else
+		{
+			error->text[0] = '\0';
+			totOut = -1;
+		}
+	}
+	else /* numBytes == 0 */
+	{
+		error->text[0] = '\0';
+		totOut = -2;
+	}
+
+	return(totOut);
+#else
+	*zeroCopySent = 0;
+	return(ipcWriteV(transport, iov, iovcnt, outLen, flags, error));
+#endif
+}
+
+int ipcZeroCopyAbort(RsslSocket fd)
+{
+#ifdef Linux
+	struct linger	lingerOpt;
+	struct sockaddr	unspec;
+
+	/* Even if the disconnect below fails, closing the socket now resets the connection instead of sending what is queued. */
+	lingerOpt.l_onoff = 1;
+	lingerOpt.l_linger = 0;
+	(void)setsockopt(fd, SOL_SOCKET, SO_LINGER, (char*)&lingerOpt, sizeof(lingerOpt));
+
+	/* Disconnecting resets the connection and drops the unsent data, but unlike close() keeps the error queue readable. */
+	memset(&unspec, 0, sizeof(unspec));
+	unspec.sa_family = AF_UNSPEC;
+	if (connect(fd, &unspec, sizeof(unspec)) < 0)
+		return(-1);
+	return(1);
+#else
+	return(0);
+#endif
+}
+
+int ipcZeroCopyCompletion(RsslSocket fd, RsslUInt32 *lo, RsslUInt32 *hi, int *copied)
+{
+#ifdef Linux
+	struct msghdr	msg;
+	struct cmsghdr	*cm;
+	struct sock_extended_err	*serr;
+	char	control[128];
+
+	for (;;)
+	{
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		if (recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+		{
+			if ((errno == _IPC_WOULD_BLOCK) || (errno == EINTR))
+				return(0);
+			return(-1);
+		}
+
+		for (cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm))
+		{
+			if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+				(cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+				continue;
+
+			serr = (struct sock_extended_err*)CMSG_DATA(cm);
+			if ((serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) || (serr->ee_errno != 0))
+				continue;
+
+			*lo = serr->ee_info;
+			*hi = serr->ee_data;
+			*copied = (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) ? 1 : 0;
+			return(1);
+		}
+		/* Not a zero copy notification, keep reading. */
+	}
+#else
+	return(0);
+#endif
+}
+
+int ipcRecvTimestampEnable(RsslSocket fd, int enable)
+{
+#ifdef Linux
+	int flags = (enable ? (SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE) : 0);
+
+	if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, (char*)&flags, sizeof(flags)) < 0)
+		return(-1);
+	return(1);
+#else
+	errno = ENOSYS;
+	return(-1);
+#endif
+}
+
+int ipcReadTimestamp(void *transport, char *buf, int max_len, ripcRWFlags flags, ripcRecvStamp *stamps, RsslUInt32 *stampCount, RsslUInt32 maxStamps, RsslError *error)
+{
+#ifdef Linux
+	struct msghdr	msg;
+	struct iovec	iov;
+	struct cmsghdr	*cm;
+	struct scm_timestamping	*tss;
+	char	control[CMSG_SPACE(sizeof(struct scm_timestamping))];
+	ssize_t numBytes;
+	int totalBytes = 0;
+
+	*stampCount = 0;
+
+	while (totalBytes < max_len)
+	{
+		iov.iov_base = buf + totalBytes;
+		iov.iov_len = (size_t)(max_len - totalBytes);
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		numBytes = recvmsg((RsslSocket)(intptr_t)transport, &msg, 0);
+
+		if (numBytes > 0)
+		{
+			totalBytes += (int)numBytes;
+
+			for (cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm))
+			{
+				if ((cm->cmsg_level != SOL_SOCKET) || (cm->cmsg_type != SCM_TIMESTAMPING))
+					continue;
+
+				tss = (struct scm_timestamping*)CMSG_DATA(cm);
+				if ((tss->ts[0].tv_sec == 0) && (tss->ts[0].tv_nsec == 0))
+					break;
+
+				if (*stampCount == maxStamps)
+				{
+					if (maxStamps == 0)
+						break;
+					--(*stampCount);
+				}
+				stamps[*stampCount].endOffset = (RsslUInt32)totalBytes;
+				stamps[*stampCount].stamp = (RsslUInt64)tss->ts[0].tv_sec * 1000000000ULL + (RsslUInt64)tss->ts[0].tv_nsec;
+				++(*stampCount);
+				break;
+			}
+		}
+		else if (numBytes < 0)
+		{
+			error->text[0] = '\0';
+			if ((errno == _IPC_WOULD_BLOCK) || (errno == EINTR))
+			{
+				if (!(flags & RIPC_RW_BLOCKING))
+					return(totalBytes);
+			}
+			else
+			{
+				return(-1);
+			}
+		}
+		else	/* numBytes == 0 */
+		{
+			if (totalBytes)
+				return totalBytes;
+			else
+			{
+				error->text[0] = '\0';
+				return(-2);
+			}
+		}
+
+		if ((flags & RIPC_RW_BLOCKING) && (totalBytes != 0) && (!(flags & RIPC_RW_WAITALL)))
+			break;
+	}
+
+	return(totalBytes);
+#else
+	*stampCount = 0;
+	return(ipcRead(transport, buf, max_len, flags, error));
+#endif
+}
+
+int ipcBusyPollEnable(RsslSocket fd, RsslUInt32 usec)
+{
+#ifdef Linux
+	int value = (int)usec;
+	int prefer = (usec ? 1 : 0);
+
+	/* Raising SO_BUSY_POLL above net.core.busy_poll needs CAP_NET_ADMIN, and
+	 * SO_PREFER_BUSY_POLL needs a 5.11 kernel; both are optional. */
+	(void)setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, (char*)&prefer, sizeof(prefer));
+	if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, (char*)&value, sizeof(value)) < 0)
+		return(0);
+	return(1);
+#else
+	return(0);
+#endif
+}
+
+RsslUInt64 ipcGetTimeNano()
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = { 0 };
+	LARGE_INTEGER counter;
+
+	if (frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (RsslUInt64)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (RsslUInt64)ts.tv_sec * 1000000000ULL + (RsslUInt64)ts.tv_nsec;
+#endif
+}
+
 int ipcWrite( void *transport, char *buf, int outLen, ripcRWFlags flags, RsslError *error)
 {
 #ifdef _WIN32WSA
@@ -782,6 +1092,18 @@ RsslInt32 ipcSrvrBind(rsslServerImpl *srvr, RsslError *error)
 	char* interfaceName;
 #endif
 
+#if !defined(SO_REUSEPORT)
+	if (rsslServerSocketChannel->serverSharedSocket)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 0006 serverSharedSocket is not supported on this platform.\n",
+			__FILE__, __LINE__);
+
+		return -1;
+	}
+#endif
+
 	sock_fd = socket(AF_INET, SOCK_STREAM, getProtocolNumber());
 
 	if (!ripcValidSocket(sock_fd))
@@ -794,6 +1116,25 @@ RsslInt32 ipcSrvrBind(rsslServerImpl *srvr, RsslError *error)
 		return -1;
 	}
 
+#if defined(SO_REUSEPORT)
+	/* Other servers may already be listening on this port; the kernel balances new connections between them */
+	if (rsslServerSocketChannel->serverSharedSocket)
+	{
+		sockopts.code = RIPC_SOPT_REUSEPORT;
+		sockopts.options.turn_on = 1;
+		if (ipcSockOpts(sock_fd, &sockopts) < 0)
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+				"<%s:%d> Error: 1002 Could not to set SO_REUSEPORT on socket. System errno: (%d)\n",
+				__FILE__, __LINE__, errno);
+
+			sock_close(sock_fd);
+			return -1;
+		}
+	}
+#endif
+
 #if defined(_WIN32)
 	sockopts.code = RIPC_SOPT_EXCLUSIVEADDRUSE;
 	sockopts.options.turn_on = 1;
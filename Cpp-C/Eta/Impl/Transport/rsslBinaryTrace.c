@@ -0,0 +1,481 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+#include "rtr/rsslBinaryTraceImpl.h"
+#include "rtr/rsslThread.h"
+#include "rtr/rsslErrors.h"
+#include "rtr/rsslAlloc.h"
+#include "xmlDump.h"
+
+/* The writer thread waits on a condition once it has run out of work */
+#if defined(_WIN32)
+typedef CONDITION_VARIABLE rsslBinaryTraceCond;
+#define RSSL_BINARY_TRACE_COND_INIT(__pCond)			InitializeConditionVariable(__pCond)
+#define RSSL_BINARY_TRACE_COND_DESTROY(__pCond)
+#define RSSL_BINARY_TRACE_COND_WAIT(__pCond, __pMutex)	SleepConditionVariableCS((__pCond), (__pMutex), INFINITE)
+#define RSSL_BINARY_TRACE_COND_SIGNAL(__pCond)			WakeConditionVariable(__pCond)
+#else
+typedef pthread_cond_t rsslBinaryTraceCond;
+#define RSSL_BINARY_TRACE_COND_INIT(__pCond)			pthread_cond_init((__pCond), NULL)
+#define RSSL_BINARY_TRACE_COND_DESTROY(__pCond)			pthread_cond_destroy(__pCond)
+#define RSSL_BINARY_TRACE_COND_WAIT(__pCond, __pMutex)	pthread_cond_wait((__pCond), (__pMutex))
+#define RSSL_BINARY_TRACE_COND_SIGNAL(__pCond)			pthread_cond_signal(__pCond)
+#endif
+
+/* Traces of the open channels, and the thread writing them; started when the first trace is opened.
+ * binaryTraceMutex guards the list, and is not held while a file is written. */
+static RsslMutex	binaryTraceMutex;
+static RsslQueue	binaryTraceList;
+static RsslUInt32	binaryTracePass = 0;
+static RsslThreadId	binaryTraceThreadId;
+static RsslBool		binaryTraceThreadStarted = RSSL_FALSE;
+static RsslBool		binaryTraceThreadStop = RSSL_FALSE;
+static rsslBinaryTraceCond binaryTraceWake;
+static rtr_atomic_val binaryTraceIdle = 0;	/* set while the writer thread waits, or is about to */
+
+static RsslInt64 rsslBinaryTraceTime()
+{
+#if defined(_WIN32)
+	FILETIME fileTime;
+	ULARGE_INTEGER time100ns;
+
+	GetSystemTimePreciseAsFileTime(&fileTime);
+	time100ns.LowPart = fileTime.dwLowDateTime;
+	time100ns.HighPart = fileTime.dwHighDateTime;
+
+	/* from 100ns intervals since 1601 */
+	return (RsslInt64)(time100ns.QuadPart - 116444736000000000ULL) * 100;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (RsslInt64)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+/* Opens a new file, named after traceMsgFileName and the time, and writes its header */
+static RsslRet rsslBinaryTraceOpenFile(rsslBinaryTrace *trace)
+{
+	unsigned long long hour = 0, min = 0, sec = 0, msec = 0;
+	size_t nameLength = strlen(trace->fileName);
+	char *newFileName;
+
+	if ((newFileName = (char*)_rsslMalloc(nameLength + 48)) == NULL)
+		return RSSL_RET_FAILURE;
+
+	xmlGetTimeFromEpoch(&hour, &min, &sec, &msec);
+	/* as the XML trace names its files, with the time in milliseconds */
+	snprintf(newFileName, nameLength + 48, "%s%llu.bin", trace->fileName, msec);
+
+	trace->file = fopen(newFileName, "wb");
+	_rsslFree(newFileName);
+	if (trace->file == NULL)
+		return RSSL_RET_FAILURE;
+
+	trace->fileHeader.startTime = rsslBinaryTraceTime();
+	if (fwrite(&trace->fileHeader, sizeof(RsslBinaryTraceFileHeader), 1, trace->file) != 1)
+	{
+		fclose(trace->file);
+		trace->file = NULL;
+		return RSSL_RET_FAILURE;
+	}
+	trace->fileSize = sizeof(RsslBinaryTraceFileHeader);
+
+	return RSSL_RET_SUCCESS;
+}
+
+/* Writes a record to the current file, moving to a new file, or stopping, once traceMsgMaxFileSize is reached */
+static void rsslBinaryTraceWriteRecord(rsslBinaryTrace *trace, const void *record, RsslUInt32 recordLength)
+{
+	if (trace->file == NULL)
+		return;
+
+	if (trace->fileSize + recordLength > trace->maxFileSize)
+	{
+		fclose(trace->file);
+		trace->file = NULL;
+
+		if (!trace->multipleFiles || rsslBinaryTraceOpenFile(trace) != RSSL_RET_SUCCESS)
+			return;
+	}
+
+	if (fwrite(record, recordLength, 1, trace->file) == 1)
+		trace->fileSize += recordLength;
+}
+
+/* Writes the committed records at the start of the buffer, then gives their space back.
+ * Called with the trace's fileMutex held.  Returns the number of bytes consumed. */
+static RsslUInt32 rsslBinaryTraceDrain(rsslBinaryTrace *trace)
+{
+	RsslUInt32 ringSize = trace->ringMask + 1;
+	RsslUInt32 start = (RsslUInt32)trace->consumed;
+	RsslUInt32 position = start;
+	RsslUInt32 offset, recordLength;
+	rtr_atomic_val dropped;
+
+	while (position - start < ringSize)
+	{
+		offset = position & trace->ringMask;
+		recordLength = *(volatile RsslUInt32*)(trace->ring + offset);
+		if (recordLength == 0)
+			break;
+
+		if (!(recordLength & RSSL_BINARY_TRACE_PAD))
+			rsslBinaryTraceWriteRecord(trace, trace->ring + offset, recordLength);
+		position += recordLength & ~RSSL_BINARY_TRACE_PAD;
+	}
+
+	if (position != start)
+	{
+		/* producers rely on free space being zero, so that a record is only seen once committed */
+		offset = start & trace->ringMask;
+		if (offset + (position - start) <= ringSize)
+			memset(trace->ring + offset, 0, position - start);
+		else
+		{
+			memset(trace->ring + offset, 0, ringSize - offset);
+			memset(trace->ring, 0, (position - start) - (ringSize - offset));
+		}
+		RTR_ATOMIC_SET(trace->consumed, (rtr_atomic_val)position);
+	}
+
+	if ((dropped = RTR_ATOMIC_SET_RETOLD(trace->dropped, 0)) != 0)
+	{
+		RsslBinaryTraceRecord record;
+
+		memset(&record, 0, sizeof(record));
+		record.recordLength = sizeof(record);
+		record.event = RSSL_BTRC_DROPPED;
+		record.retCode = (RsslInt32)dropped;
+		record.time = rsslBinaryTraceTime();
+		rsslBinaryTraceWriteRecord(trace, &record, sizeof(record));
+	}
+
+	if (trace->file && (position != start || dropped))
+		fflush(trace->file);
+
+	return position - start;
+}
+
+/* Drains the trace and closes its file */
+static void rsslBinaryTraceCloseFile(rsslBinaryTrace *trace)
+{
+	(void) RSSL_MUTEX_LOCK(&trace->fileMutex);
+	(void)rsslBinaryTraceDrain(trace);
+	if (trace->file)
+	{
+		fclose(trace->file);
+		trace->file = NULL;
+	}
+	(void) RSSL_MUTEX_UNLOCK(&trace->fileMutex);
+}
+
+static void rsslBinaryTraceFree(rsslBinaryTrace *trace)
+{
+	if (trace->file)
+		fclose(trace->file);
+	if (trace->fileName)
+		_rsslFree(trace->fileName);
+	if (trace->ring)
+		_rsslFree(trace->ring);
+	(void) RSSL_MUTEX_DESTROY(&trace->fileMutex);
+	_rsslFree(trace);
+}
+
+/* Whether any trace has a committed record or a drop to write.  Called with binaryTraceMutex held. */
+static RsslBool rsslBinaryTracePending()
+{
+	RsslQueueLink *pLink;
+
+	RSSL_QUEUE_FOR_EACH_LINK(&binaryTraceList, pLink)
+	{
+		rsslBinaryTrace *trace = RSSL_QUEUE_LINK_TO_OBJECT(rsslBinaryTrace, link, pLink);
+
+		if (*(volatile RsslUInt32*)(trace->ring + ((RsslUInt32)trace->consumed & trace->ringMask)) != 0 || trace->dropped != 0)
+			return RSSL_TRUE;
+	}
+	return RSSL_FALSE;
+}
+
+/* Drains every open trace until told to stop.  Each trace is drained holding only its own
+ * fileMutex, so writing a file holds up neither other traces nor channels opening or closing
+ * theirs.  A pass that wrote nothing waits until a producer commits a record. */
+static RSSL_THREAD_DECLARE(rsslBinaryTraceThread, pArg)
+{
+	RsslQueueLink *pLink;
+	rsslBinaryTrace *trace;
+	RsslUInt32 consumed = 0;
+
+	(void) RSSL_MUTEX_LOCK(&binaryTraceMutex);
+	while (!binaryTraceThreadStop)
+	{
+		/* the list may change while a file is written, so look for the next trace from the start */
+		trace = NULL;
+		RSSL_QUEUE_FOR_EACH_LINK(&binaryTraceList, pLink)
+		{
+			rsslBinaryTrace *listTrace = RSSL_QUEUE_LINK_TO_OBJECT(rsslBinaryTrace, link, pLink);
+
+			if (listTrace->pass != binaryTracePass)
+			{
+				trace = listTrace;
+				break;
+			}
+		}
+
+		if (trace != NULL)
+		{
+			/* taking fileMutex before letting go of the list keeps the trace from being freed */
+			trace->pass = binaryTracePass;
+			(void) RSSL_MUTEX_LOCK(&trace->fileMutex);
+			(void) RSSL_MUTEX_UNLOCK(&binaryTraceMutex);
+			consumed += rsslBinaryTraceDrain(trace);
+			(void) RSSL_MUTEX_UNLOCK(&trace->fileMutex);
+			(void) RSSL_MUTEX_LOCK(&binaryTraceMutex);
+			continue;
+		}
+
+		if (consumed == 0)
+		{
+			/* producers commit before checking binaryTraceIdle, and this checks for records after
+			 * setting it, so a record committed now either is seen here or wakes the thread */
+			RTR_ATOMIC_SET(binaryTraceIdle, 1);
+			if (!rsslBinaryTracePending() && !binaryTraceThreadStop)
+				RSSL_BINARY_TRACE_COND_WAIT(&binaryTraceWake, &binaryTraceMutex);
+			RTR_ATOMIC_SET(binaryTraceIdle, 0);
+		}
+		consumed = 0;
+		binaryTracePass++;
+	}
+	(void) RSSL_MUTEX_UNLOCK(&binaryTraceMutex);
+
+	return RSSL_THREAD_RETURN();
+}
+
+void _rsslBinaryTraceInitialize()
+{
+	(void) RSSL_MUTEX_INIT_ESDK(&binaryTraceMutex);
+	RSSL_BINARY_TRACE_COND_INIT(&binaryTraceWake);
+	rsslInitQueue(&binaryTraceList);
+	binaryTraceThreadStarted = RSSL_FALSE;
+	binaryTraceThreadStop = RSSL_FALSE;
+	binaryTraceIdle = 0;
+}
+
+void _rsslBinaryTraceUninitialize()
+{
+	RsslQueueLink *pLink;
+
+	if (binaryTraceThreadStarted)
+	{
+		(void) RSSL_MUTEX_LOCK(&binaryTraceMutex);
+		binaryTraceThreadStop = RSSL_TRUE;
+		RSSL_BINARY_TRACE_COND_SIGNAL(&binaryTraceWake);
+		(void) RSSL_MUTEX_UNLOCK(&binaryTraceMutex);
+
+		RSSL_THREAD_JOIN(binaryTraceThreadId);
+		binaryTraceThreadStarted = RSSL_FALSE;
+		binaryTraceThreadStop = RSSL_FALSE;
+	}
+
+	/* channels left open keep tracing until here */
+	while ((pLink = rsslQueueRemoveFirstLink(&binaryTraceList)) != NULL)
+	{
+		rsslBinaryTrace *trace = RSSL_QUEUE_LINK_TO_OBJECT(rsslBinaryTrace, link, pLink);
+
+		(void)rsslBinaryTraceDrain(trace);
+		rsslBinaryTraceFree(trace);
+	}
+
+	RSSL_BINARY_TRACE_COND_DESTROY(&binaryTraceWake);
+	(void) RSSL_MUTEX_DESTROY(&binaryTraceMutex);
+}
+
+RsslRet _rsslBinaryTraceStart(rsslBinaryTrace *trace, RsslChannel *chnl, RsslTraceOptions *traceOptions, RsslError *error)
+{
+	size_t nameLength;
+	char *fileName;
+
+	if (trace->recording)
+		return RSSL_RET_SUCCESS;
+
+	if (traceOptions->traceMsgFileName == NULL)
+	{
+		_rsslSetError(error, chnl, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctl() Error: RSSL_TRACE_BINARY requires traceMsgFileName.\n", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+
+	nameLength = strlen(traceOptions->traceMsgFileName);
+	if ((fileName = (char*)_rsslMalloc(nameLength + 1)) == NULL)
+	{
+		_rsslSetError(error, chnl, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctl() Error: Unable to create memory for the binary trace.\n", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+	memcpy(fileName, traceOptions->traceMsgFileName, nameLength + 1);
+
+	/* the writer thread may be draining the records kept since the trace was stopped */
+	(void) RSSL_MUTEX_LOCK(&trace->fileMutex);
+	if (trace->fileName)
+		_rsslFree(trace->fileName);
+	trace->fileName = fileName;
+	trace->maxFileSize = traceOptions->traceMsgMaxFileSize;
+	trace->multipleFiles = (traceOptions->traceFlags & RSSL_TRACE_TO_MULTIPLE_FILES) ? RSSL_TRUE : RSSL_FALSE;
+	trace->fileHeader.majorVersion = chnl->majorVersion;
+	trace->fileHeader.minorVersion = chnl->minorVersion;
+	if (rsslBinaryTraceOpenFile(trace) != RSSL_RET_SUCCESS)
+	{
+		(void) RSSL_MUTEX_UNLOCK(&trace->fileMutex);
+		_rsslSetError(error, chnl, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctl() Error: Unable to open file. fopen() failed\n", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+	(void) RSSL_MUTEX_UNLOCK(&trace->fileMutex);
+
+	trace->recording = RSSL_TRUE;
+	return RSSL_RET_SUCCESS;
+}
+
+rsslBinaryTrace *_rsslBinaryTraceOpen(RsslChannel *chnl, RsslTraceOptions *traceOptions, RsslError *error)
+{
+	rsslBinaryTrace *trace;
+
+	if ((trace = (rsslBinaryTrace*)_rsslMalloc(sizeof(rsslBinaryTrace))) == NULL)
+	{
+		_rsslSetError(error, chnl, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctl() Error: Unable to create memory for the binary trace.\n", __FILE__, __LINE__);
+		return NULL;
+	}
+	memset(trace, 0, sizeof(rsslBinaryTrace));
+	(void) RSSL_MUTEX_INIT_ESDK(&trace->fileMutex);
+
+	if ((trace->ring = (char*)_rsslMalloc(RSSL_BINARY_TRACE_RING_SIZE)) == NULL)
+	{
+		rsslBinaryTraceFree(trace);
+		_rsslSetError(error, chnl, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctl() Error: Unable to create memory for the binary trace.\n", __FILE__, __LINE__);
+		return NULL;
+	}
+	memset(trace->ring, 0, RSSL_BINARY_TRACE_RING_SIZE);
+
+	trace->ringMask = RSSL_BINARY_TRACE_RING_SIZE - 1;
+	/* a longer message is cut, so one record cannot hold the buffer for long */
+	trace->maxDataLength = RSSL_BINARY_TRACE_RING_SIZE / 4;
+
+	memcpy(trace->fileHeader.magic, RSSL_BINARY_TRACE_MAGIC, sizeof(trace->fileHeader.magic));
+	trace->fileHeader.byteOrder = RSSL_BINARY_TRACE_BYTE_ORDER;
+	trace->fileHeader.formatVersion = RSSL_BINARY_TRACE_VERSION;
+	trace->fileHeader.protocolType = chnl->protocolType;
+
+	if (_rsslBinaryTraceStart(trace, chnl, traceOptions, error) != RSSL_RET_SUCCESS)
+	{
+		rsslBinaryTraceFree(trace);
+		return NULL;
+	}
+
+	(void) RSSL_MUTEX_LOCK(&binaryTraceMutex);
+	if (!binaryTraceThreadStarted)
+	{
+		if (RSSL_THREAD_START(&binaryTraceThreadId, rsslBinaryTraceThread, NULL) != 0)
+		{
+			(void) RSSL_MUTEX_UNLOCK(&binaryTraceMutex);
+			rsslBinaryTraceFree(trace);
+			_rsslSetError(error, chnl, RSSL_RET_FAILURE, errno);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctl() Error: Unable to start the binary trace thread.\n", __FILE__, __LINE__);
+			return NULL;
+		}
+		binaryTraceThreadStarted = RSSL_TRUE;
+	}
+	trace->pass = binaryTracePass;
+	rsslQueueAddLinkToBack(&binaryTraceList, &trace->link);
+	(void) RSSL_MUTEX_UNLOCK(&binaryTraceMutex);
+
+	return trace;
+}
+
+void _rsslBinaryTraceStop(rsslBinaryTrace *trace)
+{
+	/* a record begun before this is seen is still written, by the writer thread or a later file */
+	trace->recording = RSSL_FALSE;
+	rsslBinaryTraceCloseFile(trace);
+}
+
+void _rsslBinaryTraceClose(rsslBinaryTrace *trace)
+{
+	/* once off the list the writer thread no longer looks at it, and once its fileMutex is free
+	 * the writer thread is done with it */
+	(void) RSSL_MUTEX_LOCK(&binaryTraceMutex);
+	rsslQueueRemoveLink(&binaryTraceList, &trace->link);
+	(void) RSSL_MUTEX_UNLOCK(&binaryTraceMutex);
+
+	trace->recording = RSSL_FALSE;
+	rsslBinaryTraceCloseFile(trace);
+	rsslBinaryTraceFree(trace);
+}
+
+void _rsslBinaryTraceRecord(rsslBinaryTrace *trace, RsslUInt16 event, RsslSocket channelId, const char *data, RsslUInt32 dataLength, RsslInt32 retCode)
+{
+	RsslUInt32 ringSize = trace->ringMask + 1;
+	RsslUInt32 keptLength = (dataLength <= trace->maxDataLength) ? dataLength : trace->maxDataLength;
+	RsslUInt32 recordLength = (RsslUInt32)((sizeof(RsslBinaryTraceRecord) + keptLength + 7) & ~(size_t)7);
+	RsslUInt32 position, offset, padLength;
+	RsslBinaryTraceRecord *record;
+
+	if (!trace->recording)
+		return;
+
+	/* claim the space, with a pad in front if the record would run past the end of the buffer */
+	do
+	{
+		position = (RsslUInt32)trace->reserved;
+		offset = position & trace->ringMask;
+		padLength = (offset + recordLength > ringSize) ? ringSize - offset : 0;
+
+		if (position + padLength + recordLength - (RsslUInt32)trace->consumed > ringSize)
+		{
+			RTR_ATOMIC_INCREMENT(trace->dropped);
+			return;
+		}
+	} while ((RsslUInt32)RTR_ATOMIC_COMPARE_AND_SWAP(trace->reserved, (rtr_atomic_val)position, (rtr_atomic_val)(position + padLength + recordLength)) != position);
+
+	if (padLength)
+	{
+		RTR_ATOMIC_SET(*(rtr_atomic_val*)(trace->ring + offset), (rtr_atomic_val)(padLength | RSSL_BINARY_TRACE_PAD));
+		offset = 0;
+	}
+
+	record = (RsslBinaryTraceRecord*)(trace->ring + offset);
+	record->event = event;
+	record->flags = (keptLength < dataLength) ? RSSL_BTRC_FL_TRUNCATED : RSSL_BTRC_FL_NONE;
+	record->dataLength = dataLength;
+	record->retCode = retCode;
+	record->time = rsslBinaryTraceTime();
+	record->channelId = (RsslUInt64)channelId;
+	if (keptLength)
+		memcpy(record + 1, data, keptLength);
+
+	/* setting the length commits the record to the writer thread */
+	RTR_ATOMIC_SET(*(rtr_atomic_val*)&record->recordLength, (rtr_atomic_val)recordLength);
+
+	/* only the first record after the writer thread runs out of work wakes it */
+	if (rtrUnlikely(binaryTraceIdle != 0) && RTR_ATOMIC_SET_RETOLD(binaryTraceIdle, 0) != 0)
+	{
+		(void) RSSL_MUTEX_LOCK(&binaryTraceMutex);
+		RSSL_BINARY_TRACE_COND_SIGNAL(&binaryTraceWake);
+		(void) RSSL_MUTEX_UNLOCK(&binaryTraceMutex);
+	}
+}
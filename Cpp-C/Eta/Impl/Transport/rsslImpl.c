@@ -38,6 +38,7 @@
 
 /* Include other transport type headers */
 #include "rtr/rsslChanManagement.h"
+#include "rtr/rsslBinaryTraceImpl.h"
 #include "rtr/rsslSeqMcastTransportImpl.h"
 #include "rtr/rsslSocketTransportImpl.h"
 #include "rtr/rsslUniShMemTransportImpl.h"
@@ -303,10 +304,7 @@ void RTR_FASTCALL _rsslReleaseChannel(rsslChannelImpl *chnl)
 				rsslAssemblyBuf = RSSL_QUEUE_LINK_TO_OBJECT(rsslAssemblyBuffer, link1, pLink);
 
 				if (rsslAssemblyBuf->buffer.data)
-				{
-					_rsslFree(rsslAssemblyBuf->buffer.data);
-					rsslAssemblyBuf->buffer.data = 0;
-				}
+					_rsslFreeAssemblyBufferData(chnl, rsslAssemblyBuf);
 
 				rsslHashTableRemoveLink(&chnl->assemblyBuffers, &rsslAssemblyBuf->link1);
 
@@ -653,6 +651,45 @@ void _rsslTraceClosed(rsslChannelImpl *rsslChnlImpl, RsslRet *retTrace)
 		(void) RSSL_MUTEX_UNLOCK(&rsslChnlImpl->traceMutex);
 	}
 }
+
+/* The binary trace counterparts of the functions above: they only copy the message, with what
+ * the XML trace would have said about it, into the channel's trace buffer */
+RTR_C_ALWAYS_INLINE void _rsslBinaryTraceMsg(rsslChannelImpl *rsslChnlImpl, RsslUInt16 event, RsslBuffer *buffer)
+{
+	_rsslBinaryTraceRecord(rsslChnlImpl->traceOptionsInfo.binaryTrace, event, rsslChnlImpl->Channel.socketId, buffer->data, buffer->length, 0);
+}
+
+void _rsslBinaryTraceClosed(rsslChannelImpl *rsslChnlImpl, RsslRet retTrace)
+{
+	if (retTrace == RSSL_RET_FAILURE && rsslChnlImpl->Channel.state == RSSL_CH_STATE_CLOSED)
+		_rsslBinaryTraceRecord(rsslChnlImpl->traceOptionsInfo.binaryTrace, RSSL_BTRC_CHANNEL_CLOSED, rsslChnlImpl->Channel.socketId, NULL, 0, retTrace);
+}
+
+void _rsslBinaryTraceRead(rsslChannelImpl *rsslChnlImpl, RsslBuffer *buffer, RsslRet retTrace)
+{
+	RsslUInt64 traceFlags = rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags;
+
+	if (buffer != NULL)
+	{
+		if (traceFlags & RSSL_TRACE_READ)
+			_rsslBinaryTraceMsg(rsslChnlImpl, RSSL_BTRC_READ, buffer);
+	}
+	else if (retTrace == RSSL_RET_READ_PING)
+	{
+		if ((traceFlags & (RSSL_TRACE_READ | RSSL_TRACE_PING)) == (RSSL_TRACE_READ | RSSL_TRACE_PING))
+			_rsslBinaryTraceRecord(rsslChnlImpl->traceOptionsInfo.binaryTrace, RSSL_BTRC_READ_PING, rsslChnlImpl->Channel.socketId, NULL, 0, 0);
+	}
+	else
+		_rsslBinaryTraceClosed(rsslChnlImpl, retTrace);
+}
+
+/* Follows a traced write with its result, when it did not succeed */
+void _rsslBinaryTraceWriteResult(rsslChannelImpl *rsslChnlImpl, RsslRet retTrace)
+{
+	if (rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & RSSL_TRACE_WRITE)
+		_rsslBinaryTraceRecord(rsslChnlImpl->traceOptionsInfo.binaryTrace, RSSL_BTRC_WRITE_RESULT, rsslChnlImpl->Channel.socketId, NULL, 0, retTrace);
+	_rsslBinaryTraceClosed(rsslChnlImpl, retTrace);
+}
 	
 
 /***********************
@@ -755,6 +792,8 @@ RsslRet rsslInitializeEx(RsslInitializeExOpts *rsslInitOpts, RsslError *error)
 		rsslInitQueue(&freeServerList);
 		rsslInitQueue(&activeServerList);
 		rsslInitQueue(&activeChannelList);
+
+		_rsslBinaryTraceInitialize();
 	
 		/* preallocate memory for channels - this should
 		speed up performance when requesting a channel */
@@ -1291,6 +1330,9 @@ RsslRet rsslInitChannel(RsslChannel *chnl, RsslInProgInfo *inProg, RsslError *er
 		(void) RSSL_MUTEX_LOCK(&rsslChnlImpl->traceMutex);
 		_rsslXMLDumpComment(rsslChnlImpl, message, RSSL_TRUE, RSSL_TRUE);
 		(void) RSSL_MUTEX_UNLOCK(&rsslChnlImpl->traceMutex);
+
+		if (rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL)
+			_rsslBinaryTraceRecord(rsslChnlImpl->traceOptionsInfo.binaryTrace, RSSL_BTRC_CONNECTED, rsslChnlImpl->Channel.socketId, NULL, 0, 0);
 	}
 
 	return ret;
@@ -1323,6 +1365,9 @@ RsslRet rsslCloseChannel(RsslChannel *chnl, RsslError *error)
 		(void) RSSL_MUTEX_LOCK(&rsslChnlImpl->traceMutex);
 		_rsslXMLDumpComment(rsslChnlImpl, message, RSSL_TRUE, RSSL_TRUE);
 		(void) RSSL_MUTEX_UNLOCK(&rsslChnlImpl->traceMutex);
+
+		if (rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL)
+			_rsslBinaryTraceRecord(rsslChnlImpl->traceOptionsInfo.binaryTrace, RSSL_BTRC_CLOSE_CHANNEL, rsslChnlImpl->Channel.socketId, NULL, 0, 0);
 	}
 
 	/* release active buffers before closing the channel and removing the channels pool */
@@ -1345,6 +1390,11 @@ RsslRet rsslCloseChannel(RsslChannel *chnl, RsslError *error)
 		free(rsslChnlImpl->traceOptionsInfo.newTraceMsgFileName);
 		rsslChnlImpl->traceOptionsInfo.newTraceMsgFileName = NULL;
 	}
+	if(rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL)
+	{
+		_rsslBinaryTraceClose(rsslChnlImpl->traceOptionsInfo.binaryTrace);
+		rsslChnlImpl->traceOptionsInfo.binaryTrace = NULL;
+	}
 
 	rsslClearTraceOptionsInfo(&(rsslChnlImpl->traceOptionsInfo));
 
@@ -1420,6 +1470,22 @@ RsslRet rsslIoctl(RsslChannel *chnl, RsslIoctlCodes code, void *value, RsslError
 					return RSSL_RET_FAILURE;
 				}
 
+				/* the binary trace is separate from the XML one, and keeps its file until it is turned off.
+				 * Threads reading or writing the channel may be recording into it without a lock, so
+				 * turning it off only stops it; it is freed when the channel closes. */
+				if (((RsslTraceOptions *)value)->traceFlags & RSSL_TRACE_BINARY)
+				{
+					if (rsslChnlImpl->traceOptionsInfo.binaryTrace == NULL)
+					{
+						if ((rsslChnlImpl->traceOptionsInfo.binaryTrace = _rsslBinaryTraceOpen(chnl, (RsslTraceOptions *)value, error)) == NULL)
+							return RSSL_RET_FAILURE;
+					}
+					else if (_rsslBinaryTraceStart(rsslChnlImpl->traceOptionsInfo.binaryTrace, chnl, (RsslTraceOptions *)value, error) != RSSL_RET_SUCCESS)
+						return RSSL_RET_FAILURE;
+				}
+				else if (rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL)
+					_rsslBinaryTraceStop(rsslChnlImpl->traceOptionsInfo.binaryTrace);
+
 				rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags = ((RsslTraceOptions *)value)->traceFlags;
 				rsslChnlImpl->traceOptionsInfo.traceOptions.traceMsgMaxFileSize = ((RsslTraceOptions *)value)->traceMsgMaxFileSize;
 
@@ -1593,6 +1659,9 @@ RSSL_API RsslBuffer* rsslReadEx(RsslChannel *chnl, RsslReadInArgs *readInArgs, R
 
 	retBuf = (*(rsslChnlImpl->channelFuncs->channelRead))(rsslChnlImpl, readOutArgs, readRet, error);
 
+	if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL))
+		_rsslBinaryTraceRead(rsslChnlImpl, retBuf, *readRet);
+
 	if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_TO_FILE_ENABLE | RSSL_TRACE_TO_STDOUT)))
 	{
 		if ((retBuf != NULL) && (rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & RSSL_TRACE_READ))
@@ -1695,6 +1764,9 @@ RsslRet rsslWrite(RsslChannel *chnl, RsslBuffer *buffer, RsslWritePriorities rss
 		if (rtrUnlikely((rsslChnlImpl->debugFlags & RSSL_DEBUG_RSSL_DUMP_OUT) && (buffer->length > 0)))
 		  (*(rsslDumpOutFunc))((char*)__FUNCTION__, buffer->data, buffer->length, chnl->socketId);
 
+		if (rtrUnlikely((rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL) && (rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & RSSL_TRACE_WRITE)))
+			_rsslBinaryTraceMsg(rsslChnlImpl, RSSL_BTRC_WRITE, buffer);
+
 		if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_TO_FILE_ENABLE | RSSL_TRACE_TO_STDOUT)))
 		{
 			ret = RSSL_RET_SUCCESS;
@@ -1713,6 +1785,8 @@ RsslRet rsslWrite(RsslChannel *chnl, RsslBuffer *buffer, RsslWritePriorities rss
 		{
 			ret = (*(rsslChnlImpl->channelFuncs->channelWrite))(rsslChnlImpl, rsslBufImpl, &writeInArgs, &writeOutArgs, error);
 		}
+		if (rtrUnlikely((rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL) && (ret < RSSL_RET_SUCCESS)))
+			_rsslBinaryTraceWriteResult(rsslChnlImpl, ret);
 		*bytesWritten = writeOutArgs.bytesWritten;
 		*uncompressedBytesWritten = writeOutArgs.uncompressedBytesWritten;
 		return ret;
@@ -1800,6 +1874,19 @@ RsslRet rsslWriteEx(RsslChannel *chnl, RsslBuffer *buffer, RsslWriteInArgs *writ
 		if (rtrUnlikely((rsslChnlImpl->debugFlags & RSSL_DEBUG_RSSL_DUMP_OUT) && (buffer->length > 0)))
 		        (*(rsslDumpOutFunc))((char*)__FUNCTION__, buffer->data, buffer->length, chnl->socketId);
 
+		if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL))
+		{
+			if (rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & RSSL_TRACE_WRITE)
+				_rsslBinaryTraceMsg(rsslChnlImpl, RSSL_BTRC_WRITE, buffer);
+			if (!(rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_TO_FILE_ENABLE | RSSL_TRACE_TO_STDOUT)))
+			{
+				ret = (*(rsslChnlImpl->channelFuncs->channelWrite))(rsslChnlImpl, rsslBufImpl, writeInArgs, writeOutArgs, error);
+				if (ret < RSSL_RET_SUCCESS)
+					_rsslBinaryTraceWriteResult(rsslChnlImpl, ret);
+				return ret;
+			}
+		}
+
 		if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_TO_FILE_ENABLE | RSSL_TRACE_TO_STDOUT)))
 		{
 			ret = RSSL_RET_SUCCESS;
@@ -1813,6 +1900,8 @@ RsslRet rsslWriteEx(RsslChannel *chnl, RsslBuffer *buffer, RsslWriteInArgs *writ
 				_rsslTraceEndMsg(rsslChnlImpl, &ret, RSSL_FALSE);
 			}
 			_rsslTraceClosed(rsslChnlImpl, &ret);
+			if ((rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL) && (ret < RSSL_RET_SUCCESS))
+				_rsslBinaryTraceWriteResult(rsslChnlImpl, ret);
 			return ret;
 		}
 		else
@@ -1831,6 +1920,200 @@ RsslRet rsslWriteEx(RsslChannel *chnl, RsslBuffer *buffer, RsslWriteInArgs *writ
 	}
 }
 
+/* Writes a copy of msg to a channel, as rsslGetBuffer() and rsslWriteEx() would */
+RsslRet _rsslWriteCopy(rsslChannelImpl *rsslChnlImpl, RsslBuffer *msg, RsslWriteInArgs *writeInArgs, RsslWriteOutArgs *writeOutArgs, RsslError *error)
+{
+	RsslChannel *chnl = &rsslChnlImpl->Channel;
+	RsslBuffer *copy;
+	RsslError flushError;
+	RsslRet ret;
+
+	if ((copy = rsslGetBuffer(chnl, msg->length, RSSL_FALSE, error)) == NULL)
+		return (error->rsslErrorId < RSSL_RET_SUCCESS) ? error->rsslErrorId : RSSL_RET_FAILURE;
+
+	MemCopyByInt(copy->data, msg->data, msg->length);
+	copy->length = msg->length;
+
+	/* a message that is fragmented may need the channel flushed before all of it is written */
+	while ((ret = rsslWriteEx(chnl, copy, writeInArgs, writeOutArgs, error)) == RSSL_RET_WRITE_CALL_AGAIN)
+		(void)rsslFlush(chnl, &flushError);
+
+	if ((ret < RSSL_RET_SUCCESS) && (ret != RSSL_RET_WRITE_FLUSH_FAILED))
+		(void)rsslReleaseBuffer(copy, &flushError);
+
+	return ret;
+}
+
+/* Number of distinct shared messages rsslWriteToChannels() keeps at once */
+#define RSSL_MAX_SHARED_WRITE_MSGS 8
+
+/* Write one message to several channels */
+RSSL_API RsslRet rsslWriteToChannels(RsslChannel *chnl, RsslBuffer *buffer, RsslWriteInArgs *writeInArgs, RsslWriteTarget *targets, RsslUInt32 targetCount, RsslError *error)
+{
+	rsslChannelImpl *rsslChnlImpl = 0;
+	rsslBufferImpl *rsslBufImpl = 0;
+	rsslChannelImpl *targetImpl;
+	RsslWriteTarget *target;
+	RsslError releaseError;
+	RsslEncodeIterator encIter;
+	RsslDecodeIterator decIter;
+	RsslInt32 encodedStreamId = 0;
+	RsslInt32 bufferStreamId = 0;
+	RsslInt32 streamId;
+	RsslBool replaceStreamId = RSSL_FALSE;
+	/* framed copies of the message, by transport and stream Id, that channels share */
+	RsslTransportChannelFuncs *sharedFuncs[RSSL_MAX_SHARED_WRITE_MSGS];
+	RsslInt32 sharedStreamIds[RSSL_MAX_SHARED_WRITE_MSGS];
+	void *sharedMsgs[RSSL_MAX_SHARED_WRITE_MSGS];
+	RsslUInt32 sharedCount = 0;
+	RsslUInt32 nextShared = 0;
+	RsslUInt32 i, j;
+
+	if (rtrUnlikely(!initialized))
+	{
+		_rsslSetError(error, chnl, RSSL_RET_INIT_NOT_INITIALIZED, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslWriteToChannels() Error: 0001 RSSL not initialized.\n", __FILE__, __LINE__);
+		return RSSL_RET_INIT_NOT_INITIALIZED;
+	}
+
+	if (rtrUnlikely(RSSL_NULL_PTR(chnl, "rsslWriteToChannels", "chnl", error)))
+		return RSSL_RET_FAILURE;
+
+	if (rtrUnlikely(RSSL_NULL_PTR(buffer, "rsslWriteToChannels", "buffer", error)))
+		return RSSL_RET_FAILURE;
+
+	if (rtrUnlikely(RSSL_NULL_PTR(writeInArgs, "rsslWriteToChannels", "writeInArgs", error)))
+		return RSSL_RET_FAILURE;
+
+	if (rtrUnlikely((targetCount > 0) && RSSL_NULL_PTR(targets, "rsslWriteToChannels", "targets", error)))
+		return RSSL_RET_FAILURE;
+
+	rsslChnlImpl = (rsslChannelImpl*)chnl;
+	rsslBufImpl = (rsslBufferImpl*)buffer;
+
+	if (rtrUnlikely(rsslBufImpl->integrity != 69))
+	{
+		_rsslSetError(error, chnl, RSSL_RET_BUFFER_TOO_SMALL, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslWriteToChannels() Error: 0008 Data has overflowed the allocated buffer length or RSSL is not owner.\n", __FILE__, __LINE__);
+		return RSSL_RET_BUFFER_TOO_SMALL;
+	}
+
+	if (rtrUnlikely(rsslBufImpl->RsslChannel != rsslChnlImpl))
+	{
+		_rsslSetError(error, chnl, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslWriteToChannels() Error: 0018 Channel is not owner of buffer.\n", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (rtrUnlikely((buffer->length == 0) || (rsslBufImpl->packingOffset > 0)))
+	{
+		_rsslSetError(error, chnl, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslWriteToChannels() Error: 0009 Buffer must hold one message, not be empty or packed.\n", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (rtrUnlikely((writeInArgs->rsslPriority < RSSL_HIGH_PRIORITY) || (writeInArgs->rsslPriority > RSSL_LOW_PRIORITY)))
+	{
+		_rsslSetError(error, chnl, RSSL_RET_INVALID_ARGUMENT, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslWriteToChannels() Error: 0009 Invalid priority %d.\n", __FILE__, __LINE__, (int)writeInArgs->rsslPriority);
+		return RSSL_RET_INVALID_ARGUMENT;
+	}
+
+	for (i = 0; i < targetCount; i++)
+	{
+		if (targets[i].streamId != 0)
+			replaceStreamId = RSSL_TRUE;
+	}
+
+	if (replaceStreamId)
+	{
+		rsslClearDecodeIterator(&decIter);
+		rsslSetDecodeIteratorBuffer(&decIter, buffer);
+		rsslClearEncodeIterator(&encIter);
+		rsslSetEncodeIteratorBuffer(&encIter, buffer);
+
+		/* the message is rewritten in place, so check first that it is long enough to have a stream Id */
+		encodedStreamId = bufferStreamId = rsslExtractStreamId(&decIter);
+		if (rsslReplaceStreamId(&encIter, encodedStreamId) != RSSL_RET_SUCCESS)
+		{
+			_rsslSetError(error, chnl, RSSL_RET_INVALID_ARGUMENT, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslWriteToChannels() Error: 0009 Buffer is too short to hold a message with a stream Id.\n", __FILE__, __LINE__);
+			return RSSL_RET_INVALID_ARGUMENT;
+		}
+	}
+
+	for (i = 0; i < targetCount; i++)
+	{
+		target = &targets[i];
+		targetImpl = (rsslChannelImpl*)target->channel;
+		rsslClearWriteOutArgs(&target->writeOutArgs);
+
+		if (!targetImpl || (targetImpl->Channel.state != RSSL_CH_STATE_ACTIVE))
+		{
+			_rsslSetError(&target->error, target->channel, RSSL_RET_FAILURE, 0);
+			snprintf(target->error.text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslWriteToChannels() Error: 0007 Only Channels in RSSL_CH_STATE_ACTIVE state can write.\n", __FILE__, __LINE__);
+			target->writeRet = RSSL_RET_FAILURE;
+			continue;
+		}
+
+		if (replaceStreamId)
+		{
+			streamId = target->streamId ? target->streamId : encodedStreamId;
+			if (streamId != bufferStreamId)
+			{
+				(void)rsslReplaceStreamId(&encIter, streamId);
+				bufferStreamId = streamId;
+			}
+		}
+		else
+			streamId = 0;
+
+		/* traced and dumped writes are copied, to go through rsslWriteEx() */
+		if (targetImpl->channelFuncs->channelWriteShared &&
+			!(targetImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_TO_FILE_ENABLE | RSSL_TRACE_TO_STDOUT)) &&
+			!(targetImpl->traceOptionsInfo.traceOptions.traceFlags & RSSL_TRACE_BINARY) &&
+			!(targetImpl->debugFlags & RSSL_DEBUG_RSSL_DUMP_OUT))
+		{
+			for (j = 0; j < sharedCount; j++)
+			{
+				if ((sharedFuncs[j] == targetImpl->channelFuncs) && (sharedStreamIds[j] == streamId))
+					break;
+			}
+
+			if (j == sharedCount)
+			{
+				/* once full, the oldest copy gives way; channels that queued it keep their references */
+				if (sharedCount < RSSL_MAX_SHARED_WRITE_MSGS)
+					sharedCount++;
+				else
+				{
+					j = nextShared;
+					nextShared = (nextShared + 1) % RSSL_MAX_SHARED_WRITE_MSGS;
+					if (sharedMsgs[j])
+						(*(sharedFuncs[j]->releaseSharedMsg))(sharedMsgs[j]);
+				}
+				sharedFuncs[j] = targetImpl->channelFuncs;
+				sharedStreamIds[j] = streamId;
+				sharedMsgs[j] = 0;
+			}
+
+			target->writeRet = (*(targetImpl->channelFuncs->channelWriteShared))(targetImpl, buffer, &sharedMsgs[j], writeInArgs, &target->writeOutArgs, &target->error);
+		}
+		else
+			target->writeRet = _rsslWriteCopy(targetImpl, buffer, writeInArgs, &target->writeOutArgs, &target->error);
+	}
+
+	for (j = 0; j < sharedCount; j++)
+	{
+		if (sharedMsgs[j])
+			(*(sharedFuncs[j]->releaseSharedMsg))(sharedMsgs[j]);
+	}
+
+	(void)rsslReleaseBuffer(buffer, &releaseError);
+
+	return RSSL_RET_SUCCESS;
+}
+
 /* Flush socket */
 RSSL_API RsslRet rsslFlush(RsslChannel *chnl, RsslError *error)
 {
@@ -1886,6 +2169,10 @@ RSSL_API RsslRet rsslPing(RsslChannel *chnl, RsslError *error)
 
 	rsslChnlImpl = (rsslChannelImpl*)chnl;
 
+	if (rtrUnlikely((rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL) &&
+		((rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_WRITE | RSSL_TRACE_PING)) == (RSSL_TRACE_WRITE | RSSL_TRACE_PING))))
+		_rsslBinaryTraceRecord(rsslChnlImpl->traceOptionsInfo.binaryTrace, RSSL_BTRC_WRITE_PING, rsslChnlImpl->Channel.socketId, NULL, 0, 0);
+
 	if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_TO_FILE_ENABLE | RSSL_TRACE_TO_STDOUT)))
 	{
 		if(rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & RSSL_TRACE_WRITE)
@@ -2039,6 +2326,7 @@ RsslRet rsslUninitialize()
 	if ((numInitCalls == 0) && initialized)
 	{
 		RTR_ATOMIC_SET(initialized,0);
+		_rsslBinaryTraceUninitialize();
 		_rsslCleanUp();
 		rsslUnloadTransport();
 		multiThread = 0;
@@ -2109,6 +2397,9 @@ RSSL_API RsslBuffer* rsslPackBuffer(RsslChannel *chnl, RsslBuffer *buffer,  Rssl
 	if (rtrUnlikely(rsslChnlImpl->debugFlags & RSSL_DEBUG_RSSL_DUMP_OUT))
 	        (*(rsslDumpOutFunc))((char*)__FUNCTION__, buffer->data, buffer->length, chnl->socketId);
 
+	if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.binaryTrace != NULL))
+		_rsslBinaryTraceMsg(rsslChnlImpl, RSSL_BTRC_PACK, buffer);
+
 	if (rtrUnlikely(rsslChnlImpl->traceOptionsInfo.traceOptions.traceFlags & (RSSL_TRACE_TO_FILE_ENABLE | RSSL_TRACE_TO_STDOUT)))
 	{
 		RsslBuffer *retBuffer;
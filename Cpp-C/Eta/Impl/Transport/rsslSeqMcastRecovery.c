@@ -0,0 +1,985 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#include "rtr/rsslSeqMcastRecovery.h"
+#include "rtr/rsslSeqMcastTransport.h"
+#include "rtr/ripch.h"
+#include "rtr/rsslChanManagement.h"
+#include "rtr/rsslAlloc.h"
+#include "rtr/rsslErrors.h"
+
+#if !defined(_WIN32)
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+/* Offsets into the Sequence Multicast header, see rsslSeqMcastWriteHdr() */
+#define SEQ_MCAST_FLAGS_POS			1
+#define SEQ_MCAST_INSTANCE_ID_POS	4
+#define SEQ_MCAST_SEQ_NUM_POS		8
+
+RTR_C_ALWAYS_INLINE RsslUInt16 seqMcastGet16(const char *p)
+{
+	return (RsslUInt16)(((RsslUInt8)p[0] << 8) | (RsslUInt8)p[1]);
+}
+
+RTR_C_ALWAYS_INLINE RsslUInt32 seqMcastGet32(const char *p)
+{
+	return ((RsslUInt32)seqMcastGet16(p) << 16) | seqMcastGet16(p + 2);
+}
+
+RTR_C_ALWAYS_INLINE void seqMcastPut16(char *p, RsslUInt16 value)
+{
+	p[0] = (char)(value >> 8);
+	p[1] = (char)value;
+}
+
+RTR_C_ALWAYS_INLINE void seqMcastPut32(char *p, RsslUInt32 value)
+{
+	seqMcastPut16(p, (RsslUInt16)(value >> 16));
+	seqMcastPut16(p + 2, (RsslUInt16)value);
+}
+
+static RsslInt64 seqMcastTimeMsec()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (RsslInt64)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Sequence number 0 is reserved for resets, so the writer skips it when wrapping */
+RTR_C_ALWAYS_INLINE RsslUInt32 seqMcastSeqNext(RsslUInt32 seqNum)
+{
+	return (++seqNum == 0) ? 1 : seqNum;
+}
+
+RTR_C_ALWAYS_INLINE seqMcastSlot *seqMcastGetSlot(seqMcastRecovery *pRecovery, seqMcastStream *pStream, RsslUInt32 seqNum)
+{
+	return &pStream->slots[seqNum % pRecovery->capacity];
+}
+
+static void seqMcastAddReady(seqMcastRecovery *pRecovery, seqMcastPkt *pPkt)
+{
+	pPkt->next = 0;
+	if (pRecovery->readyTail)
+		pRecovery->readyTail->next = pPkt;
+	else
+		pRecovery->readyHead = pPkt;
+	pRecovery->readyTail = pPkt;
+}
+
+static void seqMcastFreePktList(seqMcastPkt *pPkt)
+{
+	seqMcastPkt *pNext;
+
+	while (pPkt)
+	{
+		pNext = pPkt->next;
+		_rsslFree(pPkt);
+		pPkt = pNext;
+	}
+}
+
+seqMcastRecovery *rsslSeqMcastRecoveryCreate(RsslUInt32 reorderWindow, RsslUInt32 retransTimeout, RsslBool retrans, RsslUInt32 maxPktLen, RsslError *error)
+{
+	seqMcastRecovery *pRecovery;
+
+	if (!(pRecovery = (seqMcastRecovery*)_rsslMalloc(sizeof(seqMcastRecovery))))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 0005 Failed to allocate the sequenced multicast recovery structure.\n", __FILE__, __LINE__);
+		return NULL;
+	}
+	memset(pRecovery, 0, sizeof(seqMcastRecovery));
+
+	/* Keep the slot arrays bounded; requests carry a 16 bit count */
+	if (reorderWindow > 0xFFFF - SEQ_MCAST_RETRANS_HOLD - 1)
+		reorderWindow = 0xFFFF - SEQ_MCAST_RETRANS_HOLD - 1;
+
+	pRecovery->reorderWindow = reorderWindow;
+	pRecovery->retransTimeout = retransTimeout;
+	pRecovery->retrans = retrans;
+	pRecovery->capacity = reorderWindow + 1 + (retrans ? SEQ_MCAST_RETRANS_HOLD : 0);
+	pRecovery->maxPktLen = maxPktLen;
+	pRecovery->retransSock = RIPC_INVALID_SOCKET;
+	pRecovery->epollFd = RIPC_INVALID_SOCKET;
+	pRecovery->timerFd = RIPC_INVALID_SOCKET;
+
+	return pRecovery;
+}
+
+void rsslSeqMcastRecoveryDestroy(seqMcastRecovery *pRecovery)
+{
+	RsslUInt32 i, j;
+
+	for (i = 0; i < pRecovery->numStreams; i++)
+	{
+		for (j = 0; j < pRecovery->capacity; j++)
+		{
+			if (pRecovery->streams[i].slots[j].pkt)
+				_rsslFree(pRecovery->streams[i].slots[j].pkt);
+		}
+		_rsslFree(pRecovery->streams[i].slots);
+	}
+	if (pRecovery->streams)
+		_rsslFree(pRecovery->streams);
+
+	seqMcastFreePktList(pRecovery->freePkts);
+	seqMcastFreePktList(pRecovery->readyHead);
+	if (pRecovery->current)
+		_rsslFree(pRecovery->current);
+
+	if (pRecovery->retransSock != RIPC_INVALID_SOCKET)
+		close(pRecovery->retransSock);
+	if (pRecovery->timerFd != RIPC_INVALID_SOCKET)
+		close(pRecovery->timerFd);
+	if (pRecovery->epollFd != RIPC_INVALID_SOCKET)
+		close(pRecovery->epollFd);
+	if (pRecovery->retransIn)
+		_rsslFree(pRecovery->retransIn);
+
+	_rsslFree(pRecovery);
+}
+
+seqMcastPkt *rsslSeqMcastRecoveryGetPkt(seqMcastRecovery *pRecovery)
+{
+	seqMcastPkt *pPkt;
+
+	if ((pPkt = pRecovery->freePkts) != 0)
+	{
+		pRecovery->freePkts = pPkt->next;
+		return pPkt;
+	}
+
+	/* Add 7 to avoid any full word byte swap issues at the end of the buffer */
+	if (!(pPkt = (seqMcastPkt*)_rsslMalloc(sizeof(seqMcastPkt) + pRecovery->maxPktLen + 7)))
+		return NULL;
+	pPkt->data = (char*)(pPkt + 1);
+	return pPkt;
+}
+
+void rsslSeqMcastRecoveryPutPkt(seqMcastRecovery *pRecovery, seqMcastPkt *pPkt)
+{
+	pPkt->next = pRecovery->freePkts;
+	pRecovery->freePkts = pPkt;
+}
+
+static seqMcastStream *seqMcastFindStream(seqMcastRecovery *pRecovery, RsslUInt32 addr, RsslUInt16 port, RsslUInt16 instanceId)
+{
+	RsslUInt32 i;
+
+	for (i = 0; i < pRecovery->numStreams; i++)
+	{
+		seqMcastStream *pStream = &pRecovery->streams[i];
+		if (pStream->addr == addr && pStream->port == port && pStream->instanceId == instanceId)
+			return pStream;
+	}
+	return NULL;
+}
+
+static seqMcastStream *seqMcastAddStream(seqMcastRecovery *pRecovery, RsslUInt32 addr, RsslUInt16 port, RsslUInt16 instanceId, RsslUInt32 nextSeqNum)
+{
+	seqMcastStream *pStreams;
+	seqMcastStream *pStream;
+
+	if (!(pStreams = (seqMcastStream*)_rsslMalloc((pRecovery->numStreams + 1) * sizeof(seqMcastStream))))
+		return NULL;
+
+	pStream = &pStreams[pRecovery->numStreams];
+	memset(pStream, 0, sizeof(seqMcastStream));
+	if (!(pStream->slots = (seqMcastSlot*)_rsslMalloc(pRecovery->capacity * sizeof(seqMcastSlot))))
+	{
+		_rsslFree(pStreams);
+		return NULL;
+	}
+	memset(pStream->slots, 0, pRecovery->capacity * sizeof(seqMcastSlot));
+
+	if (pRecovery->streams)
+	{
+		memcpy(pStreams, pRecovery->streams, pRecovery->numStreams * sizeof(seqMcastStream));
+		_rsslFree(pRecovery->streams);
+	}
+	pRecovery->streams = pStreams;
+	pRecovery->numStreams++;
+
+	pStream->addr = addr;
+	pStream->port = port;
+	pStream->instanceId = instanceId;
+	pStream->nextSeqNum = nextSeqNum;
+	pStream->highSeqNum = nextSeqNum - 1;
+	return pStream;
+}
+
+/* Delivers what is held in order up to targetSeqNum, giving up on any holes, and continues from there */
+static void seqMcastStreamSkipTo(seqMcastRecovery *pRecovery, seqMcastStream *pStream, RsslUInt32 targetSeqNum)
+{
+	RsslBool inGap = RSSL_FALSE;
+
+	while (pStream->numHeld > 0 && pStream->nextSeqNum != targetSeqNum)
+	{
+		seqMcastSlot *pSlot = seqMcastGetSlot(pRecovery, pStream, pStream->nextSeqNum);
+
+		if (pSlot->state == SEQ_MCAST_SLOT_HELD)
+		{
+			seqMcastAddReady(pRecovery, pSlot->pkt);
+			pStream->numHeld--;
+			inGap = RSSL_FALSE;
+		}
+		else if (!inGap)
+		{
+			pRecovery->gapsDetected++;
+			inGap = RSSL_TRUE;
+		}
+		pSlot->pkt = 0;
+		pSlot->state = SEQ_MCAST_SLOT_EMPTY;
+		pStream->nextSeqNum = seqMcastSeqNext(pStream->nextSeqNum);
+	}
+
+	if (pStream->nextSeqNum != targetSeqNum)
+	{
+		if (!inGap)
+			pRecovery->gapsDetected++;
+		memset(pStream->slots, 0, pRecovery->capacity * sizeof(seqMcastSlot));
+		pStream->nextSeqNum = targetSeqNum;
+	}
+
+	if ((RsslInt32)(pStream->highSeqNum - pStream->nextSeqNum) < 0)
+		pStream->highSeqNum = pStream->nextSeqNum - 1;
+	pStream->holeSince = 0;
+}
+
+static void seqMcastQueueRequest(seqMcastRecovery *pRecovery, seqMcastStream *pStream, RsslUInt32 firstSeqNum, RsslUInt32 count)
+{
+	seqMcastRetransReq *pReq;
+
+	if (!pRecovery->retrans || pRecovery->reqTail - pRecovery->reqHead == SEQ_MCAST_RETRANS_MAX_REQS)
+		return;
+
+	pReq = &pRecovery->reqs[pRecovery->reqTail % SEQ_MCAST_RETRANS_MAX_REQS];
+	pReq->addr = pStream->addr;
+	pReq->port = pStream->port;
+	pReq->instanceId = pStream->instanceId;
+	pReq->firstSeqNum = firstSeqNum;
+	pReq->count = (RsslUInt16)count;
+	pRecovery->reqTail++;
+}
+
+/* Marks the holes from the oldest unconfirmed one up to highSeqNum as lost, and requests them */
+static void seqMcastStreamConfirm(seqMcastRecovery *pRecovery, seqMcastStream *pStream, RsslInt64 now)
+{
+	RsslUInt32 seqNum = pStream->nextSeqNum;
+	RsslUInt32 runStart = 0, runCount = 0;
+	RsslInt64 deadline = now + (pRecovery->retrans ? pRecovery->retransTimeout : 0);
+
+	if (pStream->holeSince != 0 && (RsslInt32)(pStream->holeSeqNum - seqNum) > 0)
+		seqNum = pStream->holeSeqNum;
+
+	for (; (RsslInt32)(seqNum - pStream->highSeqNum) <= 0; seqNum = seqMcastSeqNext(seqNum))
+	{
+		seqMcastSlot *pSlot = seqMcastGetSlot(pRecovery, pStream, seqNum);
+
+		if (pSlot->state == SEQ_MCAST_SLOT_EMPTY)
+		{
+			pSlot->state = SEQ_MCAST_SLOT_MISSING;
+			pSlot->deadline = deadline;
+			if (runCount++ == 0)
+				runStart = seqNum;
+		}
+		else if (runCount)
+		{
+			seqMcastQueueRequest(pRecovery, pStream, runStart, runCount);
+			runCount = 0;
+		}
+	}
+	if (runCount)
+		seqMcastQueueRequest(pRecovery, pStream, runStart, runCount);
+
+	pStream->holeSince = 0;
+}
+
+/* Moves packets that can now be delivered to the ready list, skipping lost packets whose deadline has passed */
+static void seqMcastStreamDrain(seqMcastRecovery *pRecovery, seqMcastStream *pStream, RsslInt64 now)
+{
+	seqMcastSlot *pSlot;
+
+	if (pStream->holeSince != 0 && now - pStream->holeSince >= SEQ_MCAST_REORDER_WAIT)
+		seqMcastStreamConfirm(pRecovery, pStream, now);
+
+	for (;;)
+	{
+		pSlot = seqMcastGetSlot(pRecovery, pStream, pStream->nextSeqNum);
+
+		if (pSlot->state == SEQ_MCAST_SLOT_HELD)
+		{
+			seqMcastAddReady(pRecovery, pSlot->pkt);
+			pStream->numHeld--;
+		}
+		else if (pSlot->state == SEQ_MCAST_SLOT_MISSING && pSlot->deadline <= now)
+		{
+			pRecovery->gapsDetected++;
+			do
+			{
+				pSlot->state = SEQ_MCAST_SLOT_EMPTY;
+				pStream->nextSeqNum = seqMcastSeqNext(pStream->nextSeqNum);
+				pSlot = seqMcastGetSlot(pRecovery, pStream, pStream->nextSeqNum);
+			} while (pSlot->state == SEQ_MCAST_SLOT_MISSING && pSlot->deadline <= now);
+			continue;
+		}
+		else
+			break;
+
+		pSlot->pkt = 0;
+		pSlot->state = SEQ_MCAST_SLOT_EMPTY;
+		pStream->nextSeqNum = seqMcastSeqNext(pStream->nextSeqNum);
+	}
+
+	if (pStream->holeSince != 0 && (RsslInt32)(pStream->holeSeqNum - pStream->nextSeqNum) < 0)
+	{
+		if ((RsslInt32)(pStream->nextSeqNum - pStream->highSeqNum) > 0)
+			pStream->holeSince = 0;
+		else
+			pStream->holeSeqNum = pStream->nextSeqNum;
+	}
+}
+
+/* Extends what is known to have been sent up to seqNum; the new sequence numbers are holes until they arrive */
+static void seqMcastStreamExtend(seqMcastRecovery *pRecovery, seqMcastStream *pStream, RsslUInt32 seqNum, RsslInt64 now)
+{
+	RsslUInt32 expected = seqMcastSeqNext(pStream->highSeqNum);
+
+	if ((RsslInt32)(seqNum - pStream->highSeqNum) <= 0)
+		return;
+
+	if (seqNum != expected && pStream->holeSince == 0)
+	{
+		pStream->holeSince = now;
+		pStream->holeSeqNum = expected;
+	}
+	pStream->highSeqNum = seqNum;
+}
+
+RsslRet rsslSeqMcastRecoveryInsert(seqMcastRecovery *pRecovery, seqMcastPkt *pPkt, RsslInt64 now)
+{
+	seqMcastStream *pStream;
+	seqMcastSlot *pSlot;
+	RsslInt32 distance;
+
+	/* A reset isn't sequenced */
+	if (pPkt->seqNum == 0)
+	{
+		seqMcastAddReady(pRecovery, pPkt);
+		return RSSL_RET_SUCCESS;
+	}
+
+	if (!(pStream = seqMcastFindStream(pRecovery, pPkt->addr, pPkt->port, pPkt->instanceId))
+			&& !(pStream = seqMcastAddStream(pRecovery, pPkt->addr, pPkt->port, pPkt->instanceId, pPkt->seqNum)))
+	{
+		rsslSeqMcastRecoveryPutPkt(pRecovery, pPkt);
+		return RSSL_RET_FAILURE;
+	}
+
+	distance = (RsslInt32)(pPkt->seqNum - pStream->nextSeqNum);
+	if (distance < 0)
+	{
+		if (distance > -2 * (RsslInt32)pRecovery->capacity)
+		{
+			/* Already delivered or skipped */
+			rsslSeqMcastRecoveryPutPkt(pRecovery, pPkt);
+			return RSSL_RET_SUCCESS;
+		}
+
+		/* The sender has restarted; start over from here */
+		seqMcastStreamSkipTo(pRecovery, pStream, pPkt->seqNum);
+		pStream->highSeqNum = pPkt->seqNum - 1;
+	}
+	else if ((RsslUInt32)distance >= pRecovery->capacity)
+	{
+		/* Too far ahead to hold */
+		seqMcastStreamSkipTo(pRecovery, pStream, pPkt->seqNum - pRecovery->capacity + 1);
+	}
+
+	pSlot = seqMcastGetSlot(pRecovery, pStream, pPkt->seqNum);
+	if (pSlot->state == SEQ_MCAST_SLOT_HELD)
+	{
+		rsslSeqMcastRecoveryPutPkt(pRecovery, pPkt);
+		return RSSL_RET_SUCCESS;
+	}
+
+	if (pPkt->length > SEQ_MCAST_FLAGS_POS && (pPkt->data[SEQ_MCAST_FLAGS_POS] & SEQ_MCAST_FLAGS_RETRANSMIT))
+		pRecovery->retransPktsRcvd++;
+
+	pSlot->pkt = pPkt;
+	pSlot->state = SEQ_MCAST_SLOT_HELD;
+	pStream->numHeld++;
+
+	seqMcastStreamExtend(pRecovery, pStream, pPkt->seqNum, now);
+
+	if (pStream->holeSince != 0 && (RsslUInt32)(pStream->highSeqNum - pStream->holeSeqNum) > pRecovery->reorderWindow)
+		seqMcastStreamConfirm(pRecovery, pStream, now);
+
+	seqMcastStreamDrain(pRecovery, pStream, now);
+	return RSSL_RET_SUCCESS;
+}
+
+RsslRet rsslSeqMcastRecoveryPing(seqMcastRecovery *pRecovery, RsslUInt32 addr, RsslUInt16 port, RsslUInt16 instanceId, RsslUInt32 seqNum, RsslInt64 now)
+{
+	seqMcastStream *pStream;
+
+	if (seqNum == 0)
+		return RSSL_RET_SUCCESS;
+
+	if (!(pStream = seqMcastFindStream(pRecovery, addr, port, instanceId)))
+	{
+		/* Nothing received yet; the next packet is the first one expected */
+		return (seqMcastAddStream(pRecovery, addr, port, instanceId, seqMcastSeqNext(seqNum)) != NULL) ? RSSL_RET_SUCCESS : RSSL_RET_FAILURE;
+	}
+
+	if ((RsslInt32)(seqNum - pStream->highSeqNum) <= 0)
+		return RSSL_RET_SUCCESS;
+
+	if ((RsslUInt32)(seqNum - pStream->nextSeqNum) >= pRecovery->capacity)
+		seqMcastStreamSkipTo(pRecovery, pStream, seqNum - pRecovery->capacity + 1);
+
+	/* Everything up to and including seqNum was sent, so there is nothing left to wait for */
+	seqMcastStreamExtend(pRecovery, pStream, seqNum, now);
+	if (pStream->holeSince == 0)
+	{
+		pStream->holeSince = now;
+		pStream->holeSeqNum = pStream->nextSeqNum;
+	}
+	seqMcastStreamConfirm(pRecovery, pStream, now);
+	seqMcastStreamDrain(pRecovery, pStream, now);
+	return RSSL_RET_SUCCESS;
+}
+
+seqMcastPkt *rsslSeqMcastRecoveryNext(seqMcastRecovery *pRecovery, RsslInt64 now)
+{
+	seqMcastPkt *pPkt;
+	RsslUInt32 i;
+
+	if (!pRecovery->readyHead)
+	{
+		for (i = 0; i < pRecovery->numStreams; i++)
+		{
+			seqMcastStream *pStream = &pRecovery->streams[i];
+
+			/* Anything known to have been sent and not yet delivered may be held, awaited or lost */
+			if ((RsslInt32)(pStream->highSeqNum - pStream->nextSeqNum) >= 0)
+				seqMcastStreamDrain(pRecovery, pStream, now);
+		}
+		if (!pRecovery->readyHead)
+			return NULL;
+	}
+
+	pPkt = pRecovery->readyHead;
+	if (!(pRecovery->readyHead = pPkt->next))
+		pRecovery->readyTail = 0;
+	pPkt->next = 0;
+	return pPkt;
+}
+
+RsslInt64 rsslSeqMcastRecoveryDeadline(seqMcastRecovery *pRecovery)
+{
+	RsslInt64 deadline = 0, streamDeadline;
+	RsslUInt32 i;
+
+	for (i = 0; i < pRecovery->numStreams; i++)
+	{
+		seqMcastStream *pStream = &pRecovery->streams[i];
+		seqMcastSlot *pSlot = seqMcastGetSlot(pRecovery, pStream, pStream->nextSeqNum);
+
+		streamDeadline = 0;
+		if (pSlot->state == SEQ_MCAST_SLOT_MISSING)
+			streamDeadline = pSlot->deadline;
+		if (pStream->holeSince != 0 && (streamDeadline == 0 || pStream->holeSince + SEQ_MCAST_REORDER_WAIT < streamDeadline))
+			streamDeadline = pStream->holeSince + SEQ_MCAST_REORDER_WAIT;
+
+		if (streamDeadline != 0 && (deadline == 0 || streamDeadline < deadline))
+			deadline = streamDeadline;
+	}
+	return deadline;
+}
+
+/* Retransmission connection */
+
+static void seqMcastRetransWatch(seqMcastRecovery *pRecovery)
+{
+	struct epoll_event event;
+	RsslUInt32 events = 0;
+
+	if (pRecovery->retransSock == RIPC_INVALID_SOCKET)
+		return;
+
+	/* Only watch the connection while it has work; a closed connection would otherwise keep the channel readable */
+	if (!pRecovery->retransConnected || pRecovery->reqSent != pRecovery->reqTail)
+		events |= EPOLLOUT;
+	if (pRecovery->reqHead != pRecovery->reqSent)
+		events |= EPOLLIN;
+
+	if (events == pRecovery->retransEvents)
+		return;
+
+	memset(&event, 0, sizeof(event));
+	event.events = events;
+	event.data.fd = pRecovery->retransSock;
+	if (events == 0)
+		epoll_ctl(pRecovery->epollFd, EPOLL_CTL_DEL, pRecovery->retransSock, &event);
+	else
+		epoll_ctl(pRecovery->epollFd, (pRecovery->retransEvents == 0) ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, pRecovery->retransSock, &event);
+	pRecovery->retransEvents = events;
+}
+
+static void seqMcastRetransClose(seqMcastRecovery *pRecovery)
+{
+	if (pRecovery->retransEvents)
+		epoll_ctl(pRecovery->epollFd, EPOLL_CTL_DEL, pRecovery->retransSock, NULL);
+	close(pRecovery->retransSock);
+	pRecovery->retransSock = RIPC_INVALID_SOCKET;
+	pRecovery->retransConnected = RSSL_FALSE;
+	pRecovery->retransEvents = 0;
+	pRecovery->retransInLen = 0;
+	pRecovery->retransOutLen = 0;
+
+	/* Holes already requested are skipped at their deadline */
+	pRecovery->reqHead = pRecovery->reqSent = pRecovery->reqTail;
+}
+
+static void seqMcastRetransConnect(seqMcastRecovery *pRecovery, RsslInt64 now)
+{
+	RsslSocket sock;
+	int nodelay = 1;
+
+	pRecovery->retransLastAttempt = now;
+
+	if ((sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)) == RIPC_INVALID_SOCKET)
+		return;
+
+	if (fcntl(sock, F_SETFL, O_NONBLOCK) < 0)
+	{
+		close(sock);
+		return;
+	}
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (char*)&nodelay, sizeof(nodelay));
+
+	if (connect(sock, (struct sockaddr*)&pRecovery->retransAddr, sizeof(pRecovery->retransAddr)) == 0)
+		pRecovery->retransConnected = RSSL_TRUE;
+	else if (errno != EINPROGRESS)
+	{
+		close(sock);
+		return;
+	}
+
+	pRecovery->retransSock = sock;
+	seqMcastRetransWatch(pRecovery);
+}
+
+/* Returns RSSL_TRUE if seqNum is one of the sequence numbers the request asked for */
+static RsslBool seqMcastRetransReqHas(seqMcastRetransReq *pReq, RsslUInt32 seqNum)
+{
+	RsslUInt32 offset = seqNum - pReq->firstSeqNum;
+
+	if (seqNum == 0)
+		return RSSL_FALSE;
+
+	/* a range that wraps skips sequence number 0 */
+	if (seqNum < pReq->firstSeqNum)
+		offset--;
+
+	return (offset < pReq->count) ? RSSL_TRUE : RSSL_FALSE;
+}
+
+/* The server has sent everything it has for this request; skip what is still missing now */
+static void seqMcastRetransDone(seqMcastRecovery *pRecovery, seqMcastRetransReq *pReq, RsslInt64 now)
+{
+	seqMcastStream *pStream;
+	RsslUInt32 seqNum = pReq->firstSeqNum;
+	RsslUInt32 i;
+
+	if (!(pStream = seqMcastFindStream(pRecovery, pReq->addr, pReq->port, pReq->instanceId)))
+		return;
+
+	for (i = 0; i < pReq->count; i++, seqNum = seqMcastSeqNext(seqNum))
+	{
+		seqMcastSlot *pSlot;
+
+		if ((RsslUInt32)(seqNum - pStream->nextSeqNum) >= pRecovery->capacity)
+			continue;
+
+		pSlot = seqMcastGetSlot(pRecovery, pStream, seqNum);
+		if (pSlot->state == SEQ_MCAST_SLOT_MISSING)
+			pSlot->deadline = now;
+	}
+}
+
+static void seqMcastRetransRead(seqMcastRecovery *pRecovery, RsslInt64 now)
+{
+	RsslUInt32 bufLen = 4 * (pRecovery->maxPktLen + 2);
+	RsslUInt32 pos = 0;
+	int cc;
+
+	do
+	{
+		if ((cc = recv(pRecovery->retransSock, pRecovery->retransIn + pRecovery->retransInLen, bufLen - pRecovery->retransInLen, MSG_DONTWAIT)) <= 0)
+		{
+			if (cc < 0 && (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR))
+				return;
+			seqMcastRetransClose(pRecovery);
+			return;
+		}
+		pRecovery->retransInLen += cc;
+
+		while (pRecovery->retransInLen - pos >= 2 && pRecovery->reqHead != pRecovery->reqSent)
+		{
+			seqMcastRetransReq *pReq = &pRecovery->reqs[pRecovery->reqHead % SEQ_MCAST_RETRANS_MAX_REQS];
+			RsslUInt32 frameLen = seqMcastGet16(pRecovery->retransIn + pos);
+			seqMcastPkt *pPkt;
+
+			if (frameLen == 0)
+			{
+				seqMcastRetransDone(pRecovery, pReq, now);
+				pRecovery->reqHead++;
+				pos += 2;
+				continue;
+			}
+
+			if (frameLen > pRecovery->maxPktLen || frameLen <= SEQ_MCAST_PING_LEN)
+			{
+				seqMcastRetransClose(pRecovery);
+				return;
+			}
+
+			if (pRecovery->retransInLen - pos < 2 + frameLen)
+				break;
+
+			if ((pPkt = rsslSeqMcastRecoveryGetPkt(pRecovery)) != NULL)
+			{
+				char *pData = pRecovery->retransIn + pos + 2;
+
+				memcpy(pPkt->data, pData, frameLen);
+				pPkt->length = frameLen;
+				pPkt->addr = pReq->addr;
+				pPkt->port = pReq->port;
+				pPkt->instanceId = seqMcastGet16(pData + SEQ_MCAST_INSTANCE_ID_POS);
+				pPkt->seqNum = seqMcastGet32(pData + SEQ_MCAST_SEQ_NUM_POS);
+				pPkt->data[SEQ_MCAST_FLAGS_POS] |= SEQ_MCAST_FLAGS_RETRANSMIT;
+
+				/* anything the request did not ask for is dropped rather than taken as a retransmission */
+				if (pPkt->instanceId == pReq->instanceId && seqMcastRetransReqHas(pReq, pPkt->seqNum))
+					rsslSeqMcastRecoveryInsert(pRecovery, pPkt, now);
+				else
+					rsslSeqMcastRecoveryPutPkt(pRecovery, pPkt);
+			}
+			pos += 2 + frameLen;
+		}
+
+		if (pos)
+		{
+			memmove(pRecovery->retransIn, pRecovery->retransIn + pos, pRecovery->retransInLen - pos);
+			pRecovery->retransInLen -= pos;
+			pos = 0;
+		}
+	} while (pRecovery->reqHead != pRecovery->reqSent);
+}
+
+static void seqMcastRetransWrite(seqMcastRecovery *pRecovery)
+{
+	int cc;
+
+	while (pRecovery->reqSent != pRecovery->reqTail)
+	{
+		if (pRecovery->retransOutLen == 0)
+		{
+			seqMcastRetransReq *pReq = &pRecovery->reqs[pRecovery->reqSent % SEQ_MCAST_RETRANS_MAX_REQS];
+			char *pOut = pRecovery->retransOut;
+
+			pOut[0] = RSSL_SEQ_MCAST_RETRANS_VERSION;
+			pOut[1] = 0;
+			seqMcastPut16(pOut + 2, pReq->instanceId);
+			seqMcastPut32(pOut + 4, pReq->addr);
+			seqMcastPut16(pOut + 8, pReq->port);
+			seqMcastPut16(pOut + 10, pReq->count);
+			seqMcastPut32(pOut + 12, pReq->firstSeqNum);
+		}
+
+		if ((cc = send(pRecovery->retransSock, pRecovery->retransOut + pRecovery->retransOutLen,
+						RSSL_SEQ_MCAST_RETRANS_REQ_LEN - pRecovery->retransOutLen, MSG_DONTWAIT | MSG_NOSIGNAL)) < 0)
+		{
+			if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR)
+				return;
+			seqMcastRetransClose(pRecovery);
+			return;
+		}
+
+		if ((pRecovery->retransOutLen += cc) == RSSL_SEQ_MCAST_RETRANS_REQ_LEN)
+		{
+			pRecovery->retransOutLen = 0;
+			pRecovery->reqSent++;
+			pRecovery->retransReqSent++;
+		}
+	}
+}
+
+static void seqMcastRetransService(seqMcastRecovery *pRecovery, RsslInt64 now)
+{
+	/* Finish a pending connect first, whether or not there is anything to ask for yet */
+	if (pRecovery->retransSock != RIPC_INVALID_SOCKET && !pRecovery->retransConnected)
+	{
+		struct pollfd pfd;
+		int sockErr = 0;
+		socklen_t errLen = sizeof(sockErr);
+
+		pfd.fd = pRecovery->retransSock;
+		pfd.events = POLLOUT;
+		pfd.revents = 0;
+		if (poll(&pfd, 1, 0) <= 0)
+			return;
+
+		if (getsockopt(pRecovery->retransSock, SOL_SOCKET, SO_ERROR, (char*)&sockErr, &errLen) < 0 || sockErr != 0)
+			seqMcastRetransClose(pRecovery);
+		else
+			pRecovery->retransConnected = RSSL_TRUE;
+	}
+
+	if (pRecovery->reqTail == pRecovery->reqHead)
+	{
+		seqMcastRetransWatch(pRecovery);
+		return;
+	}
+
+	if (pRecovery->retransSock == RIPC_INVALID_SOCKET)
+	{
+		if (now - pRecovery->retransLastAttempt >= SEQ_MCAST_RETRANS_RECONNECT)
+			seqMcastRetransConnect(pRecovery, now);
+		if (pRecovery->retransSock == RIPC_INVALID_SOCKET)
+		{
+			/* Can't ask for these; they are skipped at their deadline */
+			pRecovery->reqHead = pRecovery->reqSent = pRecovery->reqTail;
+			return;
+		}
+	}
+
+	if (!pRecovery->retransConnected)
+		return;
+
+	seqMcastRetransWrite(pRecovery);
+	if (pRecovery->retransSock != RIPC_INVALID_SOCKET && pRecovery->reqHead != pRecovery->reqSent)
+		seqMcastRetransRead(pRecovery, now);
+	seqMcastRetransWatch(pRecovery);
+}
+
+/* Keeps the timer at the earliest deadline, or fires it right away if packets are ready, so the epoll descriptor is
+ * readable whenever rsslRead() has something to do */
+static void seqMcastArmTimer(seqMcastRecovery *pRecovery, RsslInt64 now)
+{
+	struct itimerspec spec;
+	RsslInt64 deadline = pRecovery->readyHead ? now : rsslSeqMcastRecoveryDeadline(pRecovery);
+	RsslInt64 wait;
+
+	if (deadline == pRecovery->timerDeadline)
+		return;
+
+	memset(&spec, 0, sizeof(spec));
+	if (deadline != 0)
+	{
+		wait = deadline - now;
+		if (wait > 0)
+		{
+			spec.it_value.tv_sec = (time_t)(wait / 1000);
+			spec.it_value.tv_nsec = (long)(wait % 1000) * 1000000;
+		}
+		else
+			spec.it_value.tv_nsec = 1;
+	}
+	timerfd_settime(pRecovery->timerFd, 0, &spec, NULL);
+	pRecovery->timerDeadline = deadline;
+}
+
+RsslRet rsslSeqMcastRecoveryOpen(seqMcastRecovery *pRecovery, RsslSocket mcastSock, char *retransHostName, char *retransServiceName, RsslError *error)
+{
+	struct epoll_event event;
+	RsslUInt32 addr;
+
+	if ((pRecovery->epollFd = epoll_create(4)) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 1002 epoll_create() failed.  System errno: (%d).\n", __FILE__, __LINE__, errno);
+		return RSSL_RET_FAILURE;
+	}
+
+	if ((pRecovery->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK)) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 1002 timerfd_create() failed.  System errno: (%d).\n", __FILE__, __LINE__, errno);
+		return RSSL_RET_FAILURE;
+	}
+
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.fd = mcastSock;
+	if (epoll_ctl(pRecovery->epollFd, EPOLL_CTL_ADD, mcastSock, &event) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 1002 epoll_ctl() failed.  System errno: (%d).\n", __FILE__, __LINE__, errno);
+		return RSSL_RET_FAILURE;
+	}
+	event.data.fd = pRecovery->timerFd;
+	if (epoll_ctl(pRecovery->epollFd, EPOLL_CTL_ADD, pRecovery->timerFd, &event) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 1002 epoll_ctl() failed.  System errno: (%d).\n", __FILE__, __LINE__, errno);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (!pRecovery->retrans)
+		return RSSL_RET_SUCCESS;
+
+	memset(&pRecovery->retransAddr, 0, sizeof(pRecovery->retransAddr));
+	pRecovery->retransAddr.sin_family = AF_INET;
+	if (rsslGetHostByName(retransHostName, &addr) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 1004 getHostByName() failed.  Retransmission host (%s) is incorrect.  System errno: (%d).\n", __FILE__, __LINE__, retransHostName, errno);
+		return RSSL_RET_FAILURE;
+	}
+	pRecovery->retransAddr.sin_addr.s_addr = addr;
+
+	if ((pRecovery->retransAddr.sin_port = rsslGetServByName(retransServiceName)) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 1004 getServByName() failed.  Retransmission service (%s) is incorrect.  System errno: (%d).\n", __FILE__, __LINE__, retransServiceName, errno);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (!(pRecovery->retransIn = (char*)_rsslMalloc(4 * (pRecovery->maxPktLen + 2))))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 0005 Failed to allocate the retransmission input buffer.\n", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+
+	/* Connect now so the first gap doesn't wait for it; failures are retried when there is something to ask for */
+	seqMcastRetransConnect(pRecovery, seqMcastTimeMsec());
+	return RSSL_RET_SUCCESS;
+}
+
+seqMcastPkt *rsslSeqMcastRecoveryRead(seqMcastRecovery *pRecovery, RsslSocket mcastSock, RsslBool blocking, RsslRet *readRet, RsslError *error)
+{
+	seqMcastPkt *pPkt;
+	struct sockaddr_in srcAddr;
+	socklen_t srcAddrLen;
+	RsslInt64 now;
+	int cc;
+
+	if (pRecovery->current)
+	{
+		rsslSeqMcastRecoveryPutPkt(pRecovery, pRecovery->current);
+		pRecovery->current = 0;
+	}
+
+	for (;;)
+	{
+		now = seqMcastTimeMsec();
+
+		if (pRecovery->timerDeadline != 0 && now >= pRecovery->timerDeadline)
+		{
+			RsslUInt64 expirations;
+			if (read(pRecovery->timerFd, &expirations, sizeof(expirations)) < 0)
+				expirations = 0;	/* already cleared */
+			pRecovery->timerDeadline = 0;
+		}
+
+		seqMcastRetransService(pRecovery, now);
+
+		if ((pPkt = rsslSeqMcastRecoveryNext(pRecovery, now)) != NULL)
+			break;
+
+		if (!(pPkt = rsslSeqMcastRecoveryGetPkt(pRecovery)))
+		{
+			*readRet = RSSL_RET_FAILURE;
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslRead() Error: 0005 Failed to allocate a sequenced multicast packet.\n", __FILE__, __LINE__);
+			return NULL;
+		}
+
+		srcAddrLen = sizeof(srcAddr);
+		if ((cc = recvfrom(mcastSock, pPkt->data, pRecovery->maxPktLen, MSG_DONTWAIT, (struct sockaddr*)&srcAddr, &srcAddrLen)) < 0)
+		{
+			int sockErr = errno;
+
+			rsslSeqMcastRecoveryPutPkt(pRecovery, pPkt);
+			if (sockErr == EWOULDBLOCK || sockErr == EAGAIN)
+			{
+				if (blocking)
+				{
+					struct epoll_event events[4];
+					RsslInt64 deadline = rsslSeqMcastRecoveryDeadline(pRecovery);
+					int timeout = -1;
+
+					if (deadline != 0)
+						timeout = (deadline > now) ? (int)(deadline - now) : 0;
+					epoll_wait(pRecovery->epollFd, events, 4, timeout);
+					continue;
+				}
+				seqMcastArmTimer(pRecovery, now);
+				*readRet = RSSL_RET_READ_WOULD_BLOCK;
+				return NULL;
+			}
+			else if (sockErr == EINTR)
+			{
+				*readRet = 1;
+				return NULL;
+			}
+
+			*readRet = RSSL_RET_FAILURE;
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, sockErr);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslRead() Error: 1002  Call to recvfrom() failed.  System errno: (%d).\n", __FILE__, __LINE__, sockErr);
+			return NULL;
+		}
+
+		pRecovery->mcastRcvd++;
+		pPkt->length = (RsslUInt32)cc;
+		pPkt->addr = ntohl(srcAddr.sin_addr.s_addr);
+		pPkt->port = ntohs(srcAddr.sin_port);
+
+		/* Malformed packets are passed through for the transport to reject */
+		if (cc < SEQ_MCAST_PING_LEN || pPkt->data[0] != SEQ_MCAST_MAX_VERSION)
+			break;
+
+		pPkt->instanceId = seqMcastGet16(pPkt->data + SEQ_MCAST_INSTANCE_ID_POS);
+		pPkt->seqNum = seqMcastGet32(pPkt->data + SEQ_MCAST_SEQ_NUM_POS);
+
+		if (cc == SEQ_MCAST_PING_LEN)
+		{
+			rsslSeqMcastRecoveryPing(pRecovery, pPkt->addr, pPkt->port, pPkt->instanceId, pPkt->seqNum, now);
+			break;
+		}
+
+		rsslSeqMcastRecoveryInsert(pRecovery, pPkt, now);
+	}
+
+	/* Send anything this packet made us ask for now, rather than on the next call */
+	if (pRecovery->reqSent != pRecovery->reqTail)
+		seqMcastRetransService(pRecovery, now);
+
+	pRecovery->current = pPkt;
+	seqMcastArmTimer(pRecovery, now);
+	*readRet = RSSL_RET_SUCCESS;
+	return pPkt;
+}
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "rtr/rsslSeqMcastTransportImpl.h"
 #include "rtr/rsslSeqMcastTransport.h"
+#include "rtr/rsslSeqMcastRecovery.h"
 #include "rtr/rsslAlloc.h"
 #include "rtr/rsslErrors.h"
 #include "rtr/retmacros.h"
@@ -63,8 +64,6 @@
 
 #endif
 
-#define SEQ_MCAST_MAX_VERSION 0x01
-
 #define SEQ_MCAST_SEQUENCE_NUM_LEN 4
 #define SEQ_MCAST_MESSAGE_LENGTH_LEN 2
 #define SEQ_MCAST_VERSION_LEN 1
@@ -81,13 +80,13 @@
 /* Minimum length of the header, excluding any optional members, but also including the 1st message. */
 #define SEQ_MCAST_MIN_HDR_LEN 14
 
-/* Ping length is the total number of bytes in the header, minus the message length. */
-#define SEQ_MCAST_PING_LEN 12
-
 typedef struct
 {
 	RsslMutex			lock;
 	RsslSocket			sendSock;
+	RsslSocket			mcastSock;					/* Channel.socketId, unless recovery is on */
+	seqMcastRecovery	*pRecovery;					/* gap recovery, see RsslSeqMCastOpts.reorderWindow */
+	RsslBool			blocking;
 	RsslUInt32			maxMsgSize;
 	RsslUInt16			instanceId;
 	RsslBool			bufferInUse;
@@ -97,6 +96,7 @@ typedef struct
 	RsslInt32			processedPacketLen;
 	RsslUInt32			readSeqNum;
 	RsslUInt16			readInstanceID;				/* Instance ID for the current packet */
+	RsslBool			readRetransmit;				/* the current packet is a retransmission */
 	RsslBool			stillProcessingPacket;
 	RsslBuffer			readBuffer;
 	RsslUInt32			writeSeqNum;
@@ -240,7 +240,11 @@ RsslRet rsslSeqMcastCloseChannel(rsslChannelImpl* rsslChnlImpl, RsslError *error
 	if (chnlLocking)
 		seqMcastGetLock(&pSeqMcastChannel->lock);
 
-	sock_close(rsslChnlImpl->Channel.socketId);
+	sock_close(pSeqMcastChannel->mcastSock);
+#if !defined(_WIN32)
+	if (pSeqMcastChannel->pRecovery)
+		rsslSeqMcastRecoveryDestroy(pSeqMcastChannel->pRecovery);
+#endif
 
 	rsslChnlImpl->Channel.state = RSSL_CH_STATE_INACTIVE;
 
@@ -324,6 +328,9 @@ RsslRet rsslSeqMcastConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *o
 	pSeqMcastChannel->pktRecvCount = 0;
 	pSeqMcastChannel->pktSentCount = 0;
 	pSeqMcastChannel->instanceId = opts->seqMulticastOpts.instanceId;
+	pSeqMcastChannel->pRecovery = NULL;
+	pSeqMcastChannel->blocking = opts->blocking;
+	pSeqMcastChannel->readRetransmit = RSSL_FALSE;
 	memset(&pSeqMcastChannel->sendAddr, 0, sizeof(pSeqMcastChannel->sendAddr));
 	memset(&pSeqMcastChannel->recvAddr, 0, sizeof(pSeqMcastChannel->recvAddr));
 	memset(&pSeqMcastChannel->writeBuffer, 0, sizeof(pSeqMcastChannel->writeBuffer));
@@ -599,6 +606,40 @@ RsslRet rsslSeqMcastConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *o
 		pSeqMcastChannel->sendAddr.sin_port = rsslGetServByName(opts->connectionInfo.segmented.recvServiceName);
 	}
 
+	pSeqMcastChannel->mcastSock = socketId;
+
+	if (opts->seqMulticastOpts.reorderWindow)
+	{
+#if defined(_WIN32)
+		sock_close(socketId);
+
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslConnect() Error: 0006 seqMulticastOpts.reorderWindow is not supported on this platform.\n", __FILE__, __LINE__);
+		_rsslFree(pSeqMcastChannel->inputBufferMem);
+		_rsslFree(pSeqMcastChannel->bufferMem);
+		_rsslFree(pSeqMcastChannel);
+		return RSSL_RET_FAILURE;
+#else
+		RsslBool retrans = (opts->seqMulticastOpts.retransHostName && opts->seqMulticastOpts.retransServiceName) ? RSSL_TRUE : RSSL_FALSE;
+
+		if (!(pSeqMcastChannel->pRecovery = rsslSeqMcastRecoveryCreate(opts->seqMulticastOpts.reorderWindow, opts->seqMulticastOpts.retransTimeout, retrans,
+						pSeqMcastChannel->maxMsgSize + SEQ_MCAST_MAX_HDR_LEN, error))
+				|| rsslSeqMcastRecoveryOpen(pSeqMcastChannel->pRecovery, socketId, opts->seqMulticastOpts.retransHostName, opts->seqMulticastOpts.retransServiceName, error) != RSSL_RET_SUCCESS)
+		{
+			if (pSeqMcastChannel->pRecovery)
+				rsslSeqMcastRecoveryDestroy(pSeqMcastChannel->pRecovery);
+			sock_close(socketId);
+			_rsslFree(pSeqMcastChannel->inputBufferMem);
+			_rsslFree(pSeqMcastChannel->bufferMem);
+			_rsslFree(pSeqMcastChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* Applications wait on the recovery layer's epoll descriptor, which includes the multicast socket */
+		socketId = pSeqMcastChannel->pRecovery->epollFd;
+#endif
+	}
+
 	/* Update Channel information */
 	rsslChnlImpl->Channel.socketId = socketId;
 	rsslChnlImpl->Channel.state = RSSL_CH_STATE_ACTIVE;
@@ -696,11 +737,25 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslRet) rsslSeqMcastGetChannelInfo(rsslChannelImp
 	info->serverToClientPings = RSSL_FALSE;
 	info->multicastStats.mcastRcvd = pSeqMcastChannel->pktRecvCount;
 	info->multicastStats.mcastSent = pSeqMcastChannel->pktSentCount;
+	if (pSeqMcastChannel->pRecovery)
+	{
+		info->multicastStats.mcastRcvd = pSeqMcastChannel->pRecovery->mcastRcvd;
+		info->multicastStats.gapsDetected = pSeqMcastChannel->pRecovery->gapsDetected;
+		info->multicastStats.retransReqSent = pSeqMcastChannel->pRecovery->retransReqSent;
+		info->multicastStats.retransPktsRcvd = pSeqMcastChannel->pRecovery->retransPktsRcvd;
+	}
+	memset(&info->shmemStats, 0, sizeof(info->shmemStats));
 	
+	info->compressionDictId = 0;
+	info->zeroCopyThreshold = 0;
+	info->zeroCopyPendingSends = 0;
+	info->zeroCopyHeldBuffers = 0;
+	info->zeroCopyCopiedSends = 0;
 	info->encryptionProtocol = RSSL_ENC_NONE;
+	info->encryptionOffload = RSSL_ENC_OFFLOAD_NONE;
 
 	optlen = sizeof(info->sysSendBufSize);
-	if (getsockopt(rsslChnlImpl->Channel.socketId, SOL_SOCKET, SO_SNDBUF, (char *)&info->sysSendBufSize, &optlen) < 0)
+	if (getsockopt(pSeqMcastChannel->mcastSock, SOL_SOCKET, SO_SNDBUF, (char *)&info->sysSendBufSize, &optlen) < 0)
 	{
 		_rsslSetError(error, NULL, RSSL_RET_FAILURE,  errno);
 		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslGetChannelInfo() Error: 1002 getsockopt() failed.  System errno: (%d)\n", __FILE__, __LINE__, errno);
@@ -710,7 +765,7 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslRet) rsslSeqMcastGetChannelInfo(rsslChannelImp
 	}
 
 	optlen = sizeof(info->sysRecvBufSize);
-	if (getsockopt(rsslChnlImpl->Channel.socketId, SOL_SOCKET, SO_RCVBUF, (char *)&info->sysRecvBufSize, &optlen) < 0)
+	if (getsockopt(pSeqMcastChannel->mcastSock, SOL_SOCKET, SO_RCVBUF, (char *)&info->sysRecvBufSize, &optlen) < 0)
 	{
 		_rsslSetError(error, NULL, RSSL_RET_FAILURE,  errno);
 		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslGetChannelInfo() Error: 1002 getsockopt() failed.  System errno: (%d)\n", __FILE__, __LINE__, errno);
@@ -750,7 +805,7 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslRet) rsslSeqMcastIoctl(rsslChannelImpl *rsslCh
 	switch(code)
 	{
 		case RSSL_SYSTEM_READ_BUFFERS:
-			if (setsockopt(rsslChnlImpl->Channel.socketId, SOL_SOCKET, SO_RCVBUF, value, sizeof(RsslInt32)) < 0)
+			if (setsockopt(pSeqMcastChannel->mcastSock, SOL_SOCKET, SO_RCVBUF, value, sizeof(RsslInt32)) < 0)
 			{
 				_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
 				snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctrl()  Error: 1002 setsockopt() failed. Unable to set SO_RCVBUF on socket. System errno: (%d).\n", __FILE__, __LINE__, errno);
@@ -760,7 +815,7 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslRet) rsslSeqMcastIoctl(rsslChannelImpl *rsslCh
 			}
 			break;
 		case RSSL_SYSTEM_WRITE_BUFFERS:
-			if (setsockopt(rsslChnlImpl->Channel.socketId, SOL_SOCKET, SO_SNDBUF, value, sizeof(RsslInt32)) < 0)
+			if (setsockopt(pSeqMcastChannel->mcastSock, SOL_SOCKET, SO_SNDBUF, value, sizeof(RsslInt32)) < 0)
 			{
 				_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
 				snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctrl()  Error: 1002 setsockopt() failed. Unable to set SO_SNDBUF on socket. System errno: (%d).\n", __FILE__, __LINE__, errno);
@@ -846,7 +901,7 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslRet) rsslSeqMcastPing(rsslChannelImpl *rsslChn
 	/* send packet */
 	do
 	{
-		if ((ret = sendto(rsslChnlImpl->Channel.socketId, sendBuf,
+		if ((ret = sendto(pSeqMcastChannel->mcastSock, sendBuf,
 						SEQ_MCAST_PING_LEN, 
 						0, (struct sockaddr*)&pSeqMcastChannel->sendAddr, sizeof(pSeqMcastChannel->sendAddr))) < 0)
 		{
@@ -895,9 +950,30 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslBuffer*) rsslSeqMcastRead(rsslChannelImpl* rss
 	{
 		if (pSeqMcastChannel->stillProcessingPacket == RSSL_FALSE) /* process a new packet from network */
 		{
+#if !defined(_WIN32)
+			if (pSeqMcastChannel->pRecovery)
+			{
+				/* Packets come back in sequence order, with lost ones retransmitted where possible */
+				seqMcastPkt *pPkt = rsslSeqMcastRecoveryRead(pSeqMcastChannel->pRecovery, pSeqMcastChannel->mcastSock, pSeqMcastChannel->blocking, readRet, error);
+
+				if (!pPkt)
+				{
+					if (chnlLocking)
+						seqMcastUnlock(&pSeqMcastChannel->lock);
+					return NULL;
+				}
+
+				pSeqMcastChannel->inputBuffer.data = pPkt->data;
+				cc = (RsslInt32)pPkt->length;
+				srcAddr.sin_addr.s_addr = htonl(pPkt->addr);
+				srcAddr.sin_port = htons(pPkt->port);
+			}
+			else
+#endif
+			{
 			pSeqMcastChannel->inputBuffer.data = pSeqMcastChannel->inputBufferMem;
 
-			if ((cc = recvfrom(rsslChnlImpl->Channel.socketId, pSeqMcastChannel->inputBuffer.data, pSeqMcastChannel->maxMsgSize + SEQ_MCAST_MAX_HDR_LEN, 0, (struct sockaddr*)&srcAddr, (socklen_t*)&srcAddrLen)) < 0)
+			if ((cc = recvfrom(pSeqMcastChannel->mcastSock, pSeqMcastChannel->inputBuffer.data, pSeqMcastChannel->maxMsgSize + SEQ_MCAST_MAX_HDR_LEN, 0, (struct sockaddr*)&srcAddr, (socklen_t*)&srcAddrLen)) < 0)
 			{
 				if(errno == EINTR || errno == EWOULDBLOCK || errno == EAGAIN)
 				{
@@ -924,6 +1000,7 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslBuffer*) rsslSeqMcastRead(rsslChannelImpl* rss
 			}
 
 			pSeqMcastChannel->pktRecvCount++;
+			}
 
 			/* each packet contains one or more messages */
 
@@ -968,8 +1045,7 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslBuffer*) rsslSeqMcastRead(rsslChannelImpl* rss
 			RTR_GET_8(tmpChar, &pSeqMcastChannel->inputBuffer.data[pSeqMcastChannel->processedPacketLen]);
 
 			readFlags = (RsslInt32)tmpChar;
-			if (readFlags & SEQ_MCAST_FLAGS_RETRANSMIT)
-				readOutArgs->readOutFlags |= RSSL_READ_OUT_RETRANSMIT; 	
+			pSeqMcastChannel->readRetransmit = (readFlags & SEQ_MCAST_FLAGS_RETRANSMIT) ? RSSL_TRUE : RSSL_FALSE;
 
 			pSeqMcastChannel->processedPacketLen += SEQ_MCAST_FLAGS_LEN;
 
@@ -1115,6 +1191,11 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslBuffer*) rsslSeqMcastRead(rsslChannelImpl* rss
 			}
 			*readRet = remainingLen;
 		}
+
+		/* Held packets that are now in order don't make the socket readable */
+		if (*readRet == 0 && pSeqMcastChannel->pRecovery && rsslSeqMcastRecoveryPending(pSeqMcastChannel->pRecovery))
+			*readRet = 1;
+
 		if (chnlLocking)
 			seqMcastUnlock(&pSeqMcastChannel->lock);
 	}
@@ -1130,6 +1211,8 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslBuffer*) rsslSeqMcastRead(rsslChannelImpl* rss
 	readOutArgs->nodeId.nodeAddr = pSeqMcastChannel->readAddr;
 	readOutArgs->nodeId.port = pSeqMcastChannel->readPort;
 	readOutArgs->instanceId = pSeqMcastChannel->readInstanceID;
+	if (pSeqMcastChannel->readRetransmit)
+		readOutArgs->readOutFlags |= RSSL_READ_OUT_RETRANSMIT;
 
 	if ((rsslChnlImpl->debugFlags & RSSL_DEBUG_RSSL_DUMP_IN) && (pSeqMcastChannel->readBuffer.length))
 		(*(rsslSeqMcastDumpInFunc))(__FUNCTION__, pSeqMcastChannel->readBuffer.data, pSeqMcastChannel->readBuffer.length, rsslChnlImpl->Channel.socketId);
@@ -1279,7 +1362,7 @@ RSSL_RSSL_SEQ_MCAST_IMPL_FAST(RsslRet) rsslSeqMcastWrite(rsslChannelImpl *rsslCh
 	/* send packet */
 	do
 	{
-		if ((ret = sendto(rsslChnlImpl->Channel.socketId, seqMcastBuffer->buffer + hdrOffset,
+		if ((ret = sendto(pSeqMcastChannel->mcastSock, seqMcastBuffer->buffer + hdrOffset,
 						  pktLength, 0, (struct sockaddr*)&pSeqMcastChannel->sendAddr, sizeof(pSeqMcastChannel->sendAddr))) < 0)
 		{
 			if(errno == EWOULDBLOCK || errno == EAGAIN)
@@ -1341,6 +1424,8 @@ RsslRet rsslSeqMcastSetChannelFunctions()
 	funcs.channelGetBuffer = rsslSeqMcastGetBuffer;
 	funcs.channelGetInfo = rsslSeqMcastGetChannelInfo;
 	funcs.channelIoctl = rsslSeqMcastIoctl;
+	funcs.channelWriteShared = 0;
+	funcs.releaseSharedMsg = 0;
 	funcs.channelPackBuffer = rsslSeqMcastPackBuffer;
 	funcs.channelPing = rsslSeqMcastPing;
 	funcs.channelRead = rsslSeqMcastRead;
@@ -14,6 +14,7 @@
 #include "rtr/rsslErrors.h"
 #include "rtr/ripcflip.h"
 #include "rtr/ripcutils.h"
+#include "rtr/ripcshmutils.h"
 #include "rtr/rtratomic.h"
 #include "rtr/rsslQueue.h"
 #include "lz4.h"
@@ -31,6 +32,11 @@
 #include "rtr/ripcsslutils.h"
 #endif
 
+#ifdef Linux
+#include <sys/eventfd.h>
+#include <poll.h>
+#endif
+
 #if defined(_WIN32)
 #include <process.h>
 #include <signal.h>
@@ -88,6 +94,8 @@ static ripcSessInit ipcConnecting(RsslSocketChannel *rsslSocketChannel, ripcSess
 static ripcSessInit ipcProxyConnecting(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *inPr, RsslError *error);
 static ripcSessInit ipcClientAccept(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *inPr, RsslError *error);
 static ripcSessInit ipcReconnectSocket(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *inPr, RsslError *error);
+static void ipcZeroCopyReap(RsslSocketChannel *rsslSocketChannel, RsslSocket fd);
+static void ipcReleaseZeroCopyClosed(RsslBool reset);
 ripcSessInit ipcWaitProxyAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *inPr, RsslError *error);
 RsslRet ipcIntWrtHeader(RsslSocketChannel *rssl, RsslError *error);
 ripcSessInit ipcSessionInit(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *inPr, RsslError *error);
@@ -98,6 +106,8 @@ RsslRet rsslSocketGetSockOpts(RsslSocketChannel *rsslSocketChannel, RsslInt32 co
 
 RsslRet ripcInitZlibComp();
 RsslRet ripcInitLz4Comp();
+RsslRet ripcInitZstdComp(char *libzstdName);
+void ripcUninitZstdComp();
 
 // used to assign global sessionID's for each session. Will need to optimize to reuse session ID
 static RsslUInt32					g_sessionID = 0;
@@ -117,6 +127,7 @@ static RsslUInt32			shutdownFlag =  SHUT_WR;
 static RsslMutex		ripcMutex;
 static RsslQueue			activeSocketChannelList;
 static RsslQueue			freeSocketChannelList;
+static RsslQueue			zeroCopyClosedList;		/* released channels waiting for their zero copy sends to complete */
 static RsslQueue			freeServerSocketChannelList;
 
 /* Used to tell if openSSL has been loaded */
@@ -137,6 +148,7 @@ static ripcCompFuncs	compressFuncs[RSSL_COMP_MAX_TYPE + 1];
 
 static const RsslUInt32	RSSL_COMP_DFLT_THRESHOLD_ZLIB = 30;
 static const RsslUInt32	RSSL_COMP_DFLT_THRESHOLD_LZ4 = 300;
+static const RsslUInt32	RSSL_COMP_DFLT_THRESHOLD_ZSTD = 30;
 
 static RsslInitializeExOpts  transOpts = RSSL_INIT_INITIALIZE_EX_OPTS; 
 
@@ -152,7 +164,11 @@ static rtr_atomic_val		gblmutexinit = 0;
 
 static u8 ripccompressions[][3]	=	{	{ 0, 0x00, RSSL_COMP_NONE  },	/* no compression	*/
 										{ 0, 0x01, RSSL_COMP_ZLIB  },	/* zlib compression	*/
-										{ 0, 0x02, RSSL_COMP_LZ4 } };	/* LZ4 compression	*/
+										{ 0, 0x02, RSSL_COMP_LZ4 },		/* LZ4 compression	*/
+										{ 0, 0x04, RSSL_COMP_ZSTD } };	/* zstd compression	*/
+
+/* the table is not indexed by type, so search it with this many entries */
+#define RIPC_COMP_TABLE_SIZE ((RsslInt32)(sizeof(ripccompressions) / sizeof(ripccompressions[0])))
 
 /* winInet tunneling */
 #include "rtr/ripcinetutils.h"
@@ -167,6 +183,8 @@ extern RIPC_SESS_VERS ripc13Ver;
 extern RIPC_SESS_VERS ripc13WinInetVer;
 extern RIPC_SESS_VERS ripc14Ver;
 extern RIPC_SESS_VERS ripc14WinInetVer;
+extern RIPC_SESS_VERS ripc15Ver;
+extern RIPC_SESS_VERS ripc15WinInetVer;
 
 /************* global variables ************/
 //#define IPC_DEBUG
@@ -444,6 +462,9 @@ RsslSocketChannel* newRsslSocketChannel()
 		(void) RSSL_MUTEX_LOCK(&ripcMutex);
 	}
 
+	if (rsslQueueGetElementCount(&zeroCopyClosedList))
+		ipcReleaseZeroCopyClosed(RSSL_FALSE);
+
 	if ((pLink = rsslQueuePeekFront(&freeSocketChannelList)) == 0)
 		rsslSocketChannel = createRsslSocketChannel();
 	else
@@ -460,6 +481,10 @@ RsslSocketChannel* newRsslSocketChannel()
 		(void) RSSL_MUTEX_UNLOCK(&ripcMutex);
 	}
 
+	/* the channel's buffers are placed on the node of the thread connecting or accepting it */
+	if (rsslSocketChannel)
+		rsslSocketChannel->pageArena = rsslPageArenaForThread();
+
     if (rtrUnlikely(refdebug)) printf("newRsslSocketChannel() RsslSocketChannel=0x%p\n",rsslSocketChannel);
 
 	return rsslSocketChannel;	
@@ -499,6 +524,76 @@ RsslServerSocketChannel* newRsslServerSocketChannel()
     return rsslServerSocketChannel;
 }
 
+/* Reads into the input buffer at buf.  With receive timestamps on, the timestamps
+ * of the reads are kept in offset order so each message can be given the receive
+ * time of the read that completed it. */
+RTR_C_INLINE int ipcReadInput(RsslSocketChannel *rsslSocketChannel, char *buf, int len, ripcRWFlags rwflags, RsslError *error)
+{
+	RsslUInt32 offset;
+	RsslUInt32 first;
+	RsslUInt32 added;
+	int cc;
+
+	if (rtrLikely(!rsslSocketChannel->recvTimestamps))
+		return (*(rsslSocketChannel->transportFuncs->readTransport))(rsslSocketChannel->transportInfo, buf, len, rwflags, error);
+
+	offset = (RsslUInt32)(buf - rsslSocketChannel->inputBuffer->buffer);
+	if (offset == 0)
+	{
+		rsslSocketChannel->recvStampHead = 0;
+		rsslSocketChannel->recvStampCount = 0;
+	}
+	else if (rsslSocketChannel->recvStampCount == RIPC_RECV_STAMP_COUNT)
+	{
+		if (rsslSocketChannel->recvStampHead)
+		{
+			rsslSocketChannel->recvStampCount -= rsslSocketChannel->recvStampHead;
+			memmove(rsslSocketChannel->recvStamps, rsslSocketChannel->recvStamps + rsslSocketChannel->recvStampHead,
+				rsslSocketChannel->recvStampCount * sizeof(ripcRecvStamp));
+			rsslSocketChannel->recvStampHead = 0;
+		}
+		else
+		{
+			/* Give up the newest entry; its bytes take the later time of this read. */
+			rsslSocketChannel->recvStampCount--;
+		}
+	}
+
+	first = rsslSocketChannel->recvStampCount;
+	cc = ipcReadTimestamp(rsslSocketChannel->transportInfo, buf, len, rwflags, rsslSocketChannel->recvStamps + first,
+		&added, RIPC_RECV_STAMP_COUNT - first, error);
+
+	for (rsslSocketChannel->recvStampCount = first; added; --added)
+		rsslSocketChannel->recvStamps[rsslSocketChannel->recvStampCount++].endOffset += offset;
+
+	return cc;
+}
+
+/* Keeps reading the empty input buffer until data arrives or the busy poll time is used up */
+static int ipcBusyPollInput(RsslSocketChannel *rsslSocketChannel, ripcRWFlags rwflags, RsslError *error)
+{
+	RsslUInt64 deadline = ipcGetTimeNano() + (RsslUInt64)rsslSocketChannel->busyPollUsec * 1000;
+	int cc;
+
+	do
+	{
+		cc = ipcReadInput(rsslSocketChannel, rsslSocketChannel->inputBuffer->buffer, rsslSocketChannel->readSize, rwflags, error);
+	} while ((cc == 0) && (ipcGetTimeNano() < deadline));
+
+	return cc;
+}
+
+/* Sets lastRecvStamp to the receive time of the input buffer bytes ending at msgEnd */
+RTR_C_INLINE void ipcRecvStampLookup(RsslSocketChannel *rsslSocketChannel, RsslUInt32 msgEnd)
+{
+	while ((rsslSocketChannel->recvStampHead < rsslSocketChannel->recvStampCount) &&
+		(rsslSocketChannel->recvStamps[rsslSocketChannel->recvStampHead].endOffset < msgEnd))
+		rsslSocketChannel->recvStampHead++;
+
+	if (rsslSocketChannel->recvStampHead < rsslSocketChannel->recvStampCount)
+		rsslSocketChannel->lastRecvStamp = rsslSocketChannel->recvStamps[rsslSocketChannel->recvStampHead].stamp;
+}
+
 /*********************************************
 *	The following defines the functions needed
 *	for reading ipc messages
@@ -562,8 +657,9 @@ rtr_msgb_t *ipcReadSession( RsslSocketChannel *rsslSocketChannel, RsslRet *readr
 #endif
 		IPC_MUTEX_UNLOCK(rsslSocketChannel);
 
-		cc = (*(rsslSocketChannel->transportFuncs->readTransport))(rsslSocketChannel->transportInfo,
-			rsslSocketChannel->inputBuffer->buffer, rsslSocketChannel->readSize, rwflags, error);
+		cc = ipcReadInput(rsslSocketChannel, rsslSocketChannel->inputBuffer->buffer, rsslSocketChannel->readSize, rwflags, error);
+		if ((cc == 0) && rsslSocketChannel->busyPollUsec && !rsslSocketChannel->blocking)
+			cc = ipcBusyPollInput(rsslSocketChannel, rwflags, error);
 
 #ifdef MUTEX_DEBUG
 	printf("LOCK rsslSocketChannel -- ipcReadSession (after transportFuncs->readTransport)\n");
@@ -654,8 +750,7 @@ rtr_msgb_t *ipcReadSession( RsslSocketChannel *rsslSocketChannel, RsslRet *readr
 #endif
 				IPC_MUTEX_UNLOCK(rsslSocketChannel);
 
-				cc = (*(rsslSocketChannel->transportFuncs->readTransport))(
-					rsslSocketChannel->transportInfo,
+				cc = ipcReadInput(rsslSocketChannel,
 					(rsslSocketChannel->inputBuffer->buffer + rsslSocketChannel->inputBuffer->length),
 					((IPC_header_size + extendedHdr) - tempLen), rwflags, error);
 
@@ -817,8 +912,7 @@ rtr_msgb_t *ipcReadSession( RsslSocketChannel *rsslSocketChannel, RsslRet *readr
 #endif
 			IPC_MUTEX_UNLOCK(rsslSocketChannel);
 
-			cc = (*(rsslSocketChannel->transportFuncs->readTransport))(
-				rsslSocketChannel->transportInfo,
+			cc = ipcReadInput(rsslSocketChannel,
 				(rsslSocketChannel->inputBuffer->buffer + rsslSocketChannel->inputBuffer->length),
 				(ipcLen - tempLen), rwflags, error);
 
@@ -897,6 +991,9 @@ rtr_msgb_t *ipcReadSession( RsslSocketChannel *rsslSocketChannel, RsslRet *readr
 	}
 
 	/* if we get here, we have a full message with respect to the length in the ripc header */
+	if (rsslSocketChannel->recvTimestamps)
+		ipcRecvStampLookup(rsslSocketChannel, rsslSocketChannel->inputBufCursor + ipcLen);
+
 	/* if it was compressed, we should decompress it before processing the rest of the header */
 	if (ipcOpcode & IPC_COMP_DATA)
 	{
@@ -1174,6 +1271,7 @@ rtr_msgb_t *ipcReadSession( RsslSocketChannel *rsslSocketChannel, RsslRet *readr
 	/* Need seperate handling for this because of different fragID length */
 	case CONN_VERSION_13:
 	case CONN_VERSION_14:
+	case CONN_VERSION_15:
 	{
 		RsslUInt16 sFragId;
 
@@ -1475,6 +1573,12 @@ RsslInt32 ipcReleaseDataBuffer(RsslSocketChannel *rsslSocketChannel, rtr_msgb_t
 	return(retval);
 }
 
+/* Input, decompression and compression buffers of a channel, from its page arena if it has one */
+static rtr_msgb_t *ipcAllocChannelMsg(RsslSocketChannel *rsslSocketChannel, size_t size)
+{
+	return rtr_smplcAllocArenaMsg(gblInputBufs, size, rsslSocketChannel->pageArena);
+}
+
 rtr_bufferpool_t *ipcCreatePool(RsslInt32 max_bufs, RsslMutex *mutex)
 {
 	rtr_bufferpool_t *retpool = NULL;
@@ -1485,6 +1589,8 @@ rtr_bufferpool_t *ipcCreatePool(RsslInt32 max_bufs, RsslMutex *mutex)
 	{
 		return(retpool);
 	}
+	/* the server's shared pool is placed on the node of the thread binding it */
+	(void)rtr_dfltcSetPageArena(cpool, rsslPageArenaForThread());
 	retpool = &(cpool->bufpool);
 	return(retpool);
 }
@@ -1586,6 +1692,7 @@ RsslInt32 ipcIntWrtHeader(RsslSocketChannel *rsslSocketChannel, RsslError *error
 	case CONN_VERSION_12:
 	case CONN_VERSION_13:
 	case CONN_VERSION_14:
+	case CONN_VERSION_15:
 		messageLength = (RsslUInt16)(IPC_header_size);
 		flags |= IPC_DATA;
 
@@ -1649,6 +1756,8 @@ RsslInt32 ipcIntWrtHeader(RsslSocketChannel *rsslSocketChannel, RsslError *error
 	else
 	{
 		/* pings are always assumed high priority */
+		if (rsslSocketChannel->weightedFlush)
+			buffer->queueTime = ipcGetTimeNano();
 		rsslQueueAddLinkToBack(&(rsslSocketChannel->priorityQueues[0].priorityQueue), &(buffer->link));
 	}
 
@@ -1661,11 +1770,111 @@ RsslInt32 ipcIntWrtHeader(RsslSocketChannel *rsslSocketChannel, RsslError *error
 }
 
 
+/* Returns the compression statistics size class for a message of this length */
+RTR_C_INLINE ripcCompBucket *ripcCompGetBucket(RsslSocketChannel *rsslSocketChannel, RsslUInt32 length)
+{
+	RsslInt32 i = 0;
+
+	length /= RIPC_COMP_BUCKET_MIN_LENGTH;
+	while (length && (i < RSSL_COMP_STATS_BUCKET_COUNT - 1))
+	{
+		length >>= 1;
+		++i;
+	}
+
+	return &rsslSocketChannel->compBuckets[i];
+}
+
+/* Adaptive compression: returns 1 if the message should be sent uncompressed
+ * because its size class is in a bypass period. */
+RTR_C_INLINE RsslInt32 ripcCompBypass(ripcCompBucket *bucket)
+{
+	if (bucket->bypassLeft == 0)
+		return 0;
+
+	++bucket->stats.bypassedMsgs;
+
+	/* the next message of this class is compressed again to see if it pays off now */
+	if (--bucket->bypassLeft == 0)
+		bucket->stats.bypassed = RSSL_FALSE;
+
+	return 1;
+}
+
+/* Records a compressed message.  With adaptive compression on, each full sample
+ * is checked against the channel's minimum savings and maximum cost; a class that
+ * saves too little or costs too much compression time for what it saves is
+ * bypassed, and the bypass period doubles while retries keep falling short.
+ * timeNsec is only measured while adaptive compression is on. */
+RTR_C_INLINE void ripcCompRecord(RsslSocketChannel *rsslSocketChannel, ripcCompBucket *bucket, RsslUInt32 bytesIn, RsslUInt32 bytesOut, RsslUInt64 timeNsec)
+{
+	RsslUInt64 saved;
+
+	++bucket->stats.compressedMsgs;
+	bucket->stats.bytesIn += bytesIn;
+	bucket->stats.bytesOut += bytesOut;
+	bucket->stats.compressTimeNsec += timeNsec;
+
+	if (rsslSocketChannel->compMinSavings == 0)
+		return;
+
+	bucket->sampleIn += bytesIn;
+	bucket->sampleOut += bytesOut;
+	bucket->sampleNsec += timeNsec;
+	if (++bucket->sampleMsgs < RIPC_COMP_SAMPLE_MSGS)
+		return;
+
+	saved = (bucket->sampleIn > bucket->sampleOut) ? bucket->sampleIn - bucket->sampleOut : 0;
+	if ((bucket->sampleOut * 100 > bucket->sampleIn * (100 - rsslSocketChannel->compMinSavings)) ||
+		(rsslSocketChannel->compMaxCost && (bucket->sampleNsec * 1024 > saved * rsslSocketChannel->compMaxCost)))
+	{
+		bucket->stats.bypassed = RSSL_TRUE;
+		bucket->bypassLeft = bucket->bypassLength;
+		if (bucket->bypassLength < RIPC_COMP_MAX_BYPASS)
+			bucket->bypassLength <<= 1;
+	}
+	else
+		bucket->bypassLength = RIPC_COMP_MIN_BYPASS;
+
+	bucket->sampleIn = 0;
+	bucket->sampleOut = 0;
+	bucket->sampleNsec = 0;
+	bucket->sampleMsgs = 0;
+}
+
+/* Once a message is queued, flushes the queues if it was a direct write, if they are over the high water mark, or if
+ * the coalescing time has run out.  Returns the number of bytes waiting to be written.  The channel lock must already
+ * be held. */
+RTR_C_INLINE RsslRet ipcWriteQueued(RsslSocketChannel *rsslSocketChannel, RsslInt32 directWrite, RsslError *error)
+{
+	RsslRet		retval = 0;
+	RsslInt32	i;
+
+	for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+		retval += rsslSocketChannel->priorityQueues[i].queueLength;
+
+	if (directWrite || (retval >(RsslInt32)rsslSocketChannel->high_water_mark))
+	{
+		retval = ipcFlushSession(rsslSocketChannel, error);
+	}
+	else if ((retval > 0) && rsslSocketChannel->coalesceWriteNsec)
+	{
+		/* Coalescing: the first held write starts the clock, and the first write after it runs out flushes everything */
+		RsslUInt64 now = ipcGetTimeNano();
+
+		if (rsslSocketChannel->coalesceDeadline == 0)
+			rsslSocketChannel->coalesceDeadline = now + rsslSocketChannel->coalesceWriteNsec;
+		else if (now >= rsslSocketChannel->coalesceDeadline)
+			retval = ipcFlushSession(rsslSocketChannel, error);
+	}
+
+	return retval;
+}
+
 RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rsslBufferImpl, RsslInt32 wFlags, RsslInt32 *bytesWritten, 
 	RsslInt32 *uncompBytesWritten, RsslInt32 forceFlush, RsslError *error)
 {
 	RsslRet			retval = RSSL_RET_SUCCESS;
-	RsslInt32		i = 0;
 	RsslInt32		totalSize;
 	caddr_t			hdr;
 	caddr_t			chunkhdr;
@@ -1681,6 +1890,7 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 	RsslUInt16		httpHeaderLen = 0;
 	RsslUInt16		tempLen;
 	rtr_msgb_t		*compressedmb1;
+	ripcCompBucket	*compBucket = 0;
 	rtr_msgb_t		*ripcBuffer = NULL;
 	rtr_msgb_t		**msgb = NULL;
 	RsslUInt32		size = rsslBufferImpl->buffer.length;
@@ -1810,6 +2020,7 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 			case CONN_VERSION_12:
 			case CONN_VERSION_13: /* even though ver 13 has two byte frag ID, didnt want to duplicate all this code */
 			case CONN_VERSION_14:
+			case CONN_VERSION_15:
 				/* if we are compressing, and
 				* the compressQueue we are using matches this message or hasnt been set and
 				* the message is greater or equal to than the minimum size
@@ -1820,21 +2031,27 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 					((rsslSocketChannel->safeLZ4 == 0) || ((rsslSocketChannel->safeLZ4 == 1) && ((*msgb)->length <= rsslSocketChannel->upperCompressionThreshold))) &&
 					(!(wFlags & RIPC_WRITE_DO_NOT_COMPRESS)))
 				{
-					/* get first buffer to compress into */
-					/* need to unlock the mutex to avoid deadlock */
+					compBucket = ripcCompGetBucket(rsslSocketChannel, (RsslUInt32)(*msgb)->length);
+
+					/* adaptive compression sends size classes that are not saving enough uncompressed */
+					if ((rsslSocketChannel->compMinSavings == 0) || (ripcCompBypass(compBucket) == 0))
+					{
+						/* get first buffer to compress into */
+						/* need to unlock the mutex to avoid deadlock */
 #ifdef MUTEX_DEBUG
-					printf("UNLOCK rsslSocketChannel -- ipcWriteSession (before ipcDataBuffer)\n");
+						printf("UNLOCK rsslSocketChannel -- ipcWriteSession (before ipcDataBuffer)\n");
 #endif
-					IPC_MUTEX_UNLOCK(rsslSocketChannel);
+						IPC_MUTEX_UNLOCK(rsslSocketChannel);
 
-					compressedmb1 = ipcDataBuffer(rsslSocketChannel, rsslSocketChannel->maxUserMsgSize, error);
+						compressedmb1 = ipcDataBuffer(rsslSocketChannel, rsslSocketChannel->maxUserMsgSize, error);
 
 #ifdef MUTEX_DEBUG
-					printf("LOCK rsslSocketChannel -- ipcWriteSession (after ipcDataBuffer)\n");
+						printf("LOCK rsslSocketChannel -- ipcWriteSession (after ipcDataBuffer)\n");
 #endif
-					IPC_MUTEX_LOCK(rsslSocketChannel);
+						IPC_MUTEX_LOCK(rsslSocketChannel);
 
-					/* if this failed, just send it normally */
+						/* if this failed, just send it normally */
+					}
 				}
 
 				/* if we couldnt get a buffer or we are not compressing go through this code */
@@ -1936,6 +2153,8 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 					RsslUInt8				headerLength = 0;
 					rtr_msgb_t				*compressedmb2;
 					ripcCompBuffer				compBuf;
+					RsslUInt64				compTime = 0;
+					RsslUInt32				compBytesOut;
 
 #ifdef IPC_DEBUG
 					if (rtrUnlikely(readdebug))
@@ -2031,6 +2250,9 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 					compBuf.next_in = (*msgb)->buffer + headerLength;
 					compBuf.avail_in = messageLength - headerLength;
 
+					/* compression is only timed for adaptive compression */
+					if (rsslSocketChannel->compMinSavings)
+						compTime = ipcGetTimeNano();
 					if ((*(rsslSocketChannel->outCompFuncs->compress)) (rsslSocketChannel->c_stream_out, &compBuf, error) < 0)
 					{
 						_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -2041,8 +2263,11 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 						retval = RSSL_RET_FAILURE;
 						break;
 					}
+					if (rsslSocketChannel->compMinSavings)
+						compTime = ipcGetTimeNano() - compTime;
 
 					compLen1 = compBuf.bytes_out_used;
+					compBytesOut = compBuf.bytes_out_used;
 #ifdef IPC_DEBUG
 					if (rtrUnlikely(readdebug))
 						printf("#1 compressed %d bytes into %d bytes (avail_out = %d)\n", messageLength - headerLength, compLen1, compBuf.avail_out);
@@ -2188,6 +2413,7 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 							if (!queuedBytesToWrite)
 							{
 								/* pass the buffer directly to write and free the buffer */
+								rsslSocketChannel->writeSysCalls++;
 
 								if (rsslSocketChannel->httpHeaders)
 									cc = (*(rsslSocketChannel->transportFuncs->writeTransport))(rsslSocketChannel->tunnelStreamFd, compressedmb1->local, lenToWrite, rwflags, error);
@@ -2283,6 +2509,8 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 						{
 							/* put it in the correct priority out list */
 							rsslSocketChannel->priorityQueues[compressedmb1->priority].queueLength += totalSize;
+							if (rsslSocketChannel->weightedFlush)
+								compressedmb1->queueTime = ipcGetTimeNano();
 							rsslQueueAddLinkToBack(&(rsslSocketChannel->priorityQueues[compressedmb1->priority].priorityQueue), &(compressedmb1->link));
 						}
 
@@ -2329,9 +2557,13 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 						else
 						{
 							/* have to continue compressing */
+							RsslUInt64 compTime2 = 0;
+
 							compBuf.next_out = compressedmb2->buffer + headerLength;
 							compBuf.avail_out = (unsigned long)(compressedmb2->maxLength - headerLength - footer_size);
 
+							if (rsslSocketChannel->compMinSavings)
+								compTime2 = ipcGetTimeNano();
 							if ((*(rsslSocketChannel->outCompFuncs->compress)) (rsslSocketChannel->c_stream_out, &compBuf, error) < 0)
 							{
 								_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -2341,9 +2573,13 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 								retval = RSSL_RET_FAILURE;
 								break;
 							}
+							if (rsslSocketChannel->compMinSavings)
+								compTime += ipcGetTimeNano() - compTime2;
 
 							compLen2 = compBuf.bytes_out_used;
+							compBytesOut += compBuf.bytes_out_used;
 						}
+						ripcCompRecord(rsslSocketChannel, compBucket, messageLength - headerLength, compBytesOut, compTime);
 #ifdef IPC_DEBUG
 						if (rtrUnlikely(readdebug))
 							printf("#2 compressed %d bytes into %d bytes (avail_out = %d)\n",
@@ -2393,6 +2629,8 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 					else
 					{
 						/* non compression fragmentation case (e.g. single compressed buffer) */
+						ripcCompRecord(rsslSocketChannel, compBucket, messageLength - headerLength, compBytesOut, compTime);
+
 						compLen1 += headerLength - httpHeaderLen;
 
 						/* add the chunking header if we are tunneling */
@@ -2503,6 +2741,7 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 				if (!queuedBytesToWrite)
 				{
 					/* pass the buffer directly to write and free the buffer */
+					rsslSocketChannel->writeSysCalls++;
 					if (rsslSocketChannel->httpHeaders)
 						cc = (*(rsslSocketChannel->transportFuncs->writeTransport))(rsslSocketChannel->tunnelStreamFd, (*msgb)->local, lenToWrite, rwflags, error);
 					else
@@ -2627,6 +2866,8 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 						printf("#2 Queuing %d bytes (forceFlush=%d, queueLength=%d)\n", totalSize, forceFlush, rsslSocketChannel->priorityQueues[(*msgb)->priority].queueLength);
 #endif
 
+					if (rsslSocketChannel->weightedFlush)
+						(*msgb)->queueTime = ipcGetTimeNano();
 					rsslQueueAddLinkToBack(&(rsslSocketChannel->priorityQueues[(*msgb)->priority].priorityQueue), &((*msgb)->link));
 					rsslSocketChannel->bytesOutLastMsg += (RsslUInt32)((*msgb)->length);
 				}
@@ -2684,24 +2925,299 @@ RsslRet ipcWriteSession(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rs
 	}
 
 	if (retval != RSSL_RET_FAILURE)
+		retval = ipcWriteQueued(rsslSocketChannel, forceFlush == RSSL_WRITE_DIRECT_SOCKET_WRITE, error);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel ipcWriteSession (end)\n");
+#endif
+	IPC_MUTEX_UNLOCK(rsslSocketChannel);
+
+	return(retval);
+}
+
+/* Queues a message, already framed, that is held in a shared data block (see rsslSocketWriteShared).  Returns what
+ * ipcWriteSession() would, and sets bytesWritten once the message is queued. */
+static RsslRet ipcWriteSharedSession(RsslSocketChannel *rsslSocketChannel, rtr_datab_t *sharedMsg, RsslInt32 priority, RsslInt32 directWrite,
+	RsslInt32 *bytesWritten, RsslError *error)
+{
+	rtr_msgb_t		*msgb;
+	RsslRet			retval;
+
+#ifdef MUTEX_DEBUG
+	printf("LOCK rsslSocketChannel -- ipcWriteSharedSession (start)\n");
+#endif
+	IPC_MUTEX_LOCK(rsslSocketChannel);
+
+	if (rsslSocketChannel->workState & RIPC_INT_SHTDOWN_PEND)
 	{
-		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
-			retval += rsslSocketChannel->priorityQueues[i].queueLength;
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1003 ipcWriteSharedSession() failed due to channel shutting down.\n",
+			__FILE__, __LINE__);
 
-		if ((forceFlush == RSSL_WRITE_DIRECT_SOCKET_WRITE) || (retval >(RsslInt32)rsslSocketChannel->high_water_mark))
-		{
-			retval = ipcFlushSession(rsslSocketChannel, error);
-		}
+#ifdef MUTEX_DEBUG
+		printf("UNLOCK rsslSocketChannel ipcWriteSharedSession (end)\n");
+#endif
+		IPC_MUTEX_UNLOCK(rsslSocketChannel);
+		return RSSL_RET_FAILURE;
 	}
 
+	if ((msgb = rtr_dfltcRefSharedDatab(&(rsslSocketChannel->guarBufPool->bufpool), sharedMsg, sharedMsg->length)) == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_BUFFER_NO_BUFFERS, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1009 ipcWriteSharedSession() failed, out of output buffers.\n",
+			__FILE__, __LINE__);
+
 #ifdef MUTEX_DEBUG
-	printf("UNLOCK rsslSocketChannel ipcWriteSession (end)\n");
+		printf("UNLOCK rsslSocketChannel ipcWriteSharedSession (end)\n");
+#endif
+		IPC_MUTEX_UNLOCK(rsslSocketChannel);
+		return RSSL_RET_BUFFER_NO_BUFFERS;
+	}
+
+	msgb->priority = priority;
+	msgb->local = msgb->buffer;
+	if (rsslSocketChannel->weightedFlush)
+		msgb->queueTime = ipcGetTimeNano();
+
+	rsslSocketChannel->priorityQueues[priority].queueLength += (RsslInt32)msgb->length;
+	rsslQueueAddLinkToBack(&(rsslSocketChannel->priorityQueues[priority].priorityQueue), &(msgb->link));
+	rsslSocketChannel->bytesOutLastMsg = (RsslUInt32)msgb->length;
+	*bytesWritten = (RsslInt32)msgb->length;
+
+	retval = ipcWriteQueued(rsslSocketChannel, directWrite, error);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel ipcWriteSharedSession (end)\n");
 #endif
 	IPC_MUTEX_UNLOCK(rsslSocketChannel);
 
 	return(retval);
 }
 
+/* Reads zero copy completions from the error queue of socket fd and releases
+ * the written buffers of every send that has completed, in send order.  The
+ * caller holds the channel's write lock, or ripcMutex for a released channel. */
+static void ipcZeroCopyReap(RsslSocketChannel *rsslSocketChannel, RsslSocket fd)
+{
+	RsslUInt32			lo, hi, id;
+	int					copied;
+	RIPC_ZEROCOPY_SEND	*zcSend;
+	RsslQueueLink		*pLink = 0;
+
+	while (ipcZeroCopyCompletion(fd, &lo, &hi, &copied) > 0)
+	{
+		if (copied)
+			rsslSocketChannel->zeroCopyNumCopied += (hi - lo + 1);
+
+		for (id = lo; ; id++)
+		{
+			/* Only mark ids that are still outstanding */
+			if ((id - rsslSocketChannel->zeroCopyDoneId) < (rsslSocketChannel->zeroCopyNextId - rsslSocketChannel->zeroCopyDoneId))
+				rsslSocketChannel->zeroCopySends[id % RIPC_MAX_ZEROCOPY_SENDS].done = 1;
+			if (id == hi)
+				break;
+		}
+	}
+
+	while (rsslSocketChannel->zeroCopyDoneId != rsslSocketChannel->zeroCopyNextId)
+	{
+		zcSend = &rsslSocketChannel->zeroCopySends[rsslSocketChannel->zeroCopyDoneId % RIPC_MAX_ZEROCOPY_SENDS];
+		if (!zcSend->done)
+			break;
+
+		while (zcSend->numBufs > 0 && (pLink = rsslQueueRemoveFirstLink(&rsslSocketChannel->zeroCopyBufs)) != 0)
+		{
+			rtr_dfltcFreeMsg(RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink));
+			zcSend->numBufs--;
+		}
+		zcSend->numBufs = 0;
+		zcSend->done = 0;
+		rsslSocketChannel->zeroCopyDoneId++;
+	}
+}
+
+/* Channels released with zero copy sends outstanding are kept on
+ * zeroCopyClosedList with their socket and buffer pool, since the kernel may
+ * still be sending from the pool.  This reaps their completions, and once a
+ * channel has none outstanding, closes its socket, gives back its pool and
+ * puts it on the free list.  With reset, used when the transport is
+ * uninitialized, the connections are reset first, which has the kernel drop
+ * the unsent data and complete the sends; a channel whose sends still have
+ * not completed is closed and its buffers are left allocated.  Called with
+ * ripcMutex held. */
+static void ipcReleaseZeroCopyClosed(RsslBool reset)
+{
+	RsslQueueLink		*pLink, *pNext;
+	RsslSocketChannel	*rsslSocketChannel;
+
+	for (pLink = rsslQueuePeekFront(&zeroCopyClosedList); pLink != 0; pLink = pNext)
+	{
+		pNext = rsslQueuePeekNext(&zeroCopyClosedList, pLink);
+		rsslSocketChannel = RSSL_QUEUE_LINK_TO_OBJECT(RsslSocketChannel, link1, pLink);
+
+		if (reset)
+			ipcZeroCopyAbort(rsslSocketChannel->zeroCopyStream);
+
+		ipcZeroCopyReap(rsslSocketChannel, rsslSocketChannel->zeroCopyStream);
+		if (rsslSocketChannel->zeroCopyNextId != rsslSocketChannel->zeroCopyDoneId)
+		{
+			if (reset)
+			{
+				sock_close(rsslSocketChannel->zeroCopyStream);
+				rsslQueueRemoveLink(&zeroCopyClosedList, pLink);
+			}
+			continue;
+		}
+
+		sock_close(rsslSocketChannel->zeroCopyStream);
+		rtr_dfltcDropRef(&(rsslSocketChannel->guarBufPool->bufpool));
+		rsslSocketChannel->guarBufPool = 0;
+
+		rsslQueueRemoveLink(&zeroCopyClosedList, pLink);
+		ripcClearRsslSocketChannel(rsslSocketChannel);
+		rsslQueueAddLinkToFront(&freeSocketChannelList, &(rsslSocketChannel->link1));
+	}
+}
+
+/* Releases a buffer that has been completely written.  If any part of it went
+ * out with a zero copy send that is still outstanding, the kernel may still
+ * reference it, so it is held until the most recent zero copy send completes. */
+RTR_C_INLINE void ipcReleaseWrittenBuffer(RsslSocketChannel *rsslSocketChannel, rtr_msgb_t *msgb, RsslBool zeroCopy)
+{
+	if (zeroCopy && (rsslSocketChannel->zeroCopyNextId != rsslSocketChannel->zeroCopyDoneId))
+	{
+		rsslQueueAddLinkToBack(&rsslSocketChannel->zeroCopyBufs, &(msgb->link));
+		rsslSocketChannel->zeroCopySends[(rsslSocketChannel->zeroCopyNextId - 1) % RIPC_MAX_ZEROCOPY_SENDS].numBufs++;
+	}
+	else
+		rtr_dfltcFreeMsg(msgb);
+}
+
+/* Weighted flushing (RSSL_PRIORITY_FLUSH_WEIGHTS) is a deficit round robin over the priority queues, counted in bytes.
+ * On its turn a queue is credited its weight and flushes buffers for as long as they fit in its credit; a queue
+ * that empties loses whatever credit it has left.  Each buffer is charged when it is chosen, against the caller's
+ * copy of the round robin state. */
+
+/* Returns the next buffer to flush and sets *priority to its queue, or returns 0 if nothing is left to flush */
+static rtr_msgb_t *ipcWeightedFlushNext(RsslSocketChannel *rsslSocketChannel, ripcWeightedFlushState *pState, RsslUInt64 now, RsslInt32 *priority)
+{
+	rtr_msgb_t			*candidates[RIPC_MAX_PRIORITY_QUEUE];
+	RIPC_PRIORITY_WRITE	*pQueue;
+	RsslQueueLink		*pLink;
+	RsslInt32			waiting = 0;
+	RsslInt32			i, pass;
+
+	for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+	{
+		pQueue = &rsslSocketChannel->priorityQueues[i];
+
+		if (pQueue->tempIndex > -1)
+			pLink = rsslQueuePeekNext(&pQueue->priorityQueue, &(pQueue->tempList[pQueue->tempIndex]->link));
+		else
+			pLink = rsslQueuePeekFront(&pQueue->priorityQueue);
+
+		candidates[i] = pLink ? RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink) : 0;
+		if (!candidates[i])
+			continue;
+
+		/* a partially written buffer was charged when it was chosen, and has to be finished first */
+		if (candidates[i]->local != candidates[i]->buffer)
+		{
+			*priority = i;
+			return candidates[i];
+		}
+		waiting++;
+	}
+
+	if (!waiting)
+		return 0;
+
+	if (rsslSocketChannel->highLatencyBudget && candidates[0] && (now >= candidates[0]->queueTime + rsslSocketChannel->highLatencyBudget))
+	{
+		pState->deficit[0] -= (RsslInt64)candidates[0]->length;
+		pState->budgetFlushes++;
+		*priority = 0;
+		return candidates[0];
+	}
+
+	for (pass = 0; pass < 2; pass++)
+	{
+		RsslInt64 turns = 0;
+
+		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+		{
+			RsslInt32 current = pState->currentQueue;
+
+			if (candidates[current])
+			{
+				if (!pState->credited)
+				{
+					pState->deficit[current] += rsslSocketChannel->priorityQueues[current].weight;
+					pState->credited = 1;
+				}
+
+				if ((RsslInt64)candidates[current]->length <= pState->deficit[current])
+				{
+					pState->deficit[current] -= (RsslInt64)candidates[current]->length;
+					*priority = current;
+					return candidates[current];
+				}
+			}
+			else if (pState->deficit[current] > 0)
+				pState->deficit[current] = 0;
+
+			pState->currentQueue = (RsslInt8)((current + 1) % RIPC_MAX_PRIORITY_QUEUE);
+			pState->credited = 0;
+		}
+
+		/* No waiting buffer fit.  Rather than going round until one does, give every waiting queue all but
+		 * one of the turns the closest of them still needs, so the next pass picks the first that fits. */
+		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+		{
+			if (candidates[i])
+			{
+				RsslInt64 weight = rsslSocketChannel->priorityQueues[i].weight;
+				RsslInt64 needed = ((RsslInt64)candidates[i]->length - pState->deficit[i] + weight - 1) / weight;
+
+				if (turns == 0 || needed < turns)
+					turns = needed;
+			}
+		}
+
+		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+		{
+			if (candidates[i])
+				pState->deficit[i] += (turns - 1) * rsslSocketChannel->priorityQueues[i].weight;
+		}
+	}
+
+	/* not reached, the second pass always finds a buffer */
+	return 0;
+}
+
+/* Keeps the round robin state as it was after choosing the last buffer that was at least partly written */
+RTR_C_INLINE void ipcWeightedFlushCommit(RsslSocketChannel *rsslSocketChannel, ripcWeightedFlushState *pState)
+{
+	rsslSocketChannel->budgetFlushes += pState->budgetFlushes;
+	pState->budgetFlushes = 0;
+	rsslSocketChannel->flushState = *pState;
+}
+
+/* Records the wait of a completely written buffer */
+RTR_C_INLINE void ipcWeightedFlushDone(RsslSocketChannel *rsslSocketChannel, RsslInt32 priority, rtr_msgb_t *msgb, RsslUInt64 now)
+{
+	RIPC_PRIORITY_WRITE	*pQueue = &rsslSocketChannel->priorityQueues[priority];
+	RsslUInt64			wait = (now > msgb->queueTime) ? (now - msgb->queueTime) : 0;
+
+	pQueue->flushedBytes += msgb->length;
+	pQueue->flushedBuffers++;
+	pQueue->totalWaitNsec += wait;
+	if (wait > pQueue->maxWaitNsec)
+		pQueue->maxWaitNsec = wait;
+}
+
 RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 {
 	rtr_msgb_t			*curmsgb = 0;
@@ -2718,6 +3234,10 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 	RsslInt32			iovLength = RIPC_MAXIOVLEN;
 	RsslInt32			reducedIovLen = 0;
 	RsslQueueLink		*pLink = 0;
+	ripcWeightedFlushState	flushState;
+	ripcWeightedFlushState	iovFlushState[RIPC_MAXIOVLEN + 1];
+	RsslInt32			priority;
+	RsslUInt64			flushTime = 0;
 
 	if (rsslSocketChannel->workState & RIPC_INT_SHTDOWN_PEND)
 	{
@@ -2731,6 +3251,9 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 
 	rwflags |= (rsslSocketChannel->blocking ? RIPC_RW_BLOCKING : 0);
 
+	if (rsslSocketChannel->zeroCopyNextId != rsslSocketChannel->zeroCopyDoneId)
+		ipcZeroCopyReap(rsslSocketChannel, rsslSocketChannel->stream);
+
 	/* keep track of this so we know if we went though the entire out list */
 	tempOutList = rsslSocketChannel->currentOutList;
 
@@ -2738,6 +3261,9 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 	for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
 		rsslSocketChannel->priorityQueues[i].tempList[0] = 0;
 
+	if (rsslSocketChannel->weightedFlush)
+		flushTime = ipcGetTimeNano();
+
 	/* If there is no writev, then write one at a time. */
 	if (rsslSocketChannel->transportFuncs->writeVTransport == 0) {
 		while (cont)
@@ -2748,8 +3274,16 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 			/* while we have a buffer, or we do not have a buffer and have gone through
 			the entire flush strategy we want to exit the while */
 
+			if (rsslSocketChannel->weightedFlush)
+			{
+				for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+					rsslSocketChannel->priorityQueues[i].tempIndex = -1;
+				flushState = rsslSocketChannel->flushState;
+				curmsgb = ipcWeightedFlushNext(rsslSocketChannel, &flushState, flushTime, &priority);
+			}
+
 			/* this should get a msgb from the output queue that should be flushed */
-			while (!curmsgb)
+			while (!curmsgb && !rsslSocketChannel->weightedFlush)
 			{
 				pLink = rsslQueuePeekFront(&rsslSocketChannel->priorityQueues[rsslSocketChannel->flushStrategy[rsslSocketChannel->currentOutList]].priorityQueue);
 				rsslSocketChannel->currentOutList++;
@@ -2840,6 +3374,7 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 				else
 					lenToWrite = (RsslInt32)(curmsgb->length - ((caddr_t)curmsgb->local - curmsgb->buffer));
 
+				rsslSocketChannel->writeSysCalls++;
 				if (rsslSocketChannel->httpHeaders)
 					cc = (*(rsslSocketChannel->transportFuncs->writeTransport))(rsslSocketChannel->tunnelStreamFd, curmsgb->local, lenToWrite, rwflags, error);
 				else
@@ -2879,9 +3414,17 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 
 				/* now update the particular output buffers length */
 				rsslSocketChannel->priorityQueues[curmsgb->priority].queueLength -= cc;
+				if ((cc > 0) && rsslSocketChannel->weightedFlush)
+					ipcWeightedFlushCommit(rsslSocketChannel, &flushState);
 
 				if (cc == lenToWrite) /* check if we wrote out everything we expected to */
 				{
+					if (rsslSocketChannel->weightedFlush)
+					{
+						flushTime = ipcGetTimeNano();
+						ipcWeightedFlushDone(rsslSocketChannel, curmsgb->priority, curmsgb, flushTime);
+					}
+
 					/* now actually remove the buffer from the queue */
 					/* and free it */
 					pLink = rsslQueueRemoveFirstLink(&rsslSocketChannel->priorityQueues[curmsgb->priority].priorityQueue);
@@ -2962,6 +3505,7 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 		wrtveclen = 0;
 		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
 			rsslSocketChannel->priorityQueues[i].tempIndex = -1;
+		flushState = rsslSocketChannel->flushState;
 
 		/* if we are doing http tunneling and require headers, limit this to one buffer and then write end of the chunk */
 		/* there really shouldnt be a case where we have a new Tunnel stream fd and not using http headers */
@@ -2979,13 +3523,25 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 				curmsgb = RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink);
 
 			if (curmsgb) {
+				iovFlushState[wrtveclen] = flushState;
 				iovPriority[wrtveclen] = rsslSocketChannel->nextOutBuf;
 				rsslSocketChannel->priorityQueues[rsslSocketChannel->nextOutBuf].tempIndex++;
 				rsslSocketChannel->priorityQueues[rsslSocketChannel->nextOutBuf].tempList[rsslSocketChannel->priorityQueues[rsslSocketChannel->nextOutBuf].tempIndex] = curmsgb;
 			}
 		}
 
-		while (!curmsgb)
+		if (!curmsgb && rsslSocketChannel->weightedFlush)
+		{
+			if ((curmsgb = ipcWeightedFlushNext(rsslSocketChannel, &flushState, flushTime, &priority)) != 0)
+			{
+				iovFlushState[wrtveclen] = flushState;
+				iovPriority[wrtveclen] = priority;
+				rsslSocketChannel->priorityQueues[priority].tempIndex++;
+				rsslSocketChannel->priorityQueues[priority].tempList[rsslSocketChannel->priorityQueues[priority].tempIndex] = curmsgb;
+			}
+		}
+
+		while (!curmsgb && !rsslSocketChannel->weightedFlush)
 		{
 			/* do work to get buffer here */
 			pLink = rsslQueuePeekFront(&rsslSocketChannel->priorityQueues[rsslSocketChannel->flushStrategy[rsslSocketChannel->currentOutList]].priorityQueue);
@@ -3062,8 +3618,19 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 			/* set this to 0 */
 			curmsgb = 0;
 
+			if (rsslSocketChannel->weightedFlush && (wrtveclen < iovLength))
+			{
+				if ((curmsgb = ipcWeightedFlushNext(rsslSocketChannel, &flushState, flushTime, &priority)) != 0)
+				{
+					iovFlushState[wrtveclen] = flushState;
+					iovPriority[wrtveclen] = priority;
+					rsslSocketChannel->priorityQueues[priority].tempIndex++;
+					rsslSocketChannel->priorityQueues[priority].tempList[rsslSocketChannel->priorityQueues[priority].tempIndex] = curmsgb;
+				}
+			}
+
 			/* now here get the buffer - this is instead of doing it in each of the if/else statements above */
-			while ((!curmsgb) && (wrtveclen < iovLength))
+			while ((!curmsgb) && (wrtveclen < iovLength) && !rsslSocketChannel->weightedFlush)
 			{
 				if (rsslSocketChannel->priorityQueues[rsslSocketChannel->flushStrategy[rsslSocketChannel->currentOutList]].tempIndex > -1)
 				{
@@ -3128,8 +3695,20 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 
 		if (wrtveclen > 0)
 		{
+			int zeroCopySent = 0;
+
+			rsslSocketChannel->writeSysCalls++;
 			if (rsslSocketChannel->httpHeaders)
 				cc = (*(rsslSocketChannel->transportFuncs->writeVTransport))(rsslSocketChannel->tunnelStreamFd, wrtvec, wrtveclen, lenToWrite, rwflags, error);
+			else if (rsslSocketChannel->zeroCopyThreshold && ((RsslUInt32)lenToWrite >= rsslSocketChannel->zeroCopyThreshold) &&
+				((rsslSocketChannel->zeroCopyNextId - rsslSocketChannel->zeroCopyDoneId) < RIPC_MAX_ZEROCOPY_SENDS) &&
+				/* do not let buffers waiting on completions take more than half of the guaranteed buffers */
+				(rsslQueueGetElementCount(&rsslSocketChannel->zeroCopyBufs) < (RsslUInt32)(rsslSocketChannel->guarBufPool->bufpool.maxBufs / 2)))
+			{
+				cc = ipcZeroCopyWriteV(rsslSocketChannel->transportInfo, wrtvec, wrtveclen, lenToWrite, rwflags, &zeroCopySent, error);
+				if (zeroCopySent)
+					rsslSocketChannel->zeroCopyNextId++;
+			}
 			else
 				cc = (*(rsslSocketChannel->transportFuncs->writeVTransport))(rsslSocketChannel->transportInfo, wrtvec, wrtveclen, lenToWrite, rwflags, error);
 
@@ -3175,8 +3754,18 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 				}
 			}
 
+			if (rsslSocketChannel->weightedFlush)
+				flushTime = ipcGetTimeNano();
+
+			/* Written buffers must be held if this send was zero copy, or if the
+			 * partially written buffer at the front went out with an earlier one */
+			zeroCopySent = zeroCopySent || rsslSocketChannel->zeroCopyPartial;
+
 			if (cc == lenToWrite)
 			{
+				rsslSocketChannel->zeroCopyPartial = 0;
+				if (rsslSocketChannel->weightedFlush)
+					ipcWeightedFlushCommit(rsslSocketChannel, &iovFlushState[wrtveclen - 1]);
 				while (wrtveclen > 0)
 				{
 					wrtveclen--;
@@ -3185,10 +3774,12 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 						curmsgb = RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink);
 
 					rsslSocketChannel->priorityQueues[iovPriority[wrtveclen]].queueLength -= (RsslInt32)curmsgb->length;
+					if (rsslSocketChannel->weightedFlush)
+						ipcWeightedFlushDone(rsslSocketChannel, iovPriority[wrtveclen], curmsgb, flushTime);
 					iovPriority[wrtveclen] = -1;
 					rsslSocketChannel->nextOutBuf = -1;
 					RIPC_ASSERT(curmsgb);
-					rtr_dfltcFreeMsg(curmsgb);
+					ipcReleaseWrittenBuffer(rsslSocketChannel, curmsgb, (RsslBool)zeroCopySent);
 					curmsgb = 0;
 				}
 
@@ -3243,6 +3834,8 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 			else
 			{
 				RsslInt32 curpos = 0;
+				if (cc > 0)
+					rsslSocketChannel->zeroCopyPartial = 0;
 				while (cc > 0)
 				{
 					if (RIPC_IOV_GETLEN(&wrtvec[curpos]) <= (RsslUInt32)cc)
@@ -3252,12 +3845,14 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 							curmsgb = RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink);
 
 						rsslSocketChannel->priorityQueues[iovPriority[curpos]].queueLength -= (RsslInt32)curmsgb->length;
+						if (rsslSocketChannel->weightedFlush)
+							ipcWeightedFlushDone(rsslSocketChannel, iovPriority[curpos], curmsgb, flushTime);
 						iovPriority[curpos] = -1;
 
 						rsslSocketChannel->nextOutBuf = -1;
 
 						RIPC_ASSERT(curmsgb);
-						rtr_dfltcFreeMsg(curmsgb);
+						ipcReleaseWrittenBuffer(rsslSocketChannel, curmsgb, (RsslBool)zeroCopySent);
 
 						curmsgb = 0;
 
@@ -3274,6 +3869,7 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 
 						rsslSocketChannel->nextOutBuf = iovPriority[curpos];
 						iovPriority[curpos] = -1;
+						rsslSocketChannel->zeroCopyPartial = (RsslUInt8)zeroCopySent;
 
 						RIPC_ASSERT(curmsgb);
 
@@ -3288,6 +3884,9 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 						curpos++;
 					}
 				}
+
+				if ((curpos > 0) && rsslSocketChannel->weightedFlush)
+					ipcWeightedFlushCommit(rsslSocketChannel, &iovFlushState[curpos - 1]);
 			}
 
 			if (rsslSocketChannel->blocking == 0)
@@ -3313,7 +3912,163 @@ RsslRet ipcFlushSession(RsslSocketChannel *rsslSocketChannel, RsslError *error)
 	}
 	for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
 		retVal += rsslSocketChannel->priorityQueues[i].queueLength;
-	return(retVal);
+
+	if (retVal == 0)
+		rsslSocketChannel->coalesceDeadline = 0;
+
+	return(retVal);
+}
+
+/* Flushes the data a coalescing channel is holding if it has been held for as long as allowed.
+ * The channel lock must already be held.  Errors are left for the caller's own read or write
+ * on the channel to find. */
+static void ipcFlushCoalesced(RsslSocketChannel *rsslSocketChannel)
+{
+	RsslError error;
+
+	if (rsslSocketChannel->coalesceDeadline && (ipcGetTimeNano() >= rsslSocketChannel->coalesceDeadline))
+		(void)ipcFlushSession(rsslSocketChannel, &error);
+}
+
+/* Transparent packing (RSSL_AUTO_PACK_SIZE) copies each small message into an open packed buffer for its priority
+ * rather than writing it on its own.  An open buffer is written, like one packed by the application, when the next
+ * message of its priority does not fit, when a message of its priority is written unpacked, or when the channel is
+ * flushed or written to directly.  Open buffers are only changed with the channel lock held, but are written
+ * without it since ipcWriteSession() takes the lock itself. */
+
+/* Writes the open packed buffer for a priority, if there is one */
+static RsslRet ipcAutoPackClose(RsslSocketChannel *rsslSocketChannel, RsslInt32 priority, RsslError *error)
+{
+	rsslBufferImpl packBufImpl;
+	rtr_msgb_t *packBuf;
+	RsslInt32 bytesWritten, uncompBytesWritten;
+
+#ifdef MUTEX_DEBUG
+	printf("LOCK rsslSocketChannel -- ipcAutoPackClose (start)\n");
+#endif
+	IPC_MUTEX_LOCK(rsslSocketChannel);
+
+	packBuf = rsslSocketChannel->autoPackBufs[priority];
+	rsslSocketChannel->autoPackBufs[priority] = 0;
+	if (packBuf)
+		rsslSocketChannel->autoPackedBufs++;
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- ipcAutoPackClose (end)\n");
+#endif
+	IPC_MUTEX_UNLOCK(rsslSocketChannel);
+
+	if (packBuf == 0)
+		return RSSL_RET_SUCCESS;
+
+	memset(&packBufImpl, 0, sizeof(rsslBufferImpl));
+	packBufImpl.bufferInfo = packBuf;
+	packBufImpl.buffer.data = packBuf->buffer;
+	packBufImpl.buffer.length = (RsslUInt32)packBuf->length;
+	packBufImpl.packingOffset = (RsslUInt32)packBuf->length;
+	packBufImpl.priority = (RsslUInt8)priority;
+	packBuf->priority = priority;
+
+	return ipcWriteSession(rsslSocketChannel, &packBufImpl, 0, &bytesWritten, &uncompBytesWritten, 0, error);
+}
+
+/* Writes every open packed buffer */
+static RsslRet ipcAutoPackCloseAll(RsslSocketChannel *rsslSocketChannel, RsslError *error)
+{
+	RsslRet retVal;
+	RsslInt32 i;
+
+	for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+	{
+		if (rsslSocketChannel->autoPackBufs[i] && (retVal = ipcAutoPackClose(rsslSocketChannel, i, error)) < RSSL_RET_SUCCESS)
+			return retVal;
+	}
+	return RSSL_RET_SUCCESS;
+}
+
+/* Copies a message into the open packed buffer for its priority, first writing that buffer if the message does not fit
+ * and opening a new one of packSize bytes.  Returns the number of bytes waiting to be written, including those in open
+ * packed buffers, or RSSL_RET_BUFFER_NO_BUFFERS if no packed buffer could be opened and the message should be written
+ * as it is. */
+static RsslRet ipcAutoPackWrite(RsslSocketChannel *rsslSocketChannel, rsslBufferImpl *rsslBufImpl, RsslUInt32 packSize, RsslError *error)
+{
+	RsslInt32 priority = rsslBufImpl->priority;
+	RsslUInt32 length = rsslBufImpl->buffer.length;
+	rtr_msgb_t *packBuf;
+	RsslRet retVal;
+	RsslInt32 i;
+
+	while (1)
+	{
+#ifdef MUTEX_DEBUG
+		printf("LOCK rsslSocketChannel -- ipcAutoPackWrite\n");
+#endif
+		IPC_MUTEX_LOCK(rsslSocketChannel);
+
+		packBuf = rsslSocketChannel->autoPackBufs[priority];
+		if (packBuf && (packBuf->length + 2 + length <= packSize) && (packBuf->length + 2 + length <= packBuf->maxLength))
+		{
+			char *pMsg = packBuf->buffer + packBuf->length;
+			RsslUInt16 msgLength = (RsslUInt16)length;
+
+			pMsg += rwfPut16(pMsg, msgLength);
+			MemCopyByInt(pMsg, rsslBufImpl->buffer.data, length);
+			packBuf->length += length + 2;
+			rsslSocketChannel->autoPackedMsgs++;
+
+			retVal = 0;
+			for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+			{
+				retVal += rsslSocketChannel->priorityQueues[i].queueLength;
+				if (rsslSocketChannel->autoPackBufs[i])
+					retVal += (RsslRet)rsslSocketChannel->autoPackBufs[i]->length;
+			}
+
+#ifdef MUTEX_DEBUG
+			printf("UNLOCK rsslSocketChannel -- ipcAutoPackWrite\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return retVal;
+		}
+
+#ifdef MUTEX_DEBUG
+		printf("UNLOCK rsslSocketChannel -- ipcAutoPackWrite\n");
+#endif
+		IPC_MUTEX_UNLOCK(rsslSocketChannel);
+
+		if (packBuf)
+		{
+			/* full */
+			if ((retVal = ipcAutoPackClose(rsslSocketChannel, priority, error)) < RSSL_RET_SUCCESS)
+				return retVal;
+		}
+		else
+		{
+			if ((packBuf = ipcDataBuffer(rsslSocketChannel, packSize, error)) == 0)
+				return RSSL_RET_BUFFER_NO_BUFFERS;
+			packBuf->length = 0;
+
+#ifdef MUTEX_DEBUG
+			printf("LOCK rsslSocketChannel -- ipcAutoPackWrite (open)\n");
+#endif
+			IPC_MUTEX_LOCK(rsslSocketChannel);
+
+			if (rsslSocketChannel->autoPackBufs[priority] == 0)
+			{
+				rsslSocketChannel->autoPackBufs[priority] = packBuf;
+				packBuf = 0;
+			}
+
+#ifdef MUTEX_DEBUG
+			printf("UNLOCK rsslSocketChannel -- ipcAutoPackWrite (open)\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+
+			/* another thread opened one first */
+			if (packBuf)
+				ipcReleaseDataBuffer(rsslSocketChannel, packBuf, error);
+		}
+	}
 }
 
 /*********************************************
@@ -3392,6 +4147,9 @@ static ripcSessInit ipcInitTransport(RsslSocketChannel *rsslSocketChannel, ripcS
 	}
 	else if (cc > 0)
 	{
+		/* the transport may have moved the channel to another descriptor */
+		if (inProg->types & RIPC_INPROG_NEW_FD)
+			rsslSocketChannel->stream = inProg->newSocket.stream;
 		rsslSocketChannel->intState = RIPC_INT_ST_READ_HDR;
 	}
 
@@ -3572,6 +4330,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 	case CONN_VERSION_12:  /* lz4 and protocol type exchange */
 	case CONN_VERSION_13:  /* force compression as non ZLIB and component versioning */
 	case CONN_VERSION_14:  /* app signing key negotiation */
+	case CONN_VERSION_15:  /* zstd dictionary ID */
 	{
 		/* Start of connection handshake */
 		if (rtrUnlikely(conndebug))
@@ -3608,6 +4367,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 				RsslInt16 compStringLen = -1;
 				unsigned char componentVersionLen = 0;
 				unsigned char componentStringLen = 0;
+				RsslUInt32	dictId = 0;
 
 
 				flags = hdrStart[7];  /* may indicate that client wants key exchange if version 14 or higher */
@@ -3627,6 +4387,17 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 					compVerLen = componentVersionLen;
 				}
 				break;
+				case CONN_VERSION_15:
+				{
+					/* the dictionary ID sits between the IP address and the component versioning,
+					* get it now since compression is set up before either is parsed */
+					hostnameLen = hdrStart[15 + compbitmapsize];
+					addrLen = hdrStart[16 + compbitmapsize + hostnameLen];
+					_move_u32_swap(&dictId, &(hdrStart[17 + compbitmapsize + hostnameLen + addrLen]));
+					componentVersionLen = hdrStart[17 + compbitmapsize + hostnameLen + addrLen + RSSL_COMP_DICT_ID_SIZE];
+					compVerLen = componentVersionLen;
+				}
+				break;
 				default:
 					/* fall through for all older versions */
 					;
@@ -3663,7 +4434,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 					if ((compbitmapsize > 0) && (rsslSocketChannel->srvrcomp))
 					{
 						RsslUInt8 *compbitmap = (RsslUInt8*)&(hdrStart[10]);
-						for (i = 0; i <= RSSL_COMP_MAX_TYPE; i++)
+						for (i = 0; i < RIPC_COMP_TABLE_SIZE; i++)
 						{
 							RsslInt16 idx = ripccompressions[i][RSSL_COMP_BYTEINDEX];
 							if ((idx < RSSL_COMP_BITMAP_SIZE) && (idx < (RsslInt16)compbitmapsize))
@@ -3722,7 +4493,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 						{
 							RsslUInt8 *compbitmap = (RsslUInt8*)&(hdrStart[10]);
 
-							for (i = 0; i <= RSSL_COMP_MAX_TYPE; i++)
+							for (i = 0; i < RIPC_COMP_TABLE_SIZE; i++)
 							{
 								RsslInt16 idx = ripccompressions[i][RSSL_COMP_BYTEINDEX];
 								if ((idx < RSSL_COMP_BITMAP_SIZE) && (idx < (RsslInt16)compbitmapsize))
@@ -3788,7 +4559,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 					/* Compression both directions */
 					if (rsslSocketChannel->inDecompress)
 					{
-						rsslSocketChannel->decompressBuf = rtr_smplcAllocMsg(gblInputBufs, rsslSocketChannel->maxMsgSize);
+						rsslSocketChannel->decompressBuf = ipcAllocChannelMsg(rsslSocketChannel, rsslSocketChannel->maxMsgSize);
 						if (rsslSocketChannel->decompressBuf == 0)
 						{
 							_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -3824,7 +4595,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 						{
 							RsslUInt8 *compbitmap = (RsslUInt8*)&(hdrStart[10]);
 
-							for (i = 0; i <= RSSL_COMP_MAX_TYPE; i++)
+							for (i = 0; i < RIPC_COMP_TABLE_SIZE; i++)
 							{
 								/* if the client is requesting the same compression we want to do, then do it! */
 								RsslInt16 idx = ripccompressions[i][RSSL_COMP_BYTEINDEX];
@@ -3913,7 +4684,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 							/* Create buffer to compress into and decompress from */
 							i = LZ4_compressBound(rsslSocketChannel->maxUserMsgSize);
 							i += 5; /* add in small fudge factor to ensure these buffers are larger than needed */
-							rsslSocketChannel->tempCompressBuf = rtr_smplcAllocMsg(gblInputBufs, i);
+							rsslSocketChannel->tempCompressBuf = ipcAllocChannelMsg(rsslSocketChannel, i);
 							if (rsslSocketChannel->tempCompressBuf == 0)
 							{
 								_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -3923,7 +4694,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 
 								return(RIPC_CONN_ERROR);
 							}
-							rsslSocketChannel->tempDecompressBuf = rtr_smplcAllocMsg(gblInputBufs, i);
+							rsslSocketChannel->tempDecompressBuf = ipcAllocChannelMsg(rsslSocketChannel, i);
 							if (rsslSocketChannel->tempDecompressBuf == 0)
 							{
 								_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -3940,7 +4711,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 					/* Compression both directions */
 					if (rsslSocketChannel->inDecompress)
 					{
-						rsslSocketChannel->decompressBuf = rtr_smplcAllocMsg(gblInputBufs, rsslSocketChannel->maxMsgSize);
+						rsslSocketChannel->decompressBuf = ipcAllocChannelMsg(rsslSocketChannel, rsslSocketChannel->maxMsgSize);
 						if (rsslSocketChannel->decompressBuf == 0)
 						{
 							_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -3968,6 +4739,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 				/* Version 13/14 is similar to 12, but it allows force compression to be whatever server says (V12 forced it as ZLIB always) */
 				case CONN_VERSION_13:
 				case CONN_VERSION_14:
+				case CONN_VERSION_15:
 				{
 					if (rsslSocketChannel->srvrcomp)
 					{
@@ -3979,7 +4751,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 						{
 							/* take bitmap off wire (if its there) to see what compression the client wants */
 							RsslUInt8 *compbitmap = (RsslUInt8*)&(hdrStart[10]);
-							for (i = 0; i <= RSSL_COMP_MAX_TYPE; i++)
+							for (i = 0; i < RIPC_COMP_TABLE_SIZE; i++)
 							{
 								/* check if the client is requesting a compression type we support */
 								/* if not, then there will be no compression */
@@ -4036,6 +4808,17 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 							}
 						}
 
+						/* use the zstd dictionary only if the client offered the same one */
+						if ((rsslSocketChannel->outCompression == RSSL_COMP_ZSTD) && rsslSocketChannel->outCompFuncs &&
+							rsslSocketChannel->inDecompFuncs && rsslSocketChannel->server->compDict &&
+							(dictId != 0) && (dictId == rsslSocketChannel->server->compDict->dictId))
+						{
+							if (ripcZstdUseDict(rsslSocketChannel->server->compDict, rsslSocketChannel->c_stream_out,
+									rsslSocketChannel->c_stream_in, error) != RSSL_RET_SUCCESS)
+								return(RIPC_CONN_ERROR);
+							rsslSocketChannel->compDict = rsslSocketChannel->server->compDict;
+						}
+
 						/* LZ4 compression can sometimes grow data instead of shrinking it
 						*  the compression routine isnt smart enough to stop at the end of a buffer (yes, this is hard to believe)
 						* so we need to make sure we do not exceed the buffer.
@@ -4063,7 +4846,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 							/* Create buffer to compress into and decompress from */
 							i = LZ4_compressBound(rsslSocketChannel->maxUserMsgSize);
 							i += 5; /* add in small fudge factor to ensure these buffers are larger than needed */
-							rsslSocketChannel->tempCompressBuf = rtr_smplcAllocMsg(gblInputBufs, i);
+							rsslSocketChannel->tempCompressBuf = ipcAllocChannelMsg(rsslSocketChannel, i);
 							if (rsslSocketChannel->tempCompressBuf == 0)
 							{
 								_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -4073,7 +4856,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 
 								return(RIPC_CONN_ERROR);
 							}
-							rsslSocketChannel->tempDecompressBuf = rtr_smplcAllocMsg(gblInputBufs, i);
+							rsslSocketChannel->tempDecompressBuf = ipcAllocChannelMsg(rsslSocketChannel, i);
 							if (rsslSocketChannel->tempDecompressBuf == 0)
 							{
 								_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -4089,7 +4872,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 					/* Compression both directions */
 					if (rsslSocketChannel->inDecompress)
 					{
-						rsslSocketChannel->decompressBuf = rtr_smplcAllocMsg(gblInputBufs, rsslSocketChannel->maxMsgSize);
+						rsslSocketChannel->decompressBuf = ipcAllocChannelMsg(rsslSocketChannel, rsslSocketChannel->maxMsgSize);
 						if (rsslSocketChannel->decompressBuf == 0)
 						{
 							_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -4157,6 +4940,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 				case CONN_VERSION_12:
 				case CONN_VERSION_13:
 				case CONN_VERSION_14:
+				case CONN_VERSION_15:
 					protocoltype = (RsslUInt8)hdrStart[hdrCursor];
 					hdrCursor++;
 					/* validate protocolType */
@@ -4226,6 +5010,10 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 				}
 				hdrCursor += addrLen;
 
+				/* skip the dictionary ID, it was read up front for the compression setup */
+				if (version_number > CONN_VERSION_14)
+					hdrCursor += RSSL_COMP_DICT_ID_SIZE;
+
 				/* If we are past the right connection version (14 or higher) and client asked for key exchange,
 				* set up the internal structure so we know to provide this on the ack and have the extra handshake steps */
 				if ((version_number > CONN_VERSION_13) && (flags & RIPC_KEY_EXCHANGE))
@@ -4242,6 +5030,7 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 				{
 				case CONN_VERSION_13:
 				case CONN_VERSION_14:
+				case CONN_VERSION_15:
 				{
 					/* get component versioning stuff */
 					/* rb15 total length followed by rb15 length specified product version string */
@@ -4335,6 +5124,18 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 						rsslSocketChannel->maxUserMsgSize -= 8;
 					}
 					break;
+				case CONN_VERSION_15:
+					rsslSocketChannel->version = &ripc15Ver;
+					/* there should not be any 10 versions that can do tunneling */
+					if (rsslSocketChannel->httpHeaders)
+					{
+						/* we need to add to the header and footer length */
+						/* 6 butes is the max length we can represent as a chunk */
+						/* need to reserve footer for carrage return -line feed */
+						rsslSocketChannel->version = &ripc15WinInetVer;
+						rsslSocketChannel->maxUserMsgSize -= 8;
+					}
+					break;
 
 				default:
 					_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -4892,11 +5693,21 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 	if (rtrUnlikely(conndebug))
 		printf("Version is ConnVer 0x%x comp <%d>\n", version_number, rsslSocketChannel->outCompression);
 
-	rsslSocketChannel->guarBufPool = rtr_dfltcAllocatePool(
+	/* this may run on a handshake worker, so place the pool with the rest of the channel
+	 * rather than on the worker's node */
+	rsslSocketChannel->guarBufPool = rtr_dfltcAllocPool(
 		rsslSocketChannel->server->maxGuarMsgs, rsslSocketChannel->server->maxGuarMsgs,
-		10, rsslSocketChannel->maxMsgSize, rsslSocketChannel->server->sharedBufPool,
+		10, rsslSocketChannel->server->sharedBufPool,
 		(rsslSocketChannel->server->maxNumMsgs - rsslSocketChannel->server->maxGuarMsgs), 0);
 
+	if (rsslSocketChannel->guarBufPool &&
+		((rtr_dfltcSetPageArena(rsslSocketChannel->guarBufPool, rsslSocketChannel->pageArena) < 0) ||
+		 (rtr_dfltcSetBufSize(rsslSocketChannel->guarBufPool, rsslSocketChannel->maxMsgSize) < 0)))
+	{
+		rtrBufferPoolDropRef(&(rsslSocketChannel->guarBufPool->bufpool));
+		rsslSocketChannel->guarBufPool = 0;
+	}
+
 	if (rsslSocketChannel->guarBufPool == 0)
 	{
 		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -4907,6 +5718,9 @@ ripcSessInit ipcProcessHdr(RsslSocketChannel *rsslSocketChannel, ripcSessInProg
 		return(RIPC_CONN_ERROR);
 	}
 
+	if (rsslSocketChannel->server->sharedPoolCacheSize)
+		rtr_dfltcSetSharedPoolCacheSize(&(rsslSocketChannel->guarBufPool->bufpool), rsslSocketChannel->server->sharedPoolCacheSize);
+
 	{
 		if (rtrUnlikely(conndebug))
 			printf("\nipcProcessHdr: NOT doing renegotiation "SOCKET_PRINT_TYPE"\n", rsslSocketChannel->stream);
@@ -5128,6 +5942,9 @@ static ripcSessInit ipcFinishSess(RsslSocketChannel *rsslSocketChannel, ripcSess
 		componentVersionLength = 2 + ((rsslSocketChannel->componentVerLen > 253) ? 253 : rsslSocketChannel->componentVerLen);
 		newIpcMsgLength += componentVersionLength + 1; /* +1 is for protocol length */
 		break;
+	case CONN_VERSION_15:
+		newIpcMsgLength += RSSL_COMP_DICT_ID_SIZE;
+		/* add the dictionary ID and fall through */
 	case CONN_VERSION_14:
 		/* figure out total length of component version stuff */
 		componentVersionLength = 2 + ((rsslSocketChannel->componentVerLen > 253) ? 253 : rsslSocketChannel->componentVerLen);
@@ -5182,6 +5999,7 @@ static ripcSessInit ipcFinishSess(RsslSocketChannel *rsslSocketChannel, ripcSess
 	switch (rsslSocketChannel->version->connVersion)
 	{
 	case CONN_VERSION_14:  /* add key negotiation; should be on version 14 and higher */
+	case CONN_VERSION_15:
 		if (rsslSocketChannel->keyExchange == 1)
 		{
 			RsslUInt64 server_send_key;
@@ -5235,6 +6053,15 @@ static ripcSessInit ipcFinishSess(RsslSocketChannel *rsslSocketChannel, ripcSess
 		break;
 	}
 
+	/* Version 15 and higher echoes the zstd dictionary ID to tell the client the dictionary is in use */
+	if (rsslSocketChannel->version->connVersion > CONN_VERSION_14)
+	{
+		RsslUInt32 dictId = (rsslSocketChannel->compDict ? rsslSocketChannel->compDict->dictId : 0);
+
+		_move_u32_swap((conMsg + iterator), &dictId);
+		iterator += RSSL_COMP_DICT_ID_SIZE;
+	}
+
 	/* apply trailer to end of actual data */
 	if (rsslSocketChannel->httpHeaders)
 		chunkLength += sprintf((conMsg + iterator), "%s", "\r\n");
@@ -5308,6 +6135,9 @@ static ripcSessInit ipcFinishSess(RsslSocketChannel *rsslSocketChannel, ripcSess
 			case RSSL_COMP_LZ4:
 				rsslSocketChannel->lowerCompressionThreshold = RSSL_COMP_DFLT_THRESHOLD_LZ4;
 				break;
+			case RSSL_COMP_ZSTD:
+				rsslSocketChannel->lowerCompressionThreshold = RSSL_COMP_DFLT_THRESHOLD_ZSTD;
+				break;
 			default:
 				break;
 			}
@@ -5588,6 +6418,9 @@ static ripcSessInit ipcWaitClientKey(RsslSocketChannel *rsslSocketChannel, ripcS
 		case RSSL_COMP_LZ4:
 			rsslSocketChannel->lowerCompressionThreshold = RSSL_COMP_DFLT_THRESHOLD_LZ4;
 			break;
+		case RSSL_COMP_ZSTD:
+			rsslSocketChannel->lowerCompressionThreshold = RSSL_COMP_DFLT_THRESHOLD_ZSTD;
+			break;
 		default:
 			break;
 		}
@@ -5821,6 +6654,7 @@ static ripcSessInit ipcConnecting(RsslSocketChannel *rsslSocketChannel, ripcSess
 		case CONN_VERSION_12:
 		case CONN_VERSION_13:
 		case CONN_VERSION_14:
+		case CONN_VERSION_15:
 		{
 			if (rsslSocketChannel->inDecompress == 0)
 				len = 7;
@@ -5904,6 +6738,8 @@ static ripcSessInit ipcConnecting(RsslSocketChannel *rsslSocketChannel, ripcSess
 				ripcHeaderSize = V10_MIN_CONN_HDR + hostnameLen + addrLen + 2;
 				if (rsslSocketChannel->version->connVersion > CONN_VERSION_11)
 					++ripcHeaderSize;
+				if (rsslSocketChannel->version->connVersion > CONN_VERSION_14)
+					ripcHeaderSize += RSSL_COMP_DICT_ID_SIZE;
 				ripcHead[8] = (char)ripcHeaderSize;
 				ripcHead[9] = 0;
 				/* set len to the next element for the variable portion */
@@ -5915,6 +6751,8 @@ static ripcSessInit ipcConnecting(RsslSocketChannel *rsslSocketChannel, ripcSess
 					hostnameLen + addrLen + 2;
 				if (rsslSocketChannel->version->connVersion > CONN_VERSION_11)
 					++ripcHeaderSize;
+				if (rsslSocketChannel->version->connVersion > CONN_VERSION_14)
+					ripcHeaderSize += RSSL_COMP_DICT_ID_SIZE;
 				ripcHead[8] = (char)ripcHeaderSize;
 				ripcHead[9] = RSSL_COMP_BITMAP_SIZE;
 				MemCopyByInt((ripcHead + 10), (char*)rsslSocketChannel->compressionBitmap, RSSL_COMP_BITMAP_SIZE);
@@ -5945,6 +6783,15 @@ static ripcSessInit ipcConnecting(RsslSocketChannel *rsslSocketChannel, ripcSess
 			}
 			len += addrLen;
 
+			/* The zstd dictionary ID is in ripc handshake 15 and higher */
+			if (rsslSocketChannel->version->connVersion > CONN_VERSION_14)
+			{
+				RsslUInt32 dictId = (rsslSocketChannel->compDict ? rsslSocketChannel->compDict->dictId : 0);
+
+				_move_u32_swap((ripcHead + len), &dictId);
+				len += RSSL_COMP_DICT_ID_SIZE;
+			}
+
 			/* Component versioning is in ripc handshake 13 and higher */
 			if (rsslSocketChannel->version->connVersion > CONN_VERSION_12)
 			{
@@ -6155,6 +7002,9 @@ static ripcSessInit ipcReconnectOld(RsslSocketChannel *rsslSocketChannel, ripcSe
 {
 	switch (rsslSocketChannel->version->connVersion)
 	{
+	case CONN_VERSION_15:
+		rsslSocketChannel->version = &ripc14Ver;
+		break;
 	case CONN_VERSION_14:
 		/* Since we may have been doing key exchange, we have to reset this in the session
 		* before we go down to a version of code that does not support that */
@@ -6238,6 +7088,7 @@ static ripcSessInit ipcReconnectSocket(RsslSocketChannel *rsslSocketChannel, rip
 
 				return(RIPC_CONN_ERROR);
 			}
+			userSpecPtr = (void*)&(rsslSocketChannel->kernelTlsOffload);
 		}
 	}
 #endif
@@ -6391,7 +7242,8 @@ ripcSessInit ipcWaitProxyAck(RsslSocketChannel *rsslSocketChannel, ripcSessInPro
 		}
 
 		rsslSocketChannel->transportInfo = (*(rsslSocketChannel->transportFuncs->newClientConnection))(
-			rsslSocketChannel->stream, &initcomplete, 0, error);
+			rsslSocketChannel->stream, &initcomplete,
+			(rsslSocketChannel->connType == RSSL_CONN_TYPE_ENCRYPTED) ? (void*)&(rsslSocketChannel->kernelTlsOffload) : 0, error);
 
 		if (rsslSocketChannel->transportInfo == 0)
 		{
@@ -6509,6 +7361,7 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 			}
 			/* else fall through */
 		case CONN_VERSION_14:
+		case CONN_VERSION_15:
 			return (ipcReconnectOld(rsslSocketChannel, inPr, error));
 			break;
 		case CONN_VERSION_12:
@@ -6622,6 +7475,7 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 	/* future versions will probably make use of the version number sent back in the ACK message. */
 	{
 		RsslUInt16 comp;
+		RsslUInt32 ackDictId = 0;
 
 		switch (versionNumber)
 		{
@@ -6640,6 +7494,9 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 		case RIPC_VERSION_14:
 			rsslSocketChannel->version = &ripc14Ver;
 			break;
+		case RIPC_VERSION_15:
+			rsslSocketChannel->version = &ripc15Ver;
+			break;
 		default:
 			/* version error */
 			_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -6726,6 +7583,13 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 			tempIter = skipIter + componentVersionLen;
 		}
 
+		/* a server using our zstd dictionary echoes its ID, version 15 and higher */
+		if (versionNumber > RIPC_VERSION_14)
+		{
+			_move_u32_swap(&ackDictId, (buf + tempIter));
+			tempIter += RSSL_COMP_DICT_ID_SIZE;
+		}
+
 		/* set up compression */
 		if (comp > RSSL_COMP_MAX_TYPE)
 		{
@@ -6778,6 +7642,7 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 		case RIPC_VERSION_12:
 		case RIPC_VERSION_13:
 		case RIPC_VERSION_14:
+		case RIPC_VERSION_15:
 		{
 			if ((flags & RSSL_COMP_FORCE) && (!comp))
 				comp = RSSL_COMP_ZLIB;
@@ -6812,7 +7677,7 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 				/* Create buffer to compress into and decompress from */
 				i = LZ4_compressBound(maxMsgSize);
 				i += 5; /* add in small fudge factor to ensure these buffers are larger than needed */
-				rsslSocketChannel->tempCompressBuf = rtr_smplcAllocMsg(gblInputBufs, i);
+				rsslSocketChannel->tempCompressBuf = ipcAllocChannelMsg(rsslSocketChannel, i);
 				if (rsslSocketChannel->tempCompressBuf == 0)
 				{
 					_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -6822,7 +7687,7 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 
 					return(RIPC_CONN_ERROR);
 				}
-				rsslSocketChannel->tempDecompressBuf = rtr_smplcAllocMsg(gblInputBufs, i);
+				rsslSocketChannel->tempDecompressBuf = ipcAllocChannelMsg(rsslSocketChannel, i);
 				if (rsslSocketChannel->tempDecompressBuf == 0)
 				{
 					_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -6882,6 +7747,20 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 					return(RIPC_CONN_ERROR);
 				}
 			}
+
+			/* the server only echoes the dictionary ID when it compresses with the same dictionary */
+			if ((comp == RSSL_COMP_ZSTD) && rsslSocketChannel->compDict && (ackDictId == rsslSocketChannel->compDict->dictId))
+			{
+				if ((ripcZstdPrepareDict(rsslSocketChannel->compDict, rsslSocketChannel->zlibCompLevel, error) != RSSL_RET_SUCCESS) ||
+					(ripcZstdUseDict(rsslSocketChannel->compDict, rsslSocketChannel->c_stream_out, rsslSocketChannel->c_stream_in, error) != RSSL_RET_SUCCESS))
+					return(RIPC_CONN_ERROR);
+			}
+			else if (rsslSocketChannel->compDict)
+			{
+				/* not in use, so only a channel that is using a dictionary keeps one */
+				ripcZstdFreeDict(rsslSocketChannel->compDict);
+				rsslSocketChannel->compDict = 0;
+			}
 		}
 		break;
 		default:
@@ -6901,11 +7780,11 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 		printf("Session active ConnVer 0x%x ripcVer 0x%x comp %d\n", rsslSocketChannel->version->connVersion, versionNumber, rsslSocketChannel->inDecompress);
 
 	/* Initialize the input buffer */
-	rsslSocketChannel->inputBuffer = rtr_smplcAllocMsg(gblInputBufs, (rsslSocketChannel->maxMsgSize * rsslSocketChannel->readSize));
+	rsslSocketChannel->inputBuffer = ipcAllocChannelMsg(rsslSocketChannel, (rsslSocketChannel->maxMsgSize * rsslSocketChannel->readSize));
 
 	if (rsslSocketChannel->inDecompress)
 	{
-		rsslSocketChannel->decompressBuf = rtr_smplcAllocMsg(gblInputBufs, rsslSocketChannel->maxMsgSize);
+		rsslSocketChannel->decompressBuf = ipcAllocChannelMsg(rsslSocketChannel, rsslSocketChannel->maxMsgSize);
 		if (rsslSocketChannel->decompressBuf == 0)
 		{
 			_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -6975,6 +7854,7 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 
 	rsslSocketChannel->compressQueue = -1;
 	rsslSocketChannel->nextOutBuf = -1;
+	ripcClearWeightedFlush(rsslSocketChannel);
 
 	/* If we read more bytes than in the header, put them
 	* into the read buffer. This can happen in quick applications
@@ -7008,6 +7888,9 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
 			case RSSL_COMP_LZ4:
 				rsslSocketChannel->lowerCompressionThreshold = RSSL_COMP_DFLT_THRESHOLD_LZ4;
 				break;
+			case RSSL_COMP_ZSTD:
+				rsslSocketChannel->lowerCompressionThreshold = RSSL_COMP_DFLT_THRESHOLD_ZSTD;
+				break;
 			default:
 				break;
 			}
@@ -7022,131 +7905,538 @@ ripcSessInit ipcWaitAck(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *in
  ***************************/
 
 /* SocketBind impl */
-RsslRet rsslSocketBind(rsslServerImpl* rsslSrvrImpl, RsslBindOptions *opts, RsslError *error )
+#ifdef Linux
+/* How long a handshake worker waits for its channels to become readable before driving them
+ * anyway, which covers handshakes that are waiting to write. */
+#define RIPC_HANDSHAKE_POLL_MS	10
+
+static void ripcHandshakeSignal(int fd)
 {
-	RsslServerSocketChannel*	rsslServerSocketChannel = NULL;
-	rtr_bufferpool_t	*serverPool=0; /* buffer pool */
-	RsslUInt32			poolSize = 0;	/* number of pool buffers */
-	RsslInt32			connType = opts->connectionType;
-	RsslInt32			tempLen = 0;
-	RsslInt32			retCode = 0;
+	RsslUInt64 one = 1;
 
-	if (opts->numInputBuffers <= 1)
-	{
-		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
-			"<%s:%d> Error: 1004 invalid number of input buffers specified(<%d>), must be at least <%d>.\n",
-			__FILE__, __LINE__, opts->numInputBuffers, 2);
-		return RSSL_RET_FAILURE;
-	}
+	if (write(fd, &one, sizeof(one)) < 0)
+		return;
+}
 
-	if (opts->guaranteedOutputBuffers < 1)
-	{
-		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
-			"<%s:%d> Error: 1004 invalid number of guaranteed output buffers <%d>, must be at least <%d>.\n",
-			__FILE__, __LINE__, opts->guaranteedOutputBuffers, 1);
-		return RSSL_RET_FAILURE;
-	}
+/* Negotiates the channels on a worker's list until the server is closed.  Every pass waits for
+ * the channels to become readable and then drives each of them once with ipcSessionInit(),
+ * without holding the worker's mutex.  Channels whose negotiation ended are taken off the list
+ * and their handshakeFd is signalled, so the application calls rsslInitChannel() again. */
+static RSSL_THREAD_DECLARE(ripcHandshakeThread, pArg)
+{
+	ripcHandshakeWorker	*worker = (ripcHandshakeWorker*)pArg;
+	struct pollfd		*pollFds = 0;
+	RsslSocketChannel	**pollChannels = 0;
+	RsslUInt32			pollSize = 0;
+	RsslUInt32			count, i;
+	RsslQueueLink		*pLink;
+	RsslUInt64			wakeCount;
+	RsslInt32			ready;
 
-	if ((opts->connectionType != RSSL_CONN_TYPE_SOCKET) && (opts->connectionType != RSSL_CONN_TYPE_HTTP) && (opts->connectionType != RSSL_CONN_TYPE_EXT_LINE_SOCKET))
+	for (;;)
 	{
-		_rsslSetError(error, NULL, RSSL_RET_INVALID_ARGUMENT, 0);
-		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 0006 Connection type %d is not supported.\n", __FILE__, __LINE__, opts->connectionType);
-		return RSSL_RET_FAILURE;
-	}
+		(void) RSSL_MUTEX_LOCK(&worker->mutex);
+		if (worker->stop)
+		{
+			(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+			break;
+		}
 
-	if (ipcValidServerName(opts->serviceName, MAX_SERV_NAME) < 0)
-	{
-		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 Invalid serviceName or port number specified <%s>\n",
-			__FILE__, __LINE__, opts->serviceName);
-		return RSSL_RET_FAILURE;
-	}
+		count = rsslQueueGetElementCount(&worker->channels);
+		if (count + 1 > pollSize)
+		{
+			RsslUInt32 newSize = (count + 1) * 2;
+			struct pollfd *newFds = (struct pollfd*)_rsslMalloc(newSize * sizeof(struct pollfd));
+			RsslSocketChannel **newChannels = (RsslSocketChannel**)_rsslMalloc(newSize * sizeof(RsslSocketChannel*));
 
-	if ((opts->compressionType & ~RSSL_COMP_ALL_TYPE) != 0)
-	{
-		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 Invalid compression type <0x%x>\n",
-			__FILE__, __LINE__, opts->compressionType);
-		return RSSL_RET_FAILURE;
-	}
+			if (newFds && newChannels)
+			{
+				if (pollFds)
+				{
+					_rsslFree(pollFds);
+					_rsslFree(pollChannels);
+				}
+				pollFds = newFds;
+				pollChannels = newChannels;
+				pollSize = newSize;
+			}
+			else
+			{
+				if (newFds)
+					_rsslFree(newFds);
+				if (newChannels)
+					_rsslFree(newChannels);
+			}
+		}
 
-	if (opts->connectionType == RSSL_CONN_TYPE_ENCRYPTED)
-	{
-		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-		snprintf(error->text, MAX_RIPC_ERROR_TEXT, "<%s:%d> Error: 1004 SSL Tunneling not supported in this library.", __FILE__, __LINE__);
-		return RSSL_RET_FAILURE;
-	}
+		/* the rest wait for the next pass if the arrays could not grow */
+		if (count + 1 > pollSize)
+			count = (pollSize ? pollSize - 1 : 0);
 
-	// make sure that only one compression type is specified if using forced compression
-	if(opts->compressionType && opts->forceCompression)
-	{
-		RsslUInt32 i, count = 0;
+		i = 0;
+		RSSL_QUEUE_FOR_EACH_LINK(&worker->channels, pLink)
+		{
+			RsslSocketChannel *rsslSocketChannel;
 
-		for (i = 0; i<32; i++)
+			if (i == count)
+				break;
+			rsslSocketChannel = RSSL_QUEUE_LINK_TO_OBJECT(RsslSocketChannel, handshakeLink, pLink);
+			pollChannels[i] = rsslSocketChannel;
+			pollFds[i + 1].fd = (int)rsslSocketChannel->stream;
+			pollFds[i + 1].events = POLLIN;
+			pollFds[i + 1].revents = 0;
+			++i;
+		}
+		(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+
+		if (pollSize == 0)
 		{
-			if ((1 << i) & opts->compressionType)
-				count++;
+			/* nothing can be polled without memory; try again shortly */
+			usleep(RIPC_HANDSHAKE_POLL_MS * 1000);
+			continue;
 		}
-		if (count == 0)
+
+		pollFds[0].fd = worker->wakeFd;
+		pollFds[0].events = POLLIN;
+		pollFds[0].revents = 0;
+
+		ready = poll(pollFds, count + 1, count ? RIPC_HANDSHAKE_POLL_MS : -1);
+		if (ready < 0)
+			continue;
+
+		if (pollFds[0].revents & POLLIN)
 		{
-			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 Force compression cannot be used without a valid compression type.\n", __FILE__, __LINE__);
-			relRsslServerSocketChannel(rsslServerSocketChannel);
-			return RSSL_RET_FAILURE;
+			if (read(worker->wakeFd, &wakeCount, sizeof(wakeCount)) < 0)
+				wakeCount = 0;
+			--ready;
 		}
-		if (count > 1)
+
+		for (i = 0; i < count; i++)
 		{
-			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-			snprintf(error->text, MAX_RIPC_ERROR_TEXT, "<%s:%d> Error: 1004 Cannot specify multiple compressionTypes when using force compression.\n", __FILE__, __LINE__);
-			relRsslServerSocketChannel(rsslServerSocketChannel);
-			return RSSL_RET_FAILURE;
+			RsslSocketChannel	*rsslSocketChannel = pollChannels[i];
+			ripcSessInProg		inPr;
+			RsslError			error;
+			ripcSessInit		ret;
+
+			/* on a timeout every channel is driven */
+			if (ready > 0 && pollFds[i + 1].revents == 0)
+				continue;
+
+			(void) RSSL_MUTEX_LOCK(&worker->mutex);
+			/* it may have been closed since the list was read */
+			if (worker->stop || rsslSocketChannel->handshakeWorker != worker ||
+				rsslSocketChannel->handshakeState != RIPC_HS_WORKING)
+			{
+				(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+				continue;
+			}
+			worker->current = rsslSocketChannel;
+			(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+
+			ret = ipcSessionInit(rsslSocketChannel, &inPr, &error);
+
+			(void) RSSL_MUTEX_LOCK(&worker->mutex);
+			worker->current = 0;
+			if (ret != RIPC_CONN_IN_PROGRESS)
+			{
+				rsslQueueRemoveLink(&worker->channels, &rsslSocketChannel->handshakeLink);
+				rsslSocketChannel->handshakeResult = ret;
+				rsslSocketChannel->handshakeError = error;
+				rsslSocketChannel->handshakeState = RIPC_HS_DONE;
+				ripcHandshakeSignal(rsslSocketChannel->handshakeFd);
+			}
+			(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
 		}
 	}
 
-	rsslServerSocketChannel = newRsslServerSocketChannel();
-
-	if (rsslServerSocketChannel == 0)
+	if (pollFds)
 	{
-		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
-		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 0005 Could not allocate memory for binding socket.\n", __FILE__, __LINE__);
-		return RSSL_RET_FAILURE;
+		_rsslFree(pollFds);
+		_rsslFree(pollChannels);
 	}
 
-	/* added for infra group */
-	if ((opts->maxFragmentSize >= RSSL_MIN_FRAG_SIZE) && (opts->maxFragmentSize <= 0xFFFF))
-		rsslServerSocketChannel->maxMsgSize = opts->maxFragmentSize;
-	else
-		rsslServerSocketChannel->maxMsgSize = RSSL_MAX_MSG_SIZE;
+	return RSSL_THREAD_RETURN();
+}
 
-	rsslServerSocketChannel->interfaceName = opts->interfaceName;
+/* Stops the workers.  Channels they had not finished fail with an error. */
+static void ripcDestroyHandshakePool(ripcHandshakePool *pool)
+{
+	RsslUInt32 i;
 
-	/* setup compression */
-	rsslServerSocketChannel->compressionSupported = opts->compressionType;
-	/* set to default compression - may want to expose this if we decide
-	   to start using compression */
-	if (opts->compressionType != 0)
+	for (i = 0; i < pool->numWorkers; i++)
 	{
-		rsslServerSocketChannel->zlibCompressionLevel = opts->compressionLevel;
-		rsslServerSocketChannel->forcecomp = opts->forceCompression;
+		ripcHandshakeWorker *worker = &pool->workers[i];
+
+		(void) RSSL_MUTEX_LOCK(&worker->mutex);
+		worker->stop = RSSL_TRUE;
+		(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+		ripcHandshakeSignal(worker->wakeFd);
 	}
 
-	rsslServerSocketChannel->server_blocking = (opts->serverBlocking ? 1 : 0);
-	rsslServerSocketChannel->session_blocking = (opts->channelsBlocking ? 1 : 0);
+	for (i = 0; i < pool->numWorkers; i++)
+	{
+		ripcHandshakeWorker *worker = &pool->workers[i];
+		RsslQueueLink *pLink;
 
-	/* check to make sure ping timeouts are valid - we set to 0 if client and server pings are off */
-	/* 0 implies no pinging */
+		RSSL_THREAD_JOIN(worker->threadId);
 
-	if ((opts->minPingTimeout > 0) && (opts->minPingTimeout <= IPC_MAXIMUM_PINGTIMEOUT))
-		rsslServerSocketChannel->minPingTimeout = opts->minPingTimeout;
-	else if ((opts->minPingTimeout == 0) && (opts->clientToServerPings || opts->serverToClientPings))
-		rsslServerSocketChannel->minPingTimeout = IPC_MINIMUM_PINGTIMEOUT;
-	else if (opts->pingTimeout > IPC_MAXIMUM_PINGTIMEOUT)
-		rsslServerSocketChannel->minPingTimeout = IPC_MAXIMUM_PINGTIMEOUT;
+		(void) RSSL_MUTEX_LOCK(&worker->mutex);
+		while ((pLink = rsslQueueRemoveFirstLink(&worker->channels)) != NULL)
+		{
+			RsslSocketChannel *rsslSocketChannel = RSSL_QUEUE_LINK_TO_OBJECT(RsslSocketChannel, handshakeLink, pLink);
 
-	if ((opts->pingTimeout > 0) && (opts->pingTimeout <= IPC_MAXIMUM_PINGTIMEOUT) && (opts->pingTimeout >= (RsslUInt32)rsslServerSocketChannel->minPingTimeout))
-		rsslServerSocketChannel->pingTimeout = opts->pingTimeout;
+			rsslSocketChannel->handshakeWorker = 0;
+			rsslSocketChannel->handshakeResult = RIPC_CONN_ERROR;
+			_rsslSetError(&rsslSocketChannel->handshakeError, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(rsslSocketChannel->handshakeError.text, MAX_RSSL_ERROR_TEXT,
+				"<%s:%d> Error: 1003 Server was closed before the channel finished its handshake.\n",
+				__FILE__, __LINE__);
+			rsslSocketChannel->handshakeState = RIPC_HS_DONE;
+			ripcHandshakeSignal(rsslSocketChannel->handshakeFd);
+		}
+		(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+
+		(void) RSSL_MUTEX_DESTROY(&worker->mutex);
+		close(worker->wakeFd);
+	}
+
+	_rsslFree(pool->workers);
+	_rsslFree(pool);
+}
+
+static ripcHandshakePool *ripcCreateHandshakePool(RsslUInt32 numWorkers, RsslError *error)
+{
+	ripcHandshakePool *pool = (ripcHandshakePool*)_rsslMalloc(sizeof(ripcHandshakePool));
+	RsslUInt32 i;
+
+	if (pool == NULL || (pool->workers = (ripcHandshakeWorker*)_rsslMalloc(numWorkers * sizeof(ripcHandshakeWorker))) == NULL)
+	{
+		if (pool)
+			_rsslFree(pool);
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1001 Failed to allocate handshake workers.\n", __FILE__, __LINE__);
+		return NULL;
+	}
+
+	memset(pool->workers, 0, numWorkers * sizeof(ripcHandshakeWorker));
+	pool->numWorkers = 0;
+	pool->nextWorker = 0;
+
+	for (i = 0; i < numWorkers; i++)
+	{
+		ripcHandshakeWorker *worker = &pool->workers[i];
+
+		rsslInitQueue(&worker->channels);
+		worker->current = 0;
+		worker->stop = RSSL_FALSE;
+		if ((worker->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0)
+			break;
+
+		(void) RSSL_MUTEX_INIT_ESDK(&worker->mutex);
+		if (RSSL_THREAD_START(&worker->threadId, ripcHandshakeThread, worker) != 0)
+		{
+			(void) RSSL_MUTEX_DESTROY(&worker->mutex);
+			close(worker->wakeFd);
+			break;
+		}
+		pool->numWorkers++;
+	}
+
+	if (pool->numWorkers != numWorkers)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1002 Failed to start handshake worker %u. System errno: (%d)\n",
+			__FILE__, __LINE__, pool->numWorkers, errno);
+		ripcDestroyHandshakePool(pool);
+		return NULL;
+	}
+
+	return pool;
+}
+
+/* Hands a channel of a server with handshake workers to one of them, then returns its result
+ * over the next calls: the first call changes the channel's descriptor to its handshakeFd, and
+ * once that is signalled, a successful channel gets its connection back and is active on the
+ * call after. */
+static ripcSessInit ripcHandshakeInit(RsslSocketChannel *rsslSocketChannel, ripcSessInProg *inPr, RsslError *error)
+{
+	ripcHandshakePool	*pool;
+	ripcHandshakeWorker	*worker;
+	RsslUInt8			state;
+
+	inPr->types = 0;
+	inPr->intConnState = 0;
+
+	switch (rsslSocketChannel->handshakeState)
+	{
+		case RIPC_HS_NONE:
+			pool = rsslSocketChannel->server->handshakePool;
+
+			if ((rsslSocketChannel->handshakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0)
+			{
+				/* negotiate it on this thread instead */
+				rsslSocketChannel->handshakeState = RIPC_HS_FINISHED;
+				return ipcSessionInit(rsslSocketChannel, inPr, error);
+			}
+
+			worker = &pool->workers[pool->nextWorker++ % pool->numWorkers];
+
+			(void) RSSL_MUTEX_LOCK(&worker->mutex);
+			rsslSocketChannel->handshakeWorker = worker;
+			rsslSocketChannel->handshakeState = RIPC_HS_WORKING;
+			rsslQueueAddLinkToBack(&worker->channels, &rsslSocketChannel->handshakeLink);
+			(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+			ripcHandshakeSignal(worker->wakeFd);
+
+			inPr->types = RIPC_INPROG_NEW_FD;
+			inPr->oldSocket = rsslSocketChannel->stream;
+			inPr->newSocket.stream = rsslSocketChannel->handshakeFd;
+			return RIPC_CONN_IN_PROGRESS;
+
+		case RIPC_HS_WORKING:
+		case RIPC_HS_DONE:
+			if ((worker = rsslSocketChannel->handshakeWorker) != 0)
+			{
+				(void) RSSL_MUTEX_LOCK(&worker->mutex);
+				state = rsslSocketChannel->handshakeState;
+				(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+
+				if (state == RIPC_HS_WORKING)
+					return RIPC_CONN_IN_PROGRESS;
+
+				rsslSocketChannel->handshakeWorker = 0;
+			}
+
+			if (rsslSocketChannel->handshakeResult == RIPC_CONN_ACTIVE)
+			{
+				rsslSocketChannel->handshakeState = RIPC_HS_HANDED_BACK;
+				inPr->types = RIPC_INPROG_NEW_FD;
+				inPr->oldSocket = rsslSocketChannel->handshakeFd;
+				inPr->newSocket.stream = rsslSocketChannel->stream;
+				return RIPC_CONN_IN_PROGRESS;
+			}
+
+			/* the handshakeFd stays the channel's descriptor until it is closed */
+			rsslSocketChannel->handshakeState = RIPC_HS_FINISHED;
+			*error = rsslSocketChannel->handshakeError;
+			return rsslSocketChannel->handshakeResult;
+
+		case RIPC_HS_HANDED_BACK:
+			close(rsslSocketChannel->handshakeFd);
+			rsslSocketChannel->handshakeFd = -1;
+			rsslSocketChannel->handshakeState = RIPC_HS_FINISHED;
+			inPr->intConnState = rsslSocketChannel->intState;
+			return RIPC_CONN_ACTIVE;
+
+		default:
+			return ipcSessionInit(rsslSocketChannel, inPr, error);
+	}
+}
+
+/* Takes a channel that is being closed away from its handshake worker, waiting if the worker is
+ * driving it right now. */
+static void ripcHandshakeDetach(RsslSocketChannel *rsslSocketChannel)
+{
+	ripcHandshakeWorker *worker = rsslSocketChannel->handshakeWorker;
+
+	if (worker)
+	{
+		(void) RSSL_MUTEX_LOCK(&worker->mutex);
+		if (rsslSocketChannel->handshakeState == RIPC_HS_WORKING)
+			rsslQueueRemoveLink(&worker->channels, &rsslSocketChannel->handshakeLink);
+		rsslSocketChannel->handshakeState = RIPC_HS_FINISHED;
+
+		while (worker->current == rsslSocketChannel)
+		{
+			(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+			usleep(1000);
+			(void) RSSL_MUTEX_LOCK(&worker->mutex);
+		}
+		rsslSocketChannel->handshakeWorker = 0;
+		(void) RSSL_MUTEX_UNLOCK(&worker->mutex);
+	}
+
+	if (rsslSocketChannel->handshakeFd >= 0)
+	{
+		close(rsslSocketChannel->handshakeFd);
+		rsslSocketChannel->handshakeFd = -1;
+	}
+	rsslSocketChannel->handshakeState = RIPC_HS_NONE;
+}
+#endif
+
+RsslRet rsslSocketBind(rsslServerImpl* rsslSrvrImpl, RsslBindOptions *opts, RsslError *error )
+{
+	RsslServerSocketChannel*	rsslServerSocketChannel = NULL;
+	rtr_bufferpool_t	*serverPool=0; /* buffer pool */
+	RsslUInt32			poolSize = 0;	/* number of pool buffers */
+	RsslInt32			connType = opts->connectionType;
+	RsslInt32			tempLen = 0;
+	RsslInt32			retCode = 0;
+
+	if (opts->numInputBuffers <= 1)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1004 invalid number of input buffers specified(<%d>), must be at least <%d>.\n",
+			__FILE__, __LINE__, opts->numInputBuffers, 2);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (opts->guaranteedOutputBuffers < 1)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+			"<%s:%d> Error: 1004 invalid number of guaranteed output buffers <%d>, must be at least <%d>.\n",
+			__FILE__, __LINE__, opts->guaranteedOutputBuffers, 1);
+		return RSSL_RET_FAILURE;
+	}
+
+	if ((opts->connectionType != RSSL_CONN_TYPE_SOCKET) && (opts->connectionType != RSSL_CONN_TYPE_HTTP) && (opts->connectionType != RSSL_CONN_TYPE_EXT_LINE_SOCKET) &&
+		((opts->connectionType != RSSL_CONN_TYPE_BIDIR_SHMEM) || (transFuncs[RSSL_CONN_TYPE_BIDIR_SHMEM].bindSrvr == 0)))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_INVALID_ARGUMENT, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 0006 Connection type %d is not supported.\n", __FILE__, __LINE__, opts->connectionType);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (ipcValidServerName(opts->serviceName, MAX_SERV_NAME) < 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 Invalid serviceName or port number specified <%s>\n",
+			__FILE__, __LINE__, opts->serviceName);
+		return RSSL_RET_FAILURE;
+	}
+
+	if ((opts->compressionType & ~RSSL_COMP_ALL_TYPE) != 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 Invalid compression type <0x%x>\n",
+			__FILE__, __LINE__, opts->compressionType);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (opts->compressionDictionary.length && !(opts->compressionType & RSSL_COMP_ZSTD))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 A compression dictionary can only be used with RSSL_COMP_ZSTD.\n",
+			__FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (opts->connectionType == RSSL_CONN_TYPE_ENCRYPTED)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RIPC_ERROR_TEXT, "<%s:%d> Error: 1004 SSL Tunneling not supported in this library.", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+
+	if (opts->handshakeThreads)
+	{
+#ifdef Linux
+		if (multiThread == RSSL_LOCK_NONE)
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 handshakeThreads requires rsslInitialize() to be called with locking enabled.\n",
+				__FILE__, __LINE__);
+			return RSSL_RET_FAILURE;
+		}
+#else
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 handshakeThreads is not supported on this platform.\n",
+			__FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+#endif
+	}
+
+	// make sure that only one compression type is specified if using forced compression
+	if(opts->compressionType && opts->forceCompression)
+	{
+		RsslUInt32 i, count = 0;
+
+		for (i = 0; i<32; i++)
+		{
+			if ((1 << i) & opts->compressionType)
+				count++;
+		}
+		if (count == 0)
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 Force compression cannot be used without a valid compression type.\n", __FILE__, __LINE__);
+			relRsslServerSocketChannel(rsslServerSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+		if (count > 1)
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RIPC_ERROR_TEXT, "<%s:%d> Error: 1004 Cannot specify multiple compressionTypes when using force compression.\n", __FILE__, __LINE__);
+			relRsslServerSocketChannel(rsslServerSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+	}
+
+	rsslServerSocketChannel = newRsslServerSocketChannel();
+
+	if (rsslServerSocketChannel == 0)
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 0005 Could not allocate memory for binding socket.\n", __FILE__, __LINE__);
+		return RSSL_RET_FAILURE;
+	}
+
+	/* added for infra group */
+	if ((opts->maxFragmentSize >= RSSL_MIN_FRAG_SIZE) && (opts->maxFragmentSize <= 0xFFFF))
+		rsslServerSocketChannel->maxMsgSize = opts->maxFragmentSize;
+	else
+		rsslServerSocketChannel->maxMsgSize = RSSL_MAX_MSG_SIZE;
+
+	rsslServerSocketChannel->interfaceName = opts->interfaceName;
+
+	/* setup compression */
+	rsslServerSocketChannel->compressionSupported = opts->compressionType;
+	/* set to default compression - may want to expose this if we decide
+	   to start using compression */
+	if (opts->compressionType != 0)
+	{
+		rsslServerSocketChannel->zlibCompressionLevel = opts->compressionLevel;
+		rsslServerSocketChannel->forcecomp = opts->forceCompression;
+	}
+
+	/* without the zstd library, zstd is not offered and clients that ask for it get the other types (or none) */
+	if ((opts->compressionType & RSSL_COMP_ZSTD) && (compressFuncs[RSSL_COMP_ZSTD].compress == 0))
+	{
+		rsslServerSocketChannel->compressionSupported &= ~RSSL_COMP_ZSTD;
+		if (rsslServerSocketChannel->compressionSupported == 0)
+			rsslServerSocketChannel->forcecomp = 0;
+	}
+
+	/* the dictionary is digested once here and shared by every accepted channel that negotiates it */
+	if (opts->compressionDictionary.length && (rsslServerSocketChannel->compressionSupported & RSSL_COMP_ZSTD))
+	{
+		if (((rsslServerSocketChannel->compDict = ripcZstdCreateDict(opts->compressionDictionary.data, opts->compressionDictionary.length, error)) == 0) ||
+			(ripcZstdPrepareDict(rsslServerSocketChannel->compDict, opts->compressionLevel, error) != RSSL_RET_SUCCESS))
+		{
+			relRsslServerSocketChannel(rsslServerSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+	}
+
+	rsslServerSocketChannel->server_blocking = (opts->serverBlocking ? 1 : 0);
+	rsslServerSocketChannel->session_blocking = (opts->channelsBlocking ? 1 : 0);
+	rsslServerSocketChannel->serverSharedSocket = (opts->serverSharedSocket ? 1 : 0);
+
+	/* check to make sure ping timeouts are valid - we set to 0 if client and server pings are off */
+	/* 0 implies no pinging */
+
+	if ((opts->minPingTimeout > 0) && (opts->minPingTimeout <= IPC_MAXIMUM_PINGTIMEOUT))
+		rsslServerSocketChannel->minPingTimeout = opts->minPingTimeout;
+	else if ((opts->minPingTimeout == 0) && (opts->clientToServerPings || opts->serverToClientPings))
+		rsslServerSocketChannel->minPingTimeout = IPC_MINIMUM_PINGTIMEOUT;
+	else if (opts->pingTimeout > IPC_MAXIMUM_PINGTIMEOUT)
+		rsslServerSocketChannel->minPingTimeout = IPC_MAXIMUM_PINGTIMEOUT;
+
+	if ((opts->pingTimeout > 0) && (opts->pingTimeout <= IPC_MAXIMUM_PINGTIMEOUT) && (opts->pingTimeout >= (RsslUInt32)rsslServerSocketChannel->minPingTimeout))
+		rsslServerSocketChannel->pingTimeout = opts->pingTimeout;
 	else if ((opts->pingTimeout == 0) && (opts->clientToServerPings || opts->serverToClientPings))
 		rsslServerSocketChannel->pingTimeout = IPC_MINIMUM_PINGTIMEOUT;
 	else if (opts->pingTimeout > IPC_MAXIMUM_PINGTIMEOUT)
@@ -7168,6 +8458,8 @@ RsslRet rsslSocketBind(rsslServerImpl* rsslSrvrImpl, RsslBindOptions *opts, Rssl
 	else
 		rsslServerSocketChannel->tcp_nodelay = 0;
 
+	rsslServerSocketChannel->autoPackSize = opts->tcpOpts.autoPackSize;
+
 	if (opts->maxOutputBuffers < opts->guaranteedOutputBuffers)
 		rsslServerSocketChannel->maxNumMsgs = opts->guaranteedOutputBuffers;
 	else
@@ -7186,8 +8478,10 @@ RsslRet rsslSocketBind(rsslServerImpl* rsslSrvrImpl, RsslBindOptions *opts, Rssl
 
 	rsslServerSocketChannel->numInputBufs = opts->numInputBuffers;
 
-	/* Create buffer pool for server */
-	if (opts->sharedPoolLock)
+	rsslServerSocketChannel->sharedPoolCacheSize = opts->sharedPoolCacheSize;
+
+	/* Create buffer pool for server; handshake workers allocate from it too */
+	if (opts->sharedPoolLock || opts->handshakeThreads)
 	{
 #ifdef MUTEX_DEBUG
 	    printf("MUTEX_INIT rsslSrvrImpl->sharedBufPoolMutex -- rsslSocketBind\n");
@@ -7308,6 +8602,18 @@ RsslRet rsslSocketBind(rsslServerImpl* rsslSrvrImpl, RsslBindOptions *opts, Rssl
 	rsslSrvrImpl->sendBufSize = opts->sysSendBufSize;
 	rsslSrvrImpl->recvBufSize = opts->sysRecvBufSize;
 
+#ifdef Linux
+	if (opts->handshakeThreads)
+	{
+		if ((rsslServerSocketChannel->handshakePool = ripcCreateHandshakePool(opts->handshakeThreads, error)) == NULL)
+		{
+			transFuncs[rsslServerSocketChannel->connType].shutdownSrvrError(rsslSrvrImpl);
+			relRsslServerSocketChannel(rsslServerSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+	}
+#endif
+
 	/*store user defined component version info from bind options, if it's present*/
 	if (opts->componentVersion  != NULL)
 	{
@@ -7335,7 +8641,8 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 	void*	userSpecPtr = 0;
 	RsslInt32	initcomplete;
 
-	if( !(opts->hostName) && !(opts->connectionInfo.unified.address) )
+	/* a shared memory server is always on this host, so its address is not needed */
+	if( !(opts->hostName) && !(opts->connectionInfo.unified.address) && (opts->connectionType != RSSL_CONN_TYPE_BIDIR_SHMEM) )
 	{
 		_rsslSetError(error, NULL, RSSL_RET_INVALID_ARGUMENT, 0);
 		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 0013 rsslSocketConnect() No hostName or unified.address provided.\n", __FILE__, __LINE__);
@@ -7399,6 +8706,20 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 			return RSSL_RET_FAILURE;
 		}
 	}
+	else
+	{
+		rsslSocketChannel->hostName = (char*) strncpy((char*)_rsslMalloc(10), "localhost", 10);
+		if (rsslSocketChannel->hostName == 0)
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1001 Failed to allocate or copy hostName. System errno: (%d)\n",
+					__FILE__, __LINE__, errno);
+
+			ripcRelSocketChannel(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+	}
 
 	if (opts->serviceName)
 	{
@@ -7465,6 +8786,30 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 	rsslSocketChannel->blocking = opts->blocking;
 	rsslSocketChannel->compression = opts->compressionType;
 
+	if (opts->compressionDictionary.length && !(opts->compressionType & RSSL_COMP_ZSTD))
+	{
+		_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> Error: 1004 A compression dictionary can only be used with RSSL_COMP_ZSTD.\n",
+			__FILE__, __LINE__);
+		ripcRelSocketChannel(rsslSocketChannel);
+		return RSSL_RET_FAILURE;
+	}
+
+	/* without the zstd library, connect without compression as with a server that does not support it */
+	if ((opts->compressionType & RSSL_COMP_ZSTD) && (compressFuncs[RSSL_COMP_ZSTD].compress == 0))
+		rsslSocketChannel->compression = RSSL_COMP_NONE;
+
+	/* The dictionary is offered to the server by ID in the handshake; the compression side
+	 * is prepared once the server has accepted it and told us the level to use. */
+	if (opts->compressionDictionary.length && (rsslSocketChannel->compression & RSSL_COMP_ZSTD))
+	{
+		if ((rsslSocketChannel->compDict = ripcZstdCreateDict(opts->compressionDictionary.data, opts->compressionDictionary.length, error)) == 0)
+		{
+			ripcRelSocketChannel(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+	}
+
 	/* check ping timeout for valid value */
 	if ((opts->pingTimeout > 0) && (opts->pingTimeout <= IPC_MAXIMUM_PINGTIMEOUT))
 		rsslSocketChannel->pingTimeout = opts->pingTimeout;
@@ -7506,9 +8851,12 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 	else
 		rsslSocketChannel->tcp_nodelay = 0;
 
+	rsslSocketChannel->autoPackSize = opts->tcpOpts.autoPackSize;
+
 	rsslSocketChannel->numInputBufs = opts->numInputBuffers;
 	
 	rsslSocketChannel->encryptionProtocolFlags = opts->encryptionOpts.encryptionProtocolFlags;
+	rsslSocketChannel->kernelTlsOffload = opts->encryptionOpts.kernelTlsOffload;
 
 	/* Set Proxy options, if present */
 	/* If we are on windows and using HTTP/Encrypted we shouldnt set these because options will come in from WinInet/IE settings */
@@ -7557,6 +8905,7 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 		case RSSL_CONN_TYPE_SOCKET:
 		case RSSL_CONN_TYPE_ENCRYPTED:
 		case RSSL_CONN_TYPE_HTTP:
+		case RSSL_CONN_TYPE_BIDIR_SHMEM:
 			rsslSocketChannel->connType = (RsslUInt32)opts->connectionType;
 			break;
 		default:
@@ -7575,6 +8924,11 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 
 	switch(rsslSocketChannel->ripcVersion)
 	{
+		case RIPC_VERSION_15:
+			/* version 15 only adds the zstd dictionary ID, so a channel without a dictionary
+			 * offers 14 and saves older servers from rejecting the first connection attempt */
+			version = (rsslSocketChannel->compDict ? &ripc15Ver : &ripc14Ver);
+			break;
 		case RIPC_VERSION_14:
 			version = &ripc14Ver;
 			break;
@@ -7630,6 +8984,18 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 	case RSSL_CONN_TYPE_SOCKET:
 		rsslSocketChannel->transportFuncs = &(transFuncs[RSSL_CONN_TYPE_SOCKET]);
 		break;
+	case RSSL_CONN_TYPE_BIDIR_SHMEM:
+		if (transFuncs[RSSL_CONN_TYPE_BIDIR_SHMEM].connectSocket == 0)
+		{
+			_rsslSetError(error, NULL, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 Bidirectional shared memory connections are not supported on this platform.\n",
+					__FILE__, __LINE__);
+
+			return RSSL_RET_FAILURE;
+		}
+		rsslSocketChannel->transportFuncs = &(transFuncs[RSSL_CONN_TYPE_BIDIR_SHMEM]);
+		break;
 	case RSSL_CONN_TYPE_EXT_LINE_SOCKET:
 		if (rsslLoadInitTransport(&(transFuncs[RSSL_CONN_TYPE_EXT_LINE_SOCKET]),
 											0,
@@ -7726,6 +9092,7 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 
 				return RSSL_RET_FAILURE;
 			}
+			userSpecPtr = (void*)&(rsslSocketChannel->kernelTlsOffload);
 		}
 		else
 		{
@@ -7747,9 +9114,18 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 	/* for now we can only set one compression type */
 	/* not sure why we are indexing into compressionBitmap since its an array of only 1 byte */
 	{
-		RsslInt16 idx = ripccompressions[rsslSocketChannel->compression][RSSL_COMP_BYTEINDEX];
-		if (idx < RSSL_COMP_BITMAP_SIZE)
-			rsslSocketChannel->compressionBitmap[idx] |= ripccompressions[rsslSocketChannel->compression][RSSL_COMP_BYTEBIT];
+		RsslInt32 i;
+
+		for (i = 0; i < RIPC_COMP_TABLE_SIZE; i++)
+		{
+			if (ripccompressions[i][RSSL_COMP_TYPE] == rsslSocketChannel->compression)
+			{
+				RsslInt16 idx = ripccompressions[i][RSSL_COMP_BYTEINDEX];
+				if (idx < RSSL_COMP_BITMAP_SIZE)
+					rsslSocketChannel->compressionBitmap[idx] |= ripccompressions[i][RSSL_COMP_BYTEBIT];
+				break;
+			}
+		}
 	}
 
 	/* normal connection */
@@ -7776,6 +9152,8 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 
 	rsslSocketChannel->guarBufPool = rtr_dfltcAllocPool(rsslSocketChannel->numGuarOutputBufs, rsslSocketChannel->numGuarOutputBufs, 10,
 		rsslSocketChannel->bufPool, (rsslSocketChannel->numMaxOutputBufs - rsslSocketChannel->numGuarOutputBufs), 0);
+	if (rsslSocketChannel->guarBufPool)
+		(void)rtr_dfltcSetPageArena(rsslSocketChannel->guarBufPool, rsslSocketChannel->pageArena);
 	if (rsslSocketChannel->guarBufPool == 0)
 	{
 		_rsslSetError(error, NULL, RSSL_RET_FAILURE, errno);
@@ -7797,7 +9175,7 @@ RsslRet rsslSocketConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *opt
 	rsslSocketChannel->minorVersion = (RsslUInt8)rsslSocketChannel->minorVersion;
 	rsslSocketChannel->majorVersion = (RsslUInt8)rsslSocketChannel->majorVersion;
 
-	rsslSocketChannel->inDecompress = opts->compressionType;
+	rsslSocketChannel->inDecompress = rsslSocketChannel->compression;
 
 	if ((rsslSocketChannel->proxyPort && rsslSocketChannel->proxyPort[0] != '\0') && (rsslSocketChannel->usingWinInet == 0))
 	{
@@ -7961,6 +9339,10 @@ static RsslSocketChannel *ipcClientChannel(rsslServerImpl* serverImpl, RsslError
 		rsslSocketChannel->connType = RSSL_CONN_TYPE_SOCKET;
 		rsslSocketChannel->transportFuncs = &(transFuncs[rsslSocketChannel->connType]);
 		break;
+	case RSSL_CONN_TYPE_BIDIR_SHMEM:
+		rsslSocketChannel->connType = RSSL_CONN_TYPE_BIDIR_SHMEM;
+		rsslSocketChannel->transportFuncs = &(transFuncs[rsslSocketChannel->connType]);
+		break;
 	case RSSL_CONN_TYPE_EXT_LINE_SOCKET:
 		//TODO anaylize if a different mehtod exists such that these case statements can be eliminated
 		if (rsslLoadInitTransport(&(transFuncs[RSSL_CONN_TYPE_EXT_LINE_SOCKET]),
@@ -8064,6 +9446,7 @@ static RsslSocketChannel *ipcClientChannel(rsslServerImpl* serverImpl, RsslError
 
 	rsslSocketChannel->blocking = (rsslServerSocketChannel->session_blocking ? 1 : 0);
 	rsslSocketChannel->tcp_nodelay = (rsslServerSocketChannel->tcp_nodelay ? 1 : 0);
+	rsslSocketChannel->autoPackSize = rsslServerSocketChannel->autoPackSize;
 	rsslSocketChannel->maxMsgSize = rsslServerSocketChannel->maxMsgSize;
 	rsslSocketChannel->maxUserMsgSize = rsslServerSocketChannel->maxUserMsgSize;
 	rsslSocketChannel->srvrcomp = rsslServerSocketChannel->compressionSupported;
@@ -8078,7 +9461,7 @@ static RsslSocketChannel *ipcClientChannel(rsslServerImpl* serverImpl, RsslError
 	rsslSocketChannel->majorVersion = rsslServerSocketChannel->majorVersion;
 
 	/* Take care of input buffer */
-	rsslSocketChannel->inputBuffer = rtr_smplcAllocMsg(gblInputBufs, (rsslSocketChannel->maxMsgSize * rsslServerSocketChannel->numInputBufs));
+	rsslSocketChannel->inputBuffer = ipcAllocChannelMsg(rsslSocketChannel, (rsslSocketChannel->maxMsgSize * rsslServerSocketChannel->numInputBufs));
 
 	/*do not need this as we do it later when processing connect msgs */
 	/*rsslSocketChannel->curInputBuf = rtr_smplcDupMsg(gblInputBufs,rsslSocketChannel->inputBuffer);  */
@@ -8122,6 +9505,7 @@ static RsslSocketChannel *ipcClientChannel(rsslServerImpl* serverImpl, RsslError
 
 	rsslSocketChannel->compressQueue = -1;
 	rsslSocketChannel->nextOutBuf = -1;
+	ripcClearWeightedFlush(rsslSocketChannel);
 
 	rsslSocketChannel->stream = fdtemp;
 	rsslSocketChannel->state = RSSL_CH_STATE_INITIALIZING;
@@ -8353,6 +9737,14 @@ RsslRet rsslSocketInitChannel(rsslChannelImpl* rsslChnlImpl, RsslInProgInfo *inP
 		rsslSocketChannel->componentVerLen = rsslChnlImpl->componentVer.componentVersion.length;
 	}	
 
+#ifdef Linux
+	/* channels of a server with handshake workers are negotiated by them */
+	if ((rsslSocketChannel->handshakeState != RIPC_HS_NONE && rsslSocketChannel->handshakeState != RIPC_HS_FINISHED) ||
+		(rsslSocketChannel->handshakeState == RIPC_HS_NONE && !rsslSocketChannel->blocking &&
+		 rsslSocketChannel->server && rsslSocketChannel->server->handshakePool))
+		retVal = ripcHandshakeInit(rsslSocketChannel, &ripcInProg, error);
+	else
+#endif
 	/* Call ipcSessionInit */
 	retVal = ipcSessionInit(rsslSocketChannel, &ripcInProg, error);
 	inProg->internalConnState = ripcInProg.intConnState;
@@ -8501,6 +9893,10 @@ RsslRet rsslSocketCloseChannel(rsslChannelImpl* rsslChnlImpl, RsslError *error)
 		_rsslFree(rsslChnlImpl->returnBuffer.data);
 	}
 
+#ifdef Linux
+	ripcHandshakeDetach(rsslSocketChannel);
+#endif
+
 		retVal = ipcShutdownSession(rsslSocketChannel, error);
 
 		if (retVal < RSSL_RET_SUCCESS)
@@ -8575,6 +9971,15 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 		rsslChnlImpl->returnBufferOwner = 0;
 	}
 
+	/* Zero copy completions wake up readers of the socket.  They are reaped here, where the
+	 * channel's write lock is held (chanMutex is rsslSocketChannel->mutex), not in ipcReadSession. */
+	if (rtrUnlikely(rsslSocketChannel->zeroCopyNextId != rsslSocketChannel->zeroCopyDoneId))
+		ipcZeroCopyReap(rsslSocketChannel, rsslSocketChannel->stream);
+
+	/* a coalescing channel sends what it has held too long before reading */
+	if (rsslSocketChannel->coalesceDeadline)
+		ipcFlushCoalesced(rsslSocketChannel);
+
 	/* packed */
 	if ((rsslChnlImpl->packedBuffer))
 	{
@@ -8586,6 +9991,11 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 		{
 			readOutArgs->bytesRead = 0;
 			readOutArgs->uncompressedBytesRead = 0;
+			if (rsslSocketChannel->recvTimestamps && rsslSocketChannel->lastRecvStamp)
+			{
+				readOutArgs->readOutFlags |= RSSL_READ_OUT_RECV_TIMESTAMP;
+				readOutArgs->recvTimestamp = rsslSocketChannel->lastRecvStamp;
+			}
 		}
 
 		rsslChnlImpl->unpackOffset += rwfGet16(bufLength, (rsslChnlImpl->packedBuffer->buffer + rsslChnlImpl->unpackOffset));
@@ -8638,6 +10048,10 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 
 		ripcBuffer = ipcReadSession(rsslSocketChannel, &ipcReadRet, &ripcMoreData, &ripcFragSize, &ripcFragId, &inBytes, &uncompInBytes, &packing, error);
 
+		/* With busy polling, have the application read again once the input is drained, so that read polls for more */
+		if ((ripcBuffer != 0) && (ripcBuffer->length > 0) && (ripcMoreData == 0) && rsslSocketChannel->busyPollUsec)
+			ripcMoreData = 1;
+
 		rsslSocketChannel->workState &= ~RIPC_INT_READ_THR;
 	}
 
@@ -8648,6 +10062,11 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 		{
 			readOutArgs->bytesRead = inBytes;
 			readOutArgs->uncompressedBytesRead = uncompInBytes;
+			if (rsslSocketChannel->recvTimestamps && rsslSocketChannel->lastRecvStamp)
+			{
+				readOutArgs->readOutFlags |= RSSL_READ_OUT_RECV_TIMESTAMP;
+				readOutArgs->recvTimestamp = rsslSocketChannel->lastRecvStamp;
+			}
 		}
 		/* we have read something */
 		/* map ripcBuffer to RsslBuffer */
@@ -8716,8 +10135,16 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 			if (rsslAssemblyBuf)
 			{
 				_rsslCleanAssemblyBuffer(rsslAssemblyBuf);
-				/* now create the data portion */
-				rsslAssemblyBuf->buffer.data = (char*)_rsslMalloc(ripcFragSize + 7);
+				/* now create the data portion, in the application's memory if it gave us an allocator */
+				if (rsslChnlImpl->reassemblyAllocator.allocateBuffer)
+				{
+					rsslAssemblyBuf->buffer.data = (*rsslChnlImpl->reassemblyAllocator.allocateBuffer)(&rsslChnlImpl->Channel,
+							(RsslUInt32)ripcFragSize, rsslChnlImpl->reassemblyAllocator.userSpecPtr);
+					rsslAssemblyBuf->freeBuffer = rsslChnlImpl->reassemblyAllocator.freeBuffer;
+					rsslAssemblyBuf->userSpecPtr = rsslChnlImpl->reassemblyAllocator.userSpecPtr;
+				}
+				else
+					rsslAssemblyBuf->buffer.data = (char*)_rsslMalloc(ripcFragSize + 7);
 				if (rsslAssemblyBuf->buffer.data)
 					rsslAssemblyBuf->buffer.length = ripcFragSize;
 			}
@@ -8752,8 +10179,15 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 				/* no more data for this - not sure why fragmentation was used in this case */
 				/* its not in the queue yet so we do not have to remove it */
 						
-				/* i am the owner since its a fragment */
-				rsslChnlImpl->returnBufferOwner = 1;
+				/* i am the owner since its a fragment, unless the application gave us the memory */
+				if (rsslAssemblyBuf->freeBuffer)
+				{
+					rsslChnlImpl->returnBufferOwner = 0;
+					if (readOutArgs != NULL)
+						readOutArgs->readOutFlags |= RSSL_READ_OUT_CALLER_BUFFER;
+				}
+				else
+					rsslChnlImpl->returnBufferOwner = 1;
 
 				rsslChnlImpl->returnBuffer.length = rsslAssemblyBuf->buffer.length;
 				rsslChnlImpl->returnBuffer.data = rsslAssemblyBuf->buffer.data;
@@ -8793,7 +10227,7 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 						printf("removing from assemblyBuffers hash\n");
 		
 					/* now release this memory back into the pool */
-					_rsslFree(rsslTempAssemblyBuf->buffer.data);
+					_rsslFreeAssemblyBufferData(rsslChnlImpl, rsslTempAssemblyBuf);
 					rsslTempAssemblyBuf->buffer.length = 0;
 					_rsslFree(rsslTempAssemblyBuf);
 					rsslTempAssemblyBuf = 0;
@@ -8869,8 +10303,15 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 				if (memoryDebug)
 					printf("removing from assemblyBuffers hash\n");
 
-				/* I am the owner */
-				rsslChnlImpl->returnBufferOwner = 1;
+				/* I am the owner, unless the application gave us the memory */
+				if (rsslAssemblyBuf->freeBuffer)
+				{
+					rsslChnlImpl->returnBufferOwner = 0;
+					if (readOutArgs != NULL)
+						readOutArgs->readOutFlags |= RSSL_READ_OUT_CALLER_BUFFER;
+				}
+				else
+					rsslChnlImpl->returnBufferOwner = 1;
 
 				rsslChnlImpl->returnBuffer.length = rsslAssemblyBuf->buffer.length;
 				rsslChnlImpl->returnBuffer.data = rsslAssemblyBuf->buffer.data;
@@ -9028,14 +10469,56 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketWrite(rsslChannelImpl *rsslChnlImp
 	RsslUInt32 totalUncompOutBytes = 0;
 	RsslUInt32 writeFlags = writeInArgs->writeInFlags;
 	rtr_msgb_t	**ripcBuffer = (rtr_msgb_t**)(&rsslBufImpl->bufferInfo);
+	RsslBool autoPacked = RSSL_FALSE;
 
 	RsslSocketChannel *rsslSocketChannel = (RsslSocketChannel*)rsslChnlImpl->transportInfo;
 
 	if (IPC_NULL_PTR(rsslSocketChannel, "rsslSocketWrite", "rsslSocketChannel", error))
 		return RSSL_RET_FAILURE;
 
+	/* transparent packing of small messages */
+	if (rsslSocketChannel->autoPackSize && (*ripcBuffer) && (!(rsslBufImpl->fragmentationFlag)) && (rsslBufImpl->writeCursor == 0) &&
+		(rsslBufImpl->packingOffset == 0) && (rsslBufImpl->buffer.length > 0) &&
+		(!(writeFlags & (RSSL_WRITE_DIRECT_SOCKET_WRITE | RSSL_WRITE_DO_NOT_COMPRESS))))
+	{
+		RsslUInt32 packSize = rsslSocketChannel->autoPackSize < rsslChnlImpl->maxMsgSize ? rsslSocketChannel->autoPackSize : rsslChnlImpl->maxMsgSize;
+
+		if ((rsslBufImpl->buffer.length + 2 <= packSize) &&
+			((retVal = ipcAutoPackWrite(rsslSocketChannel, rsslBufImpl, packSize, error)) != RSSL_RET_BUFFER_NO_BUFFERS))
+		{
+			if (retVal < RSSL_RET_SUCCESS)
+			{
+				rsslChnlImpl->Channel.state = RSSL_CH_STATE_CLOSED;
+				error->channel = &rsslChnlImpl->Channel;
+				return RSSL_RET_FAILURE;
+			}
+
+			/* the message was copied, so its own buffer is done with */
+			ipcReleaseDataBuffer(rsslSocketChannel, *ripcBuffer, error);
+			totalOutBytes = totalUncompOutBytes = rsslBufImpl->buffer.length + 2;
+			(*ripcBuffer) = 0;
+			autoPacked = RSSL_TRUE;
+		}
+	}
+
+	/* messages written unpacked go after any packed ahead of them */
+	if (!autoPacked && ((writeFlags & RSSL_WRITE_DIRECT_SOCKET_WRITE) || rsslSocketChannel->autoPackBufs[rsslBufImpl->priority]))
+	{
+		if (((writeFlags & RSSL_WRITE_DIRECT_SOCKET_WRITE) ? ipcAutoPackCloseAll(rsslSocketChannel, error) :
+				ipcAutoPackClose(rsslSocketChannel, rsslBufImpl->priority, error)) < RSSL_RET_SUCCESS)
+		{
+			rsslChnlImpl->Channel.state = RSSL_CH_STATE_CLOSED;
+			error->channel = &rsslChnlImpl->Channel;
+			return RSSL_RET_FAILURE;
+		}
+	}
+
 	/* check if we are doing fragmentation */
-	if ((*ripcBuffer) && (!(rsslBufImpl->fragmentationFlag)) && (rsslBufImpl->writeCursor == 0))
+	if (autoPacked)
+	{
+		/* copied into a packed buffer above */
+	}
+	else if ((*ripcBuffer) && (!(rsslBufImpl->fragmentationFlag)) && (rsslBufImpl->writeCursor == 0))
 	{
 		/* no fragmentation */
 
@@ -9308,6 +10791,85 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketWrite(rsslChannelImpl *rsslChnlImp
 	}
 }
 
+/* rssl Socket write of a message going to several channels.  A message that goes out as one ripc data message, neither
+ * compressed nor chunked for tunneling, is the same on every such channel, so they all queue one framed copy of it,
+ * held in a shared data block. */
+RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketWriteShared(rsslChannelImpl *rsslChnlImpl, RsslBuffer *msg, void **sharedMsg, RsslWriteInArgs *writeInArgs,
+	RsslWriteOutArgs *writeOutArgs, RsslError *error)
+{
+	RsslSocketChannel *rsslSocketChannel = (RsslSocketChannel*)rsslChnlImpl->transportInfo;
+	RsslUInt32 writeFlags = writeInArgs->writeInFlags;
+	RsslInt32 priority = writeInArgs->rsslPriority;
+	RsslInt32 outBytes = 0;
+	rtr_datab_t *dblk;
+	RsslRet retVal;
+
+	if (IPC_NULL_PTR(rsslSocketChannel, "rsslSocketWriteShared", "rsslSocketChannel", error))
+		return RSSL_RET_FAILURE;
+
+	if ((msg->length > rsslChnlImpl->maxMsgSize) || rsslSocketChannel->httpHeaders ||
+		(rsslSocketChannel->version->dataHeaderLen != IPC_100_DATA_HEADER_SIZE) || rsslSocketChannel->version->footerLen ||
+		(rsslSocketChannel->dbgFlags & RSSL_DEBUG_IPC_DUMP_OUT) ||
+		((rsslSocketChannel->outCompFuncs != 0) && !(writeFlags & RSSL_WRITE_DO_NOT_COMPRESS) &&
+			((rsslSocketChannel->compressQueue == -1) || (rsslSocketChannel->compressQueue == priority)) &&
+			(msg->length >= rsslSocketChannel->lowerCompressionThreshold)))
+		return _rsslWriteCopy(rsslChnlImpl, msg, writeInArgs, writeOutArgs, error);
+
+	if ((dblk = (rtr_datab_t*)(*sharedMsg)) == 0)
+	{
+		RsslUInt16 messageLength = (RsslUInt16)(msg->length + IPC_100_DATA_HEADER_SIZE);
+
+		if ((dblk = rtr_dfltcAllocSharedDatab(messageLength)) == 0)
+			return _rsslWriteCopy(rsslChnlImpl, msg, writeInArgs, writeOutArgs, error);
+
+		RTR_PUT_16(dblk->base, messageLength);
+		dblk->base[2] = IPC_DATA;
+		MemCopyByInt(dblk->base + IPC_100_DATA_HEADER_SIZE, msg->data, msg->length);
+		*sharedMsg = dblk;
+	}
+
+	/* messages written unpacked go after any packed ahead of them */
+	if ((writeFlags & RSSL_WRITE_DIRECT_SOCKET_WRITE) || rsslSocketChannel->autoPackBufs[priority])
+	{
+		if (((writeFlags & RSSL_WRITE_DIRECT_SOCKET_WRITE) ? ipcAutoPackCloseAll(rsslSocketChannel, error) :
+				ipcAutoPackClose(rsslSocketChannel, priority, error)) < RSSL_RET_SUCCESS)
+		{
+			rsslChnlImpl->Channel.state = RSSL_CH_STATE_CLOSED;
+			error->channel = &rsslChnlImpl->Channel;
+			return RSSL_RET_FAILURE;
+		}
+	}
+
+	retVal = ipcWriteSharedSession(rsslSocketChannel, dblk, priority, (writeFlags & RSSL_WRITE_DIRECT_SOCKET_WRITE) != 0, &outBytes, error);
+
+	if (retVal == RSSL_RET_BUFFER_NO_BUFFERS)
+	{
+		error->channel = &rsslChnlImpl->Channel;
+		return retVal;
+	}
+	else if (retVal == RSSL_RET_FAILURE)
+	{
+		error->channel = &rsslChnlImpl->Channel;
+
+		/* as in rsslSocketWrite, a failed flush of a queued message is only blocked or fatal */
+		if ((outBytes > 0) && ((errno == EINTR) || (errno == EAGAIN) || (errno == _IPC_WOULD_BLOCK)))
+			return RSSL_RET_WRITE_FLUSH_FAILED;
+
+		rsslChnlImpl->Channel.state = RSSL_CH_STATE_CLOSED;
+		return (outBytes > 0) ? RSSL_RET_WRITE_FLUSH_FAILED : RSSL_RET_FAILURE;
+	}
+
+	writeOutArgs->bytesWritten = outBytes;
+	writeOutArgs->uncompressedBytesWritten = outBytes;
+	return retVal;
+}
+
+/* Releases a shared message made by rsslSocketWriteShared */
+static void rsslSocketReleaseSharedMsg(void *sharedMsg)
+{
+	rtr_dfltcReleaseSharedDatab((rtr_datab_t*)sharedMsg);
+}
+
 /* rssl Socket GetBuffer */
 RSSL_RSSL_SOCKET_IMPL_FAST(rsslBufferImpl*) rsslSocketGetBuffer(rsslChannelImpl *rsslChnlImpl, RsslUInt32 size, RsslBool packedBuffer, RsslError *error)
 {
@@ -9351,8 +10913,9 @@ RSSL_RSSL_SOCKET_IMPL_FAST(rsslBufferImpl*) rsslSocketGetBuffer(rsslChannelImpl
 #endif
 		IPC_MUTEX_LOCK(rsslSocketChannel);
 
-		/* Return the number of guaranteed buffers used + pool buffers used */
-		usedBuf = rsslSocketChannel->guarBufPool->numRegBufsUsed + rsslSocketChannel->guarBufPool->numPoolBufs;
+		/* Return the number of guaranteed buffers used + pool buffers used + shared messages queued */
+		usedBuf = rsslSocketChannel->guarBufPool->numRegBufsUsed + rsslSocketChannel->guarBufPool->numPoolBufs +
+			rsslSocketChannel->guarBufPool->numSharedRefs;
 		maxOutputMsgs = rsslSocketChannel->guarBufPool->maxPoolBufs + rsslSocketChannel->guarBufPool->bufpool.maxBufs;
 		compression = rsslSocketChannel->outCompression;
 
@@ -9520,12 +11083,25 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketFlush(rsslChannelImpl *rsslChnlImp
 	if (IPC_NULL_PTR(rsslSocketChannel, "rsslSocketFlush", "rsslSocketChannel", error))
 		return RSSL_RET_FAILURE;
 
+	if (ipcAutoPackCloseAll(rsslSocketChannel, error) < RSSL_RET_SUCCESS)
+		return RSSL_RET_FAILURE;
+
 #ifdef MUTEX_DEBUG
 	printf("LOCK rsslSocketChannel -- rsslSocketFlush (start)\n");
 #endif
 	IPC_MUTEX_LOCK(rsslSocketChannel);
 
-	retVal = ipcFlushSession(rsslSocketChannel, error);
+	/* a coalescing channel keeps holding its data until the coalescing time has passed */
+	if (rsslSocketChannel->coalesceDeadline && (ipcGetTimeNano() < rsslSocketChannel->coalesceDeadline))
+	{
+		RsslInt32 i;
+
+		retVal = 0;
+		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+			retVal += rsslSocketChannel->priorityQueues[i].queueLength;
+	}
+	else
+		retVal = ipcFlushSession(rsslSocketChannel, error);
 
 #ifdef MUTEX_DEBUG
 	printf("UNLOCK rsslSocketChannel -- rsslSocketFlush (end)\n");
@@ -9563,6 +11139,7 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketPing(rsslChannelImpl *rsslChnlImpl
 RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketGetChannelInfo(rsslChannelImpl *rsslChnlImpl, RsslChannelInfo *info, RsslError *error)
 {
 	RsslInt32		i = 0;
+	RsslInt32		bucket;
 	RsslInt32 		size = 0;
 	
 	char*		componentVersion;
@@ -9611,6 +11188,19 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketGetChannelInfo(rsslChannelImpl *rs
 	info->compressionThreshold = rsslSocketChannel->lowerCompressionThreshold;
 	info->compressionType = (RsslCompTypes)rsslSocketChannel->outCompression;
 	info->encryptionProtocol = rsslSocketChannel->sslCurrentProtocol;
+	info->encryptionOffload = RSSL_ENC_OFFLOAD_NONE;
+#ifndef WIN32
+	if ((rsslSocketChannel->connType == RSSL_CONN_TYPE_ENCRYPTED) && rsslSocketChannel->transportInfo &&
+		(rsslSocketChannel->transportFuncs->readTransport == ripcSSLRead))
+	{
+		RsslUInt32 offload = ripcSSLKernelTlsOffload(rsslSocketChannel->transportInfo);
+
+		if (offload & RIPC_SSL_KTLS_TX)
+			info->encryptionOffload |= RSSL_ENC_OFFLOAD_KTLS_TX;
+		if (offload & RIPC_SSL_KTLS_RX)
+			info->encryptionOffload |= RSSL_ENC_OFFLOAD_KTLS_RX;
+	}
+#endif
 
 	/* until we own this memory, we have not gotten the info from the other side of the connection */
 	if (rsslSocketChannel->outComponentVer)
@@ -9647,6 +11237,54 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketGetChannelInfo(rsslChannelImpl *rs
 		i++;
 	}
 
+	info->compressionStats.minSavings = rsslSocketChannel->compMinSavings;
+	info->compressionStats.maxCost = rsslSocketChannel->compMaxCost;
+	for (bucket = 0; bucket < RSSL_COMP_STATS_BUCKET_COUNT; bucket++)
+		info->compressionStats.buckets[bucket] = rsslSocketChannel->compBuckets[bucket].stats;
+
+	info->priorityFlushStats.highLatencyBudget = (RsslUInt32)(rsslSocketChannel->highLatencyBudget / 1000);
+	info->priorityFlushStats.budgetFlushes = rsslSocketChannel->budgetFlushes;
+	info->coalesceWriteUsec = (RsslUInt32)(rsslSocketChannel->coalesceWriteNsec / 1000);
+	info->coalesceFlushUsec = 0;
+	if (rsslSocketChannel->coalesceDeadline)
+	{
+		RsslUInt64 now = ipcGetTimeNano();
+
+		info->coalesceFlushUsec = (now < rsslSocketChannel->coalesceDeadline) ? (RsslUInt32)((rsslSocketChannel->coalesceDeadline - now + 999) / 1000) : 0;
+	}
+	info->writeSysCalls = rsslSocketChannel->writeSysCalls;
+	info->autoPackSize = rsslSocketChannel->autoPackSize;
+	info->autoPackedMsgs = rsslSocketChannel->autoPackedMsgs;
+	info->autoPackedBufs = rsslSocketChannel->autoPackedBufs;
+	info->compressionDictId = (rsslSocketChannel->compDict ? rsslSocketChannel->compDict->dictId : 0);
+	info->zeroCopyThreshold = rsslSocketChannel->zeroCopyThreshold;
+	info->zeroCopyPendingSends = rsslSocketChannel->zeroCopyNextId - rsslSocketChannel->zeroCopyDoneId;
+	info->zeroCopyHeldBuffers = rsslQueueGetElementCount(&rsslSocketChannel->zeroCopyBufs);
+	info->zeroCopyCopiedSends = rsslSocketChannel->zeroCopyNumCopied;
+	for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+	{
+		RIPC_PRIORITY_WRITE *pQueue = &rsslSocketChannel->priorityQueues[i];
+		RsslPriorityQueueStats *pStats = &info->priorityFlushStats.queues[i];
+		RsslQueueLink *pLink = rsslQueuePeekFront(&pQueue->priorityQueue);
+
+		pStats->weight = rsslSocketChannel->weightedFlush ? pQueue->weight : 0;
+		pStats->queuedBytes = (RsslUInt32)pQueue->queueLength;
+		pStats->queuedBuffers = rsslQueueGetElementCount(&pQueue->priorityQueue);
+		pStats->oldestWait = 0;
+		if (pLink && rsslSocketChannel->weightedFlush)
+		{
+			RsslUInt64 now = ipcGetTimeNano();
+			rtr_msgb_t *pOldest = RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink);
+
+			if (now > pOldest->queueTime)
+				pStats->oldestWait = (now - pOldest->queueTime) / 1000;
+		}
+		pStats->flushedBytes = pQueue->flushedBytes;
+		pStats->flushedBuffers = pQueue->flushedBuffers;
+		pStats->totalWait = pQueue->totalWaitNsec / 1000;
+		pStats->maxWait = pQueue->maxWaitNsec / 1000;
+	}
+
 #ifdef MUTEX_DEBUG
 	printf("UNLOCK rsslSocketChannel -- rsslSocketGetChannelInfo\n");
 #endif
@@ -9717,6 +11355,7 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketGetChannelInfo(rsslChannelImpl *rs
 	info->multicastStats.unicastRcvd = 0;
 	info->multicastStats.unicastSent = 0;
 	info->multicastStats.gapsDetected = 0;
+	memset(&info->shmemStats, 0, sizeof(info->shmemStats));
 	
 	return RSSL_RET_SUCCESS;
 }
@@ -9745,8 +11384,8 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketGetSrvrInfo(rsslServerImpl *rsslSr
 	{
 		rtr_dfltcpool = (rtr_dfltcbufferpool_t*)rsslServerSocketChannel->sharedBufPool->internal;
 
-		info->currentBufferUsage = rtr_dfltcpool->numRegBufsUsed;
-		info->peakBufferUsage = rtr_dfltcpool->peakNumBufsUsed;
+		info->currentBufferUsage = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
+		info->peakBufferUsage = rtr_dfltcGetPeakNumBufs(rsslServerSocketChannel->sharedBufPool);
 	}
 	else
 	{
@@ -9766,6 +11405,8 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketGetSrvrInfo(rsslServerImpl *rsslSr
 #endif
 	IPC_MUTEX_UNLOCK(rsslServerSocketChannel);
 
+	memset(&info->shmemStats, 0, sizeof(info->shmemStats));
+
 	return RSSL_RET_SUCCESS;
 }
 
@@ -9797,8 +11438,9 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslInt32) rsslSocketBufferUsage(rsslChannelImpl *rss
 		return RSSL_RET_FAILURE;
 	}
 
-	/* Return the number of guaranteed buffers used + pool buffers used */
-	retVal = rsslSocketChannel->guarBufPool->numRegBufsUsed + rsslSocketChannel->guarBufPool->numPoolBufs;
+	/* Return the number of guaranteed buffers used + pool buffers used + shared messages queued */
+	retVal = rsslSocketChannel->guarBufPool->numRegBufsUsed + rsslSocketChannel->guarBufPool->numPoolBufs +
+		rsslSocketChannel->guarBufPool->numSharedRefs;
 
 #ifdef MUTEX_DEBUG
 	printf("UNLOCK rsslSocketChannel -- rsslSocketBufferUsage (end)\n");
@@ -9833,7 +11475,7 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslInt32) rsslSocketSrvrBufferUsage(rsslServerImpl *
 	if (rsslServerSocketChannel->sharedBufPool)
 	{
 		rtr_dfltcpool = (rtr_dfltcbufferpool_t*)rsslServerSocketChannel->sharedBufPool->internal;
-		retVal = rtr_dfltcpool->numRegBufsUsed;
+		retVal = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
 	}
 	else
 	{
@@ -10110,6 +11752,135 @@ printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
 		}
 		break;
 
+	case RSSL_SHARED_POOL_CACHE_SIZE:
+		if (iValue < 0)
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, invalid value <%d>, shared pool cache size cannot be negative\n",
+					__FILE__, __LINE__, iValue);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* Only server channels pull buffers from a shared pool */
+		if (rsslSocketChannel->guarBufPool && rsslSocketChannel->guarBufPool->sharedPool)
+			rtr_dfltcSetSharedPoolCacheSize(&(rsslSocketChannel->guarBufPool->bufpool), iValue);
+		break;
+
+	case RSSL_ZERO_COPY_THRESHOLD:
+		if (iValue < 0)
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, invalid value <%d>, zero copy threshold cannot be negative\n",
+					__FILE__, __LINE__, iValue);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		if (iValue > 0 && rsslSocketChannel->zeroCopyThreshold == 0)
+		{
+			/* Zero copy is only done on plain sockets, where the data is written as is */
+			if (rsslSocketChannel->httpHeaders || (rsslSocketChannel->transportFuncs == 0) ||
+				(rsslSocketChannel->transportFuncs->writeVTransport != ipcWriteV))
+			{
+				_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+				snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+						"<%s:%d> Error: 1004 rsslSocketIoctl() failed, zero copy is only supported on RSSL_CONN_TYPE_SOCKET connections\n",
+						__FILE__, __LINE__);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+				IPC_MUTEX_UNLOCK(rsslSocketChannel);
+				return RSSL_RET_FAILURE;
+			}
+
+			if (ipcZeroCopyEnable(rsslSocketChannel->stream) < 0)
+			{
+				_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, errno);
+				snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+						"<%s:%d> Error: 1002 rsslSocketIoctl() failed, could not enable SO_ZEROCOPY. System errno: (%d)\n",
+						__FILE__, __LINE__, errno);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+				IPC_MUTEX_UNLOCK(rsslSocketChannel);
+				return RSSL_RET_FAILURE;
+			}
+		}
+
+		/* Buffers already sent with zero copy are still released as their sends complete */
+		rsslSocketChannel->zeroCopyThreshold = iValue;
+		break;
+
+	case RSSL_BUSY_POLL_USEC:
+		if (iValue < 0)
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, invalid value <%d>, busy poll time cannot be negative\n",
+					__FILE__, __LINE__, iValue);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* The kernel options only help, the polling itself is done in ipcReadSession */
+		(void)ipcBusyPollEnable(rsslSocketChannel->stream, (RsslUInt32)iValue);
+		rsslSocketChannel->busyPollUsec = (RsslUInt32)iValue;
+		break;
+
+	case RSSL_RECV_TIMESTAMPS:
+		/* Timestamps are read from the socket itself, so only plain sockets can use them */
+		if ((rsslSocketChannel->transportFuncs == 0) || (rsslSocketChannel->transportFuncs->readTransport != ipcRead))
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, receive timestamps are only supported on RSSL_CONN_TYPE_SOCKET connections\n",
+					__FILE__, __LINE__);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		if (ipcRecvTimestampEnable(rsslSocketChannel->stream, (iValue != 0)) < 0)
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, errno);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1002 rsslSocketIoctl() failed, could not set SO_TIMESTAMPING. System errno: (%d)\n",
+					__FILE__, __LINE__, errno);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* Data already in the input buffer is given the time of the next read */
+		rsslSocketChannel->recvTimestamps = (iValue != 0);
+		rsslSocketChannel->recvStampHead = 0;
+		rsslSocketChannel->recvStampCount = 0;
+		rsslSocketChannel->lastRecvStamp = 0;
+		break;
+
 	case RSSL_DEBUG_FLAGS:
 		/* reset debug flags - if user still wants these on, they should continue passing them in */
 		rsslChnlImpl->debugFlags = 0;
@@ -10141,8 +11912,18 @@ printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
 	    if (rsslSocketChannel->outCompression == RSSL_COMP_NONE)
 		  break;
 
-		lowerThreshold = (rsslSocketChannel->outCompression == RSSL_COMP_ZLIB ?
-									RSSL_COMP_DFLT_THRESHOLD_ZLIB : RSSL_COMP_DFLT_THRESHOLD_LZ4);
+		switch (rsslSocketChannel->outCompression)
+		{
+		case RSSL_COMP_ZLIB:
+			lowerThreshold = RSSL_COMP_DFLT_THRESHOLD_ZLIB;
+			break;
+		case RSSL_COMP_ZSTD:
+			lowerThreshold = RSSL_COMP_DFLT_THRESHOLD_ZSTD;
+			break;
+		default:
+			lowerThreshold = RSSL_COMP_DFLT_THRESHOLD_LZ4;
+			break;
+		}
 		if(iValue >= lowerThreshold)
 			rsslSocketChannel->lowerCompressionThreshold = iValue;
 		else
@@ -10161,6 +11942,56 @@ printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
 	}
 		break;
 
+	case RSSL_COMPRESSION_MIN_SAVINGS:
+		if ((iValue < 0) || (iValue > 99))
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, invalid value <%d>, compression minimum savings must be between 0 and 99 percent\n",
+					__FILE__, __LINE__, iValue);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* start every size class over with the new setting; the statistics are kept */
+		rsslSocketChannel->compMinSavings = iValue;
+		for (i = 0; i < RSSL_COMP_STATS_BUCKET_COUNT; i++)
+		{
+			ripcCompBucket *bucket = &rsslSocketChannel->compBuckets[i];
+
+			bucket->stats.bypassed = RSSL_FALSE;
+			bucket->sampleIn = 0;
+			bucket->sampleOut = 0;
+			bucket->sampleNsec = 0;
+			bucket->sampleMsgs = 0;
+			bucket->bypassLeft = 0;
+			bucket->bypassLength = RIPC_COMP_MIN_BYPASS;
+		}
+		break;
+
+	case RSSL_COMPRESSION_MAX_COST:
+		if (iValue < 0)
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, invalid value <%d>, compression maximum cost must not be negative\n",
+					__FILE__, __LINE__, iValue);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* takes effect from the next sample of each size class */
+		rsslSocketChannel->compMaxCost = iValue;
+		break;
+
 	case RSSL_PRIORITY_FLUSH_ORDER:
 		/* cast value to char*, go through one by one to verify that they are all H, M, L 
 		   Null terminate - Make sure at least H and M are represented.  Then store in sess->flushStrategy[]; 
@@ -10229,6 +12060,9 @@ printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
 
 			/* set current flush strategy index back to start */
 			rsslSocketChannel->currentOutList = 0;
+
+			/* a flush order replaces weighted flushing */
+			rsslSocketChannel->weightedFlush = 0;
 		}
 		else
 		{	
@@ -10246,6 +12080,119 @@ printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
 		}
 		break;
 
+	case RSSL_PRIORITY_FLUSH_WEIGHTS:
+	{
+		RsslPriorityFlushWeights *pWeights = (RsslPriorityFlushWeights*)value;
+		RsslInt32 weightCount = 0;
+
+		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+		{
+			if (pWeights->weights[i])
+				weightCount++;
+		}
+
+		if ((weightCount != 0) && (weightCount != RIPC_MAX_PRIORITY_QUEUE))
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, priority flush weights must either all be non-zero or all be 0\n",
+					__FILE__, __LINE__);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		if (weightCount == 0)
+		{
+			rsslSocketChannel->weightedFlush = 0;
+			break;
+		}
+
+		/* Buffers already queued were not stamped, so their wait starts now */
+		if (!rsslSocketChannel->weightedFlush)
+		{
+			RsslUInt64 now = ipcGetTimeNano();
+			RsslQueueLink *pLink;
+
+			for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+			{
+				RSSL_QUEUE_FOR_EACH_LINK(&rsslSocketChannel->priorityQueues[i].priorityQueue, pLink)
+					RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink)->queueTime = now;
+			}
+			memset(&rsslSocketChannel->flushState, 0, sizeof(ripcWeightedFlushState));
+		}
+
+		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+			rsslSocketChannel->priorityQueues[i].weight = pWeights->weights[i];
+		rsslSocketChannel->highLatencyBudget = (RsslUInt64)pWeights->highLatencyBudget * 1000;
+		rsslSocketChannel->weightedFlush = 1;
+		break;
+	}
+
+	case RSSL_COALESCE_WRITE_USEC:
+		if (iValue < 0)
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, invalid value <%d>, coalescing time cannot be negative\n",
+					__FILE__, __LINE__, iValue);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* Data already held keeps its deadline, so the next read or write still sends it on time */
+		rsslSocketChannel->coalesceWriteNsec = (RsslUInt64)iValue * 1000;
+		break;
+
+	case RSSL_AUTO_PACK_SIZE:
+		if (iValue < 0)
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, invalid value <%d>, packing size cannot be negative\n",
+					__FILE__, __LINE__, iValue);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* Buffers already open are written by the next flush */
+		rsslSocketChannel->autoPackSize = iValue;
+		break;
+
+	case RSSL_REASSEMBLY_ALLOCATOR:
+	{
+		RsslReassemblyAllocator *pAllocator = (RsslReassemblyAllocator*)value;
+
+		if ((pAllocator->allocateBuffer == NULL) != (pAllocator->freeBuffer == NULL))
+		{
+			_rsslSetError(error, (RsslChannel*)(&rsslChnlImpl->Channel), RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT,
+					"<%s:%d> Error: 1004 rsslSocketIoctl() failed, reassembly allocator needs both an allocate and a free function\n",
+					__FILE__, __LINE__);
+
+#ifdef MUTEX_DEBUG
+	printf("UNLOCK rsslSocketChannel -- rsslSocketIoctl\n");
+#endif
+			IPC_MUTEX_UNLOCK(rsslSocketChannel);
+			return RSSL_RET_FAILURE;
+		}
+
+		/* Messages already being reassembled keep the memory they started with */
+		rsslChnlImpl->reassemblyAllocator = *pAllocator;
+		break;
+	}
+
 	case RSSL_IGNORE_CERT_REVOCATION:
 		if (rsslSocketChannel->transportFuncs->sessIoctl)
 			return (*(rsslSocketChannel->transportFuncs->sessIoctl))(rsslSocketChannel->transportInfo, code, iValue, error);
@@ -10339,6 +12286,7 @@ RsslInt32 ipcInitialize(RsslInt32 numServers, RsslInt32 numClients, RsslInitiali
 		rsslInitQueue(&freeServerSocketChannelList);
 		rsslInitQueue(&freeSocketChannelList);
 		rsslInitQueue(&activeSocketChannelList);
+		rsslInitQueue(&zeroCopyClosedList);
 
 		ripc10Ver.connVersion = _conn_version_10;
 		ripc10Ver.ipcVersion = RIPC_VERSION_10;
@@ -10407,6 +12355,21 @@ RsslInt32 ipcInitialize(RsslInt32 numServers, RsslInt32 numClients, RsslInitiali
 		ripc14WinInetVer.firstFragHdrLen = 6;
 		ripc14WinInetVer.subsequentFragHdrLen = 2;
 
+		ripc15Ver.connVersion = _conn_version_15;
+		ripc15Ver.ipcVersion = RIPC_VERSION_15;
+		ripc15Ver.dataHeaderLen = IPC_100_DATA_HEADER_SIZE;
+		ripc15Ver.footerLen = 0;
+		ripc15Ver.firstFragHdrLen = 6;
+		ripc15Ver.subsequentFragHdrLen = 2;
+
+		/* set this up for tunneling */
+		ripc15WinInetVer.connVersion = _conn_version_15;
+		ripc15WinInetVer.ipcVersion = RIPC_VERSION_15;
+		ripc15WinInetVer.dataHeaderLen = IPC_100_DATA_HEADER_SIZE + 6;
+		ripc15WinInetVer.footerLen = 2;
+		ripc15WinInetVer.firstFragHdrLen = 6;
+		ripc15WinInetVer.subsequentFragHdrLen = 2;
+
 		transOpts.rsslLocking = 0;
 		transOpts.jitOpts.libsslName = 0;
 		transOpts.jitOpts.libcryptoName = 0;
@@ -10482,6 +12445,7 @@ RsslInt32 ipcInitialize(RsslInt32 numServers, RsslInt32 numClients, RsslInitiali
 		}
 
 		ipcSetSockFuncs();
+		ipcSetShmFuncs();
 
 		for (i = 0; i <= RSSL_COMP_MAX_TYPE; i++)
 		{
@@ -10495,6 +12459,7 @@ RsslInt32 ipcInitialize(RsslInt32 numServers, RsslInt32 numClients, RsslInitiali
 
 		ripcInitZlibComp();
 		ripcInitLz4Comp();
+		ripcInitZstdComp(initOpts->jitOpts.libzstdName);
 
 		/* initialize open SSL library */
 #ifndef _WIN32
@@ -10535,6 +12500,8 @@ RsslInt32 ipcInitialize(RsslInt32 numServers, RsslInt32 numClients, RsslInitiali
 
 		protocolNumber = 6;  /* tcp (transmission control protocol) */
 
+		rsslPageArenaInitialize(initOpts->memoryFlags);
+
 		if ((gblInputBufs = rtr_smplcAllocatePool(poolMutex)) == 0)
 		{
 			error->rsslErrorId = RSSL_RET_FAILURE;
@@ -10678,12 +12645,15 @@ RsslInt32 ipcCleanup()
 	if ((numInitCalls == 0) && initialized)
 	{
 		int i;
+		ipcReleaseZeroCopyClosed(RSSL_TRUE);
 		ipcCleanRsslServerSocketChannel();
 		ipcCleanRsslSocketChannel();
 
 		if (gblInputBufs)
 			rtr_smplcDropRef(gblInputBufs);
 
+		rsslPageArenaUninitialize();
+
 		for ( i=0; i<RIPC_MAX_TRANSPORTS; i++)
 		{
 			if (transFuncs[i].uninitialize)
@@ -10711,6 +12681,8 @@ RsslInt32 ipcCleanup()
 		}
 #endif
 
+		ripcUninitZstdComp();
+
 		rssl_socket_shutdown();
 
 		initialized = 0;
@@ -10812,6 +12784,14 @@ RSSL_RSSL_SOCKET_FAST(RsslRet) rsslCloseSocketSrvr(rsslServerImpl *rsslSrvrImpl,
 
 	if (rsslSrvrSocketChannel != 0)
 	{
+#ifdef Linux
+		/* stopped first, so no worker is using the server while it is released */
+		if (rsslSrvrSocketChannel->handshakePool)
+		{
+			ripcDestroyHandshakePool(rsslSrvrSocketChannel->handshakePool);
+			rsslSrvrSocketChannel->handshakePool = 0;
+		}
+#endif
 
 #ifdef RIPC_SSL_ENABLED
 		if (rsslServerSocketChannel->connType == RIPC_CONN_TYPE_ENCRYPTED)
@@ -10857,6 +12837,8 @@ RsslRet rsslSocketSetChannelFunctions()
 	funcs.channelReleaseBuffer = rsslSocketReleaseBuffer;
 	funcs.channelWrite = rsslSocketWrite;
 	funcs.initChannel = rsslSocketInitChannel;
+	funcs.channelWriteShared = rsslSocketWriteShared;
+	funcs.releaseSharedMsg = rsslSocketReleaseSharedMsg;
 	
 	return(rsslSetTransportChannelFunc(RSSL_SOCKET_TRANSPORT,&funcs));
 }
@@ -11084,8 +13066,16 @@ void ipcUserSessClose(RsslSocketChannel *rsslSocketChannel)
 	{
 		if (!(rsslSocketChannel->workState & RIPC_INT_SOCK_CLOSED))
 		{
+			/* The kernel may still be sending from the buffers of outstanding zero copy sends.  The
+			 * socket is only shut down, so the peer still gets everything written, and is closed
+			 * once the sends complete; see ipcReleaseZeroCopyClosed. */
+			if (rsslSocketChannel->zeroCopyNextId != rsslSocketChannel->zeroCopyDoneId)
+			{
+				shutdown(rsslSocketChannel->stream, shutdownFlag);
+				rsslSocketChannel->zeroCopyStream = rsslSocketChannel->stream;
+			}
 			/* If we're in a proxy connecting state, transportInfo is 0.  Send the FD instead.  Don't cast as a pointer it since it's just getting cast to a RsslSocket. */
-			if (rsslSocketChannel->intState == RIPC_INT_ST_PROXY_CONNECTING || rsslSocketChannel->intState == RIPC_INT_ST_CLIENT_WAIT_PROXY_ACK)
+			else if (rsslSocketChannel->intState == RIPC_INT_ST_PROXY_CONNECTING || rsslSocketChannel->intState == RIPC_INT_ST_CLIENT_WAIT_PROXY_ACK)
 				(*(rsslSocketChannel->transportFuncs->shutdownTransport))(rsslSocketChannel->transportInfo);
 			/* if we are doing tunneling, this state means we do not want to close the real fd */
 			else if (rsslSocketChannel->tunnelingState != RIPC_TUNNEL_REMOVE_SESSION)
@@ -11281,6 +13271,12 @@ RSSL_RSSL_SOCKET_IMPL_FAST(void) relRsslServerSocketChannel(RsslServerSocketChan
 			rsslServerSocketChannel->serverName = 0;
 		}
 
+		if (rsslServerSocketChannel->compDict)
+		{
+			ripcZstdFreeDict(rsslServerSocketChannel->compDict);
+			rsslServerSocketChannel->compDict = 0;
+		}
+
 		rsslClearRsslServerSocketChannel(rsslServerSocketChannel);
 
 		rsslQueueAddLinkToBack(&freeServerSocketChannelList, &(rsslServerSocketChannel->link1));
@@ -11306,6 +13302,27 @@ RSSL_RSSL_SOCKET_IMPL_FAST(void) ripcRelSocketChannel(RsslSocketChannel *rsslSoc
 	{
 		int i;
 		rtr_msgb_t *mblk;
+
+		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+		{
+			if ((mblk = rsslSocketChannel->autoPackBufs[i]) != 0)
+			{
+				mblk->buffer -= rsslSocketChannel->version->dataHeaderLen;
+				rtr_dfltcFreeMsg(mblk);
+				rsslSocketChannel->autoPackBufs[i] = 0;
+			}
+		}
+
+		/* Buffers of outstanding zero copy sends stay held, see ipcReleaseZeroCopyClosed */
+		if (rsslSocketChannel->zeroCopyStream == RIPC_INVALID_SOCKET)
+		{
+			while ((pLink = rsslQueueRemoveFirstLink(&(rsslSocketChannel->zeroCopyBufs))) != 0)
+			{
+				mblk = RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink);
+				rtr_dfltcFreeMsg(mblk);
+			}
+		}
+
 		for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
 		{
 			while ((pLink = rsslQueueRemoveFirstLink(&(rsslSocketChannel->priorityQueues[i].priorityQueue))) != 0)
@@ -11315,8 +13332,11 @@ RSSL_RSSL_SOCKET_IMPL_FAST(void) ripcRelSocketChannel(RsslSocketChannel *rsslSoc
 			}
 		}
 
-		rtr_dfltcDropRef(&(rsslSocketChannel->guarBufPool->bufpool));
-		rsslSocketChannel->guarBufPool = 0;
+		if (rsslSocketChannel->zeroCopyStream == RIPC_INVALID_SOCKET)
+		{
+			rtr_dfltcDropRef(&(rsslSocketChannel->guarBufPool->bufpool));
+			rsslSocketChannel->guarBufPool = 0;
+		}
 	}	
 
 	if (rsslSocketChannel->curInputBuf)
@@ -11355,6 +13375,11 @@ RSSL_RSSL_SOCKET_IMPL_FAST(void) ripcRelSocketChannel(RsslSocketChannel *rsslSoc
 	if (rsslSocketChannel->c_stream_in && rsslSocketChannel->inDecompFuncs)
 		(*(rsslSocketChannel->inDecompFuncs->decompressEnd))(rsslSocketChannel->c_stream_in);
 
+	/* accepted channels only borrow the server's dictionary */
+	if (rsslSocketChannel->compDict && (rsslSocketChannel->server == 0))
+		ripcZstdFreeDict(rsslSocketChannel->compDict);
+	rsslSocketChannel->compDict = 0;
+
 	if (rsslSocketChannel->hostName != 0)
 	{
 		_rsslFree((void*)rsslSocketChannel->hostName);
@@ -11407,10 +13432,18 @@ RSSL_RSSL_SOCKET_IMPL_FAST(void) ripcRelSocketChannel(RsslSocketChannel *rsslSoc
 
 	rssl_pipe_close(&rsslSocketChannel->sessPipe);
 
-	ripcClearRsslSocketChannel(rsslSocketChannel);
-	/* do not clear sessionID here */
+	if (rsslSocketChannel->zeroCopyStream != RIPC_INVALID_SOCKET)
+		rsslQueueAddLinkToBack(&zeroCopyClosedList, &(rsslSocketChannel->link1));
+	else
+	{
+		ripcClearRsslSocketChannel(rsslSocketChannel);
+		/* do not clear sessionID here */
+
+		rsslQueueAddLinkToFront(&freeSocketChannelList, &(rsslSocketChannel->link1));
+	}
 
-	rsslQueueAddLinkToFront(&freeSocketChannelList, &(rsslSocketChannel->link1));
+	if (rsslQueueGetElementCount(&zeroCopyClosedList))
+		ipcReleaseZeroCopyClosed(RSSL_FALSE);
 	
 	if (multiThread)
 	  (void) RSSL_MUTEX_UNLOCK(&ripcMutex);
@@ -146,6 +146,7 @@ RsslRet rsslUniShMemConnect(rsslChannelImpl* rsslChnlImpl, RsslConnectOptions *o
 	shMemOpts.minorVersion = opts->minorVersion;
 	shMemOpts.protocolType = opts->protocolType;
 	shMemOpts.maxReaderSeqNumLag = opts->shmemOpts.maxReaderLag;
+	shMemOpts.resumeOnOverrun = opts->shmemOpts.resumeOnOverrun;
 	shMemOpts.userSpecPtr = rsslChnlImpl;
 	shMemOpts.blockingIO = opts->blocking;
 #ifndef SHM_PIPE	/* used when using a notifier */
@@ -471,7 +472,7 @@ RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslBuffer*) rsslUniShMemRead(rsslChannel
 		switch (error->rsslErrorId)
 		{
 		case RSSL_RET_SLOW_READER:
-			/* very slow readers are detached from shared memory */
+			/* very slow readers are detached from shared memory, unless they resume on overrun */
 			*readRet = RSSL_RET_SLOW_READER;
 #ifdef SHM_BYTE_COUNT
 			printf("readCnt = %lu\t\treadSuccess = %u\t\treadByteCnt = %u\nreadByteSuccess = %u\t\treadByteFailed = %u\n", readCnt, readSuccess, readByteCnt, readByteSuccess, readByteFailed);
@@ -707,7 +708,7 @@ RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(rsslBufferImpl*) rsslUniShMemGetBuffer(rs
 		return NULL;
 	}
 
-	shmBuffer = rtrShmTransGetFreeBuffer(channelShMemServer);
+	shmBuffer = rtrShmTransGetWriteBuffer(channelShMemServer);
 
 	/* successful - now allocate rsslbuffer */
 	rsslBufImpl = _rsslUniShMemNewBuffer(rsslChnlImpl);
@@ -782,7 +783,7 @@ RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslRet) rsslUniShMemPing(rsslChannelImpl
 		return RSSL_RET_FAILURE;
 	}
 
-	shmBuffer = rtrShmTransGetFreeBuffer(channelShMemServer);
+	shmBuffer = rtrShmTransGetWriteBuffer(channelShMemServer);
 	shmBuffer->flags = RSSL_SHMBUF_PING;
 	shmBuffer->length = 0;
 	rtrShmTransServerWrite(channelShMemServer);
@@ -892,6 +893,25 @@ RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslRet) rsslUniShMemGetChannelInfo(rsslC
 	info->multicastStats.unicastRcvd = 0;
 	info->multicastStats.unicastSent = 0;
 	info->multicastStats.gapsDetected = 0;
+	memset(&info->compressionStats, 0, sizeof(info->compressionStats));
+	memset(&info->priorityFlushStats, 0, sizeof(info->priorityFlushStats));
+	info->coalesceWriteUsec = 0;
+	info->coalesceFlushUsec = 0;
+	info->writeSysCalls = 0;
+	info->autoPackSize = 0;
+	info->autoPackedMsgs = 0;
+	info->autoPackedBufs = 0;
+	info->compressionDictId = 0;
+	info->zeroCopyThreshold = 0;
+	info->zeroCopyPendingSends = 0;
+	info->zeroCopyHeldBuffers = 0;
+	info->zeroCopyCopiedSends = 0;
+	info->encryptionOffload = RSSL_ENC_OFFLOAD_NONE;
+
+	if (rsslChnlImpl->transportClientInfo)
+		rtrShmTransClientStats(rsslChnlImpl->transportClientInfo, &info->shmemStats);
+	else
+		rtrShmTransServerStats(rsslChnlImpl->transportServerInfo, &info->shmemStats);
 
 	return RSSL_RET_SUCCESS;
 }
@@ -915,6 +935,8 @@ RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslRet) rsslUniShMemGetSrvrInfo(rsslServ
 
 	info->peakBufferUsage = 1;		/* shmem has only one rsslBuffer, so the peak cannot be more than that */
 
+	rtrShmTransServerStats(shMemServer, &info->shmemStats);
+
 	return RSSL_RET_SUCCESS;
 }
 
@@ -944,8 +966,19 @@ RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslInt32) rsslUniShMemSrvrBufferUsage(rs
 }
 
 
+/* Sets the slow reader policy of a shmem server */
+static RsslRet rsslUniShMemSetSlowReaderWait(rtrShmTransServer *shMemServer, void *value, RsslError *error)
+{
+	shMemServer->slowReaderWaitUsec = *(RsslUInt32*)value;
+	shMemServer->writesBeforeCheck = 0;		/* look at the readers before the next write */
+	return RSSL_RET_SUCCESS;
+}
+
 RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslRet) rsslUniShMemSrvrIoctl(rsslServerImpl *rsslSrvrImpl, RsslIoctlCodes code, void *value, RsslError *error)
 {
+	if (code == RSSL_SHMEM_SLOW_READER_WAIT && rsslSrvrImpl->transportInfo)
+		return rsslUniShMemSetSlowReaderWait(rsslSrvrImpl->transportInfo, value, error);
+
 	return RSSL_RET_SUCCESS;
 }
 
@@ -956,6 +989,17 @@ RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslRet) rsslUniShMemCloseServer(rsslServ
 
 RSSL_RSSL_UNIDIRECTION_SHMEM_IMPL_FAST(RsslRet) rsslUniShMemIoctl(rsslChannelImpl *rsslChnlImpl, RsslIoctlCodes code, void *value, RsslError *error)
 {
+	if (code == RSSL_SHMEM_SLOW_READER_WAIT)
+	{
+		if (!rsslChnlImpl->transportServerInfo)
+		{
+			_rsslSetError(error, &rsslChnlImpl->Channel, RSSL_RET_FAILURE, 0);
+			snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rsslIoctl() RSSL_SHMEM_SLOW_READER_WAIT is only valid on the server's channel.\n", __FILE__, __LINE__);
+			return RSSL_RET_FAILURE;
+		}
+		return rsslUniShMemSetSlowReaderWait(rsslChnlImpl->transportServerInfo, value, error);
+	}
+
 	return RSSL_RET_SUCCESS;
 }
 
@@ -976,6 +1020,8 @@ RsslRet rsslUniShMemSetChannelFunctions()
 	funcs.channelGetBuffer = rsslUniShMemGetBuffer;
 	funcs.channelGetInfo = rsslUniShMemGetChannelInfo;
 	funcs.channelIoctl = rsslUniShMemIoctl;
+	funcs.channelWriteShared = 0;
+	funcs.releaseSharedMsg = 0;
 	funcs.channelPackBuffer = rsslUniShMemPackBuffer;
 	funcs.channelPing = rsslUniShMemPing;
 	funcs.channelRead = rsslUniShMemRead;
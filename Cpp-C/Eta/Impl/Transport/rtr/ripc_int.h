@@ -108,6 +108,7 @@
 #define CONN_VERSION_12		0x0015 /* 21 */
 #define CONN_VERSION_13		0x0016 /* 22 */
 #define CONN_VERSION_14		0x0017 /* 23 */
+#define CONN_VERSION_15		0x0018 /* 24 */
 
 RTR_C_ALWAYS_INLINE u32 dumpConnVersion(u32 version_number)
 {
@@ -128,6 +129,9 @@ RTR_C_ALWAYS_INLINE u32 dumpConnVersion(u32 version_number)
 		case CONN_VERSION_14:
 			return 14;
 		break;
+		case CONN_VERSION_15:
+			return 15;
+		break;
 		default:
 			return 0;
 	}
@@ -138,6 +142,7 @@ static const u32 _conn_version_11	=	CONN_VERSION_11;
 static const u32 _conn_version_12	=	CONN_VERSION_12;
 static const u32 _conn_version_13	=	CONN_VERSION_13;
 static const u32 _conn_version_14	=	CONN_VERSION_14;
+static const u32 _conn_version_15	=	CONN_VERSION_15;
 
 	/* These version numbers for non-negotiated clients was
 	 * picked because the old way sent an sockaddr_in structure
@@ -178,6 +183,12 @@ static const u32 _conn_version_14	=	CONN_VERSION_14;
 /* Current number of bytes in the compression bitmap */
 #define RSSL_COMP_BITMAP_SIZE 1
 
+/* Connection version 15 adds a 4 byte zstd dictionary ID to the connection request, after
+ * the client IP address, and to the ack, after the component versioning block. The client
+ * sends the ID of the dictionary it offers and the server echoes it when it compresses with
+ * that dictionary; 0 means no dictionary. */
+#define RSSL_COMP_DICT_ID_SIZE 4
+
 
 #define IPC_100_OTHER_HEADER_SIZE	8	/* Non Data opcode header size */
 #define IPC_100_CONN_ACK		    10	
@@ -49,6 +49,12 @@ extern "C" {
 #define IPC_MAX_HOST_NAME	256
 #define RIPC_MAX_FLUSH_STRATEGY 32
 #define RIPC_MAX_PRIORITY_QUEUE 3
+#define RIPC_MAX_ZEROCOPY_SENDS 256	/* zero copy sends a channel may have waiting for completion */
+#define RIPC_COMP_BUCKET_MIN_LENGTH 64	/* upper bound of the smallest compression statistics size class; each class doubles it */
+#define RIPC_COMP_SAMPLE_MSGS	32		/* compressed messages per adaptive compression sample */
+#define RIPC_COMP_MIN_BYPASS	256		/* messages sent uncompressed the first time a size class stops paying off */
+#define RIPC_COMP_MAX_BYPASS	65536	/* limit on the doubling bypass period */
+#define RIPC_RECV_STAMP_COUNT	32		/* receive timestamps kept for data not yet returned to the application */
 
 /*  ripc IOCTL codes */
 #define RIPC_MAX_POOL_BUFS			1	/* Set value to maximum number of pool buffers */
@@ -72,7 +78,8 @@ typedef enum
 	RIPC_VERSION_12 = 7,
 	RIPC_VERSION_13 = 8,
 	RIPC_VERSION_14 = 9,
-	RIPC_VERSION_LATEST = RIPC_VERSION_14 /* Denotes the latest version of RIPC handshake.  Should be 
+	RIPC_VERSION_15 = 10,
+	RIPC_VERSION_LATEST = RIPC_VERSION_15 /* Denotes the latest version of RIPC handshake.  Should be 
 										   * updated as newer versions of RIPC handshake are introduced. */
 } RsslRipcVersion;
 
@@ -96,8 +103,8 @@ typedef struct {
 	RsslUInt64	shared_key;  /* used for encryption/decryption - 0 when not available */
 } RIPC_SOCKET;
 
-#define RSSL_COMP_ALL_TYPE ((unsigned)RSSL_COMP_ZLIB | (unsigned)RSSL_COMP_LZ4)
-#define RSSL_COMP_MAX_TYPE 0x02		/* set to the highest ripcCompressType enum value */
+#define RSSL_COMP_ALL_TYPE ((unsigned)RSSL_COMP_ZLIB | (unsigned)RSSL_COMP_LZ4 | (unsigned)RSSL_COMP_ZSTD)
+#define RSSL_COMP_MAX_TYPE 0x04		/* set to the highest ripcCompressType enum value */
 #define ZLIB_COMP_MAX_LEVEL 9
 #define ZLIB_COMP_MIN_LEVEL 0
 
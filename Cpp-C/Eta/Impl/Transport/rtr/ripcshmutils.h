@@ -0,0 +1,113 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#ifndef __ripcshmutils_h
+#define __ripcshmutils_h
+
+/* Full-duplex shared memory transport (RSSL_CONN_TYPE_BIDIR_SHMEM).
+ *
+ * The normal RIPC session runs over a pair of single producer, single consumer
+ * byte rings in a segment created by the client.  The client connects to the
+ * server's Unix domain socket (abstract namespace, named after the port) and
+ * passes the segment and one eventfd per side with SCM_RIGHTS; the socket then
+ * stays open only to detect the peer going away.  Both sides check with
+ * SO_PEERCRED that the peer runs as the same user.  The server does not wait
+ * for the segment in accept; rsslInitChannel() attaches it once it arrives and
+ * moves the channel from the socket to its eventfd.
+ *
+ * A reader that finds its ring empty sets readerWaiting before returning, and
+ * the writer rings the reader's eventfd only when it sees that flag, so busy
+ * sides make no system calls.  Likewise a writer that finds the ring full sets
+ * writerWaiting, and the reader rings the writer's eventfd once it has made
+ * space.
+ *
+ * The eventfd a side waits on is that side's channel socketId.  An eventfd is
+ * always writable, so a flush that could not finish waits for it to become
+ * readable instead.
+ */
+
+#include "rtr/rsslSocketTransportImpl.h"
+#include "rtr/ripcutils.h"
+
+#define RIPC_SHM_MAGIC				0x52534D32	/* "RSM2" */
+#define RIPC_SHM_VERSION			1
+#define RIPC_SHM_DFLT_RING_SIZE		0x200000	/* 2MB in each direction */
+#define RIPC_SHM_MIN_RING_SIZE		0x10000
+#define RIPC_SHM_MAX_RING_SIZE		0x40000000
+
+#define RIPC_SHM_CLIENT_TO_SERVER	0
+#define RIPC_SHM_SERVER_TO_CLIENT	1
+
+/* Control block of one ring.  The writer owns tail, the reader owns head; each
+ * is on its own cache line. */
+typedef struct {
+	volatile RsslUInt64	tail;			/* bytes written */
+	char				pad1[56];
+	volatile RsslUInt64	head;			/* bytes read */
+	char				pad2[56];
+	volatile RsslUInt32	readerWaiting;	/* reader found the ring empty and may sleep */
+	volatile RsslUInt32	writerWaiting;	/* writer found the ring full and waits for space */
+	volatile RsslUInt32	bells;			/* times the reader's eventfd was signalled */
+	RsslUInt32			size;			/* power of two */
+	RsslUInt64			dataOffset;		/* from the start of the segment */
+	char				pad3[40];
+} ripcShmRing;
+
+typedef struct {
+	RsslUInt32			magic;
+	RsslUInt32			version;
+	volatile RsslUInt32	closed;			/* set by the first side to shut down */
+	char				pad[52];
+	ripcShmRing			rings[2];		/* indexed by RIPC_SHM_CLIENT_TO_SERVER/SERVER_TO_CLIENT */
+} ripcShmSegment;
+
+/* Sent by the client with the segment and eventfds attached. */
+typedef struct {
+	RsslUInt32	magic;
+	RsslUInt32	version;
+} ripcShmHello;
+
+/* Per channel state; this is the channel's transportInfo. */
+typedef struct {
+	ripcShmSegment	*seg;
+	size_t			segLength;
+	ripcShmRing		*in;
+	ripcShmRing		*out;
+	char			*inData;
+	char			*outData;
+	RsslSocket		ctlFd;			/* Unix domain socket to the peer */
+	RsslSocket		inFd;			/* eventfd signalled when there is something to read */
+	RsslSocket		peerFd;			/* the peer's eventfd */
+	RsslUInt32		bellsSeen;		/* signals consumed from inFd */
+} ripcShmSession;
+
+/* Registers the transport functions for RSSL_CONN_TYPE_BIDIR_SHMEM.  Must be
+ * called after ipcSetSockFuncs(), since unset functions default to the socket ones. */
+extern int ipcSetShmFuncs();
+
+extern RsslInt32 ipcShmSrvrBind(rsslServerImpl *srvr, RsslError *error);
+
+extern RsslSocket ipcShmSrvrAccept(rsslServerImpl *srvr, void** userSpecPtr, RsslError *error);
+
+extern RsslSocket ipcShmConnectSocket(RsslInt32 *portnum, void *opts, RsslInt32 flags, void** userSpecPtr, RsslError *error);
+
+extern void *ipcShmNewConn(void *srvr, RsslSocket fd, int *initComplete, void* userSpecPtr, RsslError *error);
+
+extern void *ipcShmNewClientConn(RsslSocket fd, int *initComplete, void* userSpecPtr, RsslError* error);
+
+extern int ipcShmInitTrans(void *transport, ripcSessInProg *inPr, RsslError *error);
+
+extern int ipcShmShutdown(void *transport);
+
+extern int ipcShmRead(void *transport, char *buf, int max_len, ripcRWFlags flags, RsslError *error);
+
+extern int ipcShmWrite(void *transport, char *buf, int outLen, ripcRWFlags flags, RsslError *error);
+
+extern int ipcShmWriteV(void *transport, ripcIovType *iov, int iovcnt, int outLen, ripcRWFlags flags, RsslError *error);
+
+#endif
@@ -55,8 +55,9 @@ typedef struct
 {
 	int initialized;
 	int (*library_init)(void);  		/* SSL_library_init */
-	void (*load_error_strings)(); 		/* SSL_load_error_strings */
-	void (*load_crypto_strings)(); 		/* crypto::ERR_load_crypto_strings */
+	void (*load_error_strings)(); 		/* SSL_load_error_strings, optional */
+	void (*load_crypto_strings)(); 		/* crypto::ERR_load_crypto_strings, optional */
+	int (*init_ssl)(uint64_t, const void*);	/* OPENSSL_init_ssl, used when SSL_library_init is missing */
 	SSL* (*ssl_new)(SSL_CTX*);			/* SSL_new */
 	int (*ssl_clear)(SSL*);				/* SSL_clear */
 	int (*ssl_connect)(SSL*);			/* SSL_connect */
@@ -74,13 +75,19 @@ typedef struct
 	void* (*get_ex_data)(SSL*, int);			/* SSL_get_ex_data */
 	void (*set_accept_state)(SSL*);			/* SSL_set_accept_state */
 	void (*ssl_free)(SSL*);				/* SSL_free */
-	int (*ssl_state)(const SSL*);		/* SSL_state */
+	int (*ssl_state)(const SSL*);		/* SSL_state, optional */
+	int (*is_init_finished)(const SSL*);	/* SSL_is_init_finished, used when SSL_state is missing */
 	const SSL_METHOD* (*TLSv1_client_method)();  /* TLSv1_client_method */
 	const SSL_METHOD* (*TLSv1_1_client_method)();
 	const SSL_METHOD* (*TLSv1_2_client_method)();
+	int (*set_session)(SSL*, SSL_SESSION*);		/* SSL_set_session, optional */
+	SSL_SESSION* (*get1_session)(SSL*);			/* SSL_get1_session, optional */
+	void (*session_free)(SSL_SESSION*);			/* SSL_SESSION_free, optional */
+	uint64_t (*set_options)(SSL*, uint64_t);	/* SSL_set_options, a function from OpenSSL 1.1 on; kernel TLS offload is skipped if it is missing */
+	int (*get_ex_data_X509_STORE_CTX_idx)(void);	/* SSL_get_ex_data_X509_STORE_CTX_idx, optional; the index is 0 in OpenSSL 1.0 */
 } ripcSSLApiFuncs;
 
-#define INIT_SSL_API_FUNCS {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
+#define INIT_SSL_API_FUNCS {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
 
 typedef struct
 {
@@ -97,15 +104,16 @@ typedef struct
 	void* (*ctx_set_ex_data)(SSL_CTX*, int, void*);		/* SSL_CTX_set_ex_data */
 	void (*ctx_free)(SSL_CTX*);												/* SSL_CTX_free */
 	long (*ctx_ctrl)(SSL_CTX*, int, long, void*);							/* SSL_CTX_ctrl */
+	unsigned long (*ctx_set_options)(SSL_CTX*, unsigned long);				/* SSL_CTX_set_options, a function from OpenSSL 1.1 on */
 }ripcSSLCTXApiFuncs;
 
-#define INIT_SSL_CTX_FUNCS {0,0,0,0,0,0,0,0,0,0,0,0,0}
+#define INIT_SSL_CTX_FUNCS {0,0,0,0,0,0,0,0,0,0,0,0,0,0}
 
 typedef struct
 {
 	int initialized;
 	int (*v3_add_standard_extensions)();				/* X509V3_add_standard_extensions */
-	unsigned long (*thread_id)();						/* CRYPTO_thread_id */
+	unsigned long (*thread_id)();						/* CRYPTO_thread_id, optional */
 	unsigned long (*get_error_line_data)(const char**, int*, const char**, int*); /* ERR_get_error_line_data */
 	void (*error_string_n)(unsigned long, char*, size_t);	/* ERR_error_string_n */
 	void* (*X509_get_ex_data)(X509_STORE_CTX*, int);		/* X509_STORE_CTX_get_ex_data */
@@ -121,14 +129,15 @@ typedef struct
 	BIGNUM* (*bin2bn)(const unsigned char*, int, BIGNUM*);	/* BN_bin2bn */
 	void (*dh_free)(DH*);						/* DH_free */
 	void (*rand_seed)(const void*, int);		/* RAND_seed */
-	void (*err_free_strings)(void);				/* ERR_free_strings */
-	void (*err_remove_state)(int);				/* ERR_remove_state */
-	void (*engine_cleanup)(void);				/* ENGINE_cleanup */
-	void (*crypto_cleanup_all_ex_data)(void);  /* CRYPTO_cleanup_all_ex_data */
-	void (*evp_cleanup)(void);					/* EVP_cleanup */
+	void (*err_free_strings)(void);				/* ERR_free_strings, optional */
+	void (*err_remove_state)(int);				/* ERR_remove_state, optional */
+	void (*engine_cleanup)(void);				/* ENGINE_cleanup, optional */
+	void (*crypto_cleanup_all_ex_data)(void);  /* CRYPTO_cleanup_all_ex_data, optional */
+	void (*evp_cleanup)(void);					/* EVP_cleanup, optional */
+	unsigned long (*version_num)(void);			/* OpenSSL_version_num, optional; missing before OpenSSL 1.1 */
 }ripcCryptoApiFuncs;
 
-#define INIT_CRYPTO_API_FUNCS {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
+#define INIT_CRYPTO_API_FUNCS {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
 
 typedef struct
 {
@@ -137,9 +146,10 @@ typedef struct
 	int (*sock_should_retry)(int);						/* BIO_sock_should_retry */
 	BIO* (*new_file)(const char*, const char*);			/* BIO_new_file */
 	int (*bio_free)(BIO*);								/* BIO_free */
+	long (*bio_ctrl)(BIO*, int, long, void*);			/* BIO_ctrl, optional */
 }ripcSSLBIOApiFuncs;
 
-#define INIT_SSL_BIO_API_FUNCS {0,0,0,0,0}
+#define INIT_SSL_BIO_API_FUNCS {0,0,0,0,0,0}
 
 #endif
 #endif
@@ -25,6 +25,7 @@
 #include "rtr/ripcssljit.h"
 
 #include <sys/types.h>
+#include <sys/socket.h>
 #include <unistd.h>
 #include <dlfcn.h>
 
@@ -105,8 +106,18 @@ typedef struct {
 	char		   clientConnState;
 	ripcSSLProtocolFlags sessionProtocol;
 	ripcSSLConnectOpts  config;  // this holds the config for the clients (if this is server side, the config is copied from the servers 
+	struct sockaddr_storage peer;	// client side, the server's address that cached sessions are kept under
+	socklen_t	   peerLen;			// 0 if the session is not cached
+	char		   resumeChecked;	// client side, a cached session has been looked for
+	char		   kernelTlsRequested;	// client side, OpenSSL was asked to offload the records to the kernel
+	char		   kernelTlsTx;		// records are encrypted by the kernel, so writes go straight to the socket
+	char		   kernelTlsRx;		// records are decrypted by the kernel; reads still go through SSL_read()
 } ripcSSLSession;
 
+/* ripcSSLKernelTlsOffload() flags */
+#define RIPC_SSL_KTLS_TX	0x1
+#define RIPC_SSL_KTLS_RX	0x2
+
 #define RIPC_INIT_SSL_SESSION { 0, 0, 0, 0, 0, SSL_INITIALIZING, RIPC_INIT_SSL_CONNECT_OPTS }
 
 /* our transport read function -
@@ -117,6 +128,13 @@ RsslInt32 ripcSSLRead( void *sslSess, char *buf, RsslInt32 max_len, ripcRWFlags
    this will write to the network using SSL and return the appropriate value to the ripc layer */
 RsslInt32 ripcSSLWrite( void *sslSess, char *buf, RsslInt32 len, ripcRWFlags flags, RsslError *error);
 
+/* our transport writev function - a single writev() when the kernel encrypts the records,
+   otherwise the buffers are written one at a time with SSL */
+int ripcSSLWriteV( void *sslSess, ripcIovType *iov, int iovcnt, int outLen, ripcRWFlags flags, RsslError *error);
+
+/* returns the RIPC_SSL_KTLS_* flags for the directions of the session handled by kernel TLS */
+RsslUInt32 ripcSSLKernelTlsOffload(void *session);
+
 /* shutdown the SSL and the socket */
 RsslInt32 ripcShutdownSSLSocket(void *session);
 
@@ -131,7 +149,7 @@ ripcSSLServer *ripcInitializeSSLServer(RsslSocket fd, char* name, RsslError  *er
 /* creates and initializes new client/session structure */
 ripcSSLSession *ripcInitializeSSLSession(RsslSocket fd, RsslInt32 SSLProtocolVersion, char* name, RsslError *error);
 
-/* connects session to a server */
+/* connects session to a server; userSpecPtr, if set, points to an RsslBool asking for kernel TLS offload */
 void *ripcSSLConnectTLSv1(RsslSocket fd, RsslInt32 *initComplete, void* userSpecPtr, RsslError *error);
 
 
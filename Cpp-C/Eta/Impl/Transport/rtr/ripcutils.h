@@ -70,7 +70,8 @@ typedef enum {
 	RIPC_SOPT_CLOEXEC		= 6,	/* Use turn_on */
 	RIPC_SOPT_TCP_NODELAY	= 7,	/* Use turn_on */
 	RIPC_SOPT_EXCLUSIVEADDRUSE = 8,	/* Use Exclusive Address Reuse (WIN) */
-	RIPC_SOPT_KEEPALIVE		= 9
+	RIPC_SOPT_KEEPALIVE		= 9,
+	RIPC_SOPT_REUSEPORT		= 10	/* Use turn_on */
 } ripcSocketOptionsCode;
 
 typedef struct {
@@ -116,12 +117,54 @@ extern int ipcWrite(void *transport, char *buf, int outLen, ripcRWFlags flags, R
 
 extern int ipcWriteV(void *transport, ripcIovType *iov, int iovcnt, int outLen, ripcRWFlags flags, RsslError *error);
 
+/* Zero copy sends (Linux MSG_ZEROCOPY).  Each send that writes any bytes with
+ * zero copy is assigned the next notification id by the kernel, and the
+ * written memory must not be reused until that id is reported complete. */
+extern int ipcZeroCopyEnable(RsslSocket fd);
+
+/* Same as ipcWriteV, but sends with MSG_ZEROCOPY.  *zeroCopySent is set to 1
+ * if bytes were written with zero copy and a notification id was used. */
+extern int ipcZeroCopyWriteV(void *transport, ripcIovType *iov, int iovcnt, int outLen, ripcRWFlags flags, int *zeroCopySent, RsslError *error);
+
+/* Resets the connection so the kernel stops sending from zero copy buffers,
+ * while leaving the descriptor open so their completions can still be read.
+ * The socket should be closed afterwards. */
+extern int ipcZeroCopyAbort(RsslSocket fd);
+
+/* Reads one completion from the socket error queue.  Returns 1 and the range
+ * of completed ids in [*lo, *hi], 0 if there are no more completions, -1 on error.
+ * *copied is set to 1 when the kernel had to copy the data anyway. */
+extern int ipcZeroCopyCompletion(RsslSocket fd, RsslUInt32 *lo, RsslUInt32 *hi, int *copied);
+
+/* Kernel receive timestamps (Linux SO_TIMESTAMPING).  Each entry gives the
+ * software receive time of the bytes read up to endOffset. */
+typedef struct {
+	RsslUInt32	endOffset;
+	RsslUInt64	stamp;			/* nanoseconds since the epoch */
+} ripcRecvStamp;
+
+extern int ipcRecvTimestampEnable(RsslSocket fd, int enable);
+
+/* Same as ipcRead, but reads with recvmsg and appends an entry to stamps for each
+ * receive that returned a timestamp, with endOffset relative to buf.  Once
+ * maxStamps entries are used, the last entry is overwritten. */
+extern int ipcReadTimestamp(void *transport, char *buf, int max_len, ripcRWFlags flags, ripcRecvStamp *stamps, RsslUInt32 *stampCount, RsslUInt32 maxStamps, RsslError *error);
+
+/* Sets SO_BUSY_POLL and SO_PREFER_BUSY_POLL (Linux) so the kernel polls the device
+ * queue for up to usec microseconds on reads.  Returns 1 if SO_BUSY_POLL was set. */
+extern int ipcBusyPollEnable(RsslSocket fd, RsslUInt32 usec);
+
+/* Monotonic clock in nanoseconds, used to time compression. */
+extern RsslUInt64 ipcGetTimeNano();
+
 extern int ipcWrite(void *transport, char *buf, int outLen, ripcRWFlags flags, RsslError *error);
 
 extern int ipcScktReconnectClient(void *transport, RsslError *error);
 
 extern RsslSocket ipcSrvrAccept(rsslServerImpl *srvr, void** userSpecPtr, RsslError *error);
 
+extern void ipcSrvrShutdownError(rsslServerImpl* srvr);
+
 extern int ipcShutdownSckt(void *transport);
 
 /* Not support for ipc Sockets */
@@ -0,0 +1,85 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#ifndef __rsslbinarytraceimpl
+#define __rsslbinarytraceimpl
+
+#include <stdio.h>
+
+#include "rtr/rsslTransport.h"
+#include "rtr/rsslBinaryTrace.h"
+#include "rtr/rsslQueue.h"
+#include "rtr/rsslThread.h"
+#include "rtr/rtratomic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bytes in each channel's record buffer; a power of two */
+#define RSSL_BINARY_TRACE_RING_SIZE		0x100000
+
+/* A channel's binary trace.  Any thread using the channel claims space for a record by moving
+ * reserved forward, copies the record in, and then sets its recordLength, which commits it.
+ * The writer thread writes committed records to the file in order, zeroes their space and moves
+ * consumed forward.  Positions only grow (modulo 2^32); they are masked to index the buffer.
+ * A record that would not fit before the end of the buffer is preceded by a pad, whose
+ * recordLength has RSSL_BINARY_TRACE_PAD set and which is not written to the file.
+ * A trace lasts as long as its channel: turning it off only stops recording and closes the file,
+ * since threads reading or writing the channel may still be using it. */
+typedef struct rsslBinaryTrace {
+	RsslQueueLink	link;				/* on the writer thread's list */
+	char			*ring;				/* record buffer */
+	RsslUInt32		ringMask;			/* RSSL_BINARY_TRACE_RING_SIZE - 1 */
+	RsslUInt32		maxDataLength;		/* longest message kept whole */
+	volatile RsslBool recording;		/* producers leave the buffer alone while this is off */
+	rtr_atomic_val	reserved;			/* end of the space claimed by producers */
+	rtr_atomic_val	dropped;			/* records not kept since the writer thread last looked */
+	char			producerPad[56];	/* keeps the writer thread's position off the producers' cache line */
+	rtr_atomic_val	consumed;			/* start of the space not yet given back by the writer thread */
+	RsslUInt32		pass;				/* writer thread pass that last drained it */
+	RsslMutex		fileMutex;			/* held while draining; guards consumed and the fields below */
+	FILE			*file;				/* current file, or NULL once maxFileSize stopped the trace */
+	char			*fileName;			/* traceMsgFileName; files are named after it */
+	RsslInt64		fileSize;			/* bytes written to the current file */
+	RsslInt64		maxFileSize;		/* traceMsgMaxFileSize */
+	RsslBool		multipleFiles;		/* RSSL_TRACE_TO_MULTIPLE_FILES */
+	RsslBinaryTraceFileHeader fileHeader;	/* starts each file */
+} rsslBinaryTrace;
+
+#define RSSL_BINARY_TRACE_PAD			0x80000000
+
+/* Called by rsslInitialize() and rsslUninitialize().  Uninitializing stops the writer thread
+ * and closes the traces still open. */
+void _rsslBinaryTraceInitialize();
+void _rsslBinaryTraceUninitialize();
+
+/* Creates a channel's trace, opens its first file and hands it to the writer thread, which is
+ * started on first use.  Returns NULL and populates error on failure. */
+rsslBinaryTrace *_rsslBinaryTraceOpen(RsslChannel *chnl, RsslTraceOptions *traceOptions, RsslError *error);
+
+/* Starts recording again into a new file, after _rsslBinaryTraceStop().  Does nothing if the trace
+ * is recording.  Returns RSSL_RET_FAILURE and populates error on failure. */
+RsslRet _rsslBinaryTraceStart(rsslBinaryTrace *trace, RsslChannel *chnl, RsslTraceOptions *traceOptions, RsslError *error);
+
+/* Stops recording, writes what the trace holds and closes its file.  The trace itself is kept. */
+void _rsslBinaryTraceStop(rsslBinaryTrace *trace);
+
+/* Takes the trace from the writer thread, writes what it holds, and frees it.  Only called when
+ * the channel closes, once no other thread can be using it. */
+void _rsslBinaryTraceClose(rsslBinaryTrace *trace);
+
+/* Copies a record into the trace's buffer.  Safe to call from several threads at once; the record
+ * is dropped, and counted, if the buffer is full. */
+void _rsslBinaryTraceRecord(rsslBinaryTrace *trace, RsslUInt16 event, RsslSocket channelId, const char *data, RsslUInt32 dataLength, RsslInt32 retCode);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
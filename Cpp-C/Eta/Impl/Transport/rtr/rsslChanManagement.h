@@ -66,6 +66,7 @@ typedef struct {
 								   * This string also includes a time stamp appended to it if a new trace file needs to be created
 								   * if traceMsgMaxFileSize is reached. The ".xml" extension is appended to the end of the string*/
 	FILE* traceMsgFilePtr;		   /* Pointer to the user specified file */
+	struct rsslBinaryTrace *binaryTrace;	/* set while RSSL_TRACE_BINARY is on, see rsslBinaryTraceImpl.h */
 } RsslTraceOptionsInfo;
 
 	
@@ -101,6 +102,7 @@ typedef struct {
 	RsslUInt64		shared_key;				/* shared key for encryption/decryption.  If 0 this is not present */
 	RsslBool			ownConnOptCompVer;	/* if true, we created memory for connn opts component version.  false otherwise */
 	RsslComponentInfo	connOptsCompVer;	/* the component version string passed in by the user through the connectOpts */
+	RsslReassemblyAllocator	reassemblyAllocator;	/* application buffers for reassembling fragmented messages, see RSSL_REASSEMBLY_ALLOCATOR */
 } rsslChannelImpl;	
 
 typedef struct {
@@ -133,6 +135,8 @@ typedef struct {
 	RsslUInt32	   msgSeqNum;			/* sequence number for the whole message (for multicast) */
 	RsslUInt16	   readOutFlags;		/* for return of readOutArgs */
 	RsslUInt8	   FTGroupId;			/* the FTGroup this was sent from (for multicast) */
+	RsslReassemblyFreeFunction *freeBuffer;	/* if set, buffer came from the application's reassembly allocator and is released through this */
+	void		   *userSpecPtr;		/* passed to freeBuffer */
 } rsslAssemblyBuffer;
 
 typedef enum {
@@ -180,6 +184,7 @@ RTR_C_INLINE void rsslClearTraceOptionsInfo(RsslTraceOptionsInfo *traceOptionsIn
 	traceOptionsInfo->newTraceMsgFileName = NULL;
 	traceOptionsInfo->traceMsgOrigFileNameSize = 0;
 	traceOptionsInfo->traceMsgFilePtr = NULL;
+	traceOptionsInfo->binaryTrace = NULL;
 }
 
 RTR_C_INLINE RsslUInt32 UInt32_key_hash(void *element)
@@ -236,6 +241,12 @@ typedef struct RsslTransChannelFuncs {
 	RsslRet  (RTR_FASTCALL *channelGetInfo)( rsslChannelImpl *rsslChnlImpl, RsslChannelInfo *info, RsslError *error );
 	/* Allows for changing channel options */
 	RsslRet  (RTR_FASTCALL *channelIoctl)( rsslChannelImpl *rsslChnlImpl, RsslIoctlCodes code, void *value, RsslError *error );
+	/* Writes a message that is going to several channels (rsslWriteToChannels).  *sharedMsg is a copy of the message, framed
+	 * by the transport, that every channel able to send it as it is queues; the first of them makes it.  Other channels are
+	 * written their own copy.  NULL when the transport only writes copies. */
+	RsslRet  (RTR_FASTCALL *channelWriteShared)( rsslChannelImpl *rsslChnlImpl, RsslBuffer *msg, void **sharedMsg, RsslWriteInArgs *writeInArgs, RsslWriteOutArgs *writeOutArgs, RsslError *error );
+	/* Releases a shared message made by channelWriteShared */
+	void  (*releaseSharedMsg)( void *sharedMsg );
 } RsslTransportChannelFuncs;
 
 
@@ -350,8 +361,20 @@ RTR_C_ALWAYS_INLINE void _rsslCleanAssemblyBuffer(rsslAssemblyBuffer *assemblyBu
 	assemblyBuf->FTGroupId = 0;
 	assemblyBuf->readOutFlags = 0;
 	assemblyBuf->nodeId = 0;
+	assemblyBuf->freeBuffer = 0;
+	assemblyBuf->userSpecPtr = 0;
 }	
 
+/* releases the data of an assembly buffer whose message was not completed */
+RTR_C_ALWAYS_INLINE void _rsslFreeAssemblyBufferData(rsslChannelImpl *chnl, rsslAssemblyBuffer *assemblyBuf)
+{
+	if (assemblyBuf->freeBuffer)
+		(*assemblyBuf->freeBuffer)(&chnl->Channel, assemblyBuf->buffer.data, assemblyBuf->userSpecPtr);
+	else
+		_rsslFree(assemblyBuf->buffer.data);
+	assemblyBuf->buffer.data = 0;
+}
+
 
 /* CHANNEL HELPERS */
 
@@ -384,6 +407,7 @@ RTR_C_ALWAYS_INLINE void _rsslCleanChan(rsslChannelImpl *chnl)
 	chnl->returnBuffer.data = 0;
 	chnl->returnBuffer.length = 0;
 	chnl->returnBufferOwner = 0;
+	rsslClearReassemblyAllocator(&chnl->reassemblyAllocator);
 
 	/* set this to the typical value.  If ripc allows for more (e.g. greater than conn version 13) it will be increased when we connect */
 	chnl->fragIdMax = 255;
@@ -592,6 +616,9 @@ rsslServerImpl *_rsslNewServer();
 void RTR_FASTCALL _rsslReleaseChannel(rsslChannelImpl *chnl);
 void RTR_FASTCALL _rsslReleaseServer(rsslServerImpl *srvr);
 
+/* Writes a copy of msg to a channel, as rsslGetBuffer() and rsslWriteEx() would */
+RsslRet _rsslWriteCopy(rsslChannelImpl *rsslChnlImpl, RsslBuffer *msg, RsslWriteInArgs *writeInArgs, RsslWriteOutArgs *writeOutArgs, RsslError *error);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,163 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#ifndef __RTR_SEQ_MCAST_RECOVERY_H
+#define __RTR_SEQ_MCAST_RECOVERY_H
+
+/* Gap recovery for the Sequence Multicast transport (RsslSeqMCastOpts.reorderWindow).
+ *
+ * Received packets are tracked per stream (sender address, port and instance ID).
+ * A packet that arrives ahead of the next expected sequence number is held in a
+ * slot indexed by sequence number.  The missing packets are confirmed lost once
+ * more than reorderWindow later packets have arrived, a ping shows they were sent,
+ * or they have been missing for SEQ_MCAST_REORDER_WAIT msec.  Confirmed holes are
+ * requested from the retransmission server, if there is one, and skipped when
+ * retransTimeout passes or the server says it doesn't have them.
+ *
+ * When recovery is on, the channel's socketId is an epoll descriptor covering the
+ * multicast socket, the retransmission connection and a timer for the earliest
+ * deadline, so applications can keep selecting on socketId.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rtr/rsslTypes.h"
+#include "rtr/rsslTransport.h"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#else
+#include <netinet/in.h>
+#endif
+
+#define SEQ_MCAST_REORDER_WAIT			5		/* msec a hole may stay unconfirmed */
+#define SEQ_MCAST_RETRANS_HOLD			4096	/* extra packets held while waiting for retransmissions */
+#define SEQ_MCAST_RETRANS_MAX_REQS		256		/* outstanding requests on the retransmission connection */
+#define SEQ_MCAST_RETRANS_RECONNECT		1000	/* msec between connection attempts to the retransmission server */
+
+/* A received packet, either from the multicast socket or the retransmission server */
+typedef struct seqMcastPkt
+{
+	struct seqMcastPkt	*next;
+	RsslUInt32			length;
+	RsslUInt32			seqNum;
+	RsslUInt32			addr;
+	RsslUInt16			port;
+	RsslUInt16			instanceId;
+	char				*data;
+} seqMcastPkt;
+
+typedef enum
+{
+	SEQ_MCAST_SLOT_EMPTY	= 0,	/* not yet seen; may still arrive out of order */
+	SEQ_MCAST_SLOT_HELD		= 1,	/* packet is held for in-order delivery */
+	SEQ_MCAST_SLOT_MISSING	= 2		/* confirmed lost; skipped at deadline */
+} seqMcastSlotState;
+
+typedef struct
+{
+	seqMcastPkt			*pkt;
+	RsslInt64			deadline;
+	RsslUInt8			state;
+} seqMcastSlot;
+
+typedef struct
+{
+	RsslUInt32			addr;
+	RsslUInt16			port;
+	RsslUInt16			instanceId;
+	RsslUInt32			nextSeqNum;		/* next sequence number to deliver */
+	RsslUInt32			highSeqNum;		/* highest sequence number known to have been sent */
+	RsslInt64			holeSince;		/* when the oldest unconfirmed hole was first seen, 0 for none */
+	RsslUInt32			holeSeqNum;		/* the oldest unconfirmed hole, when holeSince is set */
+	RsslUInt32			numHeld;
+	seqMcastSlot		*slots;			/* indexed by sequence number modulo the channel's capacity */
+} seqMcastStream;
+
+typedef struct
+{
+	RsslUInt32			addr;
+	RsslUInt16			port;
+	RsslUInt16			instanceId;
+	RsslUInt32			firstSeqNum;
+	RsslUInt16			count;
+} seqMcastRetransReq;
+
+typedef struct
+{
+	RsslUInt32			reorderWindow;
+	RsslUInt32			retransTimeout;
+	RsslUInt32			capacity;		/* slots per stream */
+	RsslUInt32			maxPktLen;
+
+	seqMcastStream		*streams;
+	RsslUInt32			numStreams;
+
+	seqMcastPkt			*freePkts;
+	seqMcastPkt			*readyHead;		/* packets ready for delivery, in order */
+	seqMcastPkt			*readyTail;
+	seqMcastPkt			*current;		/* packet being read by the application */
+
+	/* Requests waiting to be sent, then waiting for their responses */
+	seqMcastRetransReq	reqs[SEQ_MCAST_RETRANS_MAX_REQS];
+	RsslUInt32			reqHead;		/* oldest request still waiting for a response */
+	RsslUInt32			reqSent;		/* requests before this one have been written */
+	RsslUInt32			reqTail;
+
+	/* Retransmission connection */
+	RsslBool			retrans;
+	struct sockaddr_in	retransAddr;
+	RsslSocket			retransSock;
+	RsslBool			retransConnected;
+	RsslUInt32			retransEvents;	/* what the epoll descriptor is watching for on retransSock */
+	RsslInt64			retransLastAttempt;
+	char				*retransIn;
+	RsslUInt32			retransInLen;
+	char				retransOut[RSSL_SEQ_MCAST_RETRANS_REQ_LEN];
+	RsslUInt32			retransOutLen;	/* bytes of reqs[reqSent] already written */
+
+	RsslSocket			epollFd;
+	RsslSocket			timerFd;
+	RsslInt64			timerDeadline;
+
+	RsslUInt64			mcastRcvd;
+	RsslUInt64			gapsDetected;
+	RsslUInt64			retransReqSent;
+	RsslUInt64			retransPktsRcvd;
+} seqMcastRecovery;
+
+/* Core (no sockets); used directly by the unit tests.  Times are in msec. */
+seqMcastRecovery *rsslSeqMcastRecoveryCreate(RsslUInt32 reorderWindow, RsslUInt32 retransTimeout, RsslBool retrans, RsslUInt32 maxPktLen, RsslError *error);
+void rsslSeqMcastRecoveryDestroy(seqMcastRecovery *pRecovery);
+seqMcastPkt *rsslSeqMcastRecoveryGetPkt(seqMcastRecovery *pRecovery);
+void rsslSeqMcastRecoveryPutPkt(seqMcastRecovery *pRecovery, seqMcastPkt *pPkt);
+RsslRet rsslSeqMcastRecoveryInsert(seqMcastRecovery *pRecovery, seqMcastPkt *pPkt, RsslInt64 now);
+RsslRet rsslSeqMcastRecoveryPing(seqMcastRecovery *pRecovery, RsslUInt32 addr, RsslUInt16 port, RsslUInt16 instanceId, RsslUInt32 seqNum, RsslInt64 now);
+seqMcastPkt *rsslSeqMcastRecoveryNext(seqMcastRecovery *pRecovery, RsslInt64 now);
+RsslInt64 rsslSeqMcastRecoveryDeadline(seqMcastRecovery *pRecovery);
+
+/* Sockets */
+RsslRet rsslSeqMcastRecoveryOpen(seqMcastRecovery *pRecovery, RsslSocket mcastSock, char *retransHostName, char *retransServiceName, RsslError *error);
+
+/* Returns the next packet to hand to the application, or NULL with readRet set.
+ * The packet stays valid until the next call. */
+seqMcastPkt *rsslSeqMcastRecoveryRead(seqMcastRecovery *pRecovery, RsslSocket mcastSock, RsslBool blocking, RsslRet *readRet, RsslError *error);
+
+/* RSSL_TRUE if there are packets ready that won't be signalled on the epoll descriptor */
+RTR_C_INLINE RsslBool rsslSeqMcastRecoveryPending(seqMcastRecovery *pRecovery)
+{
+	return (pRecovery->readyHead != 0) ? RSSL_TRUE : RSSL_FALSE;
+}
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -32,6 +32,11 @@ typedef struct
 } rtrSeqMcastBuffer;
 /* This should be a statically allocated part of the channel.  If we add buffer pooling at a later date, this is where we should try to do it. */
 
+#define SEQ_MCAST_MAX_VERSION 0x01
+
+/* Ping length is the total number of bytes in the header, minus the message length. */
+#define SEQ_MCAST_PING_LEN 12
+
 typedef enum {
 	SEQ_MCAST_NO_FLAGS				= 0x00, /*!< @brief None. */
 	SEQ_MCAST_FLAGS_RETRANSMIT		= 0x02
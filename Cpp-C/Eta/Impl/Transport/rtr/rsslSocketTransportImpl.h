@@ -45,7 +45,8 @@ extern "C" {
 #define RIPC_OPENSSL_TRANSPORT  1
 #define RIPC_WININET_TRANSPORT  2
 #define RIPC_EXT_LINE_SOCKET_TRANSPORT 5
-#define RIPC_MAX_TRANSPORTS     RIPC_EXT_LINE_SOCKET_TRANSPORT + 1
+#define RIPC_BIDIR_SHMEM_TRANSPORT 7
+#define RIPC_MAX_TRANSPORTS     (RIPC_BIDIR_SHMEM_TRANSPORT + 1)
 #define RIPC_MAX_SSL_PROTOCOLS  3		/* TLSv1, TLSv1.1, TLSv1.2 */
 
 typedef enum {
@@ -122,8 +123,29 @@ typedef struct {
 	RsslInt32 queueLength;
 	rtr_msgb_t		*tempList[RIPC_MAXIOVLEN + 1];
 	RsslInt32	tempIndex;
+
+	/* weighted flushing (RSSL_PRIORITY_FLUSH_WEIGHTS) */
+	RsslUInt32	weight;			/* bytes this queue may flush per turn */
+	RsslUInt64	flushedBytes;
+	RsslUInt64	flushedBuffers;
+	RsslUInt64	totalWaitNsec;	/* time flushed buffers spent queued */
+	RsslUInt64	maxWaitNsec;
 } RIPC_PRIORITY_WRITE;
 
+/* Round robin position of weighted flushing.  A flush works on a copy and keeps it only up to
+ * the last buffer the socket took, so buffers that did not go out are chosen again next time. */
+typedef struct {
+	RsslInt64	deficit[RIPC_MAX_PRIORITY_QUEUE];	/* bytes each queue may still flush; negative after latency budget flushes */
+	RsslInt8	currentQueue;	/* the queue whose turn it is */
+	RsslUInt8	credited;		/* the current queue already got its weight this turn */
+	RsslUInt32	budgetFlushes;	/* latency budget flushes chosen since the copy was taken */
+} ripcWeightedFlushState;
+
+typedef struct {
+	RsslUInt32	numBufs;	/* buffers to release when this send completes */
+	RsslUInt8	done;		/* completion was reported by the kernel */
+} RIPC_ZEROCOPY_SEND;
+
 typedef struct {
 	RsslUInt32		connVersion;
 	RsslUInt32		ipcVersion;
@@ -142,6 +164,8 @@ RIPC_SESS_VERS ripc13Ver;
 RIPC_SESS_VERS ripc13WinInetVer;
 RIPC_SESS_VERS ripc14Ver;
 RIPC_SESS_VERS ripc14WinInetVer;
+RIPC_SESS_VERS ripc15Ver;
+RIPC_SESS_VERS ripc15WinInetVer;
 
 typedef enum {
 	RIPC_PROTO_SSL_NONE = 0,
@@ -256,6 +280,41 @@ typedef struct {
 	int(*decompress)(void *compressInfo, ripcCompBuffer *buf, RsslError *error);
 } ripcCompFuncs;
 
+/* A zstd dictionary shared by the compression streams of one or more channels.
+ * A server creates one at bind time and lends it to its accepted channels; a client
+ * creates its own at connect time and prepares the compression side once the
+ * server has told it which level to use.
+ */
+typedef struct {
+	RsslUInt32	dictId;			/* dictionary ID, exchanged in the handshake */
+	RsslInt32	level;			/* compression level cdict was prepared with */
+	void		*cdict;			/* digested dictionary for compression */
+	void		*ddict;			/* digested dictionary for decompression */
+	char		*data;			/* raw dictionary content, kept until cdict is prepared */
+	RsslUInt32	length;
+} ripcCompDict;
+
+ripcCompDict*	ripcZstdCreateDict(char *data, RsslUInt32 length, RsslError *error);
+RsslRet			ripcZstdPrepareDict(ripcCompDict *dict, RsslInt32 compressionLevel, RsslError *error);
+RsslRet			ripcZstdUseDict(ripcCompDict *dict, void *compressInfo, void *decompressInfo, RsslError *error);
+void			ripcZstdFreeDict(ripcCompDict *dict);
+
+/* Adaptive compression state for one message size class of a channel.
+ * Compressed messages are sampled in groups; when a sample saves less than the
+ * channel's minimum, or costs more time per byte saved than its maximum, the
+ * class is sent uncompressed for bypassLength messages, and the period doubles
+ * each time a retry still does not pay off.
+ */
+typedef struct {
+	RsslCompressionBucketStats	stats;			/* reported through rsslGetChannelInfo */
+	RsslUInt64					sampleIn;		/* uncompressed bytes in the current sample */
+	RsslUInt64					sampleOut;		/* compressed bytes in the current sample */
+	RsslUInt64					sampleNsec;		/* time spent compressing the current sample */
+	RsslUInt32					sampleMsgs;		/* messages in the current sample */
+	RsslUInt32					bypassLeft;		/* messages left to send uncompressed before retrying */
+	RsslUInt32					bypassLength;	/* length of the next bypass period */
+} ripcCompBucket;
+
 /* This structure represents the function entry points for the different
 * Secure Sockets Layer implementations.
 * -- OpenSSL Secure Sockets
@@ -272,6 +331,34 @@ typedef struct RsslSSLSrvrFuncs {
 
 ripcSSLFuncs*		getSSLTransFuncs();
 
+/* A thread that negotiates accepted channels for a server, see RsslBindOptions::handshakeThreads.
+ * The mutex covers the channel list and the handshake state of the channels on it; it is not held
+ * while a handshake is driven, so rsslInitChannel() on the application's thread never waits for one.
+ */
+typedef struct {
+	RsslMutex		mutex;
+	RsslThreadId	threadId;
+	RsslQueue		channels;		/* channels being negotiated, in the order they are driven */
+	void			*current;		/* channel being driven right now, so closing it can wait */
+	int				wakeFd;			/* eventfd that wakes the thread for new channels and shutdown */
+	RsslBool		stop;
+} ripcHandshakeWorker;
+
+typedef struct {
+	RsslUInt32			numWorkers;
+	RsslUInt32			nextWorker;		/* round robin assignment of new channels */
+	ripcHandshakeWorker	*workers;
+} ripcHandshakePool;
+
+/* Where a channel of a server with a handshake pool is in being negotiated */
+typedef enum {
+	RIPC_HS_NONE = 0,			/* not handed over */
+	RIPC_HS_WORKING = 1,		/* a worker is negotiating it */
+	RIPC_HS_DONE = 2,			/* negotiation finished, the result has not been returned yet */
+	RIPC_HS_HANDED_BACK = 3,	/* the connection's descriptor has been returned, success is next */
+	RIPC_HS_FINISHED = 4		/* negotiated and active, or failed */
+} ripcHandshakeState;
+
 typedef struct {
 	RsslQueueLink      link1;      /* It is used to add this type to RsslQueue */
 	char		*serverName;		/* portName or port number */
@@ -281,12 +368,15 @@ typedef struct {
 	RsslUInt32	maxGuarMsgs;		/* Guar. number output messages per session */
 	RsslUInt32	maxNumMsgs;			/* Max number of output messages per session */
 	RsslUInt32	numInputBufs;		/* number of input buffers used to read in data */
+	RsslUInt32	sharedPoolCacheSize;	/* number of shared pool buffers each session may cache */
 	RsslUInt32  compressionSupported;	/* a bitmask of The types of compression supported by this server. 0 means no compression */
 	RsslUInt32	zlibCompressionLevel;	/* compression level for zlib */
 	RsslBool	forcecomp;			/* Force compression */
 	RsslBool	server_blocking;	/* Perform server blocking operations */
 	RsslBool	session_blocking;	/* Perform session blocking operations */
 	RsslBool	tcp_nodelay;		/* Disable Nagle Algorithm */
+	RsslUInt32	autoPackSize;		/* transparent packing size for accepted channels, 0 is off */
+	RsslBool	serverSharedSocket;	/* Open the listening socket with SO_REUSEPORT */
 	RsslInt32	connType;			/* Controls the connection type */
 	RsslUInt32	rsslFlags;			/* this flag keeps track of client to server and server to client ping*/
 	RsslUInt8	pingTimeout; 		/* ping timeout */
@@ -307,9 +397,11 @@ typedef struct {
 									* the OS calls read/write. For Secure
 									* Sockets we use SSLRead/SSLWrite calls.
 									*/
+	ripcCompDict	*compDict;		/* zstd dictionary offered to clients, owned by the server */
+	ripcHandshakePool	*handshakePool;	/* threads negotiating accepted channels, 0 when they are negotiated by rsslInitChannel() */
 } RsslServerSocketChannel;
 
-#define RSSL_INIT_SERVER_SOCKET_Bind { 0, 0, 0, 0, 0, 0, 0, RSSL_COMP_NONE, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+#define RSSL_INIT_SERVER_SOCKET_Bind { 0, 0, 0, 0, 0, 0, 0, RSSL_COMP_NONE, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
 RTR_C_INLINE void rsslClearRsslServerSocketChannel(RsslServerSocketChannel *rsslServerSocketChannel)
 {
@@ -320,12 +412,15 @@ RTR_C_INLINE void rsslClearRsslServerSocketChannel(RsslServerSocketChannel *rssl
 	rsslServerSocketChannel->maxGuarMsgs = 0;
 	rsslServerSocketChannel->maxNumMsgs = 0;
 	rsslServerSocketChannel->numInputBufs = 0;
+	rsslServerSocketChannel->sharedPoolCacheSize = 0;
 	rsslServerSocketChannel->compressionSupported = RSSL_COMP_NONE;
 	rsslServerSocketChannel->zlibCompressionLevel = 0;
 	rsslServerSocketChannel->forcecomp = 0;
 	rsslServerSocketChannel->server_blocking = 0;
 	rsslServerSocketChannel->session_blocking = 0;
 	rsslServerSocketChannel->tcp_nodelay = 0;
+	rsslServerSocketChannel->autoPackSize = 0;
+	rsslServerSocketChannel->serverSharedSocket = 0;
 	rsslServerSocketChannel->connType = 0;
 	rsslServerSocketChannel->rsslFlags = 0;
 	rsslServerSocketChannel->pingTimeout = 0;
@@ -338,7 +433,10 @@ RTR_C_INLINE void rsslClearRsslServerSocketChannel(RsslServerSocketChannel *rssl
 	rsslServerSocketChannel->sendBufSize = 0;
 	rsslServerSocketChannel->recvBufSize = 0;
 	rsslServerSocketChannel->transportInfo = 0;
+	rsslServerSocketChannel->compDict = 0;
+	rsslServerSocketChannel->handshakePool = 0;
 	rsslServerSocketChannel->mountNak = 0;
+	rsslServerSocketChannel->stream = RIPC_INVALID_SOCKET;
 }
 
 RSSL_RSSL_SOCKET_IMPL_FAST(void) relRsslServerSocketChannel(RsslServerSocketChannel* rsslServerSocketChannel);
@@ -373,6 +471,7 @@ typedef struct
 	RsslUInt32			recvBufSize;
 
 	RsslUInt32 			encryptionProtocolFlags;
+	RsslBool			kernelTlsOffload;	/* RsslEncryptionOpts::kernelTlsOffload, passed to the SSL client connection */
 
 	/* SSL/TLS Encryption information */
 	ripcSSLProtocolFlags sslProtocolBitmap;		/* Represents the protocols supported by the dynamically loaded openSSL library */
@@ -400,6 +499,10 @@ typedef struct
 	RsslUInt32			sentControlAck : 1; /* used for tunneling connection */
 
 	RsslUInt32			zlibCompLevel;		/* compression level for zlib */
+	ripcCompDict		*compDict;			/* zstd dictionary; a client owns it, an accepted channel borrows the server's once negotiated */
+	RsslUInt32			compMinSavings;		/* adaptive compression: percent a size class must save to stay compressed, 0 is off */
+	RsslUInt32			compMaxCost;		/* adaptive compression: nanoseconds per kilobyte saved a size class may cost, 0 is no limit */
+	ripcCompBucket		compBuckets[RSSL_COMP_STATS_BUCKET_COUNT];	/* compression statistics per message size class */
 	RsslUInt32			lowerCompressionThreshold;			/* dont compress any buffers smaller than this */
 	RsslUInt32			upperCompressionThreshold;			/* dont compress any buffers larger than this */
 	RsslUInt32			high_water_mark;	/* used for the upper buffer usage threshold for this channel */
@@ -422,6 +525,42 @@ typedef struct
 												to avoid potential zlib dictionary issues, we keep track of the first
 												queue compression was done on and only allow it on that queue */
 	RsslInt8			nextOutBuf;		/* used to keep track of next out buffer in case of partial write */
+	RsslUInt8			weightedFlush;		/* priority queues are flushed by byte-weighted round robin instead of the flush strategy */
+	ripcWeightedFlushState	flushState;
+	RsslUInt64			highLatencyBudget;	/* weighted flushing: nanoseconds a high priority buffer may wait before it goes ahead of its turn, 0 is off */
+	RsslUInt64			budgetFlushes;		/* high priority buffers flushed ahead of their turn */
+	RsslUInt64			coalesceWriteNsec;	/* nanoseconds written data may be held before it is flushed, 0 is off */
+	RsslUInt64			coalesceDeadline;	/* time the oldest held data must be flushed by, 0 when nothing is held */
+	RsslUInt64			writeSysCalls;		/* system calls made to write data */
+	RsslUInt32			autoPackSize;		/* small messages are packed into buffers of up to this size, 0 is off */
+	rtr_msgb_t			*autoPackBufs[RIPC_MAX_PRIORITY_QUEUE];	/* open packed buffer for each priority */
+	RsslUInt64			autoPackedMsgs;		/* messages copied into packed buffers */
+	RsslUInt64			autoPackedBufs;		/* packed buffers written */
+
+	RsslQueueLink		handshakeLink;		/* link in the handshake worker's channel list */
+	ripcHandshakeWorker	*handshakeWorker;	/* worker negotiating this channel, if any */
+	RsslUInt8			handshakeState;		/* ripcHandshakeState */
+	int					handshakeFd;		/* eventfd standing in for stream while a worker negotiates, -1 if none */
+	ripcSessInit		handshakeResult;	/* how the worker's negotiation ended */
+	RsslError			handshakeError;		/* error from the worker's negotiation */
+
+	RsslPageArena		*pageArena;			/* where the channel's buffers are allocated, NULL for the heap */
+
+	RsslUInt32			zeroCopyThreshold;	/* flushes of at least this many bytes use MSG_ZEROCOPY, 0 disables */
+	RsslUInt32			zeroCopyNextId;		/* notification id the kernel assigns to the next zero copy send */
+	RsslUInt32			zeroCopyDoneId;		/* every zero copy send before this id has completed */
+	RsslUInt32			zeroCopyNumCopied;	/* zero copy sends that the kernel had to copy anyway */
+	RsslUInt8			zeroCopyPartial;	/* the partially written buffer was part of a zero copy send */
+	RsslQueue			zeroCopyBufs;		/* written buffers waiting for a zero copy send to complete, in write order */
+	RIPC_ZEROCOPY_SEND	zeroCopySends[RIPC_MAX_ZEROCOPY_SENDS];
+	RsslSocket			zeroCopyStream;		/* socket of a closed channel, kept open until its zero copy sends complete */
+
+	RsslUInt32			busyPollUsec;		/* microseconds a read keeps polling an empty socket, 0 is off */
+	RsslUInt8			recvTimestamps;		/* SO_TIMESTAMPING receive timestamps are on */
+	RsslUInt32			recvStampHead;		/* first entry of recvStamps still covering unread input */
+	RsslUInt32			recvStampCount;		/* entries used in recvStamps */
+	RsslUInt64			lastRecvStamp;		/* receive time of the last message taken from the input buffer */
+	ripcRecvStamp		recvStamps[RIPC_RECV_STAMP_COUNT];	/* receive time per read into the input buffer, in offset order */
 
 	rtr_msgb_t			*decompressBuf;		/* decompress buffer */
 	rtr_msgb_t			*tempDecompressBuf;	/* temporary buffer to use when decompressing with compression types that dont effectively handle data growth (LZ4) */
@@ -463,6 +602,26 @@ typedef struct
 											*/
 } RsslSocketChannel;
 
+/* Turns weighted flushing off and clears its statistics */
+RTR_C_INLINE void ripcClearWeightedFlush(RsslSocketChannel *rsslSocketChannel)
+{
+	RsslInt32 i;
+
+	for (i = 0; i < RIPC_MAX_PRIORITY_QUEUE; i++)
+	{
+		rsslSocketChannel->priorityQueues[i].weight = 0;
+		rsslSocketChannel->priorityQueues[i].flushedBytes = 0;
+		rsslSocketChannel->priorityQueues[i].flushedBuffers = 0;
+		rsslSocketChannel->priorityQueues[i].totalWaitNsec = 0;
+		rsslSocketChannel->priorityQueues[i].maxWaitNsec = 0;
+	}
+
+	rsslSocketChannel->weightedFlush = 0;
+	memset(&rsslSocketChannel->flushState, 0, sizeof(ripcWeightedFlushState));
+	rsslSocketChannel->highLatencyBudget = 0;
+	rsslSocketChannel->budgetFlushes = 0;
+}
+
 RTR_C_INLINE void ripcClearRsslSocketChannel(RsslSocketChannel *rsslSocketChannel)
 {
 	RsslInt32 i = 0;
@@ -488,6 +647,14 @@ RTR_C_INLINE void ripcClearRsslSocketChannel(RsslSocketChannel *rsslSocketChanne
 	rsslSocketChannel->sentControlAck = 0;
 	/* Dont clear sessionID here - we want this to stay persistant for the life of the session */
 	rsslSocketChannel->zlibCompLevel = 6;  /* set this to the default we want */
+	rsslSocketChannel->compDict = 0;
+	rsslSocketChannel->compMinSavings = 0;
+	rsslSocketChannel->compMaxCost = 0;
+	memset(rsslSocketChannel->compBuckets, 0, sizeof(rsslSocketChannel->compBuckets));
+	for (i = 0; i < RSSL_COMP_STATS_BUCKET_COUNT - 1; i++)
+		rsslSocketChannel->compBuckets[i].stats.maxLength = RIPC_COMP_BUCKET_MIN_LENGTH << i;
+	for (i = 0; i < RSSL_COMP_STATS_BUCKET_COUNT; i++)
+		rsslSocketChannel->compBuckets[i].bypassLength = RIPC_COMP_MIN_BYPASS;
 	rsslSocketChannel->lowerCompressionThreshold = 0;
 	rsslSocketChannel->upperCompressionThreshold = 10000000;
 	rsslSocketChannel->high_water_mark = 6000;
@@ -523,6 +690,36 @@ RTR_C_INLINE void ripcClearRsslSocketChannel(RsslSocketChannel *rsslSocketChanne
 	rsslSocketChannel->currentOutList = 0;
 	rsslSocketChannel->compressQueue = -1;
 	rsslSocketChannel->nextOutBuf = -1;
+	ripcClearWeightedFlush(rsslSocketChannel);
+
+	rsslSocketChannel->zeroCopyThreshold = 0;
+	rsslSocketChannel->zeroCopyNextId = 0;
+	rsslSocketChannel->zeroCopyDoneId = 0;
+	rsslSocketChannel->zeroCopyNumCopied = 0;
+	rsslSocketChannel->zeroCopyPartial = 0;
+	rsslInitQueue(&rsslSocketChannel->zeroCopyBufs);
+	memset(rsslSocketChannel->zeroCopySends, 0, sizeof(rsslSocketChannel->zeroCopySends));
+	rsslSocketChannel->zeroCopyStream = RIPC_INVALID_SOCKET;
+
+	rsslSocketChannel->coalesceWriteNsec = 0;
+	rsslSocketChannel->coalesceDeadline = 0;
+	rsslSocketChannel->writeSysCalls = 0;
+	rsslSocketChannel->autoPackSize = 0;
+	memset(rsslSocketChannel->autoPackBufs, 0, sizeof(rsslSocketChannel->autoPackBufs));
+	rsslSocketChannel->autoPackedMsgs = 0;
+	rsslSocketChannel->autoPackedBufs = 0;
+
+	rsslInitQueueLink(&rsslSocketChannel->handshakeLink);
+	rsslSocketChannel->handshakeWorker = 0;
+	rsslSocketChannel->handshakeState = RIPC_HS_NONE;
+	rsslSocketChannel->handshakeFd = -1;
+	rsslSocketChannel->handshakeResult = RIPC_CONN_IN_PROGRESS;
+
+	rsslSocketChannel->busyPollUsec = 0;
+	rsslSocketChannel->recvTimestamps = 0;
+	rsslSocketChannel->recvStampHead = 0;
+	rsslSocketChannel->recvStampCount = 0;
+	rsslSocketChannel->lastRecvStamp = 0;
 
 	rsslSocketChannel->decompressBuf = 0;
 	rsslSocketChannel->tempCompressBuf = 0;
@@ -669,6 +866,7 @@ RSSL_RSSL_SOCKET_IMPL_FAST(RsslBuffer*) rsslSocketRead(rsslChannelImpl* rsslChnl
 
 /* Contains code necessary to write/queue data going to a socket connection (client or server side) */
 RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketWrite(rsslChannelImpl *rsslChnlImpl, rsslBufferImpl *rsslBufImpl, RsslWriteInArgs *writeInArgs, RsslWriteOutArgs *writeOutArgs, RsslError *error);
+RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketWriteShared(rsslChannelImpl *rsslChnlImpl, RsslBuffer *msg, void **sharedMsg, RsslWriteInArgs *writeInArgs, RsslWriteOutArgs *writeOutArgs, RsslError *error);
 
 /* Contains code necessary to flush queued data to socket connection (client or server side) */
 RSSL_RSSL_SOCKET_IMPL_FAST(RsslRet) rsslSocketFlush(rsslChannelImpl *rsslChnlImpl, RsslError *error);
@@ -39,6 +39,26 @@ extern "C" {
 
 #define RSSL_SHM_MIN_SEQ_NUM			0
 #define RSSL_SHM_COMPONENT_VERSION_SIZE	255	// plus 1 bytes for the length
+#define RSSL_SHM_MAX_READERS			64	// readers beyond this work, but the server cannot see or wait for them
+
+/* One per attached reader, in the shmem seg after circularBufferServer.
+ * Each reader writes only its own slot, which is a cache line to itself. */
+typedef struct
+{
+	volatile RsslUInt64	seqNum;			// next sequence number the reader will read
+	volatile RsslUInt64	overruns;		// times the reader fell more than maxLag behind
+	volatile RsslUInt64	lostMsgs;		// messages skipped by resumeOnOverrun
+	RsslUInt64			maxLag;			// the reader's maxReaderSeqNumLag
+	volatile RsslUInt32	inUse;
+	RsslUInt32			pad[5];
+} rtrShmReader;
+
+typedef struct
+{
+	volatile RsslUInt32	generation;		// incremented each time a reader attaches
+	RsslUInt32			pad[15];
+	rtrShmReader		readers[RSSL_SHM_MAX_READERS];
+} rtrShmReaderTable;
 
 typedef struct
 {
@@ -72,6 +92,14 @@ typedef struct
 	rtr_atomic_val64*	seqNumServer;	// server sequence number, 32 bit platform does not do native atomic 64 load/store */
 #endif
 	rtrShmCirBuf*		circularBufferServer;
+	rtrShmReaderTable*	readerTable;
+
+	// not in shared memory segment - slow reader policy, see RSSL_SHMEM_SLOW_READER_WAIT
+	RsslUInt32			slowReaderWaitUsec;
+	RsslUInt32			readerGeneration;	// readerTable->generation when writesBeforeCheck was computed
+	RsslUInt64			writesBeforeCheck;	// writes that cannot overrun any reader
+	RsslUInt64			slowReaderWaits;
+	RsslUInt64			slowReaderTimeouts;
 } rtrShmTransServer;
 
 
@@ -89,6 +117,7 @@ typedef struct
 #define RSSL_SHM_SERVER_PING_ENABLED	0x01
 #define RSSL_SHM_SERVER_SHUTDOWN		0x02	// the server has shutdown and destroyed the shmem segment
 #define RSSL_SHM_SERVER_INITIALIZED		0x04	// the shmem segment is ready to accept connections 
+#define RSSL_SHM_SERVER_READER_TABLE	0x08	// the shmem segment has a reader table; older servers do not
 
 typedef struct
 {
@@ -106,12 +135,17 @@ typedef struct
 #endif
 	rtrSpinLock*  		userLock;				// lock for adding/removing users
 	rtrShmCirBuf*		circularBufferServer;
+	rtrShmReaderTable*	readerTable;			// 0 if the server is older and has none
 	rtrShmBuffer*		readBuffer;				// not stored in shared memory - pointer to last read buffer
 	rtrShmCirBuf		circularBufferClient;	// not stored in shared memory
 	RsslUInt64			seqNumClient;			/* not stored in shared memory - client sequence number */
 	RsslUInt64			readRetries;			/* the number of consecutive times the reader recevied nothing from a read attempt */
 	RsslUInt64			maxReaderRetryThreshhold;/* maximum number of read retries before the client waits for a notification */
 	RsslUInt64			maxReaderSeqNumLag;		/* not stored in shared memory */
+	RsslBool			resumeOnOverrun;		/* not stored in shared memory - skip ahead instead of disconnecting */
+	rtrShmReader*		reader;					/* our slot in the reader table, 0 if there is none */
+	RsslUInt64			overruns;				/* not stored in shared memory - also kept in reader when there is one */
+	RsslUInt64			lostMsgs;
 	RsslUInt16*			shmemVersion;			// the version of the shmem transport used to create the shmem seg
 	RsslUInt16*			flags;
 	RsslUInt32*			byteWritten;			// used to signify when there is a byte in the named pipe
@@ -150,6 +184,7 @@ typedef struct
 	RsslUInt32	   majorVersion;
 	RsslUInt32	   minorVersion;
 	RsslUInt64	   maxReaderSeqNumLag;
+	RsslBool	   resumeOnOverrun;
 	RsslUInt64	   maxReaderRetryThreshhold;	// used by the notifier
 	void		   *userSpecPtr;  
 } rtrShmAttachOpts;
@@ -171,17 +206,38 @@ RsslInt32 rtrShmTransDetach(rtrShmTransClient *trans, RsslError *error);
 rtrShmBuffer* rtrShmTransClientRead(rtrShmTransClient *trans, RsslChannel *chnl, RsslRet *readRet, RsslError *error);
 	/* Retrieve an empty output buffer. */
 
+void rtrShmTransWaitForReaders(rtrShmTransServer *trans);
+	/* Applies the slow reader policy before the next write */
+
+void rtrShmTransServerStats(rtrShmTransServer *trans, RsslShmemStats *stats);
+	/* Server side reader statistics */
+
+void rtrShmTransClientStats(rtrShmTransClient *trans, RsslShmemStats *stats);
+	/* Client side reader statistics */
+
 /* server uses to get a buffer to write into */
 RTR_C_ALWAYS_INLINE rtrShmBuffer* rtrShmTransGetFreeBuffer(rtrShmTransServer *trans)
 {
 	return (rtrShmBuffer*)RTRShmCirBufGetWriteBuf(trans->circularBufferServer, &trans->shMemSeg);
 }
 
+/* server uses to get a buffer to write into, after making room for slow readers if it waits for them */
+RTR_C_ALWAYS_INLINE rtrShmBuffer* rtrShmTransGetWriteBuffer(rtrShmTransServer *trans)
+{
+	if (rtrUnlikely(trans->slowReaderWaitUsec != 0) &&
+		(trans->writesBeforeCheck-- == 0 || trans->readerGeneration != trans->readerTable->generation))
+		rtrShmTransWaitForReaders(trans);
+
+	return rtrShmTransGetFreeBuffer(trans);
+}
+
 /* clients use to release buffer after read and process is done */
 RTR_C_ALWAYS_INLINE RsslInt32 rtrShmTransRelBuffer(rtrShmTransClient *trans)
 {
 	trans->seqNumClient++;
 	RTRShmCirBufReadComplete(&trans->circularBufferClient);
+	if (trans->reader)
+		trans->reader->seqNum = trans->seqNumClient;
 	return 0;
 }
 
@@ -13,6 +13,50 @@
 #include <stdio.h>
 #include <malloc.h>
 #include <assert.h>
+#ifndef WIN32
+#include <time.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+static RsslUInt64 rtrShmTransTimeUsec()
+{
+#ifdef WIN32
+	static LARGE_INTEGER frequency = { 0 };
+	LARGE_INTEGER counter;
+
+	if (frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (RsslUInt64)((double)counter.QuadPart * 1000000.0 / (double)frequency.QuadPart);
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (RsslUInt64)ts.tv_sec * 1000000ULL + (RsslUInt64)ts.tv_nsec / 1000;
+#endif
+}
+
+static RsslUInt32 rtrShmTransProcessId()
+{
+#ifdef WIN32
+	return (RsslUInt32)GetCurrentProcessId();
+#else
+	return (RsslUInt32)getpid();
+#endif
+}
+
+/* A reader that exited without detaching leaves its slot in use */
+static int rtrShmTransReaderGone(rtrShmReader *reader)
+{
+#ifdef WIN32
+	return 0;
+#else
+	return (kill((pid_t)reader->inUse, 0) == -1 && errno == ESRCH);
+#endif
+}
 
 
 rtrShmTransServer *rtrShmTransCreate(rtrShmCreateOpts *createOpts, RsslError *error)
@@ -36,7 +80,8 @@ rtrShmTransServer *rtrShmTransCreate(rtrShmCreateOpts *createOpts, RsslError *er
 							 RTR_SHM_ALIGNBYTES(sizeof(rtrUInt8) + RSSL_SHM_COMPONENT_VERSION_SIZE) +			/* component version and its (1 byte) length */
 							 RTR_SHM_ALIGNBYTES(sizeof(rtrSpinLock)) +					 						/* userLock */
 							 RTR_SHM_ALIGNBYTES(sizeof(rtrInt64)) +												/* seqNumServer */
-							 RTR_SHM_ALIGNBYTES(sizeof(rtrShmCirBuf)));											/* circularBufferServer */
+							 RTR_SHM_ALIGNBYTES(sizeof(rtrShmCirBuf)) +											/* circularBufferServer */
+							 RTR_SHM_ALIGNBYTES(sizeof(rtrShmReaderTable)));									/* readerTable */
 
 	trans = (rtrShmTransServer*)_rsslMalloc(sizeof(rtrShmTransServer));
 
@@ -146,9 +191,12 @@ rtrShmTransServer *rtrShmTransCreate(rtrShmCreateOpts *createOpts, RsslError *er
 	trans->userLock = (rtrSpinLock*)rtrShmBytesReserve( &trans->shMemSeg, RTR_SHM_ALIGNBYTES(sizeof(rtrSpinLock)));		/* spinlock is 4 bytes on windows and linux */
 	trans->seqNumServer = (RsslUInt64*)rtrShmBytesReserve(&trans->shMemSeg, sizeof(rtrInt64));
 	trans->circularBufferServer = (rtrShmCirBuf*)rtrShmBytesReserve( &trans->shMemSeg, sizeof(rtrShmCirBuf) );
+	/* older clients do not know about the reader table; they find the buffers through circularBufferServer */
+	trans->readerTable = (rtrShmReaderTable*)rtrShmBytesReserve( &trans->shMemSeg, RTR_SHM_ALIGNBYTES(sizeof(rtrShmReaderTable)) );
+	memset(trans->readerTable, 0, sizeof(rtrShmReaderTable));
 
 	*trans->shmemVersion = 1;	/* the version of this transport */
-	*trans->flags = 0;
+	*trans->flags = RSSL_SHM_SERVER_READER_TABLE;
 	*trans->pingTimeout  = createOpts->pingTimeout;
 	*trans->protocolType = createOpts->protocolType;
 	*trans->majorVersion = createOpts->majorVersion;
@@ -157,6 +205,12 @@ rtrShmTransServer *rtrShmTransCreate(rtrShmCreateOpts *createOpts, RsslError *er
 	trans->serverBlocking = createOpts->serverBlocking;
 	trans->channelsBlocking = createOpts->channelsBlocking;
 
+	trans->slowReaderWaitUsec = 0;
+	trans->readerGeneration = 0;
+	trans->writesBeforeCheck = 0;
+	trans->slowReaderWaits = 0;
+	trans->slowReaderTimeouts = 0;
+
 	if (createOpts->serverToClientPing)
 		*trans->flags |= RSSL_SHM_SERVER_PING_ENABLED;
 
@@ -319,6 +373,9 @@ rtrShmTransClient* rtrShmTransAttach( rtrShmAttachOpts *attachOpts, RsslError *e
 	trans->seqNumServer = 0;
 	trans->readBuffer = 0;
 	trans->namedPipe = 0;
+	trans->reader = 0;
+	trans->overruns = 0;
+	trans->lostMsgs = 0;
 
 	if ((trans->controlMutex = rtrShmSegAttachMutex(&trans->shMemSeg,attachOpts->shMemKey,0, errBuff)) == 0)
 	{
@@ -393,6 +450,10 @@ rtrShmTransClient* rtrShmTransAttach( rtrShmAttachOpts *attachOpts, RsslError *e
 	trans->userLock = (rtrSpinLock*) rtrShmBytesAttach( &curLoc, RTR_SHM_ALIGNBYTES(sizeof(rtrSpinLock)));		/* spinlock 4 bytes on win and Linux */
 	trans->seqNumServer = (RsslUInt64*)rtrShmBytesAttach( &curLoc, sizeof(rtrInt64));
 	trans->circularBufferServer = (rtrShmCirBuf*)rtrShmBytesAttach(&curLoc,sizeof(rtrShmCirBuf));
+	if (*trans->flags & RSSL_SHM_SERVER_READER_TABLE)
+		trans->readerTable = (rtrShmReaderTable*)rtrShmBytesAttach(&curLoc, RTR_SHM_ALIGNBYTES(sizeof(rtrShmReaderTable)));
+	else
+		trans->readerTable = 0;
 
 
 #if 0	/* for alignment debugging */
@@ -499,6 +560,36 @@ rtrShmTransClient* rtrShmTransAttach( rtrShmAttachOpts *attachOpts, RsslError *e
 		trans->maxReaderSeqNumLag = (trans->circularBufferClient.numBuffers * 3)/4;
 	}
 
+	/* a reader that skips ahead must land on a buffer the server is not writing */
+	trans->resumeOnOverrun = attachOpts->resumeOnOverrun;
+	if (trans->resumeOnOverrun && trans->maxReaderSeqNumLag > trans->circularBufferClient.numBuffers - 1)
+		trans->maxReaderSeqNumLag = trans->circularBufferClient.numBuffers - 1;
+
+	/* take a slot in the reader table so the server can see how far behind we are */
+	if (trans->readerTable)
+	{
+		RsslUInt32 i;
+		rtrShmReader *reader;
+
+		RTR_SHTRANS_LOCK(trans->userLock);
+		for (i = 0; i < RSSL_SHM_MAX_READERS; i++)
+		{
+			reader = &trans->readerTable->readers[i];
+			if (reader->inUse == 0 || rtrShmTransReaderGone(reader))
+			{
+				reader->seqNum = trans->seqNumClient;
+				reader->overruns = 0;
+				reader->lostMsgs = 0;
+				reader->maxLag = trans->maxReaderSeqNumLag;
+				reader->inUse = rtrShmTransProcessId();
+				++trans->readerTable->generation;
+				trans->reader = reader;
+				break;
+			}
+		}
+		RTR_SHTRANS_UNLOCK(trans->userLock);
+	}
+
 	if (*trans->protocolType != attachOpts->protocolType)
 	{
 		_rsslSetError(error, 0, RSSL_RET_FAILURE, 0);
@@ -522,6 +613,12 @@ int rtrShmTransDetach( rtrShmTransClient *trans, RsslError *error )
 {
 	rtrWaitForMutex(trans->controlMutex);
 
+	if (trans->reader)
+	{
+		trans->reader->inUse = 0;
+		trans->reader = 0;
+	}
+
 	trans->userLock = 0;
 	trans->circularBufferServer = 0;
 	trans->readBuffer = 0;
@@ -550,6 +647,44 @@ int rtrShmTransDetach( rtrShmTransClient *trans, RsslError *error )
 }
 
 
+/* Counts an overrun.  With resumeOnOverrun the reader moves up to maxReaderSeqNumLag behind
+ * the server, counts what it skipped and stays connected; otherwise the channel is closed. */
+static void rtrShmTransOverrun(rtrShmTransClient *trans, RsslChannel *chnl, RsslUInt64 seqNumServer, RsslError *error)
+{
+	rtrShmCirBuf *cBuf = &trans->circularBufferClient;
+	RsslUInt64 lag = seqNumServer - trans->seqNumClient;
+	RsslUInt64 nextSeqNum;
+
+	trans->overruns++;
+	trans->readBuffer = 0;
+
+	if (!trans->resumeOnOverrun)
+	{
+		if (trans->reader)
+			trans->reader->overruns = trans->overruns;
+		_rsslSetError(error, 0, RSSL_RET_SLOW_READER, 0);
+		snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rtrShmTransClientRead disconnected from shared memory because reader lags writer by %llu messages.\n", __FILE__, __LINE__, lag);
+		chnl->state = RSSL_CH_STATE_CLOSED;
+		return;
+	}
+
+	/* the buffer for seqNum is always at the same place in the circular buffer */
+	nextSeqNum = seqNumServer - trans->maxReaderSeqNumLag;
+	trans->lostMsgs += nextSeqNum - trans->seqNumClient;
+	trans->seqNumClient = nextSeqNum;
+	cBuf->read = cBuf->start + (RTR_SHM_OFFSET)(nextSeqNum % cBuf->numBuffers) * cBuf->maxBufSize;
+
+	if (trans->reader)
+	{
+		trans->reader->overruns = trans->overruns;
+		trans->reader->lostMsgs = trans->lostMsgs;
+		trans->reader->seqNum = nextSeqNum;
+	}
+
+	_rsslSetError(error, 0, RSSL_RET_SLOW_READER, 0);
+	snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rtrShmTransClientRead reader lagged writer by %llu messages and skipped %llu of them.\n", __FILE__, __LINE__, lag, lag - trans->maxReaderSeqNumLag);
+}
+
 /* client uses to read */
 rtrShmBuffer* rtrShmTransClientRead(rtrShmTransClient *trans, RsslChannel *chnl, RsslRet *readRet, RsslError *error)
 {
@@ -579,9 +714,7 @@ rtrShmBuffer* rtrShmTransClientRead(rtrShmTransClient *trans, RsslChannel *chnl,
 			/* return failure if reader is too slow */
 			if (rtrUnlikely(reader_seqnum_lag > trans->maxReaderSeqNumLag))
 			{
-				_rsslSetError(error, 0, RSSL_RET_SLOW_READER, 0);
-				snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rtrShmTransClientRead disconnected from shared memory because reader lags writer by %llu messages.\n", __FILE__, __LINE__, reader_seqnum_lag);
-				chnl->state = RSSL_CH_STATE_CLOSED;
+				rtrShmTransOverrun(trans, chnl, trans->seqNumClient + reader_seqnum_lag, error);
 				return 0;
 			}
 			trans->readBuffer = (rtrShmBuffer*)RTRShmCirBufRead(&trans->circularBufferClient, &trans->shMemSeg);
@@ -592,9 +725,7 @@ rtrShmBuffer* rtrShmTransClientRead(rtrShmTransClient *trans, RsslChannel *chnl,
 			reader_seqnum_lag = (RsslUInt64)(RTR_ATOMIC_READ64(trans->seqNumServer) - trans->seqNumClient);
 			if (rtrUnlikely(reader_seqnum_lag > (trans->circularBufferClient.numBuffers - 1)))	/* check if server passed us during the memcpy */
 			{
-				_rsslSetError(error, 0, RSSL_RET_SLOW_READER, 0);
-				snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rtrShmTransClientRead disconnected from shared memory because reader lags writer by %llu messages.\n", __FILE__, __LINE__, reader_seqnum_lag);
-				chnl->state = RSSL_CH_STATE_CLOSED;
+				rtrShmTransOverrun(trans, chnl, trans->seqNumClient + reader_seqnum_lag, error);
 				return 0;
 			}
 			*readRet = (RsslRet) reader_seqnum_lag;
@@ -627,9 +758,7 @@ rtrShmBuffer* rtrShmTransClientRead(rtrShmTransClient *trans, RsslChannel *chnl,
 				/* return failure if reader is too slow */
 				if (reader_seqnum_lag > trans->maxReaderSeqNumLag)
 				{
-					_rsslSetError(error, 0, RSSL_RET_SLOW_READER, 0);
-					snprintf(error->text, MAX_RSSL_ERROR_TEXT, "<%s:%d> rtrShmTransClientRead failed because reader lags writer by %llu messages.\n", __FILE__, __LINE__, reader_seqnum_lag);
-					chnl->state = RSSL_CH_STATE_CLOSED;
+					rtrShmTransOverrun(trans, chnl, trans->seqNumClient + reader_seqnum_lag, error);
 					return 0;
 				}
 				*readRet = (RsslRet) reader_seqnum_lag;
@@ -660,3 +789,103 @@ rtrShmBuffer* rtrShmTransClientRead(rtrShmTransClient *trans, RsslChannel *chnl,
 }
 
 
+
+
+/* server uses before a write when it waits for slow readers (RSSL_SHMEM_SLOW_READER_WAIT) */
+/* Finds how many writes can be made before one would put an attached reader more than its maxLag behind,
+ * waiting first for any reader the next write would overrun.  Readers already overrun are not waited for;
+ * they skip ahead or disconnect on their own. */
+void rtrShmTransWaitForReaders(rtrShmTransServer *trans)
+{
+	rtrShmReaderTable *table = trans->readerTable;
+	RsslUInt64 nextSeqNum = *trans->seqNumServer;	/* only the server changes this */
+	RsslUInt64 writesBeforeCheck = (RsslUInt64)-1;
+	RsslUInt64 deadline = 0;
+	RsslUInt64 seqNum;
+	RsslUInt64 lag;
+	RsslUInt64 readerWrites;
+	rtrShmReader *reader;
+	RsslUInt32 i;
+	RsslBool timedOut = RSSL_FALSE;
+
+	/* read first, so a reader attaching during the scan causes another one */
+	trans->readerGeneration = table->generation;
+
+	for (i = 0; i < RSSL_SHM_MAX_READERS; i++)
+	{
+		reader = &table->readers[i];
+		if (reader->inUse == 0)
+			continue;
+
+		seqNum = reader->seqNum;
+		lag = nextSeqNum + 1 - seqNum;	/* after the next write */
+
+		if (lag == reader->maxLag + 1)
+		{
+			if (deadline == 0)
+			{
+				deadline = rtrShmTransTimeUsec() + trans->slowReaderWaitUsec;
+				trans->slowReaderWaits++;
+			}
+
+			while (reader->inUse && reader->seqNum == seqNum && rtrShmTransTimeUsec() < deadline)
+			{
+#ifdef WIN32
+				SwitchToThread();
+#else
+				sched_yield();
+#endif
+			}
+
+			if (reader->inUse == 0 || reader->seqNum == seqNum)
+				timedOut = RSSL_TRUE;
+			else
+				lag = nextSeqNum + 1 - reader->seqNum;
+		}
+
+		/* an overrun reader is looked at again once it could have skipped ahead and caught up */
+		readerWrites = (lag <= reader->maxLag) ? reader->maxLag - lag : reader->maxLag;
+		if (readerWrites < writesBeforeCheck)
+			writesBeforeCheck = readerWrites;
+	}
+
+	if (timedOut)
+		trans->slowReaderTimeouts++;
+
+	trans->writesBeforeCheck = writesBeforeCheck;
+}
+
+void rtrShmTransServerStats(rtrShmTransServer *trans, RsslShmemStats *stats)
+{
+	RsslUInt64 seqNumServer = RTR_ATOMIC_READ64(trans->seqNumServer);
+	rtrShmReader *reader;
+	RsslUInt32 i;
+
+	memset(stats, 0, sizeof(RsslShmemStats));
+
+	for (i = 0; i < RSSL_SHM_MAX_READERS; i++)
+	{
+		reader = &trans->readerTable->readers[i];
+		if (reader->inUse == 0)
+			continue;
+
+		stats->numReaders++;
+		if (seqNumServer - reader->seqNum > stats->readerLag)
+			stats->readerLag = seqNumServer - reader->seqNum;
+		stats->overruns += reader->overruns;
+		stats->lostMsgs += reader->lostMsgs;
+	}
+
+	stats->slowReaderWaits = trans->slowReaderWaits;
+	stats->slowReaderTimeouts = trans->slowReaderTimeouts;
+}
+
+void rtrShmTransClientStats(rtrShmTransClient *trans, RsslShmemStats *stats)
+{
+	memset(stats, 0, sizeof(RsslShmemStats));
+
+	stats->numReaders = 1;
+	stats->readerLag = (RsslUInt64)(RTR_ATOMIC_READ64(trans->seqNumServer) - trans->seqNumClient);
+	stats->overruns = trans->overruns;
+	stats->lostMsgs = trans->lostMsgs;
+}
@@ -105,6 +105,7 @@ typedef struct rtr_msgb {
 	unsigned short	protocol;
 	unsigned short  fragOffset;
 	int				priority;   /* which priority queue to write to */
+	RsslUInt64		queueTime;	/* when it was queued for writing, kept only with weighted flushing */
 	void			*local;		/* Local storage for however owns the rtr_msgb_t */
 } rtr_msgb_t;
 
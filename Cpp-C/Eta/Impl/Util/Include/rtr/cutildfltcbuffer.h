@@ -10,11 +10,19 @@
 #define	__rtr_dfltcbuffer_h
 
 #include "rtr/cutilcbuffer.h"
+#include "rtr/rtratomic.h"
+#include "rtr/rsslPageArena.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+	/* At most this fraction (1/n) of a shared pool's buffers may sit
+	 * unused in the caches of the pools that share it, so idle caches
+	 * cannot starve other pools.
+	 */
+#define RTR_DFLTC_CACHED_BUFS_DIVISOR 4
+
 typedef struct rtr_dfltcbufferpool {
 	rtr_bufferpool_t	bufpool;
 	RsslQueue	freeList;
@@ -29,7 +37,13 @@ typedef struct rtr_dfltcbufferpool {
 	int				numPoolBufs;
 	int				numRegBufsUsed; /* Current number of buffers used */
 	int				peakNumBufsUsed; /* Peak number of buffers used */
+	int				numSharedRefs; /* Shared data blocks referred to by this pool's messages, each counted as a buffer used */
 	RsslQueue	sharedPoolMblks;
+	RsslQueue	sharedPoolCache; /* Shared pool buffers held by this pool but not in use */
+	int				sharedPoolCacheSize; /* Max number of cached shared pool buffers, 0 disables the cache */
+	rtr_atomic_val	numCachedBufs; /* When used as a shared pool, buffers held in other pools' caches */
+	rtr_atomic_val	maxCachedBufs; /* When used as a shared pool, limit on numCachedBufs */
+	RsslPageArena	*pageArena; /* Where blocks are allocated, or NULL for the heap */
 #ifdef _DFLTC_BUFFER_DEBUG
 	unsigned int numFreeDblks;
 	unsigned int numFreeMblks;
@@ -43,6 +57,11 @@ enum rtr_dfltcMsgbFlags
 	rtr_dfltcMsgbPutInFreeList = 0x01
 };
 
+enum rtr_dfltcDatabFlags
+{
+	rtr_dfltcDatabShared = 0x01	/* Data block belongs to no pool, see rtr_dfltcAllocSharedDatab */
+};
+
 
 #define rtr_dfltcSetUsedLast(mypool,curmblk) \
 	( (	((mypool)->curDblk == (curmblk)->datab) && \
@@ -69,6 +88,11 @@ extern rtr_dfltcbufferpool_t *rtr_dfltcAllocPool(
 			RsslMutex *mutex );
 extern int rtr_dfltcSetBufSize( rtr_dfltcbufferpool_t *pool, size_t bufSize );
 
+	/* A pool allocates from the heap unless this gives it a page arena,
+	 * e.g. its channel's.  Must be called before rtr_dfltcSetBufSize.
+	 */
+extern int rtr_dfltcSetPageArena( rtr_dfltcbufferpool_t *pool, RsslPageArena *arena );
+
 extern int rtr_dfltcAddRef(rtr_bufferpool_t *pool);
 extern int rtr_dfltcDropRef(rtr_bufferpool_t *pool);
 
@@ -83,6 +107,55 @@ extern int rtr_dfltcSetMaxBufs(rtr_bufferpool_t *pool, int newValue );
 extern int rtr_dfltcSetMaxSharedBufs(rtr_bufferpool_t *pool, int newValue );
 extern int rtr_dfltcResetPeakNumBufs(rtr_bufferpool_t *pool);
 
+	/* Peak number of buffers used.  Buffers that other pools take from
+	 * their caches are counted the next time this pool is locked, so a
+	 * burst served entirely from caches (at most maxCachedBufs buffers)
+	 * may not show in the peak.
+	 */
+extern int rtr_dfltcGetPeakNumBufs(rtr_bufferpool_t *pool);
+
+	/* Sets the number of shared pool buffers this pool may keep cached
+	 * for reuse.  Cached buffers are pulled from and returned to the shared
+	 * pool in batches, so the shared pool lock is taken once per batch
+	 * instead of once per buffer.  The cache has no lock of its own: like
+	 * the rest of this pool, it is only used under the lock of the channel
+	 * that owns the pool, and only numCachedBufs in the shared pool is
+	 * updated atomically.  Cached buffers are not counted in numPoolBufs.
+	 * A value of 0 disables the cache.
+	 */
+extern int rtr_dfltcSetSharedPoolCacheSize(rtr_bufferpool_t *pool, int newValue );
+
+	/* Batch operations used to fill and drain the cache above.
+	 * rtr_dfltcAllocMaxMsgs returns one buffer for immediate use and adds
+	 * up to count - 1 more to the back of 'list', as long as the shared
+	 * pool's maxCachedBufs allows.  Those are counted in numCachedBufs until
+	 * they are taken from the cache or returned with rtr_dfltcFreeCachedMsgs,
+	 * which returns the number of buffers freed.  Both update the shared
+	 * pool's peak under its lock.
+	 */
+extern rtr_msgb_t *rtr_dfltcAllocMaxMsgs(rtr_bufferpool_t *pool, RsslQueue *list, int count);
+extern int rtr_dfltcFreeCachedMsgs(rtr_bufferpool_t *pool, RsslQueue *list);
+
+	/* Shared data blocks belong to no pool, so message blocks from any
+	 * number of pools can refer to the same data.  The reference count is
+	 * atomic, since the pools are not locked together.  A new block holds
+	 * one reference for its creator, which drops it with
+	 * rtr_dfltcReleaseSharedDatab; each message block made by
+	 * rtr_dfltcRefSharedDatab holds another until it is freed.  The block
+	 * is freed with its last reference.  A pool counts each of its
+	 * references as a buffer used, against its own and its shared pool
+	 * limits, so rtr_dfltcRefSharedDatab fails once they are reached.
+	 */
+extern rtr_datab_t *rtr_dfltcAllocSharedDatab(size_t size);
+extern rtr_msgb_t *rtr_dfltcRefSharedDatab(rtr_bufferpool_t *pool, rtr_datab_t *dblk, size_t length);
+extern void rtr_dfltcReleaseSharedDatab(rtr_datab_t *dblk);
+
+	/* Number of buffers in use, not counting buffers sitting in the caches
+	 * of pools that share this one.
+	 */
+#define rtr_dfltcNumBufsUsed(mypool) \
+	((mypool)->numRegBufsUsed - (mypool)->numCachedBufs)
+
 
 #ifdef __cplusplus
 } /* extern "C" */
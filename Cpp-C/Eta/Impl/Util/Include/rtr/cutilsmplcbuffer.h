@@ -10,6 +10,7 @@
 #define	__smplecbuffer_h
 
 #include "rtr/cutilcbuffer.h"
+#include "rtr/rsslPageArena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +22,8 @@ extern rtr_bufferpool_t *rtr_smplcAllocatePool( RsslMutex *mutex );
 extern int rtr_smplcAddRef(rtr_bufferpool_t *pool);
 extern int rtr_smplcDropRef(rtr_bufferpool_t *pool);
 extern rtr_msgb_t *rtr_smplcAllocMsg(rtr_bufferpool_t *pool, size_t size);
+	/* As rtr_smplcAllocMsg, with the data from 'arena' when it is not NULL */
+extern rtr_msgb_t *rtr_smplcAllocArenaMsg(rtr_bufferpool_t *pool, size_t size, RsslPageArena *arena);
 extern rtr_msgb_t *rtr_smplcAllocMaxMsg(rtr_bufferpool_t *pool);
 extern rtr_msgb_t *rtr_smplcDupMsg(rtr_bufferpool_t *pool, rtr_msgb_t *curmblk);
 extern rtr_msgb_t *rtr_smplcCopyMsg(rtr_bufferpool_t *pool, rtr_msgb_t *curmblk);
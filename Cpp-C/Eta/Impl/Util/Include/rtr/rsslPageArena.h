@@ -0,0 +1,69 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#ifndef	__rssl_page_arena_h
+#define	__rssl_page_arena_h
+
+#include <stddef.h>
+#include "rtr/rsslTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Page arenas hold the transport's long-lived buffers (channel output pools, server shared
+ * pools, input buffers and compression buffers) in 2 MB regions instead of separate heap
+ * blocks.  The regions are backed by huge pages when RSSL_PAGE_ARENA_HUGE_PAGES is set, and
+ * there is one arena for each NUMA node when RSSL_PAGE_ARENA_LOCAL_NODE is set, whose regions
+ * prefer that node.  With neither flag set no arena exists and callers use the heap.
+ *
+ * Allocations are rounded up to a power of two, from 64 bytes to a quarter of a region, and
+ * memory given back to its arena is reused for allocations of the same size class.  A region
+ * is unmapped once nothing in it is allocated, except the one new chunks are carved from,
+ * which starts over empty.  Larger allocations are mapped on their own. */
+
+/* Values match RsslInitMemoryFlags */
+#define RSSL_PAGE_ARENA_HUGE_PAGES	0x01	/* MAP_HUGETLB regions, else transparent huge pages */
+#define RSSL_PAGE_ARENA_LOCAL_NODE	0x02	/* an arena for each node, used by threads running on it */
+
+#define RSSL_PAGE_ARENA_REGION_SIZE	0x200000
+#define RSSL_PAGE_ARENA_MAX_NODES	64
+
+typedef struct RsslPageArena RsslPageArena;
+
+typedef struct {
+	RsslUInt64	regionBytes;	/* bytes mapped by all arenas */
+	RsslUInt64	hugeTlbBytes;	/* of those, bytes mapped with explicit huge pages */
+	RsslUInt64	nodeBoundBytes;	/* of those, bytes whose node policy was set for RSSL_PAGE_ARENA_LOCAL_NODE */
+	RsslUInt64	inUseBytes;		/* bytes allocated and not yet freed */
+	RsslUInt32	arenaCount;		/* arenas created, at most one per node */
+} RsslPageArenaStats;
+
+/* Sets the flags for the process; called once by ipcInitialize() */
+void rsslPageArenaInitialize(RsslUInt32 flags);
+
+/* Unmaps every region.  Nothing allocated from an arena may be used afterwards. */
+void rsslPageArenaUninitialize();
+
+/* The arena for the node the calling thread is running on, created on first use.
+ * Returns NULL when no flags were set, or if the arena cannot be created. */
+RsslPageArena *rsslPageArenaForThread();
+
+/* Allocates from the arena; safe to call from any thread.  Memory is aligned on 16 bytes. */
+void *rsslPageArenaAlloc(RsslPageArena *arena, size_t size);
+
+/* Gives memory back to the arena it came from. */
+void rsslPageArenaFree(void *mem);
+
+void rsslPageArenaGetStats(RsslPageArenaStats *stats);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
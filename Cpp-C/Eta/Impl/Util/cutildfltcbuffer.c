@@ -32,6 +32,20 @@
 int rtr_cbufferCppOverhead = 0;
 void *(*rtr_cbufferCppInit)(rtr_msgb_t*,void*) = 0;
 
+	/* Data and message blocks come from the pool's page arena when it has one */
+static void *rtr_dfltcMemAlloc( rtr_dfltcbufferpool_t *pool, size_t size )
+{
+	return (pool->pageArena ? rsslPageArenaAlloc(pool->pageArena, size) : malloc(size));
+}
+
+static void rtr_dfltcMemFree( rtr_dfltcbufferpool_t *pool, void *memory )
+{
+	if (pool->pageArena)
+		rsslPageArenaFree(memory);
+	else
+		free(memory);
+}
+
 
 size_t rtr_dfltcAlignBytes( size_t bytes, size_t alignment )
 {
@@ -40,6 +54,109 @@ size_t rtr_dfltcAlignBytes( size_t bytes, size_t alignment )
 	return(x);
 }
 
+static rtr_msgb_t *rtr_dfltcIntAllocMaxMsg(rtr_dfltcbufferpool_t *rtr_dfltcpool);
+static int rtr_dfltcIntFreeMsg(rtr_dfltcbufferpool_t *rtr_dfltcpool,rtr_msgb_t *mblk);
+
+#define isDfltcPool(pool) \
+	( ((pool)->allocMaxMsg == rtr_dfltcAllocMaxMsg) ? 1 : 0)
+
+/* Returns cached shared pool buffers until at most 'keep' are left in the cache. */
+static void rtr_dfltcDrainSharedPoolCache( rtr_dfltcbufferpool_t *pool, int keep )
+{
+	RsslQueue		drainList;
+	RsslQueueLink	*pLink;
+	rtr_msgb_t		*mblk;
+
+	if (keep < 0)
+		keep = 0;
+
+	if (pool->sharedPoolCache.count <= keep)
+		return;
+
+	if (isDfltcPool(pool->sharedPool))
+	{
+		rsslInitQueue(&drainList);
+		while (pool->sharedPoolCache.count > keep)
+		{
+			pLink = rsslQueueRemoveLastLink(&(pool->sharedPoolCache));
+			rsslQueueAddLinkToBack(&drainList, pLink);
+		}
+		rtr_dfltcFreeCachedMsgs(pool->sharedPool, &drainList);
+	}
+	else
+	{
+		while (pool->sharedPoolCache.count > keep)
+		{
+			pLink = rsslQueueRemoveLastLink(&(pool->sharedPoolCache));
+			mblk = RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink);
+			rtrBufferFree(mblk->pool,mblk);
+		}
+	}
+}
+
+/* Gets a max sized buffer from the shared pool.  When the cache is enabled,
+ * the buffer comes from the cache, which is refilled in a batch of up to
+ * half its size when empty.  The caller accounts for the buffer in numPoolBufs. */
+static rtr_msgb_t *rtr_dfltcGetSharedMblk( rtr_dfltcbufferpool_t *pool )
+{
+	rtr_dfltcbufferpool_t	*sharedpool;
+	RsslQueueLink			*pLink;
+	int						refill;
+
+	if (pool->sharedPoolCacheSize <= 0 || !isDfltcPool(pool->sharedPool))
+		return(rtrBufferAllocMax(pool->sharedPool));
+
+	sharedpool = (rtr_dfltcbufferpool_t*)pool->sharedPool->internal;
+
+	if (pool->sharedPoolCache.count == 0)
+	{
+		refill = (pool->sharedPoolCacheSize + 1) / 2;
+
+		/* Never hold more shared pool buffers than this pool is allowed to use. */
+		if (refill > (pool->maxPoolBufs - pool->numPoolBufs))
+			refill = pool->maxPoolBufs - pool->numPoolBufs;
+
+		if (refill <= 0)
+			return(0);
+
+		return(rtr_dfltcAllocMaxMsgs(pool->sharedPool, &(pool->sharedPoolCache), refill));
+	}
+
+	/* The shared pool's peak picks this buffer up the next time it is locked. */
+	pLink = rsslQueueRemoveFirstLink(&(pool->sharedPoolCache));
+	RTR_ATOMIC_DECREMENT(sharedpool->numCachedBufs);
+
+	return(RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink));
+}
+
+/* Returns a buffer to the shared pool, or to the cache when it is enabled
+ * and the shared pool's caches are not full.
+ * When the cache overflows, half of it is returned to the shared pool. */
+static void rtr_dfltcPutSharedMblk( rtr_dfltcbufferpool_t *pool, rtr_msgb_t *shmblk )
+{
+	rtr_dfltcbufferpool_t	*sharedpool;
+
+	if (pool->sharedPoolCacheSize <= 0 || !isDfltcPool(shmblk->pool))
+	{
+		rtrBufferFree(shmblk->pool,shmblk);
+		return;
+	}
+
+	sharedpool = (rtr_dfltcbufferpool_t*)shmblk->pool->internal;
+
+	if (sharedpool->numCachedBufs >= sharedpool->maxCachedBufs)
+	{
+		rtrBufferFree(shmblk->pool,shmblk);
+		return;
+	}
+
+	rsslQueueAddLinkToFront(&(pool->sharedPoolCache),&(shmblk->link));
+	RTR_ATOMIC_INCREMENT(sharedpool->numCachedBufs);
+
+	if (pool->sharedPoolCache.count > pool->sharedPoolCacheSize)
+		rtr_dfltcDrainSharedPoolCache(pool, pool->sharedPoolCacheSize / 2);
+}
+
 
 static int rtr_dfltcRemovePool( rtr_dfltcbufferpool_t *pool )
 {
@@ -50,7 +167,7 @@ static int rtr_dfltcRemovePool( rtr_dfltcbufferpool_t *pool )
 	while ((pLink = rsslQueueRemoveLastLink(&(pool->freeList))) != 0)
 	{
 		dblk = RSSL_QUEUE_LINK_TO_OBJECT(rtr_datab_t, link, pLink);
-		free(dblk);
+		rtr_dfltcMemFree(pool, dblk);
 	}
 
 	pool->bufpool.numBufs = 0;
@@ -65,7 +182,7 @@ static int rtr_dfltcRemovePool( rtr_dfltcbufferpool_t *pool )
 	if (pool->curDblk)
 	{
 		if (fromMyPool(pool->curDblk,pool))
-			free(pool->curDblk);
+			rtr_dfltcMemFree(pool, pool->curDblk);
 		else
 		{
 			rtrBufferFree(pool->curDblk->pool,(rtr_msgb_t*)pool->curDblk->internal);
@@ -83,17 +200,19 @@ static int rtr_dfltcRemovePool( rtr_dfltcbufferpool_t *pool )
 		pool->numPoolBufs--;
 	}
 
+	rtr_dfltcDrainSharedPoolCache(pool, 0);
+
 	while ((pLink = rsslQueueRemoveLastLink(&(pool->usedList))) != 0)
 	{
 		dblk = RSSL_QUEUE_LINK_TO_OBJECT(rtr_datab_t, link, pLink);
-		free(dblk);
+		rtr_dfltcMemFree(pool, dblk);
 	}
 
 	/* Allocated message blocks list does not have an associated structure.  The allocated memory block 
 	   starts with a RsslQueueLink header. */
 	while ((pLink = (RsslQueueLink*)rsslQueueRemoveLastLink(&(pool->allocatedMblks))) != 0)
 	{
-		free(pLink);
+		rtr_dfltcMemFree(pool, pLink);
 	}
 
 	rsslInitQueue(&(pool->freeMsgList));
@@ -115,7 +234,7 @@ static int rtr_dfltcRemoveFromPool( rtr_dfltcbufferpool_t *pool, int numBufs )
 			pool->numFreeDblks--;
 			pool->numFreeMblks--;
 #endif
-			free(dblk);
+			rtr_dfltcMemFree(pool, dblk);
 			pool->bufpool.numBufs--;
 		}
 		else
@@ -133,7 +252,7 @@ static int rtr_dfltcIncreasePool( rtr_dfltcbufferpool_t *pool, int bufs )
 
 	while (numBufs < bufs)
 	{
-		memory = malloc(sizeof(rtr_datab_t) + sizeof(rtr_msgb_t) + rtr_cbufferCppOverhead + pool->bufpool.maxBufSize);
+		memory = rtr_dfltcMemAlloc(pool, sizeof(rtr_datab_t) + sizeof(rtr_msgb_t) + rtr_cbufferCppOverhead + pool->bufpool.maxBufSize);
 		if (memory)
 		{
 			dblk = (rtr_datab_t*)memory;
@@ -199,7 +318,7 @@ static int rtr_dfltcIncreaseMblks( rtr_dfltcbufferpool_t *pool, int bufs )
 	if ( bytesNeeded < (sizeof(rtr_msgb_t) + sizeof(RsslQueueLink)) )
 		return(-1);
 
-	memory = malloc(bytesNeeded);
+	memory = rtr_dfltcMemAlloc(pool, bytesNeeded);
 	if (memory)
 	{
 		/* the mblock list is a queue header followed by an rtr_msgb_t structure, then the memory for the block
@@ -297,6 +416,12 @@ static rtr_msgb_t *rtr_dfltcIntAllocMsg(rtr_dfltcbufferpool_t* rtr_dfltcpool, si
 		/* Check to see if there is a free data segment */
 		if ((dblk = rtr_dfltcpool->curDblk) == 0)
 		{
+			/* shared data blocks referred to count against the same limits as the pool's own */
+			if (rtr_dfltcpool->numSharedRefs &&
+				(rtr_dfltcpool->numRegBufsUsed + rtr_dfltcpool->numPoolBufs + rtr_dfltcpool->numSharedRefs >
+					rtr_dfltcpool->bufpool.maxBufs + rtr_dfltcpool->maxPoolBufs))
+				return(0);
+
 			pLink = rsslQueueRemoveFirstLink(&(rtr_dfltcpool->freeList));
 			
 			if (pLink != 0)
@@ -325,7 +450,7 @@ static rtr_msgb_t *rtr_dfltcIntAllocMsg(rtr_dfltcbufferpool_t* rtr_dfltcpool, si
 				(rtr_dfltcpool->numPoolBufs < rtr_dfltcpool->maxPoolBufs ))
 			{
 				/* Pull from the shared pool, if present. */
-				mblk = rtrBufferAllocMax(rtr_dfltcpool->sharedPool);
+				mblk = rtr_dfltcGetSharedMblk(rtr_dfltcpool);
 				if (mblk)
 				{
 					rsslQueueAddLinkToBack(&(rtr_dfltcpool->sharedPoolMblks),&(mblk->link));
@@ -388,8 +513,8 @@ static rtr_msgb_t *rtr_dfltcIntAllocMsg(rtr_dfltcbufferpool_t* rtr_dfltcpool, si
 			if (rtr_dfltcpool->numRegBufsUsed == 0)
 			{
 				rtr_dfltcpool->numRegBufsUsed++;
-				if (rtr_dfltcpool->numRegBufsUsed > rtr_dfltcpool->peakNumBufsUsed)
-					rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcpool->numRegBufsUsed;
+				if (rtr_dfltcNumBufsUsed(rtr_dfltcpool) > rtr_dfltcpool->peakNumBufsUsed)
+					rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
 			}
 
 		}
@@ -401,8 +526,8 @@ static rtr_msgb_t *rtr_dfltcIntAllocMsg(rtr_dfltcbufferpool_t* rtr_dfltcpool, si
 			{
 				rsslQueueAddLinkToBack(&(rtr_dfltcpool->usedList),&(dblk->link));
 				rtr_dfltcpool->numRegBufsUsed++;
-				if (rtr_dfltcpool->numRegBufsUsed > rtr_dfltcpool->peakNumBufsUsed)
-					rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcpool->numRegBufsUsed;
+				if (rtr_dfltcNumBufsUsed(rtr_dfltcpool) > rtr_dfltcpool->peakNumBufsUsed)
+					rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
 			}
 			rtr_dfltcpool->curDblk = 0;
 		}
@@ -419,7 +544,13 @@ static int rtr_dfltcIntFreeMsg(rtr_dfltcbufferpool_t *rtr_dfltcpool,rtr_msgb_t *
 	{
 		dblk = mblk->datab;
 		nmblk = mblk->nextMsg;
-		if (dblk)
+		if (dblk && (dblk->flags & rtr_dfltcDatabShared))
+		{
+			rtr_dfltcReleaseSharedDatab(dblk);
+			rtr_dfltcpool->numSharedRefs--;
+			mblk->datab = 0;
+		}
+		else if (dblk)
 		{
 			dblk->numRefs--;
 
@@ -451,7 +582,7 @@ static int rtr_dfltcIntFreeMsg(rtr_dfltcbufferpool_t *rtr_dfltcpool,rtr_msgb_t *
 					rtr_msgb_t *shmblk = (rtr_msgb_t*)dblk->internal;
 					rsslQueueRemoveLink(&(rtr_dfltcpool->sharedPoolMblks),&(shmblk->link));
 					rtr_dfltcpool->numPoolBufs--;
-					rtrBufferFree(shmblk->pool,shmblk);
+					rtr_dfltcPutSharedMblk(rtr_dfltcpool,shmblk);
 					mblk->datab = 0;
 
 						/* If this is the current data block being
@@ -525,17 +656,13 @@ rtr_msgb_t *rtr_dfltcAllocMsg(rtr_bufferpool_t *pool, size_t size)
 	return(mblk);
 }
 /* This function pulls messages from the shared pool.  */
-rtr_msgb_t *rtr_dfltcAllocMaxMsg(rtr_bufferpool_t *pool)
+static rtr_msgb_t *rtr_dfltcIntAllocMaxMsg(rtr_dfltcbufferpool_t *rtr_dfltcpool)
 {
-	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
 	rtr_msgb_t			*mblk=0;
 	rtr_datab_t			*dblk=0;
 	int					attempt=0;
 	RsslQueueLink		*pLink = 0;
 
-	RTBUFFERPOOLLOCK(pool);
-	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
-
 	while (dblk == 0)
 	{
 		pLink = rsslQueueRemoveFirstLink(&(rtr_dfltcpool->freeList));
@@ -545,8 +672,8 @@ rtr_msgb_t *rtr_dfltcAllocMaxMsg(rtr_bufferpool_t *pool)
 				/* Put the data block in the used list. */
 			rsslQueueAddLinkToBack(&(rtr_dfltcpool->usedList),&(dblk->link));
 			rtr_dfltcpool->numRegBufsUsed++;
-			if (rtr_dfltcpool->numRegBufsUsed > rtr_dfltcpool->peakNumBufsUsed)
-				rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcpool->numRegBufsUsed;
+			if (rtr_dfltcNumBufsUsed(rtr_dfltcpool) > rtr_dfltcpool->peakNumBufsUsed)
+				rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
 
 #ifdef _DFLTC_BUFFER_DEBUG
 			rtr_dfltcpool->numFreeDblks--;
@@ -568,7 +695,7 @@ rtr_msgb_t *rtr_dfltcAllocMaxMsg(rtr_bufferpool_t *pool)
 		else if ((rtr_dfltcpool->sharedPool) &&
 			(rtr_dfltcpool->numPoolBufs < rtr_dfltcpool->maxPoolBufs ))
 		{
-			mblk = rtrBufferAllocMax(rtr_dfltcpool->sharedPool);
+			mblk = rtr_dfltcGetSharedMblk(rtr_dfltcpool);
 			if (mblk)
 			{
 				rsslQueueAddLinkToBack(&(rtr_dfltcpool->sharedPoolMblks),&(mblk->link));
@@ -578,16 +705,10 @@ rtr_msgb_t *rtr_dfltcAllocMaxMsg(rtr_bufferpool_t *pool)
 				mblk = 0;
 			}
 			else
-			{
-				RTBUFFERPOOLUNLOCK(pool);
 				return(0);
-			}
 		}
 		else
-		{
-			RTBUFFERPOOLUNLOCK(pool);
 			return(0);
-		}
 	}
 
 	if ((pLink = rsslQueueRemoveLastLink(&(rtr_dfltcpool->freeMsgList))) == 0)
@@ -599,8 +720,7 @@ rtr_msgb_t *rtr_dfltcAllocMaxMsg(rtr_bufferpool_t *pool)
 			rtr_msgb_t *shmblk = (rtr_msgb_t*)dblk->internal;
 			rsslQueueRemoveLink(&(rtr_dfltcpool->sharedPoolMblks),&(shmblk->link));
 			rtr_dfltcpool->numPoolBufs--;
-			rtrBufferFree(shmblk->pool,shmblk);
-			RTBUFFERPOOLUNLOCK(pool);
+			rtr_dfltcPutSharedMblk(rtr_dfltcpool,shmblk);
 			return(0);
 		}
 	}
@@ -620,10 +740,78 @@ rtr_msgb_t *rtr_dfltcAllocMaxMsg(rtr_bufferpool_t *pool)
 	rtr_dfltcpool->numFreeMblks--;
 	rtr_dfltcpool->numUsedMblks++;
 #endif
+	return(mblk);
+}
+
+rtr_msgb_t *rtr_dfltcAllocMaxMsg(rtr_bufferpool_t *pool)
+{
+	rtr_msgb_t			*mblk;
+
+	RTBUFFERPOOLLOCK(pool);
+	mblk = rtr_dfltcIntAllocMaxMsg((rtr_dfltcbufferpool_t*)pool->internal);
 	RTBUFFERPOOLUNLOCK(pool);
 	return(mblk);
 }
 
+/* Pulls max sized messages under a single lock, for a pool caching buffers from this one.
+ * Returns one message for immediate use, and adds up to count - 1 more to the back of 'list' while
+ * the buffers held in caches stay within maxCachedBufs. */
+rtr_msgb_t *rtr_dfltcAllocMaxMsgs(rtr_bufferpool_t *pool, RsslQueue *list, int count)
+{
+	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
+	rtr_msgb_t			*mblk;
+	rtr_msgb_t			*cachedmblk;
+	int					numAlloc;
+
+	RTBUFFERPOOLLOCK(pool);
+	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
+
+	/* Account for buffers taken out of caches since the pool was last locked. */
+	if (rtr_dfltcNumBufsUsed(rtr_dfltcpool) > rtr_dfltcpool->peakNumBufsUsed)
+		rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
+
+	if ((mblk = rtr_dfltcIntAllocMaxMsg(rtr_dfltcpool)) != 0)
+	{
+		for (numAlloc = 1; numAlloc < count && rtr_dfltcpool->numCachedBufs < rtr_dfltcpool->maxCachedBufs; numAlloc++)
+		{
+			/* Count the buffer as cached before it is allocated so it is not counted in the peak. */
+			RTR_ATOMIC_INCREMENT(rtr_dfltcpool->numCachedBufs);
+			if ((cachedmblk = rtr_dfltcIntAllocMaxMsg(rtr_dfltcpool)) == 0)
+			{
+				RTR_ATOMIC_DECREMENT(rtr_dfltcpool->numCachedBufs);
+				break;
+			}
+			rsslQueueAddLinkToBack(list,&(cachedmblk->link));
+		}
+	}
+	RTBUFFERPOOLUNLOCK(pool);
+	return(mblk);
+}
+
+/* Returns a list of cached messages under a single lock. */
+int rtr_dfltcFreeCachedMsgs(rtr_bufferpool_t *pool, RsslQueue *list)
+{
+	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
+	RsslQueueLink		*pLink;
+	int					numFreed=0;
+
+	RTBUFFERPOOLLOCK(pool);
+	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
+
+	/* Account for buffers taken out of caches since the pool was last locked. */
+	if (rtr_dfltcNumBufsUsed(rtr_dfltcpool) > rtr_dfltcpool->peakNumBufsUsed)
+		rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
+
+	while ((pLink = rsslQueueRemoveFirstLink(list)) != 0)
+	{
+		rtr_dfltcIntFreeMsg(rtr_dfltcpool,RSSL_QUEUE_LINK_TO_OBJECT(rtr_msgb_t, link, pLink));
+		numFreed++;
+	}
+	RTR_ATOMIC_ADD(rtr_dfltcpool->numCachedBufs, -numFreed);
+	RTBUFFERPOOLUNLOCK(pool);
+	return(numFreed);
+}
+
 int rtr_dfltcSetUsed(rtr_bufferpool_t *pool, rtr_msgb_t *curmblk)
 {
 	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
@@ -753,6 +941,95 @@ int rtr_dfltcFreeMsg(rtr_msgb_t *mblk)
 	return(retval);
 }
 
+/* A shared data block with its atomic reference count.  The data follows
+ * the structure, with a spare byte after it so that the end of the data is
+ * never the start of some other allocation; ripc merges queued buffers
+ * that are contiguous. */
+typedef struct {
+	rtr_datab_t		dblk;
+	rtr_atomic_val	numRefs;
+} rtr_dfltcSharedDatab;
+
+rtr_datab_t *rtr_dfltcAllocSharedDatab(size_t size)
+{
+	rtr_dfltcSharedDatab	*shdblk;
+
+	if ((shdblk = (rtr_dfltcSharedDatab*)malloc(sizeof(rtr_dfltcSharedDatab) + size + 1)) == 0)
+		return(0);
+
+	rsslInitQueueLink(&(shdblk->dblk.link));
+	shdblk->dblk.pool = 0;
+	shdblk->dblk.base = (caddr_t)(shdblk + 1);
+	shdblk->dblk.length = size;
+	shdblk->dblk.numRefs = 0;
+	shdblk->dblk.flags = rtr_dfltcDatabShared;
+	shdblk->dblk.pad = 0;
+	shdblk->dblk.internal = 0;
+	shdblk->numRefs = 1;
+
+	return(&(shdblk->dblk));
+}
+
+rtr_msgb_t *rtr_dfltcRefSharedDatab(rtr_bufferpool_t *pool, rtr_datab_t *dblk, size_t length)
+{
+	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
+	rtr_msgb_t			*mblk;
+
+	RTBUFFERPOOLLOCK(pool);
+	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
+
+	/* the reference is a buffer used, as a copy of the message would have been */
+	if (rtr_dfltcpool->numRegBufsUsed + rtr_dfltcpool->numPoolBufs + rtr_dfltcpool->numSharedRefs >=
+		pool->maxBufs + rtr_dfltcpool->maxPoolBufs)
+	{
+		RTBUFFERPOOLUNLOCK(pool);
+		return(0);
+	}
+
+	mblk = getFreeMblk(rtr_dfltcpool);
+	if (mblk)
+	{
+		rtr_dfltcpool->numSharedRefs++;
+		if (rtr_dfltcNumBufsUsed(rtr_dfltcpool) + rtr_dfltcpool->numSharedRefs > rtr_dfltcpool->peakNumBufsUsed)
+			rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool) + rtr_dfltcpool->numSharedRefs;
+#ifdef _DFLTC_BUFFER_DEBUG
+		rtr_dfltcpool->numFreeMblks--;
+		rtr_dfltcpool->numUsedMblks++;
+#endif
+	}
+	RTBUFFERPOOLUNLOCK(pool);
+
+	if (mblk == 0)
+		return(0);
+
+	RTR_ATOMIC_INCREMENT(((rtr_dfltcSharedDatab*)dblk)->numRefs);
+
+	mblk->nextMsg = 0;
+	mblk->buffer = dblk->base;
+	mblk->length = length;
+	mblk->maxLength = length;
+	mblk->datab = dblk;
+	mblk->protocol = 0;
+	mblk->fragOffset = 0;
+	mblk->priority = 0;
+	return(mblk);
+}
+
+void rtr_dfltcReleaseSharedDatab(rtr_datab_t *dblk)
+{
+	rtr_dfltcSharedDatab	*shdblk = (rtr_dfltcSharedDatab*)dblk;
+	rtr_atomic_val			numRefs;
+
+	/* compare and swap, so that exactly one releaser sees the last reference go */
+	do
+	{
+		numRefs = shdblk->numRefs;
+	} while (RTR_ATOMIC_COMPARE_AND_SWAP(shdblk->numRefs, numRefs, numRefs - 1) != numRefs);
+
+	if (numRefs == 1)
+		free(shdblk);
+}
+
 int rtr_dfltcSetMaxBufs(rtr_bufferpool_t *pool, int newValue )
 {
 	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
@@ -778,6 +1055,7 @@ int rtr_dfltcSetMaxBufs(rtr_bufferpool_t *pool, int newValue )
 		}
 		pool->maxBufs = newValue;
 	}
+	RTR_ATOMIC_SET(rtr_dfltcpool->maxCachedBufs, pool->maxBufs / RTR_DFLTC_CACHED_BUFS_DIVISOR);
 	RTBUFFERPOOLUNLOCK(pool);
 	return(retval);
 }
@@ -790,7 +1068,29 @@ int rtr_dfltcSetMaxSharedBufs(rtr_bufferpool_t *pool, int newValue )
 	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
 
 	if (newValue >= 0)
+	{
 		rtr_dfltcpool->maxPoolBufs = newValue;
+		rtr_dfltcDrainSharedPoolCache(rtr_dfltcpool, (newValue - rtr_dfltcpool->numPoolBufs));
+	}
+
+	RTBUFFERPOOLUNLOCK(pool);
+
+	return(1);
+}
+
+int rtr_dfltcSetSharedPoolCacheSize(rtr_bufferpool_t *pool, int newValue )
+{
+	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
+
+	if (newValue < 0)
+		return(-1);
+
+	RTBUFFERPOOLLOCK(pool);
+	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
+
+	rtr_dfltcpool->sharedPoolCacheSize = newValue;
+	if (rtr_dfltcpool->sharedPool)
+		rtr_dfltcDrainSharedPoolCache(rtr_dfltcpool, newValue);
 
 	RTBUFFERPOOLUNLOCK(pool);
 
@@ -805,13 +1105,32 @@ int rtr_dfltcResetPeakNumBufs(rtr_bufferpool_t *pool)
 
 	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
 
-	rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcpool->numRegBufsUsed;
+	rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
 
 	RTBUFFERPOOLUNLOCK(pool);
 
 	return(1);
 }
 
+int rtr_dfltcGetPeakNumBufs(rtr_bufferpool_t *pool)
+{
+	rtr_dfltcbufferpool_t	*rtr_dfltcpool;
+	int						peak;
+
+	RTBUFFERPOOLLOCK(pool);
+
+	rtr_dfltcpool = (rtr_dfltcbufferpool_t*)pool->internal;
+
+	/* Account for buffers taken out of caches since the pool was last locked. */
+	if (rtr_dfltcNumBufsUsed(rtr_dfltcpool) > rtr_dfltcpool->peakNumBufsUsed)
+		rtr_dfltcpool->peakNumBufsUsed = rtr_dfltcNumBufsUsed(rtr_dfltcpool);
+	peak = rtr_dfltcpool->peakNumBufsUsed;
+
+	RTBUFFERPOOLUNLOCK(pool);
+
+	return(peak);
+}
+
 int rtr_countFreeList(rtr_bufferpool_t *pool)
 {
 	rtr_dfltcbufferpool_t	*rtr_dfltcpool=(rtr_dfltcbufferpool_t*)pool->internal;
@@ -928,6 +1247,10 @@ rtr_dfltcbufferpool_t *rtr_dfltcAllocPool(	int init_bufs, int max_bufs,int incre
 		rsslInitQueue(&(retpool->freeMsgList));
 		rsslInitQueue(&(retpool->allocatedMblks));
 		rsslInitQueue(&(retpool->sharedPoolMblks));
+		rsslInitQueue(&(retpool->sharedPoolCache));
+		retpool->sharedPoolCacheSize = 0;
+		retpool->numCachedBufs = 0;
+		retpool->maxCachedBufs = max_bufs / RTR_DFLTC_CACHED_BUFS_DIVISOR;
 		retpool->nextChar = 0;
 		retpool->curDblk = 0;
 #ifdef _DFLTC_BUFFER_DEBUG
@@ -937,11 +1260,13 @@ rtr_dfltcbufferpool_t *rtr_dfltcAllocPool(	int init_bufs, int max_bufs,int incre
 		retpool->numUsedMblks = 0;
 #endif
 		retpool->sharedPool = sharedPool;
+		retpool->pageArena = 0;
 		retpool->maxPoolBufs = maxPoolBufs;
 		retpool->increaseBufRate = increase_bufs;
 		retpool->numPoolBufs = 0;
 		retpool->numRegBufsUsed = 0;
 		retpool->peakNumBufsUsed =0;
+		retpool->numSharedRefs = 0;
 		retpool->bufpool.maxBufs = max_bufs;
 		retpool->bufpool.numBufs = init_bufs;
 		retpool->bufpool.numRefs = 1;
@@ -966,6 +1291,23 @@ rtr_dfltcbufferpool_t *rtr_dfltcAllocPool(	int init_bufs, int max_bufs,int incre
 	return(retpool);
 }
 
+int rtr_dfltcSetPageArena( rtr_dfltcbufferpool_t *pool, RsslPageArena *arena )
+{
+	int	retval=0;
+
+	RTBUFFERPOOLLOCK(&(pool->bufpool));
+
+	/* only before any blocks are allocated, since they are freed to where they came from */
+	if (pool->bufpool.initialized || pool->allocatedMblks.count)
+		retval = -1;
+	else
+		pool->pageArena = arena;
+
+	RTBUFFERPOOLUNLOCK(&(pool->bufpool));
+
+	return(retval);
+}
+
 int rtr_dfltcSetBufSize( rtr_dfltcbufferpool_t *pool, size_t bufSize )
 {
 	int	retval=0;
@@ -15,12 +15,18 @@ enum {
 	rtr_smplcFreeMblk = 0x01
 } rtr_smplcMsgbFlags;
 
-rtr_msgb_t *rtr_smplcIntAllocD(rtr_bufferpool_t *pool, size_t size)
+enum {
+	rtr_smplcDatabArena = 0x01	/* Allocated from a page arena */
+} rtr_smplcDatabFlags;
+
+rtr_msgb_t *rtr_smplcIntAllocD(rtr_bufferpool_t *pool, size_t size, RsslPageArena *arena)
 {
 	void		*memory;
 	rtr_msgb_t	*mblk=0;
 	rtr_datab_t	*dblk;
-	memory = malloc(sizeof(rtr_datab_t) + sizeof(rtr_msgb_t) + rtr_cbufferCppOverhead + size);
+	size_t		bytesNeeded = sizeof(rtr_datab_t) + sizeof(rtr_msgb_t) + rtr_cbufferCppOverhead + size;
+
+	memory = arena ? rsslPageArenaAlloc(arena, bytesNeeded) : malloc(bytesNeeded);
 	if (memory)
 	{
 		dblk = (rtr_datab_t*)memory;
@@ -30,7 +36,7 @@ rtr_msgb_t *rtr_smplcIntAllocD(rtr_bufferpool_t *pool, size_t size)
 		dblk->length = size;
 		dblk->pool = pool;
 		dblk->numRefs = 1;
-		dblk->flags = 0;
+		dblk->flags = arena ? rtr_smplcDatabArena : 0;
 		dblk->pad = 0;
 		dblk->internal = 0;
 
@@ -99,7 +105,16 @@ rtr_msgb_t *rtr_smplcAllocMsg(rtr_bufferpool_t *pool, size_t size)
 	rtr_msgb_t	*mblk;
 	if ((pool == 0) || (pool->internal == 0))
 		return(0);
-	mblk=rtr_smplcIntAllocD(pool,size);
+	mblk=rtr_smplcIntAllocD(pool,size,0);
+	return(mblk);
+}
+
+rtr_msgb_t *rtr_smplcAllocArenaMsg(rtr_bufferpool_t *pool, size_t size, RsslPageArena *arena)
+{
+	rtr_msgb_t	*mblk;
+	if ((pool == 0) || (pool->internal == 0))
+		return(0);
+	mblk=rtr_smplcIntAllocD(pool,size,arena);
 	return(mblk);
 }
 
@@ -121,7 +136,10 @@ int rtr_smplcFreeMsg(rtr_msgb_t *mblk)
 
 	if (mblk->datab->numRefs <= 0)
 	{
-		free(mblk->datab);
+		if (mblk->datab->flags & rtr_smplcDatabArena)
+			rsslPageArenaFree(mblk->datab);
+		else
+			free(mblk->datab);
 	}
 
 	if (doFree)
@@ -170,7 +188,7 @@ rtr_msgb_t *rtr_smplcCopyMsg(rtr_bufferpool_t *pool, rtr_msgb_t *curmblk)
 	if ((pool == 0) || (curmblk == 0) || (pool->internal == 0))
 		return(0);
 
-	if ((mblk = rtr_smplcIntAllocD(pool,curmblk->maxLength)) == 0)
+	if ((mblk = rtr_smplcIntAllocD(pool,curmblk->maxLength,0)) == 0)
 		return(0);
 
 	mblk->nextMsg = 0;
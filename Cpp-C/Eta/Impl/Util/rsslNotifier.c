@@ -10,12 +10,14 @@
 #include <stdlib.h>
 
 /* On windows, select is used for notification.
- * Otherwise poll is used. */
+ * Otherwise poll is used, unless epoll is available and requested. */
 #if defined(WIN32)
 #define FD_SETSIZE 6400
 #include <winsock2.h>
 #else
 #include <poll.h>
+#include <errno.h>
+#include <unistd.h>
 #endif
 
 typedef struct
@@ -26,11 +28,17 @@ typedef struct
 	void *_object;
 
 #ifndef WIN32
-	int _pollFdIndex; /* Array index of the pollfd associated with this event */
+	int _pollFdIndex; /* Array index of this event, and of the pollfd associated with it when polling. */
 #else
 	SOCKET _fd;
 #endif
 
+#ifdef RSSL_NOTIFIER_EPOLL
+	RsslSocket _epollFd; /* Descriptor registered for this event */
+	unsigned int _epollEvents; /* epoll events registered for this event */
+	int _epollBadFd; /* Descriptor was found closed; report RSSL_NESF_BAD_FD on the next wait */
+#endif
+
 } RsslNotifierEventImpl;
 
 typedef struct
@@ -45,9 +53,71 @@ typedef struct
 	fd_set _readFds; /* Read fd_set */
 	fd_set _writeFds; /* Write fd_set */
 	fd_set _exceptFds; /* Except fd_set */
+#endif
+	RsslNotifierType _type; /* Notification mechanism in use */
+#ifdef RSSL_NOTIFIER_EPOLL
+	int _epollFd; /* epoll instance, when _type is RSSL_NOTIFIER_TYPE_EPOLL or RSSL_NOTIFIER_TYPE_EPOLL_EDGE */
+	struct epoll_event *_epollReadyEvents; /* Output array for epoll_wait */
+	int _epollBadFdCount; /* Number of events with _epollBadFd set */
 #endif
 } RsslNotifierImpl;
 
+#ifdef RSSL_NOTIFIER_EPOLL
+#define RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl) ((pNotifierImpl)->_type >= RSSL_NOTIFIER_TYPE_EPOLL)
+
+/* Applies the event's current interest set to the epoll instance.
+ * If the descriptor turns out to have been closed, the event is marked so that RSSL_NESF_BAD_FD is reported on the next wait. */
+static int _notifierEpollUpdate(RsslNotifierImpl *pNotifierImpl, RsslNotifierEventImpl *pNotifierEventImpl, int op)
+{
+	struct epoll_event epollEvent;
+
+	epollEvent.events = pNotifierEventImpl->_epollEvents;
+	if (pNotifierImpl->_type == RSSL_NOTIFIER_TYPE_EPOLL_EDGE)
+		epollEvent.events |= EPOLLET;
+	epollEvent.data.ptr = pNotifierEventImpl;
+
+	if (epoll_ctl(pNotifierImpl->_epollFd, op, pNotifierEventImpl->_epollFd, &epollEvent) == 0)
+		return 0;
+
+	switch(errno)
+	{
+		case EEXIST:
+			/* Descriptor already belongs to another event on this notifier. epoll keeps one registration per descriptor,
+			 * so taking it over would silently stop notification of the other event. */
+			return -1;
+
+		case EBADF:
+		case ENOENT:
+			/* Closing a descriptor removes it from the epoll set, so this event no longer has a valid registration. */
+			if (!pNotifierEventImpl->_epollBadFd)
+			{
+				pNotifierEventImpl->_epollBadFd = 1;
+				++pNotifierImpl->_epollBadFdCount;
+			}
+			return 0;
+
+		default:
+			return -1;
+	}
+}
+
+/* Removes an event from the list of notified events, so that it is not referenced after it is removed from the notifier. */
+static void _notifierEpollRemoveNotified(RsslNotifierImpl *pNotifierImpl, RsslNotifierEventImpl *pNotifierEventImpl)
+{
+	int i;
+
+	for (i = 0; i < pNotifierImpl->base.notifiedEventCount; ++i)
+	{
+		if (pNotifierImpl->base.notifiedEvents[i] == &pNotifierEventImpl->base)
+		{
+			pNotifierImpl->base.notifiedEvents[i] = pNotifierImpl->base.notifiedEvents[pNotifierImpl->base.notifiedEventCount - 1];
+			--pNotifierImpl->base.notifiedEventCount;
+			break;
+		}
+	}
+}
+#endif
+
 RSSL_API RsslNotifierEvent *rsslCreateNotifierEvent()
 {
 	return (RsslNotifierEvent*)calloc(sizeof(RsslNotifierEventImpl), 1);
@@ -66,10 +136,31 @@ RSSL_API void *rsslNotifierEventGetObject(RsslNotifierEvent *pEvent)
 
 
 RSSL_API RsslNotifier *rsslCreateNotifier(int maxEventsHint)
+{
+	return rsslCreateNotifierEx(maxEventsHint, RSSL_NOTIFIER_TYPE_DEFAULT);
+}
+
+RSSL_API RsslNotifier *rsslCreateNotifierEx(int maxEventsHint, RsslNotifierType notifierType)
 {
 	RsslNotifierImpl *pNotifierImpl = (RsslNotifierImpl*)malloc(sizeof(RsslNotifierImpl));
+	if (pNotifierImpl == NULL)
+		return NULL;
 	memset(pNotifierImpl, 0, sizeof(RsslNotifierImpl));
 
+	if (maxEventsHint < 1)
+		maxEventsHint = 1;
+
+	pNotifierImpl->_type = RSSL_NOTIFIER_TYPE_POLL;
+#ifdef RSSL_NOTIFIER_EPOLL
+	pNotifierImpl->_epollFd = -1;
+	if (notifierType == RSSL_NOTIFIER_TYPE_EPOLL || notifierType == RSSL_NOTIFIER_TYPE_EPOLL_EDGE)
+	{
+		/* Fall back to poll if an epoll instance cannot be created. */
+		if ((pNotifierImpl->_epollFd = epoll_create(maxEventsHint)) >= 0)
+			pNotifierImpl->_type = notifierType;
+	}
+#endif
+
 	pNotifierImpl->_maxEvents = maxEventsHint;
 	pNotifierImpl->_events = (RsslNotifierEventImpl**)malloc(maxEventsHint * sizeof(RsslNotifierEventImpl**));
 	if (pNotifierImpl->_events == NULL)
@@ -94,9 +185,26 @@ RSSL_API RsslNotifier *rsslCreateNotifier(int maxEventsHint)
 	}
 #endif
 
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		pNotifierImpl->_epollReadyEvents = (struct epoll_event*)malloc(maxEventsHint * sizeof(struct epoll_event));
+		if (pNotifierImpl->_epollReadyEvents == NULL)
+		{
+			rsslDestroyNotifier(&pNotifierImpl->base);
+			return NULL;
+		}
+	}
+#endif
+
 	return &pNotifierImpl->base;
 }
 
+RSSL_API RsslNotifierType rsslNotifierGetType(RsslNotifier *pNotifier)
+{
+	return ((RsslNotifierImpl*)pNotifier)->_type;
+}
+
 RSSL_API void rsslDestroyNotifier(RsslNotifier *pNotifier)
 {
 	RsslNotifierImpl *pNotifierImpl = (RsslNotifierImpl*)pNotifier;
@@ -111,6 +219,14 @@ RSSL_API void rsslDestroyNotifier(RsslNotifier *pNotifier)
 	pNotifierImpl->_pollFds = NULL;
 #endif
 
+#ifdef RSSL_NOTIFIER_EPOLL
+	free(pNotifierImpl->_epollReadyEvents);
+	pNotifierImpl->_epollReadyEvents = NULL;
+
+	if (pNotifierImpl->_epollFd >= 0)
+		close(pNotifierImpl->_epollFd);
+#endif
+
 	free(pNotifierImpl);
 }
 
@@ -147,6 +263,16 @@ RSSL_API int rsslNotifierAddEvent(RsslNotifier *pNotifier, RsslNotifierEvent *pE
 			return -1;
 #endif
 
+#ifdef RSSL_NOTIFIER_EPOLL
+		if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+		{
+			struct epoll_event *epollReadyEvents = (struct epoll_event*)realloc(pNotifierImpl->_epollReadyEvents, pNotifierImpl->_maxEvents * 2 * sizeof(struct epoll_event));
+			if (epollReadyEvents == NULL)
+				return -1;
+			pNotifierImpl->_epollReadyEvents = epollReadyEvents;
+		}
+#endif
+
 		pNotifierImpl->_maxEvents *= 2;
 		pNotifierImpl->_events = events;
 		pNotifierImpl->base.notifiedEvents = notifiedEvents;
@@ -155,6 +281,18 @@ RSSL_API int rsslNotifierAddEvent(RsslNotifier *pNotifier, RsslNotifierEvent *pE
 #endif
 	}
 
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		pNotifierEventImpl->_epollFd = fd;
+		pNotifierEventImpl->_epollEvents = 0;
+		pNotifierEventImpl->_epollBadFd = 0;
+		pNotifierEventImpl->base.notifiedFlags = 0;
+		if (_notifierEpollUpdate(pNotifierImpl, pNotifierEventImpl, EPOLL_CTL_ADD) < 0)
+			return -1;
+	}
+#endif
+
 #ifndef WIN32
 	memset(&pNotifierImpl->_pollFds[pNotifierImpl->_eventCount], 0, sizeof(struct pollfd));
 	pNotifierImpl->_pollFds[pNotifierImpl->_eventCount].fd = fd;
@@ -178,6 +316,26 @@ RSSL_API int rsslNotifierUpdateEventFd(RsslNotifier *pNotifier, RsslNotifierEven
 
 	pNotifierEventImpl->_registeredFlags = 0;
 
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		i = pNotifierEventImpl->_pollFdIndex;
+		if (i < 0 || i >= pNotifierImpl->_eventCount || pNotifierImpl->_events[i] != pNotifierEventImpl)
+			return -1; /* Not found. */
+
+		/* The previous descriptor was closed, which already removed it from the epoll set.
+		 * Remove it anyway in case it is still open elsewhere, then register the new descriptor with the same interest set. */
+		epoll_ctl(pNotifierImpl->_epollFd, EPOLL_CTL_DEL, pNotifierEventImpl->_epollFd, NULL);
+		if (pNotifierEventImpl->_epollBadFd)
+		{
+			pNotifierEventImpl->_epollBadFd = 0;
+			--pNotifierImpl->_epollBadFdCount;
+		}
+		pNotifierEventImpl->_epollFd = fd;
+		return _notifierEpollUpdate(pNotifierImpl, pNotifierEventImpl, EPOLL_CTL_ADD);
+	}
+#endif
+
 	for (i = 0; i < pNotifierImpl->_eventCount; ++i)
 	{
 		if (pNotifierImpl->_events[i] == pNotifierEventImpl)
@@ -204,6 +362,33 @@ RSSL_API int rsslNotifierRemoveEvent(RsslNotifier *pNotifier, RsslNotifierEvent
 
 	pNotifierEventImpl->_registeredFlags = 0;
 
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		i = pNotifierEventImpl->_pollFdIndex;
+		if (i < 0 || i >= pNotifierImpl->_eventCount || pNotifierImpl->_events[i] != pNotifierEventImpl)
+			return 0;
+
+		/* Descriptor may already be closed, in which case it is no longer in the epoll set. */
+		epoll_ctl(pNotifierImpl->_epollFd, EPOLL_CTL_DEL, pNotifierEventImpl->_epollFd, NULL);
+		if (pNotifierEventImpl->_epollBadFd)
+		{
+			pNotifierEventImpl->_epollBadFd = 0;
+			--pNotifierImpl->_epollBadFdCount;
+		}
+		pNotifierEventImpl->_epollEvents = 0;
+		_notifierEpollRemoveNotified(pNotifierImpl, pNotifierEventImpl);
+		pNotifierEventImpl->base.notifiedFlags = 0;
+
+		/* Swap in last event */
+		pNotifierImpl->_events[i] = pNotifierImpl->_events[pNotifierImpl->_eventCount - 1];
+		pNotifierImpl->_events[i]->_pollFdIndex = i;
+		pNotifierEventImpl->_pollFdIndex = -1;
+		--pNotifierImpl->_eventCount;
+		return 0;
+	}
+#endif
+
 	for (i = 0; i < pNotifierImpl->_eventCount; ++i)
 	{
 		if (pNotifierImpl->_events[i] == pNotifierEventImpl)
@@ -233,6 +418,13 @@ RSSL_API int rsslNotifierRegisterRead(RsslNotifier *pNotifier, RsslNotifierEvent
 	RsslNotifierImpl *pNotifierImpl = (RsslNotifierImpl*)pNotifier;
 	RsslNotifierEventImpl *pNotifierEventImpl = (RsslNotifierEventImpl*)pEvent;
 	pNotifierEventImpl->_registeredFlags |= RSSL_NESF_READ;
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		pNotifierEventImpl->_epollEvents |= EPOLLIN | EPOLLPRI;
+		return _notifierEpollUpdate(pNotifierImpl, pNotifierEventImpl, EPOLL_CTL_MOD);
+	}
+#endif
 #ifndef WIN32
 	pNotifierImpl->_pollFds[pNotifierEventImpl->_pollFdIndex].events |= POLLIN | POLLPRI;
 #endif
@@ -244,6 +436,13 @@ RSSL_API int rsslNotifierUnregisterRead(RsslNotifier *pNotifier, RsslNotifierEve
 	RsslNotifierImpl *pNotifierImpl = (RsslNotifierImpl*)pNotifier;
 	RsslNotifierEventImpl *pNotifierEventImpl = (RsslNotifierEventImpl*)pEvent;
 	pNotifierEventImpl->_registeredFlags &= ~RSSL_NESF_READ;
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		pNotifierEventImpl->_epollEvents &= ~(EPOLLIN | EPOLLPRI);
+		return _notifierEpollUpdate(pNotifierImpl, pNotifierEventImpl, EPOLL_CTL_MOD);
+	}
+#endif
 #ifndef WIN32
 	pNotifierImpl->_pollFds[pNotifierEventImpl->_pollFdIndex].events &= ~(POLLIN | POLLPRI);
 #endif
@@ -256,6 +455,13 @@ RSSL_API int rsslNotifierRegisterWrite(RsslNotifier *pNotifier, RsslNotifierEven
 	RsslNotifierImpl *pNotifierImpl = (RsslNotifierImpl*)pNotifier;
 	RsslNotifierEventImpl *pNotifierEventImpl = (RsslNotifierEventImpl*)pEvent;
 	pNotifierEventImpl->_registeredFlags |= RSSL_NESF_WRITE;
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		pNotifierEventImpl->_epollEvents |= EPOLLOUT;
+		return _notifierEpollUpdate(pNotifierImpl, pNotifierEventImpl, EPOLL_CTL_MOD);
+	}
+#endif
 #ifndef WIN32
 	pNotifierImpl->_pollFds[pNotifierEventImpl->_pollFdIndex].events |= POLLOUT;
 #endif
@@ -267,6 +473,13 @@ RSSL_API int rsslNotifierUnregisterWrite(RsslNotifier *pNotifier, RsslNotifierEv
 	RsslNotifierImpl *pNotifierImpl = (RsslNotifierImpl*)pNotifier;
 	RsslNotifierEventImpl *pNotifierEventImpl = (RsslNotifierEventImpl*)pEvent;
 	pNotifierEventImpl->_registeredFlags &= ~RSSL_NESF_WRITE;
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		pNotifierEventImpl->_epollEvents &= ~EPOLLOUT;
+		return _notifierEpollUpdate(pNotifierImpl, pNotifierEventImpl, EPOLL_CTL_MOD);
+	}
+#endif
 #ifndef WIN32
 	pNotifierImpl->_pollFds[pNotifierEventImpl->_pollFdIndex].events &= ~POLLOUT;
 #endif
@@ -279,6 +492,66 @@ RSSL_API int rsslNotifierWait(RsslNotifier *pNotifier, long timeoutUsec)
 	int i;
 	int ret;
 
+#ifdef RSSL_NOTIFIER_EPOLL
+	if (RSSL_NOTIFIER_IS_EPOLL(pNotifierImpl))
+	{
+		/* Only the events notified by the previous wait can have flags set, so only those need clearing. */
+		for (i = 0; i < pNotifierImpl->base.notifiedEventCount; ++i)
+			pNotifierImpl->base.notifiedEvents[i]->notifiedFlags = 0;
+		pNotifierImpl->base.notifiedEventCount = 0;
+
+		/* Don't block if there are closed descriptors to report. */
+		ret = epoll_wait(pNotifierImpl->_epollFd, pNotifierImpl->_epollReadyEvents, pNotifierImpl->_maxEvents, 
+				pNotifierImpl->_epollBadFdCount ? 0 : timeoutUsec/1000);
+		if (ret < 0)
+			return ret;
+
+		for (i = 0; i < ret; ++i)
+		{
+			RsslNotifierEventImpl *pNotifierEventImpl = (RsslNotifierEventImpl*)pNotifierImpl->_epollReadyEvents[i].data.ptr;
+			unsigned int revents = pNotifierImpl->_epollReadyEvents[i].events;
+
+			if (revents & (EPOLLIN | EPOLLPRI))
+				pNotifierEventImpl->base.notifiedFlags |= RSSL_NESF_READ;
+
+			if (revents & EPOLLOUT)
+				pNotifierEventImpl->base.notifiedFlags |= RSSL_NESF_WRITE;
+
+			/* Errors and hangups are always reported by epoll; let the registered operation discover them. */
+			if (revents & (EPOLLERR | EPOLLHUP))
+				pNotifierEventImpl->base.notifiedFlags |= (pNotifierEventImpl->_registeredFlags & (RSSL_NESF_READ | RSSL_NESF_WRITE));
+
+			if (pNotifierEventImpl->base.notifiedFlags)
+			{
+				pNotifierImpl->base.notifiedEvents[pNotifierImpl->base.notifiedEventCount] = &pNotifierEventImpl->base;
+				++pNotifierImpl->base.notifiedEventCount;
+			}
+		}
+
+		if (pNotifierImpl->_epollBadFdCount)
+		{
+			for (i = 0; i < pNotifierImpl->_eventCount; ++i)
+			{
+				RsslNotifierEventImpl *pNotifierEventImpl = pNotifierImpl->_events[i];
+
+				if (!pNotifierEventImpl->_epollBadFd)
+					continue;
+
+				pNotifierEventImpl->_epollBadFd = 0;
+				if (!pNotifierEventImpl->base.notifiedFlags)
+				{
+					pNotifierImpl->base.notifiedEvents[pNotifierImpl->base.notifiedEventCount] = &pNotifierEventImpl->base;
+					++pNotifierImpl->base.notifiedEventCount;
+				}
+				pNotifierEventImpl->base.notifiedFlags |= RSSL_NESF_BAD_FD;
+			}
+			pNotifierImpl->_epollBadFdCount = 0;
+		}
+
+		return pNotifierImpl->base.notifiedEventCount;
+	}
+#endif
+
 #ifndef WIN32
 	pNotifierImpl->base.notifiedEventCount = 0;
 	ret = poll(pNotifierImpl->_pollFds, pNotifierImpl->_eventCount, timeoutUsec/1000);
@@ -0,0 +1,475 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "rtr/rsslPageArena.h"
+#include "rtr/rsslThread.h"
+
+#if !defined(_WIN32) && !defined(MPOL_PREFERRED)
+#define MPOL_PREFERRED 1
+#endif
+
+/* Bytes in front of each allocation; keeps the memory given out aligned on 16 bytes */
+#define RSSL_PAGE_ARENA_HEADER		16
+
+/* Chunks are a power of two in size, from 64 bytes so that buffers do not share cache
+ * lines, up to a quarter of a region; larger allocations get a mapping of their own */
+#define RSSL_PAGE_ARENA_MIN_SHIFT	6
+#define RSSL_PAGE_ARENA_MAX_SHIFT	19
+#define RSSL_PAGE_ARENA_CLASSES		(RSSL_PAGE_ARENA_MAX_SHIFT - RSSL_PAGE_ARENA_MIN_SHIFT + 1)
+#define RSSL_PAGE_ARENA_MAX_CHUNK	((size_t)1 << RSSL_PAGE_ARENA_MAX_SHIFT)
+
+typedef struct RsslPageArenaMapping {
+	struct RsslPageArenaMapping	*next;
+	struct RsslPageArena		*arena;
+	char						*base;
+	size_t						size;
+	size_t						liveChunks;	/* allocated and not yet freed */
+	RsslBool					hugeTlb;
+	RsslBool					nodeBound;
+} RsslPageArenaMapping;
+
+typedef struct {
+	RsslPageArenaMapping	*mapping;	/* region, or mapping of its own, the chunk is in */
+	size_t					size;		/* bytes in the chunk, header included */
+} RsslPageArenaChunk;
+
+struct RsslPageArena {
+	RsslMutex				mutex;
+	int						node;
+	RsslPageArenaMapping	*mappings;
+	char					*freeChunks[RSSL_PAGE_ARENA_CLASSES];	/* linked through their first word after the header */
+	RsslPageArenaMapping	*current;		/* the region new chunks are carved from */
+	char					*nextChar;		/* its unused space */
+	char					*regionEnd;
+	RsslUInt64				regionBytes;
+	RsslUInt64				hugeTlbBytes;
+	RsslUInt64				nodeBoundBytes;
+	RsslUInt64				inUseBytes;
+};
+
+static RsslUInt32 arenaFlags = 0;
+static RsslBool arenaMutexInit = RSSL_FALSE;
+static RsslMutex arenaMutex;
+static RsslPageArena *arenas[RSSL_PAGE_ARENA_MAX_NODES];
+
+static int rsslPageArenaCurrentNode()
+{
+#if defined(_WIN32)
+	UCHAR node;
+
+	if (GetNumaProcessorNode((UCHAR)GetCurrentProcessorNumber(), &node))
+		return (int)node;
+	return 0;
+#elif defined(SYS_getcpu)
+	unsigned int cpu, node;
+
+	if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+		return (int)node;
+	return 0;
+#else
+	return 0;
+#endif
+}
+
+#if !defined(_WIN32)
+/* Sets the policy of a mapping to prefer the node, before its pages are touched; preferred
+ * rather than bound so that a full node falls back to another instead of failing.  Returns
+ * RSSL_FALSE if the policy could not be set, e.g. on a kernel without NUMA support, which
+ * leaves the pages wherever the system puts them. */
+static RsslBool rsslPageArenaBindNode(char *mem, size_t size, int node)
+{
+#if defined(SYS_mbind)
+	unsigned long nodeMask;
+
+	if (node < 0 || node >= (int)(sizeof(nodeMask) * 8))
+		return RSSL_FALSE;
+
+	nodeMask = 1UL << node;
+	return (syscall(SYS_mbind, mem, size, MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8 + 1, 0) == 0) ? RSSL_TRUE : RSSL_FALSE;
+#else
+	return RSSL_FALSE;
+#endif
+}
+#endif
+
+/* Maps size bytes, a multiple of the region size, aligned on a region so that transparent
+ * huge pages can back it, and prefers the arena's node for its pages */
+static char *rsslPageArenaMap(RsslPageArena *arena, size_t size, RsslBool *hugeTlb, RsslBool *nodeBound)
+{
+	char *mem = NULL;
+
+	*hugeTlb = RSSL_FALSE;
+	*nodeBound = RSSL_FALSE;
+
+#if defined(_WIN32)
+	{
+		DWORD node = (arenaFlags & RSSL_PAGE_ARENA_LOCAL_NODE) ? (DWORD)arena->node : NUMA_NO_PREFERRED_NODE;
+		SIZE_T largePage = GetLargePageMinimum();
+
+		/* needs SeLockMemoryPrivilege; fall back to normal pages without it */
+		if ((arenaFlags & RSSL_PAGE_ARENA_HUGE_PAGES) && largePage && (size % largePage) == 0)
+		{
+			if ((mem = (char*)VirtualAllocExNuma(GetCurrentProcess(), NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, node)) != NULL)
+				*hugeTlb = RSSL_TRUE;
+		}
+
+		if (mem == NULL)
+			mem = (char*)VirtualAllocExNuma(GetCurrentProcess(), NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+
+		if (mem != NULL && node != NUMA_NO_PREFERRED_NODE)
+			*nodeBound = RSSL_TRUE;
+	}
+#else
+	{
+		void *map = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+		/* succeeds only when huge pages have been reserved, e.g. through vm.nr_hugepages */
+		if (arenaFlags & RSSL_PAGE_ARENA_HUGE_PAGES)
+		{
+			if ((map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0)) != MAP_FAILED)
+				*hugeTlb = RSSL_TRUE;
+		}
+#endif
+
+		if (map == MAP_FAILED)
+		{
+			size_t extra = RSSL_PAGE_ARENA_REGION_SIZE;
+			size_t lead;
+
+			if ((map = mmap(NULL, size + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+				return NULL;
+
+			/* trim to a region boundary at both ends */
+			lead = (RSSL_PAGE_ARENA_REGION_SIZE - ((size_t)map & (RSSL_PAGE_ARENA_REGION_SIZE - 1))) & (RSSL_PAGE_ARENA_REGION_SIZE - 1);
+			if (lead)
+				munmap(map, lead);
+			if (extra - lead)
+				munmap((char*)map + lead + size, extra - lead);
+			map = (char*)map + lead;
+
+#if defined(MADV_HUGEPAGE)
+			if (arenaFlags & RSSL_PAGE_ARENA_HUGE_PAGES)
+				(void)madvise(map, size, MADV_HUGEPAGE);
+#endif
+		}
+
+		if (arenaFlags & RSSL_PAGE_ARENA_LOCAL_NODE)
+			*nodeBound = rsslPageArenaBindNode((char*)map, size, arena->node);
+
+		mem = (char*)map;
+	}
+#endif
+
+	return mem;
+}
+
+static void rsslPageArenaUnmap(char *base, size_t size)
+{
+#if defined(_WIN32)
+	VirtualFree(base, 0, MEM_RELEASE);
+#else
+	munmap(base, size);
+#endif
+}
+
+static RsslPageArenaMapping *rsslPageArenaAddMapping(RsslPageArena *arena, size_t size)
+{
+	RsslPageArenaMapping *mapping;
+
+	if ((mapping = (RsslPageArenaMapping*)malloc(sizeof(RsslPageArenaMapping))) == NULL)
+		return NULL;
+
+	if ((mapping->base = rsslPageArenaMap(arena, size, &mapping->hugeTlb, &mapping->nodeBound)) == NULL)
+	{
+		free(mapping);
+		return NULL;
+	}
+
+	mapping->arena = arena;
+	mapping->size = size;
+	mapping->liveChunks = 0;
+	mapping->next = arena->mappings;
+	arena->mappings = mapping;
+
+	arena->regionBytes += size;
+	if (mapping->hugeTlb)
+		arena->hugeTlbBytes += size;
+	if (mapping->nodeBound)
+		arena->nodeBoundBytes += size;
+
+	return mapping;
+}
+
+static void rsslPageArenaRemoveMapping(RsslPageArena *arena, RsslPageArenaMapping *mapping)
+{
+	RsslPageArenaMapping **ppMapping;
+
+	for (ppMapping = &arena->mappings; *ppMapping != NULL; ppMapping = &(*ppMapping)->next)
+	{
+		if (*ppMapping == mapping)
+		{
+			*ppMapping = mapping->next;
+			arena->regionBytes -= mapping->size;
+			if (mapping->hugeTlb)
+				arena->hugeTlbBytes -= mapping->size;
+			if (mapping->nodeBound)
+				arena->nodeBoundBytes -= mapping->size;
+			rsslPageArenaUnmap(mapping->base, mapping->size);
+			free(mapping);
+			return;
+		}
+	}
+}
+
+/* Takes the free chunks of an empty region off the free lists; only done when a region
+ * empties, so walking the lists is cheaper than keeping them doubly linked */
+static void rsslPageArenaUnlinkRegion(RsslPageArena *arena, RsslPageArenaMapping *mapping)
+{
+	int sizeClass;
+
+	for (sizeClass = 0; sizeClass < RSSL_PAGE_ARENA_CLASSES; sizeClass++)
+	{
+		char **ppChunk = &arena->freeChunks[sizeClass];
+
+		while (*ppChunk != NULL)
+		{
+			if (*ppChunk >= mapping->base && *ppChunk < mapping->base + mapping->size)
+				*ppChunk = *(char**)(*ppChunk + RSSL_PAGE_ARENA_HEADER);
+			else
+				ppChunk = (char**)(*ppChunk + RSSL_PAGE_ARENA_HEADER);
+		}
+	}
+}
+
+/* The size class for a chunk of at least chunkSize bytes, and the size of its chunks */
+static int rsslPageArenaSizeClass(size_t chunkSize, size_t *classSize)
+{
+	int sizeClass = 0;
+	size_t size = (size_t)1 << RSSL_PAGE_ARENA_MIN_SHIFT;
+
+	while (size < chunkSize)
+	{
+		size <<= 1;
+		sizeClass++;
+	}
+
+	*classSize = size;
+	return sizeClass;
+}
+
+void rsslPageArenaInitialize(RsslUInt32 flags)
+{
+	if (!arenaMutexInit)
+	{
+		(void)RSSL_MUTEX_INIT_ESDK(&arenaMutex);
+		arenaMutexInit = RSSL_TRUE;
+	}
+
+	arenaFlags = flags & (RSSL_PAGE_ARENA_HUGE_PAGES | RSSL_PAGE_ARENA_LOCAL_NODE);
+}
+
+void rsslPageArenaUninitialize()
+{
+	int i;
+
+	if (!arenaMutexInit)
+		return;
+
+	for (i = 0; i < RSSL_PAGE_ARENA_MAX_NODES; i++)
+	{
+		RsslPageArena *arena = arenas[i];
+
+		if (arena == NULL)
+			continue;
+
+		while (arena->mappings)
+			rsslPageArenaRemoveMapping(arena, arena->mappings);
+
+		(void)RSSL_MUTEX_DESTROY(&arena->mutex);
+		free(arena);
+		arenas[i] = NULL;
+	}
+
+	arenaFlags = 0;
+	(void)RSSL_MUTEX_DESTROY(&arenaMutex);
+	arenaMutexInit = RSSL_FALSE;
+}
+
+RsslPageArena *rsslPageArenaForThread()
+{
+	RsslPageArena *arena;
+	int node = 0;
+
+	if (arenaFlags == 0)
+		return NULL;
+
+	if (arenaFlags & RSSL_PAGE_ARENA_LOCAL_NODE)
+	{
+		node = rsslPageArenaCurrentNode();
+		if (node < 0 || node >= RSSL_PAGE_ARENA_MAX_NODES)
+			node = 0;
+	}
+
+	(void)RSSL_MUTEX_LOCK(&arenaMutex);
+
+	if ((arena = arenas[node]) == NULL)
+	{
+		if ((arena = (RsslPageArena*)malloc(sizeof(RsslPageArena))) != NULL)
+		{
+			memset(arena, 0, sizeof(RsslPageArena));
+			(void)RSSL_MUTEX_INIT_ESDK(&arena->mutex);
+			arena->node = node;
+			arenas[node] = arena;
+		}
+	}
+
+	(void)RSSL_MUTEX_UNLOCK(&arenaMutex);
+
+	return arena;
+}
+
+void *rsslPageArenaAlloc(RsslPageArena *arena, size_t size)
+{
+	size_t chunkSize = size + RSSL_PAGE_ARENA_HEADER;
+	RsslPageArenaChunk *chunk = NULL;
+	RsslPageArenaMapping *mapping = NULL;
+	int sizeClass;
+
+	(void)RSSL_MUTEX_LOCK(&arena->mutex);
+
+	if (chunkSize > RSSL_PAGE_ARENA_MAX_CHUNK)
+	{
+		chunkSize = (chunkSize + RSSL_PAGE_ARENA_REGION_SIZE - 1) & ~(size_t)(RSSL_PAGE_ARENA_REGION_SIZE - 1);
+		if ((mapping = rsslPageArenaAddMapping(arena, chunkSize)) != NULL)
+			chunk = (RsslPageArenaChunk*)mapping->base;
+	}
+	else if (arena->freeChunks[sizeClass = rsslPageArenaSizeClass(chunkSize, &chunkSize)] != NULL)
+	{
+		chunk = (RsslPageArenaChunk*)arena->freeChunks[sizeClass];
+		arena->freeChunks[sizeClass] = *(char**)((char*)chunk + RSSL_PAGE_ARENA_HEADER);
+		mapping = chunk->mapping;
+	}
+	else
+	{
+		/* what is left of the current region is abandoned when a chunk does not fit */
+		if (arena->current == NULL || (size_t)(arena->regionEnd - arena->nextChar) < chunkSize)
+		{
+			RsslPageArenaMapping *region;
+
+			/* an empty region always has room, so the old one still holds chunks and is
+			 * unmapped when the last of them is freed */
+			if ((region = rsslPageArenaAddMapping(arena, RSSL_PAGE_ARENA_REGION_SIZE)) != NULL)
+			{
+				arena->current = region;
+				arena->nextChar = region->base;
+				arena->regionEnd = region->base + RSSL_PAGE_ARENA_REGION_SIZE;
+			}
+		}
+
+		if (arena->current != NULL && (size_t)(arena->regionEnd - arena->nextChar) >= chunkSize)
+		{
+			chunk = (RsslPageArenaChunk*)arena->nextChar;
+			arena->nextChar += chunkSize;
+			mapping = arena->current;
+		}
+	}
+
+	if (chunk != NULL)
+	{
+		chunk->mapping = mapping;
+		chunk->size = chunkSize;
+		mapping->liveChunks++;
+		arena->inUseBytes += chunkSize;
+	}
+
+	(void)RSSL_MUTEX_UNLOCK(&arena->mutex);
+
+	return (chunk != NULL) ? (char*)chunk + RSSL_PAGE_ARENA_HEADER : NULL;
+}
+
+void rsslPageArenaFree(void *mem)
+{
+	RsslPageArenaChunk *chunk;
+	RsslPageArenaMapping *mapping;
+	RsslPageArena *arena;
+	size_t classSize;
+	int sizeClass;
+
+	if (mem == NULL)
+		return;
+
+	chunk = (RsslPageArenaChunk*)((char*)mem - RSSL_PAGE_ARENA_HEADER);
+	mapping = chunk->mapping;
+	arena = mapping->arena;
+
+	(void)RSSL_MUTEX_LOCK(&arena->mutex);
+
+	arena->inUseBytes -= chunk->size;
+
+	if (chunk->size > RSSL_PAGE_ARENA_MAX_CHUNK)
+		rsslPageArenaRemoveMapping(arena, mapping);
+	else
+	{
+		sizeClass = rsslPageArenaSizeClass(chunk->size, &classSize);
+		*(char**)((char*)chunk + RSSL_PAGE_ARENA_HEADER) = arena->freeChunks[sizeClass];
+		arena->freeChunks[sizeClass] = (char*)chunk;
+
+		if (--mapping->liveChunks == 0)
+		{
+			rsslPageArenaUnlinkRegion(arena, mapping);
+
+			/* the region being carved starts over instead of being unmapped */
+			if (mapping == arena->current)
+				arena->nextChar = mapping->base;
+			else
+				rsslPageArenaRemoveMapping(arena, mapping);
+		}
+	}
+
+	(void)RSSL_MUTEX_UNLOCK(&arena->mutex);
+}
+
+void rsslPageArenaGetStats(RsslPageArenaStats *stats)
+{
+	int i;
+
+	memset(stats, 0, sizeof(RsslPageArenaStats));
+
+	if (!arenaMutexInit)
+		return;
+
+	(void)RSSL_MUTEX_LOCK(&arenaMutex);
+	for (i = 0; i < RSSL_PAGE_ARENA_MAX_NODES; i++)
+	{
+		RsslPageArena *arena = arenas[i];
+
+		if (arena == NULL)
+			continue;
+
+		(void)RSSL_MUTEX_LOCK(&arena->mutex);
+		stats->regionBytes += arena->regionBytes;
+		stats->hugeTlbBytes += arena->hugeTlbBytes;
+		stats->nodeBoundBytes += arena->nodeBoundBytes;
+		stats->inUseBytes += arena->inUseBytes;
+		stats->arenaCount++;
+		(void)RSSL_MUTEX_UNLOCK(&arena->mutex);
+	}
+	(void)RSSL_MUTEX_UNLOCK(&arenaMutex);
+}
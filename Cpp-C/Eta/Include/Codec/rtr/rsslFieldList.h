@@ -17,6 +17,8 @@ extern "C" {
 #include "rtr/rsslTypes.h"
 #include "rtr/rsslRDM.h"
 #include "rtr/rsslIterators.h"
+#include "rtr/rsslReal.h"
+#include "rtr/rsslDateTime.h"
 
 
 /**
@@ -258,6 +260,152 @@ RSSL_API RsslRet rsslEncodeFieldEntryComplete(
 
 
 
+/** 
+ * @addtogroup FieldListTemplate RsslFieldList Encoding Templates
+ * @{
+ */
+
+/**
+ * @brief One field of the layout compiled into an RsslFieldListTemplate.
+ * @see rsslCompileFieldListTemplate
+ */
+typedef struct {
+	RsslFieldId			fieldId;	/*!< @brief The field identifier */
+	RsslUInt8			dataType;	/*!< @brief ::RSSL_DT_INT, ::RSSL_DT_UINT, ::RSSL_DT_REAL, ::RSSL_DT_ENUM, ::RSSL_DT_DATE, ::RSSL_DT_TIME, ::RSSL_DT_DATETIME, or a buffer or string type */
+} RsslFieldListTemplateEntry;
+
+/**
+ * @brief Value of one field encoded with rsslEncodeFieldListTemplate(), using the member matching the type of the field in the layout.
+ * @see rsslEncodeFieldListTemplate
+ */
+typedef union {
+	RsslInt64			intValue;		/*!< @brief For ::RSSL_DT_INT */
+	RsslUInt64			uintValue;		/*!< @brief For ::RSSL_DT_UINT */
+	RsslReal			realValue;		/*!< @brief For ::RSSL_DT_REAL */
+	RsslEnum			enumValue;		/*!< @brief For ::RSSL_DT_ENUM */
+	RsslDate			dateValue;		/*!< @brief For ::RSSL_DT_DATE */
+	RsslTime			timeValue;		/*!< @brief For ::RSSL_DT_TIME */
+	RsslDateTime		dateTimeValue;	/*!< @brief For ::RSSL_DT_DATETIME */
+	RsslBuffer			bufferValue;	/*!< @brief For ::RSSL_DT_BUFFER and the string types */
+} RsslFieldListTemplateValue;
+
+/**
+ * @brief Flag values for use with the RsslFieldListTemplate (FLTF = FieldListTemplate Flags)
+ * @see RsslFieldListTemplate
+ */
+typedef enum {
+	RSSL_FLTF_NONE				= 0x00,	/*!< (0x00) The fields are encoded as standard entries, each value in a fixed width slot */
+	RSSL_FLTF_SET_DEFINED		= 0x01,	/*!< (0x01) The fields are encoded as the set data of RsslFieldListTemplate::setId, using the set definition in RsslFieldListTemplate::setDef */
+	RSSL_FLTF_VARIABLE_WIDTH	= 0x02	/*!< (0x02) Each value is encoded in its shortest form, giving the same encoding as rsslEncodeFieldEntry().  Always used for layouts containing buffers or strings. */
+} RsslFieldListTemplateFlags;
+
+/**
+ * @brief Location of one field within the encoding of a compiled RsslFieldListTemplate; for internal use.
+ */
+typedef struct {
+	RsslFieldId			fieldId;
+	RsslUInt8			dataType;		/* Type of the field in the layout */
+	RsslUInt8			encDataType;	/* Type the value is encoded as; a set defined type for fixed width set data */
+	RsslUInt32			offset;			/* Of the value within the fixed width encoding */
+} RsslFieldListTemplateSlot;
+
+/**
+ * @brief Memory an RsslFieldListTemplate needs for a layout of entryCount fields.
+ * @see RsslFieldListTemplate
+ */
+#define RSSL_FIELD_LIST_TEMPLATE_MEMORY_SIZE(entryCount) \
+	(sizeof(RsslUInt32) + 8 + (entryCount) * (sizeof(RsslFieldListTemplateSlot) + sizeof(RsslFieldSetDefEntry) + 16))
+
+/**
+ * @brief A field list layout compiled once by rsslCompileFieldListTemplate(), for encoding lists of the same fields repeatedly with rsslEncodeFieldListTemplate().
+ *
+ * Compiling encodes the whole list with empty values.  Unless ::RSSL_FLTF_VARIABLE_WIDTH applies, every value has a slot of fixed width
+ * (e.g. all eight bytes of an RsslReal's value), so encoding copies the compiled list and writes each value into its slot,
+ * without encoding field identifiers, lengths or counts again.  The result is larger than rsslEncodeFieldEntry() would produce
+ * for small values, but decodes the same.<BR>
+ * With ::RSSL_FLTF_VARIABLE_WIDTH, the header of the list is still copied and each entry is written in turn.
+ * @see RSSL_INIT_FIELD_LIST_TEMPLATE, rsslClearFieldListTemplate, rsslCompileFieldListTemplate, rsslEncodeFieldListTemplate
+ */
+typedef struct {
+	RsslBuffer					memory;		/*!< @brief Memory to compile the template into, set by the application.  RSSL_FIELD_LIST_TEMPLATE_MEMORY_SIZE() gives the length needed. */
+	RsslUInt8					flags;		/*!< @brief RsslFieldListTemplateFlags, set by the application */
+	RsslUInt16					setId;		/*!< @brief With ::RSSL_FLTF_SET_DEFINED, the set identifier to encode, up to ::RSSL_FIELD_SET_MAX_LOCAL_ID */
+	RsslUInt16					entryCount;	/*!< @brief Number of fields in the layout */
+	RsslFieldSetDef				setDef;		/*!< @brief With ::RSSL_FLTF_SET_DEFINED, the set definition of the layout.  It must be in the RsslLocalFieldSetDefDb sent with the encoded lists. */
+
+	/* Internal use only */
+	RsslFieldListTemplateSlot	*_slots;
+	char						*_encData;		/* The compiled list */
+	RsslUInt32					_encLength;		/* Of the whole list if fixed width, otherwise of its header */
+	RsslBool					_fixedWidth;
+} RsslFieldListTemplate;
+
+/**
+ * @brief RsslFieldListTemplate static initializer
+ * @see RsslFieldListTemplate, rsslClearFieldListTemplate
+ */
+#define RSSL_INIT_FIELD_LIST_TEMPLATE { RSSL_INIT_BUFFER, 0, 0, 0, RSSL_INIT_FIELD_SET_DEF, 0, 0, 0, RSSL_FALSE }
+
+/**
+ * @brief Clears an RsslFieldListTemplate, including RsslFieldListTemplate::memory
+ * @see RsslFieldListTemplate, RSSL_INIT_FIELD_LIST_TEMPLATE
+ */
+RTR_C_INLINE void rsslClearFieldListTemplate(RsslFieldListTemplate *pTemplate)
+{
+	pTemplate->memory.length = 0;
+	pTemplate->memory.data = 0;
+	pTemplate->flags = 0;
+	pTemplate->setId = 0;
+	pTemplate->entryCount = 0;
+	rsslClearFieldSetDef(&pTemplate->setDef);
+	pTemplate->_slots = 0;
+	pTemplate->_encData = 0;
+	pTemplate->_encLength = 0;
+	pTemplate->_fixedWidth = RSSL_FALSE;
+}
+
+/**
+ * @brief Compiles a field list layout into an RsslFieldListTemplate
+ *
+ * Typical use:<BR>
+ *  1. Set RsslFieldListTemplate::memory, RsslFieldListTemplate::flags and RsslFieldListTemplate::setId<BR>
+ *  2. Call rsslCompileFieldListTemplate() once for the layout<BR>
+ *  3. Call rsslEncodeFieldListTemplate() with the values of each list to encode<BR>
+ *
+ * @param pTemplate RsslFieldListTemplate to compile into
+ * @param pEntries The fields of the layout, in the order they are encoded
+ * @param entryCount Number of fields; at most 255 with ::RSSL_FLTF_SET_DEFINED
+ * @see RsslFieldListTemplate, rsslEncodeFieldListTemplate
+ * @return ::RSSL_RET_SUCCESS, ::RSSL_RET_BUFFER_TOO_SMALL if RsslFieldListTemplate::memory is too small, or ::RSSL_RET_INVALID_ARGUMENT for an unsupported type or set identifier
+ */
+RSSL_API RsslRet rsslCompileFieldListTemplate(
+							RsslFieldListTemplate				*pTemplate,
+							const RsslFieldListTemplateEntry	*pEntries,
+							RsslUInt16							entryCount );
+
+/**
+ * @brief Encodes a complete RsslFieldList from a compiled template and the values of its fields
+ *
+ * This takes the place of rsslEncodeFieldListInit(), rsslEncodeFieldEntry() for each field and rsslEncodeFieldListComplete(),
+ * wherever a field list can be encoded (e.g. after rsslEncodeMsgInit() or rsslEncodeMapEntryInit()).<BR>
+ * A blank RsslReal can be encoded; other values cannot be blank.
+ *
+ * @param pIter	Pointer to the encode iterator
+ * @param pTemplate RsslFieldListTemplate compiled by rsslCompileFieldListTemplate()
+ * @param pValues One value for each field of the layout, in the same order
+ * @see RsslFieldListTemplate, rsslCompileFieldListTemplate
+ * @return ::RSSL_RET_SUCCESS, ::RSSL_RET_BUFFER_TOO_SMALL, or ::RSSL_RET_INVALID_DATA for an invalid value.  Nothing is encoded on failure.
+ */
+RSSL_API RsslRet rsslEncodeFieldListTemplate(
+							RsslEncodeIterator					*pIter,
+							const RsslFieldListTemplate			*pTemplate,
+							const RsslFieldListTemplateValue	*pValues );
+
+/**
+ * @}
+ */
+
+
 /** 
  * @addtogroup FieldListDecoding RsslFieldList and RsslFieldEntry Decoding
  * @{
@@ -306,6 +454,195 @@ RSSL_API RsslRet rsslDecodeFieldEntry(
  */
 
 
+/** 
+ * @addtogroup FieldListIndex RsslFieldList Index
+ * @{
+ */
+
+/**
+ * @brief Location of one RsslFieldEntry in an RsslFieldList indexed by rsslDecodeFieldListIndex().
+ * @see RsslFieldListIndex
+ */
+typedef struct {
+	RsslFieldId			fieldId;	/*!< @brief The field identifier of the entry */
+	RsslUInt8			dataType;	/*!< @brief For set defined entries, the type from the set definition.  Otherwise ::RSSL_DT_UNKNOWN, as in RsslFieldEntry::dataType. */
+	RsslUInt8			_lengthSize;	/* Internal use only: bytes taken by the length of a standard entry, 0 for set defined entries */
+	RsslUInt32			offset;		/*!< @brief Offset of the entry's encoded content from the first entry of the list */
+	RsslUInt32			length;		/*!< @brief Length of the entry's encoded content */
+} RsslFieldListIndexEntry;
+
+/**
+ * @brief Lists with at most this many entries are searched in order; larger lists also get a hash table.
+ * @see RsslFieldListIndex
+ */
+#define RSSL_FIELD_LIST_INDEX_SCAN_MAX 16
+
+/**
+ * @brief Memory an RsslFieldListIndex needs to index a list of up to entryCount entries, including set defined entries.
+ * @see RsslFieldListIndex
+ */
+#define RSSL_FIELD_LIST_INDEX_MEMORY_SIZE(entryCount) \
+	(sizeof(RsslUInt32) + (entryCount) * (sizeof(RsslFieldListIndexEntry) + 4 * sizeof(RsslUInt32)))
+
+/**
+ * @brief Index of the entries of a decoded RsslFieldList, giving the location of any entry by its field identifier.
+ *
+ * Built with rsslDecodeFieldListIndex() in a single pass over the list, after which
+ * rsslDecodeFieldEntryAt() positions the iterator on any entry without walking the list again.<BR>
+ * The index is built in memory supplied by the application in RsslFieldListIndex::memory,
+ * which can be reused for the next list.
+ * @see RSSL_INIT_FIELD_LIST_INDEX, rsslClearFieldListIndex, rsslDecodeFieldListIndex, rsslDecodeFieldEntryAt
+ */
+typedef struct {
+	RsslBuffer					memory;			/*!< @brief Memory to build the index in, set by the application.  RSSL_FIELD_LIST_INDEX_MEMORY_SIZE() gives the length needed. */
+	RsslUInt32					entryCount;		/*!< @brief Number of entries in the list */
+	RsslFieldListIndexEntry		*entries;		/*!< @brief The entries of the list, in the order they were encoded */
+
+	/* Internal use only */
+	RsslUInt32					*_hashTable;	/* Field identifier and position + 1 of an entry for each slot, when entryCount > RSSL_FIELD_LIST_INDEX_SCAN_MAX */
+	RsslUInt32					_hashMask;
+	RsslUInt8					_hashShift;
+	RsslInt8					_decodingLevel;	/* Decoding level of the list in the iterator */
+	RsslBool					_hasDuplicates;	/* Set if a field identifier may occur more than once; always set for lists searched in order */
+	char						*_entryBase;	/* Position RsslFieldListIndexEntry::offset is from */
+} RsslFieldListIndex;
+
+/**
+ * @brief RsslFieldListIndex static initializer
+ * @see RsslFieldListIndex, rsslClearFieldListIndex
+ */
+#define RSSL_INIT_FIELD_LIST_INDEX { RSSL_INIT_BUFFER, 0, 0, 0, 0, 0, -1, 0, 0 }
+
+/**
+ * @brief Clears an RsslFieldListIndex, including RsslFieldListIndex::memory
+ * @see RsslFieldListIndex, RSSL_INIT_FIELD_LIST_INDEX
+ */
+RTR_C_INLINE void rsslClearFieldListIndex(RsslFieldListIndex *pIndex)
+{
+	pIndex->memory.length = 0;
+	pIndex->memory.data = 0;
+	pIndex->entryCount = 0;
+	pIndex->entries = 0;
+	pIndex->_hashTable = 0;
+	pIndex->_hashMask = 0;
+	pIndex->_hashShift = 0;
+	pIndex->_decodingLevel = -1;
+	pIndex->_hasDuplicates = 0;
+	pIndex->_entryBase = 0;
+}
+
+/**
+ * @brief Decodes every entry of an RsslFieldList, including set defined entries, into an index of their locations
+ *
+ * Typical use:<BR>
+ *  1. Call rsslDecodeFieldList()<BR>
+ *  2. Call rsslDecodeFieldListIndex(), instead of calling rsslDecodeFieldEntry() for each entry<BR>
+ *  3. Call rsslDecodeFieldEntryAt() for each field of interest, followed by the decoder for its type (e.g. rsslDecodeReal())<BR>
+ *  4. Call rsslFinishDecodeEntries() to continue decoding from the level above<BR>
+ *
+ * @note This must be called before any rsslDecodeFieldEntry() call on the list.  Set defined entries are skipped, 
+ * as they are by rsslDecodeFieldEntry(), if no set definition database was passed to rsslDecodeFieldList().<BR>
+ * The index refers to the encoded list, which must remain available while the index is used.
+ *
+ * @param pIter Decode iterator, positioned by rsslDecodeFieldList()
+ * @param pIndex RsslFieldListIndex to build, with RsslFieldListIndex::memory set
+ * @see rsslDecodeFieldEntryAt, RsslFieldListIndex
+ * @return ::RSSL_RET_SUCCESS, ::RSSL_RET_BUFFER_TOO_SMALL if RsslFieldListIndex::memory cannot hold the entries, or a decoding failure such as ::RSSL_RET_INCOMPLETE_DATA
+ */
+RSSL_API RsslRet rsslDecodeFieldListIndex(
+							RsslDecodeIterator	*pIter,
+							RsslFieldListIndex	*pIndex );
+
+/**
+ * @brief Positions the iterator on the entry of an indexed RsslFieldList with the given field identifier, and returns the entry
+ *
+ * After this call the entry's content can be decoded with the decoder for its type, as after rsslDecodeFieldEntry().
+ * Entries can be looked up in any order and more than once.  If the list contains the field identifier more than once, the last entry is returned.
+ *
+ * @param pIter Decode iterator used with rsslDecodeFieldListIndex()
+ * @param pIndex RsslFieldListIndex built by rsslDecodeFieldListIndex()
+ * @param fieldId Field identifier to look up
+ * @param pField RsslFieldEntry to populate as rsslDecodeFieldEntry() would
+ * @see rsslDecodeFieldListIndex, RsslFieldListIndex
+ * @return ::RSSL_RET_SUCCESS, or ::RSSL_RET_NO_DATA if the list has no entry for fieldId
+ */
+RSSL_API RsslRet rsslDecodeFieldEntryAt(
+							RsslDecodeIterator			*pIter,
+							const RsslFieldListIndex	*pIndex,
+							RsslFieldId					fieldId,
+							RsslFieldEntry				*pField );
+
+/**
+ * @}
+ */
+
+
+/** 
+ * @addtogroup FieldListDelta RsslFieldList Delta
+ * @{
+ */
+
+/**
+ * @brief Encodes the entries that change one field list image into another, comparing the images as encoded
+ *
+ * An entry of the new image is encoded if the old image has no entry for its field identifier, or has one with
+ * different encoded content.  A blank entry is encoded for each field identifier of the old image that the new image does not have.
+ * Content is compared without decoding it, so a value encoded differently in each image (such as a set defined entry 
+ * in one and a standard entry in the other) is encoded as changed.  All entries are encoded as standard entries.<BR>
+ * Applying the entries to the old image with rsslApplyFieldListUpdate() gives the values of the new image.
+ *
+ * Typical use:<BR>
+ *  1. Call rsslDecodeFieldList() and rsslDecodeFieldListIndex() for each image<BR>
+ *  2. Call rsslEncodeFieldListInit(), without set data<BR>
+ *  3. Call rsslEncodeFieldListDelta()<BR>
+ *  4. Call rsslEncodeFieldListComplete()<BR>
+ *
+ * @note If a list contains a field identifier more than once, only its last entry is used.
+ *
+ * @param pIter Encode iterator, positioned by rsslEncodeFieldListInit() or after an entry
+ * @param pOldIndex RsslFieldListIndex of the old image
+ * @param pNewIndex RsslFieldListIndex of the new image
+ * @see rsslApplyFieldListUpdate, rsslDecodeFieldListIndex
+ * @return ::RSSL_RET_SUCCESS, ::RSSL_RET_NO_DATA if the images are the same and nothing was encoded, 
+ * or a failure such as ::RSSL_RET_BUFFER_TOO_SMALL, after which no entries were encoded
+ */
+RSSL_API RsslRet rsslEncodeFieldListDelta(
+							RsslEncodeIterator			*pIter,
+							const RsslFieldListIndex	*pOldIndex,
+							const RsslFieldListIndex	*pNewIndex );
+
+/**
+ * @brief Encodes the entries of a field list image with the entries of an update field list applied to it
+ *
+ * Each entry of the image is encoded with the content of the update's entry for its field identifier, if the update has one,
+ * and otherwise with its own content.  Entries of the update for field identifiers the image does not have follow, in the order of the update.
+ * Blank entries of the update blank the image's entry.  Content is copied as encoded, 
+ * except that set defined entries are converted to standard entries.
+ *
+ * Typical use:<BR>
+ *  1. Call rsslDecodeFieldList() and rsslDecodeFieldListIndex() for the image and the update<BR>
+ *  2. Call rsslEncodeFieldListInit(), without set data<BR>
+ *  3. Call rsslApplyFieldListUpdate()<BR>
+ *  4. Call rsslEncodeFieldListComplete()<BR>
+ *
+ * @note If a list contains a field identifier more than once, only its last entry is used.
+ *
+ * @param pIter Encode iterator, positioned by rsslEncodeFieldListInit() or after an entry
+ * @param pImageIndex RsslFieldListIndex of the image
+ * @param pUpdateIndex RsslFieldListIndex of the update
+ * @see rsslEncodeFieldListDelta, rsslDecodeFieldListIndex
+ * @return ::RSSL_RET_SUCCESS, or a failure such as ::RSSL_RET_BUFFER_TOO_SMALL, after which no entries were encoded
+ */
+RSSL_API RsslRet rsslApplyFieldListUpdate(
+							RsslEncodeIterator			*pIter,
+							const RsslFieldListIndex	*pImageIndex,
+							const RsslFieldListIndex	*pUpdateIndex );
+
+/**
+ * @}
+ */
+
+
 /** 
  * @addtogroup FieldListSetInfo
  * @{
@@ -253,6 +253,33 @@ RSSL_API RsslRet rsslFloatToReal(RsslReal * oReal, RsslFloat * iValue, RsslUInt8
  */
 RSSL_API RsslRet rsslRealToDouble(RsslDouble * oValue, RsslReal * iReal);
 
+/**
+ * @brief Convert an array of RsslReal to doubles
+ *
+ * Each converted entry is identical to the result of rsslRealToDouble().  Entries that rsslRealToDouble()
+ * cannot convert (blank, or an invalid hint) are set to NaN and the remaining entries are still converted.
+ * @param oValues array of count doubles to convert into
+ * @param iReals array of count RsslReal to convert to double
+ * @param count number of entries to convert
+ * @return Returns ::RSSL_RET_SUCCESS if every entry was converted; ::RSSL_RET_FAILURE if any entry was blank or had an invalid hint value
+ * @see rsslRealToDouble
+ */
+RSSL_API RsslRet rsslRealToDoubleBatch(RsslDouble * oValues, const RsslReal * iReals, RsslUInt32 count);
+
+/**
+ * @brief Convert an array of doubles to RsslReal, using the same hint for each entry
+ *
+ * Each entry is identical to the result of rsslDoubleToReal() with the same hint, including infinity and NaN values.
+ * SIMD instructions are used when supported by the CPU.
+ * @param oReals array of count RsslReal to populate
+ * @param iValues array of count doubles to convert to RsslReal
+ * @param count number of entries to convert
+ * @param iHint \ref RsslRealHints exponent or fraction hint value to use for converting each double (::RSSL_RH_EXPONENT_14 through ::RSSL_RH_FRACTION_256)
+ * @return Returns ::RSSL_RET_SUCCESS if successful conversion; ::RSSL_RET_FAILURE if the hint value is invalid, in which case nothing is converted
+ * @see rsslDoubleToReal
+ */
+RSSL_API RsslRet rsslDoubleToRealBatch(RsslReal * oReals, const RsslDouble * iValues, RsslUInt32 count, RsslUInt8 iHint);
+
 /**
  * @brief Convert numeric string to double
  * @param oValue double to convert into
@@ -224,6 +224,8 @@ typedef struct {
 	RsslInt32	dispatchDecodeMemoryBufferSize;	/*!< Size of the memory buffer(in bytes) that the RsslReactor will use when decoding RsslRDMMsgs to pass to callback functions. */
 	void		*userSpecPtr; 					/*!< user-specified pointer which will be set on the Reactor. */
 	int			port;							/*!< @deprecated DEPRECATED: This parameter no longer has any effect. It was a port used for creating the eventFd descriptor on the RsslReactor. It was never used on Linux or Solaris platforms. */
+	RsslBool	useEpollNotification;			/*!< Linux only. If set, the RsslReactor and its worker thread use epoll to wait for channel notification, so that the cost of each wait
+												 * does not grow with the number of channels.  Recommended when an RsslReactor handles thousands of channels. Has no effect on other platforms. */
 } RsslCreateReactorOptions;
 
 /**
@@ -286,6 +288,13 @@ typedef struct
 	RsslReactorConnectInfo	*reactorConnectionList;	/*!< A list of connnections.  Each connection in the list will be tried with each reconnection attempt. */
 	RsslUInt32				connectionCount;		/*!< The number of connections in reactorConnectionList. */
 
+	RsslUInt32				busyPollUsec;			/*!< If non-zero, the channel is read with busy polling: rsslReactorDispatch() reads it without waiting for notification,
+													 * and each read polls the socket for up to this many microseconds before giving up. Intended for a channel that
+													 * has its own dispatching thread, e.g. by specifying it in RsslReactorDispatchOptions::pReactorChannel. See ::RSSL_BUSY_POLL_USEC. */
+
+	RsslUInt32				coalesceWriteUsec;		/*!< If non-zero, messages submitted on the channel are held for up to this many microseconds so that they are written together.
+													 * The RsslReactor flushes the channel when the time runs out rather than as soon as a message is submitted.  See ::RSSL_COALESCE_WRITE_USEC. */
+
 } RsslReactorConnectOptions;
 
 /**
@@ -302,6 +311,8 @@ RTR_C_INLINE void rsslClearReactorConnectOptions(RsslReactorConnectOptions *pOpt
 
 	pOpts->reactorConnectionList = NULL;
 	pOpts->connectionCount = 0;
+	pOpts->busyPollUsec = 0;
+	pOpts->coalesceWriteUsec = 0;
 }
 
 /**
@@ -323,6 +334,8 @@ typedef struct
 	RsslAcceptOptions	rsslAcceptOptions;		/*!< Options for accepting the connection. */
 	RsslUInt32			initializationTimeout;	/*!< Time(in seconds) to wait for successful initialization of a channel. 
 												 * If initialization does not complete in time, a RsslReactorChannelEvent will be sent indicating that the channel is down. */
+	RsslUInt32			coalesceWriteUsec;		/*!< If non-zero, messages submitted on the channel are held for up to this many microseconds so that they are written together.
+												 * The RsslReactor flushes the channel when the time runs out rather than as soon as a message is submitted.  See ::RSSL_COALESCE_WRITE_USEC. */
 } RsslReactorAcceptOptions;
 
 /**
@@ -333,6 +346,7 @@ RTR_C_INLINE void rsslClearReactorAcceptOptions(RsslReactorAcceptOptions *pOpts)
 {
 	rsslClearAcceptOpts(&pOpts->rsslAcceptOptions);
 	pOpts->initializationTimeout = 60;
+	pOpts->coalesceWriteUsec = 0;
 }
 
 /**
@@ -0,0 +1,103 @@
+/*|-----------------------------------------------------------------------------
+ *|            This source code is provided under the Apache 2.0 license      --
+ *|  and is provided AS IS with no warranty or guarantee of fit for purpose.  --
+ *|                See the project's LICENSE.md for details.                  --
+ *|           Copyright Thomson Reuters 2018. All rights reserved.            --
+ *|-----------------------------------------------------------------------------
+ */
+
+#ifndef __RTR_RSSL_BINARY_TRACE_H
+#define __RTR_RSSL_BINARY_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "rtr/rsslTypes.h"
+
+/**
+ *	@addtogroup RSSLTransportStructs
+ *	@{
+ */
+
+/**
+ * @brief Layout of the files written when RSSL_TRACE_BINARY is set on a channel.
+ *
+ * A file starts with an RsslBinaryTraceFileHeader, followed by records.  Each record is an
+ * RsslBinaryTraceRecord followed by the message bytes, padded so the next record starts on a
+ * multiple of 8 bytes.  Values are in the byte order of the host that wrote the file, which
+ * the byteOrder member of the file header identifies.
+ * @see RSSL_TRACE_BINARY
+ */
+
+/** @brief Marks the start of a binary trace file */
+#define RSSL_BINARY_TRACE_MAGIC			"RSSLBTRC"
+
+/** @brief Value of RsslBinaryTraceFileHeader::byteOrder, as written by the host */
+#define RSSL_BINARY_TRACE_BYTE_ORDER	0x01020304
+
+/** @brief Version of the layout described here */
+#define RSSL_BINARY_TRACE_VERSION		1
+
+/**
+ * @brief What a binary trace record holds
+ * @see RsslBinaryTraceRecord
+ */
+typedef enum {
+	RSSL_BTRC_READ				= 1,	/*!< (1) A message returned by rsslRead() */
+	RSSL_BTRC_WRITE				= 2,	/*!< (2) A message passed to rsslWrite() */
+	RSSL_BTRC_PACK				= 3,	/*!< (3) A message passed to rsslPackBuffer() */
+	RSSL_BTRC_READ_PING			= 4,	/*!< (4) A ping read by rsslRead(); no data */
+	RSSL_BTRC_WRITE_PING		= 5,	/*!< (5) A ping sent by rsslPing(); no data */
+	RSSL_BTRC_WRITE_RESULT		= 6,	/*!< (6) The failure code, in retCode, of the write recorded before it */
+	RSSL_BTRC_CONNECTED			= 7,	/*!< (7) The channel became active; no data */
+	RSSL_BTRC_CHANNEL_CLOSED	= 8,	/*!< (8) The channel failed while reading or writing; no data */
+	RSSL_BTRC_CLOSE_CHANNEL		= 9,	/*!< (9) rsslCloseChannel() was called; no data */
+	RSSL_BTRC_DROPPED			= 10	/*!< (10) retCode messages were not recorded because the trace buffer was full */
+} RsslBinaryTraceEvents;
+
+/**
+ * @brief Flags of a binary trace record
+ * @see RsslBinaryTraceRecord
+ */
+typedef enum {
+	RSSL_BTRC_FL_NONE		= 0x0000,	/*!< (0x0000) No flags */
+	RSSL_BTRC_FL_TRUNCATED	= 0x0001	/*!< (0x0001) Only the start of the message was kept; dataLength is its full length */
+} RsslBinaryTraceRecordFlags;
+
+/**
+ * @brief Header of a binary trace file
+ */
+typedef struct {
+	char		magic[8];			/*!< @brief RSSL_BINARY_TRACE_MAGIC, without a null terminator */
+	RsslUInt32	byteOrder;			/*!< @brief RSSL_BINARY_TRACE_BYTE_ORDER */
+	RsslUInt16	formatVersion;		/*!< @brief RSSL_BINARY_TRACE_VERSION */
+	RsslUInt8	majorVersion;		/*!< @brief RWF major version of the channel */
+	RsslUInt8	minorVersion;		/*!< @brief RWF minor version of the channel */
+	RsslInt32	protocolType;		/*!< @brief Protocol type of the channel */
+	RsslUInt32	reserved;			/*!< @brief Zero */
+	RsslInt64	startTime;			/*!< @brief When the file was created, in nanoseconds since the epoch */
+} RsslBinaryTraceFileHeader;
+
+/**
+ * @brief Header of a record in a binary trace file
+ */
+typedef struct {
+	RsslUInt32	recordLength;		/*!< @brief Bytes in the record, this header and padding included */
+	RsslUInt16	event;				/*!< @brief RsslBinaryTraceEvents */
+	RsslUInt16	flags;				/*!< @brief RsslBinaryTraceRecordFlags */
+	RsslUInt32	dataLength;			/*!< @brief Length of the message */
+	RsslInt32	retCode;			/*!< @brief Return code or count, for the events that have one */
+	RsslInt64	time;				/*!< @brief When the event happened, in nanoseconds since the epoch */
+	RsslUInt64	channelId;			/*!< @brief The channel's socketId, as the XML trace's Channel IPC descriptor */
+} RsslBinaryTraceRecord;
+
+/**
+ *	@}
+ */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
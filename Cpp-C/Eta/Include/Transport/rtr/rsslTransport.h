@@ -59,7 +59,8 @@ typedef enum {
 typedef enum {
 	RSSL_COMP_NONE	= 0x00,  /*!< (0) No compression will be negotiated. */
 	RSSL_COMP_ZLIB	= 0x01,	 /*!< (1) RSSL will attempt to use Zlib compression. */
-	RSSL_COMP_LZ4	= 0x02	 /*!< (2) RSSL will attempt to use LZ4 compression */
+	RSSL_COMP_LZ4	= 0x02,	 /*!< (2) RSSL will attempt to use LZ4 compression */
+	RSSL_COMP_ZSTD	= 0x04	 /*!< (4) RSSL will attempt to use Zstandard compression.  The zstd library (libzstd.so.1 or libzstd.dll, see rsslJITOpts::libzstdName) is loaded at runtime when RSSL is initialized; if it cannot be loaded this type is not offered, and the connection negotiates without it. */
 } RsslCompTypes;
 
 /**
@@ -82,7 +83,18 @@ typedef enum {
 										 /*!< (12) Reserved */
 										 /*!< (13) Reserved */
 	RSSL_REGISTER_HASH_ID			= 14, /*!< (14) Channel: Used with ::RSSL_CONN_TYPE_RELIABLE_MCAST connections. Registers a hash so that a filtering-enabled channel allows it. */
-	RSSL_UNREGISTER_HASH_ID			= 15 /*!< (15) Channel: Used with ::RSSL_CONN_TYPE_RELIABLE_MCAST connections. Unregisters a hash so that a filtering-enabled channel no longer allows it. */
+	RSSL_UNREGISTER_HASH_ID			= 15, /*!< (15) Channel: Used with ::RSSL_CONN_TYPE_RELIABLE_MCAST connections. Unregisters a hash so that a filtering-enabled channel no longer allows it. */
+	RSSL_SHARED_POOL_CACHE_SIZE		= 16, /*!< (16) Channel: Used to change the number of server shared pool buffers this channel keeps cached. 0 disables the cache. */
+	RSSL_ZERO_COPY_THRESHOLD		= 17, /*!< (17) Channel: Linux ::RSSL_CONN_TYPE_SOCKET connections only. Flushes that write at least this many bytes use MSG_ZEROCOPY, and written buffers are released once the kernel reports the send complete. Once half of the guaranteed output buffers are waiting on completions, flushes copy as usual. 0 (the default) disables zero copy. */
+	RSSL_COMPRESSION_MIN_SAVINGS	= 18, /*!< (18) Channel: When compression is on, turns on adaptive compression.  The value is the percentage of bytes (1 - 99) that compression must save for a message size class to keep being compressed; size classes that save less are sent uncompressed and periodically retried.  0 (the default) compresses every eligible message.  See RsslChannelInfo::compressionStats. */
+	RSSL_RECV_TIMESTAMPS			= 19, /*!< (19) Channel: Linux ::RSSL_CONN_TYPE_SOCKET connections only. A non-zero value turns on kernel software receive timestamps (SO_TIMESTAMPING); each buffer returned by rsslReadEx() then carries the time its last byte was received in RsslReadOutArgs::recvTimestamp. When no socket on the host has used them yet, the kernel starts stamping shortly after the call, so the first messages may not carry a time. 0 (the default) turns them off. */
+	RSSL_BUSY_POLL_USEC				= 20, /*!< (20) Channel: Non-blocking ::RSSL_CONN_TYPE_SOCKET, ::RSSL_CONN_TYPE_ENCRYPTED and ::RSSL_CONN_TYPE_HTTP connections. When rsslRead() finds no data, it keeps polling the socket for up to this many microseconds before returning ::RSSL_RET_READ_WOULD_BLOCK, avoiding a notifier wake-up for data that arrives within that time. On Linux, SO_BUSY_POLL and SO_PREFER_BUSY_POLL are also set where permitted. Data queued for writing is not flushed while polling. 0 (the default) turns busy polling off. */
+	RSSL_SHMEM_SLOW_READER_WAIT		= 21, /*!< (21) Server, or channel accepted by the server: ::RSSL_CONN_TYPE_UNIDIR_SHMEM only. Before a write that would put an attached reader more than its maxReaderLag behind, the server waits up to this many microseconds for the reader to catch up; if it does not, the write goes ahead and the reader is overrun. 0 (the default) never waits; slow readers are only reported. See RsslShmemStats. */
+	RSSL_PRIORITY_FLUSH_WEIGHTS		= 22, /*!< (22) Channel: ::RSSL_CONN_TYPE_SOCKET, ::RSSL_CONN_TYPE_ENCRYPTED and ::RSSL_CONN_TYPE_HTTP connections. The value is a pointer to an RsslPriorityFlushWeights.  Replaces the ::RSSL_PRIORITY_FLUSH_ORDER pattern with a byte-weighted deficit round robin over the priority queues, optionally with a latency budget for high priority messages.  All weights set to 0 turns weighted flushing off and returns to the flush order.  See RsslChannelInfo::priorityFlushStats. */
+	RSSL_COALESCE_WRITE_USEC		= 23, /*!< (23) Channel: ::RSSL_CONN_TYPE_SOCKET, ::RSSL_CONN_TYPE_ENCRYPTED and ::RSSL_CONN_TYPE_HTTP connections. Holds written data for up to this many microseconds so that it goes out in fewer system calls. The held data is flushed by the first rsslWrite(), rsslRead() or rsslFlush() after the time has passed, when more than ::RSSL_HIGH_WATER_MARK bytes are held, or when a message is written with ::RSSL_WRITE_DIRECT_SOCKET_WRITE.  Nothing flushes it on its own: rsslWrite() still returns the number of bytes held, and rsslFlush() called before the time has passed leaves the data held and also returns a positive value, so an application that flushes on write notification should only register for it once RsslChannelInfo::coalesceFlushUsec has passed.  An application must call rsslFlush() by then if it is not otherwise reading or writing on the channel. 0 (the default) turns coalescing off. See RsslChannelInfo::writeSysCalls. */
+	RSSL_AUTO_PACK_SIZE				= 24, /*!< (24) Channel: ::RSSL_CONN_TYPE_SOCKET, ::RSSL_CONN_TYPE_ENCRYPTED and ::RSSL_CONN_TYPE_HTTP connections. Turns on transparent packing: each message written with rsslWrite() that fits, with its 2 byte length, in this many bytes is copied into an open packed buffer for its priority instead of being written on its own. The open buffer is written when the next message does not fit, when rsslFlush() is called, or when a message is written with ::RSSL_WRITE_DIRECT_SOCKET_WRITE; rsslWrite() returns a positive value while one is open. Sizes larger than the maximum fragment size are reduced to it. Readers need no change. 0 (the default) turns packing off. See RsslTcpOpts::autoPackSize and RsslChannelInfo::autoPackedMsgs. */
+	RSSL_REASSEMBLY_ALLOCATOR		= 25, /*!< (25) Channel: ::RSSL_CONN_TYPE_SOCKET, ::RSSL_CONN_TYPE_ENCRYPTED and ::RSSL_CONN_TYPE_HTTP connections. The value is a pointer to an RsslReassemblyAllocator.  Fragmented messages are reassembled straight into a buffer the application allocates once the total length is known from the first fragment, instead of into memory the transport allocates and frees again on the next rsslRead(). The returned buffer belongs to the application and is marked with ::RSSL_READ_OUT_CALLER_BUFFER. A cleared RsslReassemblyAllocator returns to transport reassembly. */
+	RSSL_COMPRESSION_MAX_COST		= 26  /*!< (26) Channel: With adaptive compression on (see ::RSSL_COMPRESSION_MIN_SAVINGS), the most compression time, in nanoseconds per kilobyte saved, that a message size class may cost and keep being compressed; size classes that cost more are sent uncompressed and periodically retried, like those that save too little.  0 (the default) does not limit the cost.  See RsslChannelInfo::compressionStats. */
 } RsslIoctlCodes;
 
 /**
@@ -96,7 +108,8 @@ typedef enum {
 	RSSL_CONN_TYPE_UNIDIR_SHMEM		= 3,  /*!< (3) Channel is using a shared memory connection */
 	RSSL_CONN_TYPE_RELIABLE_MCAST	= 4,   /*!< (4) Channel is a reliable multicast based connection. This can be on a unified/mesh network where send and receive networks are the same or a segmented network where send and receive networks are different */
 	RSSL_CONN_TYPE_EXT_LINE_SOCKET  = 5,   /*!< (5) Channel is using an extended line socket transport */	
-	RSSL_CONN_TYPE_SEQ_MCAST		= 6    /*!< (6) Channel is an unreliable, sequenced multicast connection for reading from an Elektron Direct Feed system. This is a client-only, read-only transport. This transport is supported on Linux only. */
+	RSSL_CONN_TYPE_SEQ_MCAST		= 6,   /*!< (6) Channel is an unreliable, sequenced multicast connection for reading from an Elektron Direct Feed system. This is a client-only, read-only transport. This transport is supported on Linux only. */
+	RSSL_CONN_TYPE_BIDIR_SHMEM		= 7    /*!< (7) Channel is a full-duplex shared memory connection between two processes on the same host. The session, pings and all traffic run over a pair of rings in a shared segment instead of a TCP socket, and once rsslInitChannel() has attached the segment, the channel's socketId is an eventfd that becomes readable when the peer writes to an idle reader or frees ring space a flush is waiting for. The eventfd is always writable, so when rsslFlush() returns a positive value, wait for socketId to become readable rather than writable. Both processes must run as the same user. serviceName selects the server; hostName and interfaceName are ignored. A peer that exits without closing the channel is detected by the ping timeout. This transport is supported on Linux only. */
 } RsslConnectionTypes;
 
 /**
@@ -206,9 +219,29 @@ typedef enum
 typedef struct {
 	char*			 libsslName;			/*!< Name of the openSSL libssl shared library.  The RSSL API will attempt to dynamically load this library for encrypted connections. */
 	char*			 libcryptoName;			/*!< Name of the openSSL libcrypto shared library.  The RSSL API will attempt to dynamically load this library for encrypted connections. */
+	char*			 libzstdName;			/*!< Name of the Zstandard shared library, loaded for ::RSSL_COMP_ZSTD.  NULL uses libzstd.so.1 (libzstd.dll on Windows). */
 } rsslJITOpts;
 
-#define RSSL_INIT_SSL_LIB_JIT_OPTS { NULL, NULL }
+#define RSSL_INIT_SSL_LIB_JIT_OPTS { NULL, NULL, NULL }
+
+/**
+ * @brief Options for where the transport allocates the buffers of socket channels: their
+ * output buffer pools, input buffers and compression buffers, and the shared pools of servers.
+ *
+ * By default these are separate heap allocations.  With either flag set they are carved
+ * from 2 MB regions, and a region is given back to the system once none of it is in use.
+ * @see RsslInitializeExOpts
+ */
+typedef enum
+{
+	RSSL_INIT_MEM_DEFAULT = 0x00,		/*!< (0x00) Allocate from the heap. */
+	RSSL_INIT_MEM_HUGE_PAGES = 0x01,	/*!< (0x01) Back the regions with 2 MB huge pages, reducing TLB misses.  On Linux, huge pages reserved
+										 * with vm.nr_hugepages are used when available, and transparent huge pages otherwise.  On Windows,
+										 * large pages are used when the process holds SeLockMemoryPrivilege. */
+	RSSL_INIT_MEM_NUMA_LOCAL = 0x02		/*!< (0x02) Keep regions for each NUMA node, and place a channel's buffers on the node of the thread
+										 * that called rsslConnect() or rsslAccept() for it.  Server shared pools are placed on the node of
+										 * the thread that called rsslBind(). */
+} RsslInitMemoryFlags;
 
 	/* Initialization  & Uninitialization*/
 /**
@@ -217,15 +250,16 @@ typedef struct {
 typedef struct
 {
 	RsslLockingTypes rsslLocking;			/*!< Lock method used for the RSSL API */
-	rsslJITOpts		 jitOpts;				/*!< openSSL JIT options */
+	rsslJITOpts		 jitOpts;				/*!< openSSL and zstd JIT options */
 	void*			 initConfig;			/*!< private config init */			
 	size_t			 initConfigSize;		/*!< private size of config init */			
+	RsslUInt32		 memoryFlags;			/*!< RsslInitMemoryFlags; only used by the first call to initialize the RSSL API */
 }RsslInitializeExOpts;
 
 /**
  * @brief Static initializer for RsslInitializeExOpts
  */
-#define RSSL_INIT_INITIALIZE_EX_OPTS { RSSL_LOCK_NONE, RSSL_INIT_SSL_LIB_JIT_OPTS, NULL, 0 }
+#define RSSL_INIT_INITIALIZE_EX_OPTS { RSSL_LOCK_NONE, RSSL_INIT_SSL_LIB_JIT_OPTS, NULL, 0, RSSL_INIT_MEM_DEFAULT }
 
 /**
  * @brief Initializes the RSSL API and all internal members
@@ -286,12 +320,175 @@ typedef struct {
 	RsslUInt64		unicastSent;		/*!< @brief This is the number of unicast UDP packets sent by this channel */
 	RsslUInt64		unicastRcvd;		/*!< @brief This is the number of unicast UDP packets received by this channel */
 	RsslUInt64		gapsDetected;		/*!< @brief This is the number of unrecoverable gaps that have been detected on this channel.  This value includes gaps detected for both multicast and unicast data.  Positive values indicate a possible network problem, more severe as value is larger */
-	RsslUInt64		retransReqSent;		/*!< @brief This is the number of retransmission requests sent by this channel, populated only for reliable multicast connection types.  This value includes retransmit requests for both multicast and unicast data.  Positive values indicate a possible network problem, more severe as value is larger */
+	RsslUInt64		retransReqSent;		/*!< @brief This is the number of retransmission requests sent by this channel, populated for reliable multicast connection types, and for sequenced multicast connections that use a retransmission server.  This value includes retransmit requests for both multicast and unicast data.  Positive values indicate a possible network problem, more severe as value is larger */
 	RsslUInt64		retransReqRcvd;		/*!< @brief This is the number of retransmission requests received by this channel, populated only for reliable multicast connection types.  This value includes retransmit requests for both multicast and unicast data.  Positive values indicate a possible network problem, more severe as value is larger */
 	RsslUInt64		retransPktsSent;	/*!< @brief This is the number of retransmitted packets sent by this channel, populated only for reliable multicast connection types.  This value includes retransmit packets for both multicast and unicast data.  Positive values indicate a possible network problem, more severe as value is larger */
-	RsslUInt64		retransPktsRcvd;	/*!< @brief This is the number of retransmitted packets received by this channel, populated only for reliable multicast connection types.  This value includes retransmit packets for both multicast and unicast data.  Positive values indicate a possible network problem, more severe as value is larger */
+	RsslUInt64		retransPktsRcvd;	/*!< @brief This is the number of retransmitted packets received by this channel, populated for reliable multicast connection types, and for sequenced multicast connections that use a retransmission server.  This value includes retransmit packets for both multicast and unicast data.  Positive values indicate a possible network problem, more severe as value is larger */
 } RsslMCastStats;
 
+/**
+ * @brief Shared memory reader statistics returned by rsslGetChannelInfo and rsslGetServerInfo calls (::RSSL_CONN_TYPE_UNIDIR_SHMEM).
+ * A client channel reports its own counts.  A server, and the channel it accepted, report on all attached clients.
+ * @see rsslGetChannelInfo
+ * @see rsslGetServerInfo
+ * @see RSSL_SHMEM_SLOW_READER_WAIT
+ */
+typedef struct {
+	RsslUInt32		numReaders;			/*!< @brief Server: number of clients currently attached. Client: always 1 */
+	RsslUInt64		readerLag;			/*!< @brief Number of messages written but not yet read; on the server, by the client that is furthest behind */
+	RsslUInt64		overruns;			/*!< @brief Number of times a client fell more than its maxReaderLag behind; on the server, the total over attached clients */
+	RsslUInt64		lostMsgs;			/*!< @brief Number of messages a client skipped with RsslShmemOpts::resumeOnOverrun; on the server, the total over attached clients */
+	RsslUInt64		slowReaderWaits;	/*!< @brief Server: number of writes that waited for a slow client, see ::RSSL_SHMEM_SLOW_READER_WAIT */
+	RsslUInt64		slowReaderTimeouts;	/*!< @brief Server: number of those waits that timed out and overran the client */
+} RsslShmemStats;
+
+/**
+ * @brief Number of message size classes tracked in RsslCompressionStats.
+ * @see RsslCompressionStats
+ */
+#define RSSL_COMP_STATS_BUCKET_COUNT 8
+
+/**
+ * @brief Compression statistics for one message size class, returned by rsslGetChannelInfo call.
+ * @see RsslCompressionStats
+ */
+typedef struct {
+	RsslUInt32		maxLength;			/*!< @brief Messages shorter than this many bytes (and not in a smaller class) fall in this class.  The last class has no upper bound and reports 0. */
+	RsslBool		bypassed;			/*!< @brief RSSL_TRUE if adaptive compression is currently sending this class uncompressed */
+	RsslUInt64		compressedMsgs;		/*!< @brief Number of messages in this class that were compressed */
+	RsslUInt64		bypassedMsgs;		/*!< @brief Number of messages in this class that adaptive compression sent uncompressed */
+	RsslUInt64		bytesIn;			/*!< @brief Uncompressed bytes of the compressed messages */
+	RsslUInt64		bytesOut;			/*!< @brief Compressed bytes of the compressed messages */
+	RsslUInt64		compressTimeNsec;	/*!< @brief Time, in nanoseconds, spent compressing the compressed messages.  Only measured while adaptive compression is on. */
+} RsslCompressionBucketStats;
+
+/**
+ * @brief Outbound compression statistics returned by rsslGetChannelInfo call.
+ * Populated for ::RSSL_CONN_TYPE_SOCKET, ::RSSL_CONN_TYPE_ENCRYPTED and ::RSSL_CONN_TYPE_HTTP connections that negotiated compression.
+ * @see rsslGetChannelInfo
+ * @see RsslChannelInfo
+ * @see RSSL_COMPRESSION_MIN_SAVINGS
+ * @see RSSL_COMPRESSION_MAX_COST
+ */
+typedef struct {
+	RsslUInt32					minSavings;		/*!< @brief The ::RSSL_COMPRESSION_MIN_SAVINGS percentage in effect, 0 if adaptive compression is off */
+	RsslUInt32					maxCost;		/*!< @brief The ::RSSL_COMPRESSION_MAX_COST in effect, in nanoseconds per kilobyte saved, 0 if the cost is not limited */
+	RsslCompressionBucketStats	buckets[RSSL_COMP_STATS_BUCKET_COUNT];	/*!< @brief Statistics for each message size class, smallest first */
+} RsslCompressionStats;
+
+
+/**
+ * @brief Number of write priorities, see RsslWritePriorities.
+ * @see RsslPriorityFlushWeights
+ * @see RsslPriorityFlushStats
+ */
+#define RSSL_PRIORITY_COUNT 3
+
+/**
+ * @brief Weighted flushing configuration, passed to rsslIoctl with ::RSSL_PRIORITY_FLUSH_WEIGHTS.
+ * Each time a priority queue gets its turn, it may flush up to its weight in bytes, plus whatever it did not use on
+ * earlier turns; a queue that empties loses its unused allowance.  Over time each busy queue gets a share of the bandwidth
+ * proportional to its weight, however large its messages are.
+ * @see RSSL_PRIORITY_FLUSH_WEIGHTS
+ * @see RsslPriorityFlushStats
+ */
+typedef struct {
+	RsslUInt32		weights[RSSL_PRIORITY_COUNT];	/*!< @brief Bytes each queue may flush per turn, indexed by RsslWritePriorities.  Either all non-zero, or all 0 to turn weighted flushing off. */
+	RsslUInt32		highLatencyBudget;	/*!< @brief If non-zero, a high priority message that has been queued for at least this many microseconds is flushed next, ahead of its turn.  The bytes are still counted against the high priority queue's share. */
+} RsslPriorityFlushWeights;
+
+/**
+ * @brief RsslPriorityFlushWeights initialization, which turns weighted flushing off
+ * @see RsslPriorityFlushWeights
+ */
+#define RSSL_INIT_PRIORITY_FLUSH_WEIGHTS { { 0, 0, 0 }, 0 }
+
+/**
+ * @brief Clears an RsslPriorityFlushWeights, which turns weighted flushing off
+ * @see RsslPriorityFlushWeights
+ */
+RTR_C_INLINE void rsslClearPriorityFlushWeights(RsslPriorityFlushWeights *pWeights)
+{
+	int i;
+
+	for (i = 0; i < RSSL_PRIORITY_COUNT; i++)
+		pWeights->weights[i] = 0;
+	pWeights->highLatencyBudget = 0;
+}
+
+/**
+ * @brief Allocates the buffer a fragmented message of length bytes is reassembled into.
+ * Called from rsslRead() when the first fragment arrives.  Returning NULL fails the read as if the transport could not allocate the memory.
+ * @see RsslReassemblyAllocator
+ */
+typedef char* RsslReassemblyAllocateFunction(RsslChannel *pChannel, RsslUInt32 length, void *userSpecPtr);
+
+/**
+ * @brief Releases a buffer from RsslReassemblyAllocateFunction whose message will never be completed,
+ * because the channel closed or the fragment id was reused before the last fragment arrived.
+ * Buffers returned to the application by rsslRead() are not passed here.
+ * @see RsslReassemblyAllocator
+ */
+typedef void RsslReassemblyFreeFunction(RsslChannel *pChannel, char *buffer, void *userSpecPtr);
+
+/**
+ * @brief Application buffers for fragmented message reassembly, passed to rsslIoctl with ::RSSL_REASSEMBLY_ALLOCATOR.
+ * Each fragment is copied once, straight into the application's buffer, and the completed message can be kept past the next
+ * rsslRead() without copying it again.  The allocator in effect when a message's first fragment arrives is used for that message.
+ * @see RSSL_REASSEMBLY_ALLOCATOR
+ */
+typedef struct {
+	RsslReassemblyAllocateFunction	*allocateBuffer;	/*!< @brief Allocates the reassembly buffer.  Both functions set, or both NULL to let the transport reassemble. */
+	RsslReassemblyFreeFunction		*freeBuffer;		/*!< @brief Releases a buffer whose message was not completed. */
+	void							*userSpecPtr;		/*!< @brief Passed to both functions. */
+} RsslReassemblyAllocator;
+
+/**
+ * @brief RsslReassemblyAllocator initialization, which leaves reassembly to the transport
+ * @see RsslReassemblyAllocator
+ */
+#define RSSL_INIT_REASSEMBLY_ALLOCATOR { NULL, NULL, NULL }
+
+/**
+ * @brief Clears an RsslReassemblyAllocator, which leaves reassembly to the transport
+ * @see RsslReassemblyAllocator
+ */
+RTR_C_INLINE void rsslClearReassemblyAllocator(RsslReassemblyAllocator *pAllocator)
+{
+	pAllocator->allocateBuffer = NULL;
+	pAllocator->freeBuffer = NULL;
+	pAllocator->userSpecPtr = NULL;
+}
+
+/**
+ * @brief Statistics for one priority queue, returned by rsslGetChannelInfo call.
+ * @see RsslPriorityFlushStats
+ */
+typedef struct {
+	RsslUInt32		weight;				/*!< @brief The configured weight, 0 if weighted flushing is off */
+	RsslUInt32		queuedBytes;		/*!< @brief Bytes currently waiting to be flushed */
+	RsslUInt32		queuedBuffers;		/*!< @brief Buffers currently waiting to be flushed */
+	RsslUInt64		oldestWait;			/*!< @brief How long, in microseconds, the oldest waiting buffer has been queued.  Weighted flushing only. */
+	RsslUInt64		flushedBytes;		/*!< @brief Bytes flushed from this queue while weighted flushing was on */
+	RsslUInt64		flushedBuffers;		/*!< @brief Buffers flushed from this queue while weighted flushing was on */
+	RsslUInt64		totalWait;			/*!< @brief Total time, in microseconds, the flushed buffers spent queued; divide by flushedBuffers for the average */
+	RsslUInt64		maxWait;			/*!< @brief Longest time, in microseconds, a flushed buffer spent queued */
+} RsslPriorityQueueStats;
+
+/**
+ * @brief Priority queue statistics returned by rsslGetChannelInfo call.
+ * Populated for ::RSSL_CONN_TYPE_SOCKET, ::RSSL_CONN_TYPE_ENCRYPTED and ::RSSL_CONN_TYPE_HTTP connections.  Queued
+ * bytes and buffers are always reported; the times and flushed counts are kept only while weighted flushing is on.
+ * @see rsslGetChannelInfo
+ * @see RsslChannelInfo
+ * @see RSSL_PRIORITY_FLUSH_WEIGHTS
+ */
+typedef struct {
+	RsslUInt32				highLatencyBudget;	/*!< @brief The configured RsslPriorityFlushWeights::highLatencyBudget */
+	RsslUInt64				budgetFlushes;		/*!< @brief Number of high priority buffers flushed ahead of their turn because they reached the latency budget */
+	RsslPriorityQueueStats	queues[RSSL_PRIORITY_COUNT];	/*!< @brief Statistics for each queue, indexed by RsslWritePriorities */
+} RsslPriorityFlushStats;
+
 
 /**
  * @brief Connected Component Information, used to identify components from across the connection
@@ -309,6 +506,9 @@ typedef struct {
  * @see rsslGetChannelInfo
  * @see RsslMCastStats
  * @see RsslComponentInfo
+ * @see RsslCompressionStats
+ * @see RsslShmemStats
+ * @see RsslPriorityFlushStats
  */
 typedef struct {
 	RsslUInt32 			maxFragmentSize;		 /*!< @brief This is the max fragment size before fragmentation and reassembly is necessary. */ 
@@ -329,6 +529,21 @@ typedef struct {
 	RsslUInt32			componentInfoCount;		 /*!< @brief Number of RsslComponentInfo structures contained in the dynamic componentInfo array */
 	RsslComponentInfo**	componentInfo;			 /*!< @brief A variable length array that contains product version information for the component(s) that this RsslChannel is connected to. The number of RsslComponentInfo structures present in array is indicated by componentInfoCount.  */
 	RsslUInt64			encryptionProtocol;		 /*!< @brief Current encryption protocol used. */
+	RsslCompressionStats	compressionStats;	 /*!< @brief When compression is enabled, statistics about outbound compression for each message size class */
+	RsslShmemStats		shmemStats;				 /*!< @brief When using a ::RSSL_CONN_TYPE_UNIDIR_SHMEM connection, statistics about slow and overrun readers */
+	RsslPriorityFlushStats	priorityFlushStats;	 /*!< @brief Queued bytes and, with ::RSSL_PRIORITY_FLUSH_WEIGHTS, flush wait times for each priority queue */
+	RsslUInt32			coalesceWriteUsec;		 /*!< @brief The time written data may be held before it is flushed, set with ::RSSL_COALESCE_WRITE_USEC; 0 when coalescing is off */
+	RsslUInt32			coalesceFlushUsec;		 /*!< @brief While data is held by ::RSSL_COALESCE_WRITE_USEC, the microseconds left until rsslFlush() will send it; 0 when it is due or nothing is held */
+	RsslUInt64			writeSysCalls;			 /*!< @brief The number of system calls made to write data on this channel */
+	RsslUInt32			autoPackSize;			 /*!< @brief The size of the buffers small messages are packed into, set with ::RSSL_AUTO_PACK_SIZE; 0 when packing is off */
+	RsslUInt64			autoPackedMsgs;			 /*!< @brief The number of messages packed by the transport */
+	RsslUInt64			autoPackedBufs;			 /*!< @brief The number of packed buffers the transport has written; autoPackedMsgs / autoPackedBufs is the average number of messages in each */
+	RsslUInt32			compressionDictId;		 /*!< @brief When ::RSSL_COMP_ZSTD is in use with a compression dictionary both sides share, the ID of that dictionary; otherwise 0 */
+	RsslUInt32			zeroCopyThreshold;		 /*!< @brief Flushes of at least this many bytes use MSG_ZEROCOPY, set with ::RSSL_ZERO_COPY_THRESHOLD; 0 when zero copy is off */
+	RsslUInt32			zeroCopyPendingSends;	 /*!< @brief The number of zero copy sends the kernel has not yet reported complete */
+	RsslUInt32			zeroCopyHeldBuffers;	 /*!< @brief The number of written buffers held until their zero copy sends complete */
+	RsslUInt64			zeroCopyCopiedSends;	 /*!< @brief The number of zero copy sends the kernel reported it had to copy anyway, as it always does on loopback */
+	RsslUInt32			encryptionOffload;		 /*!< @brief For an ::RSSL_CONN_TYPE_ENCRYPTED connection on Linux, the ::RsslEncryptionOffloadFlags for the directions handed to kernel TLS after the handshake.  This is only done when RsslEncryptionOpts::kernelTlsOffload is set, OpenSSL 3.0 or later built with kernel TLS support is loaded, and the kernel takes the negotiated cipher.  Writes then go straight to the socket; reads stay with OpenSSL, which handles the TLS control records. */
 } RsslChannelInfo;
 
 /**
@@ -398,9 +613,10 @@ RSSL_API RsslInt32 rsslBufferUsage(RsslChannel *chnl,
  */
 typedef struct {
 	RsslBool			tcp_nodelay;			/*!< @brief Only used with connectionType of ::RSSL_CONN_TYPE_SOCKET.  If RSSL_TRUE, disables Nagle's Algorithm. */
+	RsslUInt32			autoPackSize;			/*!< @brief If non-zero, small messages written to the channel are packed into buffers of up to this many bytes.  When set in RsslBindOptions, it carries through on all connections accepted with rsslAccept().  See ::RSSL_AUTO_PACK_SIZE. */
 } RsslTcpOpts;
 
-#define RSSL_INIT_TCP_OPTS { RSSL_FALSE }
+#define RSSL_INIT_TCP_OPTS { RSSL_FALSE, 0 }
 
 typedef enum {
 	RSSL_MCAST_NO_FLAGS				= 0x00, /*!< @brief None. */
@@ -445,9 +661,10 @@ typedef struct {
  */
 typedef struct {
 	RsslUInt		maxReaderLag;			/*!<  @brief Maximum number of messages that the client can have waiting to read. If the client "lags" the server by more than this amount, UPA will disconnect the client */
+	RsslBool		resumeOnOverrun;		/*!<  @brief If RSSL_TRUE, a client that lags by more than maxReaderLag (or whose messages were overwritten) skips the oldest messages instead of being disconnected. rsslRead() then returns ::RSSL_RET_SLOW_READER once with the channel still active, and RsslShmemStats::lostMsgs counts the skipped messages. */
 } RsslShmemOpts;
 
-#define RSSL_INIT_SHMEM_OPTS { 0 }
+#define RSSL_INIT_SHMEM_OPTS { 0, RSSL_FALSE }
 
 /**
  * @brief Options used for configuring sequenced multicast specific transport options (::RSSL_CONN_TYPE_SEQ_MCAST).
@@ -457,9 +674,27 @@ typedef struct {
 typedef struct {
 	RsslUInt32		maxMsgSize;			/*!<  @brief Maximum size of messages that the SEQ_MCAST transport will read. */
 	RsslUInt16		instanceId;			/*!<  @brief This is used, when combined with the origin IP address and port, to uniquely identify a sequenced multicast channel. */
+	RsslUInt32		reorderWindow;		/*!<  @brief Enables gap recovery on read when non-zero.  Packets that arrive ahead of a missing sequence number are held, and the missing packet is only treated as lost once more than this many later packets have arrived, a ping shows it was sent, or it has been missing for a few milliseconds.  Held packets are then delivered in sequence order.  0 (the default) hands packets up as they arrive.  Linux only. */
+	RsslUInt32		retransTimeout;		/*!<  @brief Milliseconds to wait for a requested retransmission before the missing packets are skipped.  Used when reorderWindow and retransHostName/retransServiceName are set. */
+	char*			retransHostName;	/*!<  @brief Host of a TCP retransmission server, see RSSL_SEQ_MCAST_RETRANS_VERSION.  When set (with reorderWindow), lost packets are requested from this server and delivered with ::RSSL_READ_OUT_RETRANSMIT.  When not set, lost packets are counted in RsslMCastStats::gapsDetected and skipped. */
+	char*			retransServiceName;	/*!<  @brief Port or service name of the TCP retransmission server. */
 } RsslSeqMCastOpts;
 
-#define RSSL_INIT_SEQ_MCAST_OPTS { 3000, 0 }
+#define RSSL_INIT_SEQ_MCAST_OPTS { 3000, 0, 0, 50, 0, 0 }
+
+/**
+ * @brief Version of the sequenced multicast retransmission protocol.
+ *
+ * A retransmission server accepts TCP connections.  Each request is RSSL_SEQ_MCAST_RETRANS_REQ_LEN bytes, 
+ * all in network byte order: version (1 byte), reserved (1 byte), instance ID (2 bytes), sender IPv4 address (4 bytes), 
+ * sender port (2 bytes), count (2 bytes), first sequence number (4 bytes).  For each request, in order, the server sends 
+ * the requested packets it still has, each as a 2 byte length followed by the packet exactly as it was multicast 
+ * (optionally with the retransmit header flag set), and then a 2 byte length of 0.
+ * A reference server is provided in Applications/Examples/SeqMcastRetransServer.
+ */
+#define RSSL_SEQ_MCAST_RETRANS_VERSION 1
+#define RSSL_SEQ_MCAST_RETRANS_REQ_LEN 16
+
 typedef struct {
 	char* proxyHostName;
 	char* proxyPort;
@@ -474,6 +709,15 @@ typedef enum {
 	RSSL_ENC_TLSV1_2 = 0x04				/*!< @brief (0x08) Encryption using TLSv1.2 protocol */
 } RsslEncryptionProtocolTypes;
 
+/** @brief Flags for the directions of an encrypted connection whose records are handled by the kernel (Linux kernel TLS) rather than by OpenSSL.
+ *  see RsslChannelInfo::encryptionOffload
+ */
+typedef enum {
+	RSSL_ENC_OFFLOAD_NONE		= 0x00,	/*!< @brief (0x00) Records are encrypted and decrypted by OpenSSL, or the connection is not encrypted. */
+	RSSL_ENC_OFFLOAD_KTLS_TX	= 0x01,	/*!< @brief (0x01) Written data is encrypted by the kernel. */
+	RSSL_ENC_OFFLOAD_KTLS_RX	= 0x02	/*!< @brief (0x02) Read data is decrypted by the kernel. */
+} RsslEncryptionOffloadFlags;
+
 
 
 /** @brief Options used for configuring an encrypted tunneled connection (::RSSL_CONN_TYPE_ENCRYPTED).
@@ -482,9 +726,10 @@ typedef enum {
  */
 typedef struct {
 	RsslUInt32 encryptionProtocolFlags;
+	RsslBool kernelTlsOffload;	/*!< @brief Linux only.  If RSSL_TRUE, OpenSSL is asked to hand the record encryption to the kernel (kernel TLS) once the handshake completes; see RsslChannelInfo::encryptionOffload for the directions it did.  Defaults to RSSL_FALSE. */
 } RsslEncryptionOpts;
 
-#define RSSL_INIT_ENCRYPTION_OPTS { RSSL_ENC_TLSV1 | RSSL_ENC_TLSV1_1 | RSSL_ENC_TLSV1_2}
+#define RSSL_INIT_ENCRYPTION_OPTS { RSSL_ENC_TLSV1 | RSSL_ENC_TLSV1_1 | RSSL_ENC_TLSV1_2, RSSL_FALSE }
 
 
 
@@ -553,7 +798,7 @@ typedef struct {
 	char*				hostName;				/*!< @deprecated DEPRECATED: Hostname to connect to/join. All data is exchanged on this hostName:serviceName combination.  This option will only function for the SOCKET, HTTP, and ENCRYPTED connection types.  Users should migrate to the RsslConnectOptions::connectionInfo::unified::address configuration for the same behavior with current and future connection types */
 	char*				serviceName;			/*!< @deprecated DEPRECATED: Port number or service name to connect to/join.  All data is exchanged on this hostName:serviceName combination.  This option will only function for the SOCKET, HTTP, and ENCRYPTED connection types.  Users should migrate to the RsslConnectOptions::connectionInfo::unified::serviceName configuration for the same behavior with current and future connection types */
 	char				*objectName;			/*!< @brief When using connection type of ::RSSL_CONN_TYPE_HTTP or ::RSSL_CONN_TYPE_ENCRYPTED, this can be used as an object name to pass with the URL in underlying HTTP connection messages */
-	RsslConnectionTypes	connectionType;			/*!< @brief If ::RSSL_CONN_TYPE_ENCRYPTED this will use encryption, if ::RSSL_CONN_TYPE_HTTP this will use unencrypted http tunneling, if ::RSSL_CONN_TYPE_UNIDIR_SHMEM this will use server to client shared memory */
+	RsslConnectionTypes	connectionType;			/*!< @brief If ::RSSL_CONN_TYPE_ENCRYPTED this will use encryption, if ::RSSL_CONN_TYPE_HTTP this will use unencrypted http tunneling, if ::RSSL_CONN_TYPE_UNIDIR_SHMEM this will use server to client shared memory, if ::RSSL_CONN_TYPE_BIDIR_SHMEM this will use full-duplex shared memory to a server on the same host */
 	RsslConnectionInfo	connectionInfo;			/*!< @brief Information about the network hosts/addresses, ports, and network interface cards to leverage during connection.  This configuration offers configuration for various network topologies and can be used for all connection types.  */
 	RsslCompTypes		compressionType;		/*!< @brief Which compression type, if any, to attempt to negotiate. Compression is only supported for connectionType of SOCKET, HTTP, or ENCRYPTED */	
 	RsslBool			blocking;				/*!< @brief If RSSL_TRUE, the connection will block. */
@@ -575,13 +820,14 @@ typedef struct {
 	char*				componentVersion;		/*!< @brief User defined component version information*/
 	RsslEncryptionOpts  encryptionOpts;
 	RsslELOpts			extLineOptions;			/* Extended Line specific options */
+	RsslBuffer			compressionDictionary;	/*!< @brief Optional pre-trained Zstandard dictionary (as produced by 'zstd --train') to use when ::RSSL_COMP_ZSTD is negotiated.  Its dictionary ID is sent in the handshake and the dictionary is only used if the server was bound with the same one.  The contents are copied by rsslConnect(). */
 } RsslConnectOptions;
 
 /**
  * @brief RSSL Connect Options initialization
  * @see RsslConnectOptions
  */
-#define RSSL_INIT_CONNECT_OPTS { 0, 0, 0, RSSL_CONN_TYPE_SOCKET, RSSL_INIT_CONNECTION_INFO, RSSL_COMP_NONE, RSSL_FALSE, RSSL_FALSE, 60, 50, 10, 0, 0, 0, 0, 0, 0, RSSL_INIT_TCP_OPTS, RSSL_INIT_MCAST_OPTS, RSSL_INIT_SHMEM_OPTS, RSSL_INIT_SEQ_MCAST_OPTS, RSSL_INIT_PROXY_OPTS, 0, RSSL_INIT_ENCRYPTION_OPTS, RSSL_INIT_EL_OPTS }
+#define RSSL_INIT_CONNECT_OPTS { 0, 0, 0, RSSL_CONN_TYPE_SOCKET, RSSL_INIT_CONNECTION_INFO, RSSL_COMP_NONE, RSSL_FALSE, RSSL_FALSE, 60, 50, 10, 0, 0, 0, 0, 0, 0, RSSL_INIT_TCP_OPTS, RSSL_INIT_MCAST_OPTS, RSSL_INIT_SHMEM_OPTS, RSSL_INIT_SEQ_MCAST_OPTS, RSSL_INIT_PROXY_OPTS, 0, RSSL_INIT_ENCRYPTION_OPTS, RSSL_INIT_EL_OPTS, RSSL_INIT_BUFFER }
 
 
 /**
@@ -615,6 +861,7 @@ RTR_C_INLINE void rsslClearConnectOpts(RsslConnectOptions *opts)
 	opts->protocolType = 0;
 	opts->userSpecPtr = 0;
 	opts->tcpOpts.tcp_nodelay = RSSL_FALSE;
+	opts->tcpOpts.autoPackSize = 0;
 	opts->multicastOpts.flags = RSSL_MCAST_NO_FLAGS;
 	opts->multicastOpts.disconnectOnGaps = RSSL_FALSE;
 	opts->multicastOpts.packetTTL = 5;
@@ -636,15 +883,22 @@ RTR_C_INLINE void rsslClearConnectOpts(RsslConnectOptions *opts)
 	opts->multicastOpts.tcpControlPort = NULL;
 	opts->multicastOpts.portRoamRange = 0;
 	opts->shmemOpts.maxReaderLag = 0;
+	opts->shmemOpts.resumeOnOverrun = RSSL_FALSE;
 	opts->sysSendBufSize = 0;
 	opts->sysRecvBufSize = 0;
 	opts->seqMulticastOpts.maxMsgSize = 3000;
 	opts->seqMulticastOpts.instanceId = 0;
+	opts->seqMulticastOpts.reorderWindow = 0;
+	opts->seqMulticastOpts.retransTimeout = 50;
+	opts->seqMulticastOpts.retransHostName = 0;
+	opts->seqMulticastOpts.retransServiceName = 0;
 	opts->proxyOpts.proxyHostName = 0;
 	opts->proxyOpts.proxyPort = 0;
 	opts->componentVersion = NULL;
 	opts->encryptionOpts.encryptionProtocolFlags = RSSL_ENC_TLSV1 | RSSL_ENC_TLSV1_1 | RSSL_ENC_TLSV1_2;
+	opts->encryptionOpts.kernelTlsOffload = RSSL_FALSE;
 	opts->extLineOptions.numConnections = 20;
+	rsslClearBuffer(&opts->compressionDictionary);
 }
 
 /**
@@ -717,6 +971,7 @@ typedef struct {
 typedef struct {
 	RsslUInt32 	currentBufferUsage;  /*!< @brief This is the current buffer usage for the server. */ 
 	RsslUInt32 	peakBufferUsage;	 /*!< @brief This is the peak buffer usage for the server. */ 
+	RsslShmemStats	shmemStats;		 /*!< @brief For a ::RSSL_CONN_TYPE_UNIDIR_SHMEM server, statistics about slow and overrun readers. */
 } RsslServerInfo;
 
 /**
@@ -787,14 +1042,14 @@ typedef struct {
 	char			*serviceName;			/*!< @brief Local port number or service name to bind to. */
 	char			*interfaceName;			/*!< @brief Network interface card to bind to.  If NULL, will use default NIC */
 	RsslUInt32		compressionType;		/*!< @brief Bitmask of RsslCompTypes compression types supported by the server */
-	RsslUInt32		compressionLevel;		/*!< @brief Level of compression to use, 1: More speed - 9: More compression. */
+	RsslUInt32		compressionLevel;		/*!< @brief Level of compression to use, 1: More speed - 9: More compression.  For ::RSSL_COMP_ZSTD the range is 1 to 22, and 0 selects the zstd default level. */
 	RsslBool		forceCompression;		/*!< @brief Lets the server force the client to use compression */
 	RsslBool		serverBlocking;			/*!< @brief If RSSL_TRUE, the server will be allowed to block. */
 	RsslBool		channelsBlocking;		/*!< @brief If RSSL_TRUE, the channels will be allowed to block. */
 	RsslBool		tcp_nodelay;			/*!< @deprecated DEPRECATED: Only used with connectionType of SOCKET.  If RSSL_TRUE, disables Nagle's Algorithm. Users should migrate to the RsslBindOptions::tcpOpts::tcp_nodelay configuration for the same behavior with current and future connection types */
 	RsslBool		serverToClientPings;	/*!< @brief If RSSL_TRUE, pings will be sent from server side to client side */
 	RsslBool		clientToServerPings;	/*!< @brief If RSSL_TRUE, pings will be sent from client side to server side */
-	RsslConnectionTypes	connectionType;		/*!< @brief If RSSL_CONN_TYPE_UNIDIR_SHMEM this will use server to client shared memory.  Setting to RSSL_CONN_TYPE_SOCKET or RSSL_CONN_TYPE_HTTP will allow for accepting both socket or HTTP connection types.  RSSL_CONN_TYPE_ENCRYPTED is currently not supported for servers  */
+	RsslConnectionTypes	connectionType;		/*!< @brief If RSSL_CONN_TYPE_UNIDIR_SHMEM this will use server to client shared memory.  Setting to RSSL_CONN_TYPE_SOCKET or RSSL_CONN_TYPE_HTTP will allow for accepting both socket or HTTP connection types.  RSSL_CONN_TYPE_ENCRYPTED is currently not supported for servers.  RSSL_CONN_TYPE_BIDIR_SHMEM accepts full-duplex shared memory connections from the same host only.  */
 	RsslUInt32		pingTimeout;			/*!< @brief Desired amount of time to use as a timeout for a connected channel. */
 	RsslUInt32		minPingTimeout;			/*!< @brief Least amount of time to use as a timeout for a connected channel. */
 	RsslUInt32		maxFragmentSize;		/*!< @brief Sets the maximum size fragment to be sent without any fragmentation or assembly of messages. */
@@ -811,6 +1066,10 @@ typedef struct {
 	void			*userSpecPtr;			/*!< @brief A user specified pointer, returned as userSpecPtr of the RsslServer. */ 
 	RsslTcpOpts		tcpOpts;				/*!< @brief TCP transport specific options (used by RSSL_CONN_TYPE_SOCKET and RSSL_CONN_TYPE_HTTP). */
 	char*			componentVersion;		/*!< @brief User defined component version information */
+	RsslUInt32		sharedPoolCacheSize;	/*!< @brief Sets the number of shared pool buffers each accepted channel may keep cached, so that the shared pool is locked once per batch of buffers instead of once per buffer.  Cached buffers do not count towards a channel's buffer usage.  Setting of 0 disables the cache. */
+	RsslBuffer		compressionDictionary;	/*!< @brief Optional pre-trained Zstandard dictionary (as produced by 'zstd --train') offered to clients that negotiate ::RSSL_COMP_ZSTD.  It is used on a connection only when the client presents the same dictionary ID, in which case every message is compressed on its own against the dictionary.  The contents are copied by rsslBind(). */
+	RsslBool		serverSharedSocket;		/*!< @brief If RSSL_TRUE, the listening socket is opened with SO_REUSEPORT so that several RsslServers, in this or other processes, can be bound to the same serviceName and interfaceName.  The kernel spreads incoming connections across them, so each can be accepted from its own thread or reactor.  Every server sharing the port must set this option.  Only supported on Linux, with RSSL_CONN_TYPE_SOCKET. */
+	RsslUInt32		handshakeThreads;		/*!< @brief If non-zero, the server starts this many threads that complete the connection handshake of accepted channels, so that a burst of connecting clients does not hold up the thread calling rsslInitChannel().  The first rsslInitChannel() call hands the channel over and changes its socketId to a descriptor that becomes readable when negotiation is done (::RSSL_IP_FD_CHANGE); the next call changes it back to the connection, and the one after that, made once the connection is readable or writable, returns ::RSSL_RET_SUCCESS.  While a channel is being negotiated only rsslInitChannel() and rsslCloseChannel() may be called on it.  Setting this also locks the server's shared buffer pool, and requires rsslInitialize() to have been called with locking enabled.  Only supported on Linux, and not used for channels of a blocking server or with blocking sessions. */
 } RsslBindOptions;
 
 
@@ -818,7 +1077,7 @@ typedef struct {
  * @brief RSSL Bind Options initialization
  * @see RsslBindOptions
  */
-#define RSSL_INIT_BIND_OPTS { 0, 0, RSSL_COMP_NONE, 0, RSSL_FALSE, RSSL_FALSE, RSSL_FALSE, RSSL_FALSE, RSSL_TRUE, RSSL_TRUE, RSSL_CONN_TYPE_SOCKET, 60, 20, 6144, 50, 50, 10, 0, RSSL_FALSE, 0, 0, 0, 0, 0, 0, RSSL_INIT_TCP_OPTS, 0 }
+#define RSSL_INIT_BIND_OPTS { 0, 0, RSSL_COMP_NONE, 0, RSSL_FALSE, RSSL_FALSE, RSSL_FALSE, RSSL_FALSE, RSSL_TRUE, RSSL_TRUE, RSSL_CONN_TYPE_SOCKET, 60, 20, 6144, 50, 50, 10, 0, RSSL_FALSE, 0, 0, 0, 0, 0, 0, RSSL_INIT_TCP_OPTS, 0, 0, RSSL_INIT_BUFFER, RSSL_FALSE, 0 }
 
 /**
  * @brief Clears RSSL Bind Options 
@@ -854,9 +1113,14 @@ RTR_C_INLINE void rsslClearBindOpts(RsslBindOptions *opts)
 	opts->protocolType = 0;
 	opts->userSpecPtr = 0;
 	opts->tcpOpts.tcp_nodelay = RSSL_FALSE;
+	opts->tcpOpts.autoPackSize = 0;
 	opts->sysSendBufSize = 0;
 	opts->sysRecvBufSize = 0;
 	opts->componentVersion = NULL;
+	opts->sharedPoolCacheSize = 0;
+	rsslClearBuffer(&opts->compressionDictionary);
+	opts->serverSharedSocket = RSSL_FALSE;
+	opts->handshakeThreads = 0;
 }
 
 /**
@@ -1089,7 +1353,9 @@ typedef enum {
 	RSSL_READ_OUT_HASH_ID		= 0x0008,	/*!< (0x08) set when a hash ID is returned */
 	RSSL_READ_OUT_UNICAST		= 0x0010,	/*!< (0x10) set when the message was sent unicast to this node */
 	RSSL_READ_OUT_INSTANCE_ID	= 0x0020,	/*!< (0x20) set when the message has an instance ID set */
-	RSSL_READ_OUT_RETRANSMIT     = 0x0040  	/*!< (0x40) indicates that this message is a retransmission of previous content*/
+	RSSL_READ_OUT_RETRANSMIT     = 0x0040,  	/*!< (0x40) indicates that this message is a retransmission of previous content*/
+	RSSL_READ_OUT_RECV_TIMESTAMP	= 0x0080,	/*!< (0x80) set when recvTimestamp is returned, see ::RSSL_RECV_TIMESTAMPS */
+	RSSL_READ_OUT_CALLER_BUFFER	= 0x0100	/*!< (0x100) set when the returned buffer was reassembled into memory from RsslReassemblyAllocator::allocateBuffer; the application now owns it, see ::RSSL_REASSEMBLY_ALLOCATOR */
 } RsslReadOutFlags;
 
 typedef struct {
@@ -1110,12 +1376,13 @@ typedef struct {
 		RsslUInt8				FTGroupId;				/*!< The FTGroup of the node that sent this message */
 		RsslUInt16				instanceId;				/*!< The instance ID of the sender's channel.  When combined with the sender's IP address and port, contained in the nodeId, 
 															 this can be used to identify the specific channel that sent this message. */
+		RsslUInt64				recvTimestamp;			/*!< Kernel receive time of the last byte of this buffer, in nanoseconds since the epoch (CLOCK_REALTIME).  Set when ::RSSL_READ_OUT_RECV_TIMESTAMP is present. */
 } RsslReadOutArgs;
 
 /**
  * @brief RsslReadOutArgs static initialization
  */
-#define RSSL_INIT_READ_OUT_ARGS {RSSL_READ_OUT_NO_FLAGS, 0, 0, 0, {0, 0}, 0, 0, 0}
+#define RSSL_INIT_READ_OUT_ARGS {RSSL_READ_OUT_NO_FLAGS, 0, 0, 0, {0, 0}, 0, 0, 0, 0}
 
 /**
  * @brief Clears the RsslReadInArgs structure passed in
@@ -1135,6 +1402,7 @@ RTR_C_INLINE void rsslClearReadOutArgs(RsslReadOutArgs *readOutArgs)
 	readOutArgs->bytesRead = 0;
 	readOutArgs->readOutFlags = RSSL_READ_OUT_NO_FLAGS;
 	readOutArgs->uncompressedBytesRead = 0;
+	readOutArgs->recvTimestamp = 0;
 }
 
 /**
@@ -1411,6 +1679,74 @@ RSSL_API RsslRet rsslWriteEx(RsslChannel *chnl,
 									 RsslWriteOutArgs *writeOutArgs,
 									 RsslError	*error);
 
+/**
+ * @brief A channel that rsslWriteToChannels writes to, and the outcome of that write
+ * @see rsslWriteToChannels
+ */
+typedef struct {
+	RsslChannel			*channel;		/*!< @brief Channel to write the message to. */
+	RsslInt32			streamId;		/*!< @brief Stream Id of the message on this channel, replacing the encoded one. 0 keeps the encoded stream Id. */
+	RsslRet				writeRet;		/*!< @brief Set to what rsslWriteEx would have returned for this channel: the number of bytes pending flush, or an RsslReturnCodes value. */
+	RsslWriteOutArgs	writeOutArgs;	/*!< @brief Set to the output values of the write to this channel. */
+	RsslError			error;			/*!< @brief Set to the error of the write to this channel, when writeRet is a failure. */
+} RsslWriteTarget;
+
+/**
+ * @brief Clears the RsslWriteTarget structure passed in
+ * @param writeTarget a pointer to the RsslWriteTarget structure to be cleared
+ */
+RTR_C_INLINE void rsslClearWriteTarget(RsslWriteTarget *writeTarget)
+{
+	writeTarget->channel = 0;
+	writeTarget->streamId = 0;
+	writeTarget->writeRet = RSSL_RET_SUCCESS;
+	rsslClearWriteOutArgs(&writeTarget->writeOutArgs);
+	writeTarget->error.channel = 0;
+	writeTarget->error.rsslErrorId = RSSL_RET_SUCCESS;
+	writeTarget->error.sysError = 0;
+	writeTarget->error.text[0] = '\0';
+}
+
+/**
+ * @brief Writes one message to several channels
+ *
+ * Typical use:<BR>
+ * rsslWriteToChannels is called by a provider fanning the same content out to
+ * many consumers.  The message is encoded once, into a buffer from rsslGetBuffer
+ * on chnl, and is written to each target channel in turn, with its stream Id
+ * replaced by the target's when that is set.  Channels of the
+ * ::RSSL_CONN_TYPE_SOCKET and ::RSSL_CONN_TYPE_ENCRYPTED types that send the same
+ * bytes, i.e. that need the same stream Id and neither compress the message nor
+ * need to fragment it, queue one shared copy of it rather than copying it each;
+ * other channels are written a copy, as if with rsslGetBuffer and rsslWriteEx.
+ * chnl need not be one of the targets.
+ *
+ * A shared copy counts as one of the target channel's output buffers, against its
+ * guaranteedOutputBuffers and maxOutputBuffers, until it is written.  A target
+ * that has none left fails with ::RSSL_RET_BUFFER_NO_BUFFERS, as rsslGetBuffer would.
+ *
+ * The outcome of each write is set in its target, and a channel that fails is
+ * handled as after a failed rsslWriteEx.  Unless this returns a failure, the
+ * buffer is released, whatever the outcome of the individual writes.
+ *
+ * @note Data is not written across the network until rsslFlush is called, as with rsslWrite.
+ *
+ * @param chnl RSSL Channel the buffer was obtained from
+ * @param buffer Buffer holding an encoded message, not a packed buffer
+ * @param writeInArgs input arguments to every write (RsslWriteInArgs); rsslPriority must be a valid RsslWritePriorities value
+ * @param targets channels to write the message to, and the outcome of each write
+ * @param targetCount number of targets
+ * @param error RSSL Error, to be populated when this returns a failure.  The errors of writes to the targets are set in the targets.
+ * @return RsslRet RSSL_RET_SUCCESS once the message has been written to each of the targets, each writeRet holding the outcome; otherwise a failure RsslReturnCodes value, in which case nothing was written and the buffer is not released
+ * @see RsslWriteTarget, rsslWriteEx
+ */
+RSSL_API RsslRet rsslWriteToChannels(RsslChannel *chnl,
+									 RsslBuffer *buffer,
+									 RsslWriteInArgs *writeInArgs,
+									 RsslWriteTarget *targets,
+									 RsslUInt32 targetCount,
+									 RsslError	*error);
+
 
 /**
  * @brief Flushes data waiting to be written on a given channel
@@ -1481,7 +1817,8 @@ typedef enum {
 	RSSL_TRACE_HEX					= 0x00000008, /*< (0x00000008) Display hex values of all messages */
 	RSSL_TRACE_TO_FILE_ENABLE		= 0x00000010, /*< (0x00000010) Enables tracing to a file*/ 
 	RSSL_TRACE_TO_MULTIPLE_FILES    = 0x00000020, /*< (0x00000020) If set, starts writing to a new file if traceMsgMaxFileSize is reached. If disabled, file writing stops when traceMsgMaxFileSize is reached*/
-	RSSL_TRACE_TO_STDOUT			= 0x00000040  /*< (0x00000040) Writes the xml trace to stdout. If a non-null value is also provided for traceMsgFileName, writing will be done to stdout and the specified file*/
+	RSSL_TRACE_TO_STDOUT			= 0x00000040, /*< (0x00000040) Writes the xml trace to stdout. If a non-null value is also provided for traceMsgFileName, writing will be done to stdout and the specified file*/
+	RSSL_TRACE_BINARY				= 0x00000080  /*< (0x00000080) Records the raw messages, with a timestamp, to a binary file named after traceMsgFileName with a ".bin" extension. Messages are copied into a per-channel buffer and written to the file by a background thread, so nothing is formatted on the calling thread. Follows RSSL_TRACE_READ, RSSL_TRACE_WRITE, RSSL_TRACE_PING, traceMsgMaxFileSize and RSSL_TRACE_TO_MULTIPLE_FILES, and may be set without RSSL_TRACE_TO_FILE_ENABLE or RSSL_TRACE_TO_STDOUT. Messages are not recorded while the buffer is full. The TraceConverter tool converts a file to the XML trace. @see RsslBinaryTraceFileHeader */
 } RsslTraceCodes;
 
 /**
@@ -12,6 +12,7 @@
   * 
   * Overview of usage:
   * - rsslCreateNotifier creates an RsslNotifier that can wait on file descriptors.
+  *     rsslCreateNotifierEx can be used instead to select the notification mechanism (see RsslNotifierType).
   * - rsslCreateNotifierEvent creates an RsslNotifierEvent, associated with a file descriptor.
   * - rsslNotifierAddEvent adds the RsslNotifierEvent to the RsslNotifier.
   * - rsslNotifierRegisterRead/rsslNotifierRegisterWrite enable read/write notification for the RsslNotifierEvent.
@@ -40,6 +41,18 @@ extern "C"
 {
 #endif
 
+/* Notification mechanism used by an RsslNotifier. */
+typedef enum
+{
+	RSSL_NOTIFIER_TYPE_DEFAULT = 0,		/* Platform default: select on Windows, poll elsewhere. */
+	RSSL_NOTIFIER_TYPE_POLL = 1,		/* Use select(Windows) or poll. Cost of each wait grows with the number of events. */
+	RSSL_NOTIFIER_TYPE_EPOLL = 2,		/* Linux only; level-triggered epoll. Cost of each wait grows only with the number of notified events.
+										 * Falls back to RSSL_NOTIFIER_TYPE_POLL where epoll is not available. */
+	RSSL_NOTIFIER_TYPE_EPOLL_EDGE = 3	/* Linux only; edge-triggered epoll. An event is only notified again after its descriptor
+										 * has been read from or written to until it would block.
+										 * Falls back to RSSL_NOTIFIER_TYPE_POLL where epoll is not available. */
+} RsslNotifierType;
+
 /* Flags for notifier events. */
 typedef enum
 {
@@ -67,7 +80,9 @@ RTR_C_INLINE int rsslNotifierEventIsWritable(RsslNotifierEvent *pEvent)
 
 /* Indicates whether the event's file descriptor may be invalid.  The event may need its associated FD to be updated.
  *   Note: When the notifier uses select for notification, this will be set on every descriptor when
- *   it sees the EBADF error. When the notifier uses poll, it will be set only on appropriate events. */
+ *   it sees the EBADF error. When the notifier uses poll, it will be set only on appropriate events.
+ *   When the notifier uses epoll, it will be set on an event whose descriptor was found to be closed
+ *   while registering or unregistering notification for it. */
 RTR_C_INLINE int rsslNotifierEventIsFdBad(RsslNotifierEvent *pEvent)
 {
 	return pEvent->notifiedFlags & RSSL_NESF_BAD_FD;
@@ -100,10 +115,19 @@ typedef struct
  * - maxEventsHint: The likely max number of associated events. Setting appropriately may improve performance. */
 RSSL_API RsslNotifier *rsslCreateNotifier(int maxEventsHint);
 
+/* Initializes an RsslNotifier that uses the given notification mechanism.
+ * - maxEventsHint: The likely max number of associated events. Setting appropriately may improve performance.
+ * - notifierType: The notification mechanism to use. See RsslNotifierType. */
+RSSL_API RsslNotifier *rsslCreateNotifierEx(int maxEventsHint, RsslNotifierType notifierType);
+
+/* Returns the notification mechanism actually used by an RsslNotifier. */
+RSSL_API RsslNotifierType rsslNotifierGetType(RsslNotifier *pNotifier);
+
 /* Cleans up resources associated with an RsslNotifier. */
 RSSL_API void rsslDestroyNotifier(RsslNotifier *pNotifier);
 
-/* Adds an RsslNotifierEvent to the RsslNotifier. */
+/* Adds an RsslNotifierEvent to the RsslNotifier.
+ * When the notifier uses epoll, fails if the descriptor is already associated with another event on this notifier. */
 RSSL_API int rsslNotifierAddEvent(RsslNotifier *pNotifier, RsslNotifierEvent *pEvent, RsslSocket fd, void *object);
 
 /* Removes an RsslNotifierEvent from the RsslNotifier. */
@@ -225,6 +225,44 @@ RTR_C_INLINE RsslRet rsslDeepCopyConnectOpts(RsslConnectOptions *destOpts, RsslC
 
 		strncpy(destOpts->multicastOpts.tcpControlPort, sourceOpts->multicastOpts.tcpControlPort, tempLen);
 	}
+
+	if (sourceOpts->seqMulticastOpts.retransHostName != 0)
+	{
+		tempLen = (strlen(sourceOpts->seqMulticastOpts.retransHostName)+1)*sizeof(char);
+		destOpts->seqMulticastOpts.retransHostName = (char*)malloc(tempLen);
+
+		if (destOpts->seqMulticastOpts.retransHostName == 0)
+		{
+			return RSSL_RET_FAILURE;
+		}
+
+		strncpy(destOpts->seqMulticastOpts.retransHostName, sourceOpts->seqMulticastOpts.retransHostName, tempLen);
+	}
+
+	if (sourceOpts->seqMulticastOpts.retransServiceName != 0)
+	{
+		tempLen = (strlen(sourceOpts->seqMulticastOpts.retransServiceName)+1)*sizeof(char);
+		destOpts->seqMulticastOpts.retransServiceName = (char*)malloc(tempLen);
+
+		if (destOpts->seqMulticastOpts.retransServiceName == 0)
+		{
+			return RSSL_RET_FAILURE;
+		}
+
+		strncpy(destOpts->seqMulticastOpts.retransServiceName, sourceOpts->seqMulticastOpts.retransServiceName, tempLen);
+	}
+
+	if (sourceOpts->compressionDictionary.length != 0)
+	{
+		destOpts->compressionDictionary.data = (char*)malloc(sourceOpts->compressionDictionary.length);
+
+		if (destOpts->compressionDictionary.data == 0)
+		{
+			return RSSL_RET_FAILURE;
+		}
+
+		memcpy(destOpts->compressionDictionary.data, sourceOpts->compressionDictionary.data, sourceOpts->compressionDictionary.length);
+	}
 	
 	
 	return RSSL_RET_SUCCESS;
@@ -281,6 +319,11 @@ RTR_C_INLINE void rsslFreeConnectOpts(RsslConnectOptions *connOpts)
 	{
 		free(connOpts->componentVersion);
 	}
+
+	if(connOpts->compressionDictionary.data != 0)
+	{
+		free(connOpts->compressionDictionary.data);
+	}
 	
 	if(connOpts->proxyOpts.proxyHostName != 0)
 	{
@@ -312,6 +355,16 @@ RTR_C_INLINE void rsslFreeConnectOpts(RsslConnectOptions *connOpts)
 		free(connOpts->multicastOpts.tcpControlPort);
 	}
 
+	if(connOpts->seqMulticastOpts.retransHostName != 0)
+	{
+		free(connOpts->seqMulticastOpts.retransHostName);
+	}
+
+	if(connOpts->seqMulticastOpts.retransServiceName != 0)
+	{
+		free(connOpts->seqMulticastOpts.retransServiceName);
+	}
+
 	memset(connOpts, 0, sizeof(RsslConnectOptions));
 }
 
@@ -166,6 +166,7 @@ static RsslRDMDictionaryRefresh fieldDictionaryRefresh, enumDictionaryRefresh;
 static void reactorUnitTests_AutoMsgs();
 static void reactorUnitTests_Raise();
 static void reactorUnitTests_InitializationAndPingTimeout();
+static void reactorUnitTests_BusyPollPingTimeout();
 static void reactorUnitTests_ShortPingInterval();
 static void reactorUnitTests_InvalidArguments();
 static void reactorUnitTests_BigDirectoryMsg();
@@ -252,6 +253,11 @@ TEST_F(ReactorUtilTest, InitializationAndPingTimeout)
 	reactorUnitTests_InitializationAndPingTimeout();
 }
 
+TEST_F(ReactorUtilTest, BusyPollPingTimeout)
+{
+	reactorUnitTests_BusyPollPingTimeout();
+}
+
 TEST_F(ReactorUtilTest, ShortPingInterval)
 {
 	reactorUnitTests_ShortPingInterval();
@@ -282,6 +288,141 @@ TEST_F(ReactorUtilTest, ManyConnections)
 	reactorUnitTests_ManyConnections();
 }
 #endif
+
+#ifndef _WIN32
+/* Tests notification with each notifier type: only written descriptors are notified, removed events are not
+ * reported, and a closed descriptor is reported as bad. */
+static void reactorUnitTests_NotifierType(RsslNotifierType notifierType)
+{
+	RsslNotifier *pNotifier;
+	RsslNotifierEvent *pEvents[16];
+	int pipeFds[16][2];
+	int i;
+	char byte = 0;
+
+	ASSERT_TRUE((pNotifier = rsslCreateNotifierEx(4, notifierType)) != NULL);
+
+	for (i = 0; i < 16; ++i)
+	{
+		ASSERT_TRUE(pipe(pipeFds[i]) == 0);
+		ASSERT_TRUE((pEvents[i] = rsslCreateNotifierEvent()) != NULL);
+		ASSERT_TRUE(rsslNotifierAddEvent(pNotifier, pEvents[i], pipeFds[i][0], &pipeFds[i]) == 0);
+		ASSERT_TRUE(rsslNotifierRegisterRead(pNotifier, pEvents[i]) == 0);
+	}
+
+	/* Nothing written. */
+	ASSERT_TRUE(rsslNotifierWait(pNotifier, 0) == 0);
+	ASSERT_TRUE(pNotifier->notifiedEventCount == 0);
+
+	ASSERT_TRUE(write(pipeFds[3][1], &byte, 1) == 1);
+	ASSERT_TRUE(write(pipeFds[12][1], &byte, 1) == 1);
+
+	ASSERT_TRUE(rsslNotifierWait(pNotifier, 100000) == 2);
+	ASSERT_TRUE(pNotifier->notifiedEventCount == 2);
+	for (i = 0; i < pNotifier->notifiedEventCount; ++i)
+	{
+		ASSERT_TRUE(rsslNotifierEventIsReadable(pNotifier->notifiedEvents[i]));
+		ASSERT_TRUE(rsslNotifierEventGetObject(pNotifier->notifiedEvents[i]) == &pipeFds[3]
+				|| rsslNotifierEventGetObject(pNotifier->notifiedEvents[i]) == &pipeFds[12]);
+	}
+
+	/* Removed event is no longer notified. */
+	ASSERT_TRUE(rsslNotifierRemoveEvent(pNotifier, pEvents[3]) == 0);
+
+	if (rsslNotifierGetType(pNotifier) == RSSL_NOTIFIER_TYPE_EPOLL_EDGE)
+	{
+		/* Data is still unread, but edge-triggered notification does not repeat it. */
+		ASSERT_TRUE(rsslNotifierWait(pNotifier, 0) == 0);
+	}
+	else
+	{
+		ASSERT_TRUE(rsslNotifierWait(pNotifier, 100000) == 1);
+		ASSERT_TRUE(rsslNotifierEventGetObject(pNotifier->notifiedEvents[0]) == &pipeFds[12]);
+	}
+	ASSERT_TRUE(read(pipeFds[12][0], &byte, 1) == 1);
+
+	/* Descriptor closed while still associated with an event. */
+	close(pipeFds[7][0]);
+	ASSERT_TRUE(rsslNotifierUnregisterRead(pNotifier, pEvents[7]) == 0);
+	ASSERT_TRUE(rsslNotifierRegisterRead(pNotifier, pEvents[7]) == 0);
+	ASSERT_TRUE(rsslNotifierWait(pNotifier, 100000) >= 1);
+	ASSERT_TRUE(rsslNotifierEventIsFdBad(pEvents[7]));
+
+	ASSERT_TRUE(rsslNotifierRemoveEvent(pNotifier, pEvents[7]) == 0);
+
+	for (i = 0; i < 16; ++i)
+	{
+		if (i != 3 && i != 7)
+			ASSERT_TRUE(rsslNotifierRemoveEvent(pNotifier, pEvents[i]) == 0);
+		rsslDestroyNotifierEvent(pEvents[i]);
+		if (i != 7)
+			close(pipeFds[i][0]);
+		close(pipeFds[i][1]);
+	}
+
+	rsslDestroyNotifier(pNotifier);
+}
+
+/* Tests that with epoll, a descriptor already used by one event cannot be added for another event
+ * (which would take over the first event's registration). */
+static void reactorUnitTests_NotifierDuplicateFd(RsslNotifierType notifierType)
+{
+	RsslNotifier *pNotifier;
+	RsslNotifierEvent *pEvent1, *pEvent2;
+	int pipeFds[2];
+	char byte = 0;
+
+	ASSERT_TRUE((pNotifier = rsslCreateNotifierEx(4, notifierType)) != NULL);
+	ASSERT_TRUE(pipe(pipeFds) == 0);
+	ASSERT_TRUE((pEvent1 = rsslCreateNotifierEvent()) != NULL);
+	ASSERT_TRUE((pEvent2 = rsslCreateNotifierEvent()) != NULL);
+
+	ASSERT_TRUE(rsslNotifierAddEvent(pNotifier, pEvent1, pipeFds[0], pEvent1) == 0);
+	ASSERT_TRUE(rsslNotifierRegisterRead(pNotifier, pEvent1) == 0);
+
+	if (rsslNotifierGetType(pNotifier) != RSSL_NOTIFIER_TYPE_POLL)
+		ASSERT_TRUE(rsslNotifierAddEvent(pNotifier, pEvent2, pipeFds[0], pEvent2) < 0);
+
+	/* First event is still notified. */
+	ASSERT_TRUE(write(pipeFds[1], &byte, 1) == 1);
+	ASSERT_TRUE(rsslNotifierWait(pNotifier, 100000) == 1);
+	ASSERT_TRUE(rsslNotifierEventIsReadable(pNotifier->notifiedEvents[0]));
+	ASSERT_TRUE(rsslNotifierEventGetObject(pNotifier->notifiedEvents[0]) == pEvent1);
+
+	ASSERT_TRUE(rsslNotifierRemoveEvent(pNotifier, pEvent1) == 0);
+	rsslDestroyNotifierEvent(pEvent1);
+	rsslDestroyNotifierEvent(pEvent2);
+	close(pipeFds[0]);
+	close(pipeFds[1]);
+	rsslDestroyNotifier(pNotifier);
+}
+
+TEST(ReactorNotifierTest, PollNotifier)
+{
+	reactorUnitTests_NotifierType(RSSL_NOTIFIER_TYPE_POLL);
+}
+
+TEST(ReactorNotifierTest, EpollNotifier)
+{
+	reactorUnitTests_NotifierType(RSSL_NOTIFIER_TYPE_EPOLL);
+}
+
+TEST(ReactorNotifierTest, EpollEdgeNotifier)
+{
+	reactorUnitTests_NotifierType(RSSL_NOTIFIER_TYPE_EPOLL_EDGE);
+}
+
+TEST(ReactorNotifierTest, EpollDuplicateFd)
+{
+	reactorUnitTests_NotifierDuplicateFd(RSSL_NOTIFIER_TYPE_EPOLL);
+}
+
+TEST(ReactorNotifierTest, EpollEdgeDuplicateFd)
+{
+	reactorUnitTests_NotifierDuplicateFd(RSSL_NOTIFIER_TYPE_EPOLL_EDGE);
+}
+#endif
+
 static void copyMutRDMMsg(MutMsg *pMutMsg, RsslRDMMsg *pRDMMsg, RsslReactorChannel *pReactorChannel)
 {
 	pMutMsg->memoryBuffer.data = pMutMsg->memoryBlock;
@@ -1534,6 +1675,78 @@ void reactorUnitTests_InitializationAndPingTimeout()
 	ASSERT_TRUE(rsslCloseServer(pRsslServer, &rsslErrorInfo.rsslError) == RSSL_RET_SUCCESS); 
 }
 
+void reactorUnitTests_BusyPollPingTimeout()
+{
+	/* Test that a busy polled channel, which is read on every dispatch without waiting for notification,
+	 * still times out when its peer stops sending pings */
+	RsslServer *pRsslServer;
+	RsslChannel *pRsslCh;
+	RsslInProgInfo inProg;
+	RsslBindOptions rsslBindOpts;
+	RsslReactorDispatchOptions dispatchOpts;
+	TimeValue startTimeMs, downTimeMs = 0;
+
+	clearObjects();
+
+	rsslClearReactorDispatchOptions(&dispatchOpts);
+	dispatchOpts.maxMessages = 1;
+
+	connectOpts.initializationTimeout = 1;
+	connectOpts.rsslConnectOptions.pingTimeout = 1;
+	connectOpts.busyPollUsec = 1000;
+
+	rsslClearBindOpts(&rsslBindOpts);
+	rsslBindOpts.serviceName = const_cast<char*>("14010");
+	rsslBindOpts.pingTimeout = 1;
+	rsslBindOpts.minPingTimeout = 1;
+
+	ASSERT_TRUE((pRsslServer = rsslBind(&rsslBindOpts, &rsslErrorInfo.rsslError)));
+
+	connectOpts.rsslConnectOptions.connectionInfo.unified.address = const_cast<char*>("localhost");
+	connectOpts.rsslConnectOptions.connectionInfo.unified.serviceName = const_cast<char*>("14010");
+
+	/* Use rsslAccept() on server so that pinging isn't done by server */
+	ASSERT_TRUE(rsslReactorConnect(pConsMon->pReactor, &connectOpts, (RsslReactorChannelRole*)&ommConsumerRole, &rsslErrorInfo) == RSSL_RET_SUCCESS);
+	time_sleep(10);
+	ASSERT_TRUE(pRsslCh = rsslAccept(pRsslServer, &acceptOpts.rsslAcceptOptions, &rsslErrorInfo.rsslError));
+
+	while(pRsslCh->state == RSSL_CH_STATE_INITIALIZING)
+	{
+		RsslRet ret = rsslInitChannel(pRsslCh, &inProg, &rsslErrorInfo.rsslError);
+		ASSERT_TRUE(ret == RSSL_RET_SUCCESS || ret == RSSL_RET_CHAN_INIT_IN_PROGRESS);
+	}
+
+	ASSERT_TRUE(pRsslCh->state == RSSL_CH_STATE_ACTIVE);
+
+	/* Cons: Should get conn up/ready event */
+	ASSERT_TRUE(dispatchEvent(pConsMon, 100) >= RSSL_RET_SUCCESS);
+	ASSERT_TRUE(pConsMon->mutMsg.mutMsgType == MUT_MSG_CONN && pConsMon->mutMsg.channelEvent.channelEventType == RSSL_RC_CET_CHANNEL_UP);
+	ASSERT_TRUE(dispatchEvent(pConsMon, 100) >= RSSL_RET_SUCCESS);
+	ASSERT_TRUE(pConsMon->mutMsg.mutMsgType == MUT_MSG_CONN && pConsMon->mutMsg.channelEvent.channelEventType == RSSL_RC_CET_CHANNEL_READY);
+
+	/* Cons: Dispatch continuously, as a busy polling application does. Should get conn down since provider doesn't send pings */
+	startTimeMs = getTimeMilli();
+	while (getTimeMilli() - startTimeMs < 3000)
+	{
+		clearMutMsg(&pConsMon->mutMsg);
+		ASSERT_TRUE(rsslReactorDispatch(pConsMon->pReactor, &dispatchOpts, &rsslErrorInfo) >= RSSL_RET_SUCCESS);
+		if (pConsMon->mutMsg.mutMsgType == MUT_MSG_CONN && pConsMon->mutMsg.channelEvent.channelEventType == RSSL_RC_CET_CHANNEL_DOWN)
+		{
+			downTimeMs = getTimeMilli();
+			break;
+		}
+	}
+	ASSERT_TRUE(downTimeMs != 0);
+	ASSERT_TRUE(downTimeMs - startTimeMs >= 500);
+
+	/* Cons: No message(close ack) */
+	ASSERT_TRUE(dispatchEvent(pConsMon, 100) >= RSSL_RET_SUCCESS);
+	ASSERT_TRUE(pConsMon->mutMsg.mutMsgType == MUT_MSG_NONE);
+
+	ASSERT_TRUE(rsslCloseChannel(pRsslCh, &rsslErrorInfo.rsslError) >= RSSL_RET_SUCCESS);
+	ASSERT_TRUE(rsslCloseServer(pRsslServer, &rsslErrorInfo.rsslError) == RSSL_RET_SUCCESS); 
+}
+
 static void reactorUnitTests_InvalidArguments()
 {
 	/* Test bad uses of the interface */
@@ -2767,6 +2980,7 @@ void reactorUtilTest_ConnectDeepCopy()
 	inOpts.multicastOpts.tcpControlPort = const_cast<char*>("4321");
 	inOpts.multicastOpts.portRoamRange = 4;
 	inOpts.shmemOpts.maxReaderLag = 8;
+	inOpts.shmemOpts.resumeOnOverrun = RSSL_TRUE;
 	inOpts.sysSendBufSize = 1;
 	inOpts.sysRecvBufSize = 2;
 	inOpts.seqMulticastOpts.maxMsgSize = 12345;
@@ -2831,6 +3045,7 @@ void reactorUtilTest_ConnectDeepCopy()
 	ASSERT_TRUE(strcmp((const char*)inOpts.multicastOpts.tcpControlPort, (const char*)outOpts.multicastOpts.tcpControlPort) == 0);
 	ASSERT_TRUE(inOpts.multicastOpts.portRoamRange == outOpts.multicastOpts.portRoamRange);
 	ASSERT_TRUE(inOpts.shmemOpts.maxReaderLag == outOpts.shmemOpts.maxReaderLag);	
+	ASSERT_TRUE(inOpts.shmemOpts.resumeOnOverrun == outOpts.shmemOpts.resumeOnOverrun);
 	ASSERT_TRUE(inOpts.sysSendBufSize == outOpts.sysSendBufSize);
 	ASSERT_TRUE(inOpts.sysRecvBufSize == outOpts.sysRecvBufSize);
 	ASSERT_TRUE(inOpts.seqMulticastOpts.maxMsgSize == outOpts.seqMulticastOpts.maxMsgSize);